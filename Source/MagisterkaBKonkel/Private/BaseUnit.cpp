@@ -11,6 +11,7 @@
 #include "EngineUtils.h"
 #include "UnitManager.h" 
 #include "SpatialGrid.h"
+#include "UnitArchetype.h"
 
 /// <summary>
 /// KONSTRUKTOR
@@ -34,6 +35,8 @@ ABaseUnit::ABaseUnit()
     // Komponent siatki szkieletowej
     UnitMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("UnitMesh"));
     UnitMesh->SetupAttachment(RootComponent);
+    // Bez zdarzeń nakładania - kolizje jednostek rozstrzygają rezerwacje komórek i unikanie
+    UnitMesh->SetGenerateOverlapEvents(false);
 
     // Widget 3D wyświetlający pasek zdrowia nad jednostką
     HealthBarWidget = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBarWidget"));
@@ -50,21 +53,10 @@ ABaseUnit::ABaseUnit()
     // Wyłącz kolizje - pasek zdrowia nie powinien blokować
     HealthBarWidget->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-    MaxHealth = 100;              // Maksymalne zdrowie
-    CurrentHealth = MaxHealth;     // Aktualne zdrowie
-    Attack = 10;                   // Siła ataku
-    Defense = 5;                   // Obrona
-    Speed = 5.0f;                  // Prędkość poruszania się
-    AttackRange = 1.5f;            // Zasięg ataku
-    Cost = 10;                     // Koszt wyszkolenia jednostki
-
-    AttackCooldown = 1.5f;         // Czas między atakami
+    // Statystyki, interwały i strojenie paska zdrowia pochodzą z archetypu typu (GetArchetype)
     MovementSpeed = 2.0f;          // Prędkość ruchu w walce
     bAutoCombatEnabled = false;    // Automatyczna walka wyłączona domyślnie
-    SearchRange = 2000.0f;         // Zasięg wyszukiwania wrogów
     SearchRangeGrid = 1.0f;        // Zasięg w siatce przestrzennej
-    MovementInterval = 2.0f;       // Częstotliwość aktualizacji ruchu
-    TargetSearchInterval = 0.125f;   // Częstotliwość szukania nowych celów
     MovementStepSize = 5.0f;       // Wielkość kroku ruchu
 
     CurrentTarget = nullptr;       // Brak początkowego celu
@@ -73,10 +65,11 @@ ABaseUnit::ABaseUnit()
     LastAttackTime = 0.0f;         // Czas ostatniego ataku
     LastMovementTime = 0.0f;       // Czas ostatniego ruchu
     LastTargetSearchTime = 0.0f;   // Czas ostatniego szukania celu
-    RotationSpeed = 5.0f;          // Prędkość obrotów jednostki
+    LastCombatUpdateTime = -1.0f;  // Czas ostatniej decyzji bojowej (-1 = brak)
+    CachedUnitManager = nullptr;   // Manager (koło czasowe, bufor obrażeń) - wyszukiwany przy pierwszym użyciu
     bSmoothRotation = true;        // Włącz płynne obroty
 
-    GridPosition = FVector2D(0, 0); // Pozycja w siatce
+    GridPosition = FGridCell(0, 0); // Pozycja w siatce
     GridSize = 100.0f;              // Rozmiar pojedynczej komórki siatki
 
     TeamID = 0;                     // ID drużyny 
@@ -87,17 +80,6 @@ ABaseUnit::ABaseUnit()
     bIsAlive = true;               // Jednostka żyje
     bCanMove = true;               // Może się poruszać
     bCanAttack = true;             // Może atakować
-
-    HealthBarHeight = 80.0f;       // Wysokość nad jednostką
-    bShowHealthBar = true;         // Pokaż pasek zdrowia
-    bHealthBarAlwaysVisible = false; // Nie zawsze widoczny
-
-    bHealthBarFaceCamera = true;   // Zawsze skierowany do kamery
-    bScaleWithDistance = true;     // Skaluj z odległością od kamery
-    MinHealthBarScale = 0.5f;      // Minimalna skala
-    MaxHealthBarScale = 2.0f;      // Maksymalna skala
-    MaxHealthBarVisibilityDistance = 2000.0f; // Maksymalna odległość widoczności
-    HealthBarOffset = FVector(0, 0, 80); // Przesunięcie nad jednostką
 }
 
 
@@ -108,8 +90,6 @@ void ABaseUnit::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetim
 {
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-    // Replikuj maksymalne zdrowie do wszystkich klientów
-    DOREPLIFETIME(ABaseUnit, MaxHealth);
     // Replikuj zdrowie z natychmiastowym powiadomieniem 
     DOREPLIFETIME_CONDITION_NOTIFY(ABaseUnit, CurrentHealth, COND_None, REPNOTIFY_Always);
     // ID drużyny 
@@ -139,10 +119,30 @@ void ABaseUnit::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetim
     DOREPLIFETIME_CONDITION(ABaseUnit, bCanMove, COND_None);
     // Czy może atakować
     DOREPLIFETIME_CONDITION(ABaseUnit, bCanAttack, COND_None);
+    // Czy jednostka czeka w puli aktorów
+    DOREPLIFETIME_CONDITION_NOTIFY(ABaseUnit, bInUnitPool, COND_None, REPNOTIFY_OnChanged);
+}
+
+/// <summary>
+/// Archetyp jednostki przypisany w Blueprincie typu (DA_*). Bez zasobu zwraca domyślny obiekt
+/// klasy UUnitArchetype - jeden wspólny zestaw wartości, taki sam na serwerze i u klientów.
+/// </summary>
+/// <returns>Archetyp jednostki (nigdy nullptr)</returns>
+const UUnitArchetype* ABaseUnit::GetArchetype() const
+{
+    return Archetype ? Archetype : GetDefault<UUnitArchetype>();
+}
+
+/// <summary>
+/// Czy pasek zdrowia jest włączony - w archetypie typu i nie wyłączony dla tej instancji
+/// </summary>
+bool ABaseUnit::ShouldShowHealthBar() const
+{
+    return !bHealthBarSuppressed && GetArchetype()->bShowHealthBar;
 }
 
 /// <summary>
-/// Inicjalizacja po utworzeniu aktora
+/// Rozpoczęcie gry dla jednostki
 /// </summary>
 void ABaseUnit::BeginPlay()
 {
@@ -152,7 +152,7 @@ void ABaseUnit::BeginPlay()
     PlayerController = UGameplayStatics::GetPlayerController(GetWorld(), 0);
 
     // Ustaw pełne zdrowie na starcie
-    CurrentHealth = MaxHealth;
+    CurrentHealth = GetArchetype()->MaxHealth;
 
     // Skonfiguruj i zaktualizuj pasek zdrowia
     SetupHealthBar();
@@ -166,6 +166,21 @@ void ABaseUnit::BeginPlay()
         *GetName(), HasAuthority() ? TEXT("SERVER") : TEXT("CLIENT"));
 }
 
+/// <summary>
+/// Zwolnienie slotu w kole czasowym przy usuwaniu aktora
+/// </summary>
+/// <param name="EndPlayReason">Powód zakończenia</param>
+void ABaseUnit::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Zaległe wpisy tej jednostki zostaną pominięte dzięki zmianie generacji slotu
+    if (IsValid(CachedUnitManager))
+    {
+        CachedUnitManager->ReleaseUnitTimerSlot(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 /// <summary>
 /// Wywoływanie co klatkę
 /// </summary>
@@ -175,16 +190,16 @@ void ABaseUnit::Tick(float DeltaTime)
     Super::Tick(DeltaTime);
 
     // AKTUALIZACJA PASKA ZDROWIA 3D
-    if (HealthBarWidget && bShowHealthBar && PlayerController)
+    if (HealthBarWidget && ShouldShowHealthBar() && PlayerController)
     {
         // Obróć pasek zdrowia w kierunku kamery 
-        if (bHealthBarFaceCamera)
+        if (GetArchetype()->bHealthBarFaceCamera)
         {
             BillboardHealthBarToCamera();
         }
 
         // Skaluj pasek w zależności od odległości od kamery
-        if (bScaleWithDistance)
+        if (GetArchetype()->bScaleWithDistance)
         {
             UpdateHealthBarScaleBasedOnDistance();
         }
@@ -205,10 +220,103 @@ void ABaseUnit::Tick(float DeltaTime)
 
     // Logika walki wykonywana wyłącznie przez serwer 
     // Klienci tylko wyświetlają efekty replikowane z serwera
-    if (HasAuthority())
+    // Uśpiona jednostka nie ma wrogów w sąsiedztwie - budzi ją siatka przestrzenna
+    if (HasAuthority() && !bCombatSleeping)
+    {
+        // W trybie podziału czasu decyzje bojowe planuje manager w ramach budżetu klatki
+        AUnitManager* UnitManager = GetCachedUnitManager();
+        if (!UnitManager || !UnitManager->IsTimeSlicedCombatEnabled())
+        {
+            RunCombatUpdate(GetWorld()->GetTimeSeconds());
+        }
+    }
+}
+
+/// <summary>
+/// Wykonanie jednej decyzji bojowej z czasem, który upłynął od poprzedniej decyzji tej jednostki
+/// </summary>
+/// <param name="WorldTime">Aktualny czas świata</param>
+/// <returns>Wiek poprzedniej decyzji w sekundach</returns>
+float ABaseUnit::RunCombatUpdate(float WorldTime)
+{
+    const float DecisionAge = GetCombatDecisionAge(WorldTime);
+    LastCombatUpdateTime = WorldTime;
+
+    UpdateCombatBehavior(DecisionAge);
+    return DecisionAge;
+}
+
+/// <summary>
+/// Uśpienie jednostki bez wrogów w sąsiedztwie - rejestracja zainteresowania mega-komórkami siatki
+/// </summary>
+/// <returns>true jeśli jednostka została uśpiona</returns>
+bool ABaseUnit::TryEnterCombatSleep()
+{
+    if (!HasAuthority() || !bIsAlive || !bAutoCombatEnabled || bCombatSleeping || HasValidTarget())
+        return false;
+
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    USpatialGrid* SpatialGrid = UnitManager ? UnitManager->GetSpatialGrid() : nullptr;
+    if (!SpatialGrid || !SpatialGrid->RegisterSleepInterest(this, GetArchetype()->SearchRange))
+        return false;
+
+    bCombatSleeping = true;
+    bIsMovingToTarget = false;
+
+    // Bez paska zdrowia do obracania Tick nie ma nic do zrobienia
+    SetActorTickEnabled(GetArchetype()->bHealthBarAlwaysVisible);
+
+    UE_LOG(LogTemp, Warning, TEXT("=== COMBAT SLEEP: Unit %s has no enemies nearby, sleeping ==="), *GetName());
+    return true;
+}
+
+/// <summary>
+/// Wybudzenie uśpionej jednostki - wyrejestrowanie z siatki i natychmiastowe wyszukiwanie celu
+/// </summary>
+void ABaseUnit::WakeFromCombatSleep()
+{
+    if (!bCombatSleeping)
+        return;
+
+    bCombatSleeping = false;
+
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    if (USpatialGrid* SpatialGrid = UnitManager ? UnitManager->GetSpatialGrid() : nullptr)
+    {
+        SpatialGrid->ClearSleepInterest(this);
+    }
+
+    SetActorTickEnabled(true);
+    bTargetSearchReady = true;
+
+    // Decyzja po przebudzeniu nie nadrabia czasu snu
+    if (GetWorld())
     {
-        UpdateCombatBehavior(DeltaTime);
+        LastCombatUpdateTime = GetWorld()->GetTimeSeconds();
     }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== COMBAT SLEEP: Unit %s woken up ==="), *GetName());
+}
+
+/// <summary>
+/// Wiek ostatniej decyzji bojowej jednostki
+/// </summary>
+/// <param name="WorldTime">Aktualny czas świata</param>
+/// <returns>Czas od ostatniej decyzji w sekundach (0 jeśli jeszcze jej nie było)</returns>
+float ABaseUnit::GetCombatDecisionAge(float WorldTime) const
+{
+    return LastCombatUpdateTime < 0.0f ? 0.0f : FMath::Max(WorldTime - LastCombatUpdateTime, 0.0f);
+}
+
+/// <summary>
+/// Czas od ostatniego policzonego kroku jednostki - długość kroku dla decyzji z timerów
+/// i wyszukiwania celu, które nie przechodzą przez RunCombatUpdate
+/// </summary>
+/// <param name="WorldTime">Aktualny czas świata</param>
+/// <returns>Czas od ostatniego kroku w sekundach (0 jeśli jeszcze go nie było)</returns>
+float ABaseUnit::GetMovementDecisionAge(float WorldTime) const
+{
+    return LastMovementDecisionTime < 0.0f ? 0.0f : FMath::Max(WorldTime - LastMovementDecisionTime, 0.0f);
 }
 
 
@@ -226,14 +334,40 @@ void ABaseUnit::ReceiveDamage(int32 DamageAmount)
     if (!bIsAlive || DamageAmount <= 0)
         return;
 
+    ApplyResolvedDamage(CalculateDamageTaken(DamageAmount), 1);
+}
+
+/// <summary>
+/// Obliczenie obrażeń po uwzględnieniu obrony
+/// </summary>
+/// <param name="RawDamage">Obrażenia przed obroną</param>
+/// <returns>Obrażenia faktycznie zadane jednostce</returns>
+int32 ABaseUnit::CalculateDamageTaken(int32 RawDamage) const
+{
     // Odejmij obronę, ale zawsze zadaj minimum 1 obrażenia
-    int32 ActualDamage = FMath::Max(DamageAmount - Defense, 1);
+    return FMath::Max(RawDamage - GetArchetype()->Defense, 1);
+}
+
+/// <summary>
+/// Zastosowanie zsumowanych obrażeń z jednego ticka - jedno powiadomienie niezależnie od liczby trafień
+/// </summary>
+/// <param name="ActualDamage">Suma obrażeń po uwzględnieniu obrony</param>
+/// <param name="HitCount">Liczba trafień składających się na sumę</param>
+void ABaseUnit::ApplyResolvedDamage(int32 ActualDamage, int32 HitCount)
+{
+    // Tylko serwer przetwarza obrażenia
+    if (!HasAuthority() || !bIsAlive || ActualDamage <= 0)
+        return;
+
+    // Trafienie z dystansu spoza obserwowanych komórek również budzi jednostkę
+    WakeFromCombatSleep();
+
     // Oblicz nowe zdrowie (nie poniżej 0)
     int32 NewHealth = FMath::Max(CurrentHealth - ActualDamage, 0);
 
     // Log informacyjny o obrażeniach
-    UE_LOG(LogTemp, Warning, TEXT("=== DAMAGE: %s received %d damage, health: %d -> %d ==="),
-        *GetName(), ActualDamage, CurrentHealth, NewHealth);
+    UE_LOG(LogTemp, Warning, TEXT("=== DAMAGE: %s received %d damage from %d hit(s), health: %d -> %d ==="),
+        *GetName(), ActualDamage, HitCount, CurrentHealth, NewHealth);
 
     // Zaktualizuj zdrowie
     CurrentHealth = NewHealth;
@@ -248,19 +382,12 @@ void ABaseUnit::ReceiveDamage(int32 DamageAmount)
     OnUnitDamaged.Broadcast(this, ActualDamage);   // Broadcast dla innych systemów
 
     // Jeśli pasek nie jest zawsze widoczny, pokaż go tymczasowo
-    if (!bHealthBarAlwaysVisible)
+    if (!GetArchetype()->bHealthBarAlwaysVisible)
     {
         ShowHealthBar();
 
         // Ukryj pasek po 3 sekundach
-        FTimerHandle HideHealthBarTimer;
-        GetWorldTimerManager().SetTimer(HideHealthBarTimer, [this]()
-            {
-                if (!bHealthBarAlwaysVisible && CurrentHealth > 0)
-                {
-                    HideHealthBar();
-                }
-            }, 3.0f, false);
+        ScheduleCombatTimer(ECombatTimerAction::HideHealthBar, 3.0f);
     }
 
     // Jeśli zdrowie spadło do 0, jednostka umiera
@@ -292,18 +419,11 @@ void ABaseUnit::MulticastReceiveDamage_Implementation(int32 DamageAmount, int32
         OnDamageReceived(DamageAmount, CurrentHealth);
 
         // Tymczasowo pokaż pasek zdrowia
-        if (!bHealthBarAlwaysVisible)
+        if (!GetArchetype()->bHealthBarAlwaysVisible)
         {
             ShowHealthBar();
 
-            FTimerHandle HideHealthBarTimer;
-            GetWorldTimerManager().SetTimer(HideHealthBarTimer, [this]()
-                {
-                    if (!bHealthBarAlwaysVisible && CurrentHealth > 0)
-                    {
-                        HideHealthBar();
-                    }
-                }, 3.0f, false);
+            ScheduleCombatTimer(ECombatTimerAction::HideHealthBar, 3.0f);
         }
     }
 }
@@ -324,7 +444,7 @@ bool ABaseUnit::AttackTarget(ABaseUnit* Target)
         return false;
 
     // Sprawdź zasięg ataku
-    if (GetDistanceToTarget(Target) > AttackRange)
+    if (GetDistanceToTarget(Target) > GetArchetype()->AttackRange)
         return false;
 
     UE_LOG(LogTemp, Warning, TEXT("=== ATTACK: %s attacking %s ==="), *GetName(), *Target->GetName());
@@ -334,8 +454,16 @@ bool ABaseUnit::AttackTarget(ABaseUnit* Target)
     // Wyślij animację ataku do wszystkich klientów
     MulticastPerformAttack(Target);
 
-    // Zadanie obrażen
-    Target->ReceiveDamage(Attack);
+    // Zadanie obrażen - przez bufor managera (rozstrzygane raz na tick) lub bezpośrednio
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    if (UnitManager && UnitManager->IsBatchedDamageEnabled())
+    {
+        UnitManager->QueueDamage(this, Target, GetArchetype()->Attack);
+    }
+    else
+    {
+        Target->ReceiveDamage(GetArchetype()->Attack);
+    }
 
     // Event wykonania ataku
     OnAttackPerformed(Target);
@@ -365,7 +493,7 @@ void ABaseUnit::MulticastPerformAttack_Implementation(ABaseUnit* Target)
 /// </summary>
 /// <param name="NewGridPosition">Nowa pozycja</param>
 /// <returns>true - w przypadku powodzenia, false - wpp</returns>
-bool ABaseUnit::MoveToGridPosition(FVector2D NewGridPosition)
+bool ABaseUnit::MoveToGridPosition(FGridCell NewGridPosition)
 {
     // Tylko serwer przetwarza ruch
     if (!HasAuthority())
@@ -375,8 +503,6 @@ bool ABaseUnit::MoveToGridPosition(FVector2D NewGridPosition)
     if (!CanPerformAction() || !bCanMove || NewGridPosition == GridPosition)
         return false;
 
-    // Zapisz starą pozycję
-    FVector2D OldPosition = GridPosition;
     // Ustaw nową pozycję w siatce
     GridPosition = NewGridPosition;
 
@@ -424,6 +550,15 @@ bool ABaseUnit::MoveToWorldPosition(FVector NewWorldPosition)
         return false;
     }
 
+    // Ruch wsadowy - transformację zapisze manager w jednym przebiegu po tickach jednostek
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    if (UnitManager && UnitManager->IsBatchedMovementEnabled())
+    {
+        UnitManager->QueueUnitMove(this, NewWorldPosition);
+        SetAnimationState(EAnimationState::Moving);
+        return true;
+    }
+
     // Wykonanie ruchu
     FVector OldPosition = GetActorLocation();
     UE_LOG(LogTemp, Warning, TEXT("=== SERVER MoveToWorldPosition: Moving from (%f,%f,%f) to (%f,%f,%f) ==="),
@@ -444,6 +579,7 @@ bool ABaseUnit::MoveToWorldPosition(FVector NewWorldPosition)
     UE_LOG(LogTemp, Warning, TEXT("=== SERVER MoveToWorldPosition: Setting actor location on SERVER ==="));
     SetActorLocation(NewWorldPosition);
     WorldPosition = NewWorldPosition;
+    InvalidateTargetRange();
 
     // Weryfikuj czy pozycja została ustawiona
     FVector ActualPosition = GetActorLocation();
@@ -540,6 +676,7 @@ void ABaseUnit::Die()
     bIsAlive = false;
     bCanMove = false;
     bCanAttack = false;
+    WakeFromCombatSleep();
 
     // Ustaw animację umierania
     SetAnimationState(EAnimationState::Dying);
@@ -554,12 +691,7 @@ void ABaseUnit::Die()
     HideHealthBar();
 
     // Po 2 sekundach zniszcz aktora
-    FTimerHandle DestroyTimer;
-    GetWorldTimerManager().SetTimer(DestroyTimer, [this]()
-        {
-            SetAnimationState(EAnimationState::Dead);
-            Destroy();
-        }, 2.0f, false);
+    ScheduleCombatTimer(ECombatTimerAction::DeathFinished, 2.0f);
 }
 
 /// <summary>
@@ -579,12 +711,8 @@ void ABaseUnit::MulticastDie_Implementation()
         SetAnimationState(EAnimationState::Dying);
         HideHealthBar();
 
-        // Timer na kliencie
-        FTimerHandle DestroyTimer;
-        GetWorldTimerManager().SetTimer(DestroyTimer, [this]()
-            {
-                SetAnimationState(EAnimationState::Dead);
-            }, 2.0f, false);
+        // Timer na kliencie (bez niszczenia aktora)
+        ScheduleCombatTimer(ECombatTimerAction::DeathFinished, 2.0f);
     }
 }
 
@@ -789,15 +917,15 @@ void ABaseUnit::OnRep_WorldPosition()
 /// </summary>
 /// <param name="NewGridPosition">Nowa pozycja</param>
 /// <returns>true - w przypadku możliwości przemieszczenia się, false - wpp</returns>
-bool ABaseUnit::CanMoveToGridPosition(FVector2D NewGridPosition) const
+bool ABaseUnit::CanMoveToGridPosition(FGridCell NewGridPosition) const
 {
     // Sprawdź czy jednostka żyje i może się poruszać
     if (!bIsAlive || !bCanMove || NewGridPosition == GridPosition)
         return false;
 
-    // Sprawdź dystans 
-    float Distance = FVector2D::Distance(GridPosition, NewGridPosition);
-    if (Distance > 1.0f)
+    // Sprawdź dystans - tylko sąsiednia komórka (bez przekątnych)
+    const FGridCell Offset = NewGridPosition - GridPosition;
+    if (FMath::Abs(Offset.X) + FMath::Abs(Offset.Y) > 1)
         return false;
 
     return true;
@@ -819,7 +947,7 @@ TArray<ABaseUnit*> ABaseUnit::GetValidTargets(const TArray<ABaseUnit*>& AllUnits
     // Przefiltruj jednostki
     for (ABaseUnit* Unit : AllUnits)
     {
-        if (IsValidTarget(Unit) && GetDistanceToTarget(Unit) <= AttackRange)
+        if (IsValidTarget(Unit) && GetDistanceToTarget(Unit) <= GetArchetype()->AttackRange)
         {
             ValidTargets.Add(Unit);
         }
@@ -852,7 +980,7 @@ TArray<FVector> ABaseUnit::GetValidMovePositions(const TArray<ABaseUnit*>& AllUn
         // Oblicz wektor kierunku
         FVector Direction = FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f);
         // Oblicz testową pozycję
-        FVector TestPosition = CurrentPosition + (Direction * Speed);
+        FVector TestPosition = CurrentPosition + (Direction * GetArchetype()->Speed);
         TestPosition.Z = CurrentPosition.Z; // Zachowaj wysokość
 
         // Sprawdź granice pola bitwy
@@ -890,14 +1018,14 @@ TArray<FVector> ABaseUnit::GetValidMovePositions(const TArray<ABaseUnit*>& AllUn
 void ABaseUnit::UpdateHealthBar()
 {
     // Sprawdź czy widget istnieje i jest włączony
-    if (!HealthBarWidget || !bShowHealthBar)
+    if (!HealthBarWidget || !ShouldShowHealthBar())
         return;
 
     // Pobierz widget użytkownika i zaktualizuj wartości
     if (UHealthBarWidget* HealthWidget = Cast<UHealthBarWidget>(HealthBarWidget->GetUserWidgetObject()))
     {
         float HealthPercentage = GetHealthPercentage();
-        HealthWidget->UpdateHealthBar(HealthPercentage, CurrentHealth, MaxHealth);
+        HealthWidget->UpdateHealthBar(HealthPercentage, CurrentHealth, GetArchetype()->MaxHealth);
         OnHealthBarUpdated(HealthPercentage);
     }
 }
@@ -918,7 +1046,7 @@ void ABaseUnit::ShowHealthBar()
 /// </summary>
 void ABaseUnit::HideHealthBar()
 {
-    if (HealthBarWidget && !bHealthBarAlwaysVisible)
+    if (HealthBarWidget && !GetArchetype()->bHealthBarAlwaysVisible)
     {
         HealthBarWidget->SetVisibility(false);
     }
@@ -975,7 +1103,8 @@ void ABaseUnit::UpdateHealthBarScaleBasedOnDistance()
     // Normalizuj odległość
     float NormalizedDistance = FMath::Clamp(Distance / 700.0f, 0.1f, 3.0f);
     // Ogranicz skalę do zdefiniowanych limitów
-    float Scale = FMath::Clamp(NormalizedDistance, MinHealthBarScale, MaxHealthBarScale);
+    const UUnitArchetype* UnitArchetype = GetArchetype();
+    float Scale = FMath::Clamp(NormalizedDistance, UnitArchetype->MinHealthBarScale, UnitArchetype->MaxHealthBarScale);
 
     // Zastosuj skalę
     HealthBarWidget->SetRelativeScale3D(FVector(Scale));
@@ -996,7 +1125,7 @@ void ABaseUnit::UpdateHealthBarVisibilityBasedOnDistance()
     // Oblicz odległość
     float Distance = FVector::Dist(CameraLocation, HealthBarLocation);
     // Pokaż tylko jeśli w zasięgu i włączone
-    bool bShouldBeVisible = Distance <= MaxHealthBarVisibilityDistance && bShowHealthBar;
+    bool bShouldBeVisible = Distance <= GetArchetype()->MaxHealthBarVisibilityDistance && ShouldShowHealthBar();
     HealthBarWidget->SetVisibility(bShouldBeVisible);
 }
 
@@ -1006,6 +1135,7 @@ void ABaseUnit::UpdateHealthBarVisibilityBasedOnDistance()
 /// <returns>Procent zdrowia</returns>
 float ABaseUnit::GetHealthPercentage() const
 {
+    const int32 MaxHealth = GetArchetype()->MaxHealth;
     return MaxHealth > 0 ? (float)CurrentHealth / (float)MaxHealth : 0.0f;
 }
 
@@ -1053,7 +1183,45 @@ float ABaseUnit::GetDistanceToCurrentTarget() const
     if (!HasValidTarget())
         return FLT_MAX; // Maksymalna wartość float jeśli brak celu
 
-    return FVector::Dist(GetActorLocation(), CurrentTarget->GetActorLocation());
+    return FMath::Sqrt(GetTargetRange(CurrentTarget).DistanceSq);
+}
+
+/// <summary>
+/// Odleglosc, kierunek i flaga zasiegu do celu - liczone raz na tick symulacji, ponownie tylko
+/// gdy jednostka lub cel zmienily pozycje w tej samej klatce
+/// </summary>
+/// <param name="Target">Cel</param>
+/// <returns>Dane z bufora dla biezacej klatki</returns>
+const FTargetRangeCache& ABaseUnit::GetTargetRange(const ABaseUnit* Target) const
+{
+    // Bufor jest zapisywany przy odczycie - wolno go uzywac tylko na watku gry
+    check(IsInGameThread());
+
+    const FVector OwnerLocation = GetActorLocation();
+    const FVector TargetLocation = Target ? Target->GetActorLocation() : FVector::ZeroVector;
+
+    if (TargetRangeCache.Frame == GFrameCounter && TargetRangeCache.Target == Target
+        && TargetRangeCache.OwnerLocation == OwnerLocation && TargetRangeCache.TargetLocation == TargetLocation)
+        return TargetRangeCache;
+
+    TargetRangeCache.Target = Target;
+    TargetRangeCache.Frame = GFrameCounter;
+    TargetRangeCache.OwnerLocation = OwnerLocation;
+    TargetRangeCache.TargetLocation = TargetLocation;
+
+    if (!Target)
+    {
+        TargetRangeCache.DistanceSq = MAX_flt;
+        TargetRangeCache.Direction = FVector::ZeroVector;
+        TargetRangeCache.bInRange = false;
+        return TargetRangeCache;
+    }
+
+    const FVector Delta = TargetLocation - OwnerLocation;
+    TargetRangeCache.DistanceSq = static_cast<float>(Delta.SizeSquared());
+    TargetRangeCache.Direction = FVector(Delta.X, Delta.Y, 0.0f).GetSafeNormal();
+    TargetRangeCache.bInRange = TargetRangeCache.DistanceSq <= FMath::Square(GetArchetype()->AttackRange);
+    return TargetRangeCache;
 }
 
 /// <summary>
@@ -1075,7 +1243,7 @@ float ABaseUnit::GetDistanceToTarget(const ABaseUnit* Target) const
 void ABaseUnit::UpdateWorldPosition()
 {
     // Przelicz pozycję siatki na współrzędne świata
-    FVector NewWorldPosition = GetWorldPositionFromGrid(GridPosition);
+    FVector NewWorldPosition = GetWorldPositionFromGrid(GridPosition.ToGridPosition());
     // Przenieś aktora
     SetActorLocation(NewWorldPosition);
 }
@@ -1112,10 +1280,10 @@ void ABaseUnit::SetupHealthBar()
         return;
 
     // Ustaw przesunięcie paska nad jednostką
-    HealthBarWidget->SetRelativeLocation(HealthBarOffset);
+    HealthBarWidget->SetRelativeLocation(GetArchetype()->HealthBarOffset);
 
     // Pokaż lub ukryj na podstawie ustawień
-    if (bHealthBarAlwaysVisible)
+    if (GetArchetype()->bHealthBarAlwaysVisible)
     {
         ShowHealthBar();
     }
@@ -1141,6 +1309,13 @@ void ABaseUnit::StartAutoCombat()
 
     // Włącz tryb auto-combat
     bAutoCombatEnabled = true;
+    ResetGridPath();
+    bHasReservedMove = false;
+    bLostCellReservation = false;
+    ResetAvoidance();
+    // Wiek decyzji i kroku liczony od początku walki
+    LastCombatUpdateTime = GetWorld() ? GetWorld()->GetTimeSeconds() : -1.0f;
+    LastMovementDecisionTime = LastCombatUpdateTime;
     UE_LOG(LogTemp, Warning, TEXT("=== AUTO COMBAT: Unit %s - Auto combat started ==="), *GetName());
 }
 
@@ -1155,6 +1330,7 @@ void ABaseUnit::StopAutoCombat()
 
     // Wyłącz tryb auto-combat
     bAutoCombatEnabled = false;
+    WakeFromCombatSleep();
     // Wyczyść cel
     ClearTarget();
     // Wróć do stanu bezczynności
@@ -1191,9 +1367,8 @@ void ABaseUnit::FindAndAttackNearestEnemy(const TArray<ABaseUnit*>& AllUnits)
     // Jeśli nie mamy prawidłowego celu
     if (!HasValidTarget())
     {
-        float CurrentTime = GetWorld()->GetTimeSeconds();
-        // Sprawdź czy minął interwał wyszukiwania
-        if (CurrentTime - LastTargetSearchTime < TargetSearchInterval)
+        // Sprawdź czy minął interwał wyszukiwania (flaga ustawiana przez koło czasowe)
+        if (!bTargetSearchReady)
             return;
 
         // Użyj zoptymalizowanego wyszukiwania (z partycjonowaniem przestrzeni jeśli dostępne)
@@ -1203,14 +1378,17 @@ void ABaseUnit::FindAndAttackNearestEnemy(const TArray<ABaseUnit*>& AllUnits)
         {
             // Znaleziono wroga - ustaw jako cel i ruszaj w jego kierunku
             SetTarget(NewTarget);
-            MoveTowardsTarget(NewTarget);
-            LastTargetSearchTime = CurrentTime;
+            MoveTowardsTarget(NewTarget, GetMovementDecisionAge(GetWorld()->GetTimeSeconds()));
+            LastTargetSearchTime = GetWorld()->GetTimeSeconds();
+            bTargetSearchReady = false;
+            ScheduleCombatTimer(ECombatTimerAction::TargetSearchReady, GetArchetype()->TargetSearchInterval);
         }
         else
         {
-            // Nie znaleziono wroga - wyczyść cel i czekaj
+            // Nie znaleziono wroga - wyczyść cel i uśpij jednostkę do czasu pojawienia się wroga
             ClearTarget();
             SetAnimationState(EAnimationState::Idle);
+            TryEnterCombatSleep();
         }
     }
 }
@@ -1226,7 +1404,7 @@ ABaseUnit* ABaseUnit::FindNearestEnemy(const TArray<ABaseUnit*>& AllUnits) const
         return nullptr;
 
     ABaseUnit* NearestEnemy = nullptr;
-    float NearestDistance = SearchRange;
+    float NearestDistance = GetArchetype()->SearchRange;
 
     UE_LOG(LogTemp, Warning, TEXT("=== TARGET SEARCH: Unit %s searching for enemies among %d units (ORIGINAL METHOD) ==="),
         *GetName(), AllUnits.Num());
@@ -1342,7 +1520,8 @@ AUnitManager* ABaseUnit::GetUnitManager() const
 /// Zooptymalizowania metoda ruchu do celu
 /// </summary>
 /// <param name="Target">Aktualny cel</param>
-void ABaseUnit::MoveTowardsTargetOptimized(ABaseUnit* Target)
+/// <param name="DeltaTime">Czas od poprzedniej decyzji ruchu</param>
+void ABaseUnit::MoveTowardsTargetOptimized(ABaseUnit* Target, float DeltaTime)
 {
     // Tylko serwer kontroluje ruch
     if (!HasAuthority())
@@ -1357,7 +1536,23 @@ void ABaseUnit::MoveTowardsTargetOptimized(ABaseUnit* Target)
         return;
     }
 
-    AUnitManager* UnitManager = GetUnitManager();
+    AUnitManager* UnitManager = GetCachedUnitManager();
+
+    // Przegrany w rozstrzygnięciu rezerwacji szuka objazdu przez sąsiadów zamiast ponownie
+    // zgłaszać tę samą komórkę
+    const bool bFindDetour = bLostCellReservation && UnitManager && UnitManager->IsCellReservationEnabled();
+    bLostCellReservation = false;
+
+    // Pole przepływu drużyny zastępuje sprawdzanie kierunków wokół jednostki, a tablica
+    // rezerwacji komórek - sprawdzanie sąsiadów na drodze do celu
+    FVector FlowDirection;
+    if (UnitManager && !bFindDetour && (UnitManager->IsCellReservationEnabled() ||
+        UnitManager->SampleFlowDirection(TeamID, GetActorLocation(), GetTargetRange(Target).DistanceSq, FlowDirection)))
+    {
+        MoveTowardsTarget(Target, DeltaTime);
+        return;
+    }
+
     if (UnitManager && UnitManager->IsSpatialPartitioningEnabled())
     {
         // Pobierz pobliskie jednostki z siatki przestrzennej
@@ -1365,22 +1560,33 @@ void ABaseUnit::MoveTowardsTargetOptimized(ABaseUnit* Target)
         if (SpatialGrid)
         {
             // Pobierz jednostki w promieniu 2x prędkości
-            TArray<ABaseUnit*> NearbyUnits = SpatialGrid->GetUnitsInRange(GetActorLocation(), Speed * 2.0f);
+            TArray<ABaseUnit*> NearbyUnits = SpatialGrid->GetUnitsInRange(GetActorLocation(), GetArchetype()->Speed * 2.0f);
 
             // Sprawdź czy ścieżka do celu jest wolna
-            if (IsPathClearToTarget(Target, NearbyUnits))
+            if (!bFindDetour && IsPathClearToTarget(Target, NearbyUnits))
             {
                 // Bezpośrednia ścieżka wolna - ruszaj prosto
-                MoveTowardsTarget(Target);
+                MoveTowardsTarget(Target, DeltaTime);
                 return;
             }
             else
             {
-                // Ścieżka zablokowana - znajdź alternatywną trasę
+                // Ścieżka zablokowana - trasa z serwisu ścieżek, a do jej nadejścia alternatywny kierunek
+                FVector PathDirection;
+                if (GetGridPathDirection(GetTargetRange(Target), PathDirection))
+                {
+                    MoveTowardsTarget(Target, DeltaTime);
+                    return;
+                }
+
                 FVector AlternativePosition = FindAlternativeMovementPosition(Target, NearbyUnits);
                 if (!AlternativePosition.IsZero())
                 {
-                    MoveToWorldPosition(AlternativePosition);
+                    // Objazd do innej komórki też przechodzi przez tablicę rezerwacji
+                    if (RequestReservedMove(AlternativePosition, GetTargetRange(Target)))
+                    {
+                        MoveToWorldPosition(AlternativePosition);
+                    }
                     return;
                 }
             }
@@ -1388,7 +1594,7 @@ void ABaseUnit::MoveTowardsTargetOptimized(ABaseUnit* Target)
     }
 
     // Fallback do podstawowego ruchu
-    MoveTowardsTarget(Target);
+    MoveTowardsTarget(Target, DeltaTime);
 }
 
 /// <summary>
@@ -1423,7 +1629,7 @@ bool ABaseUnit::IsPathClearToTarget(ABaseUnit* Target, const TArray<ABaseUnit*>&
         {
             float DistanceToUnit = ToUnit.Size();
             // Sprawdź czy blokuje ścieżkę
-            if (DistanceToUnit < DistanceToTarget && DistanceToUnit < Speed * 1.5f)
+            if (DistanceToUnit < DistanceToTarget && DistanceToUnit < GetArchetype()->Speed * 1.5f)
             {
                 return false; // Jednostka blokuje ścieżkę
             }
@@ -1457,7 +1663,7 @@ FVector ABaseUnit::FindAlternativeMovementPosition(ABaseUnit* Target, const TArr
         float Angle = AngleStep * i;
         // Obróć kierunek o kąt
         FVector TestDirection = BaseDirection.RotateAngleAxis(Angle, FVector::UpVector);
-        FVector TestPosition = MyPosition + (TestDirection * Speed);
+        FVector TestPosition = MyPosition + (TestDirection * GetArchetype()->Speed);
         TestPosition.Z = MyPosition.Z; // Zachowaj wysokość
 
         // Sprawdź czy pozycja jest wolna
@@ -1492,7 +1698,8 @@ FVector ABaseUnit::FindAlternativeMovementPosition(ABaseUnit* Target, const TArr
 /// Ruch w danym kierunku
 /// </summary>
 /// <param name="Target">Aktualny cel ataku</param>
-void ABaseUnit::MoveTowardsTarget(ABaseUnit* Target)
+/// <param name="DeltaTime">Czas od poprzedniej decyzji ruchu - długość kroku w ruchu wsadowym</param>
+void ABaseUnit::MoveTowardsTarget(ABaseUnit* Target, float DeltaTime)
 {
     // Tylko serwer kontroluje ruch
     if (!HasAuthority())
@@ -1510,18 +1717,19 @@ void ABaseUnit::MoveTowardsTarget(ABaseUnit* Target)
         return;
     }
 
-    // Oblicz odległość do celu
+    // Odległość i kierunek do celu z bufora ticka
+    const FTargetRangeCache& Range = GetTargetRange(Target);
     FVector MyPosition = GetActorLocation();
     FVector TargetPosition = Target->GetActorLocation();
-    float DistanceToTarget = FVector::Dist(MyPosition, TargetPosition);
+    const float DistanceToTarget = FMath::Sqrt(Range.DistanceSq);
 
     UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Unit %s -> Target %s ==="), *GetName(), *Target->GetName());
     UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: MyPos(%f,%f,%f) -> TargetPos(%f,%f,%f) ==="),
         MyPosition.X, MyPosition.Y, MyPosition.Z, TargetPosition.X, TargetPosition.Y, TargetPosition.Z);
-    UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Distance: %f, AttackRange: %f ==="), DistanceToTarget, AttackRange);
+    UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Distance: %f, AttackRange: %f ==="), DistanceToTarget, GetArchetype()->AttackRange);
 
     // Sprawdz czy jest w zasięgu
-    if (DistanceToTarget <= AttackRange)
+    if (Range.bInRange)
     {
         UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Unit %s is in attack range, stopping movement ==="), *GetName());
         // W zasięgu - obróć się do celu i zatrzymaj
@@ -1532,38 +1740,53 @@ void ABaseUnit::MoveTowardsTarget(ABaseUnit* Target)
     }
 
     float CurrentTime = GetWorld()->GetTimeSeconds();
-    if (CurrentTime - LastMovementTime < MovementInterval)
+    if (!bMovementReady)
     {
         UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Movement on cooldown - Time: %f, LastMove: %f, Interval: %f ==="),
-            CurrentTime, LastMovementTime, MovementInterval);
+            CurrentTime, LastMovementTime, GetArchetype()->MovementInterval);
         return;
     }
 
     UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Starting movement towards target ==="));
 
-    // Ustaw cel i animacje
+    // Ustaw cel i animacje - jednostka stojąca dotąd w miejscu rusza krótszym krokiem
+    const bool bStartingMove = !bIsMovingToTarget;
     SetTarget(Target);
     bIsMovingToTarget = true;
     SetAnimationState(EAnimationState::Moving);
 
-    // Oblicz kierunek ruchu
-    FVector Direction = (TargetPosition - MyPosition);
-    Direction.Z = 0; // Zeruj składową Z (ruch tylko w płaszczyźnie XY)
-    Direction = Direction.GetSafeNormal();
+    // Kierunek ruchu (tylko płaszczyzna XY) - z pola przepływu lub bezpośrednio na cel
+    const FVector Direction = GetMovementDirection(Range);
 
     UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Movement direction: (%f,%f,%f) ==="),
         Direction.X, Direction.Y, Direction.Z);
 
+    // Unikanie zatrzymało jednostkę - czeka w miejscu, aż sąsiad zrobi miejsce
+    if (Direction.IsNearlyZero())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Unit %s waiting for neighbours to make room ==="), *GetName());
+        // Czas czekania w miejscu nie wydłuża następnego kroku
+        LastMovementDecisionTime = CurrentTime;
+        return;
+    }
+
     // Obróć się w kierunku celu
     RotateTowardsTarget(Target);
 
     // Oblicz następną pozycję
-    FVector NextPosition = MyPosition + (Direction * Speed);
+    FVector NextPosition = GetNextStepPosition(MyPosition, Direction, DeltaTime, bStartingMove);
     NextPosition.Z = MyPosition.Z; // Zachowaj wysokość
 
     UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: NextPosition calculated: (%f,%f,%f) ==="),
         NextPosition.X, NextPosition.Y, NextPosition.Z);
 
+    // Krok do innej komórki czeka na rezerwację - wykonuje go manager po rozstrzygnięciu konfliktów
+    if (!RequestReservedMove(NextPosition, Range))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Unit %s waiting for cell reservation ==="), *GetName());
+        return;
+    }
+
     // Wykonaj ruch
     if (CanMoveToWorldPosition(NextPosition))
     {
@@ -1573,6 +1796,8 @@ void ABaseUnit::MoveTowardsTarget(ABaseUnit* Target)
         if (bMoveSuccess)
         {
             LastMovementTime = CurrentTime;
+            bMovementReady = false;
+            ScheduleCombatTimer(ECombatTimerAction::MovementReady, GetArchetype()->MovementInterval);
             UE_LOG(LogTemp, Warning, TEXT("=== SERVER MOVEMENT DEBUG: Movement successful, LastMovementTime updated to %f ==="), LastMovementTime);
         }
         else
@@ -1605,14 +1830,12 @@ bool ABaseUnit::CanAttackTarget(ABaseUnit* Target) const
     if (!Target->bIsAlive)
         return false;
 
-    // Sprawdź odległość
-    float Distance = FVector::Dist(GetActorLocation(), Target->GetActorLocation());
-    if (Distance > AttackRange)
+    // Sprawdź cooldown ataku (flaga ustawiana przez koło czasowe) przed odległością
+    if (!bAttackReady)
         return false;
 
-    // Sprawdź cooldown ataku
-    float CurrentTime = GetWorld()->GetTimeSeconds();
-    if (CurrentTime - LastAttackTime < AttackCooldown)
+    // Sprawdź odległość
+    if (!GetTargetRange(Target).bInRange)
         return false;
 
     return true;
@@ -1636,6 +1859,8 @@ void ABaseUnit::PerformAttack(ABaseUnit* Target)
     bIsAttacking = true;
     SetAnimationState(EAnimationState::Attacking);
     LastAttackTime = GetWorld()->GetTimeSeconds();
+    bAttackReady = false;
+    ScheduleCombatTimer(ECombatTimerAction::AttackReady, GetArchetype()->AttackCooldown);
 
     // Wykonaj atak
     if (AttackTarget(Target))
@@ -1645,16 +1870,436 @@ void ABaseUnit::PerformAttack(ABaseUnit* Target)
     }
 
     // Timer resetujący stan ataku
-    FTimerHandle AttackResetTimer;
-    GetWorldTimerManager().SetTimer(AttackResetTimer, [this]()
+    ScheduleCombatTimer(ECombatTimerAction::AttackReset, 0.5f);
+}
+
+/// <summary>
+/// Zaplanowanie akcji czasowej w kole czasowym UnitManagera
+/// </summary>
+/// <param name="Action">Akcja do wykonania</param>
+/// <param name="Delay">Opóźnienie w sekundach</param>
+void ABaseUnit::ScheduleCombatTimer(ECombatTimerAction Action, float Delay)
+{
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    if (UnitManager && UnitManager->ScheduleUnitTimer(this, Action, Delay))
+    {
+        return;
+    }
+
+    // Brak managera - pojedynczy timer silnika jako rozwiązanie awaryjne
+    FTimerHandle FallbackTimer;
+    GetWorldTimerManager().SetTimer(FallbackTimer,
+        FTimerDelegate::CreateUObject(this, &ABaseUnit::HandleCombatTimer, Action), Delay, false);
+}
+
+/// <summary>
+/// Pobranie managera jednostek z pamięci podręcznej - wyszukiwany tylko raz na jednostkę
+/// </summary>
+/// <returns>Manager jednostek lub nullptr</returns>
+AUnitManager* ABaseUnit::GetCachedUnitManager()
+{
+    if (!IsValid(CachedUnitManager) && GetWorld())
+    {
+        for (TActorIterator<AUnitManager> ActorIterator(GetWorld()); ActorIterator; ++ActorIterator)
+        {
+            CachedUnitManager = *ActorIterator;
+            break;
+        }
+    }
+
+    return IsValid(CachedUnitManager) ? CachedUnitManager : nullptr;
+}
+
+/// <summary>
+/// Kierunek kolejnego kroku - członek oddziału idzie za liderem, utrzymując miejsce w szyku;
+/// pozostali (i lider) biorą wektor z komórki pola przepływu drużyny, a blisko celu
+/// (lub bez pola) idą bezpośrednio na cel. Wynik jest korygowany przez unikanie kolizji z sojusznikami
+/// </summary>
+/// <param name="Range">Odległość i kierunek do celu z bufora ticka</param>
+/// <returns>Kierunek w płaszczyźnie XY o długości do 1 - ułamek Speed po unikaniu (zero - jednostka czeka, aż sąsiad zrobi miejsce)</returns>
+FVector ABaseUnit::GetMovementDirection(const FTargetRangeCache& Range)
+{
+    AUnitManager* UnitManager = GetCachedUnitManager();
+
+    FVector SquadDirection;
+    if (UnitManager && UnitManager->GetSquadMoveDirection(this, Range, SquadDirection))
+    {
+        return ApplyAvoidance(SquadDirection);
+    }
+
+    FVector Direction = Range.Direction;
+    FVector FlowDirection;
+    FVector PathDirection;
+    if (UnitManager && UnitManager->SampleFlowDirection(TeamID, GetActorLocation(), Range.DistanceSq, FlowDirection))
+    {
+        Direction = FlowDirection;
+    }
+    // Prosta droga do celu zajęta przez inne jednostki - kierunek do następnej komórki trasy
+    else if (GetGridPathDirection(Range, PathDirection))
+    {
+        Direction = PathDirection;
+    }
+
+    // Jedno zapytanie o pole lub trasę na oddział - kierunek lidera przejmują pozostali członkowie
+    if (UnitManager)
+    {
+        UnitManager->ReportSquadLeaderDirection(this, Direction);
+    }
+
+    return ApplyAvoidance(Direction);
+}
+
+/// <summary>
+/// Zapamiętuje pożądaną prędkość dla migawki unikania i łączy ją z prędkością ORCA policzoną
+/// przez manager w poprzednim ticku. Wynik zachowuje zwolnienie z ORCA - krok skraca się
+/// proporcjonalnie, a zerowa prędkość oznacza czekanie w miejscu
+/// </summary>
+/// <param name="DesiredDirection">Znormalizowany kierunek z pola przepływu, trasy lub na cel</param>
+/// <returns>Prędkość po unikaniu jako ułamek Speed (długość od 0 do 1)</returns>
+FVector ABaseUnit::ApplyAvoidance(const FVector& DesiredDirection)
+{
+    const float Speed = GetArchetype()->Speed;
+    PreferredVelocity = FVector2D(DesiredDirection.X, DesiredDirection.Y) * Speed;
+    PreferredVelocityFrame = GFrameCounter;
+
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    if (!bHasAvoidanceVelocity || !UnitManager || !UnitManager->IsLocalAvoidanceEnabled() || Speed <= KINDA_SMALL_NUMBER)
+    {
+        return DesiredDirection;
+    }
+
+    const FVector2D Blended = FMath::Lerp(PreferredVelocity, AvoidanceVelocity, UnitManager->GetAvoidanceBlendWeight());
+    return FVector(Blended.X, Blended.Y, 0.0f).GetClampedToMaxSize(Speed) / Speed;
+}
+
+/// <summary>
+/// Prędkość pożądana zgłoszona w tej klatce (zero, jeśli jednostka w tej klatce nie szła)
+/// </summary>
+FVector2D ABaseUnit::GetPreferredVelocity() const
+{
+    return PreferredVelocityFrame == GFrameCounter ? PreferredVelocity : FVector2D::ZeroVector;
+}
+
+/// <summary>
+/// Wynik ORCA z managera - używany w kolejnym kroku i jako bieżąca prędkość w następnej migawce
+/// </summary>
+/// <param name="Velocity">Prędkość bez kolizji w jednostkach świata na krok</param>
+void ABaseUnit::SetAvoidanceVelocity(const FVector2D& Velocity)
+{
+    AvoidanceVelocity = Velocity;
+    bHasAvoidanceVelocity = true;
+}
+
+/// <summary>
+/// Pozycja po kolejnym kroku. W ruchu wsadowym krok jest całkowany z czasem od poprzedniej
+/// decyzji (Speed na MovementStepTime managera), w przeciwnym razie ma długość Speed.
+/// Pierwszy krok po postoju ma najwyżej jeden krok referencyjny - czas ataku czy czekania na cel
+/// nie jest nadrabiany krokiem dłuższym niż komórka, który ominąłby rezerwację kolejnej komórki
+/// </summary>
+/// <param name="From">Aktualna pozycja</param>
+/// <param name="Direction">Kierunek ruchu o długości do 1 - krótszy wektor (zwolnienie z unikania) skraca krok</param>
+/// <param name="DeltaTime">Czas od poprzedniego kroku</param>
+/// <param name="bStartingMove">Czy jednostka rusza z postoju</param>
+/// <returns>Pozycja po kroku</returns>
+FVector ABaseUnit::GetNextStepPosition(const FVector& From, const FVector& Direction, float DeltaTime, bool bStartingMove)
+{
+    LastMovementDecisionTime = GetWorld()->GetTimeSeconds();
+
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    if (!UnitManager || !UnitManager->IsBatchedMovementEnabled())
+    {
+        MoveStepScale = 1.0f;
+        return From + (Direction * GetArchetype()->Speed);
+    }
+
+    const float StepTime = UnitManager->GetMovementStepTime();
+    const float StepDeltaTime = bStartingMove ? FMath::Min(DeltaTime, StepTime) : DeltaTime;
+
+    MoveStepScale = FBatchedUnitMover::GetStepScale(StepTime, StepDeltaTime);
+    return FBatchedUnitMover::IntegrateStep(From, Direction, GetArchetype()->Speed, StepTime, StepDeltaTime);
+}
+
+/// <summary>
+/// Zapis kroku z kolejki ruchu wsadowego - bez RPC, klienci dostają pozycje w partiach managera
+/// </summary>
+/// <param name="NewLocation">Pozycja po kroku</param>
+void ABaseUnit::ApplyBatchedMove(const FVector& NewLocation)
+{
+    const FVector OldPosition = GetActorLocation();
+    SetLocationDeferred(NewLocation);
+    InvalidateTargetRange();
+
+    OnMovementCompleted(OldPosition, NewLocation);
+    OnBaseUnitMoved.Broadcast(this);
+}
+
+/// <summary>
+/// Pozycja jednostki z partii MulticastUnitPositions (tylko klienci)
+/// </summary>
+/// <param name="NewLocation">Pozycja na serwerze</param>
+void ABaseUnit::ApplyReplicatedPosition(const FVector& NewLocation)
+{
+    if (HasAuthority())
+        return;
+
+    const FVector OldPosition = GetActorLocation();
+    SetLocationDeferred(NewLocation);
+
+    SetAnimationState(EAnimationState::Moving);
+    OnMovementCompleted(OldPosition, NewLocation);
+}
+
+/// <summary>
+/// Obrót w kierunku ruchu i przesunięcie bez sweepa. Komponenty potomne (siatka, pasek zdrowia)
+/// są aktualizowane raz, na końcu zakresu FScopedMovementUpdate. Replikowane WorldPosition nie jest
+/// tu zapisywane - w ruchu wsadowym pozycje trafiają do klientów tylko partiami MulticastUnitPositions
+/// </summary>
+/// <param name="NewLocation">Nowa pozycja</param>
+void ABaseUnit::SetLocationDeferred(const FVector& NewLocation)
+{
+    FScopedMovementUpdate ScopedMovement(GetRootComponent(), EScopedUpdate::DeferredUpdates);
+
+    const FVector MovementDirection = (NewLocation - GetActorLocation()).GetSafeNormal();
+    if (!MovementDirection.IsNearlyZero())
+    {
+        RotateTowardsDirection(MovementDirection);
+    }
+
+    GetRootComponent()->SetWorldLocation(NewLocation, false, nullptr, ETeleportType::None);
+}
+
+/// <summary>
+/// Czyszczenie stanu unikania przy starcie walki i powrocie do puli
+/// </summary>
+void ABaseUnit::ResetAvoidance()
+{
+    PreferredVelocity = FVector2D::ZeroVector;
+    PreferredVelocityFrame = MAX_uint64;
+    AvoidanceVelocity = FVector2D::ZeroVector;
+    bHasAvoidanceVelocity = false;
+}
+
+/// <summary>
+/// Kierunek do następnej komórki trasy z serwisu ścieżek. Gdy trasy nie ma, a komórka na prostej
+/// drodze do celu jest zajęta, zleca wyszukanie trasy - wynik przychodzi w kolejnym ticku
+/// </summary>
+/// <param name="Range">Odległość i kierunek do celu z bufora ticka</param>
+/// <param name="OutDirection">Znormalizowany kierunek w płaszczyźnie XY</param>
+/// <returns>true jeśli jednostka powinna iść według trasy, false - wpp</returns>
+bool ABaseUnit::GetGridPathDirection(const FTargetRangeCache& Range, FVector& OutDirection)
+{
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    FGridCell MyCell;
+    FGridCell TargetCell;
+    if (!Range.Target || !UnitManager ||
+        !UnitManager->GetPathCell(GetActorLocation(), MyCell) ||
+        !UnitManager->GetPathCell(Range.Target->GetActorLocation(), TargetCell))
+    {
+        return false;
+    }
+
+    // Cel zmienił komórkę - dotychczasowa trasa jest nieaktualna
+    if (TargetCell != GridPathGoal)
+    {
+        ResetGridPath();
+        GridPathGoal = TargetCell;
+    }
+
+    if (GridPath.Num() > 0)
+    {
+        // Komórka jednostki na trasie - następna komórka staje się punktem docelowym
+        for (int32 PathIndex = GridPathIndex; PathIndex < GridPath.Num(); PathIndex++)
         {
-            bIsAttacking = false;
-            // Jeśli nie porusza się do celu, wróć do bezczynności
-            if (!bIsMovingToTarget)
+            if (GridPath[PathIndex] == MyCell)
             {
-                SetAnimationState(EAnimationState::Idle);
+                GridPathIndex = PathIndex + 1;
+                break;
             }
-        }, 0.5f, false);
+        }
+
+        // Ostatnia komórka trasy to komórka celu - od przedostatniej jednostka idzie prosto na cel
+        if (GridPathIndex < GridPath.Num() - 1)
+        {
+            const FVector Delta = UnitManager->GetPathCellWorldLocation(GridPath[GridPathIndex]) - GetActorLocation();
+            OutDirection = FVector(Delta.X, Delta.Y, 0.0f).GetSafeNormal();
+            return !OutDirection.IsNearlyZero();
+        }
+
+        ResetGridPath();
+        GridPathGoal = TargetCell;
+        return false;
+    }
+
+    // Trasa potrzebna tylko, gdy następna komórka na prostej drodze jest zajęta
+    FGridCell NextCell;
+    if (!UnitManager->GetPathCell(GetActorLocation() + Range.Direction * GridSize, NextCell) ||
+        NextCell == MyCell || NextCell == TargetCell || !UnitManager->IsPathCellBlocked(NextCell))
+    {
+        return false;
+    }
+
+    if (PendingGridPathRequest == INDEX_NONE)
+    {
+        PendingGridPathRequest = UnitManager->RequestUnitPath(this, MyCell, TargetCell);
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Odbiór trasy z serwisu ścieżek. Trasa do komórki, którą cel już opuścił, jest odrzucana
+/// </summary>
+/// <param name="Result">Wynik zapytania</param>
+void ABaseUnit::ReceiveGridPath(const FGridPathResult& Result)
+{
+    if (Result.RequestID != PendingGridPathRequest)
+        return;
+
+    PendingGridPathRequest = INDEX_NONE;
+    if (Result.bFound && Result.Path.Num() > 0 && Result.Path.Last() == GridPathGoal)
+    {
+        GridPath = Result.Path;
+        GridPathIndex = 1;
+    }
+}
+
+/// <summary>
+/// Krok ruchu przez tablicę rezerwacji komórek. Krok w obrębie własnej komórki nie wymaga
+/// rezerwacji; krok do innej komórki jest zgłaszany z priorytetem i wykonywany dopiero
+/// w ResolveReservedMove, gdy zgłoszenie wygra
+/// </summary>
+/// <param name="NextPosition">Pozycja po kroku</param>
+/// <param name="Range">Zasięg do bieżącego celu</param>
+/// <returns>true jeśli krok można wykonać od razu, false - wpp</returns>
+bool ABaseUnit::RequestReservedMove(const FVector& NextPosition, const FTargetRangeCache& Range)
+{
+    AUnitManager* UnitManager = GetCachedUnitManager();
+    FGridCell MyCell;
+    FGridCell NextCell;
+    if (!UnitManager || !UnitManager->IsCellReservationEnabled() ||
+        !UnitManager->GetPathCell(GetActorLocation(), MyCell) ||
+        !UnitManager->GetPathCell(NextPosition, NextCell) || NextCell == MyCell)
+    {
+        return true;
+    }
+
+    // Zgłoszenie z tego ticku czeka już na rozstrzygnięcie
+    if (bHasReservedMove)
+        return false;
+
+    // Bliżej celu = wyższy priorytet - czoło oddziału wchodzi pierwsze, dalsze szeregi czekają
+    const float Distance = FMath::Min(FMath::Sqrt(Range.DistanceSq) / 10.0f, static_cast<float>(FCellReservationTable::MaxMovePriority));
+    const uint32 Priority = FCellReservationTable::MaxMovePriority - static_cast<uint32>(Distance);
+
+    // Komórka własnego celu jest zajęta, ale jednostka o krótkim zasięgu musi móc do niej wejść
+    FGridCell TargetCell;
+    const bool bEntersTargetCell = Range.Target && UnitManager->GetPathCell(Range.Target->GetActorLocation(), TargetCell) && TargetCell == NextCell;
+
+    if (UnitManager->ClaimMoveCell(this, NextCell, Priority, bEntersTargetCell))
+    {
+        bHasReservedMove = true;
+        ReservedMovePosition = NextPosition;
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Wynik zgłoszenia ruchu - zwycięzca wykonuje krok, przegrany zostaje w swojej komórce
+/// i przy kolejnej decyzji szuka objazdu
+/// </summary>
+/// <param name="bGranted">true jeśli komórka została przydzielona tej jednostce</param>
+/// <returns>true jeśli jednostka wykonała krok i opuściła swoją komórkę, false - wpp</returns>
+bool ABaseUnit::ResolveReservedMove(bool bGranted)
+{
+    if (!bHasReservedMove)
+        return false;
+
+    bHasReservedMove = false;
+    if (!bGranted)
+    {
+        bLostCellReservation = true;
+        return false;
+    }
+
+    if (!bIsAlive || !bCanMove)
+        return false;
+
+    if (!CanMoveToWorldPosition(ReservedMovePosition) || !MoveToWorldPosition(ReservedMovePosition))
+        return false;
+
+    LastMovementTime = GetWorld()->GetTimeSeconds();
+    if (bMovementReady)
+    {
+        bMovementReady = false;
+        ScheduleCombatTimer(ECombatTimerAction::MovementReady, GetArchetype()->MovementInterval);
+    }
+    return true;
+}
+
+/// <summary>
+/// Porzucenie trasy i zapytania w toku
+/// </summary>
+void ABaseUnit::ResetGridPath()
+{
+    GridPath.Reset();
+    GridPathIndex = 0;
+    PendingGridPathRequest = INDEX_NONE;
+    GridPathGoal = FGridCell(INDEX_NONE, INDEX_NONE);
+}
+
+/// <summary>
+/// Wykonanie akcji czasowej, której termin minął
+/// </summary>
+/// <param name="Action">Akcja do wykonania</param>
+void ABaseUnit::HandleCombatTimer(ECombatTimerAction Action)
+{
+    switch (Action)
+    {
+    case ECombatTimerAction::AttackReset:
+        bIsAttacking = false;
+        // Jeśli nie porusza się do celu, wróć do bezczynności
+        if (!bIsMovingToTarget)
+        {
+            SetAnimationState(EAnimationState::Idle);
+        }
+        break;
+
+    case ECombatTimerAction::HideHealthBar:
+        if (!GetArchetype()->bHealthBarAlwaysVisible && CurrentHealth > 0)
+        {
+            HideHealthBar();
+        }
+        break;
+
+    case ECombatTimerAction::DeathFinished:
+        SetAnimationState(EAnimationState::Dead);
+        // Tylko serwer usuwa aktora - z managerem wraca on do puli zamiast niszczenia
+        if (HasAuthority())
+        {
+            if (AUnitManager* UnitManager = GetCachedUnitManager())
+            {
+                UnitManager->ReleaseUnit(this);
+            }
+            else
+            {
+                Destroy();
+            }
+        }
+        break;
+
+    case ECombatTimerAction::AttackReady:
+        bAttackReady = true;
+        break;
+
+    case ECombatTimerAction::MovementReady:
+        bMovementReady = true;
+        break;
+
+    case ECombatTimerAction::TargetSearchReady:
+        bTargetSearchReady = true;
+        break;
+    }
 }
 
 
@@ -1675,9 +2320,9 @@ void ABaseUnit::UpdateCombatBehavior(float DeltaTime)
     // Sprawdz stan obecnego celu
     if (HasValidTarget())
     {
-        float Distance = GetDistanceToCurrentTarget();
+        const FTargetRangeCache& Range = GetTargetRange(CurrentTarget);
         UE_LOG(LogTemp, Warning, TEXT("=== COMBAT BEHAVIOR: Distance to target %s: %f, AttackRange: %f ==="),
-            *CurrentTarget->GetName(), Distance, AttackRange);
+            *CurrentTarget->GetName(), FMath::Sqrt(Range.DistanceSq), GetArchetype()->AttackRange);
 
         // Atak - Jeśli w zasięgu i gotowy do ataku 
         if (CanAttackTarget(CurrentTarget))
@@ -1692,23 +2337,29 @@ void ABaseUnit::UpdateCombatBehavior(float DeltaTime)
             UE_LOG(LogTemp, Warning, TEXT("=== COMBAT BEHAVIOR: Unit %s continuing movement towards target ==="), *GetName());
 
             // Jeśli wciąż za daleko, kontynuuj ruch
-            if (Distance > AttackRange)
+            if (!Range.bInRange)
             {
                 FVector MyPosition = GetActorLocation();
-                FVector TargetPosition = CurrentTarget->GetActorLocation();
-                FVector Direction = (TargetPosition - MyPosition);
-                Direction.Z = 0;
-                Direction = Direction.GetSafeNormal();
 
                 // Oblicz następną pozycję
-                FVector NextPosition = MyPosition + (Direction * Speed);
+                const FVector Direction = GetMovementDirection(Range);
+                FVector NextPosition = GetNextStepPosition(MyPosition, Direction, DeltaTime);
                 NextPosition.Z = MyPosition.Z;
 
                 UE_LOG(LogTemp, Warning, TEXT("=== COMBAT BEHAVIOR: Calculated next position: (%f,%f,%f) ==="),
                     NextPosition.X, NextPosition.Y, NextPosition.Z);
 
-                // Próbuj się poruszyć
-                if (CanMoveToWorldPosition(NextPosition))
+                // Unikanie zatrzymało jednostkę - czeka w miejscu, aż sąsiad zrobi miejsce
+                if (Direction.IsNearlyZero())
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("=== COMBAT BEHAVIOR: Unit %s waiting for neighbours to make room ==="), *GetName());
+                }
+                // Próbuj się poruszyć - krok do innej komórki najpierw przez tablicę rezerwacji
+                else if (!RequestReservedMove(NextPosition, Range))
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("=== COMBAT BEHAVIOR: Unit %s waiting for cell reservation ==="), *GetName());
+                }
+                else if (CanMoveToWorldPosition(NextPosition))
                 {
                     UE_LOG(LogTemp, Warning, TEXT("=== COMBAT BEHAVIOR: Moving unit %s from (%f,%f,%f) to (%f,%f,%f) ==="),
                         *GetName(), MyPosition.X, MyPosition.Y, MyPosition.Z,
@@ -1718,6 +2369,12 @@ void ABaseUnit::UpdateCombatBehavior(float DeltaTime)
                     if (bMoveSuccess)
                     {
                         LastMovementTime = GetWorld()->GetTimeSeconds();
+                        // Jeden wpis w kole na okres interwału, a nie na każdą klatkę ruchu
+                        if (bMovementReady)
+                        {
+                            bMovementReady = false;
+                            ScheduleCombatTimer(ECombatTimerAction::MovementReady, GetArchetype()->MovementInterval);
+                        }
                         UE_LOG(LogTemp, Warning, TEXT("=== COMBAT BEHAVIOR: Movement successful ==="));
                     }
                     else
@@ -1773,7 +2430,7 @@ bool ABaseUnit::CanMoveToWorldPosition(FVector NewWorldPosition) const
 
     // Sprawdź dystans ruchu
     float MovementDistance = FVector::Dist(GetActorLocation(), NewWorldPosition);
-    float MaxMovement = Speed * 1.5f; // Maksymalna odległość za jeden ruch
+    float MaxMovement = GetArchetype()->Speed * FMath::Max(MoveStepScale, 1.0f) * 1.5f; // Maksymalna odległość za jeden ruch
 
     UE_LOG(LogTemp, Warning, TEXT("=== CanMoveToWorldPosition: Unit %s - Distance: %f, MaxMovement: %f ==="),
         *GetName(), MovementDistance, MaxMovement);
@@ -1785,6 +2442,13 @@ bool ABaseUnit::CanMoveToWorldPosition(FVector NewWorldPosition) const
         return false;
     }
 
+    // Przeszkoda w warstwie nawigacji planszy - bez zapytań fizyki
+    if (CachedUnitManager && !CachedUnitManager->IsWorldPositionNavigable(NewWorldPosition))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== CanMoveToWorldPosition: Target cell is blocked for unit %s ==="), *GetName());
+        return false;
+    }
+
     UE_LOG(LogTemp, Warning, TEXT("=== CanMoveToWorldPosition: Unit %s can move to position ==="), *GetName());
     return true;
 }
@@ -1839,7 +2503,7 @@ void ABaseUnit::RotateTowardsDirection(FVector Direction)
         // Płynna rotacja - interpolacja
         FRotator CurrentRotation = GetActorRotation();
         float DeltaTime = GetWorld()->GetDeltaSeconds();
-        FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, RotationSpeed);
+        FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, GetArchetype()->RotationSpeed);
         SetActorRotation(NewRotation);
     }
     else
@@ -1867,7 +2531,7 @@ void ABaseUnit::RotateTowardsDirection(FVector Direction, float DeltaTime)
     if (bSmoothRotation)
     {
         FRotator CurrentRotation = GetActorRotation();
-        FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, RotationSpeed);
+        FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, DeltaTime, GetArchetype()->RotationSpeed);
         SetActorRotation(NewRotation);
     }
     else
@@ -1907,4 +2571,102 @@ void ABaseUnit::HideUnit()
 
     // Ukryj pasek zdrowia
     HideHealthBar();
-}
\ No newline at end of file
+}
+
+/// <summary>
+/// Odłożenie jednostki do puli - zatrzymanie walki i timerów, ukrycie, wyłączenie kolizji i Ticka
+/// </summary>
+void ABaseUnit::DeactivateForPool()
+{
+    if (bInUnitPool)
+        return;
+
+    bAutoCombatEnabled = false;
+    WakeFromCombatSleep();
+    ResetGridPath();
+    bHasReservedMove = false;
+    bLostCellReservation = false;
+    ResetAvoidance();
+
+    CurrentTarget = nullptr;
+    bIsAttacking = false;
+    bIsMovingToTarget = false;
+
+    // Zaległe wpisy koła czasowego (np. reset ataku) nie mogą trafić w jednostkę po ponownym użyciu
+    if (IsValid(CachedUnitManager))
+    {
+        CachedUnitManager->ReleaseUnitTimerSlot(this);
+    }
+
+    bInUnitPool = true;
+    HideUnit();
+
+    UE_LOG(LogTemp, Verbose, TEXT("=== PULA JEDNOSTEK: %s zwrócona do puli ==="), *GetName());
+}
+
+/// <summary>
+/// Wyjęcie jednostki z puli z pełnym resetem stanu - odpowiednik świeżego spawnu
+/// </summary>
+/// <param name="Location">Pozycja w świecie</param>
+/// <param name="Rotation">Rotacja jednostki</param>
+void ABaseUnit::ActivateFromPool(const FVector& Location, const FRotator& Rotation)
+{
+    SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+    WorldPosition = Location;
+
+    // Stan bojowy jak po konstruktorze
+    CurrentHealth = GetArchetype()->MaxHealth;
+    bIsAlive = true;
+    bCanMove = true;
+    bCanAttack = true;
+
+    CurrentTarget = nullptr;
+    bIsAttacking = false;
+    bIsMovingToTarget = false;
+    bAutoCombatEnabled = false;
+    bCombatSleeping = false;
+
+    bAttackReady = true;
+    bMovementReady = true;
+    bTargetSearchReady = true;
+    LastAttackTime = 0.0f;
+    LastMovementTime = 0.0f;
+    LastTargetSearchTime = 0.0f;
+    LastCombatUpdateTime = -1.0f;
+    LastMovementDecisionTime = -1.0f;
+    InvalidateTargetRange();
+
+    SetAnimationState(EAnimationState::Idle);
+
+    bInUnitPool = false;
+    SetActorHiddenInGame(false);
+    SetActorEnableCollision(true);
+    SetActorTickEnabled(true);
+
+    // Pasek zdrowia wraca do stanu początkowego
+    SetupHealthBar();
+    UpdateHealthBar();
+
+    // Event spawnu jak przy nowym aktorze
+    OnUnitSpawned();
+
+    UE_LOG(LogTemp, Verbose, TEXT("=== PULA JEDNOSTEK: %s ponownie użyta z puli ==="), *GetName());
+}
+
+/// <summary>
+/// Replikacja stanu puli - klient przełącza kolizję, Tick i pasek zdrowia (widoczność replikuje silnik)
+/// </summary>
+void ABaseUnit::OnRep_bInUnitPool()
+{
+    if (bInUnitPool)
+    {
+        HideUnit();
+    }
+    else
+    {
+        SetActorEnableCollision(true);
+        SetActorTickEnabled(true);
+        SetupHealthBar();
+        UpdateHealthBar();
+    }
+}
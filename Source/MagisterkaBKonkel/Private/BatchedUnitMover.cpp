@@ -0,0 +1,133 @@
+// BatchedUnitMover.cpp - Implementacja kolejki ruchow jednostek zapisywanej jednym przebiegiem
+#include "BatchedUnitMover.h"
+#include "BaseUnit.h"
+
+/// <summary>
+/// Calkowanie predkosci: StepLength / StepTime jednostek swiata na sekunde przez DeltaTime sekund.
+/// </summary>
+/// <param name="From">Aktualna pozycja</param>
+/// <param name="Direction">Kierunek ruchu o dlugosci do 1 (ulamek predkosci)</param>
+/// <param name="StepLength">Dlugosc kroku (Speed jednostki)</param>
+/// <param name="StepTime">Czas kroku, dla ktorego dobrano StepLength</param>
+/// <param name="DeltaTime">Czas od poprzedniego kroku</param>
+/// <returns>Pozycja po kroku</returns>
+FVector FBatchedUnitMover::IntegrateStep(const FVector& From, const FVector& Direction, float StepLength, float StepTime, float DeltaTime)
+{
+    const FVector PlanarDirection = FVector(Direction.X, Direction.Y, 0.0f);
+    return From + PlanarDirection * (StepLength * GetStepScale(StepTime, DeltaTime));
+}
+
+/// <summary>
+/// Ile krokow referencyjnych miesci sie w DeltaTime (po przycieciu do MaxStepDeltaTime).
+/// </summary>
+float FBatchedUnitMover::GetStepScale(float StepTime, float DeltaTime)
+{
+    if (StepTime <= 0.0f)
+    {
+        return 1.0f;
+    }
+
+    return FMath::Clamp(DeltaTime, 0.0f, MaxStepDeltaTime) / StepTime;
+}
+
+/// <summary>
+/// Zgloszenie nowej pozycji jednostki. Kolejne zgloszenie tej samej jednostki w tej klatce zastepuje poprzednie.
+/// </summary>
+/// <param name="Unit">Jednostka</param>
+/// <param name="NewLocation">Pozycja docelowa kroku</param>
+void FBatchedUnitMover::QueueMove(ABaseUnit* Unit, const FVector& NewLocation)
+{
+    if (!Unit)
+    {
+        return;
+    }
+
+    if (const int32* ExistingIndex = QueuedMoveIndex.Find(Unit))
+    {
+        QueuedMoves[*ExistingIndex].Location = NewLocation;
+        return;
+    }
+
+    QueuedMoveIndex.Add(Unit, QueuedMoves.Num());
+    QueuedMoves.Add({ Unit, NewLocation });
+}
+
+/// <summary>
+/// Jeden przebieg zapisu transformacji po tickach jednostek. Jednostki, ktore w miedzyczasie
+/// zginely lub wrocily do puli, sa pomijane.
+/// </summary>
+/// <returns>Liczba wykonanych ruchow</returns>
+int32 FBatchedUnitMover::Flush()
+{
+    int32 AppliedMoves = 0;
+
+    for (const FQueuedMove& Move : QueuedMoves)
+    {
+        ABaseUnit* Unit = Move.Unit.Get();
+        if (!Unit || !Unit->bIsAlive || Unit->IsInUnitPool())
+        {
+            continue;
+        }
+
+        Unit->ApplyBatchedMove(Move.Location);
+        AppliedMoves++;
+
+        bool bAlreadyMoved = false;
+        MovedUnitSet.Add(Unit, &bAlreadyMoved);
+        if (!bAlreadyMoved)
+        {
+            MovedUnits.Add(Unit);
+        }
+    }
+
+    QueuedMoves.Reset();
+    QueuedMoveIndex.Reset();
+    return AppliedMoves;
+}
+
+/// <summary>
+/// Akumulator czasu publikacji pozycji - liczba wysylek nie zalezy od liczby klatek serwera.
+/// </summary>
+/// <param name="DeltaTime">Czas klatki</param>
+/// <param name="PublishInterval">Odstep miedzy publikacjami w sekundach</param>
+/// <returns>true jesli minal odstep publikacji, false - wpp</returns>
+bool FBatchedUnitMover::ConsumePublishTime(float DeltaTime, float PublishInterval)
+{
+    PublishAccumulator += DeltaTime;
+    if (PublishAccumulator < PublishInterval)
+    {
+        return false;
+    }
+
+    // Po dlugiej klatce jedna publikacja zamiast serii zaleglych
+    PublishAccumulator -= PublishInterval;
+    if (PublishAccumulator >= PublishInterval)
+    {
+        PublishAccumulator = 0.0f;
+    }
+    return true;
+}
+
+void FBatchedUnitMover::TakeMovedUnits(TArray<ABaseUnit*>& OutUnits)
+{
+    OutUnits.Reset(MovedUnits.Num());
+    for (const TWeakObjectPtr<ABaseUnit>& Unit : MovedUnits)
+    {
+        if (Unit.IsValid())
+        {
+            OutUnits.Add(Unit.Get());
+        }
+    }
+
+    MovedUnits.Reset();
+    MovedUnitSet.Reset();
+}
+
+void FBatchedUnitMover::Reset()
+{
+    QueuedMoves.Reset();
+    QueuedMoveIndex.Reset();
+    MovedUnits.Reset();
+    MovedUnitSet.Reset();
+    PublishAccumulator = 0.0f;
+}
@@ -0,0 +1,527 @@
+// BattleFlowField.cpp - Implementacja pola przeplywu druzyny na siatce bitwy
+#include "BattleFlowField.h"
+
+namespace
+{
+    // Kierunki sasiadow: 0 = +X, dalej przeciwnie do ruchu wskazowek zegara; parzyste sa ortogonalne
+    constexpr int32 NumFlowDirections = 8;
+    constexpr int32 DirectionOffsetX[NumFlowDirections] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+    constexpr int32 DirectionOffsetY[NumFlowDirections] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+
+    bool IsDiagonalDirection(int32 Direction)
+    {
+        return (Direction & 1) != 0;
+    }
+}
+
+/// <summary>
+/// Przygotowuje pole dla siatki o podanych wymiarach. Pole bez celow nie ma kierunkow.
+/// </summary>
+/// <param name="InWidth">Liczba komorek w osi X</param>
+/// <param name="InHeight">Liczba komorek w osi Y</param>
+/// <param name="InCellSize">Rozmiar komorki w jednostkach swiata</param>
+/// <param name="InOrigin">Srodek komorki (0, 0) w przestrzeni swiata</param>
+void FBattleFlowField::Initialize(int32 InWidth, int32 InHeight, float InCellSize, const FVector& InOrigin)
+{
+    Width = FMath::Max(InWidth, 0);
+    Height = FMath::Max(InHeight, 0);
+    CellSize = FMath::Max(InCellSize, 1.0f);
+    Origin = InOrigin;
+
+    const int32 NumCells = Width * Height;
+    GoalCounts.Init(0, NumCells);
+    PendingGoalCounts.Init(0, NumCells);
+    BlockedCells.Init(false, NumCells);
+    MoveCosts.Init(1, NumCells);
+    IntegrationCost.Init(Unreachable, NumCells);
+    FlowDirections.Init(INDEX_NONE, NumCells);
+    OpenCells.Reset();
+    InvalidatedCells.Init(false, NumCells);
+    ChangedCells.Init(false, NumCells);
+    InvalidatedList.Reset();
+    ChangedList.Reset();
+
+    bDirty = false;
+    RecomputeCount = 0;
+    FullRecomputeCount = 0;
+    LastUpdatedCellCount = 0;
+}
+
+/// <summary>
+/// Zwalnia pamiec pola - do ponownego uzycia wymaga Initialize.
+/// </summary>
+void FBattleFlowField::Reset()
+{
+    Width = 0;
+    Height = 0;
+    GoalCounts.Empty();
+    PendingGoalCounts.Empty();
+    BlockedCells.Empty();
+    MoveCosts.Empty();
+    IntegrationCost.Empty();
+    FlowDirections.Empty();
+    OpenCells.Empty();
+    InvalidatedCells.Empty();
+    ChangedCells.Empty();
+    InvalidatedList.Empty();
+    ChangedList.Empty();
+    bDirty = false;
+}
+
+/// <summary>
+/// Rozpoczyna zbieranie zajetosci celow dla biezacego ticku.
+/// </summary>
+void FBattleFlowField::BeginGoals()
+{
+    if (PendingGoalCounts.Num() > 0)
+    {
+        FMemory::Memzero(PendingGoalCounts.GetData(), PendingGoalCounts.Num());
+    }
+}
+
+/// <summary>
+/// Dodaje jednego wroga w komorce pod WorldLocation. Wrogowie poza siatka sa pomijani.
+/// </summary>
+/// <param name="WorldLocation">Pozycja wroga w przestrzeni swiata</param>
+void FBattleFlowField::AddGoal(const FVector& WorldLocation)
+{
+    const int32 CellIndex = WorldToCellIndex(WorldLocation);
+    if (CellIndex != INDEX_NONE && PendingGoalCounts[CellIndex] < MaxGoalConcentration)
+    {
+        PendingGoalCounts[CellIndex]++;
+    }
+}
+
+/// <summary>
+/// Konczy zbieranie zajetosci. Gdy zmienily sie tylko cele, naprawiane sa komorki zalezne od
+/// zmienionych celow; pierwsze zatwierdzenie i czekajaca zmiana blokad przeliczaja cale pole.
+/// </summary>
+/// <returns>true jesli pole zostalo przeliczone, false - wpp</returns>
+bool FBattleFlowField::CommitGoals()
+{
+    if (!IsInitialized())
+    {
+        return false;
+    }
+
+    if (FMemory::Memcmp(GoalCounts.GetData(), PendingGoalCounts.GetData(), GoalCounts.Num()) != 0)
+    {
+        Swap(GoalCounts, PendingGoalCounts);
+
+        if (!bDirty && FullRecomputeCount > 0)
+        {
+            // Po zamianie PendingGoalCounts trzyma zajetosc z poprzedniego zatwierdzenia
+            RepairGoals(PendingGoalCounts);
+            return true;
+        }
+
+        bDirty = true;
+    }
+
+    return Update();
+}
+
+/// <summary>
+/// Oznacza komorke jako nieprzechodnia lub przechodnia.
+/// </summary>
+/// <param name="X">Wspolrzedna X komorki</param>
+/// <param name="Y">Wspolrzedna Y komorki</param>
+/// <param name="bBlocked">true - komorka zablokowana</param>
+void FBattleFlowField::SetCellBlocked(int32 X, int32 Y, bool bBlocked)
+{
+    if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+    {
+        return;
+    }
+
+    const int32 CellIndex = Y * Width + X;
+    if (BlockedCells[CellIndex] != bBlocked)
+    {
+        BlockedCells[CellIndex] = bBlocked;
+        bDirty = true;
+    }
+}
+
+/// <summary>
+/// Ustawia mnoznik kosztu kroku z komorki (teren spowalniajacy). Pole omija drogie komorki,
+/// jesli objazd jest tanszy.
+/// </summary>
+/// <param name="X">Wspolrzedna X komorki</param>
+/// <param name="Y">Wspolrzedna Y komorki</param>
+/// <param name="Cost">Mnoznik kosztu (co najmniej 1)</param>
+void FBattleFlowField::SetCellMoveCost(int32 X, int32 Y, uint8 Cost)
+{
+    if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+    {
+        return;
+    }
+
+    const int32 CellIndex = Y * Width + X;
+    Cost = FMath::Max<uint8>(Cost, 1);
+    if (MoveCosts[CellIndex] != Cost)
+    {
+        MoveCosts[CellIndex] = Cost;
+        bDirty = true;
+    }
+}
+
+/// <summary>
+/// Przelicza pole, jesli od ostatniego przeliczenia zmienily sie cele lub blokady.
+/// </summary>
+/// <returns>true jesli pole zostalo przeliczone, false - wpp</returns>
+bool FBattleFlowField::Update()
+{
+    if (!bDirty || !IsInitialized())
+    {
+        return false;
+    }
+
+    Recompute();
+    bDirty = false;
+    return true;
+}
+
+/// <summary>
+/// Pobiera kierunek ruchu z komorki pod podana pozycja.
+/// </summary>
+/// <param name="WorldLocation">Pozycja jednostki w przestrzeni swiata</param>
+/// <param name="OutDirection">Znormalizowany kierunek w plaszczyznie XY</param>
+/// <returns>true jesli komorka ma kierunek, false - wpp</returns>
+bool FBattleFlowField::SampleDirection(const FVector& WorldLocation, FVector& OutDirection) const
+{
+    const int32 CellIndex = WorldToCellIndex(WorldLocation);
+    if (CellIndex == INDEX_NONE || FlowDirections[CellIndex] == INDEX_NONE)
+    {
+        return false;
+    }
+
+    const int32 Direction = FlowDirections[CellIndex];
+    OutDirection = FVector(DirectionOffsetX[Direction], DirectionOffsetY[Direction], 0.0f).GetSafeNormal();
+    return true;
+}
+
+/// <summary>
+/// Zamienia pozycje swiata na indeks komorki (zaokraglenie jak w AGridManager::GetGridPositionFromWorld).
+/// </summary>
+/// <param name="WorldLocation">Pozycja w przestrzeni swiata</param>
+/// <returns>Indeks komorki lub INDEX_NONE poza siatka</returns>
+int32 FBattleFlowField::WorldToCellIndex(const FVector& WorldLocation) const
+{
+    if (!IsInitialized())
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 X = FMath::RoundToInt((WorldLocation.X - Origin.X) / CellSize);
+    const int32 Y = FMath::RoundToInt((WorldLocation.Y - Origin.Y) / CellSize);
+    if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+    {
+        return INDEX_NONE;
+    }
+
+    return Y * Width + X;
+}
+
+/// <summary>
+/// Koszt dojscia z komorki do najblizszego skupiska celow.
+/// </summary>
+/// <param name="X">Wspolrzedna X komorki</param>
+/// <param name="Y">Wspolrzedna Y komorki</param>
+/// <returns>Koszt lub Unreachable</returns>
+int32 FBattleFlowField::GetCellCost(int32 X, int32 Y) const
+{
+    if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+    {
+        return Unreachable;
+    }
+
+    return IntegrationCost[Y * Width + X];
+}
+
+/// <summary>
+/// Czy z komorki (X, Y) mozna przejsc do sasiada w danym kierunku. Ruch po przekatnej
+/// wymaga wolnych obu komorek ortogonalnych, zeby nie scinac rogow przeszkod.
+/// </summary>
+bool FBattleFlowField::CanStep(int32 X, int32 Y, int32 Direction) const
+{
+    const int32 NextX = X + DirectionOffsetX[Direction];
+    const int32 NextY = Y + DirectionOffsetY[Direction];
+    if (NextX < 0 || NextX >= Width || NextY < 0 || NextY >= Height || BlockedCells[NextY * Width + NextX])
+    {
+        return false;
+    }
+
+    if (IsDiagonalDirection(Direction))
+    {
+        return !BlockedCells[Y * Width + NextX] && !BlockedCells[NextY * Width + X];
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Koszt kroku z sasiada w danym kierunku do komorki CellIndex - jednostka idzie z CellIndex
+/// do sasiada, wiec placi koszt terenu komorki, ktora opuszcza.
+/// </summary>
+int32 FBattleFlowField::GetStepCost(int32 Direction, int32 CellIndex) const
+{
+    return (IsDiagonalDirection(Direction) ? DiagonalCost : OrthogonalCost) * MoveCosts[CellIndex];
+}
+
+/// <summary>
+/// Koszt startowy komorki celu - gestsze skupisko wrogow zaczyna z nizszym kosztem.
+/// </summary>
+/// <param name="GoalCount">Liczba wrogow w komorce</param>
+/// <returns>Koszt startowy lub Unreachable, gdy komorka nie jest celem</returns>
+int32 FBattleFlowField::GetSeedCost(uint8 GoalCount)
+{
+    return GoalCount > 0 ? OrthogonalCost * (MaxGoalConcentration - FMath::Min<int32>(GoalCount, MaxGoalConcentration)) : Unreachable;
+}
+
+/// <summary>
+/// Dijkstra z wieloma zrodlami po 8 sasiadach, start we wszystkich komorkach celow.
+/// Nastepnie kazda komorka dostaje kierunek do sasiada o najnizszym koszcie.
+/// </summary>
+void FBattleFlowField::Recompute()
+{
+    const int32 NumCells = Width * Height;
+    IntegrationCost.Init(Unreachable, NumCells);
+    FlowDirections.Init(INDEX_NONE, NumCells);
+    OpenCells.Reset();
+
+    for (int32 CellIndex = 0; CellIndex < NumCells; CellIndex++)
+    {
+        if (GoalCounts[CellIndex] > 0 && !BlockedCells[CellIndex])
+        {
+            const int32 SeedCost = GetSeedCost(GoalCounts[CellIndex]);
+            IntegrationCost[CellIndex] = SeedCost;
+            OpenCells.HeapPush({ SeedCost, CellIndex });
+        }
+    }
+
+    PropagateCosts(false);
+
+    for (int32 CellIndex = 0; CellIndex < NumCells; CellIndex++)
+    {
+        UpdateFlowDirection(CellIndex);
+    }
+
+    RecomputeCount++;
+    FullRecomputeCount++;
+    LastUpdatedCellCount = NumCells;
+}
+
+/// <summary>
+/// Naprawia pole po zmianie samych celow. Komorki, ktorych koszt wynikal z celu, ktory zdrozal
+/// lub zniknal, sa uniewazniane (z remisami wlacznie), dostaja koszt od nieuniewaznionych
+/// sasiadow i nowych celow, a Dijkstra rusza tylko z tych komorek i z celow, ktore potanialy.
+/// Kierunki sa odswiezane tylko w zmienionych komorkach i ich sasiadach.
+/// </summary>
+/// <param name="PreviousGoalCounts">Zajetosc celow z poprzedniego zatwierdzenia</param>
+void FBattleFlowField::RepairGoals(const TArray<uint8>& PreviousGoalCounts)
+{
+    const int32 NumCells = Width * Height;
+    OpenCells.Reset();
+
+    // Faza 1 - cele, ktore zdrozaly, i komorki, ktorych koszt od nich zalezal
+    for (int32 CellIndex = 0; CellIndex < NumCells; CellIndex++)
+    {
+        if (GoalCounts[CellIndex] == PreviousGoalCounts[CellIndex] || BlockedCells[CellIndex])
+        {
+            continue;
+        }
+
+        const int32 PreviousSeed = GetSeedCost(PreviousGoalCounts[CellIndex]);
+        if (GetSeedCost(GoalCounts[CellIndex]) > PreviousSeed && IntegrationCost[CellIndex] == PreviousSeed)
+        {
+            InvalidatedCells[CellIndex] = true;
+            InvalidatedList.Add(CellIndex);
+        }
+    }
+
+    for (int32 QueueIndex = 0; QueueIndex < InvalidatedList.Num(); QueueIndex++)
+    {
+        const int32 CellIndex = InvalidatedList[QueueIndex];
+        const int32 PreviousCost = IntegrationCost[CellIndex];
+        const int32 X = CellIndex % Width;
+        const int32 Y = CellIndex / Width;
+        for (int32 Direction = 0; Direction < NumFlowDirections; Direction++)
+        {
+            if (!CanStep(X, Y, Direction))
+            {
+                continue;
+            }
+
+            const int32 NextIndex = (Y + DirectionOffsetY[Direction]) * Width + (X + DirectionOffsetX[Direction]);
+            if (!InvalidatedCells[NextIndex] && IntegrationCost[NextIndex] != Unreachable
+                && IntegrationCost[NextIndex] == PreviousCost + GetStepCost(Direction, NextIndex))
+            {
+                InvalidatedCells[NextIndex] = true;
+                InvalidatedList.Add(NextIndex);
+            }
+        }
+
+        IntegrationCost[CellIndex] = Unreachable;
+        MarkCellChanged(CellIndex);
+    }
+
+    // Faza 2 - koszt uniewaznionych komorek od granicy z reszta pola i od wlasnego celu
+    for (const int32 CellIndex : InvalidatedList)
+    {
+        int32 BestCost = GetSeedCost(GoalCounts[CellIndex]);
+        const int32 X = CellIndex % Width;
+        const int32 Y = CellIndex / Width;
+        for (int32 Direction = 0; Direction < NumFlowDirections; Direction++)
+        {
+            if (!CanStep(X, Y, Direction))
+            {
+                continue;
+            }
+
+            const int32 NeighborIndex = (Y + DirectionOffsetY[Direction]) * Width + (X + DirectionOffsetX[Direction]);
+            if (!InvalidatedCells[NeighborIndex] && IntegrationCost[NeighborIndex] != Unreachable)
+            {
+                BestCost = FMath::Min(BestCost, IntegrationCost[NeighborIndex] + GetStepCost(Direction, CellIndex));
+            }
+        }
+
+        if (BestCost != Unreachable)
+        {
+            IntegrationCost[CellIndex] = BestCost;
+            OpenCells.HeapPush({ BestCost, CellIndex });
+        }
+    }
+
+    // Cele, ktore potanialy lub sa nowe
+    for (int32 CellIndex = 0; CellIndex < NumCells; CellIndex++)
+    {
+        if (GoalCounts[CellIndex] != PreviousGoalCounts[CellIndex] && !BlockedCells[CellIndex] && !InvalidatedCells[CellIndex])
+        {
+            const int32 SeedCost = GetSeedCost(GoalCounts[CellIndex]);
+            if (SeedCost < IntegrationCost[CellIndex])
+            {
+                IntegrationCost[CellIndex] = SeedCost;
+                OpenCells.HeapPush({ SeedCost, CellIndex });
+                MarkCellChanged(CellIndex);
+            }
+        }
+    }
+
+    // Faza 3 - Dijkstra tylko od zmienionych komorek
+    PropagateCosts(true);
+
+    for (const int32 CellIndex : ChangedList)
+    {
+        UpdateFlowDirection(CellIndex);
+
+        const int32 X = CellIndex % Width;
+        const int32 Y = CellIndex / Width;
+        for (int32 Direction = 0; Direction < NumFlowDirections; Direction++)
+        {
+            const int32 NeighborX = X + DirectionOffsetX[Direction];
+            const int32 NeighborY = Y + DirectionOffsetY[Direction];
+            if (NeighborX >= 0 && NeighborX < Width && NeighborY >= 0 && NeighborY < Height)
+            {
+                UpdateFlowDirection(NeighborY * Width + NeighborX);
+            }
+        }
+    }
+
+    RecomputeCount++;
+    LastUpdatedCellCount = ChangedList.Num();
+
+    for (const int32 CellIndex : InvalidatedList)
+    {
+        InvalidatedCells[CellIndex] = false;
+    }
+    for (const int32 CellIndex : ChangedList)
+    {
+        ChangedCells[CellIndex] = false;
+    }
+    InvalidatedList.Reset();
+    ChangedList.Reset();
+}
+
+/// <summary>
+/// Zapamietuje komorke ze zmienionym kosztem - jej kierunek i kierunki sasiadow trzeba odswiezyc.
+/// </summary>
+void FBattleFlowField::MarkCellChanged(int32 CellIndex)
+{
+    if (!ChangedCells[CellIndex])
+    {
+        ChangedCells[CellIndex] = true;
+        ChangedList.Add(CellIndex);
+    }
+}
+
+/// <summary>
+/// Relaksacja Dijkstry od komorek w OpenCells.
+/// </summary>
+/// <param name="bTrackChanges">Zapamietywanie komorek z obnizonym kosztem w ChangedList (naprawa pola)</param>
+void FBattleFlowField::PropagateCosts(bool bTrackChanges)
+{
+    while (OpenCells.Num() > 0)
+    {
+        FOpenCell Current;
+        OpenCells.HeapPop(Current, EAllowShrinking::No);
+
+        // Wpis nieaktualny - komorka zostala juz osiagnieta taniej
+        if (Current.Cost > IntegrationCost[Current.Index])
+        {
+            continue;
+        }
+
+        const int32 X = Current.Index % Width;
+        const int32 Y = Current.Index / Width;
+        for (int32 Direction = 0; Direction < NumFlowDirections; Direction++)
+        {
+            if (!CanStep(X, Y, Direction))
+            {
+                continue;
+            }
+
+            const int32 NextIndex = (Y + DirectionOffsetY[Direction]) * Width + (X + DirectionOffsetX[Direction]);
+            const int32 NextCost = Current.Cost + GetStepCost(Direction, NextIndex);
+            if (NextCost < IntegrationCost[NextIndex])
+            {
+                IntegrationCost[NextIndex] = NextCost;
+                OpenCells.HeapPush({ NextCost, NextIndex });
+                if (bTrackChanges)
+                {
+                    MarkCellChanged(NextIndex);
+                }
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Ustawia kierunek komorki do sasiada o najnizszym koszcie (INDEX_NONE bez drogi do celu
+/// lub gdy zaden sasiad nie jest tanszy).
+/// </summary>
+void FBattleFlowField::UpdateFlowDirection(int32 CellIndex)
+{
+    FlowDirections[CellIndex] = INDEX_NONE;
+    if (IntegrationCost[CellIndex] == Unreachable)
+    {
+        return;
+    }
+
+    const int32 X = CellIndex % Width;
+    const int32 Y = CellIndex / Width;
+    int32 BestCost = IntegrationCost[CellIndex];
+    for (int32 Direction = 0; Direction < NumFlowDirections; Direction++)
+    {
+        if (!CanStep(X, Y, Direction))
+        {
+            continue;
+        }
+
+        const int32 NeighborCost = IntegrationCost[(Y + DirectionOffsetY[Direction]) * Width + (X + DirectionOffsetX[Direction])];
+        if (NeighborCost < BestCost)
+        {
+            BestCost = NeighborCost;
+            FlowDirections[CellIndex] = static_cast<int8>(Direction);
+        }
+    }
+}
@@ -0,0 +1,219 @@
+// BattleReplay.cpp - Implementacja powtorek bitew i weryfikatora determinizmu
+#include "BattleReplay.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    // Gorny limit przy wczytywaniu, zeby uszkodzony plik nie zaalokowal gigabajtow
+    constexpr int32 MaxReplayPlacements = 100000;
+    constexpr int32 MaxReplayTicks = 1000000;
+
+    void SerializeStats(FArchive& Ar, FSimUnitStats& Stats)
+    {
+        Ar << Stats.MaxHealth << Stats.Attack << Stats.Defense;
+        Ar << Stats.Speed << Stats.AttackRange << Stats.AttackCooldown;
+        Ar << Stats.MovementInterval << Stats.SearchRange << Stats.Cost;
+    }
+
+    void SerializePlacement(FArchive& Ar, FSimUnitPlacement& Placement)
+    {
+        // Zapis jako int16 - ten sam zakres co klucz FGridCell
+        int16 GridX = static_cast<int16>(Placement.GridPosition.X);
+        int16 GridY = static_cast<int16>(Placement.GridPosition.Y);
+        uint8 PlayerID = static_cast<uint8>(Placement.PlayerID);
+        uint8 UnitType = static_cast<uint8>(Placement.UnitType);
+
+        Ar << GridX << GridY << PlayerID << UnitType;
+
+        if (Ar.IsLoading())
+        {
+            Placement.GridPosition = FGridCell(GridX, GridY);
+            Placement.PlayerID = PlayerID;
+            Placement.UnitType = static_cast<EBaseUnitType>(FMath::Min<uint8>(UnitType, FBattleSimSetup::NumUnitTypes - 1));
+        }
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FBattleReplay& Replay)
+{
+    uint32 Magic = FBattleReplay::FileMagic;
+    Ar << Magic;
+    if (Ar.IsLoading() && Magic != FBattleReplay::FileMagic)
+    {
+        Ar.SetError();
+        return Ar;
+    }
+
+    Ar << Replay.SimVersion << Replay.Seed << Replay.PositionJitterCells << Replay.bRandomizeAttackPhase;
+
+    FBattleSimSetup& Setup = Replay.Setup;
+    for (FSimUnitStats& Stats : Setup.TypeStats)
+    {
+        SerializeStats(Ar, Stats);
+    }
+    Ar << Setup.CellSize << Setup.TickSeconds << Setup.MaxBattleSeconds;
+
+    uint8 MathMode = static_cast<uint8>(Setup.MathMode);
+    Ar << MathMode;
+    if (Ar.IsLoading())
+    {
+        Setup.MathMode = MathMode == static_cast<uint8>(EBattleSimMath::FixedPoint) ? EBattleSimMath::FixedPoint : EBattleSimMath::Float;
+    }
+
+    int32 NumPlacements = Setup.Placements.Num();
+    Ar << NumPlacements;
+    if (Ar.IsLoading())
+    {
+        if (NumPlacements < 0 || NumPlacements > MaxReplayPlacements)
+        {
+            Ar.SetError();
+            return Ar;
+        }
+        Setup.Placements.SetNum(NumPlacements);
+    }
+    for (FSimUnitPlacement& Placement : Setup.Placements)
+    {
+        SerializePlacement(Ar, Placement);
+    }
+
+    int32 NumTicks = Replay.TickHashes.Num();
+    Ar << NumTicks;
+    if (Ar.IsLoading())
+    {
+        if (NumTicks < 0 || NumTicks > MaxReplayTicks)
+        {
+            Ar.SetError();
+            return Ar;
+        }
+        Replay.TickHashes.SetNum(NumTicks);
+    }
+    if (NumTicks > 0)
+    {
+        Ar.Serialize(Replay.TickHashes.GetData(), NumTicks * sizeof(uint32));
+    }
+
+    FBattleSimResult& Result = Replay.RecordedResult;
+    Ar << Result.WinnerPlayerID << Result.DurationSeconds;
+    Ar << Result.Survivors[0] << Result.Survivors[1] << Result.SurvivingCost[0] << Result.SurvivingCost[1];
+
+    return Ar;
+}
+
+/// <summary>
+/// Nagrywa powtorke - symuluje bitwe raz i zapamietuje skrot stanu po kazdym ticku.
+/// </summary>
+/// <param name="InSetup">Stan poczatkowy bitwy</param>
+/// <param name="InSeed">Ziarno bitwy</param>
+/// <param name="InPositionJitterCells">Przesuniecie pozycji w komorkach</param>
+/// <param name="bInRandomizeAttackPhase">Losowa faza ataku</param>
+/// <returns>Gotowa powtorka</returns>
+FBattleReplay FBattleReplay::Record(const FBattleSimSetup& InSetup, uint32 InSeed,
+    float InPositionJitterCells, bool bInRandomizeAttackPhase)
+{
+    FBattleReplay Replay;
+    Replay.Seed = InSeed;
+    Replay.PositionJitterCells = InPositionJitterCells;
+    Replay.bRandomizeAttackPhase = bInRandomizeAttackPhase;
+    Replay.Setup = InSetup;
+
+    FBattleSimState State;
+    Replay.StartPlayback(State);
+    while (!State.IsFinished())
+    {
+        State.Step();
+        Replay.TickHashes.Add(State.ComputeStateHash());
+    }
+
+    Replay.RecordedResult = State.GetResult();
+    return Replay;
+}
+
+/// <summary>
+/// Inicjalizuje stan symulacji z powtorki. Powtorka musi zyc dluzej niz stan.
+/// </summary>
+/// <param name="OutState">Stan do odtwarzania</param>
+void FBattleReplay::StartPlayback(FBattleSimState& OutState) const
+{
+    OutState.Initialize(Setup, Seed, PositionJitterCells, bRandomizeAttackPhase);
+}
+
+/// <summary>
+/// Ponownie symuluje bitwe i porownuje skroty stanu z nagraniem.
+/// </summary>
+/// <returns>Wynik weryfikacji z pierwszym rozbieznym tickiem</returns>
+FBattleReplayVerifyResult FBattleReplay::Verify() const
+{
+    FBattleReplayVerifyResult VerifyResult;
+
+    if (SimVersion != CurrentSimVersion)
+    {
+        VerifyResult.Error = FString::Printf(TEXT("Powtorka z wersji symulacji %d, aktualna wersja %d"), SimVersion, CurrentSimVersion);
+        return VerifyResult;
+    }
+
+    FBattleSimState State;
+    StartPlayback(State);
+
+    for (int32 TickIndex = 0; TickIndex < TickHashes.Num(); TickIndex++)
+    {
+        if (State.IsFinished())
+        {
+            VerifyResult.FirstMismatchTick = TickIndex;
+            VerifyResult.Error = FString::Printf(TEXT("Bitwa zakonczyla sie po %d tickach, nagranie ma %d"), TickIndex, TickHashes.Num());
+            return VerifyResult;
+        }
+
+        State.Step();
+        VerifyResult.TicksCompared++;
+
+        const uint32 ActualHash = State.ComputeStateHash();
+        if (ActualHash != TickHashes[TickIndex])
+        {
+            VerifyResult.FirstMismatchTick = TickIndex;
+            VerifyResult.ExpectedHash = TickHashes[TickIndex];
+            VerifyResult.ActualHash = ActualHash;
+            VerifyResult.Error = FString::Printf(TEXT("Rozbieznosc stanu w ticku %d (oczekiwano %08x, jest %08x)"),
+                TickIndex, VerifyResult.ExpectedHash, ActualHash);
+            return VerifyResult;
+        }
+    }
+
+    if (!State.IsFinished())
+    {
+        VerifyResult.FirstMismatchTick = TickHashes.Num();
+        VerifyResult.Error = FString::Printf(TEXT("Bitwa trwa dluzej niz nagrane %d tickow"), TickHashes.Num());
+        return VerifyResult;
+    }
+
+    VerifyResult.bMatches = true;
+    return VerifyResult;
+}
+
+bool FBattleReplay::SaveToBytes(TArray<uint8>& OutBytes) const
+{
+    OutBytes.Reset();
+    FMemoryWriter Writer(OutBytes);
+    Writer << const_cast<FBattleReplay&>(*this);
+    return !Writer.IsError();
+}
+
+bool FBattleReplay::LoadFromBytes(const TArray<uint8>& Bytes)
+{
+    FMemoryReader Reader(Bytes);
+    Reader << *this;
+    return !Reader.IsError();
+}
+
+bool FBattleReplay::SaveToFile(const FString& FilePath) const
+{
+    TArray<uint8> Bytes;
+    return SaveToBytes(Bytes) && FFileHelper::SaveArrayToFile(Bytes, *FilePath);
+}
+
+bool FBattleReplay::LoadFromFile(const FString& FilePath)
+{
+    TArray<uint8> Bytes;
+    return FFileHelper::LoadFileToArray(Bytes, *FilePath) && LoadFromBytes(Bytes);
+}
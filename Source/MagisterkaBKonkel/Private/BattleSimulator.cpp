@@ -0,0 +1,749 @@
+// BattleSimulator.cpp - Implementacja bezstanowego symulatora bitew dla testow balansu
+#include "BattleSimulator.h"
+#include "UnitManager.h"
+#include "UnitArchetype.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+#include "Misc/Crc.h"
+
+/// <summary>
+/// Odczyt statystyk z archetypu typu jednostki.
+/// </summary>
+/// <param name="Archetype">Archetyp typu</param>
+/// <returns>Statystyki dla symulatora</returns>
+FSimUnitStats FSimUnitStats::FromArchetype(const UUnitArchetype* Archetype)
+{
+    FSimUnitStats Stats;
+    if (!Archetype)
+    {
+        return Stats;
+    }
+
+    Stats.MaxHealth = Archetype->MaxHealth;
+    Stats.Attack = Archetype->Attack;
+    Stats.Defense = Archetype->Defense;
+    Stats.Speed = Archetype->Speed;
+    Stats.AttackRange = Archetype->AttackRange;
+    Stats.AttackCooldown = Archetype->AttackCooldown;
+    Stats.MovementInterval = Archetype->MovementInterval;
+    Stats.SearchRange = Archetype->SearchRange;
+    Stats.Cost = Archetype->Cost;
+    return Stats;
+}
+
+namespace
+{
+    // cos(k * 360/64 stopni) dla k = 0..16 w skali 1 << 14 - stale zamiast sin/cos z biblioteki
+    constexpr int32 QuarterCosTable[17] =
+    {
+        16384, 16305, 16069, 15679, 15137, 14449, 13623, 12665, 11585,
+        10394, 9102, 7723, 6270, 4756, 3196, 1606, 0
+    };
+
+    // tan((k + 0.5) * 360/64 stopni) dla k = 0..7 w skali 1 << 16 - granice kierunkow w oktancie
+    constexpr int64 OctantTanBoundaries[8] =
+    {
+        3220, 9721, 16416, 23449, 30996, 39281, 48605, 59398
+    };
+
+    // Numer kierunku 0..8 w oktancie 0-45 stopni dla Minor <= Major
+    int32 OctantDirectionStep(int64 Major, int64 Minor)
+    {
+        int32 Step = 0;
+        while (Step < 8 && Minor * 65536 > Major * OctantTanBoundaries[Step])
+        {
+            Step++;
+        }
+        return Step;
+    }
+}
+
+int32 FSimFixedMath::FromFloat(float Value)
+{
+    return FMath::RoundToInt(Value * One);
+}
+
+/// <summary>
+/// Wybiera kierunek tablicy najblizszy wektorowi - tylko porownania calkowite.
+/// </summary>
+/// <param name="DeltaX">Skladowa X wektora</param>
+/// <param name="DeltaY">Skladowa Y wektora</param>
+/// <returns>Indeks kierunku 0..NumDirections-1</returns>
+int32 FSimFixedMath::DirectionIndex(int64 DeltaX, int64 DeltaY)
+{
+    const int64 AbsX = DeltaX < 0 ? -DeltaX : DeltaX;
+    const int64 AbsY = DeltaY < 0 ? -DeltaY : DeltaY;
+
+    // Kat w pierwszej cwiartce (0..16), potem odbicia do wlasciwej cwiartki
+    int32 Index = (AbsY <= AbsX) ? OctantDirectionStep(AbsX, AbsY) : 16 - OctantDirectionStep(AbsY, AbsX);
+    if (DeltaX < 0)
+    {
+        Index = 32 - Index;
+    }
+    if (DeltaY < 0)
+    {
+        Index = 64 - Index;
+    }
+    return Index & (NumDirections - 1);
+}
+
+/// <summary>
+/// Skladowe kierunku z cwiartkowej tablicy cosinusow.
+/// </summary>
+/// <param name="Index">Indeks kierunku</param>
+/// <param name="OutX">Skladowa X (skala 1 << DirectionBits)</param>
+/// <param name="OutY">Skladowa Y (skala 1 << DirectionBits)</param>
+void FSimFixedMath::GetDirection(int32 Index, int32& OutX, int32& OutY)
+{
+    const int32 Wrapped = Index & (NumDirections - 1);
+    const int32 Step = Wrapped & 15;
+    switch (Wrapped >> 4)
+    {
+    case 0:  OutX = QuarterCosTable[Step];       OutY = QuarterCosTable[16 - Step];  break;
+    case 1:  OutX = -QuarterCosTable[16 - Step]; OutY = QuarterCosTable[Step];       break;
+    case 2:  OutX = -QuarterCosTable[Step];      OutY = -QuarterCosTable[16 - Step]; break;
+    default: OutX = QuarterCosTable[16 - Step];  OutY = -QuarterCosTable[Step];      break;
+    }
+}
+
+int32 FSimFixedMath::ScaleByDirection(int32 DirectionComponent, int32 Length)
+{
+    const int64 Scaled = static_cast<int64>(DirectionComponent) * Length;
+    return static_cast<int32>((Scaled + (1 << (DirectionBits - 1))) >> DirectionBits);
+}
+
+/// <summary>
+/// Dodaje rozstawienie jednostek w formacie uzywanym przez AUnitManager.
+/// </summary>
+/// <param name="SpawnedUnits">Dane utworzonych jednostek</param>
+void FBattleSimSetup::AddPlacements(const TArray<FSpawnedUnitData>& SpawnedUnits)
+{
+    Placements.Reserve(Placements.Num() + SpawnedUnits.Num());
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        FSimUnitPlacement& Placement = Placements.AddDefaulted_GetRef();
+        Placement.PlayerID = UnitData.PlayerID;
+        Placement.GridPosition = UnitData.GridPosition;
+        Placement.UnitType = UnitData.UnitType;
+    }
+}
+
+/// <summary>
+/// Zwraca statystyki typu jednostki.
+/// </summary>
+/// <param name="UnitType">Typ jednostki</param>
+/// <returns>Statystyki typu</returns>
+const FSimUnitStats& FBattleSimSetup::GetStats(EBaseUnitType UnitType) const
+{
+    return TypeStats[FMath::Clamp(static_cast<int32>(UnitType), 0, NumUnitTypes - 1)];
+}
+
+/// <summary>
+/// Przygotowuje stan poczatkowy bitwy.
+/// </summary>
+/// <param name="InSetup">Stan poczatkowy bitwy (musi zyc dluzej niz ten obiekt)</param>
+/// <param name="Seed">Ziarno losowania przesuniec i fazy ataku</param>
+/// <param name="PositionJitterCells">Maksymalne przesuniecie pozycji w komorkach siatki</param>
+/// <param name="bRandomizeAttackPhase">Losowy poczatkowy cooldown ataku</param>
+void FBattleSimState::Initialize(const FBattleSimSetup& InSetup, uint32 Seed,
+    float PositionJitterCells, bool bRandomizeAttackPhase)
+{
+    Setup = &InSetup;
+    Units.Reset();
+    Units.Reserve(InSetup.Placements.Num());
+    for (TArray<int32>& Group : TypeGroups)
+    {
+        Group.Reset();
+    }
+    Alive[0] = 0;
+    Alive[1] = 0;
+    Time = 0.0f;
+    TimeAccumulator = 0.0f;
+    TickCount = 0;
+    TickSeconds = FMath::Max(InSetup.TickSeconds, KINDA_SMALL_NUMBER);
+
+    FRandomStream Random(static_cast<int32>(Seed));
+
+    for (int32 AttackerType = 0; AttackerType < FBattleSimSetup::NumUnitTypes; AttackerType++)
+    {
+        for (int32 TargetType = 0; TargetType < FBattleSimSetup::NumUnitTypes; TargetType++)
+        {
+            DamageTable[AttackerType][TargetType] = FMath::Max(InSetup.TypeStats[AttackerType].Attack - InSetup.TypeStats[TargetType].Defense, 1);
+        }
+    }
+
+    bFixedPoint = InSetup.MathMode == EBattleSimMath::FixedPoint;
+    if (bFixedPoint)
+    {
+        // Jedyne operacje zmiennoprzecinkowe trybu - jednorazowe przeliczenie stalych ustawienia
+        FixedCellSize = FSimFixedMath::FromFloat(InSetup.CellSize);
+        MaxBattleTicks = SecondsToTicks(InSetup.MaxBattleSeconds);
+        for (int32 TypeIndex = 0; TypeIndex < FBattleSimSetup::NumUnitTypes; TypeIndex++)
+        {
+            const FSimUnitStats& Stats = InSetup.TypeStats[TypeIndex];
+            FFixedTypeStats& Fixed = FixedTypeStats[TypeIndex];
+            Fixed.AttackRange = FSimFixedMath::FromFloat(Stats.AttackRange);
+            Fixed.SearchRange = FSimFixedMath::FromFloat(Stats.SearchRange);
+            Fixed.StepLength = FSimFixedMath::FromFloat(Stats.Speed);
+            Fixed.AttackCooldownTicks = SecondsToTicks(Stats.AttackCooldown);
+            Fixed.MovementIntervalTicks = SecondsToTicks(Stats.MovementInterval);
+        }
+    }
+    const int32 FixedJitter = bFixedPoint ? FSimFixedMath::FromFloat(PositionJitterCells * InSetup.CellSize) : 0;
+
+    // Rozstawienie - srodek komorki jak w AUnitManager::GetWorldLocationFromGrid
+    for (const FSimUnitPlacement& Placement : InSetup.Placements)
+    {
+        if (Placement.PlayerID < 0 || Placement.PlayerID > 1)
+        {
+            continue;
+        }
+
+        const int32 TypeIndex = FMath::Clamp(static_cast<int32>(Placement.UnitType), 0, FBattleSimSetup::NumUnitTypes - 1);
+        TypeGroups[TypeIndex].Add(Units.Num());
+
+        FSimUnitState& Unit = Units.AddDefaulted_GetRef();
+        Unit.Stats = &InSetup.TypeStats[TypeIndex];
+        Unit.TypeIndex = TypeIndex;
+        Unit.Team = Placement.PlayerID;
+        Unit.Health = Unit.Stats->MaxHealth;
+        Alive[Unit.Team]++;
+
+        if (bFixedPoint)
+        {
+            // Losowanie wylacznie na liczbach calkowitych
+            Unit.FixedX = Placement.GridPosition.X * FixedCellSize + FixedCellSize / 2;
+            Unit.FixedY = Placement.GridPosition.Y * FixedCellSize + FixedCellSize / 2;
+
+            if (FixedJitter > 0)
+            {
+                Unit.FixedX += static_cast<int32>(Random.GetUnsignedInt() % static_cast<uint32>(2 * FixedJitter + 1)) - FixedJitter;
+                Unit.FixedY += static_cast<int32>(Random.GetUnsignedInt() % static_cast<uint32>(2 * FixedJitter + 1)) - FixedJitter;
+            }
+
+            const int32 CooldownTicks = FixedTypeStats[TypeIndex].AttackCooldownTicks;
+            if (bRandomizeAttackPhase && CooldownTicks > 0)
+            {
+                Unit.NextAttackTick = static_cast<int32>(Random.GetUnsignedInt() % static_cast<uint32>(CooldownTicks));
+            }
+
+            Unit.X = FSimFixedMath::ToFloat(Unit.FixedX);
+            Unit.Y = FSimFixedMath::ToFloat(Unit.FixedY);
+            continue;
+        }
+
+        Unit.X = (Placement.GridPosition.X + 0.5f) * InSetup.CellSize;
+        Unit.Y = (Placement.GridPosition.Y + 0.5f) * InSetup.CellSize;
+
+        if (PositionJitterCells > 0.0f)
+        {
+            Unit.X += Random.FRandRange(-PositionJitterCells, PositionJitterCells) * InSetup.CellSize;
+            Unit.Y += Random.FRandRange(-PositionJitterCells, PositionJitterCells) * InSetup.CellSize;
+        }
+
+        if (bRandomizeAttackPhase)
+        {
+            Unit.NextAttackTime = Random.FRand() * Unit.Stats->AttackCooldown;
+        }
+    }
+}
+
+/// <summary>
+/// Przelicza czas na liczbe tickow (tryb stalopozycyjny liczy czas w tickach).
+/// </summary>
+/// <param name="Seconds">Czas w sekundach</param>
+/// <returns>Liczba tickow</returns>
+int32 FBattleSimState::SecondsToTicks(float Seconds) const
+{
+    return FMath::Max(FMath::RoundToInt(static_cast<double>(Seconds) / TickSeconds), 0);
+}
+
+/// <summary>
+/// Sprawdza czy bitwa sie zakonczyla (jedna strona wyeliminowana lub limit czasu).
+/// </summary>
+/// <returns>True jesli kolejne ticki nic nie zmienia</returns>
+bool FBattleSimState::IsFinished() const
+{
+    if (!Setup || Alive[0] <= 0 || Alive[1] <= 0)
+    {
+        return true;
+    }
+    return bFixedPoint ? TickCount >= MaxBattleTicks : Time >= Setup->MaxBattleSeconds;
+}
+
+/// <summary>
+/// Najblizszy zywy wrog w zasiegu wyszukiwania (ta sama regula co USpatialGrid::FindNearestEnemy).
+/// </summary>
+/// <param name="SeekerIndex">Indeks szukajacej jednostki</param>
+/// <returns>Indeks wroga lub INDEX_NONE</returns>
+int32 FBattleSimState::FindNearestEnemyIndex(int32 SeekerIndex) const
+{
+    const FSimUnitState& Seeker = Units[SeekerIndex];
+    const float SearchRangeSq = FMath::Square(Seeker.Stats->SearchRange);
+    float NearestDistanceSq = MAX_flt;
+    int32 NearestIndex = INDEX_NONE;
+
+    for (int32 i = 0; i < Units.Num(); i++)
+    {
+        const FSimUnitState& Other = Units[i];
+        if (Other.Health <= 0 || Other.Team == Seeker.Team)
+        {
+            continue;
+        }
+
+        const float DistanceSq = FMath::Square(Other.X - Seeker.X) + FMath::Square(Other.Y - Seeker.Y);
+        if (DistanceSq <= SearchRangeSq && DistanceSq < NearestDistanceSq)
+        {
+            NearestDistanceSq = DistanceSq;
+            NearestIndex = i;
+        }
+    }
+
+    return NearestIndex;
+}
+
+/// <summary>
+/// Najblizszy wrog w trybie stalopozycyjnym - kwadraty odleglosci w int64, remis wygrywa nizszy indeks.
+/// </summary>
+/// <param name="SeekerIndex">Indeks szukajacej jednostki</param>
+/// <param name="SearchRangeSq">Kwadrat zasiegu wyszukiwania</param>
+/// <returns>Indeks wroga lub INDEX_NONE</returns>
+int32 FBattleSimState::FindNearestEnemyIndexFixed(int32 SeekerIndex, int64 SearchRangeSq) const
+{
+    const FSimUnitState& Seeker = Units[SeekerIndex];
+    int64 NearestDistanceSq = MAX_int64;
+    int32 NearestIndex = INDEX_NONE;
+
+    for (int32 i = 0; i < Units.Num(); i++)
+    {
+        const FSimUnitState& Other = Units[i];
+        if (Other.Health <= 0 || Other.Team == Seeker.Team)
+        {
+            continue;
+        }
+
+        const int64 DeltaX = static_cast<int64>(Other.FixedX) - Seeker.FixedX;
+        const int64 DeltaY = static_cast<int64>(Other.FixedY) - Seeker.FixedY;
+        const int64 DistanceSq = DeltaX * DeltaX + DeltaY * DeltaY;
+        if (DistanceSq <= SearchRangeSq && DistanceSq < NearestDistanceSq)
+        {
+            NearestDistanceSq = DistanceSq;
+            NearestIndex = i;
+        }
+    }
+
+    return NearestIndex;
+}
+
+/// <summary>
+/// Faza decyzji dla jednej grupy typu: cel, atak lub ruch. Instancja na typ - indeks typu jest stala
+/// czasu kompilacji, wiec stale typu i wiersz tablicy obrazen sa adresowane bezposrednio. Pominiecie
+/// martwej jednostki i jednostki bez celu to zwykle skoki; sam wybor miedzy atakiem i ruchem liczy
+/// obie mozliwosci i wybiera wynik przez select.
+/// </summary>
+template <EBaseUnitType UnitType>
+void FBattleSimState::StepTypeGroup()
+{
+    constexpr int32 TypeIndex = static_cast<int32>(UnitType);
+    static_assert(TypeIndex < FBattleSimSetup::NumUnitTypes, "Typ jednostki poza tablica typow symulatora");
+
+    const FSimUnitStats& Stats = Setup->TypeStats[TypeIndex];
+    const float AttackRangeSq = FMath::Square(Stats.AttackRange);
+    const float StepLength = Stats.Speed;
+    const float AttackCooldown = Stats.AttackCooldown;
+    const float MovementInterval = Stats.MovementInterval;
+    const int32* DamageAgainst = DamageTable[TypeIndex];
+
+    for (const int32 UnitIndex : TypeGroups[TypeIndex])
+    {
+        FSimUnitState& Unit = Units[UnitIndex];
+        if (Unit.Health <= 0)
+        {
+            continue;
+        }
+
+        if (Unit.Target == INDEX_NONE || Units[Unit.Target].Health <= 0)
+        {
+            Unit.Target = FindNearestEnemyIndex(UnitIndex);
+            if (Unit.Target == INDEX_NONE)
+            {
+                continue;
+            }
+        }
+
+        FSimUnitState& Target = Units[Unit.Target];
+        const float DeltaX = Target.X - Unit.X;
+        const float DeltaY = Target.Y - Unit.Y;
+        const float DistanceSq = DeltaX * DeltaX + DeltaY * DeltaY;
+
+        const bool bInRange = DistanceSq <= AttackRangeSq;
+        const bool bAttack = bInRange & (Time >= Unit.NextAttackTime);
+        const bool bMove = !bInRange & (Time >= Unit.NextMoveTime);
+
+        Target.PendingDamage += DamageAgainst[Target.TypeIndex] * static_cast<int32>(bAttack);
+        Unit.NextAttackTime = bAttack ? Time + AttackCooldown : Unit.NextAttackTime;
+
+        // Poza zasiegiem DistanceSq > 0, wiec Max nie zmienia kroku - chroni tylko niewybrana galaz
+        const float StepScale = bMove ? FMath::InvSqrt(FMath::Max(DistanceSq, SMALL_NUMBER)) * StepLength : 0.0f;
+        Unit.X += DeltaX * StepScale;
+        Unit.Y += DeltaY * StepScale;
+        Unit.NextMoveTime = bMove ? Time + MovementInterval : Unit.NextMoveTime;
+    }
+}
+
+/// <summary>
+/// Odpowiednik StepTypeGroup na liczbach calkowitych: czas w tickach, odleglosci jako kwadraty int64,
+/// krok ruchu wzdluz najblizszego kierunku z tablicy mnozony przez maske ruchu.
+/// </summary>
+template <EBaseUnitType UnitType>
+void FBattleSimState::StepTypeGroupFixed()
+{
+    constexpr int32 TypeIndex = static_cast<int32>(UnitType);
+    static_assert(TypeIndex < FBattleSimSetup::NumUnitTypes, "Typ jednostki poza tablica typow symulatora");
+
+    const FFixedTypeStats& Stats = FixedTypeStats[TypeIndex];
+    const int64 AttackRangeSq = static_cast<int64>(Stats.AttackRange) * Stats.AttackRange;
+    const int64 SearchRangeSq = static_cast<int64>(Stats.SearchRange) * Stats.SearchRange;
+    const int32* DamageAgainst = DamageTable[TypeIndex];
+
+    for (const int32 UnitIndex : TypeGroups[TypeIndex])
+    {
+        FSimUnitState& Unit = Units[UnitIndex];
+        if (Unit.Health <= 0)
+        {
+            continue;
+        }
+
+        if (Unit.Target == INDEX_NONE || Units[Unit.Target].Health <= 0)
+        {
+            Unit.Target = FindNearestEnemyIndexFixed(UnitIndex, SearchRangeSq);
+            if (Unit.Target == INDEX_NONE)
+            {
+                continue;
+            }
+        }
+
+        FSimUnitState& Target = Units[Unit.Target];
+        const int64 DeltaX = static_cast<int64>(Target.FixedX) - Unit.FixedX;
+        const int64 DeltaY = static_cast<int64>(Target.FixedY) - Unit.FixedY;
+        const int64 DistanceSq = DeltaX * DeltaX + DeltaY * DeltaY;
+
+        const bool bInRange = DistanceSq <= AttackRangeSq;
+        const int32 AttackMask = static_cast<int32>(bInRange & (TickCount >= Unit.NextAttackTick));
+        const int32 MoveMask = static_cast<int32>(!bInRange & (TickCount >= Unit.NextMoveTick));
+
+        Target.PendingDamage += DamageAgainst[Target.TypeIndex] * AttackMask;
+        Unit.NextAttackTick += (TickCount + Stats.AttackCooldownTicks - Unit.NextAttackTick) * AttackMask;
+
+        int32 DirectionX = 0;
+        int32 DirectionY = 0;
+        FSimFixedMath::GetDirection(FSimFixedMath::DirectionIndex(DeltaX, DeltaY), DirectionX, DirectionY);
+
+        Unit.FixedX += FSimFixedMath::ScaleByDirection(DirectionX, Stats.StepLength) * MoveMask;
+        Unit.FixedY += FSimFixedMath::ScaleByDirection(DirectionY, Stats.StepLength) * MoveMask;
+        Unit.X = FSimFixedMath::ToFloat(Unit.FixedX);
+        Unit.Y = FSimFixedMath::ToFloat(Unit.FixedY);
+        Unit.NextMoveTick += (TickCount + Stats.MovementIntervalTicks - Unit.NextMoveTick) * MoveMask;
+    }
+}
+
+/// <summary>
+/// Jeden tick symulacji: faza decyzji, potem zbiorcze rozstrzygniecie obrazen.
+/// </summary>
+void FBattleSimState::Step()
+{
+    if (IsFinished())
+    {
+        return;
+    }
+
+    Time += TickSeconds;
+    TickCount++;
+
+    // Faza decyzji - grupami typow w kolejnosci EBaseUnitType, tryb wybierany raz na tick
+    static_assert(FBattleSimSetup::NumUnitTypes == 4, "Kazdy typ jednostki musi miec swoja instancje jadra kroku");
+    if (bFixedPoint)
+    {
+        StepTypeGroupFixed<EBaseUnitType::Tank>();
+        StepTypeGroupFixed<EBaseUnitType::Ninja>();
+        StepTypeGroupFixed<EBaseUnitType::Sword>();
+        StepTypeGroupFixed<EBaseUnitType::Armor>();
+    }
+    else
+    {
+        StepTypeGroup<EBaseUnitType::Tank>();
+        StepTypeGroup<EBaseUnitType::Ninja>();
+        StepTypeGroup<EBaseUnitType::Sword>();
+        StepTypeGroup<EBaseUnitType::Armor>();
+    }
+
+    // Faza rozstrzygniecia - obrazenia z calego ticka naraz
+    for (FSimUnitState& Unit : Units)
+    {
+        if (Unit.PendingDamage > 0 && Unit.Health > 0)
+        {
+            Unit.Health -= Unit.PendingDamage;
+            if (Unit.Health <= 0)
+            {
+                Unit.Health = 0;
+                Alive[Unit.Team]--;
+            }
+        }
+        Unit.PendingDamage = 0;
+    }
+}
+
+/// <summary>
+/// Odtwarzanie w czasie rzeczywistym - przesuwa symulacje o DeltaSeconds.
+/// Predkosc odtwarzania to po prostu skalowanie DeltaSeconds przez wywolujacego.
+/// </summary>
+/// <param name="DeltaSeconds">Czas do zasymulowania</param>
+/// <returns>Liczba wykonanych tickow</returns>
+int32 FBattleSimState::Advance(float DeltaSeconds)
+{
+    TimeAccumulator += FMath::Max(DeltaSeconds, 0.0f);
+
+    int32 StepsTaken = 0;
+    while (TimeAccumulator >= TickSeconds && !IsFinished())
+    {
+        TimeAccumulator -= TickSeconds;
+        Step();
+        StepsTaken++;
+    }
+
+    if (IsFinished())
+    {
+        TimeAccumulator = 0.0f;
+    }
+
+    return StepsTaken;
+}
+
+/// <summary>
+/// Skrot calego stanu symulacji (bity pozycji, zdrowie, cele, cooldowny). Dwie deterministyczne
+/// symulacje tej samej bitwy musza dawac identyczny skrot po kazdym ticku.
+/// </summary>
+/// <returns>CRC32 stanu</returns>
+uint32 FBattleSimState::ComputeStateHash() const
+{
+    // Bez dopelnienia - skrot liczony z dokladnych bitow pol
+    struct FHashedUnitFields
+    {
+        float X, Y, NextAttackTime, NextMoveTime;
+        int32 Health, Target;
+    };
+
+    uint32 Hash = FCrc::MemCrc32(&TickCount, sizeof(TickCount));
+
+    // W trybie stalopozycyjnym skrot obejmuje tylko liczby calkowite - identyczny w kazdym buildzie
+    if (bFixedPoint)
+    {
+        struct FHashedFixedUnitFields
+        {
+            int32 FixedX, FixedY, NextAttackTick, NextMoveTick;
+            int32 Health, Target;
+        };
+
+        for (const FSimUnitState& Unit : Units)
+        {
+            const FHashedFixedUnitFields Fields = { Unit.FixedX, Unit.FixedY, Unit.NextAttackTick, Unit.NextMoveTick, Unit.Health, Unit.Target };
+            Hash = FCrc::MemCrc32(&Fields, sizeof(Fields), Hash);
+        }
+        return Hash;
+    }
+
+    for (const FSimUnitState& Unit : Units)
+    {
+        const FHashedUnitFields Fields = { Unit.X, Unit.Y, Unit.NextAttackTime, Unit.NextMoveTime, Unit.Health, Unit.Target };
+        Hash = FCrc::MemCrc32(&Fields, sizeof(Fields), Hash);
+    }
+    return Hash;
+}
+
+/// <summary>
+/// Zapisuje lub odczytuje stan dynamiczny wszystkich jednostek. Liczba jednostek musi sie zgadzac
+/// ze stanem odczytujacym - inaczej archiwum dostaje blad, a stan pozostaje bez zmian.
+/// </summary>
+/// <param name="Ar">Archiwum zapisu lub odczytu</param>
+void FBattleSimState::SerializeSnapshot(FArchive& Ar)
+{
+    int32 NumUnits = Units.Num();
+    int32 SnapshotTickCount = TickCount;
+    float SnapshotTime = Time;
+    Ar << NumUnits << SnapshotTickCount << SnapshotTime;
+
+    if (Ar.IsLoading() && (NumUnits != Units.Num() || SnapshotTickCount < 0))
+    {
+        Ar.SetError();
+        return;
+    }
+
+    FSimUnitStateArray LoadedUnits = Units;
+    for (FSimUnitState& Unit : LoadedUnits)
+    {
+        Ar << Unit.X << Unit.Y << Unit.NextAttackTime << Unit.NextMoveTime;
+        Ar << Unit.FixedX << Unit.FixedY << Unit.NextAttackTick << Unit.NextMoveTick;
+        Ar << Unit.Health << Unit.Target;
+
+        if (Ar.IsLoading() && (Unit.Target < INDEX_NONE || Unit.Target >= NumUnits))
+        {
+            Ar.SetError();
+        }
+    }
+
+    if (!Ar.IsLoading() || Ar.IsError())
+    {
+        return;
+    }
+
+    Units = MoveTemp(LoadedUnits);
+    TickCount = SnapshotTickCount;
+    Time = SnapshotTime;
+    TimeAccumulator = 0.0f;
+
+    Alive[0] = 0;
+    Alive[1] = 0;
+    for (FSimUnitState& Unit : Units)
+    {
+        Unit.PendingDamage = 0;
+        if (Unit.Health > 0)
+        {
+            Alive[Unit.Team]++;
+        }
+    }
+}
+
+/// <summary>
+/// Wynik bitwy w aktualnym stanie.
+/// </summary>
+/// <returns>Wynik bitwy</returns>
+FBattleSimResult FBattleSimState::GetResult() const
+{
+    FBattleSimResult Result;
+    Result.DurationSeconds = Time;
+
+    for (const FSimUnitState& Unit : Units)
+    {
+        if (Unit.Health > 0)
+        {
+            Result.Survivors[Unit.Team]++;
+            Result.SurvivingCost[Unit.Team] += Unit.Stats->Cost;
+        }
+    }
+
+    // Ta sama regula co AStrategyGameMode::DetermineBattleWinner
+    if (Result.Survivors[0] > Result.Survivors[1])
+    {
+        Result.WinnerPlayerID = 0;
+    }
+    else if (Result.Survivors[1] > Result.Survivors[0])
+    {
+        Result.WinnerPlayerID = 1;
+    }
+
+    return Result;
+}
+
+/// <summary>
+/// Symuluje jedna bitwe z krokiem Setup.TickSeconds do wyeliminowania jednej strony lub limitu czasu.
+/// </summary>
+/// <param name="Setup">Stan poczatkowy bitwy</param>
+/// <param name="Seed">Ziarno losowania przesuniec i fazy ataku</param>
+/// <param name="PositionJitterCells">Maksymalne przesuniecie pozycji w komorkach siatki</param>
+/// <param name="bRandomizeAttackPhase">Losowy poczatkowy cooldown ataku</param>
+/// <returns>Wynik bitwy</returns>
+FBattleSimResult FBattleSimulator::RunBattle(const FBattleSimSetup& Setup, uint32 Seed,
+    float PositionJitterCells, bool bRandomizeAttackPhase)
+{
+    FBattleSimState State;
+    State.Initialize(Setup, Seed, PositionJitterCells, bRandomizeAttackPhase);
+
+    while (!State.IsFinished())
+    {
+        State.Step();
+    }
+
+    return State.GetResult();
+}
+
+/// <summary>
+/// Uruchamia serie bitew na watkach roboczych i agreguje wyniki.
+/// </summary>
+/// <param name="Request">Parametry serii</param>
+/// <returns>Zagregowane wyniki</returns>
+FBattleSimBatchResult FBattleSimulator::RunBatch(const FBattleSimBatchRequest& Request)
+{
+    FBattleSimBatchResult Batch;
+    Batch.NumBattles = FMath::Max(Request.NumBattles, 0);
+    if (Batch.NumBattles == 0)
+    {
+        return Batch;
+    }
+
+    TArray<FBattleSimResult> Results;
+    Results.SetNum(Batch.NumBattles);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    // Kazda bitwa zapisuje tylko wlasny element tablicy
+    ParallelFor(Batch.NumBattles, [&Request, &Results](int32 BattleIndex)
+    {
+        Results[BattleIndex] = RunBattle(Request.Setup, Request.BaseSeed + static_cast<uint32>(BattleIndex),
+            Request.PositionJitterCells, Request.bRandomizeAttackPhase);
+    }, Request.bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    Batch.WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+    // Agregacja
+    const int32 NumBuckets = FMath::CeilToInt(Request.Setup.MaxBattleSeconds / Batch.DurationBucketSeconds) + 1;
+    Batch.DurationHistogram.Init(0, NumBuckets);
+
+    TArray<float> Durations;
+    Durations.Reserve(Batch.NumBattles);
+
+    double TotalDuration = 0.0;
+    double TotalSurvivors[2] = { 0.0, 0.0 };
+    double TotalSurvivingCost[2] = { 0.0, 0.0 };
+
+    for (const FBattleSimResult& Result : Results)
+    {
+        if (Result.WinnerPlayerID == INDEX_NONE)
+        {
+            Batch.Draws++;
+        }
+        else
+        {
+            Batch.Wins[Result.WinnerPlayerID]++;
+        }
+
+        Durations.Add(Result.DurationSeconds);
+        TotalDuration += Result.DurationSeconds;
+        Batch.DurationHistogram[FMath::Clamp(FMath::FloorToInt(Result.DurationSeconds / Batch.DurationBucketSeconds), 0, NumBuckets - 1)]++;
+
+        for (int32 PlayerID = 0; PlayerID < 2; PlayerID++)
+        {
+            TotalSurvivors[PlayerID] += Result.Survivors[PlayerID];
+            TotalSurvivingCost[PlayerID] += Result.SurvivingCost[PlayerID];
+        }
+    }
+
+    Durations.Sort();
+    Batch.MeanDurationSeconds = static_cast<float>(TotalDuration / Batch.NumBattles);
+    Batch.MedianDurationSeconds = Durations[Batch.NumBattles / 2];
+    Batch.P90DurationSeconds = Durations[FMath::Min((Batch.NumBattles * 9) / 10, Batch.NumBattles - 1)];
+    Batch.MaxDurationSeconds = Durations.Last();
+
+    for (int32 PlayerID = 0; PlayerID < 2; PlayerID++)
+    {
+        Batch.WinRate[PlayerID] = static_cast<float>(Batch.Wins[PlayerID]) / Batch.NumBattles;
+        Batch.MeanSurvivors[PlayerID] = static_cast<float>(TotalSurvivors[PlayerID] / Batch.NumBattles);
+        Batch.MeanSurvivingCost[PlayerID] = static_cast<float>(TotalSurvivingCost[PlayerID] / Batch.NumBattles);
+    }
+
+    if (Request.bKeepBattleResults)
+    {
+        Batch.Battles = MoveTemp(Results);
+    }
+
+    return Batch;
+}
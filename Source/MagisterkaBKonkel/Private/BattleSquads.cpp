@@ -0,0 +1,238 @@
+// BattleSquads.cpp - Implementacja podzialu jednostek na oddzialy
+#include "BattleSquads.h"
+
+/// <summary>
+/// Przebudowa oddzialow z aktualnych pozycji jednostek.
+/// </summary>
+/// <param name="Inputs">Wpisy jednostek (indeksy wejsc sa indeksami czlonkow oddzialow)</param>
+/// <param name="LinkDistance">Najwieksza odleglosc miedzy sasiadami w jednym oddziale</param>
+/// <param name="MaxSquadSize">Najwieksza liczba czlonkow oddzialu</param>
+void FBattleSquadPlanner::Rebuild(const TArray<FSquadMemberInput>& Inputs, float LinkDistance, int32 MaxSquadSize)
+{
+    const int32 InputCount = Inputs.Num();
+
+    Squads.Reset();
+    MemberSquadIndex.Init(INDEX_NONE, InputCount);
+    LastStats = FSquadRebuildStats();
+
+    if (InputCount == 0 || LinkDistance <= 0.0f)
+    {
+        PreviousSquadByKey.Reset();
+        return;
+    }
+
+    MaxSquadSize = FMath::Max(1, MaxSquadSize);
+
+    // Kubelki o boku LinkDistance - sasiedzi w zasiegu leza w kubelku wpisu lub w jednym z 8 sasiednich
+    BucketHeads.Reset();
+    NextInBucket.SetNumUninitialized(InputCount);
+    InputBuckets.SetNumUninitialized(InputCount);
+
+    for (int32 InputIndex = 0; InputIndex < InputCount; InputIndex++)
+    {
+        const FVector2D& Position = Inputs[InputIndex].Position;
+        const FIntPoint Bucket(FMath::FloorToInt(Position.X / LinkDistance), FMath::FloorToInt(Position.Y / LinkDistance));
+        InputBuckets[InputIndex] = Bucket;
+
+        int32& Head = BucketHeads.FindOrAdd(Bucket, INDEX_NONE);
+        NextInBucket[InputIndex] = Head;
+        Head = InputIndex;
+    }
+
+    Assigned.Init(false, InputCount);
+    Queued.Init(false, InputCount);
+
+    TArray<int32> ClusterMembers;
+    for (int32 Seed = 0; Seed < InputCount; Seed++)
+    {
+        if (Assigned[Seed])
+        {
+            continue;
+        }
+
+        ClusterMembers.Reset();
+        CollectCluster(Inputs, Seed, LinkDistance, MaxSquadSize, ClusterMembers);
+
+        FBattleSquad& Squad = Squads.AddDefaulted_GetRef();
+        Squad.TeamID = Inputs[Seed].TeamID;
+        Squad.Members = ClusterMembers;
+
+        for (int32 Member : ClusterMembers)
+        {
+            Squad.Centroid += Inputs[Member].Position;
+        }
+        Squad.Centroid /= static_cast<float>(ClusterMembers.Num());
+
+        // Lider - czlonek najblizszy srodka oddzialu
+        float BestDistanceSq = MAX_flt;
+        for (int32 Member : ClusterMembers)
+        {
+            const float DistanceSq = FVector2D::DistSquared(Inputs[Member].Position, Squad.Centroid);
+            if (DistanceSq < BestDistanceSq)
+            {
+                BestDistanceSq = DistanceSq;
+                Squad.Leader = Member;
+            }
+        }
+
+        const FVector2D LeaderPosition = Inputs[Squad.Leader].Position;
+        Squad.FormationOffsets.Reserve(ClusterMembers.Num());
+        for (int32 Member : ClusterMembers)
+        {
+            Squad.FormationOffsets.Add(Inputs[Member].Position - LeaderPosition);
+            MemberSquadIndex[Member] = Squads.Num() - 1;
+        }
+    }
+
+    AssignSquadIDs(Inputs);
+    LastStats.SquadCount = Squads.Num();
+}
+
+void FBattleSquadPlanner::Reset()
+{
+    Squads.Reset();
+    MemberSquadIndex.Reset();
+    BucketHeads.Reset();
+    PreviousSquadByKey.Reset();
+    NextSquadID = 0;
+    LastStats = FSquadRebuildStats();
+}
+
+/// <summary>
+/// Przeszukiwanie wszerz od wpisu Seed po sojusznikach w zasiegu LinkDistance. Gdy oddzial jest
+/// pelny, wpisy pozostale w kolejce wracaja do puli i zaczna kolejne oddzialy.
+/// </summary>
+void FBattleSquadPlanner::CollectCluster(const TArray<FSquadMemberInput>& Inputs, int32 Seed, float LinkDistance, int32 MaxSquadSize, TArray<int32>& OutMembers)
+{
+    const float LinkDistanceSq = LinkDistance * LinkDistance;
+    const int32 TeamID = Inputs[Seed].TeamID;
+
+    SearchQueue.Reset();
+    SearchQueue.Add(Seed);
+    Queued[Seed] = true;
+
+    int32 QueueHead = 0;
+    while (QueueHead < SearchQueue.Num() && OutMembers.Num() < MaxSquadSize)
+    {
+        const int32 Current = SearchQueue[QueueHead++];
+        Queued[Current] = false;
+        Assigned[Current] = true;
+        OutMembers.Add(Current);
+
+        const FIntPoint CurrentBucket = InputBuckets[Current];
+        for (int32 OffsetY = -1; OffsetY <= 1; OffsetY++)
+        {
+            for (int32 OffsetX = -1; OffsetX <= 1; OffsetX++)
+            {
+                const int32* Head = BucketHeads.Find(CurrentBucket + FIntPoint(OffsetX, OffsetY));
+                if (!Head)
+                {
+                    continue;
+                }
+
+                for (int32 Other = *Head; Other != INDEX_NONE; Other = NextInBucket[Other])
+                {
+                    if (Assigned[Other] || Queued[Other] || Inputs[Other].TeamID != TeamID)
+                    {
+                        continue;
+                    }
+
+                    if (FVector2D::DistSquared(Inputs[Current].Position, Inputs[Other].Position) > LinkDistanceSq)
+                    {
+                        continue;
+                    }
+
+                    Queued[Other] = true;
+                    SearchQueue.Add(Other);
+                }
+            }
+        }
+    }
+
+    for (int32 Remaining = QueueHead; Remaining < SearchQueue.Num(); Remaining++)
+    {
+        Queued[SearchQueue[Remaining]] = false;
+    }
+}
+
+/// <summary>
+/// Nadanie ID oddzialom. Wieksze oddzialy wybieraja pierwsze - kazdy przejmuje ID poprzedniego
+/// oddzialu, z ktorego pochodzi najwiecej jego czlonkow, o ile nie zajal go juz inny oddzial.
+/// Oddzial z czlonkami kilku poprzednich oddzialow to polaczenie, a poprzedni oddzial rozrzucony
+/// po kilku nowych - podzial.
+/// </summary>
+void FBattleSquadPlanner::AssignSquadIDs(const TArray<FSquadMemberInput>& Inputs)
+{
+    TArray<int32> SquadOrder;
+    SquadOrder.Reserve(Squads.Num());
+    for (int32 SquadIndex = 0; SquadIndex < Squads.Num(); SquadIndex++)
+    {
+        SquadOrder.Add(SquadIndex);
+    }
+
+    SquadOrder.StableSort([this](int32 A, int32 B)
+    {
+        return Squads[A].Num() > Squads[B].Num();
+    });
+
+    TSet<int32> ClaimedIDs;
+    TMap<int32, int32> SquadsPerPreviousID;
+    TMap<int32, int32> Votes;
+
+    for (int32 SquadIndex : SquadOrder)
+    {
+        FBattleSquad& Squad = Squads[SquadIndex];
+
+        Votes.Reset();
+        for (int32 Member : Squad.Members)
+        {
+            if (const int32* PreviousID = PreviousSquadByKey.Find(Inputs[Member].Key))
+            {
+                Votes.FindOrAdd(*PreviousID)++;
+            }
+        }
+
+        if (Votes.Num() > 1)
+        {
+            LastStats.MergeCount++;
+        }
+
+        int32 BestID = INDEX_NONE;
+        int32 BestVotes = 0;
+        for (const TPair<int32, int32>& Vote : Votes)
+        {
+            SquadsPerPreviousID.FindOrAdd(Vote.Key)++;
+
+            if (ClaimedIDs.Contains(Vote.Key))
+            {
+                continue;
+            }
+
+            if (Vote.Value > BestVotes || (Vote.Value == BestVotes && Vote.Key < BestID))
+            {
+                BestVotes = Vote.Value;
+                BestID = Vote.Key;
+            }
+        }
+
+        Squad.SquadID = BestID != INDEX_NONE ? BestID : NextSquadID++;
+        ClaimedIDs.Add(Squad.SquadID);
+    }
+
+    for (const TPair<int32, int32>& PreviousSquad : SquadsPerPreviousID)
+    {
+        if (PreviousSquad.Value > 1)
+        {
+            LastStats.SplitCount++;
+        }
+    }
+
+    PreviousSquadByKey.Reset();
+    for (const FBattleSquad& Squad : Squads)
+    {
+        for (int32 Member : Squad.Members)
+        {
+            PreviousSquadByKey.Add(Inputs[Member].Key, Squad.SquadID);
+        }
+    }
+}
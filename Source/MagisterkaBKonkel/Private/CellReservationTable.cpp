@@ -0,0 +1,243 @@
+// CellReservationTable.cpp - Implementacja tablicy rezerwacji komorek z compare-and-swap
+#include "CellReservationTable.h"
+#include "Async/ParallelFor.h"
+
+/// <summary>
+/// Przygotowuje tablice dla siatki o podanych wymiarach. Pierwszy tick zaczyna sie od razu.
+/// </summary>
+/// <param name="InWidth">Szerokosc siatki</param>
+/// <param name="InHeight">Wysokosc siatki</param>
+void FCellReservationTable::Initialize(int32 InWidth, int32 InHeight)
+{
+    Width = FMath::Max(InWidth, 0);
+    Height = FMath::Max(InHeight, 0);
+    Cells.Init(0, Width * Height);
+
+    // Tick 0 jest zarezerwowany dla wyzerowanych komorek
+    CurrentTick = 1;
+}
+
+/// <summary>
+/// Zwalnia tablice - do ponownego uzycia wymaga Initialize.
+/// </summary>
+void FCellReservationTable::Reset()
+{
+    Width = 0;
+    Height = 0;
+    CurrentTick = 0;
+    Cells.Empty();
+}
+
+/// <summary>
+/// Rozpoczyna nowy tick. Wywolywane na watku gry miedzy fazami ruchu.
+/// </summary>
+void FCellReservationTable::BeginTick()
+{
+    CurrentTick = (CurrentTick + 1) & TickMask;
+
+    // Po przepelnieniu licznika stare wpisy moglyby pasowac do nowego ticku
+    if (CurrentTick == 0)
+    {
+        FMemory::Memzero(Cells.GetData(), Cells.Num() * sizeof(int64));
+        CurrentTick = 1;
+    }
+}
+
+/// <summary>
+/// Oznacza komorke jako zajeta przez stojaca jednostke. Zgloszenia z tego ticku zostaja zachowane.
+/// </summary>
+/// <param name="Cell">Komorka siatki</param>
+void FCellReservationTable::MarkOccupied(const FGridCell& Cell)
+{
+    if (!IsValidCell(Cell))
+    {
+        return;
+    }
+
+    volatile int64* Slot = &Cells[Cell.ToIndex(Width)];
+    int64 Observed = FPlatformAtomics::AtomicRead(Slot);
+
+    while (true)
+    {
+        const uint64 Current = static_cast<uint64>(Observed);
+        const uint64 NewValue = UnpackTick(Current) == CurrentTick
+            ? (Current | OccupiedBit)
+            : (Pack(CurrentTick, 0, NoClaimant) | OccupiedBit);
+
+        const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(Slot, static_cast<int64>(NewValue), Observed);
+        if (Previous == Observed)
+        {
+            return;
+        }
+
+        Observed = Previous;
+    }
+}
+
+/// <summary>
+/// Zgloszenie ruchu do komorki (bezpieczne dla wielu watkow). Petla compare-and-swap: wpis
+/// z poprzedniego ticku lub slabsze zgloszenie z tego ticku jest zastepowane.
+/// </summary>
+/// <param name="Cell">Komorka docelowa</param>
+/// <param name="ClaimantID">ID zglaszajacego (0 - MaxClaimantID)</param>
+/// <param name="Priority">Priorytet (0 - MaxMovePriority), wyzszy wygrywa</param>
+/// <param name="bCanEnterOccupied">Czy zglaszajacy moze wejsc do komorki zajetej przez jednostke (np. swojego celu)</param>
+/// <returns>true jesli zgloszenie prowadzi w tej chwili, false - wpp</returns>
+bool FCellReservationTable::TryClaim(const FGridCell& Cell, int32 ClaimantID, uint32 Priority, bool bCanEnterOccupied)
+{
+    if (!IsValidCell(Cell) || ClaimantID < 0 || ClaimantID > MaxClaimantID)
+    {
+        return false;
+    }
+
+    const uint64 Claim = Pack(CurrentTick, FMath::Min(Priority, MaxMovePriority), static_cast<uint32>(ClaimantID));
+
+    volatile int64* Slot = &Cells[Cell.ToIndex(Width)];
+    int64 Observed = FPlatformAtomics::AtomicRead(Slot);
+
+    while (true)
+    {
+        const uint64 Current = static_cast<uint64>(Observed);
+        uint64 NewValue = Claim;
+
+        if (UnpackTick(Current) == CurrentTick)
+        {
+            if ((Current & OccupiedBit) != 0)
+            {
+                if (!bCanEnterOccupied)
+                {
+                    return false;
+                }
+                NewValue |= OccupiedBit;
+            }
+
+            if (ClaimKey(Current) >= ClaimKey(Claim))
+            {
+                return false;
+            }
+        }
+
+        const int64 Previous = FPlatformAtomics::InterlockedCompareExchange(Slot, static_cast<int64>(NewValue), Observed);
+        if (Previous == Observed)
+        {
+            return true;
+        }
+
+        Observed = Previous;
+    }
+}
+
+/// <summary>
+/// Czy komorka nalezy po fazie zgloszen do danego zglaszajacego.
+/// </summary>
+bool FCellReservationTable::IsClaimedBy(const FGridCell& Cell, int32 ClaimantID) const
+{
+    const uint64 Value = ReadCell(Cell);
+    return UnpackTick(Value) == CurrentTick && UnpackClaimant(Value) == static_cast<uint32>(ClaimantID);
+}
+
+/// <summary>
+/// Czy w tym ticku komorke trzyma stojaca jednostka.
+/// </summary>
+bool FCellReservationTable::IsOccupied(const FGridCell& Cell) const
+{
+    const uint64 Value = ReadCell(Cell);
+    return UnpackTick(Value) == CurrentTick && (Value & OccupiedBit) != 0;
+}
+
+/// <summary>
+/// Zgloszenia ruchu z migawki. Kazde zgloszenie to niezalezny compare-and-swap, a zwyciezca komorki
+/// nie zalezy od kolejnosci watkow, wiec wynik jest ten sam co przy wykonaniu sekwencyjnym.
+/// </summary>
+/// <param name="Claims">Migawka zgloszen; indeks jest ID zglaszajacego</param>
+/// <param name="bParallel">false wymusza wykonanie na jednym watku</param>
+void FCellReservationTable::ClaimAll(const TArray<FCellMoveClaim>& Claims, bool bParallel)
+{
+    ParallelFor(Claims.Num(), [this, &Claims](int32 ClaimIndex)
+        {
+            const FCellMoveClaim& Claim = Claims[ClaimIndex];
+            TryClaim(Claim.Cell, ClaimIndex, Claim.Priority, Claim.bCanEnterOccupied);
+        },
+        bParallel ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+}
+
+/// <summary>
+/// Wykonanie zwycieskich zgloszen w kolejnosci zaleznosci. Ruch do wolnej komorki (lub komorki celu)
+/// jest wykonywany od razu; ruch do komorki zajetej czeka, az jej mieszkancy z niej wyjda, wiec
+/// kolumna jednostek przesuwa sie w jednym ticku od czola. Zamiana miejsc i dluzsze cykle nie sa
+/// wykonywane - jednostki przeszlyby przez siebie.
+/// </summary>
+/// <param name="Claims">Migawka zgloszen z ClaimAll</param>
+/// <param name="OccupiedCells">Komorki jednostek na poczatku ticku, po jednym wpisie na jednostke</param>
+/// <param name="ExecuteMove">Wykonanie ruchu zgloszenia; false - jednostka zostala w swojej komorce</param>
+/// <param name="OutResolved">true dla zgloszen przekazanych do ExecuteMove</param>
+void FCellReservationTable::ResolveClaims(const TArray<FCellMoveClaim>& Claims, const TArray<FGridCell>& OccupiedCells,
+    TFunctionRef<bool(int32 ClaimIndex)> ExecuteMove, TBitArray<>& OutResolved) const
+{
+    OutResolved.Init(false, Claims.Num());
+
+    TMap<FGridCell, int32> OccupantCounts;
+    OccupantCounts.Reserve(OccupiedCells.Num());
+    for (const FGridCell& Cell : OccupiedCells)
+    {
+        OccupantCounts.FindOrAdd(Cell)++;
+    }
+
+    // Zwyciezca komorki zajetej czeka na jej zwolnienie; zwyciezca jest jeden na komorke
+    TMap<FGridCell, int32> WaitingClaims;
+    TArray<int32> ReadyClaims;
+    ReadyClaims.Reserve(Claims.Num());
+    for (int32 ClaimIndex = 0; ClaimIndex < Claims.Num(); ClaimIndex++)
+    {
+        const FCellMoveClaim& Claim = Claims[ClaimIndex];
+        if (!IsClaimedBy(Claim.Cell, ClaimIndex))
+        {
+            continue;
+        }
+
+        if (Claim.bCanEnterOccupied || OccupantCounts.FindRef(Claim.Cell) == 0)
+        {
+            ReadyClaims.Add(ClaimIndex);
+        }
+        else
+        {
+            WaitingClaims.Add(Claim.Cell, ClaimIndex);
+        }
+    }
+
+    for (int32 ReadyIndex = 0; ReadyIndex < ReadyClaims.Num(); ReadyIndex++)
+    {
+        const int32 ClaimIndex = ReadyClaims[ReadyIndex];
+        OutResolved[ClaimIndex] = true;
+        if (!ExecuteMove(ClaimIndex))
+        {
+            continue;
+        }
+
+        const FGridCell& FromCell = Claims[ClaimIndex].FromCell;
+        int32* OccupantCount = OccupantCounts.Find(FromCell);
+        int32 WaitingClaim = INDEX_NONE;
+        if (OccupantCount && --(*OccupantCount) == 0 && WaitingClaims.RemoveAndCopyValue(FromCell, WaitingClaim))
+        {
+            ReadyClaims.Add(WaitingClaim);
+        }
+    }
+}
+
+uint64 FCellReservationTable::Pack(uint32 Tick, uint32 Priority, uint32 ClaimantID)
+{
+    return (static_cast<uint64>(Tick & TickMask) << 40) | (static_cast<uint64>(Priority & MaxMovePriority) << 24) | (ClaimantID & ClaimantMask);
+}
+
+bool FCellReservationTable::IsValidCell(const FGridCell& Cell) const
+{
+    return Cell.IsInside(Width, Height);
+}
+
+/// <summary>
+/// Odczyt slowa komorki; komorka poza siatka daje 0 (tick 0 nigdy nie jest biezacy).
+/// </summary>
+uint64 FCellReservationTable::ReadCell(const FGridCell& Cell) const
+{
+    return IsValidCell(Cell) ? static_cast<uint64>(FPlatformAtomics::AtomicRead(&Cells[Cell.ToIndex(Width)])) : 0;
+}
@@ -0,0 +1,215 @@
+// CombatStressTest.cpp - Implementacja trybu obciazeniowego walki i komendy konsoli
+#include "CombatStressTest.h"
+#include "UnitManager.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+FString FCombatStressReport::ToString() const
+{
+    return FString::Printf(TEXT("Jednostki: %d (ocalale: %d), klatki: %d, czas klatki ms - sredni: %.2f, p50: %.2f, p90: %.2f, p99: %.2f, max: %.2f, ")
+        TEXT("spawn: %.2f s, pamiec/jednostke: %.0f B (obiekt aktora: %d B)"),
+        UnitCount, SurvivingUnits, TickSamples, MeanTickMs, P50TickMs, P90TickMs, P99TickMs, MaxTickMs,
+        SpawnSeconds, MeasuredBytesPerUnit, ActorObjectBytes);
+}
+
+void FCombatStressTickRecorder::Reset(int32 ExpectedSamples)
+{
+    SamplesMs.Reset(ExpectedSamples);
+}
+
+void FCombatStressTickRecorder::AddSample(float TickMs)
+{
+    SamplesMs.Add(TickMs);
+}
+
+/// <summary>
+/// Wypelnia pola czasu klatki raportu (srednia, p50, p90, p99, max).
+/// </summary>
+/// <param name="OutReport">Raport do uzupelnienia</param>
+void FCombatStressTickRecorder::Summarize(FCombatStressReport& OutReport) const
+{
+    OutReport.TickSamples = SamplesMs.Num();
+    if (SamplesMs.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<float> Sorted = SamplesMs;
+    Sorted.Sort();
+
+    double Total = 0.0;
+    for (float Sample : Sorted)
+    {
+        Total += Sample;
+    }
+
+    auto Percentile = [&Sorted](float Fraction)
+    {
+        const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+        return Sorted[Index];
+    };
+
+    OutReport.MeanTickMs = static_cast<float>(Total / Sorted.Num());
+    OutReport.P50TickMs = Percentile(0.50f);
+    OutReport.P90TickMs = Percentile(0.90f);
+    OutReport.P99TickMs = Percentile(0.99f);
+    OutReport.MaxTickMs = Sorted.Last();
+}
+
+/// <summary>
+/// Generuje pozycje swiata (XY) jednej armii w wybranym szyku.
+/// </summary>
+/// <param name="Config">Parametry testu</param>
+/// <param name="PlayerID">Gracz 0 lub 1</param>
+/// <param name="OutPositions">Pozycje jednostek</param>
+void FCombatStressFormation::Generate(const FCombatStressConfig& Config, int32 PlayerID, TArray<FVector2D>& OutPositions)
+{
+    const int32 Count = FMath::Clamp(Config.UnitsPerSide, 0, 50000);
+    const float Spacing = FMath::Max(Config.Spacing, 1.0f);
+
+    // Szereg 0 stoi przy froncie, kolejne szeregi oddalaja sie od przeciwnika
+    const float Facing = (PlayerID == 0) ? -1.0f : 1.0f;
+    const float FrontY = Facing * (Config.FrontGap * 0.5f);
+
+    OutPositions.Reset(Count);
+
+    switch (Config.Formation)
+    {
+    case EStressFormation::Line:
+    {
+        // Cztery szeregi na calej szerokosci
+        const int32 Ranks = FMath::Min(4, FMath::Max(Count, 1));
+        const int32 Files = FMath::DivideAndRoundUp(Count, Ranks);
+        for (int32 i = 0; i < Count; i++)
+        {
+            const int32 Rank = i / Files;
+            const int32 File = i % Files;
+            OutPositions.Add(FVector2D((File - (Files - 1) * 0.5f) * Spacing, FrontY + Facing * Rank * Spacing));
+        }
+        break;
+    }
+    case EStressFormation::Wedge:
+    {
+        // Szereg r ma 2r+1 jednostek - ostrze klina skierowane do przeciwnika
+        int32 Placed = 0;
+        for (int32 Rank = 0; Placed < Count; Rank++)
+        {
+            const int32 RankWidth = 2 * Rank + 1;
+            for (int32 File = 0; File < RankWidth && Placed < Count; File++, Placed++)
+            {
+                OutPositions.Add(FVector2D((File - Rank) * Spacing, FrontY + Facing * Rank * Spacing));
+            }
+        }
+        break;
+    }
+    case EStressFormation::Scattered:
+    {
+        // Losowo w kwadracie o polu takim jak dla szyku Block
+        const int32 Side = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count))), 1);
+        const float HalfWidth = Side * Spacing * 0.5f;
+        FRandomStream Random(Config.Seed * 2 + PlayerID);
+        for (int32 i = 0; i < Count; i++)
+        {
+            OutPositions.Add(FVector2D(Random.FRandRange(-HalfWidth, HalfWidth), FrontY + Facing * Random.FRandRange(0.0f, Side * Spacing)));
+        }
+        break;
+    }
+    case EStressFormation::Block:
+    default:
+    {
+        const int32 Files = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count))), 1);
+        for (int32 i = 0; i < Count; i++)
+        {
+            const int32 Rank = i / Files;
+            const int32 File = i % Files;
+            OutPositions.Add(FVector2D((File - (Files - 1) * 0.5f) * Spacing, FrontY + Facing * Rank * Spacing));
+        }
+        break;
+    }
+    }
+}
+
+/// <summary>
+/// Granice planszy obejmujace obie armie.
+/// </summary>
+/// <param name="Player0Positions">Pozycje armii gracza 0</param>
+/// <param name="Player1Positions">Pozycje armii gracza 1</param>
+/// <param name="Margin">Margines wokol armii</param>
+/// <returns>Prostokat planszy</returns>
+FBox2D FCombatStressFormation::ComputeBoardBounds(const TArray<FVector2D>& Player0Positions, const TArray<FVector2D>& Player1Positions, float Margin)
+{
+    FBox2D Bounds(ForceInit);
+    for (const FVector2D& Position : Player0Positions)
+    {
+        Bounds += Position;
+    }
+    for (const FVector2D& Position : Player1Positions)
+    {
+        Bounds += Position;
+    }
+
+    if (!Bounds.bIsValid)
+    {
+        Bounds = FBox2D(FVector2D::ZeroVector, FVector2D::ZeroVector);
+    }
+
+    return Bounds.ExpandBy(Margin);
+}
+
+namespace
+{
+    /// <summary>
+    /// Game.CombatStressTest JednostekNaStrone [Block|Line|Wedge|Scattered] [Prezentacja 0/1] [Sekundy]
+    /// </summary>
+    void RunCombatStressTestCommand(const TArray<FString>& Args, UWorld* World)
+    {
+        if (!World)
+        {
+            return;
+        }
+
+        TActorIterator<AUnitManager> UnitManagerIterator(World);
+        AUnitManager* UnitManager = UnitManagerIterator ? *UnitManagerIterator : nullptr;
+        if (!UnitManager || !UnitManager->HasAuthority())
+        {
+            UE_LOG(LogTemp, Error, TEXT("=== TEST OBCIAZENIOWY: Brak UnitManagera z autorytetem w tym swiecie ==="));
+            return;
+        }
+
+        if (Args.Num() > 0 && Args[0] == TEXT("stop"))
+        {
+            UnitManager->FinishCombatStressTest();
+            return;
+        }
+
+        FCombatStressConfig Config;
+        if (Args.Num() > 0)
+        {
+            Config.UnitsPerSide = FMath::Clamp(FCString::Atoi(*Args[0]), 1, 50000);
+        }
+        if (Args.Num() > 1)
+        {
+            const int64 FormationValue = StaticEnum<EStressFormation>()->GetValueByNameString(Args[1]);
+            if (FormationValue != INDEX_NONE)
+            {
+                Config.Formation = static_cast<EStressFormation>(FormationValue);
+            }
+        }
+        if (Args.Num() > 2)
+        {
+            Config.bWithPresentation = FCString::Atoi(*Args[2]) != 0;
+        }
+        if (Args.Num() > 3)
+        {
+            Config.DurationSeconds = FMath::Max(FCString::Atof(*Args[3]), 0.1f);
+        }
+
+        UnitManager->StartCombatStressTest(Config);
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs GCombatStressTestCommand(
+        TEXT("Game.CombatStressTest"),
+        TEXT("Test obciazeniowy walki: Game.CombatStressTest <JednostekNaStrone 1-50000> [Block|Line|Wedge|Scattered] [Prezentacja 0/1] [Sekundy]; Game.CombatStressTest stop"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunCombatStressTestCommand));
+}
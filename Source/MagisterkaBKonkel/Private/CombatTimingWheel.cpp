@@ -0,0 +1,133 @@
+// CombatTimingWheel.cpp - Implementacja hierarchicznego kola czasowego dla timerow walki
+#include "CombatTimingWheel.h"
+
+namespace
+{
+    constexpr uint32 SlotMask = FCombatTimingWheel::SlotsPerLevel - 1;
+}
+
+/// <summary>
+/// Konstruktor - puste kolo ustawione na tick 0.
+/// </summary>
+FCombatTimingWheel::FCombatTimingWheel()
+    : CurrentTick(0)
+    , NumScheduled(0)
+{
+}
+
+/// <summary>
+/// Usuwa wszystkie wpisy i ustawia aktualny tick.
+/// </summary>
+/// <param name="StartTick">Tick od ktorego kolo zaczyna odliczanie</param>
+void FCombatTimingWheel::Reset(uint32 StartTick)
+{
+    for (int32 Level = 0; Level < NumLevels; Level++)
+    {
+        for (int32 SlotIndex = 0; SlotIndex < SlotsPerLevel; SlotIndex++)
+        {
+            Buckets[Level][SlotIndex].Reset();
+        }
+    }
+
+    DueNow.Reset();
+    CurrentTick = StartTick;
+    NumScheduled = 0;
+}
+
+/// <summary>
+/// Dodaje wpis do kola. Terminy dalsze niz MaxDelayTicks sa przycinane.
+/// </summary>
+/// <param name="Entry">Wpis z terminem w tickach</param>
+void FCombatTimingWheel::Schedule(const FCombatTimerEntry& Entry)
+{
+    Insert(Entry);
+    NumScheduled++;
+}
+
+/// <summary>
+/// Przesuwa kolo do podanego ticku i zwraca wszystkie wpisy, ktorych termin minal.
+/// Wpisy sa zwracane w kolejnosci terminow; w obrebie jednego ticku - w kolejnosci dodania.
+/// </summary>
+/// <param name="NowTick">Aktualny tick symulacji</param>
+/// <param name="OutDueEntries">Tablica, do ktorej dopisywane sa wymagalne wpisy</param>
+void FCombatTimingWheel::Advance(uint32 NowTick, TArray<FCombatTimerEntry>& OutDueEntries)
+{
+    // Wpisy zaplanowane na tick juz miniony
+    NumScheduled -= DueNow.Num();
+    OutDueEntries.Append(DueNow);
+    DueNow.Reset();
+
+    while (static_cast<int32>(NowTick - CurrentTick) > 0)
+    {
+        CurrentTick++;
+
+        // Na granicy bloku przenies kubelki z wyzszych poziomow (najpierw najwyzszy)
+        if ((CurrentTick & SlotMask) == 0)
+        {
+            if (((CurrentTick >> SlotBits) & SlotMask) == 0)
+            {
+                Cascade(2, (CurrentTick >> (2 * SlotBits)) & SlotMask);
+            }
+            Cascade(1, (CurrentTick >> SlotBits) & SlotMask);
+
+            NumScheduled -= DueNow.Num();
+            OutDueEntries.Append(DueNow);
+            DueNow.Reset();
+        }
+
+        TArray<FCombatTimerEntry>& Bucket = Buckets[0][CurrentTick & SlotMask];
+        if (Bucket.Num() > 0)
+        {
+            NumScheduled -= Bucket.Num();
+            OutDueEntries.Append(Bucket);
+            Bucket.Reset();
+        }
+    }
+}
+
+/// <summary>
+/// Umieszcza wpis w kubelku odpowiedniego poziomu na podstawie odleglosci do terminu.
+/// </summary>
+/// <param name="Entry">Wpis do umieszczenia</param>
+void FCombatTimingWheel::Insert(const FCombatTimerEntry& Entry)
+{
+    const int32 SignedDelay = static_cast<int32>(Entry.DeadlineTick - CurrentTick);
+    if (SignedDelay <= 0)
+    {
+        DueNow.Add(Entry);
+        return;
+    }
+
+    FCombatTimerEntry ClampedEntry = Entry;
+    const uint32 Delay = FMath::Min(static_cast<uint32>(SignedDelay), MaxDelayTicks);
+    ClampedEntry.DeadlineTick = CurrentTick + Delay;
+
+    if (Delay < (1u << SlotBits))
+    {
+        Buckets[0][ClampedEntry.DeadlineTick & SlotMask].Add(ClampedEntry);
+    }
+    else if (Delay < (1u << (2 * SlotBits)))
+    {
+        Buckets[1][(ClampedEntry.DeadlineTick >> SlotBits) & SlotMask].Add(ClampedEntry);
+    }
+    else
+    {
+        Buckets[2][(ClampedEntry.DeadlineTick >> (2 * SlotBits)) & SlotMask].Add(ClampedEntry);
+    }
+}
+
+/// <summary>
+/// Przenosi wszystkie wpisy z kubelka wyzszego poziomu na nizsze poziomy.
+/// </summary>
+/// <param name="Level">Poziom kubelka (1 lub 2)</param>
+/// <param name="SlotIndex">Indeks kubelka na danym poziomie</param>
+void FCombatTimingWheel::Cascade(int32 Level, int32 SlotIndex)
+{
+    TArray<FCombatTimerEntry> Entries = MoveTemp(Buckets[Level][SlotIndex]);
+    Buckets[Level][SlotIndex].Reset();
+
+    for (const FCombatTimerEntry& Entry : Entries)
+    {
+        Insert(Entry);
+    }
+}
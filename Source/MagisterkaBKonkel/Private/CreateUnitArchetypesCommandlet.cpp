@@ -0,0 +1,130 @@
+// CreateUnitArchetypesCommandlet.cpp - Implementacja migracji statystyk jednostek do archetypow
+#include "CreateUnitArchetypesCommandlet.h"
+#include "BaseUnit.h"
+#include "UnitArchetype.h"
+#include "Engine/Blueprint.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UCreateUnitArchetypesCommandlet::UCreateUnitArchetypesCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+#if WITH_EDITOR
+/// <summary>
+/// Przeniesienie statystyk zapisanych w Blueprincie jednostki do nowego archetypu.
+/// Koszt pochodzi z tabeli sklepu, bo Cost aktora nie byl nigdzie czytany.
+/// </summary>
+/// <param name="UnitDefaults">Domyslny obiekt klasy Blueprintu jednostki</param>
+/// <param name="OutArchetype">Wypelniany archetyp</param>
+static void CopyLegacyUnitStats(const ABaseUnit& UnitDefaults, UUnitArchetype& OutArchetype)
+{
+    const int32 TypeIndex = static_cast<int32>(UnitDefaults.UnitType);
+
+    OutArchetype.UnitType = UnitDefaults.UnitType;
+    OutArchetype.DisplayName = StaticEnum<EBaseUnitType>()->GetDisplayNameTextByValue(TypeIndex).ToString();
+    OutArchetype.Cost = UUnitArchetype::GetFallbackCost(TypeIndex);
+
+    OutArchetype.MaxHealth = UnitDefaults.MaxHealth_DEPRECATED;
+    OutArchetype.Attack = UnitDefaults.Attack_DEPRECATED;
+    OutArchetype.Defense = UnitDefaults.Defense_DEPRECATED;
+    OutArchetype.Speed = UnitDefaults.Speed_DEPRECATED;
+    OutArchetype.AttackRange = UnitDefaults.AttackRange_DEPRECATED;
+
+    OutArchetype.AttackCooldown = UnitDefaults.AttackCooldown_DEPRECATED;
+    OutArchetype.SearchRange = UnitDefaults.SearchRange_DEPRECATED;
+    OutArchetype.MovementInterval = UnitDefaults.MovementInterval_DEPRECATED;
+    OutArchetype.TargetSearchInterval = UnitDefaults.TargetSearchInterval_DEPRECATED;
+    OutArchetype.RotationSpeed = UnitDefaults.RotationSpeed_DEPRECATED;
+
+    OutArchetype.HealthBarHeight = UnitDefaults.HealthBarHeight_DEPRECATED;
+    OutArchetype.bShowHealthBar = UnitDefaults.bShowHealthBar_DEPRECATED;
+    OutArchetype.bHealthBarAlwaysVisible = UnitDefaults.bHealthBarAlwaysVisible_DEPRECATED;
+    OutArchetype.bHealthBarFaceCamera = UnitDefaults.bHealthBarFaceCamera_DEPRECATED;
+    OutArchetype.bScaleWithDistance = UnitDefaults.bScaleWithDistance_DEPRECATED;
+    OutArchetype.MinHealthBarScale = UnitDefaults.MinHealthBarScale_DEPRECATED;
+    OutArchetype.MaxHealthBarScale = UnitDefaults.MaxHealthBarScale_DEPRECATED;
+    OutArchetype.MaxHealthBarVisibilityDistance = UnitDefaults.MaxHealthBarVisibilityDistance_DEPRECATED;
+    OutArchetype.HealthBarOffset = UnitDefaults.HealthBarOffset_DEPRECATED;
+}
+
+/// <summary>
+/// Zapis pakietu zasobu na dysk
+/// </summary>
+/// <param name="Asset">Glowny obiekt pakietu</param>
+/// <returns>true - w przypadku powodzenia, false - wpp</returns>
+static bool SaveAssetPackage(UObject* Asset)
+{
+    UPackage* Package = Asset->GetOutermost();
+    const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    return UPackage::SavePackage(Package, Asset, *Filename, SaveArgs);
+}
+#endif
+
+/// <summary>
+/// Tworzy archetypy DA_* dla Blueprintow jednostek bez przypisanego archetypu
+/// </summary>
+/// <param name="Params">Parametry komendy (nieuzywane)</param>
+/// <returns>0 - wszystkie Blueprinty maja archetyp, 1 - blad</returns>
+int32 UCreateUnitArchetypesCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    static const TCHAR* UnitBlueprintPaths[] =
+    {
+        TEXT("/Game/Units/BP_Tank.BP_Tank"),
+        TEXT("/Game/Units/BP_Ninja.BP_Ninja"),
+        TEXT("/Game/Units/BP_Sword.BP_Sword"),
+        TEXT("/Game/Units/BP_Armor.BP_Armor")
+    };
+
+    int32 Failures = 0;
+    for (const TCHAR* BlueprintPath : UnitBlueprintPaths)
+    {
+        UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, BlueprintPath);
+        ABaseUnit* UnitDefaults = (Blueprint && Blueprint->GeneratedClass) ? Cast<ABaseUnit>(Blueprint->GeneratedClass->GetDefaultObject()) : nullptr;
+        if (!UnitDefaults)
+        {
+            UE_LOG(LogTemp, Error, TEXT("=== ARCHETYPY: Nie znaleziono Blueprintu jednostki %s ==="), BlueprintPath);
+            Failures++;
+            continue;
+        }
+
+        if (UnitDefaults->Archetype)
+        {
+            UE_LOG(LogTemp, Display, TEXT("=== ARCHETYPY: %s ma juz archetyp %s ==="), *Blueprint->GetName(), *UnitDefaults->Archetype->GetName());
+            continue;
+        }
+
+        const FString AssetName = Blueprint->GetName().Replace(TEXT("BP_"), TEXT("DA_"));
+        UPackage* Package = CreatePackage(*FString::Printf(TEXT("/Game/Units/Archetypes/%s"), *AssetName));
+        UUnitArchetype* NewArchetype = NewObject<UUnitArchetype>(Package, *AssetName, RF_Public | RF_Standalone);
+        CopyLegacyUnitStats(*UnitDefaults, *NewArchetype);
+
+        // Archetyp trafia do domyslnego obiektu klasy, zapisywanego w pakiecie Blueprintu
+        UnitDefaults->Archetype = NewArchetype;
+        Blueprint->MarkPackageDirty();
+
+        if (!SaveAssetPackage(NewArchetype) || !SaveAssetPackage(Blueprint))
+        {
+            UE_LOG(LogTemp, Error, TEXT("=== ARCHETYPY: Nie udalo sie zapisac %s lub %s ==="), *AssetName, *Blueprint->GetName());
+            Failures++;
+            continue;
+        }
+
+        UE_LOG(LogTemp, Display, TEXT("=== ARCHETYPY: Utworzono %s dla %s (zdrowie: %d, atak: %d, obrona: %d, predkosc: %.1f) ==="),
+            *AssetName, *Blueprint->GetName(), NewArchetype->MaxHealth, NewArchetype->Attack, NewArchetype->Defense, NewArchetype->Speed);
+    }
+
+    return Failures > 0 ? 1 : 0;
+#else
+    return 1;
+#endif
+}
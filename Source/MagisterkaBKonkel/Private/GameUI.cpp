@@ -12,6 +12,9 @@
 #include "TimerManager.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
+#include "UnitManager.h"
+#include "StrategyPlayerController.h"
+#include "UnitArchetype.h"
 
 /// <summary>
 /// Konstruktor - inicjalizuje domylne wartoci dla UI
@@ -44,36 +47,17 @@ void UGameUI::NativeConstruct()
     if (Unit4Button)
         Unit4Button->OnClicked.AddDynamic(this, &UGameUI::OnUnit4ButtonClicked);
 
-    // Utworzenie domylnej listy jednostek dostpnych w sklepie
-    TArray<FUnitShopData> DefaultUnits;
+    // Lista jednostek w sklepie z archetypow typow - ten sam koszt co w AStrategyGameMode::GetUnitCost
+    // UI tworzy kontroler po InitializeReferences, wic jego referencja do UnitManager jest ju ustawiona
+    const AStrategyPlayerController* OwningController = Cast<AStrategyPlayerController>(GetOwningPlayer());
+    AUnitManager* UnitManager = OwningController ? OwningController->GetUnitManager() : nullptr;
 
-    // Definicja jednostki typu Tank
-    FUnitShopData Infantry;
-    Infantry.UnitName = TEXT("Tank");
-    Infantry.UnitCost = 50;
-    Infantry.UnitType = 0;
-    DefaultUnits.Add(Infantry);
-
-    // Definicja jednostki typu Ninja
-    FUnitShopData Archer;
-    Archer.UnitName = TEXT("Ninja");
-    Archer.UnitCost = 75;
-    Archer.UnitType = 1;
-    DefaultUnits.Add(Archer);
-
-    // Definicja jednostki typu Sword
-    FUnitShopData Cavalry;
-    Cavalry.UnitName = TEXT("Sword");
-    Cavalry.UnitCost = 100;
-    Cavalry.UnitType = 2;
-    DefaultUnits.Add(Cavalry);
-
-    // Definicja jednostki typu Armor
-    FUnitShopData Mage;
-    Mage.UnitName = TEXT("Armor");
-    Mage.UnitCost = 125;
-    Mage.UnitType = 3;
-    DefaultUnits.Add(Mage);
+    TArray<FUnitShopData> DefaultUnits;
+    for (int32 UnitType = 0; UnitType < 4; UnitType++)
+    {
+        const UUnitArchetype* Archetype = UnitManager ? UnitManager->GetUnitArchetype(static_cast<EBaseUnitType>(UnitType)) : nullptr;
+        DefaultUnits.Add(FUnitShopData::FromArchetype(UnitType, Archetype));
+    }
 
     // Konfiguracja sklepu z jednostkami
     SetupUnitShop(DefaultUnits);
@@ -485,6 +469,34 @@ void UGameUI::AddChatMessage(const FString& Message, const FString& PlayerName)
     }
 }
 
+/// <summary>
+/// Tworzy dane sklepu dla typu jednostki na podstawie jej archetypu.
+/// </summary>
+/// <param name="InUnitType">Typ jednostki (indeks w sklepie)</param>
+/// <param name="Archetype">Archetyp typu lub nullptr</param>
+/// <returns>Dane jednostki w sklepie</returns>
+FUnitShopData FUnitShopData::FromArchetype(int32 InUnitType, const UUnitArchetype* Archetype)
+{
+    static const TCHAR* DefaultUnitNames[] = { TEXT("Tank"), TEXT("Ninja"), TEXT("Sword"), TEXT("Armor") };
+
+    FUnitShopData ShopData;
+    ShopData.UnitType = InUnitType;
+
+    if (Archetype)
+    {
+        ShopData.UnitName = Archetype->DisplayName;
+        ShopData.UnitIcon = Archetype->Icon;
+        ShopData.UnitCost = Archetype->Cost;
+    }
+    else
+    {
+        ShopData.UnitName = (InUnitType >= 0 && InUnitType < UE_ARRAY_COUNT(DefaultUnitNames)) ? DefaultUnitNames[InUnitType] : TEXT("Unit");
+        ShopData.UnitCost = UUnitArchetype::GetFallbackCost(InUnitType);
+    }
+
+    return ShopData;
+}
+
 /// <summary>
 /// Konfiguracja sklepu z jednostkami
 /// </summary>
@@ -0,0 +1,41 @@
+// GridCell.cpp - Serializacja sieciowa komorki planszy
+#include "GridCell.h"
+
+namespace
+{
+    // Zig-zag: male liczby ujemne i dodatnie daja male liczby bez znaku (0, -1, 1, -2 -> 0, 1, 2, 3)
+    uint32 EncodeZigZag(int32 Value)
+    {
+        return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+    }
+
+    int32 DecodeZigZag(uint32 Value)
+    {
+        return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+    }
+}
+
+/// <summary>
+/// Serializacja sieciowa - kazda wspolrzedna jako liczba o zmiennej dlugosci
+/// </summary>
+/// <param name="Ar">Archiwum sieciowe</param>
+/// <param name="Map">Mapa pakietow (nieuzywana)</param>
+/// <param name="bOutSuccess">Czy serializacja sie powiodla</param>
+/// <returns>true - struktura obsluzona</returns>
+bool FGridCell::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    uint32 PackedX = EncodeZigZag(X);
+    uint32 PackedY = EncodeZigZag(Y);
+
+    Ar.SerializeIntPacked(PackedX);
+    Ar.SerializeIntPacked(PackedY);
+
+    if (Ar.IsLoading())
+    {
+        X = DecodeZigZag(PackedX);
+        Y = DecodeZigZag(PackedY);
+    }
+
+    bOutSuccess = !Ar.IsError();
+    return true;
+}
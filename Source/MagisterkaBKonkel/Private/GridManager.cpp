@@ -6,6 +6,10 @@
 #include "Materials/MaterialInterface.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/EngineTypes.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Camera/PlayerCameraManager.h"
 
 /// <summary>
 /// Konstruktor- Inicjalizacja komponentw siatki
@@ -41,7 +45,7 @@ void AGridManager::BeginPlay()
     // Konfiguracja collision box przed innymi inicjalizacjami
     SetupCollisionBox();
 
-    // Inicjalizacja stref spawnu dla obu graczy
+    // Inicjalizacja stref spawnu dla obu graczy (razem z warstw nawigacji, ktra trzyma ich flagi)
     InitializeSpawnZones();
 
     // Utworzenie granic mapy jeli wczone w ustawieniach
@@ -55,38 +59,104 @@ void AGridManager::BeginPlay()
     {
         GenerateGridVisuals();
     }
+
+    // Fragmenty siatki wok kamery - tworzenie, usuwanie niewidocznych i zwalnianie pustych danych
+    GetWorldTimerManager().SetTimer(ChunkUpdateTimerHandle, this, &AGridManager::UpdateChunks, ChunkUpdateInterval, true);
 }
 
 /// <summary>
 /// Konfiguruje collision box dla podogi siatki
-/// Box jest automatycznie dopasowywany do wymiarw siatki
+/// Box obejmuje tylko fragmenty siatki wok kamery lokalnego gracza i jest przesuwany razem
+/// z ni w UpdateChunks. Bez kamery (serwer dedykowany, edytor) kolizja podogi jest wyczona
 /// </summary>
 void AGridManager::SetupCollisionBox()
 {
     if (!GridCollisionBox)
         return;
 
-    // Obliczenie rozmiaru box'a na podstawie wymiarw siatki
+    // Wymiary siatki mogy si zmieni - box jest ustawiany od nowa
+    CollisionBoxChunks = FIntRect(INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE);
+
+    FGridCell MinChunk;
+    FGridCell MaxChunk;
+    if (GetCameraChunkRange(MinChunk, MaxChunk))
+    {
+        UpdateCollisionBox(MinChunk, MaxChunk);
+    }
+    else
+    {
+        GridCollisionBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+}
+
+/// <summary>
+/// Dopasowuje collision box do zakresu fragmentw siatki (komrka X zajmuje [X - 0.5, X + 0.5] * CellSize)
+/// </summary>
+/// <param name="MinChunk">pierwszy fragment zakresu</param>
+/// <param name="MaxChunk">ostatni fragment zakresu (wcznie)</param>
+void AGridManager::UpdateCollisionBox(const FGridCell& MinChunk, const FGridCell& MaxChunk)
+{
+    const FIntRect Chunks(MinChunk.ToIntPoint(), MaxChunk.ToIntPoint());
+    if (!GridCollisionBox || Chunks == CollisionBoxChunks)
+        return;
+
+    CollisionBoxChunks = Chunks;
+
+    const FGridCell StartCell = MinChunk * FGridNavigationLayer::ChunkSize;
+    const FGridCell EndCell = ((MaxChunk + FGridCell(1, 1)) * FGridNavigationLayer::ChunkSize).ComponentMin(FGridCell(GridWidth, GridHeight));
+
+    // Obliczenie rozmiaru box'a na podstawie zakresu fragmentw
     FVector BoxExtent(
-        (GridWidth * CellSize) * 0.5f,   // Szeroko siatki / 2
-        (GridHeight * CellSize) * 0.5f,  // Wysoko siatki / 2
-        FloorThickness * 0.5f            // Grubo podogi / 2
+        (EndCell.X - StartCell.X) * CellSize * 0.5f,    // Szeroko zakresu / 2
+        (EndCell.Y - StartCell.Y) * CellSize * 0.5f,    // Wysoko zakresu / 2
+        FloorThickness * 0.5f                           // Grubo podogi / 2
     );
     GridCollisionBox->SetBoxExtent(BoxExtent);
 
-    // Przesunicie box'a eby by wyrodkowany pod siatk
+    // Przesunicie box'a eby by wyrodkowany pod zakresem
     FVector BoxCenter(
-        (GridWidth * CellSize) * 0.5f,            // rodek siatki X
-        (GridHeight * CellSize) * 0.5f,           // rodek siatki Y
-        -FloorDepth - (FloorThickness * 0.5f)     // Pod siatk
+        (StartCell.X - 0.5f) * CellSize + BoxExtent.X,  // rodek zakresu X
+        (StartCell.Y - 0.5f) * CellSize + BoxExtent.Y,  // rodek zakresu Y
+        -FloorDepth - (FloorThickness * 0.5f)           // Pod siatk
     );
     GridCollisionBox->SetRelativeLocation(BoxCenter);
+    GridCollisionBox->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 
-    UE_LOG(LogTemp, Warning, TEXT("Collision box skonfigurowany: Rozmiar(%f, %f, %f), rodek(%f, %f, %f)"),
+    UE_LOG(LogTemp, Log, TEXT("Collision box pod fragmentami (%d, %d) - (%d, %d): Rozmiar(%f, %f, %f), rodek(%f, %f, %f)"),
+        MinChunk.X, MinChunk.Y, MaxChunk.X, MaxChunk.Y,
         BoxExtent.X, BoxExtent.Y, BoxExtent.Z,
         BoxCenter.X, BoxCenter.Y, BoxCenter.Z);
 }
 
+/// <summary>
+/// Zakres fragmentw siatki w promieniu ChunkVisibleRadius od kamery lokalnego gracza
+/// </summary>
+/// <param name="OutMinChunk">pierwszy fragment zakresu</param>
+/// <param name="OutMaxChunk">ostatni fragment zakresu (wcznie)</param>
+/// <returns>true jeli jest kamera i niepusta siatka, false - wpp</returns>
+bool AGridManager::GetCameraChunkRange(FGridCell& OutMinChunk, FGridCell& OutMaxChunk) const
+{
+    // Serwer dedykowany nie ma kamery - fragmenty tylko jako dane nawigacji
+    APlayerCameraManager* CameraManager = GetWorld() ? UGameplayStatics::GetPlayerCameraManager(this, 0) : nullptr;
+    if (!CameraManager || GridWidth <= 0 || GridHeight <= 0)
+        return false;
+
+    // Zakres fragmentw w promieniu od punktu kamery (komrka X zajmuje [X - 0.5, X + 0.5] * CellSize)
+    const FVector RelativeLocation = CameraManager->GetCameraLocation() - GridOrigin;
+    const float ChunkWorldSize = FGridNavigationLayer::ChunkSize * CellSize;
+    const FGridCell ChunkGridSize(
+        FMath::DivideAndRoundUp(GridWidth, FGridNavigationLayer::ChunkSize),
+        FMath::DivideAndRoundUp(GridHeight, FGridNavigationLayer::ChunkSize));
+
+    OutMinChunk = FGridCell(
+        FMath::Clamp(FMath::FloorToInt((RelativeLocation.X - ChunkVisibleRadius + CellSize * 0.5f) / ChunkWorldSize), 0, ChunkGridSize.X - 1),
+        FMath::Clamp(FMath::FloorToInt((RelativeLocation.Y - ChunkVisibleRadius + CellSize * 0.5f) / ChunkWorldSize), 0, ChunkGridSize.Y - 1));
+    OutMaxChunk = FGridCell(
+        FMath::Clamp(FMath::FloorToInt((RelativeLocation.X + ChunkVisibleRadius + CellSize * 0.5f) / ChunkWorldSize), 0, ChunkGridSize.X - 1),
+        FMath::Clamp(FMath::FloorToInt((RelativeLocation.Y + ChunkVisibleRadius + CellSize * 0.5f) / ChunkWorldSize), 0, ChunkGridSize.Y - 1));
+    return true;
+}
+
 /// <summary>
 /// Aktualizacja co klatk
 /// </summary>
@@ -101,42 +171,62 @@ void AGridManager::Tick(float DeltaTime)
 /// </summary>
 void AGridManager::InitializeSpawnZones()
 {
+    // Flagi stref s w warstwie nawigacji - musi mie aktualne wymiary
+    InitializeNavigationLayer();
+
     // Wyczy istniejce strefy
     Player1SpawnZone.Empty();
     Player2SpawnZone.Empty();
+    NavigationLayer.ClearFlags(ENavCellFlags::SpawnZonePlayer1 | ENavCellFlags::SpawnZonePlayer2);
 
     // Zabezpieczenie przed bdnymi wartociami
     int32 SafePlayer1Size = FMath::Clamp(Player1SpawnSize, 1, GridHeight);
     int32 SafePlayer2Size = FMath::Clamp(Player2SpawnSize, 1, GridHeight);
 
-    // Gracz 1 - dolne rzdy
-    for (int32 x = 0; x < GridWidth; x++)
+    // Gracz 1 - dolne rzdy, Gracz 2 - grne rzdy (zaczynaj si najwczeniej za stref Gracza 1, wic si nie nakadaj)
+    Player1SpawnRows = FIntPoint(0, SafePlayer1Size);
+    Player2SpawnRows = FIntPoint(FMath::Max(SafePlayer1Size, GridHeight - SafePlayer2Size), GridHeight);
+
+    for (int32 y = Player1SpawnRows.X; y < Player1SpawnRows.Y; y++)
     {
-        for (int32 y = 0; y < SafePlayer1Size; y++)
+        for (int32 x = 0; x < GridWidth; x++)
         {
-            Player1SpawnZone.Add(FVector2D(x, y));
+            const FGridCell Cell(x, y);
+            NavigationLayer.SetCellFlags(Cell, NavigationLayer.GetCellFlags(Cell) | ENavCellFlags::SpawnZonePlayer1);
         }
     }
 
-    // Gracz 2 - grne rzdy 
-    int32 Player2StartY = FMath::Max(SafePlayer1Size, GridHeight - SafePlayer2Size);
-    for (int32 x = 0; x < GridWidth; x++)
+    for (int32 y = Player2SpawnRows.X; y < Player2SpawnRows.Y; y++)
     {
-        for (int32 y = Player2StartY; y < GridHeight; y++)
+        for (int32 x = 0; x < GridWidth; x++)
         {
-            FVector2D Position(x, y);
+            const FGridCell Cell(x, y);
+            NavigationLayer.SetCellFlags(Cell, NavigationLayer.GetCellFlags(Cell) | ENavCellFlags::SpawnZonePlayer2);
+        }
+    }
 
-            // Sprawd czy nie nakada si ze stref Gracza 1
-            if (!Player1SpawnZone.Contains(Position))
+    // Listy komrek dla Blueprintw (kolejno: kolumnami, od dou)
+    if (bKeepSpawnZoneLists)
+    {
+        Player1SpawnZone.Reserve(GridWidth * (Player1SpawnRows.Y - Player1SpawnRows.X));
+        Player2SpawnZone.Reserve(GridWidth * (Player2SpawnRows.Y - Player2SpawnRows.X));
+        for (int32 x = 0; x < GridWidth; x++)
+        {
+            for (int32 y = Player1SpawnRows.X; y < Player1SpawnRows.Y; y++)
+            {
+                Player1SpawnZone.Add(FVector2D(x, y));
+            }
+            for (int32 y = Player2SpawnRows.X; y < Player2SpawnRows.Y; y++)
             {
-                Player2SpawnZone.Add(Position);
+                Player2SpawnZone.Add(FVector2D(x, y));
             }
         }
     }
 
     // Log diagnostyczny
-    UE_LOG(LogTemp, Warning, TEXT("Strefy spawnu zainicjalizowane - Gracz1: %d komrek, Gracz2: %d komrek"),
-        Player1SpawnZone.Num(), Player2SpawnZone.Num());
+    UE_LOG(LogTemp, Warning, TEXT("Strefy spawnu zainicjalizowane - Gracz1: %d komrek, Gracz2: %d komrek, fragmenty nawigacji: %d"),
+        GridWidth * (Player1SpawnRows.Y - Player1SpawnRows.X), GridWidth * (Player2SpawnRows.Y - Player2SpawnRows.X),
+        NavigationLayer.GetChunkCount());
 }
 
 /// <summary>
@@ -166,6 +256,44 @@ void AGridManager::RegenerateSpawnZones()
     UE_LOG(LogTemp, Warning, TEXT("Strefy spawnu zregenerowane rcznie"));
 }
 
+/// <summary>
+/// Zmienia wymiary planszy i przesuwa j do nowego punktu pocztkowego. Collision box, granice mapy
+/// i fragmenty siatki s umieszczane wzgldem aktora, wic aktor przesuwa si razem z plansz
+/// </summary>
+/// <param name="NewWidth">szeroko planszy w komrkach</param>
+/// <param name="NewHeight">wysoko planszy w komrkach</param>
+/// <param name="NewOrigin">pozycja wiata komrki (0, 0)</param>
+void AGridManager::ResizeGrid(int32 NewWidth, int32 NewHeight, const FVector& NewOrigin)
+{
+    GridWidth = FMath::Max(1, NewWidth);
+    GridHeight = FMath::Max(1, NewHeight);
+    SetActorLocation(NewOrigin);
+    GridOrigin = NewOrigin;
+
+    // Warstwa nawigacji i strefy spawnu dla nowych wymiarw, a za nimi kolizja, granice i wizualizacje
+    RegenerateSpawnZones();
+
+    UE_LOG(LogTemp, Warning, TEXT("=== PLANSZA: Nowe wymiary %dx%d komrek, pocztek (%.0f, %.0f) ==="),
+        GridWidth, GridHeight, GridOrigin.X, GridOrigin.Y);
+}
+
+/// <summary>
+/// Przywraca przeszkody, koszty i flagi komrek z kopii warstwy nawigacji zapamitanej
+/// przed ResizeGrid. Kopia musi mie biece wymiary planszy
+/// </summary>
+/// <param name="SavedLayer">zapamitana warstwa nawigacji</param>
+void AGridManager::RestoreNavigationLayer(const FGridNavigationLayer& SavedLayer)
+{
+    if (SavedLayer.GetWidth() != GridWidth || SavedLayer.GetHeight() != GridHeight)
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== PLANSZA: Kopia warstwy nawigacji %dx%d nie pasuje do planszy %dx%d ==="),
+            SavedLayer.GetWidth(), SavedLayer.GetHeight(), GridWidth, GridHeight);
+        return;
+    }
+
+    NavigationLayer.RestoreFrom(SavedLayer);
+}
+
 #if WITH_EDITOR
 
 /// <summary>
@@ -243,6 +371,27 @@ FVector2D AGridManager::GetGridPositionFromWorld(FVector WorldLocation) const
     );
 }
 
+/// <summary>
+/// Konwertuje komrk siatki na pozycj jej rodka w wiecie 3D
+/// </summary>
+/// <param name="Cell">komrka siatki</param>
+/// <returns>pozycja w przestrzeni wiata 3D</returns>
+FVector AGridManager::GetWorldLocationFromCell(const FGridCell& Cell) const
+{
+    return GridOrigin + FVector(Cell.X * CellSize, Cell.Y * CellSize, 0.0f);
+}
+
+/// <summary>
+/// Konwertuje pozycj wiata 3D na komrk siatki (najbliszy rodek komrki)
+/// </summary>
+/// <param name="WorldLocation">pozycja w przestrzeni wiata</param>
+/// <returns>komrka siatki (moe lee poza plansz)</returns>
+FGridCell AGridManager::GetCellFromWorld(const FVector& WorldLocation) const
+{
+    const FVector RelativeLocation = WorldLocation - GridOrigin;
+    return FGridCell(FMath::RoundToInt(RelativeLocation.X / CellSize), FMath::RoundToInt(RelativeLocation.Y / CellSize));
+}
+
 /// <summary>
 /// Sprawdza czy pozycja siatki jest prawidowa (w granicach)
 /// </summary>
@@ -262,7 +411,7 @@ bool AGridManager::IsValidGridPosition(FVector2D GridPosition) const
 /// <returns>true jeli pozycja jest w strefie Gracza 1, false - wpp</returns>
 bool AGridManager::IsPositionInPlayer1SpawnZone(FVector2D GridPosition) const
 {
-    return Player1SpawnZone.Contains(GridPosition);
+    return IsCellInSpawnZone(FGridCell::FromGridPosition(GridPosition), 0);
 }
 
 /// <summary>
@@ -272,21 +421,94 @@ bool AGridManager::IsPositionInPlayer1SpawnZone(FVector2D GridPosition) const
 /// <returns>true jeli pozycja jest w strefie Gracza 2, false - wpp</returns>
 bool AGridManager::IsPositionInPlayer2SpawnZone(FVector2D GridPosition) const
 {
-    return Player2SpawnZone.Contains(GridPosition);
+    return IsCellInSpawnZone(FGridCell::FromGridPosition(GridPosition), 1);
 }
 
 /// <summary>
-/// Pobiera wszystkie dostpne pozycje spawnu dla gracza
+/// Pobiera wszystkie dostpne pozycje spawnu dla gracza (wersja dla Blueprintw)
 /// </summary>
 /// <param name="PlayerID">ID gracza</param>
 /// <returns>tablica pozycji siatki dostpnych do spawnu</returns>
 TArray<FVector2D> AGridManager::GetValidSpawnPositions(int32 PlayerID) const
+{
+    const TArray<FGridCell> SpawnCells = GetValidSpawnCells(PlayerID);
+
+    TArray<FVector2D> SpawnPositions;
+    SpawnPositions.Reserve(SpawnCells.Num());
+    for (const FGridCell& Cell : SpawnCells)
+    {
+        SpawnPositions.Add(Cell.ToGridPosition());
+    }
+    return SpawnPositions;
+}
+
+/// <summary>
+/// Flaga strefy spawnu gracza w warstwie nawigacji
+/// </summary>
+/// <param name="PlayerID">ID gracza</param>
+/// <returns>flaga strefy lub None dla nieznanego gracza</returns>
+ENavCellFlags AGridManager::GetSpawnZoneFlag(int32 PlayerID)
 {
     if (PlayerID == 0)
-        return Player1SpawnZone;
-    else if (PlayerID == 1)
-        return Player2SpawnZone;
-    return TArray<FVector2D>();
+        return ENavCellFlags::SpawnZonePlayer1;
+    if (PlayerID == 1)
+        return ENavCellFlags::SpawnZonePlayer2;
+    return ENavCellFlags::None;
+}
+
+/// <summary>
+/// Sprawdza czy komrka naley do strefy spawnu gracza
+/// </summary>
+/// <param name="Cell">komrka do sprawdzenia</param>
+/// <param name="PlayerID">ID gracza</param>
+/// <returns>true jeli komrka jest w strefie gracza, false - wpp</returns>
+bool AGridManager::IsCellInSpawnZone(const FGridCell& Cell, int32 PlayerID) const
+{
+    return IsValidCell(Cell) && EnumHasAnyFlags(NavigationLayer.GetCellFlags(Cell.ToIntPoint()), GetSpawnZoneFlag(PlayerID));
+}
+
+/// <summary>
+/// Sprawdza czy w komrce strefy spawnu gracza mona rozstawi jednostk
+/// </summary>
+/// <param name="Cell">komrka do sprawdzenia</param>
+/// <param name="PlayerID">ID gracza</param>
+/// <returns>true jeli komrka jest w strefie i nie jest wyczona z rozstawiania, false - wpp</returns>
+bool AGridManager::IsSpawnCellAvailable(const FGridCell& Cell, int32 PlayerID) const
+{
+    if (!IsValidCell(Cell))
+        return false;
+
+    const ENavCellFlags Flags = NavigationLayer.GetCellFlags(Cell.ToIntPoint());
+    return EnumHasAnyFlags(Flags, GetSpawnZoneFlag(PlayerID)) && !EnumHasAnyFlags(Flags, ENavCellFlags::Blocked | ENavCellFlags::NoPlacement);
+}
+
+/// <summary>
+/// Pobiera komrki strefy spawnu gracza (kolumnami, od dou). Komrki zablokowane
+/// lub wyczone z rozstawiania nie s pozycjami spawnu
+/// </summary>
+/// <param name="PlayerID">ID gracza</param>
+/// <returns>tablica komrek dostpnych do spawnu</returns>
+TArray<FGridCell> AGridManager::GetValidSpawnCells(int32 PlayerID) const
+{
+    TArray<FGridCell> SpawnCells;
+    if (PlayerID != 0 && PlayerID != 1)
+        return SpawnCells;
+
+    const FIntPoint SpawnRows = PlayerID == 0 ? Player1SpawnRows : Player2SpawnRows;
+    SpawnCells.Reserve(GridWidth * FMath::Max(0, SpawnRows.Y - SpawnRows.X));
+
+    for (int32 x = 0; x < GridWidth; x++)
+    {
+        for (int32 y = SpawnRows.X; y < SpawnRows.Y; y++)
+        {
+            const FGridCell Cell(x, y);
+            if (IsSpawnCellAvailable(Cell, PlayerID))
+            {
+                SpawnCells.Add(Cell);
+            }
+        }
+    }
+    return SpawnCells;
 }
 
 
@@ -301,9 +523,10 @@ void AGridManager::GenerateGridVisuals()
         ClearGridVisuals();
     }
 
-    // Utwrz linie siatki
+    // Utwrz linie siatki i fragmenty widoczne z kamery
     CreateGridLines();
     bGridGenerated = true;
+    UpdateChunks();
 }
 
 /// <summary>
@@ -320,6 +543,7 @@ void AGridManager::ClearGridVisuals()
         }
     }
     GridLineComponents.Empty();
+    ClearChunkVisuals();
     bGridGenerated = false;
 }
 
@@ -328,6 +552,8 @@ void AGridManager::ClearGridVisuals()
 /// </summary>
 void AGridManager::ShowGrid()
 {
+    bGridVisible = true;
+
     for (UStaticMeshComponent* Component : GridLineComponents)
     {
         if (Component)
@@ -335,6 +561,14 @@ void AGridManager::ShowGrid()
             Component->SetVisibility(true);
         }
     }
+
+    for (const TPair<FGridCell, UStaticMeshComponent*>& ChunkVisual : ChunkVisuals)
+    {
+        if (ChunkVisual.Value)
+        {
+            ChunkVisual.Value->SetVisibility(true);
+        }
+    }
 }
 
 /// <summary>
@@ -342,6 +576,8 @@ void AGridManager::ShowGrid()
 /// </summary>
 void AGridManager::HideGrid()
 {
+    bGridVisible = false;
+
     for (UStaticMeshComponent* Component : GridLineComponents)
     {
         if (Component)
@@ -349,6 +585,14 @@ void AGridManager::HideGrid()
             Component->SetVisibility(false);
         }
     }
+
+    for (const TPair<FGridCell, UStaticMeshComponent*>& ChunkVisual : ChunkVisuals)
+    {
+        if (ChunkVisual.Value)
+        {
+            ChunkVisual.Value->SetVisibility(false);
+        }
+    }
 }
 
 /// <summary>
@@ -363,6 +607,120 @@ void AGridManager::AddGridLineComponent(UStaticMeshComponent* Component)
     }
 }
 
+/// <summary>
+/// Aktualizuje fragmenty siatki wok kamery lokalnego gracza: przesuwa pod nie kolizj podogi,
+/// tworzy wizualizacje fragmentw w promieniu ChunkVisibleRadius, usuwa te poza promieniem,
+/// ktrych kamera ju nie widzi, i zwalnia fragmenty warstwy nawigacji z samymi wartociami domylnymi
+/// </summary>
+void AGridManager::UpdateChunks()
+{
+    NavigationLayer.ReleaseUnusedChunks();
+
+    FGridCell MinChunk;
+    FGridCell MaxChunk;
+    if (!GetCameraChunkRange(MinChunk, MaxChunk))
+        return;
+
+    UpdateCollisionBox(MinChunk, MaxChunk);
+
+    if (!bGridGenerated || !ChunkVisualMesh || !NavigationLayer.IsInitialized())
+        return;
+
+    for (int32 ChunkY = MinChunk.Y; ChunkY <= MaxChunk.Y; ChunkY++)
+    {
+        for (int32 ChunkX = MinChunk.X; ChunkX <= MaxChunk.X; ChunkX++)
+        {
+            const FGridCell ChunkCoord(ChunkX, ChunkY);
+            if (!ChunkVisuals.Contains(ChunkCoord))
+            {
+                if (UStaticMeshComponent* ChunkVisual = CreateChunkVisual(ChunkCoord))
+                {
+                    ChunkVisuals.Add(ChunkCoord, ChunkVisual);
+                }
+            }
+        }
+    }
+
+    // Fragmenty poza promieniem znikaj dopiero, gdy nie byy ostatnio renderowane
+    for (auto ChunkIterator = ChunkVisuals.CreateIterator(); ChunkIterator; ++ChunkIterator)
+    {
+        const FGridCell& ChunkCoord = ChunkIterator->Key;
+        const bool bInRange = ChunkCoord.X >= MinChunk.X && ChunkCoord.X <= MaxChunk.X &&
+            ChunkCoord.Y >= MinChunk.Y && ChunkCoord.Y <= MaxChunk.Y;
+        UStaticMeshComponent* ChunkVisual = ChunkIterator->Value;
+
+        if (!IsValid(ChunkVisual))
+        {
+            ChunkIterator.RemoveCurrent();
+        }
+        else if (!bInRange && !ChunkVisual->WasRecentlyRendered(ChunkUpdateInterval))
+        {
+            ChunkVisual->DestroyComponent();
+            ChunkIterator.RemoveCurrent();
+        }
+    }
+}
+
+/// <summary>
+/// Tworzy wizualizacj jednego fragmentu siatki - ChunkVisualMesh przeskalowany do fragmentu
+/// (ostatnie fragmenty przy krawdzi planszy s mniejsze)
+/// </summary>
+/// <param name="ChunkCoord">wsprzdne fragmentu</param>
+/// <returns>utworzony komponent lub nullptr</returns>
+UStaticMeshComponent* AGridManager::CreateChunkVisual(const FGridCell& ChunkCoord)
+{
+    const FGridCell ChunkStart = ChunkCoord * FGridNavigationLayer::ChunkSize;
+    const FGridCell ChunkCells(
+        FMath::Min(FGridNavigationLayer::ChunkSize, GridWidth - ChunkStart.X),
+        FMath::Min(FGridNavigationLayer::ChunkSize, GridHeight - ChunkStart.Y));
+    if (ChunkCells.X <= 0 || ChunkCells.Y <= 0)
+        return nullptr;
+
+    UStaticMeshComponent* ChunkVisual = NewObject<UStaticMeshComponent>(this, UStaticMeshComponent::StaticClass(),
+        *FString::Printf(TEXT("GridChunk_%d_%d"), ChunkCoord.X, ChunkCoord.Y));
+    if (!ChunkVisual)
+        return nullptr;
+
+    ChunkVisual->SetStaticMesh(ChunkVisualMesh);
+    if (GridLineMaterial)
+    {
+        ChunkVisual->SetMaterial(0, GridLineMaterial);
+    }
+    ChunkVisual->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ChunkVisual->SetCastShadow(false);
+    ChunkVisual->SetVisibility(bGridVisible);
+
+    ChunkVisual->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
+    ChunkVisual->RegisterComponent();
+
+    // rodek fragmentu - komrki s wyrodkowane na pozycjach siatki
+    ChunkVisual->SetRelativeLocation(FVector(
+        (ChunkStart.X - 0.5f + ChunkCells.X * 0.5f) * CellSize,
+        (ChunkStart.Y - 0.5f + ChunkCells.Y * 0.5f) * CellSize,
+        1.0f));
+    ChunkVisual->SetRelativeScale3D(FVector(
+        ChunkCells.X * CellSize / ChunkVisualMeshSize,
+        ChunkCells.Y * CellSize / ChunkVisualMeshSize,
+        1.0f));
+
+    return ChunkVisual;
+}
+
+/// <summary>
+/// Usuwa wizualizacje wszystkich fragmentw siatki
+/// </summary>
+void AGridManager::ClearChunkVisuals()
+{
+    for (const TPair<FGridCell, UStaticMeshComponent*>& ChunkVisual : ChunkVisuals)
+    {
+        if (ChunkVisual.Value)
+        {
+            ChunkVisual.Value->DestroyComponent();
+        }
+    }
+    ChunkVisuals.Empty();
+}
+
 /// <summary>
 /// Tworzy linie siatki w Blueprint
 /// </summary>
@@ -506,4 +864,137 @@ void AGridManager::RegenerateMapBoundaries()
         CreateMapBoundaries();
     }
     UE_LOG(LogTemp, Warning, TEXT("Granice mapy zregenerowane rcznie"));
+}
+/// <summary>
+/// Konwertuje pozycj siatki na komrk warstwy nawigacji
+/// </summary>
+/// <param name="GridPosition">pozycja na siatce (x, y)</param>
+/// <returns>zaokrglone wsprzdne komrki</returns>
+FGridCell AGridManager::ToCell(FVector2D GridPosition)
+{
+    return FGridCell::FromGridPosition(GridPosition);
+}
+
+/// <summary>
+/// Tworzy warstw nawigacji dla wymiarw siatki. Przy niezmienionych wymiarach
+/// zachowuje ustawione przeszkody i koszty
+/// </summary>
+void AGridManager::InitializeNavigationLayer()
+{
+    if (NavigationLayer.GetWidth() == GridWidth && NavigationLayer.GetHeight() == GridHeight)
+        return;
+
+    NavigationLayer.Initialize(GridWidth, GridHeight);
+
+    // Wizualizacje fragmentw odpowiaday poprzednim wymiarom
+    ClearChunkVisuals();
+
+    UE_LOG(LogTemp, Warning, TEXT("Warstwa nawigacji zainicjalizowana: %dx%d komrek"), GridWidth, GridHeight);
+}
+
+/// <summary>
+/// Oznacza komrk jako przeszkod lub j zwalnia. Przewit jest przeliczany od razu,
+/// tylko w otoczeniu zmienionej komrki
+/// </summary>
+/// <param name="GridPosition">pozycja komrki</param>
+/// <param name="bBlocked">true - komrka nieprzechodnia</param>
+void AGridManager::SetCellBlocked(FVector2D GridPosition, bool bBlocked)
+{
+    NavigationLayer.SetCellBlocked(ToCell(GridPosition), bBlocked);
+    NavigationLayer.UpdateClearance();
+}
+
+/// <summary>
+/// Zmienia wiele komrek naraz - przewit jest przeliczany raz dla caej partii
+/// </summary>
+/// <param name="Cells">komrki do zmiany</param>
+/// <param name="bBlocked">true - komrki nieprzechodnie</param>
+void AGridManager::SetCellsBlocked(const TArray<FGridCell>& Cells, bool bBlocked)
+{
+    for (const FGridCell& Cell : Cells)
+    {
+        NavigationLayer.SetCellBlocked(Cell, bBlocked);
+    }
+    NavigationLayer.UpdateClearance();
+}
+
+/// <summary>
+/// Zezwala lub zabrania rozstawiania jednostek w komrce (komrka pozostaje przechodnia)
+/// </summary>
+/// <param name="GridPosition">pozycja komrki</param>
+/// <param name="bAllowed">true - rozstawianie dozwolone</param>
+void AGridManager::SetCellPlacementAllowed(FVector2D GridPosition, bool bAllowed)
+{
+    const FGridCell Cell = ToCell(GridPosition);
+    ENavCellFlags Flags = NavigationLayer.GetCellFlags(Cell);
+    if (bAllowed)
+    {
+        Flags &= ~ENavCellFlags::NoPlacement;
+    }
+    else
+    {
+        Flags |= ENavCellFlags::NoPlacement;
+    }
+    NavigationLayer.SetCellFlags(Cell, Flags);
+}
+
+/// <summary>
+/// Ustawia koszt ruchu przez komrk (1 - teren zwyky, do 255)
+/// </summary>
+/// <param name="GridPosition">pozycja komrki</param>
+/// <param name="Cost">koszt ruchu</param>
+void AGridManager::SetCellMovementCost(FVector2D GridPosition, int32 Cost)
+{
+    NavigationLayer.SetCellMoveCost(ToCell(GridPosition), static_cast<uint8>(FMath::Clamp(Cost, 1, 255)));
+}
+
+/// <summary>
+/// Sprawdza czy komrka jest przechodnia (bez warstwy nawigacji - kada komrka planszy)
+/// </summary>
+/// <param name="GridPosition">pozycja do sprawdzenia</param>
+/// <returns>true jeli komrka jest przechodnia, false - wpp</returns>
+bool AGridManager::IsCellWalkable(FVector2D GridPosition) const
+{
+    if (!NavigationLayer.IsInitialized())
+        return IsValidGridPosition(GridPosition);
+
+    return !NavigationLayer.IsCellBlocked(ToCell(GridPosition));
+}
+
+/// <summary>
+/// Sprawdza czy w komrce mona rozstawi jednostk
+/// </summary>
+/// <param name="GridPosition">pozycja do sprawdzenia</param>
+/// <returns>true jeli rozstawianie jest dozwolone, false - wpp</returns>
+bool AGridManager::IsCellPlaceable(FVector2D GridPosition) const
+{
+    if (!NavigationLayer.IsInitialized())
+        return IsValidGridPosition(GridPosition);
+
+    return NavigationLayer.IsCellPlaceable(ToCell(GridPosition));
+}
+
+/// <summary>
+/// Przewit komrki - odlego w komrkach do najbliszej przeszkody lub krawdzi planszy
+/// </summary>
+/// <param name="GridPosition">pozycja komrki</param>
+/// <returns>przewit (0 - komrka zablokowana lub poza plansz)</returns>
+int32 AGridManager::GetCellClearance(FVector2D GridPosition) const
+{
+    return NavigationLayer.GetClearance(ToCell(GridPosition));
+}
+
+/// <summary>
+/// Sprawdza przechodnio komrki pod pozycj wiata - bez zapyta fizyki.
+/// Pozycje poza plansz nie s tu odrzucane (pilnuj tego granice pola bitwy)
+/// </summary>
+/// <param name="WorldLocation">pozycja w przestrzeni wiata</param>
+/// <returns>true jeli pozycja nie ley w zablokowanej komrce, false - wpp</returns>
+bool AGridManager::IsWorldLocationWalkable(const FVector& WorldLocation) const
+{
+    const FGridCell Cell = ToCell(GetGridPositionFromWorld(WorldLocation));
+    if (!NavigationLayer.IsValidCell(Cell))
+        return true;
+
+    return !NavigationLayer.IsCellBlocked(Cell);
 }
\ No newline at end of file
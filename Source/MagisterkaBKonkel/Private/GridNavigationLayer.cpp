@@ -0,0 +1,507 @@
+// GridNavigationLayer.cpp - Implementacja warstwy nawigacji planszy
+#include "GridNavigationLayer.h"
+
+/// <summary>
+/// Inicjalizacja pustej warstwy - bez fragmentow, czyli wszystkie komorki przechodnie,
+/// koszt domyslny, przeswit liczony od krawedzi planszy.
+/// </summary>
+/// <param name="InWidth">Szerokosc planszy w komorkach</param>
+/// <param name="InHeight">Wysokosc planszy w komorkach</param>
+void FGridNavigationLayer::Initialize(int32 InWidth, int32 InHeight)
+{
+    Width = FMath::Max(0, InWidth);
+    Height = FMath::Max(0, InHeight);
+    Chunks.Reset();
+    ChunkRevisions.Reset();
+    bHasDirtyRegion = false;
+    LayoutRevision = ++Revision;
+}
+
+void FGridNavigationLayer::Reset()
+{
+    Width = 0;
+    Height = 0;
+    Chunks.Empty();
+    ChunkRevisions.Empty();
+    bHasDirtyRegion = false;
+    LayoutRevision = ++Revision;
+}
+
+/// <summary>
+/// Przywrocenie flag, kosztow i przeswitu z kopii warstwy (np. sprzed tymczasowej zmiany wymiarow planszy).
+/// Rewizja nie moze sie cofnac - odbiorcy porownuja ja z rewizja swojej kopii, wiec przywrocenie
+/// liczy sie jako nowy uklad warstwy.
+/// </summary>
+/// <param name="Saved">Zapamietana kopia warstwy</param>
+void FGridNavigationLayer::RestoreFrom(const FGridNavigationLayer& Saved)
+{
+    const uint32 NewRevision = FMath::Max(Revision, Saved.Revision) + 1;
+    *this = Saved;
+    ChunkRevisions.Reset();
+    Revision = NewRevision;
+    LayoutRevision = NewRevision;
+}
+
+void FGridNavigationLayer::SetCellFlags(const FGridCell& Cell, ENavCellFlags Flags)
+{
+    if (!IsValidCell(Cell))
+    {
+        return;
+    }
+
+    const uint8 CurrentFlags = static_cast<uint8>(GetCellFlags(Cell));
+    if (CurrentFlags == static_cast<uint8>(Flags))
+    {
+        return;
+    }
+
+    FindOrAddChunk(GetChunkCoord(Cell)).CellFlags[GetLocalIndex(Cell)] = static_cast<uint8>(Flags);
+    Revision++;
+    MarkChunkChanged(GetChunkCoord(Cell));
+
+    // Przeswit zalezy tylko od blokady
+    if (((CurrentFlags ^ static_cast<uint8>(Flags)) & static_cast<uint8>(ENavCellFlags::Blocked)) != 0)
+    {
+        MarkDirty(Cell);
+    }
+}
+
+void FGridNavigationLayer::SetCellBlocked(const FGridCell& Cell, bool bBlocked)
+{
+    if (!IsValidCell(Cell))
+    {
+        return;
+    }
+
+    ENavCellFlags Flags = GetCellFlags(Cell);
+    if (bBlocked)
+    {
+        Flags |= ENavCellFlags::Blocked;
+    }
+    else
+    {
+        Flags &= ~ENavCellFlags::Blocked;
+    }
+
+    SetCellFlags(Cell, Flags);
+}
+
+/// <summary>
+/// Koszt wejscia w komorke (1 - teren zwykly, wiecej - teren spowalniajacy)
+/// </summary>
+void FGridNavigationLayer::SetCellMoveCost(const FGridCell& Cell, uint8 Cost)
+{
+    if (!IsValidCell(Cell))
+    {
+        return;
+    }
+
+    Cost = FMath::Max<uint8>(Cost, 1);
+    if (GetMoveCost(Cell) != Cost)
+    {
+        FindOrAddChunk(GetChunkCoord(Cell)).MoveCosts[GetLocalIndex(Cell)] = Cost;
+        Revision++;
+        MarkChunkChanged(GetChunkCoord(Cell));
+    }
+}
+
+/// <summary>
+/// Usuwa flagi ze wszystkich fragmentow. Zdjecie blokady oznacza fragment do przeliczenia przeswitu.
+/// </summary>
+/// <param name="Flags">Flagi do usuniecia</param>
+void FGridNavigationLayer::ClearFlags(ENavCellFlags Flags)
+{
+    const uint8 Mask = static_cast<uint8>(Flags);
+    const uint32 NewRevision = Revision + 1;
+    bool bChanged = false;
+
+    for (TPair<FGridCell, FGridNavigationChunk>& ChunkPair : Chunks)
+    {
+        const FGridCell ChunkOrigin = ChunkPair.Key * ChunkSize;
+        TArray<uint8>& CellFlags = ChunkPair.Value.CellFlags;
+        for (int32 LocalIndex = 0; LocalIndex < CellFlags.Num(); LocalIndex++)
+        {
+            if ((CellFlags[LocalIndex] & Mask) == 0)
+            {
+                continue;
+            }
+
+            if (CellFlags[LocalIndex] & Mask & static_cast<uint8>(ENavCellFlags::Blocked))
+            {
+                MarkDirty(ChunkOrigin + FGridCell::FromIndex(LocalIndex, ChunkSize));
+            }
+
+            CellFlags[LocalIndex] &= ~Mask;
+            ChunkRevisions.Add(ChunkPair.Key, NewRevision);
+            bChanged = true;
+        }
+    }
+
+    if (bChanged)
+    {
+        Revision = NewRevision;
+    }
+}
+
+/// <summary>
+/// Przeliczenie przeswitu po zmianach blokad. Zmiana komorki wplywa tylko na komorki w promieniu
+/// MaxClearance, wiec przeliczany jest prostokat zmian powiekszony o ten margines.
+/// </summary>
+/// <returns>true jesli przeswit zostal przeliczony, false - wpp</returns>
+bool FGridNavigationLayer::UpdateClearance()
+{
+    if (!bHasDirtyRegion || !IsInitialized())
+    {
+        return false;
+    }
+
+    const FIntRect Region(
+        FMath::Max(0, DirtyRegion.Min.X - MaxClearance),
+        FMath::Max(0, DirtyRegion.Min.Y - MaxClearance),
+        FMath::Min(Width - 1, DirtyRegion.Max.X + MaxClearance),
+        FMath::Min(Height - 1, DirtyRegion.Max.Y + MaxClearance));
+
+    RebuildClearance(Region);
+    bHasDirtyRegion = false;
+    return true;
+}
+
+ENavCellFlags FGridNavigationLayer::GetCellFlags(const FGridCell& Cell) const
+{
+    if (!IsValidCell(Cell))
+    {
+        return ENavCellFlags::Blocked;
+    }
+
+    const FGridNavigationChunk* Chunk = Chunks.Find(GetChunkCoord(Cell));
+    return Chunk ? static_cast<ENavCellFlags>(Chunk->CellFlags[GetLocalIndex(Cell)]) : ENavCellFlags::None;
+}
+
+bool FGridNavigationLayer::IsCellBlocked(const FGridCell& Cell) const
+{
+    return EnumHasAnyFlags(GetCellFlags(Cell), ENavCellFlags::Blocked);
+}
+
+bool FGridNavigationLayer::IsCellPlaceable(const FGridCell& Cell) const
+{
+    return !EnumHasAnyFlags(GetCellFlags(Cell), ENavCellFlags::Blocked | ENavCellFlags::NoPlacement);
+}
+
+uint8 FGridNavigationLayer::GetMoveCost(const FGridCell& Cell) const
+{
+    if (!IsValidCell(Cell))
+    {
+        return MAX_uint8;
+    }
+
+    const FGridNavigationChunk* Chunk = Chunks.Find(GetChunkCoord(Cell));
+    return Chunk ? Chunk->MoveCosts[GetLocalIndex(Cell)] : DefaultMoveCost;
+}
+
+uint8 FGridNavigationLayer::GetClearance(const FGridCell& Cell) const
+{
+    return ReadClearance(Cell.X, Cell.Y);
+}
+
+/// <summary>
+/// Jednostka o promieniu RadiusCells zajmuje kwadrat (2 * RadiusCells + 1) komorek wokol Cell -
+/// miesci sie, gdy najblizsza przeszkoda jest dalej niz RadiusCells.
+/// </summary>
+bool FGridNavigationLayer::HasClearance(const FGridCell& Cell, int32 RadiusCells) const
+{
+    return GetClearance(Cell) > FMath::Clamp(RadiusCells, 0, MaxClearance - 1);
+}
+
+/// <summary>
+/// Blokady prostokata planszy w plaskiej tablicy - czesc bez fragmentow pozostaje przechodnia.
+/// Przegladane sa tylko fragmenty przecinajace prostokat.
+/// </summary>
+/// <param name="Region">Prostokat komorek (Max poza prostokatem), przycinany do planszy</param>
+/// <param name="OutBlocked">Blokady komorek prostokata</param>
+void FGridNavigationLayer::GetBlockedCells(const FIntRect& Region, TArray<bool>& OutBlocked) const
+{
+    const FIntRect Clipped(Region.Min.ComponentMax(FIntPoint::ZeroValue), Region.Max.ComponentMin(FIntPoint(Width, Height)));
+    const int32 RegionWidth = FMath::Max(0, Region.Width());
+    OutBlocked.Init(false, RegionWidth * FMath::Max(0, Region.Height()));
+    if (Clipped.Width() <= 0 || Clipped.Height() <= 0)
+    {
+        return;
+    }
+
+    const FGridCell MinChunk = GetChunkCoord(FGridCell(Clipped.Min));
+    const FGridCell MaxChunk = GetChunkCoord(FGridCell(Clipped.Max) - FGridCell(1, 1));
+    for (int32 ChunkY = MinChunk.Y; ChunkY <= MaxChunk.Y; ChunkY++)
+    {
+        for (int32 ChunkX = MinChunk.X; ChunkX <= MaxChunk.X; ChunkX++)
+        {
+            const FGridNavigationChunk* Chunk = Chunks.Find(FGridCell(ChunkX, ChunkY));
+            if (!Chunk)
+            {
+                continue;
+            }
+
+            const int32 StartX = FMath::Max(ChunkX * ChunkSize, Clipped.Min.X);
+            const int32 EndX = FMath::Min((ChunkX + 1) * ChunkSize, Clipped.Max.X);
+            const int32 StartY = FMath::Max(ChunkY * ChunkSize, Clipped.Min.Y);
+            const int32 EndY = FMath::Min((ChunkY + 1) * ChunkSize, Clipped.Max.Y);
+            for (int32 Y = StartY; Y < EndY; Y++)
+            {
+                for (int32 X = StartX; X < EndX; X++)
+                {
+                    OutBlocked[(Y - Region.Min.Y) * RegionWidth + X - Region.Min.X] =
+                        (Chunk->CellFlags[GetLocalIndex(FGridCell(X, Y))] & static_cast<uint8>(ENavCellFlags::Blocked)) != 0;
+                }
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Koszty ruchu prostokata planszy w plaskiej tablicy - czesc bez fragmentow ma koszt domyslny.
+/// Przegladane sa tylko fragmenty przecinajace prostokat.
+/// </summary>
+/// <param name="Region">Prostokat komorek (Max poza prostokatem), przycinany do planszy</param>
+/// <param name="OutCosts">Koszty komorek prostokata</param>
+void FGridNavigationLayer::GetMoveCosts(const FIntRect& Region, TArray<uint8>& OutCosts) const
+{
+    const FIntRect Clipped(Region.Min.ComponentMax(FIntPoint::ZeroValue), Region.Max.ComponentMin(FIntPoint(Width, Height)));
+    const int32 RegionWidth = FMath::Max(0, Region.Width());
+    OutCosts.Init(DefaultMoveCost, RegionWidth * FMath::Max(0, Region.Height()));
+    if (Clipped.Width() <= 0 || Clipped.Height() <= 0)
+    {
+        return;
+    }
+
+    const FGridCell MinChunk = GetChunkCoord(FGridCell(Clipped.Min));
+    const FGridCell MaxChunk = GetChunkCoord(FGridCell(Clipped.Max) - FGridCell(1, 1));
+    for (int32 ChunkY = MinChunk.Y; ChunkY <= MaxChunk.Y; ChunkY++)
+    {
+        for (int32 ChunkX = MinChunk.X; ChunkX <= MaxChunk.X; ChunkX++)
+        {
+            const FGridNavigationChunk* Chunk = Chunks.Find(FGridCell(ChunkX, ChunkY));
+            if (!Chunk)
+            {
+                continue;
+            }
+
+            const int32 StartX = FMath::Max(ChunkX * ChunkSize, Clipped.Min.X);
+            const int32 EndX = FMath::Min((ChunkX + 1) * ChunkSize, Clipped.Max.X);
+            const int32 StartY = FMath::Max(ChunkY * ChunkSize, Clipped.Min.Y);
+            const int32 EndY = FMath::Min((ChunkY + 1) * ChunkSize, Clipped.Max.Y);
+            for (int32 Y = StartY; Y < EndY; Y++)
+            {
+                FMemory::Memcpy(&OutCosts[(Y - Region.Min.Y) * RegionWidth + StartX - Region.Min.X],
+                    &Chunk->MoveCosts[GetLocalIndex(FGridCell(StartX, Y))], EndX - StartX);
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Przesuniecie arytmetyczne zaokragla w dol takze dla ujemnych wspolrzednych (-1 lezy we fragmencie -1)
+/// </summary>
+FGridCell FGridNavigationLayer::GetChunkCoord(const FGridCell& Cell)
+{
+    return FGridCell(Cell.X >> ChunkShift, Cell.Y >> ChunkShift);
+}
+
+FGridCell FGridNavigationLayer::GetChunkGridSize() const
+{
+    return FGridCell(FMath::DivideAndRoundUp(Width, ChunkSize), FMath::DivideAndRoundUp(Height, ChunkSize));
+}
+
+/// <summary>
+/// Zwalnia fragmenty bez przeszkod, flag i kosztow, w ktorych przeswit nie rozni sie od liczonego od krawedzi
+/// </summary>
+/// <returns>Liczba zwolnionych fragmentow</returns>
+int32 FGridNavigationLayer::ReleaseUnusedChunks()
+{
+    int32 ReleasedChunks = 0;
+    for (auto ChunkIterator = Chunks.CreateIterator(); ChunkIterator; ++ChunkIterator)
+    {
+        if (IsChunkUnused(ChunkIterator->Key, ChunkIterator->Value))
+        {
+            ChunkIterator.RemoveCurrent();
+            ReleasedChunks++;
+        }
+    }
+
+    return ReleasedChunks;
+}
+
+/// <summary>
+/// Fragmenty zmienione po podanej rewizji - odbiorca kopii warstwy przepisuje tylko je
+/// </summary>
+/// <param name="SinceRevision">Rewizja ostatniej kopii odbiorcy</param>
+/// <param name="OutChunkCoords">Wspolrzedne zmienionych fragmentow</param>
+void FGridNavigationLayer::GetChangedChunks(uint32 SinceRevision, TArray<FGridCell>& OutChunkCoords) const
+{
+    OutChunkCoords.Reset();
+    for (const TPair<FGridCell, uint32>& ChunkRevision : ChunkRevisions)
+    {
+        if (ChunkRevision.Value > SinceRevision)
+        {
+            OutChunkCoords.Add(ChunkRevision.Key);
+        }
+    }
+}
+
+/// <summary>
+/// Nowy fragment ma wartosci domyslne - takie same, jakie zwracaly odczyty przed jego utworzeniem
+/// </summary>
+FGridNavigationChunk& FGridNavigationLayer::FindOrAddChunk(const FGridCell& ChunkCoord)
+{
+    if (FGridNavigationChunk* ExistingChunk = Chunks.Find(ChunkCoord))
+    {
+        return *ExistingChunk;
+    }
+
+    FGridNavigationChunk& Chunk = Chunks.Add(ChunkCoord);
+    Chunk.CellFlags.Init(static_cast<uint8>(ENavCellFlags::None), ChunkSize * ChunkSize);
+    Chunk.MoveCosts.Init(DefaultMoveCost, ChunkSize * ChunkSize);
+    Chunk.Clearance.SetNumUninitialized(ChunkSize * ChunkSize);
+
+    const FGridCell ChunkOrigin = ChunkCoord * ChunkSize;
+    for (int32 LocalY = 0; LocalY < ChunkSize; LocalY++)
+    {
+        for (int32 LocalX = 0; LocalX < ChunkSize; LocalX++)
+        {
+            Chunk.Clearance[LocalY * ChunkSize + LocalX] = GetEdgeClearance(ChunkOrigin.X + LocalX, ChunkOrigin.Y + LocalY);
+        }
+    }
+
+    return Chunk;
+}
+
+bool FGridNavigationLayer::IsChunkUnused(const FGridCell& ChunkCoord, const FGridNavigationChunk& Chunk) const
+{
+    const FGridCell ChunkOrigin = ChunkCoord * ChunkSize;
+    for (int32 LocalY = 0; LocalY < ChunkSize; LocalY++)
+    {
+        for (int32 LocalX = 0; LocalX < ChunkSize; LocalX++)
+        {
+            const int32 LocalIndex = LocalY * ChunkSize + LocalX;
+            if (Chunk.CellFlags[LocalIndex] != static_cast<uint8>(ENavCellFlags::None) ||
+                Chunk.MoveCosts[LocalIndex] != DefaultMoveCost ||
+                Chunk.Clearance[LocalIndex] != GetEdgeClearance(ChunkOrigin.X + LocalX, ChunkOrigin.Y + LocalY))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+uint8 FGridNavigationLayer::GetEdgeClearance(int32 X, int32 Y) const
+{
+    if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+    {
+        return 0;
+    }
+
+    const int32 EdgeDistance = FMath::Min(FMath::Min(X + 1, Y + 1), FMath::Min(Width - X, Height - Y));
+    return static_cast<uint8>(FMath::Min<int32>(EdgeDistance, MaxClearance));
+}
+
+void FGridNavigationLayer::MarkDirty(const FGridCell& Cell)
+{
+    if (!bHasDirtyRegion)
+    {
+        DirtyRegion = FIntRect(Cell.ToIntPoint(), Cell.ToIntPoint());
+        bHasDirtyRegion = true;
+        return;
+    }
+
+    DirtyRegion.Min = DirtyRegion.Min.ComponentMin(Cell.ToIntPoint());
+    DirtyRegion.Max = DirtyRegion.Max.ComponentMax(Cell.ToIntPoint());
+}
+
+void FGridNavigationLayer::MarkChunkChanged(const FGridCell& ChunkCoord)
+{
+    ChunkRevisions.Add(ChunkCoord, Revision);
+}
+
+/// <summary>
+/// Przeswit poza plansza wynosi 0 - krawedz dziala jak przeszkoda. Komorka bez fragmentu
+/// ma przeswit liczony od krawedzi.
+/// </summary>
+uint8 FGridNavigationLayer::ReadClearance(int32 X, int32 Y) const
+{
+    if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+    {
+        return 0;
+    }
+
+    const FGridCell Cell(X, Y);
+    const FGridNavigationChunk* Chunk = Chunks.Find(GetChunkCoord(Cell));
+    return Chunk ? Chunk->Clearance[GetLocalIndex(Cell)] : GetEdgeClearance(X, Y);
+}
+
+/// <summary>
+/// Fragment jest tworzony tylko wtedy, gdy przeswit komorki rozni sie od liczonego od krawedzi
+/// </summary>
+void FGridNavigationLayer::WriteClearance(int32 X, int32 Y, uint8 Value)
+{
+    const FGridCell Cell(X, Y);
+    FGridNavigationChunk* Chunk = Chunks.Find(GetChunkCoord(Cell));
+    if (!Chunk)
+    {
+        if (Value == GetEdgeClearance(X, Y))
+        {
+            return;
+        }
+        Chunk = &FindOrAddChunk(GetChunkCoord(Cell));
+    }
+
+    Chunk->Clearance[GetLocalIndex(Cell)] = Value;
+}
+
+/// <summary>
+/// Dwuprzebiegowa transformata odleglosci Chebysheva w prostokacie Region (wlacznie z Max).
+/// Komorki poza prostokatem maja aktualny przeswit i sluza jako warunek brzegowy.
+/// Przebieg w przod bierze sasiadow z lewej i z dolu, przebieg wstecz - z prawej i z gory;
+/// odleglosc do krawedzi planszy ogranicza wynik od razu, wiec fragmenty nie sa tworzone
+/// dla wartosci posrednich.
+/// </summary>
+/// <param name="Region">Prostokat komorek do przeliczenia</param>
+void FGridNavigationLayer::RebuildClearance(const FIntRect& Region)
+{
+    for (int32 Y = Region.Min.Y; Y <= Region.Max.Y; Y++)
+    {
+        for (int32 X = Region.Min.X; X <= Region.Max.X; X++)
+        {
+            if (IsCellBlocked(FGridCell(X, Y)))
+            {
+                WriteClearance(X, Y, 0);
+                continue;
+            }
+
+            const uint8 Nearest = FMath::Min(
+                FMath::Min(ReadClearance(X - 1, Y), ReadClearance(X - 1, Y - 1)),
+                FMath::Min(ReadClearance(X, Y - 1), ReadClearance(X + 1, Y - 1)));
+            WriteClearance(X, Y, static_cast<uint8>(FMath::Min<int32>(GetEdgeClearance(X, Y), Nearest + 1)));
+        }
+    }
+
+    for (int32 Y = Region.Max.Y; Y >= Region.Min.Y; Y--)
+    {
+        for (int32 X = Region.Max.X; X >= Region.Min.X; X--)
+        {
+            if (IsCellBlocked(FGridCell(X, Y)))
+            {
+                continue;
+            }
+
+            const uint8 Current = ReadClearance(X, Y);
+            const uint8 Nearest = FMath::Min(
+                FMath::Min(ReadClearance(X + 1, Y), ReadClearance(X + 1, Y + 1)),
+                FMath::Min(ReadClearance(X, Y + 1), ReadClearance(X - 1, Y + 1)));
+            const uint8 Value = static_cast<uint8>(FMath::Min<int32>(Current, Nearest + 1));
+            if (Value != Current)
+            {
+                WriteClearance(X, Y, Value);
+            }
+        }
+    }
+}
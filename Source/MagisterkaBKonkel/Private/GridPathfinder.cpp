@@ -0,0 +1,584 @@
+// GridPathfinder.cpp - Implementacja JPS na siatce bitwy i kolejki zapytan liczonych w tle
+#include "GridPathfinder.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    /// <summary>
+    /// Stan jednego wyszukiwania wstecz od celu. Komorki startow sa celami wyszukiwania -
+    /// skok zatrzymuje sie na kazdej z nich.
+    /// </summary>
+    struct FJumpPointSearch
+    {
+        struct FOpenNode
+        {
+            int32 Cost;
+            int32 PathCost;
+            int32 Index;
+
+            bool operator<(const FOpenNode& Other) const
+            {
+                return Cost < Other.Cost || (Cost == Other.Cost && PathCost > Other.PathCost);
+            }
+        };
+
+        int32 Width;
+        int32 Height;
+        const TArray<bool>& BlockedCells;
+        int32 GoalIndex;
+        TArray<uint8> TargetMask;
+
+        FJumpPointSearch(int32 InWidth, int32 InHeight, const TArray<bool>& InBlockedCells, int32 InGoalIndex)
+            : Width(InWidth)
+            , Height(InHeight)
+            , BlockedCells(InBlockedCells)
+            , GoalIndex(InGoalIndex)
+        {
+            TargetMask.Init(0, Width * Height);
+        }
+
+        bool IsWalkable(int32 X, int32 Y) const
+        {
+            if (X < 0 || X >= Width || Y < 0 || Y >= Height)
+            {
+                return false;
+            }
+
+            const int32 Index = Y * Width + X;
+            return !BlockedCells[Index] || TargetMask[Index] != 0 || Index == GoalIndex;
+        }
+
+        /// Skok z komorki (X, Y) w kierunku (DirectionX, DirectionY) do najblizszego punktu skoku
+        bool Jump(int32 X, int32 Y, int32 DirectionX, int32 DirectionY, FGridCell& OutJumpPoint) const
+        {
+            while (true)
+            {
+                if (!IsWalkable(X, Y))
+                {
+                    return false;
+                }
+
+                if (TargetMask[Y * Width + X] != 0)
+                {
+                    OutJumpPoint = FGridCell(X, Y);
+                    return true;
+                }
+
+                if (DirectionX != 0 && DirectionY != 0)
+                {
+                    // Po przekatnej punktem skoku jest komorka, z ktorej skok prosty cos znajduje
+                    FGridCell Unused;
+                    if (Jump(X + DirectionX, Y, DirectionX, 0, Unused) || Jump(X, Y + DirectionY, 0, DirectionY, Unused))
+                    {
+                        OutJumpPoint = FGridCell(X, Y);
+                        return true;
+                    }
+                }
+                else if (DirectionX != 0)
+                {
+                    // Wymuszony sasiad - przeszkoda za plecami odslania komorke obok
+                    if ((IsWalkable(X, Y - 1) && !IsWalkable(X - DirectionX, Y - 1)) ||
+                        (IsWalkable(X, Y + 1) && !IsWalkable(X - DirectionX, Y + 1)))
+                    {
+                        OutJumpPoint = FGridCell(X, Y);
+                        return true;
+                    }
+                }
+                else
+                {
+                    if ((IsWalkable(X - 1, Y) && !IsWalkable(X - 1, Y - DirectionY)) ||
+                        (IsWalkable(X + 1, Y) && !IsWalkable(X + 1, Y - DirectionY)))
+                    {
+                        OutJumpPoint = FGridCell(X, Y);
+                        return true;
+                    }
+                }
+
+                // Bez scinania rogow - przekatna wymaga obu wolnych komorek ortogonalnych
+                if (!IsWalkable(X + DirectionX, Y) || !IsWalkable(X, Y + DirectionY))
+                {
+                    return false;
+                }
+
+                X += DirectionX;
+                Y += DirectionY;
+            }
+        }
+
+        /// Kierunki do sprawdzenia z wezla, przyciete wzgledem kierunku, z ktorego do niego doszlismy
+        void GetSearchDirections(int32 X, int32 Y, int32 ParentIndex, TArray<FGridCell, TInlineAllocator<8>>& OutDirections) const
+        {
+            if (ParentIndex == INDEX_NONE)
+            {
+                for (int32 DirectionY = -1; DirectionY <= 1; DirectionY++)
+                {
+                    for (int32 DirectionX = -1; DirectionX <= 1; DirectionX++)
+                    {
+                        if ((DirectionX == 0 && DirectionY == 0) || !IsWalkable(X + DirectionX, Y + DirectionY))
+                        {
+                            continue;
+                        }
+
+                        if (DirectionX != 0 && DirectionY != 0 && (!IsWalkable(X + DirectionX, Y) || !IsWalkable(X, Y + DirectionY)))
+                        {
+                            continue;
+                        }
+
+                        OutDirections.Add(FGridCell(DirectionX, DirectionY));
+                    }
+                }
+                return;
+            }
+
+            const int32 DirectionX = FMath::Sign(X - ParentIndex % Width);
+            const int32 DirectionY = FMath::Sign(Y - ParentIndex / Width);
+
+            if (DirectionX != 0 && DirectionY != 0)
+            {
+                const bool bVerticalWalkable = IsWalkable(X, Y + DirectionY);
+                const bool bHorizontalWalkable = IsWalkable(X + DirectionX, Y);
+                if (bVerticalWalkable)
+                {
+                    OutDirections.Add(FGridCell(0, DirectionY));
+                }
+                if (bHorizontalWalkable)
+                {
+                    OutDirections.Add(FGridCell(DirectionX, 0));
+                }
+                if (bVerticalWalkable && bHorizontalWalkable && IsWalkable(X + DirectionX, Y + DirectionY))
+                {
+                    OutDirections.Add(FGridCell(DirectionX, DirectionY));
+                }
+            }
+            else if (DirectionX != 0)
+            {
+                const bool bNextWalkable = IsWalkable(X + DirectionX, Y);
+                const bool bUpWalkable = IsWalkable(X, Y + 1);
+                const bool bDownWalkable = IsWalkable(X, Y - 1);
+                if (bNextWalkable)
+                {
+                    OutDirections.Add(FGridCell(DirectionX, 0));
+                    if (bUpWalkable && IsWalkable(X + DirectionX, Y + 1))
+                    {
+                        OutDirections.Add(FGridCell(DirectionX, 1));
+                    }
+                    if (bDownWalkable && IsWalkable(X + DirectionX, Y - 1))
+                    {
+                        OutDirections.Add(FGridCell(DirectionX, -1));
+                    }
+                }
+                if (bUpWalkable)
+                {
+                    OutDirections.Add(FGridCell(0, 1));
+                }
+                if (bDownWalkable)
+                {
+                    OutDirections.Add(FGridCell(0, -1));
+                }
+            }
+            else
+            {
+                const bool bNextWalkable = IsWalkable(X, Y + DirectionY);
+                const bool bRightWalkable = IsWalkable(X + 1, Y);
+                const bool bLeftWalkable = IsWalkable(X - 1, Y);
+                if (bNextWalkable)
+                {
+                    OutDirections.Add(FGridCell(0, DirectionY));
+                    if (bRightWalkable && IsWalkable(X + 1, Y + DirectionY))
+                    {
+                        OutDirections.Add(FGridCell(1, DirectionY));
+                    }
+                    if (bLeftWalkable && IsWalkable(X - 1, Y + DirectionY))
+                    {
+                        OutDirections.Add(FGridCell(-1, DirectionY));
+                    }
+                }
+                if (bRightWalkable)
+                {
+                    OutDirections.Add(FGridCell(1, 0));
+                }
+                if (bLeftWalkable)
+                {
+                    OutDirections.Add(FGridCell(-1, 0));
+                }
+            }
+        }
+    };
+}
+
+/// <summary>
+/// Odleglosc oktylna (koszt ruchu po pustej siatce 8-sasiedztwa).
+/// </summary>
+int32 FGridPathfinder::OctileDistance(const FGridCell& A, const FGridCell& B)
+{
+    const int32 DeltaX = FMath::Abs(A.X - B.X);
+    const int32 DeltaY = FMath::Abs(A.Y - B.Y);
+    return OrthogonalCost * FMath::Max(DeltaX, DeltaY) + (DiagonalCost - OrthogonalCost) * FMath::Min(DeltaX, DeltaY);
+}
+
+/// <summary>
+/// Jedno wyszukiwanie JPS od celu do wszystkich startow. Heurystyka to minimum odleglosci
+/// oktylnej do startow - jest spojna, wiec kazdy zamkniety wezel ma juz optymalny koszt.
+/// </summary>
+/// <param name="Width">Szerokosc siatki</param>
+/// <param name="Height">Wysokosc siatki</param>
+/// <param name="BlockedCells">Zajetosc komorek (Width * Height)</param>
+/// <param name="Goal">Komorka celu</param>
+/// <param name="Starts">Komorki startowe</param>
+/// <param name="OutPaths">Sciezki komorka po komorce, w kolejnosci Starts</param>
+void FGridPathfinder::FindPaths(int32 Width, int32 Height, const TArray<bool>& BlockedCells,
+    const FGridCell& Goal, const TArray<FGridCell>& Starts, TArray<TArray<FGridCell>>& OutPaths)
+{
+    OutPaths.Reset();
+    OutPaths.SetNum(Starts.Num());
+
+    const int32 NumCells = Width * Height;
+    if (NumCells == 0 || BlockedCells.Num() != NumCells || !Goal.IsInside(Width, Height))
+    {
+        return;
+    }
+
+    FJumpPointSearch Search(Width, Height, BlockedCells, Goal.ToIndex(Width));
+
+    int32 RemainingTargets = 0;
+    for (const FGridCell& Start : Starts)
+    {
+        if (Start.IsInside(Width, Height) && Search.TargetMask[Start.ToIndex(Width)] == 0)
+        {
+            Search.TargetMask[Start.ToIndex(Width)] = 1;
+            RemainingTargets++;
+        }
+    }
+
+    const auto Heuristic = [&Starts, Width, Height](const FGridCell& Cell)
+    {
+        int32 Best = MAX_int32;
+        for (const FGridCell& Start : Starts)
+        {
+            if (Start.IsInside(Width, Height))
+            {
+                Best = FMath::Min(Best, OctileDistance(Cell, Start));
+            }
+        }
+        return Best;
+    };
+
+    TArray<int32> PathCosts;
+    TArray<int32> Parents;
+    TArray<uint8> Closed;
+    PathCosts.Init(MAX_int32, NumCells);
+    Parents.Init(INDEX_NONE, NumCells);
+    Closed.Init(0, NumCells);
+
+    TArray<FJumpPointSearch::FOpenNode> OpenNodes;
+    PathCosts[Search.GoalIndex] = 0;
+    OpenNodes.HeapPush({ Heuristic(Goal), 0, Search.GoalIndex });
+
+    TArray<FGridCell, TInlineAllocator<8>> Directions;
+    while (OpenNodes.Num() > 0 && RemainingTargets > 0)
+    {
+        FJumpPointSearch::FOpenNode Current;
+        OpenNodes.HeapPop(Current, EAllowShrinking::No);
+        if (Closed[Current.Index] != 0 || Current.PathCost > PathCosts[Current.Index])
+        {
+            continue;
+        }
+
+        Closed[Current.Index] = 1;
+        if (Search.TargetMask[Current.Index] != 0)
+        {
+            RemainingTargets--;
+        }
+
+        const FGridCell CurrentCell = FGridCell::FromIndex(Current.Index, Width);
+        Directions.Reset();
+        Search.GetSearchDirections(CurrentCell.X, CurrentCell.Y, Parents[Current.Index], Directions);
+
+        for (const FGridCell& Direction : Directions)
+        {
+            FGridCell JumpPoint;
+            if (!Search.Jump(CurrentCell.X + Direction.X, CurrentCell.Y + Direction.Y, Direction.X, Direction.Y, JumpPoint))
+            {
+                continue;
+            }
+
+            const int32 JumpIndex = JumpPoint.ToIndex(Width);
+            if (Closed[JumpIndex] != 0)
+            {
+                continue;
+            }
+
+            const int32 NewPathCost = Current.PathCost + OctileDistance(CurrentCell, JumpPoint);
+            if (NewPathCost < PathCosts[JumpIndex])
+            {
+                PathCosts[JumpIndex] = NewPathCost;
+                Parents[JumpIndex] = Current.Index;
+                OpenNodes.HeapPush({ NewPathCost + Heuristic(JumpPoint), NewPathCost, JumpIndex });
+            }
+        }
+    }
+
+    // Odtworzenie sciezek - rodzic wskazuje w strone celu, odcinki miedzy punktami skoku sa proste lub ukosne
+    for (int32 StartIndex = 0; StartIndex < Starts.Num(); StartIndex++)
+    {
+        const FGridCell& Start = Starts[StartIndex];
+        if (!Start.IsInside(Width, Height) || Closed[Start.ToIndex(Width)] == 0)
+        {
+            continue;
+        }
+
+        TArray<FGridCell>& Path = OutPaths[StartIndex];
+        FGridCell Cell = Start;
+        Path.Add(Cell);
+
+        int32 NextIndex = Parents[Start.ToIndex(Width)];
+        while (NextIndex != INDEX_NONE)
+        {
+            const FGridCell NextCell = FGridCell::FromIndex(NextIndex, Width);
+            const FGridCell Step(FMath::Sign(NextCell.X - Cell.X), FMath::Sign(NextCell.Y - Cell.Y));
+            while (Cell != NextCell)
+            {
+                Cell += Step;
+                Path.Add(Cell);
+            }
+
+            NextIndex = Parents[NextIndex];
+        }
+    }
+}
+
+/// <summary>
+/// Destruktor - czeka na partie liczona w tle, ktora trzyma wskazniki na dane serwisu.
+/// </summary>
+FGridPathService::~FGridPathService()
+{
+    Reset();
+}
+
+/// <summary>
+/// Przygotowuje serwis dla siatki o podanych wymiarach, z pusta zajetoscia i pustym cache.
+/// </summary>
+/// <param name="InWidth">Szerokosc siatki</param>
+/// <param name="InHeight">Wysokosc siatki</param>
+void FGridPathService::Initialize(int32 InWidth, int32 InHeight)
+{
+    Reset();
+
+    Width = FMath::Max(InWidth, 0);
+    Height = FMath::Max(InHeight, 0);
+    BlockedCells = MakeShared<TArray<bool>, ESPMode::ThreadSafe>();
+    BlockedCells->Init(false, Width * Height);
+}
+
+/// <summary>
+/// Czeka na partie w tle i czysci kolejke, cache i liczniki.
+/// </summary>
+void FGridPathService::Reset()
+{
+    if (InFlightSearch.IsValid())
+    {
+        InFlightSearch.Wait();
+    }
+
+    InFlightSearch = TFuture<void>();
+    InFlightBatch.Reset();
+    BlockedCells.Reset();
+    QueuedRequests.Reset();
+    CachedResults.Reset();
+    PathCache.Reset();
+
+    Width = 0;
+    Height = 0;
+    OccupancyEpoch = 0;
+    Stats = FGridPathStats();
+}
+
+/// <summary>
+/// Podmienia zajetosc komorek. Partia w tle dalej czyta swoja migawke.
+/// </summary>
+/// <param name="NewBlockedCells">Zajetosc (Width * Height)</param>
+void FGridPathService::SetBlockedCells(const TArray<bool>& NewBlockedCells)
+{
+    if (!IsInitialized() || NewBlockedCells.Num() != Width * Height || *BlockedCells == NewBlockedCells)
+    {
+        return;
+    }
+
+    BlockedCells = MakeShared<TArray<bool>, ESPMode::ThreadSafe>(NewBlockedCells);
+    OccupancyEpoch++;
+    PathCache.Reset();
+}
+
+/// <summary>
+/// Zmienia zajetosc jednej komorki.
+/// </summary>
+void FGridPathService::SetCellBlocked(int32 X, int32 Y, bool bBlocked)
+{
+    if (!IsValidCell(FGridCell(X, Y)) || (*BlockedCells)[Y * Width + X] == bBlocked)
+    {
+        return;
+    }
+
+    TArray<bool> NewBlockedCells = *BlockedCells;
+    NewBlockedCells[Y * Width + X] = bBlocked;
+    SetBlockedCells(NewBlockedCells);
+}
+
+/// <summary>
+/// Zajetosc komorki w aktualnej migawce. Komorki poza siatka sa traktowane jako zajete.
+/// </summary>
+bool FGridPathService::IsCellBlocked(const FGridCell& Cell) const
+{
+    return !IsValidCell(Cell) || (*BlockedCells)[Cell.ToIndex(Width)];
+}
+
+/// <summary>
+/// Dodaje zapytanie o sciezke. Trafienie w cache jest zwracane w najblizszym Tick bez wyszukiwania.
+/// </summary>
+/// <param name="Start">Komorka startowa</param>
+/// <param name="Goal">Komorka celu</param>
+/// <returns>ID, pod ktorym wynik pojawi sie w Tick, lub INDEX_NONE</returns>
+int32 FGridPathService::RequestPath(const FGridCell& Start, const FGridCell& Goal)
+{
+    if (!IsValidCell(Start) || !IsValidCell(Goal))
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 RequestID = NextRequestID++;
+    Stats.Requests++;
+
+    if (const TArray<FGridCell>* CachedPath = PathCache.Find({ Start, Goal, OccupancyEpoch }))
+    {
+        FGridPathResult& Result = CachedResults.AddDefaulted_GetRef();
+        Result.RequestID = RequestID;
+        Result.bFound = CachedPath->Num() > 0;
+        Result.bFromCache = true;
+        Result.Path = *CachedPath;
+        Stats.CacheHits++;
+        return RequestID;
+    }
+
+    QueuedRequests.Add({ RequestID, Start, Goal });
+    return RequestID;
+}
+
+/// <summary>
+/// Odbiera wyniki partii uruchomionej w poprzednim ticku (czekajac, jesli jeszcze trwa), dolacza
+/// trafienia w cache i uruchamia w tle partie z nowych zapytan.
+/// </summary>
+/// <param name="OutResults">Tablica, do ktorej dopisywane sa gotowe wyniki</param>
+void FGridPathService::Tick(TArray<FGridPathResult>& OutResults)
+{
+    CompleteBatch(OutResults);
+
+    OutResults.Append(MoveTemp(CachedResults));
+    CachedResults.Reset();
+
+    LaunchBatch();
+}
+
+bool FGridPathService::IsValidCell(const FGridCell& Cell) const
+{
+    return IsInitialized() && Cell.IsInside(Width, Height);
+}
+
+/// <summary>
+/// Grupuje zapytania po komorce celu i uruchamia jedno wyszukiwanie na grupe (ParallelFor po grupach).
+/// </summary>
+void FGridPathService::LaunchBatch()
+{
+    if (QueuedRequests.Num() == 0 || InFlightBatch.IsValid())
+    {
+        return;
+    }
+
+    TSharedPtr<FSearchBatch, ESPMode::ThreadSafe> Batch = MakeShared<FSearchBatch, ESPMode::ThreadSafe>();
+    Batch->Epoch = OccupancyEpoch;
+    Batch->Requests = MoveTemp(QueuedRequests);
+    QueuedRequests.Reset();
+    Batch->RequestSlots.Reserve(Batch->Requests.Num());
+
+    TMap<FGridCell, int32> GroupByGoal;
+    for (const FQueuedRequest& Request : Batch->Requests)
+    {
+        int32 GroupIndex = INDEX_NONE;
+        if (const int32* ExistingGroup = GroupByGoal.Find(Request.Goal))
+        {
+            GroupIndex = *ExistingGroup;
+        }
+        else
+        {
+            GroupIndex = Batch->Groups.Num();
+            Batch->Groups.AddDefaulted_GetRef().Goal = Request.Goal;
+            GroupByGoal.Add(Request.Goal, GroupIndex);
+        }
+
+        const int32 StartIndex = Batch->Groups[GroupIndex].Starts.AddUnique(Request.Start);
+        Batch->RequestSlots.Add(FIntPoint(GroupIndex, StartIndex));
+    }
+
+    Stats.Searches += Batch->Groups.Num();
+    Stats.CoalescedRequests += Batch->Requests.Num() - Batch->Groups.Num();
+
+    InFlightBatch = Batch;
+    TSharedPtr<TArray<bool>, ESPMode::ThreadSafe> Snapshot = BlockedCells;
+    const int32 GridWidth = Width;
+    const int32 GridHeight = Height;
+
+    InFlightSearch = Async(EAsyncExecution::TaskGraph, [Batch, Snapshot, GridWidth, GridHeight]()
+    {
+        ParallelFor(Batch->Groups.Num(), [&Batch, &Snapshot, GridWidth, GridHeight](int32 GroupIndex)
+        {
+            FSearchGroup& Group = Batch->Groups[GroupIndex];
+            FGridPathfinder::FindPaths(GridWidth, GridHeight, *Snapshot, Group.Goal, Group.Starts, Group.Paths);
+        }, EParallelForFlags::Unbalanced);
+    });
+}
+
+/// <summary>
+/// Zbiera wyniki partii w tle i zapisuje je w cache, jesli zajetosc sie od tego czasu nie zmienila.
+/// </summary>
+/// <param name="OutResults">Tablica, do ktorej dopisywane sa wyniki</param>
+void FGridPathService::CompleteBatch(TArray<FGridPathResult>& OutResults)
+{
+    if (!InFlightBatch.IsValid())
+    {
+        return;
+    }
+
+    InFlightSearch.Wait();
+
+    const FSearchBatch& Batch = *InFlightBatch;
+    for (int32 RequestIndex = 0; RequestIndex < Batch.Requests.Num(); RequestIndex++)
+    {
+        const FQueuedRequest& Request = Batch.Requests[RequestIndex];
+        const FIntPoint& Slot = Batch.RequestSlots[RequestIndex];
+        const TArray<FGridCell>& Path = Batch.Groups[Slot.X].Paths[Slot.Y];
+
+        FGridPathResult& Result = OutResults.AddDefaulted_GetRef();
+        Result.RequestID = Request.RequestID;
+        Result.bFound = Path.Num() > 0;
+        Result.Path = Path;
+
+        if (Batch.Epoch == OccupancyEpoch)
+        {
+            AddToCache({ Request.Start, Request.Goal, Batch.Epoch }, Path);
+        }
+    }
+
+    InFlightSearch = TFuture<void>();
+    InFlightBatch.Reset();
+}
+
+void FGridPathService::AddToCache(const FPathCacheKey& Key, const TArray<FGridCell>& Path)
+{
+    // Prosty limit pamieci - po przepelnieniu cache zaczyna od nowa
+    if (PathCache.Num() >= MaxCachedPaths)
+    {
+        PathCache.Reset();
+    }
+
+    PathCache.Add(Key, Path);
+}
@@ -0,0 +1,435 @@
+// LocalAvoidance.cpp - Implementacja unikania kolizji ORCA na migawce jednostek
+#include "LocalAvoidance.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    constexpr float AvoidanceEpsilon = 1.0e-5f;
+
+    /// Polplaszczyzna dozwolonych predkosci - dozwolona strona jest po lewej od Direction
+    struct FOrcaLine
+    {
+        FVector2D Point;
+        FVector2D Direction;
+    };
+
+    float Det(const FVector2D& A, const FVector2D& B)
+    {
+        return A.X * B.Y - A.Y * B.X;
+    }
+
+    /// <summary>
+    /// Optymalizacja na prostej Lines[LineIndex] ograniczonej kolem predkosci i poprzednimi prostymi.
+    /// </summary>
+    bool SolveOnLine(const FOrcaLine* Lines, int32 LineIndex, float Radius, const FVector2D& OptVelocity,
+        bool bDirectionOpt, FVector2D& Result)
+    {
+        const FOrcaLine& Line = Lines[LineIndex];
+        const float DotProduct = Line.Point | Line.Direction;
+        const float Discriminant = DotProduct * DotProduct + Radius * Radius - Line.Point.SizeSquared();
+
+        // Prosta nie przecina kola maksymalnej predkosci
+        if (Discriminant < 0.0f)
+        {
+            return false;
+        }
+
+        const float SqrtDiscriminant = FMath::Sqrt(Discriminant);
+        float TLeft = -DotProduct - SqrtDiscriminant;
+        float TRight = -DotProduct + SqrtDiscriminant;
+
+        for (int32 i = 0; i < LineIndex; i++)
+        {
+            const float Denominator = Det(Line.Direction, Lines[i].Direction);
+            const float Numerator = Det(Lines[i].Direction, Line.Point - Lines[i].Point);
+
+            // Proste rownolegle - albo cala prosta jest dozwolona, albo zadna jej czesc
+            if (FMath::Abs(Denominator) <= AvoidanceEpsilon)
+            {
+                if (Numerator < 0.0f)
+                {
+                    return false;
+                }
+                continue;
+            }
+
+            const float T = Numerator / Denominator;
+            if (Denominator >= 0.0f)
+            {
+                TRight = FMath::Min(TRight, T);
+            }
+            else
+            {
+                TLeft = FMath::Max(TLeft, T);
+            }
+
+            if (TLeft > TRight)
+            {
+                return false;
+            }
+        }
+
+        if (bDirectionOpt)
+        {
+            Result = Line.Point + ((OptVelocity | Line.Direction) > 0.0f ? TRight : TLeft) * Line.Direction;
+        }
+        else
+        {
+            const float T = FMath::Clamp(Line.Direction | (OptVelocity - Line.Point), TLeft, TRight);
+            Result = Line.Point + T * Line.Direction;
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Program liniowy 2D: predkosc najblizsza OptVelocity spelniajaca wszystkie ograniczenia.
+    /// </summary>
+    /// <returns>Indeks pierwszej prostej, ktorej nie dalo sie spelnic, lub LineCount</returns>
+    int32 SolveLinearProgram2(const FOrcaLine* Lines, int32 LineCount, float Radius, const FVector2D& OptVelocity,
+        bool bDirectionOpt, FVector2D& Result)
+    {
+        if (bDirectionOpt)
+        {
+            Result = OptVelocity * Radius;
+        }
+        else if (OptVelocity.SizeSquared() > Radius * Radius)
+        {
+            Result = OptVelocity.GetSafeNormal() * Radius;
+        }
+        else
+        {
+            Result = OptVelocity;
+        }
+
+        for (int32 i = 0; i < LineCount; i++)
+        {
+            if (Det(Lines[i].Direction, Lines[i].Point - Result) > 0.0f)
+            {
+                const FVector2D PreviousResult = Result;
+                if (!SolveOnLine(Lines, i, Radius, OptVelocity, bDirectionOpt, Result))
+                {
+                    Result = PreviousResult;
+                    return i;
+                }
+            }
+        }
+
+        return LineCount;
+    }
+
+    /// <summary>
+    /// Ograniczenia sprzeczne - minimalizacja najwiekszego naruszenia, zaczynajac od prostej BeginLine.
+    /// </summary>
+    void SolveLinearProgram3(const FOrcaLine* Lines, int32 LineCount, int32 BeginLine, float Radius, FVector2D& Result)
+    {
+        FOrcaLine ProjectedLines[FLocalAvoidance::MaxNeighbors];
+        float Distance = 0.0f;
+
+        for (int32 i = BeginLine; i < LineCount; i++)
+        {
+            if (Det(Lines[i].Direction, Lines[i].Point - Result) <= Distance)
+            {
+                continue;
+            }
+
+            int32 ProjectedCount = 0;
+            for (int32 j = 0; j < i; j++)
+            {
+                FOrcaLine Projected;
+                const float Determinant = Det(Lines[i].Direction, Lines[j].Direction);
+
+                if (FMath::Abs(Determinant) <= AvoidanceEpsilon)
+                {
+                    // Proste rownolegle o tym samym zwrocie
+                    if ((Lines[i].Direction | Lines[j].Direction) > 0.0f)
+                    {
+                        continue;
+                    }
+                    Projected.Point = 0.5f * (Lines[i].Point + Lines[j].Point);
+                }
+                else
+                {
+                    Projected.Point = Lines[i].Point
+                        + (Det(Lines[j].Direction, Lines[i].Point - Lines[j].Point) / Determinant) * Lines[i].Direction;
+                }
+
+                Projected.Direction = (Lines[j].Direction - Lines[i].Direction).GetSafeNormal();
+                ProjectedLines[ProjectedCount++] = Projected;
+            }
+
+            const FVector2D PreviousResult = Result;
+            const FVector2D OptDirection(-Lines[i].Direction.Y, Lines[i].Direction.X);
+            if (SolveLinearProgram2(ProjectedLines, ProjectedCount, Radius, OptDirection, true, Result) < ProjectedCount)
+            {
+                // Teoretycznie niemozliwe - blad numeryczny, zostaje poprzedni wynik
+                Result = PreviousResult;
+            }
+
+            Distance = Det(Lines[i].Direction, Lines[i].Point - Result);
+        }
+    }
+}
+
+void FAvoidanceSnapshot::Reset()
+{
+    PositionX.Reset();
+    PositionY.Reset();
+    VelocityX.Reset();
+    VelocityY.Reset();
+    PreferredX.Reset();
+    PreferredY.Reset();
+    MaxSpeed.Reset();
+    TeamID.Reset();
+    MegaCellIndex.Reset();
+    CellStart.Reset();
+    CellEntries.Reset();
+}
+
+/// <summary>
+/// Dodaje wpis jednostki. Mega-komorka jest liczona z pozycji - listy komorek tworzy BuildCellLists.
+/// </summary>
+/// <returns>Indeks wpisu</returns>
+int32 FAvoidanceSnapshot::AddEntry(const FVector2D& Position, const FVector2D& Velocity, const FVector2D& Preferred,
+    float InMaxSpeed, int32 InTeamID)
+{
+    PositionX.Add(Position.X);
+    PositionY.Add(Position.Y);
+    VelocityX.Add(Velocity.X);
+    VelocityY.Add(Velocity.Y);
+    PreferredX.Add(Preferred.X);
+    PreferredY.Add(Preferred.Y);
+    MaxSpeed.Add(InMaxSpeed);
+    TeamID.Add(InTeamID);
+    return MegaCellIndex.Add(ComputeMegaCellIndex(Position.X, Position.Y));
+}
+
+/// <summary>
+/// Buduje listy wpisow kazdej mega-komorki (sortowanie przez zliczanie, kolejnosc wpisow zachowana).
+/// </summary>
+void FAvoidanceSnapshot::BuildCellLists()
+{
+    const int32 NumCells = MegaGridWidth * MegaGridHeight;
+    CellStart.Init(0, NumCells + 1);
+
+    for (const int32 CellIndex : MegaCellIndex)
+    {
+        if (CellIndex >= 0 && CellIndex < NumCells)
+        {
+            CellStart[CellIndex + 1]++;
+        }
+    }
+
+    for (int32 CellIndex = 0; CellIndex < NumCells; CellIndex++)
+    {
+        CellStart[CellIndex + 1] += CellStart[CellIndex];
+    }
+
+    CellEntries.SetNumUninitialized(CellStart[NumCells]);
+    TArray<int32> WriteCursor(CellStart.GetData(), NumCells);
+
+    for (int32 EntryIndex = 0; EntryIndex < MegaCellIndex.Num(); EntryIndex++)
+    {
+        const int32 CellIndex = MegaCellIndex[EntryIndex];
+        if (CellIndex >= 0 && CellIndex < NumCells)
+        {
+            CellEntries[WriteCursor[CellIndex]++] = EntryIndex;
+        }
+    }
+}
+
+/// <summary>
+/// Indeks mega-komorki dla pozycji - te same obliczenia co USpatialGrid::GetMegaCellCoordinates.
+/// </summary>
+int32 FAvoidanceSnapshot::ComputeMegaCellIndex(float X, float Y) const
+{
+    if (MegaGridWidth <= 0 || MegaGridHeight <= 0 || MegaCellSize <= 0.0f)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 MegaCellX = FMath::Clamp(FMath::FloorToInt((X - WorldMin.X) / MegaCellSize), 0, MegaGridWidth - 1);
+    const int32 MegaCellY = FMath::Clamp(FMath::FloorToInt((Y - WorldMin.Y) / MegaCellSize), 0, MegaGridHeight - 1);
+    return MegaCellY * MegaGridWidth + MegaCellX;
+}
+
+/// <summary>
+/// Rozwiazanie ORCA dla jednego wpisu: wybor k najblizszych sojusznikow, polplaszczyzny ograniczen
+/// i program liniowy. Dane sasiadow sa najpierw kopiowane do tablic na stosie, wiec budowa
+/// ograniczen to jedna petla po ciaglych danych bez odwolan do migawki.
+/// </summary>
+/// <param name="Snapshot">Zamrozona migawka</param>
+/// <param name="Params">Parametry unikania</param>
+/// <param name="AgentIndex">Indeks wpisu</param>
+/// <returns>Predkosc bez kolizji najblizsza pozadanej (zero dla stojacych)</returns>
+FVector2D FLocalAvoidance::SolveAgent(const FAvoidanceSnapshot& Snapshot, const FAvoidanceParams& Params, int32 AgentIndex)
+{
+    if (AgentIndex < 0 || AgentIndex >= Snapshot.Num() || !Snapshot.IsMoving(AgentIndex))
+    {
+        return FVector2D::ZeroVector;
+    }
+
+    const float PosX = Snapshot.PositionX[AgentIndex];
+    const float PosY = Snapshot.PositionY[AgentIndex];
+    const FVector2D Velocity(Snapshot.VelocityX[AgentIndex], Snapshot.VelocityY[AgentIndex]);
+    const FVector2D Preferred(Snapshot.PreferredX[AgentIndex], Snapshot.PreferredY[AgentIndex]);
+    const float MaxSpeed = Snapshot.MaxSpeed[AgentIndex];
+    const int32 Team = Snapshot.TeamID[AgentIndex];
+
+    // Wybor k najblizszych sojusznikow (sortowanie przez wstawianie w stalej tablicy)
+    const int32 NeighborLimit = FMath::Clamp(Params.MaxNeighbors, 0, MaxNeighbors);
+    const float RangeSq = FMath::Square(Params.NeighborDistance);
+    int32 NeighborIndex[MaxNeighbors];
+    float NeighborDistSq[MaxNeighbors];
+    int32 NeighborCount = 0;
+
+    const int32 CenterCell = Snapshot.ComputeMegaCellIndex(PosX, PosY);
+    if (CenterCell != INDEX_NONE && NeighborLimit > 0 && Snapshot.CellStart.Num() > 0)
+    {
+        const int32 CenterX = CenterCell % Snapshot.MegaGridWidth;
+        const int32 CenterY = CenterCell / Snapshot.MegaGridWidth;
+        const int32 CellRadius = FMath::CeilToInt(Params.NeighborDistance / Snapshot.MegaCellSize);
+
+        for (int32 my = FMath::Max(CenterY - CellRadius, 0); my <= FMath::Min(CenterY + CellRadius, Snapshot.MegaGridHeight - 1); my++)
+        {
+            for (int32 mx = FMath::Max(CenterX - CellRadius, 0); mx <= FMath::Min(CenterX + CellRadius, Snapshot.MegaGridWidth - 1); mx++)
+            {
+                const int32 CellIndex = my * Snapshot.MegaGridWidth + mx;
+                for (int32 Slot = Snapshot.CellStart[CellIndex]; Slot < Snapshot.CellStart[CellIndex + 1]; Slot++)
+                {
+                    const int32 OtherIndex = Snapshot.CellEntries[Slot];
+                    if (OtherIndex == AgentIndex || Snapshot.TeamID[OtherIndex] != Team)
+                    {
+                        continue;
+                    }
+
+                    const float DistSq = FMath::Square(Snapshot.PositionX[OtherIndex] - PosX) + FMath::Square(Snapshot.PositionY[OtherIndex] - PosY);
+                    if (DistSq >= RangeSq || (NeighborCount == NeighborLimit && DistSq >= NeighborDistSq[NeighborCount - 1]))
+                    {
+                        continue;
+                    }
+
+                    int32 InsertAt = NeighborCount < NeighborLimit ? NeighborCount++ : NeighborCount - 1;
+                    while (InsertAt > 0 && NeighborDistSq[InsertAt - 1] > DistSq)
+                    {
+                        NeighborDistSq[InsertAt] = NeighborDistSq[InsertAt - 1];
+                        NeighborIndex[InsertAt] = NeighborIndex[InsertAt - 1];
+                        InsertAt--;
+                    }
+                    NeighborDistSq[InsertAt] = DistSq;
+                    NeighborIndex[InsertAt] = OtherIndex;
+                }
+            }
+        }
+    }
+
+    // Dane sasiadow kolumnami - wzgledna pozycja, wzgledna predkosc i udzial w ominieciu
+    float RelPosX[MaxNeighbors];
+    float RelPosY[MaxNeighbors];
+    float RelVelX[MaxNeighbors];
+    float RelVelY[MaxNeighbors];
+    float Responsibility[MaxNeighbors];
+
+    for (int32 n = 0; n < NeighborCount; n++)
+    {
+        const int32 OtherIndex = NeighborIndex[n];
+        RelPosX[n] = Snapshot.PositionX[OtherIndex] - PosX;
+        RelPosY[n] = Snapshot.PositionY[OtherIndex] - PosY;
+        RelVelX[n] = Velocity.X - Snapshot.VelocityX[OtherIndex];
+        RelVelY[n] = Velocity.Y - Snapshot.VelocityY[OtherIndex];
+        Responsibility[n] = Snapshot.IsMoving(OtherIndex) ? 0.5f : 1.0f;
+    }
+
+    // Polplaszczyzny ORCA - krok ruchu jest jednostka czasu
+    const float CombinedRadius = 2.0f * Params.AgentRadius;
+    const float CombinedRadiusSq = CombinedRadius * CombinedRadius;
+    const float InvTimeHorizon = 1.0f / FMath::Max(Params.TimeHorizon, 1.0f);
+
+    FOrcaLine Lines[MaxNeighbors];
+    for (int32 n = 0; n < NeighborCount; n++)
+    {
+        const FVector2D RelativePosition(RelPosX[n], RelPosY[n]);
+        const FVector2D RelativeVelocity(RelVelX[n], RelVelY[n]);
+        const float DistSq = RelativePosition.SizeSquared();
+        FVector2D U;
+
+        if (DistSq > CombinedRadiusSq)
+        {
+            // Brak kolizji - wektor od srodka odcietego stozka do wzglednej predkosci
+            const FVector2D W = RelativeVelocity - InvTimeHorizon * RelativePosition;
+            const float WLengthSq = W.SizeSquared();
+            const float DotProduct = W | RelativePosition;
+
+            if (DotProduct < 0.0f && DotProduct * DotProduct > CombinedRadiusSq * WLengthSq)
+            {
+                // Rzut na podstawe stozka
+                const float WLength = FMath::Sqrt(WLengthSq);
+                const FVector2D UnitW = W / WLength;
+                Lines[n].Direction = FVector2D(UnitW.Y, -UnitW.X);
+                U = (CombinedRadius * InvTimeHorizon - WLength) * UnitW;
+            }
+            else
+            {
+                // Rzut na ramie stozka
+                const float Leg = FMath::Sqrt(DistSq - CombinedRadiusSq);
+                if (Det(RelativePosition, W) > 0.0f)
+                {
+                    Lines[n].Direction = FVector2D(RelativePosition.X * Leg - RelativePosition.Y * CombinedRadius,
+                        RelativePosition.X * CombinedRadius + RelativePosition.Y * Leg) / DistSq;
+                }
+                else
+                {
+                    Lines[n].Direction = -FVector2D(RelativePosition.X * Leg + RelativePosition.Y * CombinedRadius,
+                        -RelativePosition.X * CombinedRadius + RelativePosition.Y * Leg) / DistSq;
+                }
+
+                U = (RelativeVelocity | Lines[n].Direction) * Lines[n].Direction - RelativeVelocity;
+            }
+        }
+        else
+        {
+            // Jednostki juz na siebie nachodza - rozsuniecie w ciagu jednego kroku
+            const FVector2D W = RelativeVelocity - RelativePosition;
+            const float WLength = W.Size();
+            FVector2D UnitW = WLength > AvoidanceEpsilon ? W / WLength : -RelativePosition.GetSafeNormal();
+            if (UnitW.IsNearlyZero())
+            {
+                // Ta sama pozycja i predkosc - kierunek rozsuniecia zalezny od kolejnosci wpisow
+                UnitW = FVector2D(AgentIndex < NeighborIndex[n] ? -1.0f : 1.0f, 0.0f);
+            }
+            Lines[n].Direction = FVector2D(UnitW.Y, -UnitW.X);
+            U = (CombinedRadius - WLength) * UnitW;
+        }
+
+        Lines[n].Point = Velocity + Responsibility[n] * U;
+    }
+
+    FVector2D Result;
+    const int32 FailedLine = SolveLinearProgram2(Lines, NeighborCount, MaxSpeed, Preferred, false, Result);
+    if (FailedLine < NeighborCount)
+    {
+        SolveLinearProgram3(Lines, NeighborCount, FailedLine, MaxSpeed, Result);
+    }
+
+    return Result;
+}
+
+/// <summary>
+/// Rozwiazanie dla wszystkich wpisow. Kazda iteracja zapisuje tylko wlasny element wyniku,
+/// wiec jednostki sa liczone rownolegle.
+/// </summary>
+/// <param name="Snapshot">Zamrozona migawka</param>
+/// <param name="Params">Parametry unikania</param>
+/// <param name="OutVelocities">Predkosc dla kazdego wpisu migawki</param>
+/// <param name="bParallel">false wymusza wykonanie na jednym watku</param>
+void FLocalAvoidance::ComputeVelocities(const FAvoidanceSnapshot& Snapshot, const FAvoidanceParams& Params,
+    TArray<FVector2D>& OutVelocities, bool bParallel)
+{
+    OutVelocities.Init(FVector2D::ZeroVector, Snapshot.Num());
+
+    ParallelFor(Snapshot.Num(), [&Snapshot, &Params, &OutVelocities](int32 EntryIndex)
+        {
+            OutVelocities[EntryIndex] = SolveAgent(Snapshot, Params, EntryIndex);
+        },
+        bParallel ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+}
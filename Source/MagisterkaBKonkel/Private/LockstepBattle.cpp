@@ -0,0 +1,250 @@
+// LockstepBattle.cpp - Implementacja sesji bitwy lockstep
+#include "LockstepBattle.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/// <summary>
+/// Rozpoczyna bitwe na serwerze i przygotowuje pakiet startowy.
+/// </summary>
+/// <param name="InSetup">Stan poczatkowy bitwy</param>
+/// <param name="Seed">Ziarno bitwy</param>
+/// <param name="InHashIntervalTicks">Co ile tickow wysylany jest skrot stanu</param>
+/// <param name="OutStartPacket">Pakiet startowy dla klientow</param>
+/// <returns>True jesli bitwa wystartowala</returns>
+bool FLockstepBattleSession::StartAuthority(const FBattleSimSetup& InSetup, uint32 Seed, int32 InHashIntervalTicks, TArray<uint8>& OutStartPacket)
+{
+    Stop();
+
+    Battle = FBattleReplay();
+    Battle.Setup = InSetup;
+    Battle.Setup.MathMode = EBattleSimMath::FixedPoint;
+    Battle.Seed = Seed;
+
+    if (!Battle.SaveToBytes(OutStartPacket))
+    {
+        return false;
+    }
+
+    HashIntervalTicks = FMath::Max(InHashIntervalTicks, 1);
+    bAuthority = true;
+    bActive = true;
+    Battle.StartPlayback(State);
+    return true;
+}
+
+/// <summary>
+/// Rozpoczyna bitwe na kliencie z pakietu startowego serwera.
+/// </summary>
+/// <param name="StartPacket">Pakiet startowy</param>
+/// <param name="InHashIntervalTicks">Co ile tickow serwer wysyla skrot</param>
+/// <returns>False jesli pakiet jest uszkodzony lub pochodzi z innej wersji symulacji</returns>
+bool FLockstepBattleSession::StartFromPacket(const TArray<uint8>& StartPacket, int32 InHashIntervalTicks)
+{
+    Stop();
+
+    Battle = FBattleReplay();
+    if (!Battle.LoadFromBytes(StartPacket) || Battle.SimVersion != FBattleReplay::CurrentSimVersion)
+    {
+        return false;
+    }
+
+    HashIntervalTicks = FMath::Max(InHashIntervalTicks, 1);
+    bAuthority = false;
+    bActive = true;
+    Battle.StartPlayback(State);
+    return true;
+}
+
+void FLockstepBattleSession::Stop()
+{
+    bActive = false;
+    TimeAccumulator = 0.0f;
+    bDesyncDetected = false;
+    DesyncTick = INDEX_NONE;
+    ResyncCount = 0;
+    LocalHashes.Reset();
+    PendingAuthorityHashes.Reset();
+}
+
+/// <summary>
+/// Przesuwa symulacje o DeltaSeconds (pelne ticki z akumulacja reszty).
+/// </summary>
+/// <param name="DeltaSeconds">Czas do zasymulowania</param>
+/// <param name="OutHashes">Serwer: skroty do rozeslania; klient: bez zmian</param>
+/// <returns>Liczba wykonanych tickow</returns>
+int32 FLockstepBattleSession::Advance(float DeltaSeconds, TArray<FLockstepHash>& OutHashes)
+{
+    if (!bActive)
+    {
+        return 0;
+    }
+
+    TimeAccumulator += FMath::Max(DeltaSeconds, 0.0f);
+    const float TickSeconds = FMath::Max(Battle.Setup.TickSeconds, KINDA_SMALL_NUMBER);
+
+    // Ticki wykonywane pojedynczo, zeby zaden tick z siatki interwalu skrotow nie zostal pominiety
+    int32 StepsTaken = 0;
+    while (TimeAccumulator >= TickSeconds && !State.IsFinished())
+    {
+        TimeAccumulator -= TickSeconds;
+        State.Step();
+        StepsTaken++;
+
+        if (State.GetTickCount() % HashIntervalTicks == 0 || State.IsFinished())
+        {
+            if (bAuthority)
+            {
+                OutHashes.Add({ State.GetTickCount(), State.ComputeStateHash() });
+            }
+            else
+            {
+                RecordLocalHash();
+            }
+        }
+    }
+
+    return StepsTaken;
+}
+
+/// <summary>
+/// Klient: wykonuje brakujace ticki do podanego ticku serwera.
+/// </summary>
+/// <param name="Tick">Tick serwera</param>
+void FLockstepBattleSession::CatchUpToTick(int32 Tick)
+{
+    TArray<FLockstepHash> IgnoredHashes;
+    while (bActive && State.GetTickCount() < Tick && !State.IsFinished())
+    {
+        Advance(FMath::Max(Battle.Setup.TickSeconds, KINDA_SMALL_NUMBER), IgnoredHashes);
+    }
+}
+
+/// <summary>
+/// Klient: zapisuje wlasny skrot i porownuje go ze skrotem serwera, jesli ten juz dotarl.
+/// </summary>
+void FLockstepBattleSession::RecordLocalHash()
+{
+    const int32 Tick = State.GetTickCount();
+    const uint32 LocalHash = State.ComputeStateHash();
+    LocalHashes.Add(Tick, LocalHash);
+
+    if (const uint32* AuthorityHash = PendingAuthorityHashes.Find(Tick))
+    {
+        CompareHash(Tick, LocalHash, *AuthorityHash);
+        PendingAuthorityHashes.Remove(Tick);
+    }
+
+    // Starsze skroty nie beda juz porownywane
+    const int32 OldestRetainedTick = Tick - HashIntervalTicks * MaxRetainedHashes;
+    for (auto It = LocalHashes.CreateIterator(); It; ++It)
+    {
+        if (It.Key() < OldestRetainedTick)
+        {
+            It.RemoveCurrent();
+        }
+    }
+}
+
+/// <summary>
+/// Klient: przyjmuje skrot serwera.
+/// </summary>
+/// <param name="Tick">Tick, po ktorym liczono skrot</param>
+/// <param name="Hash">Skrot stanu serwera</param>
+void FLockstepBattleSession::ReceiveAuthorityHash(int32 Tick, uint32 Hash)
+{
+    if (!bActive || bAuthority)
+    {
+        return;
+    }
+
+    if (const uint32* LocalHash = LocalHashes.Find(Tick))
+    {
+        CompareHash(Tick, *LocalHash, Hash);
+    }
+    else if (Tick > State.GetTickCount())
+    {
+        // Klient jeszcze nie doszedl do tego ticku
+        PendingAuthorityHashes.Add(Tick, Hash);
+    }
+}
+
+void FLockstepBattleSession::CompareHash(int32 Tick, uint32 LocalHash, uint32 AuthorityHash)
+{
+    if (LocalHash != AuthorityHash && !bDesyncDetected)
+    {
+        bDesyncDetected = true;
+        DesyncTick = Tick;
+    }
+}
+
+/// <summary>
+/// Serwer: pelna migawka stanu bitwy do resynchronizacji klienta.
+/// </summary>
+/// <param name="OutBytes">Zserializowana migawka</param>
+/// <returns>True jesli zapis sie powiodl</returns>
+bool FLockstepBattleSession::SaveSnapshot(TArray<uint8>& OutBytes) const
+{
+    if (!bActive)
+    {
+        return false;
+    }
+
+    OutBytes.Reset();
+    FMemoryWriter Writer(OutBytes);
+
+    // Ziarno identyfikuje bitwe - migawka z innej bitwy jest odrzucana
+    uint32 Seed = Battle.Seed;
+    Writer << Seed;
+    const_cast<FBattleSimState&>(State).SerializeSnapshot(Writer);
+    return !Writer.IsError();
+}
+
+/// <summary>
+/// Klient: zastepuje lokalny stan migawka serwera i kasuje wykryta rozbieznosc.
+/// </summary>
+/// <param name="Bytes">Migawka serwera</param>
+/// <returns>True jesli migawka pasuje do tej bitwy</returns>
+bool FLockstepBattleSession::ApplySnapshot(const TArray<uint8>& Bytes)
+{
+    if (!bActive)
+    {
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+    uint32 Seed = 0;
+    Reader << Seed;
+    if (Reader.IsError() || Seed != Battle.Seed)
+    {
+        return false;
+    }
+
+    State.SerializeSnapshot(Reader);
+    if (Reader.IsError())
+    {
+        return false;
+    }
+
+    // Skroty sprzed migawki opisuja porzucony stan
+    const int32 SnapshotTick = State.GetTickCount();
+    for (auto It = LocalHashes.CreateIterator(); It; ++It)
+    {
+        if (It.Key() <= SnapshotTick)
+        {
+            It.RemoveCurrent();
+        }
+    }
+    for (auto It = PendingAuthorityHashes.CreateIterator(); It; ++It)
+    {
+        if (It.Key() <= SnapshotTick)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    TimeAccumulator = 0.0f;
+    bDesyncDetected = false;
+    DesyncTick = INDEX_NONE;
+    ResyncCount++;
+    return true;
+}
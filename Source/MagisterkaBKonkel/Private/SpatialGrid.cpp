@@ -1,8 +1,12 @@
 // SpatialGrid.cpp - Implementacja hierarchicznego systemu podzialu przestrzennego
 #include "SpatialGrid.h"
 #include "BaseUnit.h"
+#include "UnitArchetype.h"
 #include "Engine/Engine.h"
 #include "DrawDebugHelpers.h"
+#include "LocalAvoidance.h"
+#include "BattleSquads.h"
+#include "Async/ParallelFor.h"
 
 USpatialGrid::USpatialGrid()
 {
@@ -144,7 +148,7 @@ void USpatialGrid::AddUnit(ABaseUnit* Unit)
     }
 
     FVector UnitPosition = Unit->GetActorLocation();
-    FVector2D MegaCellCoords = GetMegaCellCoordinates(UnitPosition);
+    const FGridCell MegaCellCoords = GetMegaCellCoordinates(UnitPosition);
 
     if (!IsValidMegaCellCoordinate(MegaCellCoords.X, MegaCellCoords.Y))
     {
@@ -158,11 +162,12 @@ void USpatialGrid::AddUnit(ABaseUnit* Unit)
     {
         MegaCell->AddUnit(Unit);
         UnitToMegaCellMap.Add(Unit, MegaCellCoords);
+        WakeSleepingWatchers(*MegaCell, Unit);
 
-        FVector2D BaseGridCoords = GetBaseGridCoordinates(UnitPosition);
+        const FGridCell BaseGridCoords = GetBaseGridCoordinates(UnitPosition);
         UE_LOG(LogTemp, Warning, TEXT("=== SPATIAL GRID: Dodano jednostk %s do mega-komorki (%d,%d) [siatka bazowa: (%d,%d)] - Mega-komorka ma teraz %d jednostek ==="),
-            *Unit->GetName(), (int32)MegaCellCoords.X, (int32)MegaCellCoords.Y,
-            (int32)BaseGridCoords.X, (int32)BaseGridCoords.Y, MegaCell->GetUnitCount());
+            *Unit->GetName(), MegaCellCoords.X, MegaCellCoords.Y,
+            BaseGridCoords.X, BaseGridCoords.Y, MegaCell->GetUnitCount());
     }
 }
 
@@ -177,21 +182,24 @@ void USpatialGrid::RemoveUnit(ABaseUnit* Unit)
         return;
     }
 
-    FVector2D* MegaCellCoords = UnitToMegaCellMap.Find(Unit);
+    ClearSleepInterest(Unit);
+
+    const FGridCell* MegaCellCoords = UnitToMegaCellMap.Find(Unit);
     if (!MegaCellCoords)
     {
         UE_LOG(LogTemp, Warning, TEXT("=== SPATIAL GRID: Jednostka %s nie zostala znaleziona w sledzeniu siatki ==="), *Unit->GetName());
         return;
     }
 
-    FSpatialCell* MegaCell = GetMegaCell(MegaCellCoords->X, MegaCellCoords->Y);
+    const FGridCell RemovedMegaCellCoords = *MegaCellCoords;
+    FSpatialCell* MegaCell = GetMegaCell(RemovedMegaCellCoords.X, RemovedMegaCellCoords.Y);
     if (MegaCell)
     {
         MegaCell->RemoveUnit(Unit);
         UnitToMegaCellMap.Remove(Unit);
 
         UE_LOG(LogTemp, Warning, TEXT("=== SPATIAL GRID: Usunito jednostk %s z mega-komorki (%d,%d) - Mega-komorka ma teraz %d jednostek ==="),
-            *Unit->GetName(), (int32)MegaCellCoords->X, (int32)MegaCellCoords->Y, MegaCell->GetUnitCount());
+            *Unit->GetName(), RemovedMegaCellCoords.X, RemovedMegaCellCoords.Y, MegaCell->GetUnitCount());
     }
 }
 
@@ -210,18 +218,18 @@ void USpatialGrid::UpdateUnitPosition(ABaseUnit* Unit, FVector OldPosition, FVec
     }
 
     // Obliczanie starych i nowych wspolrzdnych mega-komorki
-    FVector2D OldMegaCellCoords = GetMegaCellCoordinates(OldPosition);
-    FVector2D NewMegaCellCoords = GetMegaCellCoordinates(NewPosition);
+    const FGridCell OldMegaCellCoords = GetMegaCellCoordinates(OldPosition);
+    const FGridCell NewMegaCellCoords = GetMegaCellCoordinates(NewPosition);
 
     // Jesli jednostka nie zmienila mega-komorki, aktualizacja nie jest potrzebna
-    if (OldMegaCellCoords.Equals(NewMegaCellCoords, 0.1f))
+    if (OldMegaCellCoords == NewMegaCellCoords)
     {
         return;
     }
 
     UE_LOG(LogTemp, Warning, TEXT("=== SPATIAL GRID: Jednostka %s przesunla si z mega-komorki (%d,%d) do (%d,%d) ==="),
-        *Unit->GetName(), (int32)OldMegaCellCoords.X, (int32)OldMegaCellCoords.Y,
-        (int32)NewMegaCellCoords.X, (int32)NewMegaCellCoords.Y);
+        *Unit->GetName(), OldMegaCellCoords.X, OldMegaCellCoords.Y,
+        NewMegaCellCoords.X, NewMegaCellCoords.Y);
 
     // Usunicie ze starej mega-komorki
     if (IsValidMegaCellCoordinate(OldMegaCellCoords.X, OldMegaCellCoords.Y))
@@ -241,6 +249,7 @@ void USpatialGrid::UpdateUnitPosition(ABaseUnit* Unit, FVector OldPosition, FVec
         {
             NewMegaCell->AddUnit(Unit);
             UnitToMegaCellMap.Add(Unit, NewMegaCellCoords);
+            WakeSleepingWatchers(*NewMegaCell, Unit);
         }
     }
     else
@@ -269,7 +278,7 @@ TArray<ABaseUnit*> USpatialGrid::GetUnitsInRange(FVector Position, float Range)
     }
 
     // Obliczanie ktore mega-komorki sprawdzi na podstawie zasigu
-    FVector2D CenterMegaCell = GetMegaCellCoordinates(Position);
+    const FGridCell CenterMegaCell = GetMegaCellCoordinates(Position);
     int32 MegaCellRadius = FMath::CeilToInt(Range / MegaCellSize) + 1; // Dodanie 1 dla marginesu bezpieczenstwa
 
     // Sprawdzanie wszystkich mega-komorek w promieniu
@@ -348,7 +357,7 @@ TArray<ABaseUnit*> USpatialGrid::GetUnitsInBaseGridCell(int32 BaseGridX, int32 B
     }
 
     // Znalezienie mega-komorki zawierajacej t komork bazowa
-    FVector2D MegaCellCoords = BaseGridToMegaCell(BaseGridX, BaseGridY);
+    const FGridCell MegaCellCoords = BaseGridToMegaCell(BaseGridX, BaseGridY);
     const FSpatialCell* MegaCell = GetMegaCell(MegaCellCoords.X, MegaCellCoords.Y);
 
     if (!MegaCell)
@@ -455,6 +464,275 @@ ABaseUnit* USpatialGrid::FindNearestEnemy(ABaseUnit* Unit, float MaxRange) const
     return NearestEnemy;
 }
 
+/// <summary>
+/// Buduje listy jednostek dla kazdej mega-komorki na podstawie MegaCellIndex wpisow.
+/// Sortowanie przez zliczanie jest stabilne - kolejnosc w komorce odpowiada kolejnosci wpisow.
+/// </summary>
+void FTargetAcquisitionSnapshot::BuildCellLists()
+{
+    const int32 NumCells = MegaGridWidth * MegaGridHeight;
+    CellStart.Init(0, NumCells + 1);
+
+    for (const FTargetSnapshotEntry& Entry : Entries)
+    {
+        if (Entry.MegaCellIndex >= 0 && Entry.MegaCellIndex < NumCells)
+        {
+            CellStart[Entry.MegaCellIndex + 1]++;
+        }
+    }
+
+    for (int32 CellIndex = 0; CellIndex < NumCells; CellIndex++)
+    {
+        CellStart[CellIndex + 1] += CellStart[CellIndex];
+    }
+
+    CellEntries.SetNumUninitialized(CellStart[NumCells]);
+    TArray<int32> WriteCursor(CellStart.GetData(), NumCells);
+
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+    {
+        const int32 CellIndex = Entries[EntryIndex].MegaCellIndex;
+        if (CellIndex >= 0 && CellIndex < NumCells)
+        {
+            CellEntries[WriteCursor[CellIndex]++] = EntryIndex;
+        }
+    }
+}
+
+/// <summary>
+/// Oblicza indeks mega-komorki dla pozycji - te same obliczenia co GetMegaCellCoordinates.
+/// </summary>
+/// <param name="Position">Pozycja w przestrzeni swiata</param>
+/// <returns>Indeks mega-komorki lub INDEX_NONE jesli migawka nie ma siatki</returns>
+int32 FTargetAcquisitionSnapshot::ComputeMegaCellIndex(const FVector& Position) const
+{
+    if (MegaGridWidth <= 0 || MegaGridHeight <= 0 || MegaCellSize <= 0.0f)
+    {
+        return INDEX_NONE;
+    }
+
+    const FVector2D RelativePos = FVector2D(Position.X, Position.Y) - WorldMin;
+    const int32 MegaCellX = FMath::Clamp(FMath::FloorToInt(RelativePos.X / MegaCellSize), 0, MegaGridWidth - 1);
+    const int32 MegaCellY = FMath::Clamp(FMath::FloorToInt(RelativePos.Y / MegaCellSize), 0, MegaGridHeight - 1);
+
+    return MegaCellY * MegaGridWidth + MegaCellX;
+}
+
+/// <summary>
+/// Odpowiednik USpatialGrid::FindNearestEnemy dzialajacy wylacznie na danych migawki.
+/// Zachowuje kolejnosc przegladania mega-komorek i jednostek, wiec remisy sa rozstrzygane identycznie.
+/// Nie modyfikuje stanu - bezpieczny do wywolania z wielu watkow jednoczesnie.
+/// </summary>
+/// <param name="SeekerIndex">Indeks wpisu jednostki szukajacej celu</param>
+/// <returns>Indeks wpisu najblizszego wroga lub INDEX_NONE</returns>
+int32 FTargetAcquisitionSnapshot::FindNearestEnemy(int32 SeekerIndex) const
+{
+    if (!Entries.IsValidIndex(SeekerIndex) || CellStart.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    const FTargetSnapshotEntry& Seeker = Entries[SeekerIndex];
+    const float Range = Seeker.SearchRange;
+    if (!Seeker.bIsAlive || Range <= 0)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 CenterCellIndex = ComputeMegaCellIndex(Seeker.Position);
+    const int32 CenterX = CenterCellIndex % MegaGridWidth;
+    const int32 CenterY = CenterCellIndex / MegaGridWidth;
+    const int32 MegaCellRadius = FMath::CeilToInt(Range / MegaCellSize) + 1;
+
+    int32 NearestIndex = INDEX_NONE;
+    float NearestDistance = Range + 1.0f;
+
+    // Ta sama kolejnosc petli co w GetUnitsInRange (najpierw X, potem Y)
+    for (int32 mx = CenterX - MegaCellRadius; mx <= CenterX + MegaCellRadius; mx++)
+    {
+        for (int32 my = CenterY - MegaCellRadius; my <= CenterY + MegaCellRadius; my++)
+        {
+            if (mx < 0 || mx >= MegaGridWidth || my < 0 || my >= MegaGridHeight)
+            {
+                continue;
+            }
+
+            const int32 CellIndex = my * MegaGridWidth + mx;
+            for (int32 Slot = CellStart[CellIndex]; Slot < CellStart[CellIndex + 1]; Slot++)
+            {
+                const int32 CandidateIndex = CellEntries[Slot];
+                const FTargetSnapshotEntry& Candidate = Entries[CandidateIndex];
+
+                if (CandidateIndex == SeekerIndex || !Candidate.bIsAlive || Candidate.TeamID == Seeker.TeamID)
+                {
+                    continue;
+                }
+
+                const float Distance = FVector::Dist(Seeker.Position, Candidate.Position);
+                if (Distance <= Range && Distance < NearestDistance)
+                {
+                    NearestDistance = Distance;
+                    NearestIndex = CandidateIndex;
+                }
+            }
+        }
+    }
+
+    return NearestIndex;
+}
+
+/// <summary>
+/// Tworzy zamrozona migawk pozycji, druzyn i stanu jednostek z siatki.
+/// Wpisy sa dodawane w kolejnosci MegaCells, a stabilne BuildCellLists zachowuje te kolejnosc w komorkach.
+/// </summary>
+/// <param name="Seekers">Jednostki, dla ktorych zostanie wyznaczony cel</param>
+/// <param name="OutSnapshot">Wynikowa migawka</param>
+/// <param name="OutUnits">Jednostka odpowiadajaca kazdemu wpisowi migawki</param>
+/// <param name="OutSeekerIndices">Indeks wpisu dla kazdej jednostki z Seekers (INDEX_NONE dla nullptr)</param>
+void USpatialGrid::BuildTargetSnapshot(const TArray<ABaseUnit*>& Seekers, FTargetAcquisitionSnapshot& OutSnapshot,
+    TArray<ABaseUnit*>& OutUnits, TArray<int32>& OutSeekerIndices) const
+{
+    OutSnapshot.WorldMin = WorldMin;
+    OutSnapshot.MegaCellSize = MegaCellSize;
+    OutSnapshot.MegaGridWidth = MegaGridWidth;
+    OutSnapshot.MegaGridHeight = MegaGridHeight;
+    OutSnapshot.Entries.Reset();
+
+    OutUnits.Reset();
+    OutSeekerIndices.Reset(Seekers.Num());
+
+    TMap<ABaseUnit*, int32> UnitToEntryIndex;
+    UnitToEntryIndex.Reserve(Seekers.Num());
+
+    auto AddEntry = [&OutSnapshot, &OutUnits, &UnitToEntryIndex](ABaseUnit* Unit, int32 CellIndex) -> int32
+    {
+        if (const int32* ExistingIndex = UnitToEntryIndex.Find(Unit))
+        {
+            return *ExistingIndex;
+        }
+
+        FTargetSnapshotEntry& Entry = OutSnapshot.Entries.AddDefaulted_GetRef();
+        Entry.Position = Unit->GetActorLocation();
+        Entry.SearchRange = Unit->GetArchetype()->SearchRange;
+        Entry.TeamID = Unit->TeamID;
+        Entry.MegaCellIndex = CellIndex;
+        Entry.bIsAlive = Unit->bIsAlive;
+
+        const int32 EntryIndex = OutUnits.Add(Unit);
+        UnitToEntryIndex.Add(Unit, EntryIndex);
+        return EntryIndex;
+    };
+
+    // Wpisy w tej samej kolejnosci co FSpatialCell::Units
+    for (int32 CellIndex = 0; CellIndex < MegaCells.Num(); CellIndex++)
+    {
+        for (ABaseUnit* Unit : MegaCells[CellIndex].Units)
+        {
+            if (Unit)
+            {
+                AddEntry(Unit, CellIndex);
+            }
+        }
+    }
+
+    // Jednostki spoza siatki moga szukac celu, ale same nie sa kandydatami
+    for (ABaseUnit* Seeker : Seekers)
+    {
+        if (!Seeker)
+        {
+            OutSeekerIndices.Add(INDEX_NONE);
+            continue;
+        }
+
+        const int32 EntryIndex = AddEntry(Seeker, INDEX_NONE);
+        OutSnapshot.Entries[EntryIndex].bNeedsTarget = Seeker->bIsAlive && Seeker->bAutoCombatEnabled && !Seeker->bCombatSleeping
+            && !Seeker->HasValidTarget();
+        OutSeekerIndices.Add(EntryIndex);
+    }
+
+    OutSnapshot.BuildCellLists();
+}
+
+/// <summary>
+/// Faza decyzji wyszukiwania celow. Kazda jednostka zapisuje tylko wlasny element tablicy wynikowej,
+/// wiec iteracje sa niezalezne i moga byc wykonywane rownolegle.
+/// </summary>
+/// <param name="Snapshot">Zamrozona migawka jednostek</param>
+/// <param name="OutProposedTargets">Proponowany cel (indeks wpisu) dla kazdego wpisu migawki</param>
+/// <param name="bParallel">false wymusza wykonanie na jednym watku (sciezka referencyjna)</param>
+void USpatialGrid::DecideNearestEnemies(const FTargetAcquisitionSnapshot& Snapshot, TArray<int32>& OutProposedTargets, bool bParallel)
+{
+    OutProposedTargets.Init(INDEX_NONE, Snapshot.Entries.Num());
+
+    ParallelFor(Snapshot.Entries.Num(), [&Snapshot, &OutProposedTargets](int32 EntryIndex)
+        {
+            if (Snapshot.Entries[EntryIndex].bNeedsTarget)
+            {
+                OutProposedTargets[EntryIndex] = Snapshot.FindNearestEnemy(EntryIndex);
+            }
+        },
+        bParallel ? EParallelForFlags::Unbalanced : EParallelForFlags::ForceSingleThread);
+}
+
+/// <summary>
+/// Tworzy kolumnowa migawk zywych jednostek z siatki dla unikania kolizji ORCA.
+/// </summary>
+/// <param name="OutSnapshot">Wynikowa migawka (bufory sa uzywane ponownie)</param>
+/// <param name="OutUnits">Jednostka odpowiadajaca kazdemu wpisowi migawki</param>
+void USpatialGrid::BuildAvoidanceSnapshot(FAvoidanceSnapshot& OutSnapshot, TArray<ABaseUnit*>& OutUnits) const
+{
+    OutSnapshot.Reset();
+    OutSnapshot.WorldMin = WorldMin;
+    OutSnapshot.MegaCellSize = MegaCellSize;
+    OutSnapshot.MegaGridWidth = MegaGridWidth;
+    OutSnapshot.MegaGridHeight = MegaGridHeight;
+    OutUnits.Reset();
+
+    for (const FSpatialCell& MegaCell : MegaCells)
+    {
+        for (ABaseUnit* Unit : MegaCell.Units)
+        {
+            if (Unit && Unit->bIsAlive)
+            {
+                const FVector Position = Unit->GetActorLocation();
+                OutSnapshot.AddEntry(FVector2D(Position.X, Position.Y), Unit->GetAvoidanceVelocity(),
+                    Unit->GetPreferredVelocity(), Unit->GetArchetype()->Speed, Unit->TeamID);
+                OutUnits.Add(Unit);
+            }
+        }
+    }
+
+    OutSnapshot.BuildCellLists();
+}
+
+/// <summary>
+/// Zbiera zywe jednostki z mega-komorek siatki jako wejscia planowania oddzialow.
+/// </summary>
+/// <param name="OutInputs">Pozycje, druzyny i klucze jednostek (bufor jest uzywany ponownie)</param>
+/// <param name="OutUnits">Jednostka odpowiadajaca kazdemu wejsciu</param>
+void USpatialGrid::BuildSquadInputs(TArray<FSquadMemberInput>& OutInputs, TArray<ABaseUnit*>& OutUnits) const
+{
+    OutInputs.Reset();
+    OutUnits.Reset();
+
+    for (const FSpatialCell& MegaCell : MegaCells)
+    {
+        for (ABaseUnit* Unit : MegaCell.Units)
+        {
+            if (Unit && Unit->bIsAlive && Unit->bAutoCombatEnabled)
+            {
+                const FVector Position = Unit->GetActorLocation();
+
+                FSquadMemberInput& Input = OutInputs.AddDefaulted_GetRef();
+                Input.Position = FVector2D(Position.X, Position.Y);
+                Input.TeamID = Unit->TeamID;
+                Input.Key = Unit->GetUniqueID();
+                OutUnits.Add(Unit);
+            }
+        }
+    }
+}
+
 /// <summary>
 /// Obsluguje walki w okreslonej mega-komorce oraz z sasiednimi mega-komorkami.
 /// Sprawdza wszystkie mozliwe pary jednostek wrogich w zasigu ataku.
@@ -477,10 +755,10 @@ void USpatialGrid::HandleCombatInMegaCell(int32 MegaCellX, int32 MegaCellY)
     HandleCombatInMegaCellInternal(MegaCell);
 
     // Sprawdzanie rowniez sasiednich mega-komorek dla walk midzykomorkowych
-    TArray<FVector2D> NeighborCoords;
+    TArray<FGridCell> NeighborCoords;
     GetNeighboringMegaCells(MegaCellX, MegaCellY, NeighborCoords);
 
-    for (const FVector2D& NeighborCoord : NeighborCoords)
+    for (const FGridCell& NeighborCoord : NeighborCoords)
     {
         if (IsValidMegaCellCoordinate(NeighborCoord.X, NeighborCoord.Y))
         {
@@ -499,7 +777,7 @@ void USpatialGrid::HandleCombatInMegaCell(int32 MegaCellX, int32 MegaCellY)
                             {
                                 float Distance = FVector::Dist(Unit->GetActorLocation(),
                                     NeighborUnit->GetActorLocation());
-                                if (Distance <= Unit->AttackRange)
+                                if (Distance <= Unit->GetArchetype()->AttackRange)
                                 {
                                     if (Unit->CanAttackTarget(NeighborUnit))
                                     {
@@ -565,13 +843,13 @@ void USpatialGrid::HandleCombatInMegaCellInternal(FSpatialCell* MegaCell)
             float Distance = FVector::Dist(Unit->GetActorLocation(), OtherUnit->GetActorLocation());
 
             // Sprawdzanie czy Unit moze zaatakowa OtherUnit
-            if (Distance <= Unit->AttackRange && Unit->CanAttackTarget(OtherUnit))
+            if (Distance <= Unit->GetArchetype()->AttackRange && Unit->CanAttackTarget(OtherUnit))
             {
                 Unit->PerformAttack(OtherUnit);
             }
 
             // Sprawdzanie czy OtherUnit moze zaatakowa Unit (sprawdzanie odwrotne)
-            if (Distance <= OtherUnit->AttackRange && OtherUnit->CanAttackTarget(Unit))
+            if (Distance <= OtherUnit->GetArchetype()->AttackRange && OtherUnit->CanAttackTarget(Unit))
             {
                 OtherUnit->PerformAttack(Unit);
             }
@@ -584,7 +862,7 @@ void USpatialGrid::HandleCombatInMegaCellInternal(FSpatialCell* MegaCell)
 /// </summary>
 /// <param name="WorldPosition">Pozycja 3D w przestrzeni swiata</param>
 /// <returns>Wspolrzdne 2D mega-komorki (X, Y)</returns>
-FVector2D USpatialGrid::GetMegaCellCoordinates(FVector WorldPosition) const
+FGridCell USpatialGrid::GetMegaCellCoordinates(FVector WorldPosition) const
 {
     FVector2D Position2D(WorldPosition.X, WorldPosition.Y);
     FVector2D RelativePos = Position2D - WorldMin;
@@ -596,7 +874,7 @@ FVector2D USpatialGrid::GetMegaCellCoordinates(FVector WorldPosition) const
     MegaCellX = FMath::Clamp(MegaCellX, 0, MegaGridWidth - 1);
     MegaCellY = FMath::Clamp(MegaCellY, 0, MegaGridHeight - 1);
 
-    return FVector2D(MegaCellX, MegaCellY);
+    return FGridCell(MegaCellX, MegaCellY);
 }
 
 /// <summary>
@@ -604,7 +882,7 @@ FVector2D USpatialGrid::GetMegaCellCoordinates(FVector WorldPosition) const
 /// </summary>
 /// <param name="WorldPosition">Pozycja 3D w przestrzeni swiata</param>
 /// <returns>Wspolrzdne 2D komorki bazowej (X, Y)</returns>
-FVector2D USpatialGrid::GetBaseGridCoordinates(FVector WorldPosition) const
+FGridCell USpatialGrid::GetBaseGridCoordinates(FVector WorldPosition) const
 {
     FVector2D Position2D(WorldPosition.X, WorldPosition.Y);
     FVector2D RelativePos = Position2D - WorldMin;
@@ -616,7 +894,7 @@ FVector2D USpatialGrid::GetBaseGridCoordinates(FVector WorldPosition) const
     BaseGridX = FMath::Clamp(BaseGridX, 0, BaseGridWidth - 1);
     BaseGridY = FMath::Clamp(BaseGridY, 0, BaseGridHeight - 1);
 
-    return FVector2D(BaseGridX, BaseGridY);
+    return FGridCell(BaseGridX, BaseGridY);
 }
 
 /// <summary>
@@ -625,7 +903,7 @@ FVector2D USpatialGrid::GetBaseGridCoordinates(FVector WorldPosition) const
 /// <param name="BaseGridX">Wspolrzdna X komorki bazowej</param>
 /// <param name="BaseGridY">Wspolrzdna Y komorki bazowej</param>
 /// <returns>Wspolrzdne 2D mega-komorki zawierajacej dana komork bazowa</returns>
-FVector2D USpatialGrid::BaseGridToMegaCell(int32 BaseGridX, int32 BaseGridY) const
+FGridCell USpatialGrid::BaseGridToMegaCell(int32 BaseGridX, int32 BaseGridY) const
 {
     int32 MegaCellX = BaseGridX / MegaCellsPerDimension;
     int32 MegaCellY = BaseGridY / MegaCellsPerDimension;
@@ -634,7 +912,7 @@ FVector2D USpatialGrid::BaseGridToMegaCell(int32 BaseGridX, int32 BaseGridY) con
     MegaCellX = FMath::Clamp(MegaCellX, 0, MegaGridWidth - 1);
     MegaCellY = FMath::Clamp(MegaCellY, 0, MegaGridHeight - 1);
 
-    return FVector2D(MegaCellX, MegaCellY);
+    return FGridCell(MegaCellX, MegaCellY);
 }
 
 /// <summary>
@@ -915,26 +1193,26 @@ const FSpatialCell* USpatialGrid::GetMegaCell(int32 MegaCellX, int32 MegaCellY)
 /// <param name="MegaCellX">Wspolrzdna X centralnej mega-komorki</param>
 /// <param name="MegaCellY">Wspolrzdna Y centralnej mega-komorki</param>
 /// <param name="NeighborCoords">Tablica wyjsciowa zawierajaca wspolrzdne sasiadow</param>
-void USpatialGrid::GetNeighboringMegaCells(int32 MegaCellX, int32 MegaCellY, TArray<FVector2D>& NeighborCoords) const
+void USpatialGrid::GetNeighboringMegaCells(int32 MegaCellX, int32 MegaCellY, TArray<FGridCell>& NeighborCoords) const
 {
     NeighborCoords.Empty();
 
     // Sprawdzanie 4 przyleglych mega-komorek (bez przekatnych) aby unikna duplikatow sprawdzen
-    const TArray<FVector2D> Directions = {
-        FVector2D(-1, -1),  // Lewy gorny
-        FVector2D(-1, 0),   // Lewy
-        FVector2D(0, -1),   // Gorny
-        FVector2D(-1, 1)    // Lewy dolny
+    static const FGridCell Directions[] = {
+        FGridCell(-1, -1),  // Lewy gorny
+        FGridCell(-1, 0),   // Lewy
+        FGridCell(0, -1),   // Gorny
+        FGridCell(-1, 1)    // Lewy dolny
     };
 
-    for (const FVector2D& Direction : Directions)
+    for (const FGridCell& Direction : Directions)
     {
         int32 NeighborX = MegaCellX + Direction.X;
         int32 NeighborY = MegaCellY + Direction.Y;
 
         if (IsValidMegaCellCoordinate(NeighborX, NeighborY))
         {
-            NeighborCoords.Add(FVector2D(NeighborX, NeighborY));
+            NeighborCoords.Add(FGridCell(NeighborX, NeighborY));
         }
     }
 }
@@ -959,6 +1237,124 @@ void USpatialGrid::ClearGrid()
     for (FSpatialCell& MegaCell : MegaCells)
     {
         MegaCell.Units.Empty();
+        MegaCell.SleepingWatchers.Empty();
     }
     UnitToMegaCellMap.Empty();
+    SleepInterestRects.Empty();
+}
+
+/// <summary>
+/// Zwraca prostokat mega-komorek przeszukiwany przez GetUnitsInRange dla danej pozycji i zasiegu,
+/// przyciety do granic mega-siatki.
+/// </summary>
+/// <param name="Position">Pozycja srodkowa</param>
+/// <param name="Range">Zasieg wyszukiwania</param>
+/// <returns>Prostokat wspolrzednych mega-komorek (Min i Max wlacznie)</returns>
+FIntRect USpatialGrid::GetMegaCellNeighbourhood(const FVector& Position, float Range) const
+{
+    const FGridCell CenterMegaCell = GetMegaCellCoordinates(Position);
+    const int32 MegaCellRadius = FMath::CeilToInt(Range / MegaCellSize) + 1;
+
+    return FIntRect(
+        FMath::Max(CenterMegaCell.X - MegaCellRadius, 0),
+        FMath::Max(CenterMegaCell.Y - MegaCellRadius, 0),
+        FMath::Min(CenterMegaCell.X + MegaCellRadius, MegaGridWidth - 1),
+        FMath::Min(CenterMegaCell.Y + MegaCellRadius, MegaGridHeight - 1));
+}
+
+/// <summary>
+/// Usypia jednostke: rejestruje jej zainteresowanie mega-komorkami w zasiegu wyszukiwania.
+/// Rejestracja nie nastepuje, jesli w tych komorkach jest juz zywy wrog.
+/// </summary>
+/// <param name="Unit">Jednostka bez celu</param>
+/// <param name="Range">Zasieg wyszukiwania jednostki</param>
+/// <returns>true jesli jednostka zostala zarejestrowana jako uspiona</returns>
+bool USpatialGrid::RegisterSleepInterest(ABaseUnit* Unit, float Range)
+{
+    if (!Unit || !Unit->bIsAlive || MegaCells.Num() == 0 || MegaCellSize <= 0.0f)
+    {
+        return false;
+    }
+
+    ClearSleepInterest(Unit);
+
+    const FIntRect Neighbourhood = GetMegaCellNeighbourhood(Unit->GetActorLocation(), Range);
+    if (Neighbourhood.Min.X > Neighbourhood.Max.X || Neighbourhood.Min.Y > Neighbourhood.Max.Y)
+    {
+        return false;
+    }
+
+    // Wrog w sasiedztwie - jednostka musi pozostac aktywna
+    for (int32 mx = Neighbourhood.Min.X; mx <= Neighbourhood.Max.X; mx++)
+    {
+        for (int32 my = Neighbourhood.Min.Y; my <= Neighbourhood.Max.Y; my++)
+        {
+            for (ABaseUnit* Other : MegaCells[GetMegaCellIndex(mx, my)].Units)
+            {
+                if (Other && Other->bIsAlive && Other->TeamID != Unit->TeamID)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    for (int32 mx = Neighbourhood.Min.X; mx <= Neighbourhood.Max.X; mx++)
+    {
+        for (int32 my = Neighbourhood.Min.Y; my <= Neighbourhood.Max.Y; my++)
+        {
+            MegaCells[GetMegaCellIndex(mx, my)].SleepingWatchers.AddUnique(Unit);
+        }
+    }
+
+    SleepInterestRects.Add(Unit, Neighbourhood);
+    return true;
+}
+
+/// <summary>
+/// Usuwa zainteresowanie uspionej jednostki ze wszystkich zarejestrowanych mega-komorek.
+/// </summary>
+/// <param name="Unit">Jednostka do wyrejestrowania</param>
+void USpatialGrid::ClearSleepInterest(ABaseUnit* Unit)
+{
+    FIntRect Neighbourhood;
+    if (!SleepInterestRects.RemoveAndCopyValue(Unit, Neighbourhood))
+    {
+        return;
+    }
+
+    for (int32 mx = Neighbourhood.Min.X; mx <= Neighbourhood.Max.X; mx++)
+    {
+        for (int32 my = Neighbourhood.Min.Y; my <= Neighbourhood.Max.Y; my++)
+        {
+            const int32 CellIndex = GetMegaCellIndex(mx, my);
+            if (MegaCells.IsValidIndex(CellIndex))
+            {
+                MegaCells[CellIndex].SleepingWatchers.RemoveSwap(Unit);
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Budzi uspione jednostki przeciwnej druzyny obserwujace mega-komorke, do ktorej weszla jednostka.
+/// </summary>
+/// <param name="MegaCell">Mega-komorka, do ktorej weszla jednostka</param>
+/// <param name="EnteringUnit">Jednostka wchodzaca do komorki</param>
+void USpatialGrid::WakeSleepingWatchers(FSpatialCell& MegaCell, const ABaseUnit* EnteringUnit)
+{
+    if (MegaCell.SleepingWatchers.Num() == 0 || !EnteringUnit || !EnteringUnit->bIsAlive)
+    {
+        return;
+    }
+
+    // Kopia - budzenie wyrejestrowuje jednostke z tej samej tablicy
+    TArray<ABaseUnit*> Watchers = MegaCell.SleepingWatchers;
+    for (ABaseUnit* Watcher : Watchers)
+    {
+        if (IsValid(Watcher) && Watcher->TeamID != EnteringUnit->TeamID)
+        {
+            Watcher->WakeFromCombatSleep();
+        }
+    }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "StrategyGameMode.h"
 #include "StrategyPlayerController.h"
 #include "UnitManager.h"
+#include "UnitArchetype.h"
 #include "GameFramework/PlayerController.h"
 #include "Blueprint/UserWidget.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
@@ -37,6 +38,7 @@ AStrategyGameMode::AStrategyGameMode()
 
     // Inicjalizacja referencji
     UnitManagerRef = nullptr;
+    bPurchaseFlushScheduled = false;
     PlayerControllerClass = AStrategyPlayerController::StaticClass();
 
     // Konfiguracja replikacji sieciowej
@@ -229,22 +231,19 @@ void AStrategyGameMode::InitializeBattlePhase()
     CurrentPhase = EGamePhase::Battle;
     MulticastPhaseChanged(CurrentPhase, BattlePhaseTime);
 
-    // Rozpoczecie fazy walki w UnitManager
+    // Rozpoczecie fazy walki w UnitManager - zakupy z ostatniej klatki fazy zakupow trafiaja jeszcze do kolejki spawnu
     if (UnitManagerRef)
     {
+        FlushPurchasedUnitSpawns();
         UnitManagerRef->DeselectUnit();
         UnitManagerRef->StartCombatPhase();
     }
 
-    // Ustawienie timera sprawdzania koca bitwy
-    GetWorldTimerManager().SetTimer(BattleEndCheckTimer,
-        FTimerDelegate::CreateUObject(this, &AStrategyGameMode::CheckForBattleEnd), 2.0f, true);
-
     // Ustawienie timera maksymalnego czasu bitwy
     GetWorldTimerManager().SetTimer(PhaseTimer,
         FTimerDelegate::CreateUObject(this, &AStrategyGameMode::OnPhaseTimerExpired), BattlePhaseTime, false);
 
-    UE_LOG(LogTemp, Warning, TEXT("Rozpoczeto faze walki - system walki aktywowany, sprawdzanie koca co 2s"));
+    UE_LOG(LogTemp, Warning, TEXT("Rozpoczeto faze walki - system walki aktywowany, koniec wykrywany przy smierci jednostek"));
 }
 
 /// <summary>
@@ -258,15 +257,12 @@ void AStrategyGameMode::InitializeResultsPhase()
     // Ustawienie fazy wynikow
     CurrentPhase = EGamePhase::Results;
 
-    // Zatrzymanie fazy walki przed usunieciem jednostek
-    if (UnitManagerRef)
+    // Zatrzymanie fazy walki przed usunieciem jednostek (jeli nie zatrzymal jej juz UnitManager)
+    if (UnitManagerRef && UnitManagerRef->IsCombatActive())
     {
         UnitManagerRef->StopCombatPhase();
     }
 
-    // Zatrzymanie timera sprawdzania koca bitwy
-    GetWorldTimerManager().ClearTimer(BattleEndCheckTimer);
-
     // Przetworzenie wynikow bitwy
     ProcessBattleResults();
 
@@ -312,12 +308,7 @@ void AStrategyGameMode::OnPhaseTimerExpired()
     switch (CurrentPhase)
     {
     case EGamePhase::Purchase:
-        // Sprawdzenie czy bitwa ju sie zakoczyla
-        CheckForBattleEnd();
-        if (CurrentPhase != EGamePhase::Results)
-        {
-            InitializeBattlePhase();
-        }
+        InitializeBattlePhase();
         break;
 
     case EGamePhase::Battle:
@@ -363,30 +354,20 @@ void AStrategyGameMode::StartNextPhase()
 }
 
 /// <summary>
-/// Sprawdza czy bitwa powinna sie zakoczy.
+/// Callback wywoywany przez UnitManager w ticku, w ktorym zginela ostatnia jednostka jednej ze stron.
 /// </summary>
-void AStrategyGameMode::CheckForBattleEnd()
+/// <param name="Player0AliveCount">Liczba ywych jednostek Gracza 1</param>
+/// <param name="Player1AliveCount">Liczba ywych jednostek Gracza 2</param>
+void AStrategyGameMode::OnCombatEnded(int32 Player0AliveCount, int32 Player1AliveCount)
 {
-    if (!HasAuthority() || !UnitManagerRef)
+    if (!HasAuthority() || CurrentPhase != EGamePhase::Battle)
         return;
 
-    // Policzenie jednostek kadego gracza
-    int32 Player1Units = CountPlayerUnits(0);
-    int32 Player2Units = CountPlayerUnits(1);
+    UE_LOG(LogTemp, Warning, TEXT("=== KONIEC BITWY: Jednostki Gracza 1: %d, Jednostki Gracza 2: %d - zakoczenie bitwy ==="),
+        Player0AliveCount, Player1AliveCount);
 
-    UE_LOG(LogTemp, Warning, TEXT("=== SPRAWDZANIE BITWY: Jednostki Gracza 1: %d, Jednostki Gracza 2: %d ==="),
-        Player1Units, Player2Units);
-
-    // Sprawdzenie czy ktory gracz nie ma jednostek lub obaj nie maj jednostek
-    if ((Player1Units == 0 && Player2Units == 0) || Player1Units == 0 || Player2Units == 0)
-    {
-        if (CurrentPhase == EGamePhase::Battle)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("=== KONIEC BITWY: Jeden lub obaj gracze nie maj jednostek - zakoczenie bitwy ==="));
-            GetWorldTimerManager().ClearTimer(PhaseTimer);
-            InitializeResultsPhase();
-        }
-    }
+    GetWorldTimerManager().ClearTimer(PhaseTimer);
+    InitializeResultsPhase();
 }
 
 /// <summary>
@@ -428,9 +409,9 @@ EMatchResult AStrategyGameMode::DetermineBattleWinner()
     if (!UnitManagerRef)
         return EMatchResult::Draw;
 
-    // Policzenie ywych jednostek kadego gracza
-    int32 Player1Units = CountPlayerUnits(0);
-    int32 Player2Units = CountPlayerUnits(1);
+    // Odczyt licznikow ywych jednostek kadego gracza
+    int32 Player1Units = UnitManagerRef->GetAliveUnitCount(0);
+    int32 Player2Units = UnitManagerRef->GetAliveUnitCount(1);
 
     // Okrelenie zwyciezcy na podstawie liczby jednostek
     if (Player1Units > Player2Units)
@@ -441,21 +422,6 @@ EMatchResult AStrategyGameMode::DetermineBattleWinner()
         return EMatchResult::Draw;
 }
 
-/// <summary>
-/// Zlicza ywe jednostki gracza.
-/// </summary>
-/// <param name="PlayerID">ID gracza</param>
-/// <returns>Liczba ywych jednostek gracza</returns>
-int32 AStrategyGameMode::CountPlayerUnits(int32 PlayerID) const
-{
-    if (!UnitManagerRef)
-        return 0;
-
-    // Pobranie liczby ywych jednostek gracza z UnitManagera
-    int32 PlayerUnitsAlive = UnitManagerRef->GetAliveUnitCount(PlayerID);
-    return PlayerUnitsAlive;
-}
-
 /// <summary>
 /// Wywietla wynik bitwy na wszystkich klientach.
 /// </summary>
@@ -555,33 +521,79 @@ void AStrategyGameMode::OnUnitPurchased(int32 UnitType, int32 PlayerID)
     // Zarejestrowanie zakupu
     RegisterUnitPurchase(PlayerID, UnitType);
 
-    // Spawnowanie jednostki
-    if (UnitManagerRef)
+    if (!UnitManagerRef)
     {
-        EBaseUnitType UnitTypeEnum = static_cast<EBaseUnitType>(UnitType);
-        ABaseUnit* SpawnedUnit = UnitManagerRef->SpawnUnitForPlayer(PlayerID, UnitTypeEnum);
+        // Zwrot zlota jeli brak UnitManagera
+        UE_LOG(LogTemp, Error, TEXT("NIEPOWODZENIE: Nie znaleziono UnitManagera!"));
+        AddPlayerGold(PlayerID, UnitCost);
+        return;
+    }
 
-        if (SpawnedUnit)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("SUKCES: Zespawnowano jednostke typu %d dla Gracza %d"),
-                UnitType, PlayerID);
+    // Zakupy z tej klatki trafiaj do jednej partii spawnu - jednostki powstaj w budecie klatki UnitManagera
+    PendingPurchaseSpawns.Add(FUnitSpawnRequest(PlayerID, static_cast<EBaseUnitType>(UnitType)));
 
-            MulticastUnitSpawned(UnitType, PlayerID, SpawnedUnit->GridPosition);
-        }
-        else
-        {
-            // Zwrot zlota w przypadku niepowodzenia spawnu
-            UE_LOG(LogTemp, Error, TEXT("NIEPOWODZENIE: Nie mona zespawnowa jednostki typu %d dla Gracza %d"),
-                UnitType, PlayerID);
+    if (!bPurchaseFlushScheduled)
+    {
+        bPurchaseFlushScheduled = true;
+        GetWorldTimerManager().SetTimerForNextTick(this, &AStrategyGameMode::FlushPurchasedUnitSpawns);
+    }
+}
+
+/// <summary>
+/// Przekazuje zebrane zakupy do kolejki partii spawnu UnitManagera.
+/// </summary>
+void AStrategyGameMode::FlushPurchasedUnitSpawns()
+{
+    bPurchaseFlushScheduled = false;
+
+    if (PendingPurchaseSpawns.Num() == 0)
+    {
+        return;
+    }
+
+    const int32 BatchID = UnitManagerRef ? UnitManagerRef->QueueUnitSpawnBatch(PendingPurchaseSpawns) : INDEX_NONE;
+    if (BatchID == INDEX_NONE)
+    {
+        // Zwrot zlota za ca parti, ktrej nie udao si zleci
+        UE_LOG(LogTemp, Error, TEXT("NIEPOWODZENIE: Nie mona zleci partii %d zakupionych jednostek"),
+            PendingPurchaseSpawns.Num());
 
-            AddPlayerGold(PlayerID, UnitCost);
+        for (const FUnitSpawnRequest& Request : PendingPurchaseSpawns)
+        {
+            AddPlayerGold(Request.PlayerID, GetUnitCost(static_cast<int32>(Request.UnitType)));
         }
     }
     else
     {
-        // Zwrot zlota jeli brak UnitManagera
-        UE_LOG(LogTemp, Error, TEXT("NIEPOWODZENIE: Nie znaleziono UnitManagera!"));
-        AddPlayerGold(PlayerID, UnitCost);
+        PurchaseSpawnBatchIDs.Add(BatchID);
+    }
+
+    PendingPurchaseSpawns.Reset();
+}
+
+/// <summary>
+/// Callback wywoywany po utworzeniu caej partii jednostek. Zwraca zoto za jednostki, ktrych nie udao si zespawnowa.
+/// </summary>
+/// <param name="BatchID">ID partii spawnu</param>
+/// <param name="SpawnedBatch">Utworzone jednostki</param>
+/// <param name="FailedRequests">dania, dla ktrych zabrako miejsca lub klasy jednostki</param>
+void AStrategyGameMode::OnUnitBatchSpawned(int32 BatchID, const TArray<FSpawnedUnitData>& SpawnedBatch, const TArray<FUnitSpawnRequest>& FailedRequests)
+{
+    if (PurchaseSpawnBatchIDs.Remove(BatchID) == 0)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("SUKCES: Partia zakupw %d - zespawnowano %d jednostek, niepowodzenia: %d"),
+        BatchID, SpawnedBatch.Num(), FailedRequests.Num());
+
+    // Zwrot zlota w przypadku niepowodzenia spawnu
+    for (const FUnitSpawnRequest& Request : FailedRequests)
+    {
+        UE_LOG(LogTemp, Error, TEXT("NIEPOWODZENIE: Nie mona zespawnowa jednostki typu %d dla Gracza %d"),
+            static_cast<int32>(Request.UnitType), Request.PlayerID);
+
+        AddPlayerGold(Request.PlayerID, GetUnitCost(static_cast<int32>(Request.UnitType)));
     }
 }
 
@@ -593,15 +605,17 @@ void AStrategyGameMode::OnUnitPurchased(int32 UnitType, int32 PlayerID)
 
 int32 AStrategyGameMode::GetUnitCost(int32 UnitType) const
 {
-    // Zwrocenie kosztu jednostki w zalenosci od typu
-    switch (UnitType)
+    // Koszt z archetypu typu - ten sam zasob czyta sklep w UGameUI
+    if (UnitManagerRef && UnitType >= 0 && UnitType <= static_cast<int32>(EBaseUnitType::Armor))
     {
-    case 0: return 50;   // Piechota
-    case 1: return 75;   // lucznik
-    case 2: return 100;  // Kawaler
-    case 3: return 125;  // Mag
-    default: return 50;
+        if (const UUnitArchetype* Archetype = UnitManagerRef->GetUnitArchetype(static_cast<EBaseUnitType>(UnitType)))
+        {
+            return Archetype->Cost;
+        }
     }
+
+    // Brak archetypu - domyslna tabela kosztow
+    return UUnitArchetype::GetFallbackCost(UnitType);
 }
 
 /// <summary>
@@ -753,6 +767,8 @@ void AStrategyGameMode::BindUnitManagerEvents()
     {
         UnitManagerRef->OnUnitSpawned.AddDynamic(this, &AStrategyGameMode::OnUnitSpawned);
         UnitManagerRef->OnUnitMoved.AddDynamic(this, &AStrategyGameMode::OnUnitMoved);
+        UnitManagerRef->OnCombatEnded.AddDynamic(this, &AStrategyGameMode::OnCombatEnded);
+        UnitManagerRef->OnUnitBatchSpawned.AddDynamic(this, &AStrategyGameMode::OnUnitBatchSpawned);
     }
 }
 
@@ -762,7 +778,7 @@ void AStrategyGameMode::BindUnitManagerEvents()
 /// <param name="SpawnedUnit">Zespawnowana jednostka</param>
 /// <param name="PlayerID">ID gracza waciciela</param>
 /// <param name="GridPosition">Pozycja na siatce</param>
-void AStrategyGameMode::OnUnitSpawned(ABaseUnit* SpawnedUnit, int32 PlayerID, FVector2D GridPosition)
+void AStrategyGameMode::OnUnitSpawned(ABaseUnit* SpawnedUnit, int32 PlayerID, FGridCell GridPosition)
 {
     // Callback wywoywany gdy jednostka zostanie zespawnowana
     UE_LOG(LogTemp, Log, TEXT("Jednostka zespawnowana dla Gracza %d"), PlayerID);
@@ -775,7 +791,7 @@ void AStrategyGameMode::OnUnitSpawned(ABaseUnit* SpawnedUnit, int32 PlayerID, FV
 /// <param name="OldPosition">Poprzednia pozycja</param>
 /// <param name="NewPosition">Nowa pozycja</param>
 /// <param name="PlayerID">ID gracza waciciela</param>
-void AStrategyGameMode::OnUnitMoved(ABaseUnit* MovedUnit, FVector2D OldPosition, FVector2D NewPosition, int32 PlayerID)
+void AStrategyGameMode::OnUnitMoved(ABaseUnit* MovedUnit, FGridCell OldPosition, FGridCell NewPosition, int32 PlayerID)
 {
     // Callback wywoywany gdy jednostka zostanie przemieszczona
     UE_LOG(LogTemp, Log, TEXT("Jednostka przemieszczona dla Gracza %d"), PlayerID);
@@ -822,7 +838,7 @@ void AStrategyGameMode::ClearAllUnitsFromBattlefield()
 
     // Zebranie wszystkich jednostek ze wszystkich graczy
     TArray<ABaseUnit*> AllUnits;
-    TArray<FVector2D> UnitPositions;
+    TArray<FGridCell> UnitPositions;
 
     for (int32 PlayerID = 0; PlayerID < MaxPlayersPerGame; PlayerID++)
     {
@@ -836,7 +852,7 @@ void AStrategyGameMode::ClearAllUnitsFromBattlefield()
             {
                 AllUnits.Add(Unit);
                 UnitPositions.Add(Unit->GridPosition);
-                UE_LOG(LogTemp, Warning, TEXT("SERWER: Jednostka na (%f,%f) oznaczona do usunicia"),
+                UE_LOG(LogTemp, Warning, TEXT("SERWER: Jednostka na (%d,%d) oznaczona do usunicia"),
                     Unit->GridPosition.X, Unit->GridPosition.Y);
             }
         }
@@ -861,14 +877,21 @@ void AStrategyGameMode::ClearAllUnitsFromBattlefield()
         {
             UE_LOG(LogTemp, Warning, TEXT("SERWER: Rozpoczcie niszczenia jednostek po stronie serwera"));
 
-            // Zniszczenie jednostek na serwerze
+            // Zwolnienie jednostek na serwerze - aktory wracaj do puli UnitManagera
             for (ABaseUnit* Unit : AllUnits)
             {
                 if (Unit && IsValid(Unit))
                 {
-                    UE_LOG(LogTemp, Warning, TEXT("SERWER: Niszczenie jednostki na (%f,%f)"),
+                    UE_LOG(LogTemp, Warning, TEXT("SERWER: Niszczenie jednostki na (%d,%d)"),
                         Unit->GridPosition.X, Unit->GridPosition.Y);
-                    Unit->Destroy();
+                    if (UnitManagerRef)
+                    {
+                        UnitManagerRef->ReleaseUnit(Unit);
+                    }
+                    else
+                    {
+                        Unit->Destroy();
+                    }
                 }
             }
 
@@ -926,7 +949,7 @@ void AStrategyGameMode::MulticastPrepareUnitClearing_Implementation()
 /// Serwer niszczy swoje jednostki osobno z opnieniem.
 /// </summary>
 /// <param name="UnitPositions">Tablica pozycji jednostek do zniszczenia</param>
-void AStrategyGameMode::MulticastClearSpecificUnits_Implementation(const TArray<FVector2D>& UnitPositions)
+void AStrategyGameMode::MulticastClearSpecificUnits_Implementation(const TArray<FGridCell>& UnitPositions)
 {
     // Czyszczenie konkretnych jednostek po pozycjach
     UE_LOG(LogTemp, Warning, TEXT("MULTICAST: Otrzymano czyszczenie konkretnych jednostek - %d pozycji"), UnitPositions.Num());
@@ -1071,7 +1094,7 @@ void AStrategyGameMode::UpdatePlayerGoldUI(int32 PlayerID, int32 NewGold)
 /// <param name="UnitType">Typ jednostki</param>
 /// <param name="PlayerID">ID gracza waciciela</param>
 /// <param name="GridPosition">Pozycja na siatce</param>
-void AStrategyGameMode::MulticastUnitSpawned_Implementation(int32 UnitType, int32 PlayerID, FVector2D GridPosition)
+void AStrategyGameMode::MulticastUnitSpawned_Implementation(int32 UnitType, int32 PlayerID, FGridCell GridPosition)
 {
     // Powiadomienie o zespawnowaniu jednostki
     UE_LOG(LogTemp, Log, TEXT("Jednostka zespawnowana: Typ %d, Gracz %d"), UnitType, PlayerID);
@@ -32,7 +32,7 @@ AStrategyPlayerController::AStrategyPlayerController()
     bShowDebugInfo = false;
     bDrawDebugLines = false;
     LastClickTime = 0.0f;
-    LastClickPosition = FVector2D::ZeroVector;
+    LastClickPosition = FGridCell(0, 0);
     bInitialized = false;
 
     // Wyzerowanie referencji do kluczowych systemw gry
@@ -169,7 +169,7 @@ void AStrategyPlayerController::OnLeftMouseClick()
         return;
     }
 
-    FVector2D GridPosition;
+    FGridCell GridPosition;
     ABaseUnit* UnitUnderCursor = nullptr;
 
     // Sprawd czy kliknito na jednostk
@@ -181,7 +181,7 @@ void AStrategyPlayerController::OnLeftMouseClick()
     // Jeli nie, sprawd czy kliknito na siatk
     else if (GetGridPositionUnderCursor(GridPosition))
     {
-        UE_LOG(LogTemp, Warning, TEXT("Grid position under cursor: (%f, %f) - calling ServerHandleGridClick"),
+        UE_LOG(LogTemp, Warning, TEXT("Grid position under cursor: (%d, %d) - calling ServerHandleGridClick"),
             GridPosition.X, GridPosition.Y);
         ServerHandleGridClick(GridPosition, PlayerID);
     }
@@ -218,7 +218,7 @@ void AStrategyPlayerController::OnEscapePressed()
 /// </summary>
 /// <param name="OutGridPosition">Pozycja na siatce</param>
 /// <returns>true jeli znaleziono prawidow pozycj na siatce, false wpp</returns>
-bool AStrategyPlayerController::GetGridPositionUnderCursor(FVector2D& OutGridPosition) const
+bool AStrategyPlayerController::GetGridPositionUnderCursor(FGridCell& OutGridPosition) const
 {
     if (!GridManagerRef)
         return false;
@@ -230,8 +230,8 @@ bool AStrategyPlayerController::GetGridPositionUnderCursor(FVector2D& OutGridPos
     if (bHit)
     {
         // Konwertuj pozycj wiatow na pozycj w siatce
-        OutGridPosition = GridManagerRef->GetGridPositionFromWorld(HitResult.Location);
-        return GridManagerRef->IsValidGridPosition(OutGridPosition);
+        OutGridPosition = GridManagerRef->GetCellFromWorld(HitResult.Location);
+        return GridManagerRef->IsValidCell(OutGridPosition);
     }
 
     return false;
@@ -355,7 +355,7 @@ void AStrategyPlayerController::CreateGameUI()
 /// </summary>
 /// <param name="UnitGridPosition">Pozycja jednostki na siatce</param>
 /// <param name="RequestingPlayerID">ID gracza dajcego wywietlenia</param>
-void AStrategyPlayerController::ClientShowUnitSelectionByPosition_Implementation(FVector2D UnitGridPosition, int32 RequestingPlayerID)
+void AStrategyPlayerController::ClientShowUnitSelectionByPosition_Implementation(FGridCell UnitGridPosition, int32 RequestingPlayerID)
 {
     UE_LOG(LogTemp, Warning, TEXT("CLIENT RPC: ClientShowUnitSelectionByPosition received"));
 
@@ -367,7 +367,7 @@ void AStrategyPlayerController::ClientShowUnitSelectionByPosition_Implementation
     ABaseUnit* ClientUnit = UnitManagerRef->GetUnitAtPosition(UnitGridPosition);
     if (!ClientUnit)
     {
-        UE_LOG(LogTemp, Error, TEXT("Cannot find unit at position (%f,%f)!"),
+        UE_LOG(LogTemp, Error, TEXT("Cannot find unit at position (%d,%d)!"),
             UnitGridPosition.X, UnitGridPosition.Y);
         return;
     }
@@ -448,7 +448,7 @@ void AStrategyPlayerController::OnUnitPurchaseRequested(int32 UnitType)
 /// </summary>
 /// <param name="GridPosition">Pozycja na siatce ktra zostaa kliknita</param>
 /// <param name="RequestingPlayerID">ID gracza wykonujcego akcj</param>
-void AStrategyPlayerController::ServerHandleGridClick_Implementation(FVector2D GridPosition, int32 RequestingPlayerID)
+void AStrategyPlayerController::ServerHandleGridClick_Implementation(FGridCell GridPosition, int32 RequestingPlayerID)
 {
     // Tylko serwer przetwarza logik gry
     if (!HasAuthority() || !UnitManagerRef)
@@ -464,10 +464,10 @@ void AStrategyPlayerController::ServerHandleGridClick_Implementation(FVector2D G
 /// <param name="GridPosition">Pozycja na siatce do zwalidowania</param>
 /// <param name="RequestingPlayerID">ID gracza do zwalidowania</param>
 /// <returns>true jeli parametry s prawidowe, false wpp</returns>
-bool AStrategyPlayerController::ServerHandleGridClick_Validate(FVector2D GridPosition, int32 RequestingPlayerID)
+bool AStrategyPlayerController::ServerHandleGridClick_Validate(FGridCell GridPosition, int32 RequestingPlayerID)
 {
     // Walidacja danych przed wykonaniem RPC
-    return GridManagerRef && GridManagerRef->IsValidGridPosition(GridPosition) && RequestingPlayerID >= 0;
+    return GridManagerRef && GridManagerRef->IsValidCell(GridPosition) && RequestingPlayerID >= 0;
 }
 
 /// <summary>
@@ -527,6 +527,30 @@ void AStrategyPlayerController::ServerDeselectUnit_Implementation()
     }
 }
 
+/// <summary>
+/// Przekazuje prob klienta o migawk stanu bitwy lockstep (po wykryciu rozbienoci skrtw)
+/// </summary>
+void AStrategyPlayerController::ServerRequestBattleSnapshot_Implementation()
+{
+    // Tylko serwer ma rozstrzygajcy stan bitwy
+    if (!HasAuthority() || !UnitManagerRef)
+        return;
+
+    UnitManagerRef->SendLockstepSnapshot(this);
+}
+
+/// <summary>
+/// Odbiera migawk stanu bitwy lockstep i zastpuje ni lokaln symulacj
+/// </summary>
+/// <param name="SnapshotBytes">Zserializowany stan bitwy serwera</param>
+void AStrategyPlayerController::ClientReceiveBattleSnapshot_Implementation(const TArray<uint8>& SnapshotBytes)
+{
+    if (UnitManagerRef)
+    {
+        UnitManagerRef->ApplyLockstepSnapshot(SnapshotBytes);
+    }
+}
+
 /// <summary>
 /// Przetwarza danie zakupu jednostki po stronie serwera
 /// </summary>
@@ -601,15 +625,15 @@ void AStrategyPlayerController::ShowPlayerSpawnZones()
         return;
 
     // Pobierz wszystkie prawidowe pozycje spawnu dla tego gracza
-    TArray<FVector2D> SpawnPositions = GridManagerRef->GetValidSpawnPositions(PlayerID);
+    const TArray<FGridCell> SpawnPositions = GridManagerRef->GetValidSpawnCells(PlayerID);
 
     // Wyczy poprzednie podwietlenia
     UnitManagerRef->HideAllHighlights();
 
     // Podwietl wszystkie pozycje spawnu
-    for (const FVector2D& Position : SpawnPositions)
+    for (const FGridCell& Position : SpawnPositions)
     {
-        FVector WorldLocation = GridManagerRef->GetWorldLocationFromGrid(Position);
+        FVector WorldLocation = GridManagerRef->GetWorldLocationFromCell(Position);
         UnitManagerRef->HighlightGridPosition(Position, UnitManagerRef->ValidMoveHighlightMaterial);
 
         // Opcjonalnie narysuj debug box w edytorze
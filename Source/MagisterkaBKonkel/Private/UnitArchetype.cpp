@@ -0,0 +1,22 @@
+// UnitArchetype.cpp - Implementacja wspolnej konfiguracji typu jednostki
+#include "UnitArchetype.h"
+
+/// <summary>
+/// Koszt typu jednostki bez przypisanego archetypu - ta sama tabela co wczesniej w GetUnitCost.
+/// </summary>
+/// <param name="UnitType">Typ jednostki</param>
+/// <returns>Koszt w zlocie</returns>
+int32 UUnitArchetype::GetFallbackCost(int32 UnitType)
+{
+    static constexpr int32 FallbackCosts[] = { 50, 75, 100, 125 };
+    return (UnitType >= 0 && UnitType < UE_ARRAY_COUNT(FallbackCosts)) ? FallbackCosts[UnitType] : FallbackCosts[0];
+}
+
+/// <summary>
+/// Identyfikator zasobu dla Asset Managera - jeden archetyp na typ jednostki.
+/// </summary>
+/// <returns>Identyfikator "UnitArchetype:NazwaZasobu"</returns>
+FPrimaryAssetId UUnitArchetype::GetPrimaryAssetId() const
+{
+    return FPrimaryAssetId(TEXT("UnitArchetype"), GetFName());
+}
@@ -9,6 +9,10 @@
 #include "Kismet/GameplayStatics.h"
 #include "Net/UnrealNetwork.h"
 #include "SpatialGrid.h"
+#include "BattleSimulator.h"
+#include "BattleReplay.h"
+#include "UnitArchetype.h"
+#include "HAL/PlatformMemory.h"
 
 /// <summary>
 /// Konstruktor klasy AUnitManager.
@@ -16,6 +20,8 @@
 AUnitManager::AUnitManager()
 {
     PrimaryActorTick.bCanEverTick = true;
+    // Tick po jednostkach i timerach - śmierć i koniec walki rozstrzygane w tej samej klatce
+    PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 
     // Inicjalizacja podstawowych referencji i stanu
     GridManagerRef = nullptr;
@@ -40,11 +46,78 @@ AUnitManager::AUnitManager()
     SpatialGridCellSize = 200.0f;    // Rozmiar komórki siatki w jednostkach Unreal
     SpatialGridWorldMin = FVector2D(-2000, -2000);  // Dolne granice świata gry
     SpatialGridWorldMax = FVector2D(2000, 2000);    // Górne granice świata gry
+    bUseParallelTargetAcquisition = true;           // Wyszukiwanie celów równolegle na migawce pozycji
+    bUseBatchedDamage = true;                       // Obrażenia rozstrzygane zbiorczo raz na tick
+    bCombatEndCheckPending = false;
+
+    // Podział czasu decyzji bojowych - domyślnie każda jednostka w swoim ticku
+    bUseTimeSlicedCombat = false;
+    CombatFrameBudgetMs = 2.0f;     // Budżet klatki na decyzje jednostek
+    MinUnitRefreshRate = 4.0f;      // Każda jednostka co najmniej 4 razy na sekundę
+    TimeSliceCursor = 0;
+
+    // Bitwa lockstep - domyślnie wyłączona, walka na aktorach jak dotychczas
+    bUseLockstepBattle = false;
+    LockstepHashIntervalTicks = FLockstepBattleSession::DefaultHashIntervalTicks;
+    bLockstepSnapshotRequested = false;
+
+    // Partie spawnu rozkładane na klatki - 2 ms na klatkę na tworzenie aktorów, bez limitu liczby
+    SpawnFrameBudgetMs = 2.0f;
+    MaxSpawnsPerFrame = 0;
+    NextSpawnBatchID = 0;
+
+    // Pola przepływu drużyn - ostatnie dwie komórki przed celem jednostka idzie prosto na niego
+    bUseFlowFields = true;
+    FlowFieldDirectApproachDistance = 200.0f;
+    AppliedNavigationRevision = 0;
+    bUseGridPathfinding = true;
+    bUseCellReservations = true;
+    BattleRegionMarginChunks = 1;
+    bUseLocalAvoidance = true;
+    AvoidanceRadius = 40.0f;
+    AvoidanceNeighborDistance = 300.0f;
+    AvoidanceMaxNeighbors = 8;
+    AvoidanceTimeHorizon = 4.0f;
+    AvoidanceBlendWeight = 0.75f;
+    bUseBatchedMovement = true;
+    MovementStepTime = 1.0f / 60.0f;
+    PositionPublishRate = 10.0f;
+
+    // Oddziały do 12 jednostek, przebudowywane dwa razy na sekundę
+    bUseSquads = true;
+    SquadLinkDistance = 300.0f;
+    MaxSquadSize = 12;
+    SquadRebuildInterval = 0.5f;
+    SquadTargetRegionRadius = 400.0f;
+    SquadRebuildCountdown = 0.0f;
+
+    // Pula aktorów jednostek - po kilka aktorów każdego typu gotowych przed pierwszą rundą
+    bUseUnitPool = true;
+    MaxPooledUnitsPerType = 64;
+    UnitPoolPrewarmCounts.Add(EBaseUnitType::Tank, 8);
+    UnitPoolPrewarmCounts.Add(EBaseUnitType::Ninja, 8);
+    UnitPoolPrewarmCounts.Add(EBaseUnitType::Sword, 8);
+    UnitPoolPrewarmCounts.Add(EBaseUnitType::Armor, 8);
+
+    // Test obciążeniowy uruchamiany na żądanie (konsola lub test automatyczny)
+    bStressTestActive = false;
+    StressStartGameSeconds = 0.0f;
+    StressLastTickSeconds = 0.0;
+    SavedSpatialGridWorldMin = SpatialGridWorldMin;
+    SavedSpatialGridWorldMax = SpatialGridWorldMax;
+    SavedLogVerbosity = ELogVerbosity::Log;
+    bStressGridResized = false;
+    SavedGridWidth = 0;
+    SavedGridHeight = 0;
+    SavedGridOrigin = FVector::ZeroVector;
 
     // Inicjalizacja systemu optymalizacji pamięci podręcznej
     MaxCombatUnits = 0;
     ActiveCombatUnitsCount = 0;
 
+    // Rozdzielczość koła czasowego dla krótkich timerów jednostek (ataki, paski zdrowia, śmierć)
+    TimingWheelResolution = 0.05f;
+
     // Konfiguracja replikacji sieciowej
     bReplicates = true;
     bAlwaysRelevant = true;  // Manager zawsze widoczny dla wszystkich klientów
@@ -85,6 +158,12 @@ void AUnitManager::BeginPlay()
     // Inicjalizacja systemu optymalizacji pamięci dla walki
     InitializeCombatDataLocality();
 
+    // Koło czasowe startuje od aktualnego ticka świata
+    CombatTimingWheel.Reset(GetCurrentTimerTick());
+
+    // Aktory jednostek tworzone przy ładowaniu mapy zamiast przy pierwszych zakupach
+    PrewarmUnitPool();
+
     // Ustawienie opóźnionego timera inicjalizacji GridManager
     GetWorldTimerManager().SetTimer(
         InitializeGridManagerHandle,
@@ -98,6 +177,22 @@ void AUnitManager::BeginPlay()
         bUseSpatialPartitioning ? TEXT("WŁĄCZONE") : TEXT("WYŁĄCZONE"));
 }
 
+/// <summary>
+/// Wywoływane przy usuwaniu aktora ze świata.
+/// </summary>
+/// <param name="EndPlayReason">Powód zakończenia</param>
+void AUnitManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Przerwany test obciążeniowy nie może zostawić wyciszonych logów
+    if (bStressTestActive)
+    {
+        bStressTestActive = false;
+        LogTemp.SetVerbosity(SavedLogVerbosity);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 /// <summary>
 /// Główna pętla aktualizacji wykonywana co klatkę.
 /// </summary>
@@ -106,9 +201,97 @@ void AUnitManager::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
-    // Tylko serwer monitoruje warunki zakończenia walki
-    if (HasAuthority() && bCombatPhaseActive)
+    // Próbka czasu klatki testu obciążeniowego - odstęp między kolejnymi tickami managera
+    if (bStressTestActive)
+    {
+        const double Now = FPlatformTime::Seconds();
+        StressTickRecorder.AddSample(static_cast<float>((Now - StressLastTickSeconds) * 1000.0));
+        StressLastTickSeconds = Now;
+    }
+
+    // Opróżnienie wymagalnych kubełków koła czasowego (serwer i klienci)
+    ProcessCombatTimers();
+
+    // Partie spawnu w ramach budżetu klatki - serwer tworzy jednostki, klienci ich lokalne kopie
+    if (HasAuthority())
+    {
+        ProcessSpawnQueue();
+    }
+    else
+    {
+        ProcessClientSpawnQueue();
+    }
+
+    // Bitwa lockstep liczona lokalnie (serwer i klienci)
+    if (LockstepSession.IsActive())
+    {
+        UpdateLockstepBattle(DeltaTime);
+    }
+
+    // Pola przepływu przeliczane tylko po zmianie zajętości komórek przez wrogów
+    if (HasAuthority() && bCombatPhaseActive && bUseFlowFields && !LockstepSession.IsActive())
+    {
+        UpdateFlowFields();
+    }
+
+    // Wyniki wyszukiwań ścieżek z poprzedniego ticku i start nowej partii w tle
+    if (HasAuthority() && PathService.IsInitialized())
+    {
+        UpdatePathService();
+    }
+
+    // Oddziały - przebudowa skupisk i jedno zapytanie o cel na oddział zamiast na jednostkę
+    if (HasAuthority() && IsSquadPlanningEnabled())
+    {
+        UpdateSquads(DeltaTime);
+    }
+
+    // Decyzje bojowe jednostek w ramach budżetu klatki
+    if (HasAuthority() && bCombatPhaseActive && bUseTimeSlicedCombat)
+    {
+        ProcessTimeSlicedCombat();
+    }
+
+    // Rozstrzygnięcie zgłoszeń ruchu z tego ticku
+    if (HasAuthority() && CellReservations.IsInitialized())
+    {
+        ResolveCellReservations(true);
+    }
+
+    // Zapis transformacji wszystkich kroków z tej klatki i partia pozycji dla klientów
+    if (HasAuthority())
+    {
+        FlushUnitMoves(DeltaTime);
+    }
+
+    // Obszar bitwy budowany od nowa, gdy jednostki zbliżyły się do jego krawędzi
+    if (HasAuthority() && bCombatPhaseActive && !LockstepSession.IsActive())
+    {
+        UpdateBattleRegion(false);
+    }
+
+    // Zajętość komórek na kolejny tick - dopiero po zapisie kroków z tej klatki
+    if (HasAuthority() && CellReservations.IsInitialized())
+    {
+        BeginCellReservationTick();
+    }
+
+    // Prędkości ORCA na kolejny tick z migawki po wszystkich krokach tej klatki
+    if (HasAuthority() && IsLocalAvoidanceEnabled() && !LockstepSession.IsActive())
+    {
+        UpdateLocalAvoidance();
+    }
+
+    // Rozstrzygnięcie trafień zebranych w tym ticku
+    if (HasAuthority())
+    {
+        ResolvePendingDamage();
+    }
+
+    // Warunki zakończenia walki sprawdzane tylko po zmianie liczników żywych jednostek
+    if (HasAuthority() && bCombatEndCheckPending)
     {
+        bCombatEndCheckPending = false;
         CheckCombatEndConditions();
     }
 
@@ -129,6 +312,12 @@ void AUnitManager::Tick(float DeltaTime)
             Unit->HideUnit();
         }
     }
+
+    // Test obciążeniowy kończy się po zadanym czasie gry, jeśli walka nie rozstrzygnęła się wcześniej
+    if (bStressTestActive && GetWorld()->GetTimeSeconds() - StressStartGameSeconds >= ActiveStressConfig.DurationSeconds)
+    {
+        FinishCombatStressTest();
+    }
 }
 
 /// <summary>
@@ -255,15 +444,40 @@ void AUnitManager::StartCombatPhase()
         return;
     }
 
+    // Jednostki z zakupów czekające jeszcze w kolejce partii muszą stanąć na planszy przed walką
+    ProcessSpawnQueue(false);
+
     bCombatPhaseActive = true;
     TotalCombatUnits = SpawnedUnits.Num();
 
+    // Tryb lockstep - bitwę liczą symulacje serwera i klientów, aktorzy jednostek stoją w miejscu
+    if (bUseLockstepBattle)
+    {
+        StartLockstepBattle();
+        return;
+    }
+
     // Wypełnienie siatki przestrzennej wszystkimi jednostkami dla optymalizacji
     if (bUseSpatialPartitioning && SpatialGrid)
     {
         PopulateSpatialGridWithAllUnits();
     }
 
+    // Pola przepływu, serwis ścieżek i tablica rezerwacji na obszarze bitwy wokół pozycji startowych
+    UpdateBattleRegion(true);
+
+    // Pierwsze przeliczenie pól przepływu od razu z pozycji startowych
+    if (bUseFlowFields)
+    {
+        UpdateFlowFields();
+    }
+
+    // Zajętość pozycji startowych w tablicy rezerwacji
+    if (CellReservations.IsInitialized())
+    {
+        BeginCellReservationTick();
+    }
+
     // Włączenie automatycznej walki dla wszystkich jednostek
     EnableAutoCombatForAllUnits();
 
@@ -277,14 +491,6 @@ void AUnitManager::StartCombatPhase()
         true  // Powtarzanie co określony interwał
     );
 
-    // Uruchomienie timera monitorowania zdarzeń walki
-    GetWorldTimerManager().SetTimer(
-        CombatMonitorTimer,
-        FTimerDelegate::CreateUObject(this, &AUnitManager::MonitorCombatEvents),
-        0.5f,  // Sprawdzanie co pół sekundy
-        true   // Ciągłe powtarzanie
-    );
-
     // Podpięcie zdarzeń walki dla wszystkich jednostek
     for (const FSpawnedUnitData& UnitData : SpawnedUnits)
     {
@@ -297,6 +503,9 @@ void AUnitManager::StartCombatPhase()
     // Replikacja rozpoczęcia walki do wszystkich klientów
     MulticastCombatStarted(GetAliveUnitCount(0) + GetAliveUnitCount(1), CombatUpdateInterval);
 
+    // Walka bez jednostek jednej ze stron kończy się w najbliższym ticku
+    bCombatEndCheckPending = true;
+
     UE_LOG(LogTemp, Warning, TEXT("=== FAZA WALKI: Rozpoczęto - jednostki: %d, interwał: %f, partycjonowanie: %s ==="),
         TotalCombatUnits, CombatUpdateInterval, bUseSpatialPartitioning ? TEXT("WŁĄCZONE") : TEXT("WYŁĄCZONE"));
 }
@@ -316,9 +525,42 @@ void AUnitManager::StopCombatPhase()
 
     bCombatPhaseActive = false;
 
+    // Trafienia z przerwanej walki nie są już rozstrzygane
+    PendingDamage.Reset();
+    bCombatEndCheckPending = false;
+
+    // Przerwana bitwa lockstep (np. koniec czasu fazy) - klienci zatrzymują ją w MulticastCombatStopped
+    LockstepSession.Stop();
+
+    // Zgłoszenia ruchu z przerwanej walki są odrzucane
+    if (CellReservations.IsInitialized())
+    {
+        ResolveCellReservations(false);
+        CellReservations.Reset();
+    }
+
+    // Kroki zgłoszone przed zatrzymaniem są jeszcze wykonywane
+    UnitMover.Flush();
+    UnitMover.Reset();
+
+    // Ruch wsadowy nie zapisuje WorldPosition - jeden zapis końcowy wyrównuje replikowaną pozycję
+    // z ostatnim krokiem, także gdy ostatnia partia pozycji nie została jeszcze wysłana
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        if (UnitData.Unit && IsValid(UnitData.Unit))
+        {
+            UnitData.Unit->WorldPosition = UnitData.Unit->GetActorLocation();
+        }
+    }
+
+    // Oddziały są budowane od nowa w kolejnej walce
+    SquadPlanner.Reset();
+    SquadPlans.Reset();
+    SquadMemberSlots.Reset();
+    SquadRebuildCountdown = 0.0f;
+
     // Zatrzymanie wszystkich timerów związanych z walką
     GetWorldTimerManager().ClearTimer(CombatUpdateTimer);
-    GetWorldTimerManager().ClearTimer(CombatMonitorTimer);
 
     // Wyczyszczenie siatki przestrzennej z jednostek
     if (bUseSpatialPartitioning && SpatialGrid)
@@ -403,12 +645,19 @@ void AUnitManager::ProcessSpatialCombat(const TArray<ABaseUnit*>& AliveUnits)
     // Pozwól siatce przestrzennej obsłużyć całą walkę efektywnie
     SpatialGrid->HandleAllCombat();
 
+    // Równoległa faza decyzji + sekwencyjna faza zastosowania celów
+    if (bUseParallelTargetAcquisition)
+    {
+        AcquireTargetsInParallel(AliveUnits);
+        return;
+    }
+
     // Ulepszone przetwarzanie jednostka-po-jednostce z zapytaniami przestrzennymi
     // Daje więcej kontroli nad indywidualnym zachowaniem jednostek
     for (ABaseUnit* Unit : AliveUnits)
     {
-        // Pomijanie nieważnych lub nieaktywnych jednostek
-        if (!Unit || !Unit->bIsAlive || !Unit->bAutoCombatEnabled)
+        // Pomijanie nieważnych, nieaktywnych lub uśpionych jednostek
+        if (!Unit || !Unit->bIsAlive || !Unit->bAutoCombatEnabled || Unit->bCombatSleeping)
         {
             continue;
         }
@@ -442,22 +691,94 @@ void AUnitManager::ProcessUnitCombatWithSpatialGrid(ABaseUnit* Unit)
     {
         // Wyszukiwanie tylko w pobliskich komórkach siatki
         // zamiast sprawdzania wszystkich jednostek na mapie
-        ABaseUnit* NearestEnemy = SpatialGrid->FindNearestEnemy(Unit, Unit->SearchRange);
+        ABaseUnit* NearestEnemy = SpatialGrid->FindNearestEnemy(Unit, Unit->GetArchetype()->SearchRange);
+        ApplyAcquiredTarget(Unit, NearestEnemy);
+    }
+}
 
-        if (NearestEnemy)
+/// <summary>
+/// Wyszukiwanie celów w dwóch fazach. Faza decyzji (ParallelFor) czyta wyłącznie zamrożoną
+/// migawkę siatki i zapisuje proponowany cel każdej jednostki do osobnego elementu tablicy.
+/// Faza zastosowania przechodzi jednostki sekwencyjnie w tej samej kolejności co
+/// ProcessUnitCombatWithSpatialGrid i dopiero tu wywołuje SetTarget/PerformAttack.
+/// </summary>
+/// <param name="AliveUnits">Tablica wszystkich żywych jednostek do przetworzenia</param>
+void AUnitManager::AcquireTargetsInParallel(const TArray<ABaseUnit*>& AliveUnits)
+{
+    if (!HasAuthority() || !SpatialGrid)
+    {
+        return;
+    }
+
+    // Faza decyzji - tylko odczyt migawki, brak dostępu do aktorów
+    FTargetAcquisitionSnapshot Snapshot;
+    TArray<ABaseUnit*> SnapshotUnits;
+    TArray<int32> SeekerIndices;
+    TArray<int32> ProposedTargets;
+
+    SpatialGrid->BuildTargetSnapshot(AliveUnits, Snapshot, SnapshotUnits, SeekerIndices);
+    USpatialGrid::DecideNearestEnemies(Snapshot, ProposedTargets, true);
+
+    // Faza zastosowania - sekwencyjnie na wątku gry
+    for (int32 UnitIndex = 0; UnitIndex < AliveUnits.Num(); UnitIndex++)
+    {
+        ABaseUnit* Unit = AliveUnits[UnitIndex];
+        if (!Unit || !Unit->bIsAlive || !Unit->bAutoCombatEnabled || Unit->bCombatSleeping)
         {
-            UE_LOG(LogTemp, Warning, TEXT("=== WALKA PRZESTRZENNA: Jednostka %s znalazła nowy cel %s za pomocą siatki ==="),
-                *Unit->GetName(), *NearestEnemy->GetName());
+            continue;
+        }
 
-            Unit->SetTarget(NearestEnemy);
-            Unit->MoveTowardsTarget(NearestEnemy);
+        if (Unit->HasValidTarget() && Unit->CanAttackTarget(Unit->CurrentTarget))
+        {
+            Unit->PerformAttack(Unit->CurrentTarget);
+            continue;
         }
-        else
+
+        if (Unit->HasValidTarget())
+        {
+            continue;
+        }
+
+        const int32 SeekerIndex = SeekerIndices[UnitIndex];
+        const bool bHasDecision = SeekerIndex != INDEX_NONE && Snapshot.Entries[SeekerIndex].bNeedsTarget;
+
+        ABaseUnit* NearestEnemy = nullptr;
+        if (bHasDecision && ProposedTargets[SeekerIndex] != INDEX_NONE)
+        {
+            NearestEnemy = SnapshotUnits[ProposedTargets[SeekerIndex]];
+        }
+
+        // Cel zginął w tej fazie lub jednostka straciła cel po wykonaniu migawki - zapytanie sekwencyjne
+        if (!bHasDecision || (NearestEnemy && !NearestEnemy->bIsAlive))
         {
-            // Brak wrogów w zasięgu, powrót do stanu spoczynku
-            Unit->ClearTarget();
-            Unit->SetAnimationState(EAnimationState::Idle);
+            NearestEnemy = SpatialGrid->FindNearestEnemy(Unit, Unit->GetArchetype()->SearchRange);
         }
+
+        ApplyAcquiredTarget(Unit, NearestEnemy);
+    }
+}
+
+/// <summary>
+/// Stosuje wynik wyszukiwania celu dla jednostki bez aktualnego celu.
+/// </summary>
+/// <param name="Unit">Jednostka, której cel jest ustawiany</param>
+/// <param name="NearestEnemy">Znaleziony wróg lub nullptr gdy brak wrogów w zasięgu</param>
+void AUnitManager::ApplyAcquiredTarget(ABaseUnit* Unit, ABaseUnit* NearestEnemy)
+{
+    if (NearestEnemy)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== WALKA PRZESTRZENNA: Jednostka %s znalazła nowy cel %s za pomocą siatki ==="),
+            *Unit->GetName(), *NearestEnemy->GetName());
+
+        Unit->SetTarget(NearestEnemy);
+        Unit->MoveTowardsTarget(NearestEnemy, Unit->GetMovementDecisionAge(GetWorld()->GetTimeSeconds()));
+    }
+    else
+    {
+        // Brak wrogów w zasięgu, powrót do stanu spoczynku i uśpienie do czasu pojawienia się wroga
+        Unit->ClearTarget();
+        Unit->SetAnimationState(EAnimationState::Idle);
+        Unit->TryEnterCombatSleep();
     }
 }
 
@@ -488,7 +809,7 @@ void AUnitManager::UpdateAllUnitsCombat()
     {
         if (Unit && Unit->bAutoCombatEnabled)
         {
-            UE_LOG(LogTemp, Warning, TEXT("=== AKTUALIZACJA WALKI: Przetwarzanie jednostki %s na pozycji (%f,%f) ==="),
+            UE_LOG(LogTemp, Warning, TEXT("=== AKTUALIZACJA WALKI: Przetwarzanie jednostki %s na pozycji (%d,%d) ==="),
                 *Unit->GetName(), Unit->GridPosition.X, Unit->GridPosition.Y);
             Unit->FindAndAttackNearestEnemy(AliveUnits);
         }
@@ -498,32 +819,6 @@ void AUnitManager::UpdateAllUnitsCombat()
     MulticastCombatUpdate(AliveUnits);
 }
 
-/// <summary>
-/// Monitoruje zdarzenia walki i obsługuje usuwanie martwych jednostek.
-/// </summary>
-void AUnitManager::MonitorCombatEvents()
-{
-    if (!HasAuthority() || !bCombatPhaseActive)
-        return;
-
-    // Zebranie wszystkich martwych jednostek
-    TArray<ABaseUnit*> UnitsToRemove;
-
-    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
-    {
-        if (UnitData.Unit && !UnitData.Unit->bIsAlive)
-        {
-            UnitsToRemove.Add(UnitData.Unit);
-        }
-    }
-
-    // Obsługa każdej martwej jednostki
-    for (ABaseUnit* DeadUnit : UnitsToRemove)
-    {
-        HandleUnitDeath(DeadUnit);
-    }
-}
-
 /// <summary>
 /// Obsługuje wszystkie operacje związane ze śmiercią jednostki.
 /// </summary>
@@ -535,6 +830,9 @@ void AUnitManager::HandleUnitDeath(ABaseUnit* DeadUnit)
 
     UE_LOG(LogTemp, Warning, TEXT("=== ŚMIERĆ W WALCE: Jednostka %s zginęła ==="), *DeadUnit->GetName());
 
+    // Jedyna aktualizacja licznika żywych jednostek przy śmierci
+    AdjustAliveUnitCount(DeadUnit->TeamID, -1);
+
     // Usunięcie z siatki przestrzennej
     if (bUseSpatialPartitioning && SpatialGrid)
     {
@@ -554,8 +852,11 @@ void AUnitManager::HandleUnitDeath(ABaseUnit* DeadUnit)
     // Broadcast zdarzenia śmierci dla UI, statystyk, achievementów etc.
     OnUnitKilled.Broadcast(DeadUnit);
 
-    // Sprawdzenie czy walka powinna się zakończyć
-    CheckCombatEndConditions();
+    // Sprawdzenie czy walka powinna się zakończyć - po rozstrzygnięciu wszystkich trafień z tego ticka
+    if (GetAliveUnitCount(DeadUnit->TeamID) == 0)
+    {
+        bCombatEndCheckPending = true;
+    }
 }
 
 /// <summary>
@@ -566,7 +867,7 @@ void AUnitManager::CheckCombatEndConditions()
     if (!HasAuthority() || !bCombatPhaseActive)
         return;
 
-    // Zliczenie żywych jednostek każdego gracza
+    // Odczyt liczników żywych jednostek każdego gracza - O(1)
     int32 Player0AliveCount = GetAliveUnitCount(0);
     int32 Player1AliveCount = GetAliveUnitCount(1);
 
@@ -576,13 +877,18 @@ void AUnitManager::CheckCombatEndConditions()
     // Zakończenie walki jeśli jedna strona nie ma jednostek
     if (Player0AliveCount == 0 || Player1AliveCount == 0)
     {
+        // Bitwa testu obciążeniowego nie jest rundą gry - GameMode nie dostaje wyniku
+        if (bStressTestActive)
+        {
+            FinishCombatStressTest();
+            return;
+        }
+
         UE_LOG(LogTemp, Warning, TEXT("=== KONIEC WALKI: Zakończenie - jedna strona wyeliminowana ==="));
         StopCombatPhase();
-    }
-    else if (Player0AliveCount + Player1AliveCount < 2)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("=== KONIEC WALKI: Zakończenie - niewystarczająca liczba jednostek ==="));
-        StopCombatPhase();
+
+        // Powiadomienie GameMode o rozstrzygnięciu bitwy
+        OnCombatEnded.Broadcast(Player0AliveCount, Player1AliveCount);
     }
 }
 
@@ -593,136 +899,406 @@ void AUnitManager::CheckCombatEndConditions()
 /// <returns>Liczba żywych jednostek gracza</returns>
 int32 AUnitManager::GetAliveUnitCount(int32 PlayerID) const
 {
-    int32 Count = 0;
-    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
-    {
-        if (UnitData.PlayerID == PlayerID && UnitData.Unit && UnitData.Unit->bIsAlive)
-        {
-            Count++;
-        }
-    }
-    return Count;
+    return AliveUnitCounts.IsValidIndex(PlayerID) ? AliveUnitCounts[PlayerID] : 0;
 }
 
 /// <summary>
-/// Zwraca tablicę wszystkich żywych jednostek.
+/// Aktualizuje licznik żywych jednostek gracza (tylko serwer).
 /// </summary>
-/// <returns>Tablica wskaźników do żywych jednostek</returns>
-TArray<ABaseUnit*> AUnitManager::GetAliveUnits() const
+/// <param name="PlayerID">ID gracza</param>
+/// <param name="Delta">Zmiana liczby żywych jednostek</param>
+void AUnitManager::AdjustAliveUnitCount(int32 PlayerID, int32 Delta)
 {
-    TArray<ABaseUnit*> AliveUnits;
+    if (!HasAuthority() || PlayerID < 0)
+    {
+        return;
+    }
 
-    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    if (!AliveUnitCounts.IsValidIndex(PlayerID))
     {
-        if (UnitData.Unit && IsValid(UnitData.Unit) && UnitData.Unit->bIsAlive)
-        {
-            AliveUnits.Add(UnitData.Unit);
-        }
+        AliveUnitCounts.SetNumZeroed(PlayerID + 1);
     }
 
-    return AliveUnits;
+    AliveUnitCounts[PlayerID] = FMath::Max(AliveUnitCounts[PlayerID] + Delta, 0);
 }
 
 /// <summary>
-/// Zwraca tablicę wszystkich jednostek (żywych i martwych).
+/// Planuje akcję czasową jednostki w kole czasowym zamiast osobnego timera FTimerManager.
 /// </summary>
-/// <returns>Tablica wskaźników do wszystkich jednostek</returns>
-TArray<ABaseUnit*> AUnitManager::GetAllUnits() const
+/// <param name="Unit">Jednostka, której dotyczy akcja</param>
+/// <param name="Action">Akcja do wykonania</param>
+/// <param name="Delay">Opóźnienie w sekundach</param>
+/// <returns>true jeśli akcja została zaplanowana w kole</returns>
+bool AUnitManager::ScheduleUnitTimer(ABaseUnit* Unit, ECombatTimerAction Action, float Delay)
 {
-    TArray<ABaseUnit*> AllUnits;
+    if (!Unit || !GetWorld() || TimingWheelResolution <= 0.0f)
+    {
+        return false;
+    }
 
-    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    // Leniwa rejestracja slotu przy pierwszym timerze jednostki
+    if (Unit->TimerSlotIndex == INDEX_NONE)
     {
-        if (UnitData.Unit && IsValid(UnitData.Unit))
-        {
-            AllUnits.Add(UnitData.Unit);
-        }
+        RegisterUnitTimerSlot(Unit);
     }
 
-    return AllUnits;
+    FCombatTimerEntry Entry;
+    Entry.UnitSlot = Unit->TimerSlotIndex;
+    Entry.SlotGeneration = TimerSlotGenerations[Entry.UnitSlot];
+    Entry.Action = Action;
+    Entry.DeadlineTick = GetCurrentTimerTick() + FMath::Max(1, FMath::CeilToInt(Delay / TimingWheelResolution));
+
+    CombatTimingWheel.Schedule(Entry);
+    return true;
 }
 
 /// <summary>
-/// Inicjalizuje system optymalizacji pamięci podręcznej dla wydajnej walki.
+/// Zwalnia slot jednostki. Zmiana generacji unieważnia wszystkie zaległe wpisy tej jednostki.
 /// </summary>
-void AUnitManager::InitializeCombatDataLocality()
+/// <param name="Unit">Jednostka usuwana ze świata</param>
+void AUnitManager::ReleaseUnitTimerSlot(ABaseUnit* Unit)
 {
-    // Tylko serwer inicjalizuje system optymalizacji
-    if (!HasAuthority())
+    if (!Unit || !TimerUnitSlots.IsValidIndex(Unit->TimerSlotIndex))
     {
-        UE_LOG(LogTemp, Warning, TEXT("=== OPTYMALIZACJA CACHE: Klient pomija inicjalizację ==="));
         return;
     }
 
-    if (!GridManagerRef)
+    const int32 SlotIndex = Unit->TimerSlotIndex;
+    if (TimerUnitSlots[SlotIndex] == Unit)
     {
-        UE_LOG(LogTemp, Error, TEXT("=== OPTYMALIZACJA CACHE: Nie można zainicjalizować - GridManagerRef jest null ==="));
-        return;
+        TimerUnitSlots[SlotIndex] = nullptr;
+        TimerSlotGenerations[SlotIndex]++;
+        FreeTimerSlots.Add(SlotIndex);
     }
 
-    // Obliczenie maksymalnej liczby jednostek bojowych z pozycji spawnu obu graczy
-    TArray<FVector2D> Player0SpawnPositions = GridManagerRef->GetValidSpawnPositions(0);
-    TArray<FVector2D> Player1SpawnPositions = GridManagerRef->GetValidSpawnPositions(1);
-
-    MaxCombatUnits = Player0SpawnPositions.Num() + Player1SpawnPositions.Num();
-
-    // Pre-alokacja tablicy jednostek bojowych dla optymalnej wydajności
-    // Wszystkie jednostki będą obok siebie w pamięci
-    CombatUnitsArray.Empty(MaxCombatUnits);
-    CombatUnitsArray.SetNumZeroed(MaxCombatUnits);
-    ActiveCombatUnitsCount = 0;
-
-    UE_LOG(LogTemp, Warning, TEXT("=== OPTYMALIZACJA CACHE: Zainicjalizowano tablicę z pojemnością: %d (Gracz0: %d, Gracz1: %d) ==="),
-        MaxCombatUnits, Player0SpawnPositions.Num(), Player1SpawnPositions.Num());
+    Unit->TimerSlotIndex = INDEX_NONE;
 }
 
 /// <summary>
-/// Dodaje jednostkę do spakowanej tablicy optymalizacji cache.
+/// Przydziela jednostce slot w tabeli timerów (ponowne użycie zwolnionych slotów).
 /// </summary>
-/// <param name="Unit">Jednostka do dodania</param>
-void AUnitManager::AddUnitToCombatArray(ABaseUnit* Unit)
+/// <param name="Unit">Jednostka do zarejestrowania</param>
+/// <returns>Indeks przydzielonego slotu</returns>
+int32 AUnitManager::RegisterUnitTimerSlot(ABaseUnit* Unit)
 {
-    if (!HasAuthority() || !Unit || !Unit->bIsAlive)
+    int32 SlotIndex;
+    if (FreeTimerSlots.Num() > 0)
     {
-        return;
+        SlotIndex = FreeTimerSlots.Pop(EAllowShrinking::No);
+        TimerUnitSlots[SlotIndex] = Unit;
     }
-
-    // Sprawdzenie czy tablica jest zainicjalizowana
-    if (CombatUnitsArray.Num() == 0)
+    else
     {
-        UE_LOG(LogTemp, Warning, TEXT("=== OPTYMALIZACJA CACHE: Tablica niezainicjalizowana, inicjalizacja teraz ==="));
-        InitializeCombatDataLocality();
+        SlotIndex = TimerUnitSlots.Add(Unit);
+        TimerSlotGenerations.Add(0);
     }
 
-    if (CombatUnitsArray.Num() == 0)
+    Unit->TimerSlotIndex = SlotIndex;
+    return SlotIndex;
+}
+
+/// <summary>
+/// Przesuwa koło czasowe do aktualnego ticka i wykonuje wymagalne akcje jednostek.
+/// </summary>
+void AUnitManager::ProcessCombatTimers()
+{
+    if (!GetWorld() || TimingWheelResolution <= 0.0f)
     {
-        UE_LOG(LogTemp, Error, TEXT("=== OPTYMALIZACJA CACHE: Nie udało się zainicjalizować tablicy ==="));
         return;
     }
 
-    // Znalezienie pierwszego wolnego slotu w tablicy
-    for (int32 i = 0; i < MaxCombatUnits; i++)
+    DueTimerEntries.Reset();
+    CombatTimingWheel.Advance(GetCurrentTimerTick(), DueTimerEntries);
+
+    for (const FCombatTimerEntry& Entry : DueTimerEntries)
     {
-        if (CombatUnitsArray[i] == nullptr)
+        // Pominięcie wpisów jednostek, które zostały już usunięte
+        if (!TimerUnitSlots.IsValidIndex(Entry.UnitSlot) || TimerSlotGenerations[Entry.UnitSlot] != Entry.SlotGeneration)
         {
-            CombatUnitsArray[i] = Unit;
-            ActiveCombatUnitsCount++;
+            continue;
+        }
 
-            UE_LOG(LogTemp, Warning, TEXT("=== OPTYMALIZACJA CACHE: Dodano jednostkę %s pod indeksem %d (aktywne: %d) ==="),
-                *Unit->GetName(), i, ActiveCombatUnitsCount);
-            return;
+        ABaseUnit* Unit = TimerUnitSlots[Entry.UnitSlot];
+        if (IsValid(Unit))
+        {
+            Unit->HandleCombatTimer(Entry.Action);
         }
     }
-
-    UE_LOG(LogTemp, Error, TEXT("=== OPTYMALIZACJA CACHE: Nie udało się dodać jednostki %s - tablica pełna ==="),
-        *Unit->GetName());
 }
 
 /// <summary>
-/// Usuwa jednostkę ze spakowanej tablicy optymalizacji cache.
+/// Dodaje trafienie do bufora obrażeń bieżącego ticka.
 /// </summary>
-/// <param name="Unit">Jednostka do usunięcia</param>
-void AUnitManager::RemoveUnitFromCombatArray(ABaseUnit* Unit)
+/// <param name="Attacker">Jednostka atakująca</param>
+/// <param name="Target">Jednostka trafiona</param>
+/// <param name="RawDamage">Obrażenia przed uwzględnieniem obrony</param>
+void AUnitManager::QueueDamage(ABaseUnit* Attacker, ABaseUnit* Target, int32 RawDamage)
+{
+    if (!HasAuthority() || !Target || RawDamage <= 0)
+    {
+        return;
+    }
+
+    FPendingDamage& Hit = PendingDamage.AddDefaulted_GetRef();
+    Hit.Attacker = Attacker;
+    Hit.Target = Target;
+    Hit.RawDamage = RawDamage;
+}
+
+/// <summary>
+/// Rozstrzyga wszystkie trafienia z bieżącego ticka: obrona liczona per trafienie, trafienia
+/// w ten sam cel są sumowane i każdy cel otrzymuje jedno powiadomienie (RPC, eventy, śmierć).
+/// </summary>
+void AUnitManager::ResolvePendingDamage()
+{
+    if (!HasAuthority() || PendingDamage.Num() == 0)
+    {
+        return;
+    }
+
+    // Zamiana buforów - śmierć jednostki może zatrzymać walkę i wyczyścić PendingDamage
+    Swap(PendingDamage, ResolvingDamage);
+
+    // Sumowanie obrażeń per cel z zachowaniem kolejności pierwszego trafienia
+    TMap<ABaseUnit*, int32> TargetToIndex;
+    TArray<ABaseUnit*> Targets;
+    TArray<int32> TotalDamage;
+    TArray<int32> HitCounts;
+
+    for (const FPendingDamage& Hit : ResolvingDamage)
+    {
+        ABaseUnit* Target = Hit.Target.Get();
+        if (!Target || !Target->bIsAlive || Target->IsInUnitPool())
+        {
+            continue;
+        }
+
+        // Atakujący zniszczony lub zwrócony do puli po zakolejkowaniu trafienia - wpis nieaktualny
+        const ABaseUnit* Attacker = Hit.Attacker.Get();
+        if (Hit.Attacker.IsStale() || (Attacker && Attacker->IsInUnitPool()))
+        {
+            continue;
+        }
+
+        const int32 ActualDamage = Target->CalculateDamageTaken(Hit.RawDamage);
+        if (const int32* ExistingIndex = TargetToIndex.Find(Target))
+        {
+            TotalDamage[*ExistingIndex] += ActualDamage;
+            HitCounts[*ExistingIndex]++;
+        }
+        else
+        {
+            TargetToIndex.Add(Target, Targets.Add(Target));
+            TotalDamage.Add(ActualDamage);
+            HitCounts.Add(1);
+        }
+    }
+
+    ResolvingDamage.Reset();
+
+    // Jedno zastosowanie obrażeń na cel
+    for (int32 i = 0; i < Targets.Num(); i++)
+    {
+        if (IsValid(Targets[i]) && Targets[i]->bIsAlive)
+        {
+            Targets[i]->ApplyResolvedDamage(TotalDamage[i], HitCounts[i]);
+        }
+    }
+}
+
+/// <summary>
+/// Przetwarza decyzje bojowe jednostek round-robin w ramach budżetu klatki.
+/// Jednostki, których decyzja jest starsza niż 1 / MinUnitRefreshRate, są przetwarzane mimo
+/// przekroczenia budżetu. Pozostałe czekają do następnej klatki.
+/// </summary>
+void AUnitManager::ProcessTimeSlicedCombat()
+{
+    const int32 SlotCount = CombatUnitsArray.Num();
+    if (SlotCount == 0 || !GetWorld())
+    {
+        return;
+    }
+
+    const float WorldTime = GetWorld()->GetTimeSeconds();
+    const float MaxDecisionAge = 1.0f / FMath::Max(MinUnitRefreshRate, 1.0f);
+    const double BudgetSeconds = CombatFrameBudgetMs * 0.001;
+    const double StartTime = FPlatformTime::Seconds();
+
+    FTimeSlicedCombatStats Stats;
+    TimeSliceCursor = TimeSliceCursor % SlotCount;
+
+    // Jedno okrążenie tablicy na klatkę - kolejność round-robin zaczyna od najstarszej decyzji
+    int32 Visited = 0;
+    for (; Visited < SlotCount; Visited++)
+    {
+        ABaseUnit* Unit = CombatUnitsArray[TimeSliceCursor];
+        if (!Unit || !IsValid(Unit) || !Unit->bIsAlive || Unit->bCombatSleeping)
+        {
+            TimeSliceCursor = (TimeSliceCursor + 1) % SlotCount;
+            continue;
+        }
+
+        // Po przekroczeniu budżetu przetwarzane są tylko jednostki ze zbyt starą decyzją
+        const float DecisionAge = Unit->GetCombatDecisionAge(WorldTime);
+        if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds && DecisionAge < MaxDecisionAge)
+        {
+            break;
+        }
+
+        Unit->RunCombatUpdate(WorldTime);
+        Stats.ProcessedUnits++;
+        Stats.WorstStalenessSeconds = FMath::Max(Stats.WorstStalenessSeconds, DecisionAge);
+        TimeSliceCursor = (TimeSliceCursor + 1) % SlotCount;
+    }
+
+    // Jednostki odłożone do następnej klatki i wiek ich decyzji
+    for (int32 Offset = 0; Offset < SlotCount - Visited; Offset++)
+    {
+        ABaseUnit* Unit = CombatUnitsArray[(TimeSliceCursor + Offset) % SlotCount];
+        if (Unit && IsValid(Unit) && Unit->bIsAlive && !Unit->bCombatSleeping)
+        {
+            Stats.DeferredUnits++;
+            Stats.WorstStalenessSeconds = FMath::Max(Stats.WorstStalenessSeconds, Unit->GetCombatDecisionAge(WorldTime));
+        }
+    }
+
+    Stats.SliceTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+    TimeSlicedCombatStats = Stats;
+}
+
+/// <summary>
+/// Zwraca aktualny tick koła czasowego na podstawie czasu świata.
+/// </summary>
+/// <returns>Numer ticka</returns>
+uint32 AUnitManager::GetCurrentTimerTick() const
+{
+    if (!GetWorld() || TimingWheelResolution <= 0.0f)
+    {
+        return 0;
+    }
+
+    return static_cast<uint32>(FMath::FloorToInt(GetWorld()->GetTimeSeconds() / TimingWheelResolution));
+}
+
+/// <summary>
+/// Zwraca tablicę wszystkich żywych jednostek.
+/// </summary>
+/// <returns>Tablica wskaźników do żywych jednostek</returns>
+TArray<ABaseUnit*> AUnitManager::GetAliveUnits() const
+{
+    TArray<ABaseUnit*> AliveUnits;
+
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        if (UnitData.Unit && IsValid(UnitData.Unit) && UnitData.Unit->bIsAlive)
+        {
+            AliveUnits.Add(UnitData.Unit);
+        }
+    }
+
+    return AliveUnits;
+}
+
+/// <summary>
+/// Zwraca tablicę wszystkich jednostek (żywych i martwych).
+/// </summary>
+/// <returns>Tablica wskaźników do wszystkich jednostek</returns>
+TArray<ABaseUnit*> AUnitManager::GetAllUnits() const
+{
+    TArray<ABaseUnit*> AllUnits;
+
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        if (UnitData.Unit && IsValid(UnitData.Unit))
+        {
+            AllUnits.Add(UnitData.Unit);
+        }
+    }
+
+    return AllUnits;
+}
+
+/// <summary>
+/// Inicjalizuje system optymalizacji pamięci podręcznej dla wydajnej walki.
+/// </summary>
+void AUnitManager::InitializeCombatDataLocality()
+{
+    // Tylko serwer inicjalizuje system optymalizacji
+    if (!HasAuthority())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== OPTYMALIZACJA CACHE: Klient pomija inicjalizację ==="));
+        return;
+    }
+
+    if (!GridManagerRef)
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== OPTYMALIZACJA CACHE: Nie można zainicjalizować - GridManagerRef jest null ==="));
+        return;
+    }
+
+    // Obliczenie maksymalnej liczby jednostek bojowych z pozycji spawnu obu graczy
+    const TArray<FGridCell> Player0SpawnPositions = GridManagerRef->GetValidSpawnCells(0);
+    const TArray<FGridCell> Player1SpawnPositions = GridManagerRef->GetValidSpawnCells(1);
+
+    MaxCombatUnits = Player0SpawnPositions.Num() + Player1SpawnPositions.Num();
+
+    // Pre-alokacja tablicy jednostek bojowych dla optymalnej wydajności
+    // Wszystkie jednostki będą obok siebie w pamięci
+    CombatUnitsArray.Empty(MaxCombatUnits);
+    CombatUnitsArray.SetNumZeroed(MaxCombatUnits);
+    ActiveCombatUnitsCount = 0;
+
+    UE_LOG(LogTemp, Warning, TEXT("=== OPTYMALIZACJA CACHE: Zainicjalizowano tablicę z pojemnością: %d (Gracz0: %d, Gracz1: %d) ==="),
+        MaxCombatUnits, Player0SpawnPositions.Num(), Player1SpawnPositions.Num());
+}
+
+/// <summary>
+/// Dodaje jednostkę do spakowanej tablicy optymalizacji cache.
+/// </summary>
+/// <param name="Unit">Jednostka do dodania</param>
+void AUnitManager::AddUnitToCombatArray(ABaseUnit* Unit)
+{
+    if (!HasAuthority() || !Unit || !Unit->bIsAlive)
+    {
+        return;
+    }
+
+    // Sprawdzenie czy tablica jest zainicjalizowana
+    if (CombatUnitsArray.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== OPTYMALIZACJA CACHE: Tablica niezainicjalizowana, inicjalizacja teraz ==="));
+        InitializeCombatDataLocality();
+    }
+
+    if (CombatUnitsArray.Num() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== OPTYMALIZACJA CACHE: Nie udało się zainicjalizować tablicy ==="));
+        return;
+    }
+
+    // Znalezienie pierwszego wolnego slotu w tablicy
+    for (int32 i = 0; i < MaxCombatUnits; i++)
+    {
+        if (CombatUnitsArray[i] == nullptr)
+        {
+            CombatUnitsArray[i] = Unit;
+            ActiveCombatUnitsCount++;
+
+            UE_LOG(LogTemp, Warning, TEXT("=== OPTYMALIZACJA CACHE: Dodano jednostkę %s pod indeksem %d (aktywne: %d) ==="),
+                *Unit->GetName(), i, ActiveCombatUnitsCount);
+            return;
+        }
+    }
+
+    UE_LOG(LogTemp, Error, TEXT("=== OPTYMALIZACJA CACHE: Nie udało się dodać jednostki %s - tablica pełna ==="),
+        *Unit->GetName());
+}
+
+/// <summary>
+/// Usuwa jednostkę ze spakowanej tablicy optymalizacji cache.
+/// </summary>
+/// <param name="Unit">Jednostka do usunięcia</param>
+void AUnitManager::RemoveUnitFromCombatArray(ABaseUnit* Unit)
 {
     if (!HasAuthority() || !Unit)
     {
@@ -831,168 +1407,1352 @@ void AUnitManager::EnableAutoCombatForAllUnits()
         ABaseUnit* Unit = CombatUnitsArray[i];
         if (Unit && IsValid(Unit) && Unit->bIsAlive)
         {
-            UE_LOG(LogTemp, Warning, TEXT("=== WŁĄCZANIE WALKI: Włączanie auto-walki dla jednostki %s (indeks cache: %d) ==="),
-                *Unit->GetName(), i);
-            Unit->StartAutoCombat();
+            UE_LOG(LogTemp, Warning, TEXT("=== WŁĄCZANIE WALKI: Włączanie auto-walki dla jednostki %s (indeks cache: %d) ==="),
+                *Unit->GetName(), i);
+            Unit->StartAutoCombat();
+        }
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== WŁĄCZANIE WALKI: Optymalizacja cache - przetworzono %d jednostek w ciągłej pamięci ==="),
+        ActiveCombatUnitsCount);
+}
+
+/// <summary>
+/// Wyłącza automatyczną walkę dla wszystkich jednostek z optymalizacją cache.
+/// </summary>
+void AUnitManager::DisableAutoCombatForAllUnits()
+{
+    // Sprawdzenie czy tablica walki jest zainicjalizowana
+    if (CombatUnitsArray.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== WYŁĄCZANIE WALKI: Tablica walki niezainicjalizowana, powrót do metody podstawowej ==="));
+
+        // Fallback do oryginalnej metody
+        for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+        {
+            if (UnitData.Unit && IsValid(UnitData.Unit))
+            {
+                UnitData.Unit->StopAutoCombat();
+            }
+        }
+        return;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== WYŁĄCZANIE WALKI: Wyłączanie auto-walki z optymalizacją cache dla %d aktywnych jednostek ==="),
+        ActiveCombatUnitsCount);
+
+    // Iteracja przez ciągłą tablicę aktywnych jednostek
+    for (int32 i = 0; i < ActiveCombatUnitsCount; i++)
+    {
+        ABaseUnit* Unit = CombatUnitsArray[i];
+        if (Unit && IsValid(Unit))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("=== WYŁĄCZANIE WALKI: Wyłączanie auto-walki dla jednostki %s (indeks cache: %d) ==="),
+                *Unit->GetName(), i);
+            Unit->StopAutoCombat();
+        }
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== WYŁĄCZANIE WALKI: Optymalizacja cache - przetworzono %d jednostek w ciągłej pamięci ==="),
+        ActiveCombatUnitsCount);
+}
+
+/// <summary>
+/// Tworzy nową jednostkę dla określonego gracza.
+/// </summary>
+/// <param name="PlayerID">ID gracza (0 lub 1)</param>
+/// <param name="UnitType">Typ jednostki do utworzenia</param>
+/// <returns>Wskaźnik do utworzonej jednostki lub nullptr jeśli się nie powiodło</returns>
+ABaseUnit* AUnitManager::SpawnUnitForPlayer(int32 PlayerID, EBaseUnitType UnitType)
+{
+    return SpawnUnitInternal(PlayerID, UnitType, true);
+}
+
+/// <summary>
+/// Tworzy jednostkę na serwerze. Jednostki z partii spawnu nie wysyłają własnego RPC -
+/// klienci dostają jedno zbiorcze MulticastUnitBatchSpawned po zakończeniu partii.
+/// </summary>
+/// <param name="PlayerID">ID gracza (0 lub 1)</param>
+/// <param name="UnitType">Typ jednostki do utworzenia</param>
+/// <param name="bNotifyClients">Czy wysłać MulticastUnitSpawned dla tej jednostki</param>
+/// <returns>Wskaźnik do utworzonej jednostki lub nullptr jeśli się nie powiodło</returns>
+ABaseUnit* AUnitManager::SpawnUnitInternal(int32 PlayerID, EBaseUnitType UnitType, bool bNotifyClients)
+{
+    // Tylko serwer może tworzyć jednostki
+    if (!HasAuthority())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Klient próbował utworzyć jednostkę"));
+        return nullptr;
+    }
+
+    // Sprawdzenie czy GridManager jest dostępny
+    if (!GridManagerRef)
+    {
+        InitializeGridManager();
+        if (!GridManagerRef)
+        {
+            UE_LOG(LogTemp, Error, TEXT("Brak GridManagera"));
+            return nullptr;
+        }
+    }
+
+    // Znalezienie pierwszej wolnej pozycji do spawnu
+    FGridCell SpawnPosition = FindFirstFreeSpawnPosition(PlayerID);
+    if (SpawnPosition == FGridCell(-1, -1))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Brak wolnej pozycji spawnu dla Gracza %d"), PlayerID);
+        return nullptr;
+    }
+
+    // Pobranie klasy jednostki na podstawie typu
+    TSubclassOf<ABaseUnit> UnitClass = GetUnitClassByType(UnitType);
+    if (!UnitClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Klasa jednostki nie ustawiona dla typu %d"), (int32)UnitType);
+        return nullptr;
+    }
+
+    // Obliczenie pozycji świata i podniesienie nad podłoże
+    FVector WorldLocation = GetWorldLocationFromGrid(SpawnPosition);
+    WorldLocation.Z += 20.0f;
+
+    // Obliczenie rotacji - Gracz 1 obrócony o 180 stopni
+    FRotator SpawnRotation = FRotator::ZeroRotator;
+    if (PlayerID == 1)
+    {
+        SpawnRotation.Yaw = 180.0f;
+        UE_LOG(LogTemp, Verbose, TEXT("=== SPAWN: Gracz 1 - jednostka obrócona o 180 stopni ==="));
+    }
+    else
+    {
+        SpawnRotation.Yaw = 0.0f;
+        UE_LOG(LogTemp, Verbose, TEXT("=== SPAWN: Gracz 0 - domyślna rotacja ==="));
+    }
+
+    // Aktor jednostki z puli lub nowo utworzony w świecie
+    ABaseUnit* SpawnedUnit = AcquireUnit(UnitType, WorldLocation, SpawnRotation);
+
+    if (SpawnedUnit)
+    {
+        // Ustawienie podstawowych właściwości jednostki
+        SpawnedUnit->TeamID = PlayerID;
+        SpawnedUnit->GridPosition = SpawnPosition;
+        SpawnedUnit->UnitType = UnitType;
+
+        // Dodanie do tablicy utworzonych jednostek
+        FSpawnedUnitData UnitData;
+        UnitData.Unit = SpawnedUnit;
+        UnitData.PlayerID = PlayerID;
+        UnitData.GridPosition = SpawnPosition;
+        UnitData.UnitType = UnitType;
+        SpawnedUnits.Add(UnitData);
+        AdjustAliveUnitCount(PlayerID, 1);
+
+        // Dodanie do siatki przestrzennej jeśli walka jest aktywna
+        if (bUseSpatialPartitioning && SpatialGrid && bCombatPhaseActive)
+        {
+            SpatialGrid->AddUnit(SpawnedUnit);
+            UE_LOG(LogTemp, Verbose, TEXT("=== SIATKA PRZESTRZENNA: Dodano utworzoną jednostkę %s do siatki ==="),
+                *SpawnedUnit->GetName());
+        }
+
+        // Dodanie do tablicy optymalizacji cache
+        AddUnitToCombatArray(SpawnedUnit);
+
+        // Jeśli walka jest aktywna, podłączenie zdarzeń i uruchomienie auto-walki
+        if (bCombatPhaseActive)
+        {
+            BindUnitCombatEvents(SpawnedUnit);
+            SpawnedUnit->StartAutoCombat();
+            UE_LOG(LogTemp, Verbose, TEXT("=== SPAWN: Nowa jednostka %s dodana do aktywnej walki ==="),
+                *SpawnedUnit->GetName());
+        }
+
+        // Broadcast zdarzeń spawnu 
+        OnUnitSpawned.Broadcast(SpawnedUnit, PlayerID, SpawnPosition);
+        if (bNotifyClients)
+        {
+            MulticastUnitSpawned(SpawnedUnit, PlayerID, SpawnPosition, UnitType);
+        }
+
+        // Pojedyncze jednostki tylko w Verbose - partia spawnu raportuje się raz w FinishSpawnBatch
+        UE_LOG(LogTemp, Verbose, TEXT("Serwer utworzył jednostkę typu %d dla Gracza %d z rotacją %f stopni"),
+            (int32)UnitType, PlayerID, SpawnRotation.Yaw);
+        return SpawnedUnit;
+    }
+
+    UE_LOG(LogTemp, Error, TEXT("Nie udało się utworzyć jednostki"));
+    return nullptr;
+}
+
+/// <summary>
+/// Dodaje partię żądań spawnu do kolejki. Jednostki powstają w kolejnych klatkach w ramach SpawnFrameBudgetMs,
+/// a po zakończeniu partii serwer wywołuje OnUnitBatchSpawned i wysyła zbiorcze powiadomienie do klientów.
+/// </summary>
+/// <param name="Requests">Żądania (gracz, typ) w kolejności spawnu</param>
+/// <returns>ID partii lub INDEX_NONE, jeśli partia jest pusta albo wywołano ją na kliencie</returns>
+int32 AUnitManager::QueueUnitSpawnBatch(const TArray<FUnitSpawnRequest>& Requests)
+{
+    // Tylko serwer może tworzyć jednostki
+    if (!HasAuthority())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Klient próbował zlecić partię spawnu"));
+        return INDEX_NONE;
+    }
+
+    if (Requests.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    FPendingSpawnBatch& Batch = PendingSpawnBatches.AddDefaulted_GetRef();
+    Batch.BatchID = NextSpawnBatchID++;
+    Batch.Requests = Requests;
+    Batch.Spawned.Reserve(Requests.Num());
+
+    UE_LOG(LogTemp, Warning, TEXT("=== SPAWN PARTII: Zlecono partię %d z %d jednostkami (oczekujące: %d) ==="),
+        Batch.BatchID, Requests.Num(), GetPendingSpawnCount());
+
+    return Batch.BatchID;
+}
+
+/// <summary>
+/// Zwraca liczbę jednostek czekających w kolejce spawnu (żądania serwera lub lokalne kopie klienta).
+/// </summary>
+/// <returns>Liczba oczekujących jednostek</returns>
+int32 AUnitManager::GetPendingSpawnCount() const
+{
+    int32 PendingCount = PendingClientSpawns.Num();
+    for (const FPendingSpawnBatch& Batch : PendingSpawnBatches)
+    {
+        PendingCount += Batch.Requests.Num() - Batch.NextRequest;
+    }
+
+    return PendingCount;
+}
+
+/// <summary>
+/// Sprawdza czy budżet klatki na tworzenie jednostek (czas i liczba) jest wyczerpany.
+/// Pierwsza jednostka w klatce zawsze się mieści, żeby kolejka postępowała niezależnie od budżetu.
+/// </summary>
+/// <param name="SpawnedThisFrame">Liczba jednostek utworzonych w tej klatce</param>
+/// <param name="StartTime">Czas rozpoczęcia przetwarzania kolejki w tej klatce</param>
+/// <returns>True jeśli kolejne jednostki muszą poczekać do następnej klatki</returns>
+bool AUnitManager::IsSpawnFrameBudgetExhausted(int32 SpawnedThisFrame, double StartTime) const
+{
+    if (SpawnedThisFrame == 0)
+    {
+        return false;
+    }
+
+    if (MaxSpawnsPerFrame > 0 && SpawnedThisFrame >= MaxSpawnsPerFrame)
+    {
+        return true;
+    }
+
+    return SpawnFrameBudgetMs > 0.0f && FPlatformTime::Seconds() - StartTime >= SpawnFrameBudgetMs * 0.001;
+}
+
+/// <summary>
+/// Tworzy jednostki z kolejki partii, dopóki nie skończy się budżet klatki. Bez budżetu (np. przed
+/// rozpoczęciem walki) opróżnia całą kolejkę od razu.
+/// </summary>
+/// <param name="bWithinFrameBudget">Czy przestrzegać budżetu klatki</param>
+void AUnitManager::ProcessSpawnQueue(bool bWithinFrameBudget)
+{
+    if (PendingSpawnBatches.Num() == 0)
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    int32 SpawnedThisFrame = 0;
+
+    while (PendingSpawnBatches.Num() > 0)
+    {
+        // Dostęp przez indeks - zdarzenia spawnu mogą dopisać kolejną partię do tablicy
+        while (PendingSpawnBatches[0].NextRequest < PendingSpawnBatches[0].Requests.Num())
+        {
+            if (bWithinFrameBudget && IsSpawnFrameBudgetExhausted(SpawnedThisFrame, StartTime))
+            {
+                return;
+            }
+
+            const FUnitSpawnRequest Request = PendingSpawnBatches[0].Requests[PendingSpawnBatches[0].NextRequest++];
+            ABaseUnit* SpawnedUnit = SpawnUnitInternal(Request.PlayerID, Request.UnitType, false);
+            SpawnedThisFrame++;
+
+            if (SpawnedUnit)
+            {
+                FSpawnedUnitData& UnitData = PendingSpawnBatches[0].Spawned.AddDefaulted_GetRef();
+                UnitData.Unit = SpawnedUnit;
+                UnitData.PlayerID = Request.PlayerID;
+                UnitData.GridPosition = SpawnedUnit->GridPosition;
+                UnitData.UnitType = Request.UnitType;
+            }
+            else
+            {
+                PendingSpawnBatches[0].Failed.Add(Request);
+            }
+        }
+
+        FinishSpawnBatch();
+    }
+}
+
+/// <summary>
+/// Zamyka pierwszą partię z kolejki - jedno zdarzenie na serwerze i zbiorcze powiadomienie klientów.
+/// </summary>
+void AUnitManager::FinishSpawnBatch()
+{
+    // Rozmiar paczki RPC - duża partia nie może przekroczyć limitu rozmiaru niezawodnego RPC
+    constexpr int32 MaxUnitsPerNotification = 256;
+
+    FPendingSpawnBatch Batch = MoveTemp(PendingSpawnBatches[0]);
+    PendingSpawnBatches.RemoveAt(0);
+
+    for (int32 First = 0; First < Batch.Spawned.Num(); First += MaxUnitsPerNotification)
+    {
+        const int32 Count = FMath::Min(MaxUnitsPerNotification, Batch.Spawned.Num() - First);
+        MulticastUnitBatchSpawned(TArray<FSpawnedUnitData>(Batch.Spawned.GetData() + First, Count));
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== SPAWN PARTII: Partia %d zakończona - utworzono %d, nieudane %d ==="),
+        Batch.BatchID, Batch.Spawned.Num(), Batch.Failed.Num());
+
+    OnUnitBatchSpawned.Broadcast(Batch.BatchID, Batch.Spawned, Batch.Failed);
+    OnUnitBatchSpawnedNative.Broadcast(Batch.BatchID, Batch.Spawned, Batch.Failed);
+}
+
+/// <summary>
+/// Tworzy lokalne kopie jednostek ze zbiorczych powiadomień w ramach budżetu klatki (klient).
+/// </summary>
+void AUnitManager::ProcessClientSpawnQueue()
+{
+    if (PendingClientSpawns.Num() == 0)
+    {
+        return;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    int32 Processed = 0;
+    while (Processed < PendingClientSpawns.Num())
+    {
+        if (IsSpawnFrameBudgetExhausted(Processed, StartTime))
+        {
+            break;
+        }
+
+        const FSpawnedUnitData& UnitData = PendingClientSpawns[Processed++];
+        SpawnClientUnitCopy(UnitData.PlayerID, UnitData.GridPosition, UnitData.UnitType);
+    }
+
+    PendingClientSpawns.RemoveAt(0, Processed, EAllowShrinking::No);
+}
+
+/// <summary>
+/// Pobiera jednostkę danego typu z puli (z pełnym resetem stanu) lub tworzy nowego aktora, gdy pula jest pusta.
+/// </summary>
+/// <param name="UnitType">Typ jednostki</param>
+/// <param name="Location">Pozycja w świecie</param>
+/// <param name="Rotation">Rotacja jednostki</param>
+/// <returns>Aktywna jednostka lub nullptr, jeśli typ nie ma przypisanej klasy</returns>
+ABaseUnit* AUnitManager::AcquireUnit(EBaseUnitType UnitType, const FVector& Location, const FRotator& Rotation)
+{
+    if (bUseUnitPool)
+    {
+        TArray<ABaseUnit*>& Bucket = GetUnitPoolBucket(UnitType);
+        while (Bucket.Num() > 0)
+        {
+            ABaseUnit* PooledUnit = Bucket.Pop(EAllowShrinking::No);
+            if (IsValid(PooledUnit))
+            {
+                PooledUnit->ActivateFromPool(Location, Rotation);
+                return PooledUnit;
+            }
+        }
+    }
+
+    TSubclassOf<ABaseUnit> UnitClass = GetUnitClassByType(UnitType);
+    if (!UnitClass || !GetWorld())
+    {
+        return nullptr;
+    }
+
+    // Parametry spawnu z automatycznym dostosowaniem pozycji przy kolizji
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+    return GetWorld()->SpawnActor<ABaseUnit>(UnitClass, Location, Rotation, SpawnParams);
+}
+
+/// <summary>
+/// Usuwa jednostkę z gry i odkłada jej aktora do puli. Aktor replikowany z serwera (po stronie klienta),
+/// wyłączona pula lub pełny kubełek typu oznaczają zwykłe zniszczenie aktora.
+/// </summary>
+/// <param name="Unit">Jednostka do zwolnienia</param>
+void AUnitManager::ReleaseUnit(ABaseUnit* Unit)
+{
+    if (!IsValid(Unit) || Unit->IsInUnitPool())
+        return;
+
+    if (HasAuthority())
+    {
+        // Martwe jednostki opuściły tablicę walki w HandleUnitDeath
+        if (CombatUnitsArray.Contains(Unit))
+        {
+            RemoveUnitFromCombatArray(Unit);
+        }
+
+        UnbindUnitCombatEvents(Unit);
+        RemoveUnitFromArray(Unit);
+    }
+    else
+    {
+        RemoveUnitFromClientArray(Unit);
+    }
+
+    TArray<ABaseUnit*>& Bucket = GetUnitPoolBucket(Unit->UnitType);
+    if (!bUseUnitPool || !Unit->HasAuthority() || Bucket.Num() >= MaxPooledUnitsPerType)
+    {
+        Unit->Destroy();
+        return;
+    }
+
+    Unit->DeactivateForPool();
+    Bucket.Add(Unit);
+}
+
+/// <summary>
+/// Tworzy z góry aktorów jednostek według UnitPoolPrewarmCounts, żeby pierwsza runda nie płaciła za spawn.
+/// </summary>
+void AUnitManager::PrewarmUnitPool()
+{
+    if (!bUseUnitPool || !GetWorld())
+        return;
+
+    // Aktory tworzone pod planszą - i tak od razu trafiają ukryte do puli
+    const FVector ParkingLocation = GetActorLocation() - FVector(0.0f, 0.0f, 10000.0f);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    int32 CreatedCount = 0;
+    for (const TPair<EBaseUnitType, int32>& Prewarm : UnitPoolPrewarmCounts)
+    {
+        TSubclassOf<ABaseUnit> UnitClass = GetUnitClassByType(Prewarm.Key);
+        if (!UnitClass)
+            continue;
+
+        TArray<ABaseUnit*>& Bucket = GetUnitPoolBucket(Prewarm.Key);
+        const int32 TargetCount = FMath::Min(Prewarm.Value, MaxPooledUnitsPerType);
+        while (Bucket.Num() < TargetCount)
+        {
+            ABaseUnit* Unit = GetWorld()->SpawnActor<ABaseUnit>(UnitClass, ParkingLocation, FRotator::ZeroRotator, SpawnParams);
+            if (!Unit)
+                break;
+
+            Unit->UnitType = Prewarm.Key;
+            Unit->DeactivateForPool();
+            Bucket.Add(Unit);
+            CreatedCount++;
+        }
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== PULA JEDNOSTEK: Utworzono z góry %d aktorów - Autorytet: %s ==="),
+        CreatedCount, HasAuthority() ? TEXT("SERWER") : TEXT("KLIENT"));
+}
+
+/// <summary>
+/// Zwraca liczbę nieaktywnych jednostek danego typu czekających w puli.
+/// </summary>
+/// <param name="UnitType">Typ jednostki</param>
+/// <returns>Liczba jednostek w puli</returns>
+int32 AUnitManager::GetPooledUnitCount(EBaseUnitType UnitType) const
+{
+    const int32 TypeIndex = static_cast<int32>(UnitType);
+    return UnitPool.IsValidIndex(TypeIndex) ? UnitPool[TypeIndex].Units.Num() : 0;
+}
+
+/// <summary>
+/// Wyznacza obszar bitwy - prostokąt fragmentów planszy z żywymi jednostkami powiększony
+/// o BattleRegionMarginChunks fragmentów - i przygotowuje na nim pola przepływu, serwis ścieżek
+/// i tablicę rezerwacji. Pamięć i czas ich przygotowania rosną z obszarem walki, a nie z rozmiarem
+/// planszy. Bez wymuszenia obszar jest budowany od nowa dopiero, gdy jednostka zbliży się do jego
+/// krawędzi (innej niż krawędź planszy) na mniej niż połowę marginesu.
+/// </summary>
+/// <param name="bForce">true - budowa niezależnie od położenia jednostek (start walki)</param>
+void AUnitManager::UpdateBattleRegion(bool bForce)
+{
+    if (!bUseFlowFields && !bUseGridPathfinding && !bUseCellReservations)
+    {
+        return;
+    }
+
+    // Prostokąt komórek żywych jednostek (włącznie z Max)
+    FGridCell UnitsMin(MAX_int32, MAX_int32);
+    FGridCell UnitsMax(MIN_int32, MIN_int32);
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        FGridCell Cell;
+        if (UnitData.Unit && IsValid(UnitData.Unit) && UnitData.Unit->bIsAlive && GetPathCell(UnitData.Unit->GetActorLocation(), Cell))
+        {
+            UnitsMin = UnitsMin.ComponentMin(Cell);
+            UnitsMax = UnitsMax.ComponentMax(Cell);
+        }
+    }
+
+    const bool bHasUnits = UnitsMin.X <= UnitsMax.X;
+    const int32 Margin = FMath::Max(BattleRegionMarginChunks, 1) * FGridNavigationLayer::ChunkSize;
+    if (!bForce)
+    {
+        if (!bHasUnits || !GridManagerRef)
+        {
+            return;
+        }
+
+        const int32 EdgeDistance = Margin / 2;
+        const bool bAwayFromEdges =
+            (BattleRegion.Min.X == 0 || UnitsMin.X - BattleRegion.Min.X >= EdgeDistance) &&
+            (BattleRegion.Min.Y == 0 || UnitsMin.Y - BattleRegion.Min.Y >= EdgeDistance) &&
+            (BattleRegion.Max.X == GridManagerRef->GridWidth || BattleRegion.Max.X - 1 - UnitsMax.X >= EdgeDistance) &&
+            (BattleRegion.Max.Y == GridManagerRef->GridHeight || BattleRegion.Max.Y - 1 - UnitsMax.Y >= EdgeDistance);
+        if (bAwayFromEdges)
+        {
+            return;
+        }
+    }
+
+    // Prostokąt jednostek z marginesem, wyrównany do fragmentów i przycięty do planszy
+    BattleRegion = FIntRect();
+    if (bHasUnits && GridManagerRef)
+    {
+        const FGridCell MinChunk = FGridNavigationLayer::GetChunkCoord(UnitsMin - FGridCell(Margin, Margin));
+        const FGridCell MaxChunk = FGridNavigationLayer::GetChunkCoord(UnitsMax + FGridCell(Margin, Margin));
+        BattleRegion.Min = (MinChunk * FGridNavigationLayer::ChunkSize).ComponentMax(FGridCell()).ToIntPoint();
+        BattleRegion.Max = ((MaxChunk + FGridCell(1, 1)) * FGridNavigationLayer::ChunkSize).ComponentMin(FGridCell(GridManagerRef->GridWidth, GridManagerRef->GridHeight)).ToIntPoint();
+    }
+
+    if (bUseFlowFields)
+    {
+        InitializeFlowFields();
+    }
+
+    // Cache z poprzedniego obszaru (i poprzedniej rundy) nie ma już znaczenia
+    if (bUseGridPathfinding)
+    {
+        InitializePathService();
+    }
+
+    if (bUseCellReservations)
+    {
+        CellReservations.Initialize(BattleRegion.Width(), BattleRegion.Height());
+        ReservationClaimants.Reset();
+        ReservationClaims.Reset();
+    }
+
+    // Przeszkody i koszty terenu z warstwy nawigacji planszy
+    ApplyNavigationLayerToBattleRegion(true);
+
+    UE_LOG(LogTemp, Warning, TEXT("=== OBSZAR BITWY: Komórki (%d, %d) - (%d, %d), siatka %dx%d ==="),
+        BattleRegion.Min.X, BattleRegion.Min.Y, BattleRegion.Max.X - 1, BattleRegion.Max.Y - 1,
+        BattleRegion.Width(), BattleRegion.Height());
+}
+
+/// <summary>
+/// Komórka planszy we współrzędnych obszaru bitwy (pól przepływu, serwisu ścieżek i tablicy rezerwacji).
+/// </summary>
+/// <param name="Cell">Komórka planszy</param>
+/// <param name="OutLocalCell">Komórka względem BattleRegion.Min</param>
+/// <returns>true jeśli komórka leży w obszarze bitwy, false - wpp</returns>
+bool AUnitManager::ToBattleRegionCell(const FGridCell& Cell, FGridCell& OutLocalCell) const
+{
+    if (!BattleRegion.Contains(Cell.ToIntPoint()))
+    {
+        return false;
+    }
+
+    OutLocalCell = Cell - FGridCell(BattleRegion.Min);
+    return true;
+}
+
+/// <summary>
+/// Przygotowuje pola przepływu obu drużyn dla obszaru bitwy.
+/// </summary>
+void AUnitManager::InitializeFlowFields()
+{
+    if (!GridManagerRef || BattleRegion.Area() <= 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== POLA PRZEPŁYWU: Brak GridManagera lub obszaru bitwy - ruch bez pól przepływu ==="));
+        for (FBattleFlowField& FlowField : TeamFlowFields)
+        {
+            FlowField.Reset();
+        }
+        return;
+    }
+
+    // Pierwsza komórka obszaru bitwy wyznacza początek układu pól
+    const FVector RegionOrigin = GridManagerRef->GetWorldLocationFromCell(FGridCell(BattleRegion.Min));
+    for (FBattleFlowField& FlowField : TeamFlowFields)
+    {
+        FlowField.Initialize(BattleRegion.Width(), BattleRegion.Height(), GridManagerRef->CellSize, RegionOrigin);
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== POLA PRZEPŁYWU: Zainicjalizowano siatkę %dx%d ==="),
+        BattleRegion.Width(), BattleRegion.Height());
+}
+
+/// <summary>
+/// Kopiuje blokady i koszty ruchu z warstwy nawigacji GridManagera do obszaru bitwy (pola przepływu
+/// obu drużyn i blokady serwisu ścieżek). Z wymuszeniem kopiuje cały obszar z fragmentów, które go
+/// przecinają; bez wymuszenia - po zmianie rewizji warstwy - tylko część obszaru we fragmentach
+/// zmienionych od ostatniej kopii. Pola przeliczą się przy najbliższym CommitGoals.
+/// </summary>
+/// <param name="bForce">true - kopiowanie całego obszaru niezależnie od rewizji (po zmianie obszaru)</param>
+void AUnitManager::ApplyNavigationLayerToBattleRegion(bool bForce)
+{
+    if (!GridManagerRef || BattleRegion.Area() <= 0)
+    {
+        return;
+    }
+
+    const FGridNavigationLayer& NavigationLayer = GridManagerRef->GetNavigationLayer();
+    if (!NavigationLayer.IsInitialized())
+    {
+        return;
+    }
+
+    // Warstwa zbudowana od nowa po ostatniej kopii - zmienione fragmenty nie opisują już różnic
+    bForce = bForce || AppliedNavigationRevision < NavigationLayer.GetLayoutRevision();
+    if (!bForce && NavigationLayer.GetRevision() == AppliedNavigationRevision)
+    {
+        return;
+    }
+
+    const int32 RegionWidth = BattleRegion.Width();
+    const auto ApplyCell = [this, RegionWidth](const FGridCell& LocalCell, bool bBlocked, uint8 MoveCost)
+    {
+        NavigationBlockedCells[LocalCell.ToIndex(RegionWidth)] = bBlocked;
+        for (FBattleFlowField& FlowField : TeamFlowFields)
+        {
+            FlowField.SetCellBlocked(LocalCell.X, LocalCell.Y, bBlocked);
+            FlowField.SetCellMoveCost(LocalCell.X, LocalCell.Y, MoveCost);
+        }
+    };
+
+    if (bForce || NavigationBlockedCells.Num() != BattleRegion.Area())
+    {
+        TArray<uint8> MoveCosts;
+        NavigationLayer.GetBlockedCells(BattleRegion, NavigationBlockedCells);
+        NavigationLayer.GetMoveCosts(BattleRegion, MoveCosts);
+        for (int32 CellIndex = 0; CellIndex < MoveCosts.Num(); CellIndex++)
+        {
+            ApplyCell(FGridCell::FromIndex(CellIndex, RegionWidth), NavigationBlockedCells[CellIndex], MoveCosts[CellIndex]);
+        }
+    }
+    else
+    {
+        NavigationLayer.GetChangedChunks(AppliedNavigationRevision, ChangedNavigationChunks);
+        const FGridCell RegionMin(BattleRegion.Min);
+        const FGridCell RegionMax(BattleRegion.Max);
+        for (const FGridCell& ChunkCoord : ChangedNavigationChunks)
+        {
+            const FGridCell ChunkMin = (ChunkCoord * FGridNavigationLayer::ChunkSize).ComponentMax(RegionMin);
+            const FGridCell ChunkMax = ((ChunkCoord + FGridCell(1, 1)) * FGridNavigationLayer::ChunkSize).ComponentMin(RegionMax);
+            for (int32 Y = ChunkMin.Y; Y < ChunkMax.Y; Y++)
+            {
+                for (int32 X = ChunkMin.X; X < ChunkMax.X; X++)
+                {
+                    const FGridCell Cell(X, Y);
+                    ApplyCell(Cell - RegionMin, NavigationLayer.IsCellBlocked(Cell), NavigationLayer.GetMoveCost(Cell));
+                }
+            }
+        }
+    }
+
+    AppliedNavigationRevision = NavigationLayer.GetRevision();
+}
+
+/// <summary>
+/// Zbiera zajętość komórek przez żywe jednostki i przelicza pole drużyny tylko wtedy,
+/// gdy zmieniła się zajętość komórek jej wrogów.
+/// </summary>
+void AUnitManager::UpdateFlowFields()
+{
+    if (!TeamFlowFields[0].IsInitialized() || !TeamFlowFields[1].IsInitialized())
+    {
+        return;
+    }
+
+    ApplyNavigationLayerToBattleRegion(false);
+
+    TeamFlowFields[0].BeginGoals();
+    TeamFlowFields[1].BeginGoals();
+
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        ABaseUnit* Unit = UnitData.Unit;
+        if (Unit && IsValid(Unit) && Unit->bIsAlive && (Unit->TeamID == 0 || Unit->TeamID == 1))
+        {
+            // Jednostka jest celem dla pola przeciwnej drużyny
+            TeamFlowFields[1 - Unit->TeamID].AddGoal(Unit->GetActorLocation());
+        }
+    }
+
+    TeamFlowFields[0].CommitGoals();
+    TeamFlowFields[1].CommitGoals();
+}
+
+/// <summary>
+/// Kierunek ruchu jednostki z pola przepływu jej drużyny.
+/// </summary>
+/// <param name="TeamID">Drużyna jednostki</param>
+/// <param name="WorldLocation">Pozycja jednostki</param>
+/// <param name="TargetDistanceSq">Kwadrat odległości do aktualnego celu jednostki</param>
+/// <param name="OutDirection">Znormalizowany kierunek w płaszczyźnie XY</param>
+/// <returns>true jeśli jednostka powinna podążać za polem, false - ruch bezpośrednio na cel</returns>
+bool AUnitManager::SampleFlowDirection(int32 TeamID, const FVector& WorldLocation, float TargetDistanceSq, FVector& OutDirection) const
+{
+    if (!bUseFlowFields || !bCombatPhaseActive || TargetDistanceSq <= FMath::Square(FlowFieldDirectApproachDistance))
+    {
+        return false;
+    }
+
+    const FBattleFlowField* FlowField = GetTeamFlowField(TeamID);
+    return FlowField && FlowField->SampleDirection(WorldLocation, OutDirection);
+}
+
+/// <summary>
+/// Pole przepływu drużyny.
+/// </summary>
+/// <param name="TeamID">Drużyna (0 lub 1)</param>
+/// <returns>Pole lub nullptr dla nieznanej drużyny</returns>
+const FBattleFlowField* AUnitManager::GetTeamFlowField(int32 TeamID) const
+{
+    return (TeamID == 0 || TeamID == 1) ? &TeamFlowFields[TeamID] : nullptr;
+}
+
+/// <summary>
+/// Przygotowuje serwis ścieżek dla obszaru bitwy. Zapytania w toku przepadają razem z poprzednim
+/// obszarem - zleceniodawcy dostają pusty wynik i mogą zapytać ponownie.
+/// </summary>
+void AUnitManager::InitializePathService()
+{
+    for (const TPair<int32, TWeakObjectPtr<ABaseUnit>>& Requester : PathRequesters)
+    {
+        if (Requester.Value.IsValid())
+        {
+            FGridPathResult DroppedResult;
+            DroppedResult.RequestID = Requester.Key;
+            Requester.Value->ReceiveGridPath(DroppedResult);
+        }
+    }
+    PathRequesters.Reset();
+
+    if (!GridManagerRef || BattleRegion.Area() <= 0)
+    {
+        PathService.Reset();
+        PathOccupancy.Reset();
+        return;
+    }
+
+    PathService.Initialize(BattleRegion.Width(), BattleRegion.Height());
+    PathOccupancy.Init(false, BattleRegion.Area());
+}
+
+/// <summary>
+/// Aktualizuje zajętość komórek (epoka serwisu rośnie tylko po zmianie), odbiera gotowe trasy
+/// i przekazuje je jednostkom, które o nie prosiły.
+/// </summary>
+void AUnitManager::UpdatePathService()
+{
+    if (bCombatPhaseActive)
+    {
+        // Przeszkody z warstwy nawigacji w obszarze bitwy, a na nie zajętość komórek przez żywe jednostki
+        // (kopia z ApplyNavigationLayerToBattleRegion - fragmenty warstwy nie są tu przeglądane co tick)
+        ApplyNavigationLayerToBattleRegion(false);
+        if (NavigationBlockedCells.Num() == PathOccupancy.Num())
+        {
+            FMemory::Memcpy(PathOccupancy.GetData(), NavigationBlockedCells.GetData(), PathOccupancy.Num() * sizeof(bool));
+        }
+        else
+        {
+            FMemory::Memzero(PathOccupancy.GetData(), PathOccupancy.Num() * sizeof(bool));
+        }
+
+        for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+        {
+            FGridCell Cell;
+            if (UnitData.Unit && IsValid(UnitData.Unit) && UnitData.Unit->bIsAlive &&
+                GetPathCell(UnitData.Unit->GetActorLocation(), Cell) && ToBattleRegionCell(Cell, Cell))
+            {
+                PathOccupancy[Cell.ToIndex(BattleRegion.Width())] = true;
+            }
+        }
+
+        PathService.SetBlockedCells(PathOccupancy);
+    }
+
+    PathResults.Reset();
+    PathService.Tick(PathResults);
+
+    for (FGridPathResult& Result : PathResults)
+    {
+        TWeakObjectPtr<ABaseUnit> Requester;
+        if (PathRequesters.RemoveAndCopyValue(Result.RequestID, Requester) && Requester.IsValid())
+        {
+            // Trasa w komórkach planszy, tak jak komórki z GetPathCell
+            for (FGridCell& PathCell : Result.Path)
+            {
+                PathCell += FGridCell(BattleRegion.Min);
+            }
+            Requester->ReceiveGridPath(Result);
+        }
+    }
+}
+
+/// <summary>
+/// Zleca wyszukanie trasy dla jednostki. Wynik trafia do ABaseUnit::ReceiveGridPath w kolejnym ticku.
+/// </summary>
+/// <param name="Unit">Jednostka zlecająca</param>
+/// <param name="StartCell">Komórka jednostki</param>
+/// <param name="GoalCell">Komórka celu</param>
+/// <returns>ID zapytania lub INDEX_NONE (także dla komórek poza obszarem bitwy)</returns>
+int32 AUnitManager::RequestUnitPath(ABaseUnit* Unit, const FGridCell& StartCell, const FGridCell& GoalCell)
+{
+    FGridCell LocalStart;
+    FGridCell LocalGoal;
+    if (!HasAuthority() || !bUseGridPathfinding || !Unit || !PathService.IsInitialized() ||
+        !ToBattleRegionCell(StartCell, LocalStart) || !ToBattleRegionCell(GoalCell, LocalGoal))
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 RequestID = PathService.RequestPath(LocalStart, LocalGoal);
+    if (RequestID != INDEX_NONE)
+    {
+        PathRequesters.Add(RequestID, Unit);
+    }
+
+    return RequestID;
+}
+
+/// <summary>
+/// Komórka siatki pod pozycją świata.
+/// </summary>
+/// <param name="WorldLocation">Pozycja w przestrzeni świata</param>
+/// <param name="OutCell">Komórka siatki</param>
+/// <returns>true jeśli pozycja leży na siatce, false - wpp</returns>
+bool AUnitManager::GetPathCell(const FVector& WorldLocation, FGridCell& OutCell) const
+{
+    if (!GridManagerRef)
+    {
+        return false;
+    }
+
+    const FGridCell Cell = GridManagerRef->GetCellFromWorld(WorldLocation);
+    if (!GridManagerRef->IsValidCell(Cell))
+    {
+        return false;
+    }
+
+    OutCell = Cell;
+    return true;
+}
+
+/// <summary>
+/// Środek komórki siatki w przestrzeni świata.
+/// </summary>
+FVector AUnitManager::GetPathCellWorldLocation(const FGridCell& Cell) const
+{
+    return GridManagerRef ? GridManagerRef->GetWorldLocationFromCell(Cell) : FVector::ZeroVector;
+}
+
+/// <summary>
+/// Czy komórka jest zajęta przez żywą jednostkę (według ostatniej migawki serwisu ścieżek).
+/// Poza obszarem bitwy nie ma jednostek.
+/// </summary>
+bool AUnitManager::IsPathCellBlocked(const FGridCell& Cell) const
+{
+    FGridCell LocalCell;
+    return ToBattleRegionCell(Cell, LocalCell) && PathService.IsCellBlocked(LocalCell);
+}
+
+/// <summary>
+/// Czy pozycja leży w przechodniej komórce planszy - odczyt warstwy nawigacji zamiast zapytań fizyki.
+/// </summary>
+/// <param name="WorldLocation">Pozycja w przestrzeni świata</param>
+/// <returns>true jeśli pozycja nie leży w przeszkodzie (lub brak GridManagera), false - wpp</returns>
+bool AUnitManager::IsWorldPositionNavigable(const FVector& WorldLocation) const
+{
+    return !GridManagerRef || GridManagerRef->IsWorldLocationWalkable(WorldLocation);
+}
+
+/// <summary>
+/// Czy krok jednostki do innej komórki musi przejść przez tablicę rezerwacji.
+/// </summary>
+bool AUnitManager::IsCellReservationEnabled() const
+{
+    return bUseCellReservations && bCombatPhaseActive && CellReservations.IsInitialized();
+}
+
+/// <summary>
+/// Zgłoszenie ruchu jednostki do komórki w bieżącym ticku - trafia do migawki zgłoszeń,
+/// rozstrzyganej po decyzjach wszystkich jednostek. Wynik jednostka dostaje
+/// w ABaseUnit::ResolveReservedMove.
+/// </summary>
+/// <param name="Unit">Jednostka zgłaszająca</param>
+/// <param name="Cell">Komórka docelowa</param>
+/// <param name="Priority">Priorytet zgłoszenia - wyższy wygrywa konflikt</param>
+/// <param name="bCanEnterOccupied">Czy jednostka może wejść do komórki zajętej (komórka jej celu)</param>
+/// <returns>true jeśli zgłoszenie czeka na rozstrzygnięcie, false - wpp</returns>
+bool AUnitManager::ClaimMoveCell(ABaseUnit* Unit, const FGridCell& Cell, uint32 Priority, bool bCanEnterOccupied)
+{
+    FGridCell FromCell;
+    FGridCell LocalCell;
+    if (!Unit || !IsCellReservationEnabled() || ReservationClaimants.Num() > FCellReservationTable::MaxClaimantID ||
+        !GetPathCell(Unit->GetActorLocation(), FromCell) || !ToBattleRegionCell(FromCell, FromCell) || !ToBattleRegionCell(Cell, LocalCell))
+    {
+        return false;
+    }
+
+    // Tablica rezerwacji ma wymiary obszaru bitwy
+    FCellMoveClaim& Claim = ReservationClaims.AddDefaulted_GetRef();
+    Claim.FromCell = FromCell;
+    Claim.Cell = LocalCell;
+    Claim.Priority = Priority;
+    Claim.bCanEnterOccupied = bCanEnterOccupied;
+    ReservationClaimants.Add(Unit);
+    return true;
+}
+
+/// <summary>
+/// Nowy tick rezerwacji - zapis komórek żywych jednostek, z których zwolnieniem rozstrzyga się
+/// zgłoszenia do komórek zajętych.
+/// </summary>
+void AUnitManager::BeginCellReservationTick()
+{
+    CellReservations.BeginTick();
+    ReservationOccupiedCells.Reset();
+
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        FGridCell Cell;
+        if (UnitData.Unit && IsValid(UnitData.Unit) && UnitData.Unit->bIsAlive &&
+            GetPathCell(UnitData.Unit->GetActorLocation(), Cell) && ToBattleRegionCell(Cell, Cell))
+        {
+            ReservationOccupiedCells.Add(Cell);
+        }
+    }
+}
+
+/// <summary>
+/// Kończy fazę zgłoszeń: migawka zgłoszeń trafia równolegle do tablicy rezerwacji, a zwycięzcy
+/// wykonują krok w kolejności zależności - jednostka wchodząca do zajętej komórki rusza po tym,
+/// jak jej mieszkaniec z niej wyjdzie. Przegrani zostają na miejscu.
+/// </summary>
+/// <param name="bGrantMoves">false - wszystkie zgłoszenia odrzucone (np. przerwana walka)</param>
+void AUnitManager::ResolveCellReservations(bool bGrantMoves)
+{
+    TBitArray<> ResolvedClaims(false, ReservationClaims.Num());
+    if (bGrantMoves && ReservationClaims.Num() > 0)
+    {
+        CellReservations.ClaimAll(ReservationClaims);
+        CellReservations.ResolveClaims(ReservationClaims, ReservationOccupiedCells, [this](int32 ClaimIndex)
+            {
+                ABaseUnit* Unit = ReservationClaimants[ClaimIndex].Get();
+                return Unit && Unit->ResolveReservedMove(true);
+            },
+            ResolvedClaims);
+    }
+
+    for (int32 ClaimantID = 0; ClaimantID < ReservationClaimants.Num(); ClaimantID++)
+    {
+        ABaseUnit* Unit = ReservationClaimants[ClaimantID].Get();
+        if (Unit && !ResolvedClaims[ClaimantID])
+        {
+            Unit->ResolveReservedMove(false);
+        }
+    }
+
+    ReservationClaimants.Reset();
+    ReservationClaims.Reset();
+}
+
+/// <summary>
+/// Czy kroki jednostek są korygowane przez unikanie kolizji ORCA.
+/// </summary>
+bool AUnitManager::IsLocalAvoidanceEnabled() const
+{
+    return bUseLocalAvoidance && bCombatPhaseActive && SpatialGrid != nullptr;
+}
+
+/// <summary>
+/// Unikanie kolizji w dwóch fazach: migawka siatki przestrzennej z prędkościami pożądanymi
+/// zgłoszonymi w tej klatce, rozwiązanie ORCA równolegle dla wszystkich idących jednostek,
+/// a potem przekazanie wyników jednostkom na wątku gry - użyją ich w kolejnym kroku.
+/// </summary>
+void AUnitManager::UpdateLocalAvoidance()
+{
+    SpatialGrid->BuildAvoidanceSnapshot(AvoidanceSnapshot, AvoidanceUnits);
+
+    FAvoidanceParams Params;
+    Params.AgentRadius = AvoidanceRadius;
+    Params.NeighborDistance = AvoidanceNeighborDistance;
+    Params.MaxNeighbors = AvoidanceMaxNeighbors;
+    Params.TimeHorizon = AvoidanceTimeHorizon;
+
+    FLocalAvoidance::ComputeVelocities(AvoidanceSnapshot, Params, AvoidanceVelocities, true);
+
+    for (int32 EntryIndex = 0; EntryIndex < AvoidanceUnits.Num(); EntryIndex++)
+    {
+        AvoidanceUnits[EntryIndex]->SetAvoidanceVelocity(AvoidanceVelocities[EntryIndex]);
+    }
+}
+
+/// <summary>
+/// Czy kroki jednostek są całkowane z czasem klatki i zapisywane w jednym przebiegu managera.
+/// Bitwa lockstep ma własny, stały krok symulacji.
+/// </summary>
+bool AUnitManager::IsBatchedMovementEnabled() const
+{
+    return bUseBatchedMovement && HasAuthority() && !LockstepSession.IsActive();
+}
+
+/// <summary>
+/// Zgłoszenie kroku jednostki - transformację zapisze FlushUnitMoves po tickach wszystkich jednostek.
+/// </summary>
+/// <param name="Unit">Jednostka</param>
+/// <param name="NewLocation">Pozycja po kroku</param>
+void AUnitManager::QueueUnitMove(ABaseUnit* Unit, const FVector& NewLocation)
+{
+    UnitMover.QueueMove(Unit, NewLocation);
+}
+
+/// <summary>
+/// Jeden przebieg zapisu transformacji zgłoszonych kroków, a co 1 / PositionPublishRate sekundy
+/// jedna partia pozycji przesuniętych jednostek dla klientów zamiast RPC na każdy krok.
+/// </summary>
+/// <param name="DeltaTime">Czas klatki</param>
+void AUnitManager::FlushUnitMoves(float DeltaTime)
+{
+    if (UnitMover.GetQueuedMoveCount() > 0)
+    {
+        UnitMover.Flush();
+    }
+
+    if (!UnitMover.ConsumePublishTime(DeltaTime, 1.0f / FMath::Max(PositionPublishRate, 1.0f)))
+    {
+        return;
+    }
+
+    UnitMover.TakeMovedUnits(PublishedUnits);
+    if (PublishedUnits.Num() == 0)
+    {
+        return;
+    }
+
+    PositionUpdates.Reset(PublishedUnits.Num());
+    for (ABaseUnit* Unit : PublishedUnits)
+    {
+        if (Unit->bIsAlive)
+        {
+            FUnitPositionUpdate& Update = PositionUpdates.AddDefaulted_GetRef();
+            Update.Unit = Unit;
+            Update.Position = Unit->GetActorLocation();
+        }
+    }
+
+    if (PositionUpdates.Num() > 0)
+    {
+        MulticastUnitPositions(PositionUpdates);
+    }
+}
+
+bool AUnitManager::IsSquadPlanningEnabled() const
+{
+    return bUseSquads && bCombatPhaseActive && SpatialGrid != nullptr && !LockstepSession.IsActive();
+}
+
+/// <summary>
+/// Oddziały w walce: co SquadRebuildInterval przebudowa skupisk z siatki przestrzennej,
+/// a w każdym ticku wspólne decyzje o celach.
+/// </summary>
+/// <param name="DeltaTime">Czas klatki</param>
+void AUnitManager::UpdateSquads(float DeltaTime)
+{
+    SquadRebuildCountdown -= DeltaTime;
+    if (SquadRebuildCountdown <= 0.0f)
+    {
+        SquadRebuildCountdown = SquadRebuildInterval;
+        RebuildSquads();
+    }
+
+    UpdateSquadTargets();
+}
+
+/// <summary>
+/// Podział jednostek na oddziały według aktualnych pozycji. Oddziały, które zachowały ID
+/// (mimo podziału lub połączenia skupisk), przejmują cel z poprzedniej przebudowy.
+/// Pojedyncze jednostki nie tworzą planu i decydują same.
+/// </summary>
+void AUnitManager::RebuildSquads()
+{
+    SpatialGrid->BuildSquadInputs(SquadInputs, SquadUnits);
+    SquadPlanner.Rebuild(SquadInputs, SquadLinkDistance, MaxSquadSize);
+
+    TMap<int32, FBattleSquadPlan> PreviousPlans;
+    for (FBattleSquadPlan& Plan : SquadPlans)
+    {
+        PreviousPlans.Add(Plan.SquadID, MoveTemp(Plan));
+    }
+
+    SquadPlans.Reset();
+    SquadMemberSlots.Reset();
+
+    int32 SquadedUnits = 0;
+    for (const FBattleSquad& Squad : SquadPlanner.GetSquads())
+    {
+        if (Squad.Num() < 2)
+        {
+            continue;
+        }
+
+        const int32 PlanIndex = SquadPlans.Num();
+        FBattleSquadPlan& Plan = SquadPlans.AddDefaulted_GetRef();
+        Plan.SquadID = Squad.SquadID;
+        Plan.Leader = SquadUnits[Squad.Leader];
+        Plan.FormationOffsets = Squad.FormationOffsets;
+        Plan.Members.Reserve(Squad.Num());
+
+        for (int32 MemberIndex = 0; MemberIndex < Squad.Num(); MemberIndex++)
+        {
+            ABaseUnit* Member = SquadUnits[Squad.Members[MemberIndex]];
+            Plan.Members.Add(Member);
+            SquadMemberSlots.Add(Member, { PlanIndex, MemberIndex });
+        }
+
+        if (FBattleSquadPlan* PreviousPlan = PreviousPlans.Find(Squad.SquadID))
+        {
+            Plan.Target = PreviousPlan->Target;
+            Plan.TargetCandidates = MoveTemp(PreviousPlan->TargetCandidates);
+        }
+
+        SquadedUnits += Squad.Num();
+    }
+
+    const FSquadRebuildStats& Stats = SquadPlanner.GetLastRebuildStats();
+    if (Stats.SplitCount > 0 || Stats.MergeCount > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== ODDZIAŁY: %d oddziałów (%d jednostek), podziały: %d, połączenia: %d ==="),
+            SquadPlans.Num(), SquadedUnits, Stats.SplitCount, Stats.MergeCount);
+    }
+}
+
+/// <summary>
+/// Jedno zapytanie o cel na oddział: lider zachowuje swój cel lub szuka najbliższego wroga w siatce,
+/// a rejon wokół celu daje listę kandydatów. Członkowie bez celu wybierają najbliższego kandydata
+/// bez własnego zapytania siatki.
+/// </summary>
+void AUnitManager::UpdateSquadTargets()
+{
+    for (FBattleSquadPlan& Plan : SquadPlans)
+    {
+        ABaseUnit* Leader = Plan.Leader.Get();
+        if (!Leader || !Leader->bIsAlive || Leader->IsInUnitPool())
+        {
+            continue;
+        }
+
+        ABaseUnit* Target = Plan.Target.Get();
+        if (!Target || !Target->bIsAlive)
+        {
+            Target = Leader->HasValidTarget() ? Leader->CurrentTarget : SpatialGrid->FindNearestEnemy(Leader, Leader->GetArchetype()->SearchRange);
+            Plan.Target = Target;
+            Plan.TargetCandidates.Reset();
+
+            if (Target)
+            {
+                RefreshSquadTargetCandidates(Plan, Leader->TeamID);
+            }
+        }
+
+        if (!Target)
+        {
+            continue;
+        }
+
+        // Wszyscy kandydaci polegli - ponowne zapytanie o rejon celu
+        Plan.TargetCandidates.RemoveAll([](const TWeakObjectPtr<ABaseUnit>& Candidate)
+        {
+            return !Candidate.IsValid() || !Candidate->bIsAlive;
+        });
+
+        if (Plan.TargetCandidates.Num() == 0)
+        {
+            RefreshSquadTargetCandidates(Plan, Leader->TeamID);
+        }
+
+        for (const TWeakObjectPtr<ABaseUnit>& MemberPtr : Plan.Members)
+        {
+            ABaseUnit* Member = MemberPtr.Get();
+            if (!Member || !Member->bIsAlive || Member->IsInUnitPool() || !Member->bAutoCombatEnabled ||
+                Member->bCombatSleeping || Member->HasValidTarget())
+            {
+                continue;
+            }
+
+            const FVector MemberLocation = Member->GetActorLocation();
+            ABaseUnit* BestCandidate = nullptr;
+            float BestDistanceSq = MAX_flt;
+
+            for (const TWeakObjectPtr<ABaseUnit>& Candidate : Plan.TargetCandidates)
+            {
+                const float DistanceSq = FVector::DistSquared2D(MemberLocation, Candidate->GetActorLocation());
+                if (DistanceSq < BestDistanceSq)
+                {
+                    BestDistanceSq = DistanceSq;
+                    BestCandidate = Candidate.Get();
+                }
+            }
+
+            if (BestCandidate)
+            {
+                Member->SetTarget(BestCandidate);
+            }
         }
     }
-
-    UE_LOG(LogTemp, Warning, TEXT("=== WŁĄCZANIE WALKI: Optymalizacja cache - przetworzono %d jednostek w ciągłej pamięci ==="),
-        ActiveCombatUnitsCount);
 }
 
 /// <summary>
-/// Wyłącza automatyczną walkę dla wszystkich jednostek z optymalizacją cache.
+/// Kandydaci na cele członków oddziału - żywi wrogowie w promieniu SquadTargetRegionRadius
+/// od celu oddziału, najbliżsi celowi pierwsi.
 /// </summary>
-void AUnitManager::DisableAutoCombatForAllUnits()
+/// <param name="Plan">Plan oddziału z ustawionym celem</param>
+/// <param name="TeamID">Drużyna oddziału</param>
+void AUnitManager::RefreshSquadTargetCandidates(FBattleSquadPlan& Plan, int32 TeamID)
 {
-    // Sprawdzenie czy tablica walki jest zainicjalizowana
-    if (CombatUnitsArray.Num() == 0)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("=== WYŁĄCZANIE WALKI: Tablica walki niezainicjalizowana, powrót do metody podstawowej ==="));
+    static constexpr int32 MaxTargetCandidates = 8;
 
-        // Fallback do oryginalnej metody
-        for (const FSpawnedUnitData& UnitData : SpawnedUnits)
-        {
-            if (UnitData.Unit && IsValid(UnitData.Unit))
-            {
-                UnitData.Unit->StopAutoCombat();
-            }
-        }
+    Plan.TargetCandidates.Reset();
+
+    ABaseUnit* Target = Plan.Target.Get();
+    if (!Target)
+    {
         return;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("=== WYŁĄCZANIE WALKI: Wyłączanie auto-walki z optymalizacją cache dla %d aktywnych jednostek ==="),
-        ActiveCombatUnitsCount);
+    const FVector TargetLocation = Target->GetActorLocation();
+    TArray<ABaseUnit*> RegionUnits = SpatialGrid->GetUnitsInRange(TargetLocation, SquadTargetRegionRadius);
 
-    // Iteracja przez ciągłą tablicę aktywnych jednostek
-    for (int32 i = 0; i < ActiveCombatUnitsCount; i++)
+    RegionUnits.RemoveAll([TeamID](const ABaseUnit* Unit)
     {
-        ABaseUnit* Unit = CombatUnitsArray[i];
-        if (Unit && IsValid(Unit))
+        return !Unit || !Unit->bIsAlive || Unit->TeamID == TeamID;
+    });
+
+    RegionUnits.Sort([&TargetLocation](const ABaseUnit& A, const ABaseUnit& B)
+    {
+        return FVector::DistSquared2D(A.GetActorLocation(), TargetLocation) < FVector::DistSquared2D(B.GetActorLocation(), TargetLocation);
+    });
+
+    Plan.TargetCandidates.Add(Target);
+    for (ABaseUnit* Unit : RegionUnits)
+    {
+        if (Plan.TargetCandidates.Num() >= MaxTargetCandidates)
         {
-            UE_LOG(LogTemp, Warning, TEXT("=== WYŁĄCZANIE WALKI: Wyłączanie auto-walki dla jednostki %s (indeks cache: %d) ==="),
-                *Unit->GetName(), i);
-            Unit->StopAutoCombat();
+            break;
         }
-    }
 
-    UE_LOG(LogTemp, Warning, TEXT("=== WYŁĄCZANIE WALKI: Optymalizacja cache - przetworzono %d jednostek w ciągłej pamięci ==="),
-        ActiveCombatUnitsCount);
+        if (Unit != Target)
+        {
+            Plan.TargetCandidates.Add(Unit);
+        }
+    }
 }
 
 /// <summary>
-/// Tworzy nową jednostkę dla określonego gracza.
+/// Kierunek kroku członka oddziału - kierunek ostatniego kroku lidera (z jego pola przepływu
+/// lub trasy) skorygowany w stronę miejsca członka w szyku. Lider, jednostki spoza oddziałów
+/// i członkowie blisko swojego celu liczą kierunek sami.
 /// </summary>
-/// <param name="PlayerID">ID gracza (0 lub 1)</param>
-/// <param name="UnitType">Typ jednostki do utworzenia</param>
-/// <returns>Wskaźnik do utworzonej jednostki lub nullptr jeśli się nie powiodło</returns>
-ABaseUnit* AUnitManager::SpawnUnitForPlayer(int32 PlayerID, EBaseUnitType UnitType)
+/// <param name="Unit">Jednostka</param>
+/// <param name="Range">Odległość i kierunek do celu jednostki</param>
+/// <param name="OutDirection">Znormalizowany kierunek w płaszczyźnie XY</param>
+/// <returns>true jeśli jednostka powinna iść za liderem, false - wpp</returns>
+bool AUnitManager::GetSquadMoveDirection(const ABaseUnit* Unit, const FTargetRangeCache& Range, FVector& OutDirection) const
 {
-    // Tylko serwer może tworzyć jednostki
-    if (!HasAuthority())
+    const FSquadMemberSlot* Slot = SquadMemberSlots.Find(Unit);
+    if (!Slot || !IsSquadPlanningEnabled())
     {
-        UE_LOG(LogTemp, Error, TEXT("Klient próbował utworzyć jednostkę"));
-        return nullptr;
+        return false;
     }
 
-    // Sprawdzenie czy GridManager jest dostępny
-    if (!GridManagerRef)
+    const FBattleSquadPlan& Plan = SquadPlans[Slot->PlanIndex];
+    const ABaseUnit* Leader = Plan.Leader.Get();
+    if (!Leader || Leader == Unit || !Leader->bIsAlive || Range.DistanceSq <= FMath::Square(FlowFieldDirectApproachDistance))
     {
-        InitializeGridManager();
-        if (!GridManagerRef)
-        {
-            UE_LOG(LogTemp, Error, TEXT("Brak GridManagera"));
-            return nullptr;
-        }
+        return false;
     }
 
-    // Znalezienie pierwszej wolnej pozycji do spawnu
-    FVector2D SpawnPosition = FindFirstFreeSpawnPosition(PlayerID);
-    if (SpawnPosition == FVector2D(-1, -1))
+    // Kierunek lidera z bieżącej lub poprzedniej klatki (kolejność ticków jednostek jest dowolna)
+    if (Plan.LeaderDirectionFrame + 1 < GFrameCounter || Plan.LeaderDirection.IsNearlyZero())
     {
-        UE_LOG(LogTemp, Warning, TEXT("Brak wolnej pozycji spawnu dla Gracza %d"), PlayerID);
-        return nullptr;
+        return false;
     }
 
-    // Pobranie klasy jednostki na podstawie typu
-    TSubclassOf<ABaseUnit> UnitClass = GetUnitClassByType(UnitType);
-    if (!UnitClass)
+    const FVector LeaderLocation = Leader->GetActorLocation();
+    const FVector UnitLocation = Unit->GetActorLocation();
+    const FVector2D FormationSlot = FVector2D(LeaderLocation.X, LeaderLocation.Y) + Plan.FormationOffsets[Slot->MemberIndex];
+    const FVector2D SlotError = FormationSlot - FVector2D(UnitLocation.X, UnitLocation.Y);
+
+    // Pełna korekta, gdy członek odstaje od swojego miejsca o SquadLinkDistance
+    const FVector2D Correction = (SlotError / SquadLinkDistance).GetClampedToMaxSize(1.0f);
+    const FVector2D Direction = (FVector2D(Plan.LeaderDirection.X, Plan.LeaderDirection.Y) + Correction).GetSafeNormal();
+    if (Direction.IsNearlyZero())
     {
-        UE_LOG(LogTemp, Error, TEXT("Klasa jednostki nie ustawiona dla typu %d"), (int32)UnitType);
-        return nullptr;
+        return false;
     }
 
-    // Obliczenie pozycji świata i podniesienie nad podłoże
-    FVector WorldLocation = GetWorldLocationFromGrid(SpawnPosition);
-    WorldLocation.Z += 20.0f;
+    OutDirection = FVector(Direction.X, Direction.Y, 0.0f);
+    return true;
+}
 
-    // Obliczenie rotacji - Gracz 1 obrócony o 180 stopni
-    FRotator SpawnRotation = FRotator::ZeroRotator;
-    if (PlayerID == 1)
+/// <summary>
+/// Zapamiętuje kierunek kroku lidera oddziału (przed unikaniem kolizji) dla pozostałych członków.
+/// </summary>
+/// <param name="Unit">Jednostka, która policzyła kierunek</param>
+/// <param name="Direction">Znormalizowany kierunek z pola przepływu, trasy lub na cel</param>
+void AUnitManager::ReportSquadLeaderDirection(const ABaseUnit* Unit, const FVector& Direction)
+{
+    const FSquadMemberSlot* Slot = SquadMemberSlots.Find(Unit);
+    if (!Slot)
     {
-        SpawnRotation.Yaw = 180.0f;
-        UE_LOG(LogTemp, Warning, TEXT("=== SPAWN: Gracz 1 - jednostka obrócona o 180 stopni ==="));
+        return;
     }
-    else
+
+    FBattleSquadPlan& Plan = SquadPlans[Slot->PlanIndex];
+    if (Plan.Leader.Get() == Unit)
     {
-        SpawnRotation.Yaw = 0.0f;
-        UE_LOG(LogTemp, Warning, TEXT("=== SPAWN: Gracz 0 - domyślna rotacja ==="));
+        Plan.LeaderDirection = Direction;
+        Plan.LeaderDirectionFrame = GFrameCounter;
     }
+}
 
-    // Parametry spawnu z automatycznym dostosowaniem pozycji przy kolizji
-    FActorSpawnParameters SpawnParams;
-    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-
-    // Utworzenie aktora jednostki w świecie
-    ABaseUnit* SpawnedUnit = GetWorld()->SpawnActor<ABaseUnit>(UnitClass, WorldLocation, SpawnRotation, SpawnParams);
-
-    if (SpawnedUnit)
+/// <summary>
+/// Zwraca kubełek puli dla typu jednostki, tworząc go przy pierwszym użyciu.
+/// </summary>
+/// <param name="UnitType">Typ jednostki</param>
+/// <returns>Tablica nieaktywnych jednostek tego typu</returns>
+TArray<ABaseUnit*>& AUnitManager::GetUnitPoolBucket(EBaseUnitType UnitType)
+{
+    const int32 TypeIndex = static_cast<int32>(UnitType);
+    if (!UnitPool.IsValidIndex(TypeIndex))
     {
-        // Ustawienie podstawowych właściwości jednostki
-        SpawnedUnit->TeamID = PlayerID;
-        SpawnedUnit->GridPosition = SpawnPosition;
-        SpawnedUnit->UnitType = UnitType;
-
-        // Dodanie do tablicy utworzonych jednostek
-        FSpawnedUnitData UnitData;
-        UnitData.Unit = SpawnedUnit;
-        UnitData.PlayerID = PlayerID;
-        UnitData.GridPosition = SpawnPosition;
-        UnitData.UnitType = UnitType;
-        SpawnedUnits.Add(UnitData);
-
-        // Dodanie do siatki przestrzennej jeśli walka jest aktywna
-        if (bUseSpatialPartitioning && SpatialGrid && bCombatPhaseActive)
-        {
-            SpatialGrid->AddUnit(SpawnedUnit);
-            UE_LOG(LogTemp, Warning, TEXT("=== SIATKA PRZESTRZENNA: Dodano utworzoną jednostkę %s do siatki ==="),
-                *SpawnedUnit->GetName());
-        }
-
-        // Dodanie do tablicy optymalizacji cache
-        AddUnitToCombatArray(SpawnedUnit);
-
-        // Jeśli walka jest aktywna, podłączenie zdarzeń i uruchomienie auto-walki
-        if (bCombatPhaseActive)
-        {
-            BindUnitCombatEvents(SpawnedUnit);
-            SpawnedUnit->StartAutoCombat();
-            UE_LOG(LogTemp, Warning, TEXT("=== SPAWN: Nowa jednostka %s dodana do aktywnej walki ==="),
-                *SpawnedUnit->GetName());
-        }
-
-        // Broadcast zdarzeń spawnu 
-        OnUnitSpawned.Broadcast(SpawnedUnit, PlayerID, SpawnPosition);
-        MulticastUnitSpawned(SpawnedUnit, PlayerID, SpawnPosition, UnitType);
-
-        UE_LOG(LogTemp, Warning, TEXT("Serwer utworzył jednostkę typu %d dla Gracza %d z rotacją %f stopni"),
-            (int32)UnitType, PlayerID, SpawnRotation.Yaw);
-        return SpawnedUnit;
+        UnitPool.SetNum(TypeIndex + 1);
     }
 
-    UE_LOG(LogTemp, Error, TEXT("Nie udało się utworzyć jednostki"));
-    return nullptr;
+    return UnitPool[TypeIndex].Units;
 }
 
 /// <summary>
@@ -1002,7 +2762,7 @@ ABaseUnit* AUnitManager::SpawnUnitForPlayer(int32 PlayerID, EBaseUnitType UnitTy
 /// <param name="NewGridPosition">Nowa pozycja na siatce</param>
 /// <param name="PlayerID">ID gracza wykonującego ruch</param>
 /// <returns>True jeśli ruch się powiódł, false w przeciwnym razie</returns>
-bool AUnitManager::MoveUnitToPosition(ABaseUnit* Unit, FVector2D NewGridPosition, int32 PlayerID)
+bool AUnitManager::MoveUnitToPosition(ABaseUnit* Unit, FGridCell NewGridPosition, int32 PlayerID)
 {
     // Tylko serwer może przenosić jednostki
     if (!HasAuthority())
@@ -1024,7 +2784,7 @@ bool AUnitManager::MoveUnitToPosition(ABaseUnit* Unit, FVector2D NewGridPosition
     }
 
     // Zapisanie starych pozycji
-    FVector2D OldPosition = UnitData->GridPosition;
+    FGridCell OldPosition = UnitData->GridPosition;
     FVector OldWorldPosition = Unit->GetActorLocation();
 
     // Aktualizacja danych na serwerze
@@ -1108,13 +2868,13 @@ void AUnitManager::RemoveUnit(ABaseUnit* Unit)
     // Replikacja usunięcia do klientów
     MulticastUnitRemoved(Unit);
 
-    // Zniszczenie aktora
-    Unit->Destroy();
+    // Aktor wraca do puli (lub jest niszczony, gdy pula jest wyłączona)
+    ReleaseUnit(Unit);
 
-    // Sprawdzenie warunków zakończenia walki
+    // Sprawdzenie warunków zakończenia walki w najbliższym ticku
     if (bCombatPhaseActive)
     {
-        CheckCombatEndConditions();
+        bCombatEndCheckPending = true;
     }
 
     UE_LOG(LogTemp, Log, TEXT("Serwer usunął jednostkę z gry"));
@@ -1331,6 +3091,7 @@ void AUnitManager::MulticastCombatStopped_Implementation()
         // Zresetuj stan walki na kliencie
         bCombatPhaseActive = false;
         TotalCombatUnits = 0;
+        LockstepSession.Stop();
 
         // Wyemituj zdarzenie zakończenia walki dla klientów
         OnCombatStopped.Broadcast();
@@ -1402,6 +3163,97 @@ void AUnitManager::MulticastCombatUpdate_Implementation(const TArray<ABaseUnit*>
     }
 }
 
+/// <summary>
+/// Multicast RPC z pakietem startowym bitwy lockstep (rozstawienie, statystyki, wersja symulacji, ziarno).
+/// </summary>
+/// <param name="StartPacket">Zserializowany stan początkowy bitwy</param>
+/// <param name="HashIntervalTicks">Co ile ticków serwer wysyła skrót stanu</param>
+void AUnitManager::MulticastLockstepBattleStart_Implementation(const TArray<uint8>& StartPacket, int32 HashIntervalTicks)
+{
+    if (HasAuthority())
+    {
+        return;
+    }
+
+    bLockstepSnapshotRequested = false;
+    if (!LockstepSession.StartFromPacket(StartPacket, HashIntervalTicks))
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== LOCKSTEP: Odrzucono pakiet startowy (%d B) - inna wersja symulacji lub uszkodzone dane ==="),
+            StartPacket.Num());
+        return;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== LOCKSTEP: Klient rozpoczął lokalną symulację bitwy (%d jednostek) ==="),
+        LockstepSession.GetState().GetUnits().Num());
+}
+
+/// <summary>
+/// Multicast RPC ze skrótem stanu bitwy serwera. Niezawodność nie jest potrzebna - zgubiony skrót
+/// opóźnia jedynie wykrycie rozbieżności do następnego.
+/// </summary>
+/// <param name="Tick">Tick, po którym policzono skrót</param>
+/// <param name="Hash">Skrót stanu serwera</param>
+void AUnitManager::MulticastLockstepHash_Implementation(int32 Tick, uint32 Hash)
+{
+    if (HasAuthority())
+    {
+        return;
+    }
+
+    LockstepSession.ReceiveAuthorityHash(Tick, Hash);
+}
+
+/// <summary>
+/// Multicast RPC z partią pozycji jednostek. Niezawodność nie jest potrzebna - kolejna partia
+/// niesie aktualne pozycje, a zgubiona jedynie opóźnia ich pokazanie.
+/// </summary>
+/// <param name="Updates">Jednostki przesunięte od poprzedniej partii i ich pozycje</param>
+void AUnitManager::MulticastUnitPositions_Implementation(const TArray<FUnitPositionUpdate>& Updates)
+{
+    if (HasAuthority())
+    {
+        return;
+    }
+
+    for (const FUnitPositionUpdate& Update : Updates)
+    {
+        if (Update.Unit && IsValid(Update.Unit))
+        {
+            Update.Unit->ApplyReplicatedPosition(Update.Position);
+        }
+    }
+}
+
+/// <summary>
+/// Multicast RPC z rozstrzygającym wynikiem bitwy lockstep.
+/// </summary>
+/// <param name="FinalTick">Ostatni tick bitwy</param>
+/// <param name="FinalHash">Skrót stanu końcowego serwera</param>
+/// <param name="Player0Survivors">Ocalałe jednostki gracza 0</param>
+/// <param name="Player1Survivors">Ocalałe jednostki gracza 1</param>
+void AUnitManager::MulticastLockstepBattleFinished_Implementation(int32 FinalTick, uint32 FinalHash, int32 Player0Survivors, int32 Player1Survivors)
+{
+    if (HasAuthority())
+    {
+        return;
+    }
+
+    if (LockstepSession.IsActive())
+    {
+        // Klient dolicza brakujące ticki i porównuje stan końcowy - wynik serwera jest rozstrzygający
+        LockstepSession.CatchUpToTick(FinalTick);
+        const FBattleSimState& State = LockstepSession.GetState();
+        const bool bMatches = State.GetTickCount() == FinalTick && State.ComputeStateHash() == FinalHash;
+
+        UE_LOG(LogTemp, Warning, TEXT("=== LOCKSTEP: Koniec bitwy w ticku %d - stan klienta %s (resynchronizacji: %d) ==="),
+            FinalTick, bMatches ? TEXT("ZGODNY") : TEXT("ROZBIEŻNY"), LockstepSession.GetResyncCount());
+
+        LockstepSession.Stop();
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("=== LOCKSTEP: Wynik serwera - Gracz 0: %d, Gracz 1: %d ==="), Player0Survivors, Player1Survivors);
+}
+
 /// <summary>
 /// Znajduje dane jednostki w tablicy SpawnedUnits.
 /// </summary>
@@ -1426,13 +3278,13 @@ FSpawnedUnitData* AUnitManager::FindUnitData(ABaseUnit* Unit)
 /// <param name="NewGridPosition">Nowa pozycja na siatce</param>
 /// <param name="PlayerID">ID gracza właściciela jednostki</param>
 /// <returns>True jeśli ruch jest możliwy, false wpp</returns>
-bool AUnitManager::CanMoveUnitToPosition(ABaseUnit* Unit, FVector2D NewGridPosition, int32 PlayerID) const
+bool AUnitManager::CanMoveUnitToPosition(ABaseUnit* Unit, FGridCell NewGridPosition, int32 PlayerID) const
 {
     if (!Unit || !GridManagerRef)
         return false;
 
     // Sprawdź czy pozycja jest w granicach siatki
-    if (!GridManagerRef->IsValidGridPosition(NewGridPosition))
+    if (!GridManagerRef->IsValidCell(NewGridPosition))
         return false;
 
     // Sprawdź czy pozycja należy do strefy spawnu gracza
@@ -1455,22 +3307,31 @@ bool AUnitManager::CanMoveUnitToPosition(ABaseUnit* Unit, FVector2D NewGridPosit
 /// </summary>
 /// <param name="PlayerID">ID gracza</param>
 /// <returns>Współrzędne wolnej pozycji lub (-1,-1) jeśli nie znaleziono</returns>
-FVector2D AUnitManager::FindFirstFreeSpawnPosition(int32 PlayerID) const
+FGridCell AUnitManager::FindFirstFreeSpawnPosition(int32 PlayerID) const
 {
     if (!GridManagerRef)
-        return FVector2D(-1, -1);
+        return FGridCell(-1, -1);
 
-    TArray<FVector2D> ValidPositions = GridManagerRef->GetValidSpawnPositions(PlayerID);
+    // Zajęte komórki zbierane raz - zamiast przeglądania wszystkich jednostek dla każdej pozycji spawnu
+    TSet<FGridCell> OccupiedCells;
+    OccupiedCells.Reserve(SpawnedUnits.Num());
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        if (UnitData.Unit)
+        {
+            OccupiedCells.Add(UnitData.GridPosition);
+        }
+    }
 
-    for (const FVector2D& Position : ValidPositions)
+    for (const FGridCell& Position : GridManagerRef->GetValidSpawnCells(PlayerID))
     {
-        if (!IsPositionOccupied(Position))
+        if (!OccupiedCells.Contains(Position))
         {
             return Position;
         }
     }
 
-    return FVector2D(-1, -1);
+    return FGridCell(-1, -1);
 }
 
 /// <summary>
@@ -1478,7 +3339,7 @@ FVector2D AUnitManager::FindFirstFreeSpawnPosition(int32 PlayerID) const
 /// </summary>
 /// <param name="GridPosition">Pozycja do sprawdzenia</param>
 /// <returns>True jeśli pozycja jest zajęta, false w przeciwnym razie</returns>
-bool AUnitManager::IsPositionOccupied(FVector2D GridPosition) const
+bool AUnitManager::IsPositionOccupied(FGridCell GridPosition) const
 {
     for (const FSpawnedUnitData& UnitData : SpawnedUnits)
     {
@@ -1495,7 +3356,7 @@ bool AUnitManager::IsPositionOccupied(FVector2D GridPosition) const
 /// </summary>
 /// <param name="GridPosition">Pozycja do sprawdzenia</param>
 /// <returns>Wskaźnik do jednostki lub nullptr jeśli pozycja jest pusta</returns>
-ABaseUnit* AUnitManager::GetUnitAtPosition(FVector2D GridPosition) const
+ABaseUnit* AUnitManager::GetUnitAtPosition(FGridCell GridPosition) const
 {
     for (const FSpawnedUnitData& UnitData : SpawnedUnits)
     {
@@ -1538,6 +3399,12 @@ void AUnitManager::RemoveUnitFromArray(ABaseUnit* Unit)
     {
         if (SpawnedUnits[i].Unit == Unit)
         {
+            // Martwe jednostki zostały już odjęte od licznika w momencie śmierci
+            if (Unit && Unit->bIsAlive)
+            {
+                AdjustAliveUnitCount(SpawnedUnits[i].PlayerID, -1);
+            }
+
             SpawnedUnits.RemoveAt(i);
             break;
         }
@@ -1574,7 +3441,7 @@ void AUnitManager::SelectUnit(ABaseUnit* Unit, int32 PlayerID)
     OnUnitSelected.Broadcast(Unit, PlayerID);
     MulticastUnitSelected(Unit, PlayerID);
 
-    FVector2D UnitPosition = Unit->GridPosition;
+    const FGridCell UnitPosition = Unit->GridPosition;
 
     // Pokaż podświetlenie selekcji dla lokalnego kontrolera gracza
     for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
@@ -1630,7 +3497,7 @@ void AUnitManager::DeselectUnit()
 /// </summary>
 /// <param name="GridPosition">Pozycja klikniętego pola</param>
 /// <param name="PlayerID">ID gracza klikającego</param>
-void AUnitManager::HandleGridClick(FVector2D GridPosition, int32 PlayerID)
+void AUnitManager::HandleGridClick(FGridCell GridPosition, int32 PlayerID)
 {
     if (!HasAuthority() || !GridManagerRef)
         return;
@@ -1701,6 +3568,7 @@ void AUnitManager::ClearAllUnits()
         ActiveCombatUnitsCount = 0;
 
         SpawnedUnits.Empty();
+        AliveUnitCounts.Reset();
         ForceDeselectAllUnits();
     }
     else
@@ -1722,10 +3590,11 @@ void AUnitManager::ClearAllUnits()
         for (ABaseUnit* Unit : UnitsToDestroy)
         {
             UE_LOG(LogTemp, Warning, TEXT("KLIENT: Wymuszenie zniszczenia pozostałej jednostki"));
-            Unit->Destroy();
+            ReleaseUnit(Unit);
         }
 
         SpawnedUnits.Empty();
+        PendingClientSpawns.Reset();
         ForceDeselectAllUnits();
     }
 
@@ -1748,7 +3617,7 @@ void AUnitManager::PrepareForUnitClearing()
     {
         if (UnitData.Unit && IsValid(UnitData.Unit))
         {
-            UE_LOG(LogTemp, Warning, TEXT("KLIENT: Jednostka na (%f,%f) gotowa do zniszczenia"),
+            UE_LOG(LogTemp, Warning, TEXT("KLIENT: Jednostka na (%d,%d) gotowa do zniszczenia"),
                 UnitData.GridPosition.X, UnitData.GridPosition.Y);
         }
     }
@@ -1769,7 +3638,7 @@ void AUnitManager::FinalizeUnitClearing()
         if (UnitData.Unit && IsValid(UnitData.Unit))
         {
             RemainingUnits.Add(UnitData.Unit);
-            UE_LOG(LogTemp, Warning, TEXT("KLIENT: Znaleziono pozostałą jednostkę na (%f,%f)"),
+            UE_LOG(LogTemp, Warning, TEXT("KLIENT: Znaleziono pozostałą jednostkę na (%d,%d)"),
                 UnitData.GridPosition.X, UnitData.GridPosition.Y);
         }
     }
@@ -1778,7 +3647,7 @@ void AUnitManager::FinalizeUnitClearing()
     for (ABaseUnit* Unit : RemainingUnits)
     {
         UE_LOG(LogTemp, Warning, TEXT("KLIENT: Wymuszenie zniszczenia pozostałej jednostki w finalizacji"));
-        Unit->Destroy();
+        ReleaseUnit(Unit);
     }
 
     int32 PreviousCount = SpawnedUnits.Num();
@@ -1794,7 +3663,7 @@ void AUnitManager::FinalizeUnitClearing()
 /// Niszczy jednostki na określonych pozycjach.
 /// </summary>
 /// <param name="Positions">Tablica pozycji siatki gdzie należy zniszczyć jednostki</param>
-void AUnitManager::DestroyUnitsAtPositions(const TArray<FVector2D>& Positions)
+void AUnitManager::DestroyUnitsAtPositions(const TArray<FGridCell>& Positions)
 {
     UE_LOG(LogTemp, Warning, TEXT("KLIENT: DestroyUnitsAtPositions wywołana z %d pozycjami"), Positions.Num());
 
@@ -1807,43 +3676,16 @@ void AUnitManager::DestroyUnitsAtPositions(const TArray<FVector2D>& Positions)
     TArray<ABaseUnit*> UnitsToDestroy;
 
     // Przeszukaj pozycje i znajdź jednostki do zniszczenia
-    for (const FVector2D& Position : Positions)
-    {
-        UE_LOG(LogTemp, Warning, TEXT("KLIENT: Szukanie jednostki na pozycji (%f,%f)"), Position.X, Position.Y);
+    // Pozycje całkowite - jedno przejście po jednostkach z wyszukiwaniem w zbiorze komórek
+    const TSet<FGridCell> PositionSet(Positions);
 
-        for (int32 i = 0; i < SpawnedUnits.Num(); i++)
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        if (UnitData.Unit && IsValid(UnitData.Unit) && PositionSet.Contains(UnitData.GridPosition))
         {
-            const FSpawnedUnitData& UnitData = SpawnedUnits[i];
-
-            if (UnitData.Unit && IsValid(UnitData.Unit))
-            {
-                bool bPositionMatch = false;
-
-                // Sprawdź dokładne dopasowanie pozycji
-                if (UnitData.GridPosition.Equals(Position, 0.01f))
-                {
-                    bPositionMatch = true;
-                    UE_LOG(LogTemp, Warning, TEXT("KLIENT: Dokładne dopasowanie pozycji na (%f,%f)"), Position.X, Position.Y);
-                }
-                else
-                {
-                    // Sprawdź dopasowanie z tolerancją
-                    float Distance = FVector2D::Distance(UnitData.GridPosition, Position);
-                    if (Distance < 0.5f)
-                    {
-                        bPositionMatch = true;
-                        UE_LOG(LogTemp, Warning, TEXT("KLIENT: Dopasowanie pozycji z tolerancją na (%f,%f), odległość: %f"),
-                            Position.X, Position.Y, Distance);
-                    }
-                }
-
-                if (bPositionMatch)
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("KLIENT: Znaleziono jednostkę do zniszczenia na pozycji (%f,%f)"), Position.X, Position.Y);
-                    UnitsToDestroy.AddUnique(UnitData.Unit);
-                    break;
-                }
-            }
+            UE_LOG(LogTemp, Warning, TEXT("KLIENT: Znaleziono jednostkę do zniszczenia na pozycji (%d,%d)"),
+                UnitData.GridPosition.X, UnitData.GridPosition.Y);
+            UnitsToDestroy.AddUnique(UnitData.Unit);
         }
     }
 
@@ -1854,7 +3696,7 @@ void AUnitManager::DestroyUnitsAtPositions(const TArray<FVector2D>& Positions)
     {
         if (Unit && IsValid(Unit))
         {
-            UE_LOG(LogTemp, Warning, TEXT("KLIENT: Niszczenie jednostki na pozycji (%f,%f)"),
+            UE_LOG(LogTemp, Warning, TEXT("KLIENT: Niszczenie jednostki na pozycji (%d,%d)"),
                 Unit->GridPosition.X, Unit->GridPosition.Y);
 
             // Jeśli niszczona jednostka jest zaznaczona, wyczyść selekcję
@@ -1866,8 +3708,7 @@ void AUnitManager::DestroyUnitsAtPositions(const TArray<FVector2D>& Positions)
                 HideAllHighlights();
             }
 
-            RemoveUnitFromClientArray(Unit);
-            Unit->Destroy();
+            ReleaseUnit(Unit);
         }
     }
 
@@ -1905,56 +3746,79 @@ void AUnitManager::RemoveUnitFromClientArray(ABaseUnit* Unit)
 /// <param name="PlayerID">ID gracza właściciela jednostki</param>
 /// <param name="GridPosition">Pozycja na siatce gdzie jednostka została zespawnowana</param>
 /// <param name="UnitType">Typ jednostki do zespawnowania</param>
-void AUnitManager::MulticastUnitSpawned_Implementation(ABaseUnit* SpawnedUnit, int32 PlayerID, FVector2D GridPosition, EBaseUnitType UnitType)
+void AUnitManager::MulticastUnitSpawned_Implementation(ABaseUnit* SpawnedUnit, int32 PlayerID, FGridCell GridPosition, EBaseUnitType UnitType)
 {
     if (!HasAuthority())
     {
         UE_LOG(LogTemp, Warning, TEXT("Klient: Otrzymano żądanie spawnu jednostki typu %d dla gracza %d"), (int32)UnitType, PlayerID);
 
-        // Pobierz klasę jednostki na podstawie typu
-        TSubclassOf<ABaseUnit> UnitClass = GetUnitClassByType(UnitType);
-        if (!UnitClass)
-        {
-            UE_LOG(LogTemp, Error, TEXT("Klient: Brak klasy dla jednostki typu %d"), (int32)UnitType);
-            return;
-        }
+        SpawnClientUnitCopy(PlayerID, GridPosition, UnitType);
+    }
+}
+
+/// <summary>
+/// Multicast RPC z zakończoną partią spawnu. Klienci kolejkują lokalne kopie i tworzą je w ramach budżetu klatki.
+/// </summary>
+/// <param name="SpawnedBatch">Jednostki utworzone na serwerze w tej partii</param>
+void AUnitManager::MulticastUnitBatchSpawned_Implementation(const TArray<FSpawnedUnitData>& SpawnedBatch)
+{
+    if (!HasAuthority())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Klient: Otrzymano partię spawnu z %d jednostkami"), SpawnedBatch.Num());
+
+        PendingClientSpawns.Append(SpawnedBatch);
+    }
+}
 
-        // Oblicz pozycję w świecie
-        FVector WorldLocation = GetWorldLocationFromGrid(GridPosition);
-        WorldLocation.Z += 20.0f; // Lekkie uniesienie nad ziemię
+/// <summary>
+/// Tworzy lokalną kopię jednostki po stronie klienta i dodaje ją do lokalnej tablicy jednostek.
+/// </summary>
+/// <param name="PlayerID">ID gracza właściciela jednostki</param>
+/// <param name="GridPosition">Pozycja na siatce gdzie jednostka została zespawnowana</param>
+/// <param name="UnitType">Typ jednostki do zespawnowania</param>
+/// <returns>Lokalna kopia jednostki lub nullptr</returns>
+ABaseUnit* AUnitManager::SpawnClientUnitCopy(int32 PlayerID, FGridCell GridPosition, EBaseUnitType UnitType)
+{
+    // Sprawdź czy typ ma przypisaną klasę
+    if (!GetUnitClassByType(UnitType))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Klient: Brak klasy dla jednostki typu %d"), (int32)UnitType);
+        return nullptr;
+    }
 
-        // Ustaw rotację - gracz 1 jest obrócony o 180 stopni
-        FRotator SpawnRotation = FRotator::ZeroRotator;
-        if (PlayerID == 1)
-        {
-            SpawnRotation.Yaw = 180.0f;
-        }
+    // Oblicz pozycję w świecie
+    FVector WorldLocation = GetWorldLocationFromGrid(GridPosition);
+    WorldLocation.Z += 20.0f; // Lekkie uniesienie nad ziemię
 
-        // Przygotuj parametry spawnu
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+    // Ustaw rotację - gracz 1 jest obrócony o 180 stopni
+    FRotator SpawnRotation = FRotator::ZeroRotator;
+    if (PlayerID == 1)
+    {
+        SpawnRotation.Yaw = 180.0f;
+    }
 
-        // Zespawnuj jednostkę po stronie klienta
-        ABaseUnit* ClientSpawnedUnit = GetWorld()->SpawnActor<ABaseUnit>(UnitClass, WorldLocation, SpawnRotation, SpawnParams);
+    // Zespawnuj jednostkę po stronie klienta (lokalna kopia z puli lub nowy aktor)
+    ABaseUnit* ClientSpawnedUnit = AcquireUnit(UnitType, WorldLocation, SpawnRotation);
 
-        if (ClientSpawnedUnit)
-        {
-            // Zainicjalizuj właściwości jednostki
-            ClientSpawnedUnit->TeamID = PlayerID;
-            ClientSpawnedUnit->GridPosition = GridPosition;
-            ClientSpawnedUnit->UnitType = UnitType;
+    if (ClientSpawnedUnit)
+    {
+        // Zainicjalizuj właściwości jednostki
+        ClientSpawnedUnit->TeamID = PlayerID;
+        ClientSpawnedUnit->GridPosition = GridPosition;
+        ClientSpawnedUnit->UnitType = UnitType;
 
-            // Dodaj do lokalnej tablicy jednostek
-            FSpawnedUnitData UnitData;
-            UnitData.Unit = ClientSpawnedUnit;
-            UnitData.PlayerID = PlayerID;
-            UnitData.GridPosition = GridPosition;
-            UnitData.UnitType = UnitType;
-            SpawnedUnits.Add(UnitData);
+        // Dodaj do lokalnej tablicy jednostek
+        FSpawnedUnitData UnitData;
+        UnitData.Unit = ClientSpawnedUnit;
+        UnitData.PlayerID = PlayerID;
+        UnitData.GridPosition = GridPosition;
+        UnitData.UnitType = UnitType;
+        SpawnedUnits.Add(UnitData);
 
-            UE_LOG(LogTemp, Warning, TEXT("Klient: Pomyślnie zespawnowano jednostkę typu %d dla gracza %d"), (int32)UnitType, PlayerID);
-        }
+        UE_LOG(LogTemp, Warning, TEXT("Klient: Pomyślnie zespawnowano jednostkę typu %d dla gracza %d"), (int32)UnitType, PlayerID);
     }
+
+    return ClientSpawnedUnit;
 }
 
 /// <summary>
@@ -1964,7 +3828,7 @@ void AUnitManager::MulticastUnitSpawned_Implementation(ABaseUnit* SpawnedUnit, i
 /// <param name="OldPosition">Poprzednia pozycja jednostki</param>
 /// <param name="NewPosition">Nowa pozycja jednostki</param>
 /// <param name="PlayerID">ID gracza właściciela jednostki</param>
-void AUnitManager::MulticastUnitMoved_Implementation(ABaseUnit* MovedUnit, FVector2D OldPosition, FVector2D NewPosition, int32 PlayerID)
+void AUnitManager::MulticastUnitMoved_Implementation(ABaseUnit* MovedUnit, FGridCell OldPosition, FGridCell NewPosition, int32 PlayerID)
 {
     if (!HasAuthority())
     {
@@ -1997,30 +3861,13 @@ void AUnitManager::MulticastUnitMoved_Implementation(ABaseUnit* MovedUnit, FVect
 /// <param name="OldPosition">Pozycja gdzie jednostka się znajdowała</param>
 /// <param name="NewPosition">Nowa pozycja jednostki</param>
 /// <param name="PlayerID">ID gracza właściciela jednostki</param>
-void AUnitManager::MulticastUnitMovedByPosition_Implementation(FVector2D OldPosition, FVector2D NewPosition, int32 PlayerID)
+void AUnitManager::MulticastUnitMovedByPosition_Implementation(FGridCell OldPosition, FGridCell NewPosition, int32 PlayerID)
 {
     if (!HasAuthority())
     {
         // Znajdź jednostkę na starej pozycji
         ABaseUnit* UnitToMove = GetUnitAtPosition(OldPosition);
 
-        // Jeśli nie znaleziono dokładnie, szukaj z tolerancją
-        if (!UnitToMove)
-        {
-            for (const FSpawnedUnitData& UnitData : SpawnedUnits)
-            {
-                if (UnitData.Unit && UnitData.PlayerID == PlayerID)
-                {
-                    float Distance = FVector2D::Distance(UnitData.GridPosition, OldPosition);
-                    if (Distance < 0.5f)
-                    {
-                        UnitToMove = UnitData.Unit;
-                        break;
-                    }
-                }
-            }
-        }
-
         if (UnitToMove)
         {
             // Aktualizuj pozycję jednostki
@@ -2048,7 +3895,7 @@ void AUnitManager::MulticastUnitMovedByPosition_Implementation(FVector2D OldPosi
 /// </summary>
 /// <param name="Unit">Jednostka do zaktualizowania</param>
 /// <param name="NewPosition">Nowa pozycja na siatce</param>
-void AUnitManager::UpdateUnitDataPosition(ABaseUnit* Unit, FVector2D NewPosition)
+void AUnitManager::UpdateUnitDataPosition(ABaseUnit* Unit, FGridCell NewPosition)
 {
     for (FSpawnedUnitData& UnitData : SpawnedUnits)
     {
@@ -2133,8 +3980,8 @@ void AUnitManager::MulticastUnitRemoved_Implementation(ABaseUnit* Unit)
             HideAllHighlights();
         }
 
-        // Zniszcz aktora
-        Unit->Destroy();
+        // Zniszcz aktora lub odłóż lokalną kopię do puli
+        ReleaseUnit(Unit);
     }
 }
 
@@ -2145,17 +3992,24 @@ void AUnitManager::MulticastClearAllUnits_Implementation()
 {
     if (!HasAuthority())
     {
-        // Zniszcz wszystkie jednostki
-        for (auto& UnitData : SpawnedUnits)
+        // Zniszcz wszystkie jednostki (lokalne kopie wracają do puli)
+        TArray<ABaseUnit*> UnitsToRelease;
+        for (const FSpawnedUnitData& UnitData : SpawnedUnits)
         {
             if (UnitData.Unit)
             {
-                UnitData.Unit->Destroy();
+                UnitsToRelease.Add(UnitData.Unit);
             }
         }
 
-        // Wyczyść dane lokalne
+        for (ABaseUnit* Unit : UnitsToRelease)
+        {
+            ReleaseUnit(Unit);
+        }
+
+        // Wyczyść dane lokalne (również kopie z partii jeszcze nieutworzone)
         SpawnedUnits.Empty();
+        PendingClientSpawns.Reset();
         SelectedUnit = nullptr;
         SelectedUnitPlayerID = -1;
         HideAllHighlights();
@@ -2183,7 +4037,7 @@ void AUnitManager::MulticastAllUnitsCleared_Implementation()
         // Zniszcz je
         for (ABaseUnit* Unit : RemainingUnits)
         {
-            Unit->Destroy();
+            ReleaseUnit(Unit);
         }
 
         // Wyczyść wszystko
@@ -2213,9 +4067,9 @@ void AUnitManager::ShowValidMovePositions(ABaseUnit* Unit, int32 PlayerID)
     ClearHighlightComponents();
 
     // Pobierz wszystkie ważne pozycje spawnu dla gracza
-    TArray<FVector2D> ValidPositions = GridManagerRef->GetValidSpawnPositions(PlayerID);
+    const TArray<FGridCell> ValidPositions = GridManagerRef->GetValidSpawnCells(PlayerID);
 
-    for (const FVector2D& Position : ValidPositions)
+    for (const FGridCell& Position : ValidPositions)
     {
         UMaterialInterface* MaterialToUse = nullptr;
 
@@ -2256,7 +4110,7 @@ void AUnitManager::HideAllHighlights()
 /// </summary>
 /// <param name="GridPosition">Pozycja do podświetlenia</param>
 /// <param name="Material">Materiał do użycia dla podświetlenia</param>
-void AUnitManager::HighlightGridPosition(FVector2D GridPosition, UMaterialInterface* Material)
+void AUnitManager::HighlightGridPosition(FGridCell GridPosition, UMaterialInterface* Material)
 {
     if (Material)
     {
@@ -2281,7 +4135,7 @@ void AUnitManager::ShowSelectionHighlight(ABaseUnit* Unit)
 /// </summary>
 /// <param name="GridPosition">Pozycja na siatce gdzie utworzyć podświetlenie</param>
 /// <param name="Material">Materiał do zastosowania na mesh</param>
-void AUnitManager::CreateHighlightComponent(FVector2D GridPosition, UMaterialInterface* Material)
+void AUnitManager::CreateHighlightComponent(FGridCell GridPosition, UMaterialInterface* Material)
 {
     if (!Material)
         return;
@@ -2345,17 +4199,13 @@ void AUnitManager::ClearHighlightComponents()
 /// <param name="GridPosition">Pozycja do sprawdzenia</param>
 /// <param name="PlayerID">ID gracza</param>
 /// <returns>True jeśli pozycja jest w strefie spawnu gracza</returns>
-bool AUnitManager::IsValidPlayerSpawnPosition(FVector2D GridPosition, int32 PlayerID) const
+bool AUnitManager::IsValidPlayerSpawnPosition(FGridCell GridPosition, int32 PlayerID) const
 {
     if (!GridManagerRef)
         return false;
 
-    if (PlayerID == 0)
-        return GridManagerRef->IsPositionInPlayer1SpawnZone(GridPosition);
-    else if (PlayerID == 1)
-        return GridManagerRef->IsPositionInPlayer2SpawnZone(GridPosition);
-
-    return false;
+    // Strefa spawnu gracza bez komórek zablokowanych lub wyłączonych z rozstawiania przez warstwę nawigacji
+    return GridManagerRef->IsSpawnCellAvailable(GridPosition, PlayerID);
 }
 
 /// <summary>
@@ -2375,6 +4225,57 @@ TSubclassOf<ABaseUnit> AUnitManager::GetUnitClassByType(EBaseUnitType UnitType)
     }
 }
 
+/// <summary>
+/// Zwraca archetyp typu jednostki przypisany w klasie (Blueprincie) tego typu.
+/// </summary>
+/// <param name="UnitType">Typ jednostki</param>
+/// <returns>Archetyp lub nullptr, jeśli klasa nie ma przypisanego archetypu</returns>
+UUnitArchetype* AUnitManager::GetUnitArchetype(EBaseUnitType UnitType) const
+{
+    TSubclassOf<ABaseUnit> UnitClass = GetUnitClassByType(UnitType);
+    return UnitClass ? UnitClass->GetDefaultObject<ABaseUnit>()->Archetype : nullptr;
+}
+
+/// <summary>
+/// Przypisuje klasę aktora tworzonego dla typu jednostki (zwykle ustawianą w Blueprincie managera).
+/// </summary>
+/// <param name="UnitType">Typ jednostki</param>
+/// <param name="UnitClass">Klasa jednostki</param>
+void AUnitManager::SetUnitClassForType(EBaseUnitType UnitType, TSubclassOf<ABaseUnit> UnitClass)
+{
+    switch (UnitType)
+    {
+    case EBaseUnitType::Tank:  TankUnitClass = UnitClass; break;
+    case EBaseUnitType::Ninja: NinjaUnitClass = UnitClass; break;
+    case EBaseUnitType::Sword: SwordUnitClass = UnitClass; break;
+    case EBaseUnitType::Armor: ArmorUnitClass = UnitClass; break;
+    }
+}
+
+/// <summary>
+/// Włącza lub wyłącza podział decyzji bojowych na klatki i ustawia jego budżet.
+/// </summary>
+/// <param name="bEnabled">Czy decyzje jednostek planuje manager w ramach budżetu klatki</param>
+/// <param name="InCombatFrameBudgetMs">Budżet klatki w milisekundach, 0 = tylko jednostki ze zbyt starą decyzją</param>
+/// <param name="InMinUnitRefreshRate">Minimalna liczba decyzji każdej jednostki na sekundę</param>
+void AUnitManager::SetTimeSlicedCombat(bool bEnabled, float InCombatFrameBudgetMs, float InMinUnitRefreshRate)
+{
+    bUseTimeSlicedCombat = bEnabled;
+    CombatFrameBudgetMs = FMath::Max(InCombatFrameBudgetMs, 0.0f);
+    MinUnitRefreshRate = FMath::Max(InMinUnitRefreshRate, 1.0f);
+}
+
+/// <summary>
+/// Ustawia budżet klatki na tworzenie jednostek z partii spawnu.
+/// </summary>
+/// <param name="InSpawnFrameBudgetMs">Budżet czasu w milisekundach, 0 = bez limitu czasu</param>
+/// <param name="InMaxSpawnsPerFrame">Maksymalna liczba jednostek na klatkę, 0 = bez limitu</param>
+void AUnitManager::SetSpawnFrameBudget(float InSpawnFrameBudgetMs, int32 InMaxSpawnsPerFrame)
+{
+    SpawnFrameBudgetMs = FMath::Max(InSpawnFrameBudgetMs, 0.0f);
+    MaxSpawnsPerFrame = FMath::Max(InMaxSpawnsPerFrame, 0);
+}
+
 /// <summary>
 /// Zwraca liczbę jednostek należących do gracza.
 /// </summary>
@@ -2417,12 +4318,12 @@ int32 AUnitManager::GetUnitCountByType(int32 PlayerID, EBaseUnitType UnitType) c
 /// </summary>
 /// <param name="GridPosition">Pozycja na siatce (X, Y)</param>
 /// <returns>Pozycja w świecie 3D (środek komórki)</returns>
-FVector AUnitManager::GetWorldLocationFromGrid(FVector2D GridPosition) const
+FVector AUnitManager::GetWorldLocationFromGrid(FGridCell GridPosition) const
 {
     if (GridManagerRef)
     {
         // Użyj GridManager jeśli dostępny
-        FVector GridCorner = GridManagerRef->GetWorldLocationFromGrid(GridPosition);
+        FVector GridCorner = GridManagerRef->GetWorldLocationFromCell(GridPosition);
         float HalfCellSize = GridManagerRef->CellSize * 0.5f;
         return GridCorner + FVector(HalfCellSize, HalfCellSize, 0.0f);
     }
@@ -2436,6 +4337,414 @@ FVector AUnitManager::GetWorldLocationFromGrid(FVector2D GridPosition) const
     return FVector(WorldX, WorldY, 0.0f);
 }
 
+/// <summary>
+/// Buduje stan początkowy symulacji bez aktorów z aktualnego rozstawienia jednostek.
+/// Statystyki typów pochodzą z archetypów, a bez przypisanego zasobu z domyślnego archetypu klasy.
+/// </summary>
+/// <param name="OutSetup">Wynikowy stan początkowy symulacji</param>
+void AUnitManager::BuildBattleSimSetup(FBattleSimSetup& OutSetup) const
+{
+    for (int32 TypeIndex = 0; TypeIndex < FBattleSimSetup::NumUnitTypes; TypeIndex++)
+    {
+        const EBaseUnitType UnitType = static_cast<EBaseUnitType>(TypeIndex);
+        const UUnitArchetype* UnitArchetype = GetUnitArchetype(UnitType);
+        OutSetup.TypeStats[TypeIndex] = FSimUnitStats::FromArchetype(UnitArchetype ? UnitArchetype : GetDefault<UUnitArchetype>());
+    }
+
+    OutSetup.CellSize = GridManagerRef ? GridManagerRef->CellSize : 100.0f;
+    OutSetup.Placements.Reset();
+    OutSetup.AddPlacements(SpawnedUnits);
+}
+
+/// <summary>
+/// Zapisuje powtórkę bitwy z aktualnego rozstawienia (stan początkowy + ziarno) do Saved/Replays.
+/// </summary>
+/// <param name="ReplayName">Nazwa pliku powtórki bez rozszerzenia</param>
+/// <param name="Seed">Ziarno symulacji</param>
+/// <returns>True jeśli zapis się powiódł</returns>
+bool AUnitManager::SaveBattleReplay(const FString& ReplayName, int32 Seed)
+{
+    FBattleSimSetup Setup;
+    BuildBattleSimSetup(Setup);
+
+    const FBattleReplay Replay = FBattleReplay::Record(Setup, static_cast<uint32>(Seed));
+    const FString FilePath = FPaths::ProjectSavedDir() / TEXT("Replays") / (ReplayName + TEXT(".breplay"));
+
+    const bool bSaved = Replay.SaveToFile(FilePath);
+    UE_LOG(LogTemp, Warning, TEXT("=== POWTÓRKA: %s %s (%d jednostek, %d ticków) ==="),
+        bSaved ? TEXT("Zapisano") : TEXT("Błąd zapisu"), *FilePath, Setup.Placements.Num(), Replay.TickHashes.Num());
+
+    return bSaved;
+}
+
+/// <summary>
+/// Rozpoczyna bitwę lockstep na serwerze: symulacja stałopozycyjna z aktualnego rozstawienia,
+/// a klienci dostają jeden pakiet startowy zamiast RPC na każdy krok jednostek.
+/// </summary>
+void AUnitManager::StartLockstepBattle()
+{
+    FBattleSimSetup Setup;
+    BuildBattleSimSetup(Setup);
+
+    TArray<uint8> StartPacket;
+    const uint32 Seed = static_cast<uint32>(FMath::Rand());
+    if (!LockstepSession.StartAuthority(Setup, Seed, LockstepHashIntervalTicks, StartPacket))
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== LOCKSTEP: Nie udało się przygotować pakietu startowego ==="));
+        bCombatPhaseActive = false;
+        return;
+    }
+
+    MulticastCombatStarted(GetAliveUnitCount(0) + GetAliveUnitCount(1), CombatUpdateInterval);
+    MulticastLockstepBattleStart(StartPacket, LockstepHashIntervalTicks);
+
+    UE_LOG(LogTemp, Warning, TEXT("=== LOCKSTEP: Start bitwy - jednostki: %d, pakiet startowy: %d B, skrót co %d ticków ==="),
+        Setup.Placements.Num(), StartPacket.Num(), LockstepSession.GetHashIntervalTicks());
+}
+
+/// <summary>
+/// Przesuwa bitwę lockstep. Serwer rozsyła skróty stanu i kończy bitwę, klient prosi o migawkę
+/// po wykryciu rozbieżności.
+/// </summary>
+/// <param name="DeltaTime">Czas klatki</param>
+void AUnitManager::UpdateLockstepBattle(float DeltaTime)
+{
+    TArray<FLockstepHash> Hashes;
+    LockstepSession.Advance(DeltaTime, Hashes);
+
+    if (!HasAuthority())
+    {
+        // Klient nie ma połączenia z managerem - prośba idzie przez kontroler lokalnego gracza
+        if (LockstepSession.NeedsResync() && !bLockstepSnapshotRequested)
+        {
+            if (AStrategyPlayerController* PlayerController = Cast<AStrategyPlayerController>(GetWorld()->GetFirstPlayerController()))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("=== LOCKSTEP: Rozbieżność stanu w ticku %d - prośba o migawkę ==="),
+                    LockstepSession.GetDesyncTick());
+                bLockstepSnapshotRequested = true;
+                PlayerController->ServerRequestBattleSnapshot();
+            }
+        }
+        return;
+    }
+
+    for (const FLockstepHash& TickHash : Hashes)
+    {
+        MulticastLockstepHash(TickHash.Tick, TickHash.Hash);
+    }
+
+    // Liczniki żywych jednostek (GameMode::DetermineBattleWinner) prowadzi symulacja
+    const FBattleSimState& State = LockstepSession.GetState();
+    if (AliveUnitCounts.Num() < 2)
+    {
+        AliveUnitCounts.SetNumZeroed(2);
+    }
+    AliveUnitCounts[0] = State.GetAliveCount(0);
+    AliveUnitCounts[1] = State.GetAliveCount(1);
+
+    if (State.IsFinished())
+    {
+        const FBattleSimResult Result = State.GetResult();
+        MulticastLockstepBattleFinished(State.GetTickCount(), State.ComputeStateHash(), Result.Survivors[0], Result.Survivors[1]);
+
+        UE_LOG(LogTemp, Warning, TEXT("=== LOCKSTEP: Koniec bitwy po %d tickach - Gracz 0: %d, Gracz 1: %d ==="),
+            State.GetTickCount(), Result.Survivors[0], Result.Survivors[1]);
+
+        StopCombatPhase();
+        OnCombatEnded.Broadcast(Result.Survivors[0], Result.Survivors[1]);
+    }
+}
+
+/// <summary>
+/// Wysyła graczowi pełną migawkę stanu bitwy lockstep (serwer).
+/// </summary>
+/// <param name="Requester">Kontroler gracza, którego symulacja się rozjechała</param>
+void AUnitManager::SendLockstepSnapshot(AStrategyPlayerController* Requester)
+{
+    if (!HasAuthority() || !Requester || !LockstepSession.IsActive())
+    {
+        return;
+    }
+
+    TArray<uint8> Snapshot;
+    if (LockstepSession.SaveSnapshot(Snapshot))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== LOCKSTEP: Wysłano migawkę stanu (%d B) w ticku %d ==="),
+            Snapshot.Num(), LockstepSession.GetState().GetTickCount());
+        Requester->ClientReceiveBattleSnapshot(Snapshot);
+    }
+}
+
+/// <summary>
+/// Zastępuje lokalny stan bitwy lockstep migawką serwera (klient).
+/// </summary>
+/// <param name="SnapshotBytes">Migawka serwera</param>
+void AUnitManager::ApplyLockstepSnapshot(const TArray<uint8>& SnapshotBytes)
+{
+    bLockstepSnapshotRequested = false;
+
+    if (LockstepSession.ApplySnapshot(SnapshotBytes))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("=== LOCKSTEP: Resynchronizacja z migawki - tick %d (resynchronizacji: %d) ==="),
+            LockstepSession.GetState().GetTickCount(), LockstepSession.GetResyncCount());
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== LOCKSTEP: Odrzucono migawkę stanu (%d B) ==="), SnapshotBytes.Num());
+    }
+}
+
+/// <summary>
+/// Uruchamia test obciążeniowy: armie w zadanym szyku na powiększonej planszy walczą przez pełny
+/// potok walki serwera (siatka przestrzenna, koło czasowe, zbiorcze obrażenia). Mierzy czas klatki
+/// i pamięć na jednostkę. Istniejące jednostki są usuwane, a klienci nie dostają zdarzeń spawnu.
+/// </summary>
+/// <param name="Config">Parametry testu</param>
+/// <returns>True jeśli test wystartował</returns>
+bool AUnitManager::StartCombatStressTest(const FCombatStressConfig& Config)
+{
+    if (!HasAuthority())
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== TEST OBCIĄŻENIOWY: Klient nie może uruchomić testu ==="));
+        return false;
+    }
+
+    if (bStressTestActive || bCombatPhaseActive)
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== TEST OBCIĄŻENIOWY: Walka jest już w toku ==="));
+        return false;
+    }
+
+    ActiveStressConfig = Config;
+    ActiveStressConfig.UnitsPerSide = FMath::Clamp(Config.UnitsPerSide, 1, 50000);
+
+    // Rozstawienie obu armii i plansza obejmująca je z zapasem kilku komórek siatki przestrzennej
+    TArray<FVector2D> Positions[2];
+    FCombatStressFormation::Generate(ActiveStressConfig, 0, Positions[0]);
+    FCombatStressFormation::Generate(ActiveStressConfig, 1, Positions[1]);
+    const FBox2D BoardBounds = FCombatStressFormation::ComputeBoardBounds(Positions[0], Positions[1], SpatialGridCellSize * 4.0f);
+
+    UE_LOG(LogTemp, Warning, TEXT("=== TEST OBCIĄŻENIOWY: Start - %d jednostek na stronę, szyk: %s, prezentacja: %s, plansza: %.0f x %.0f ==="),
+        ActiveStressConfig.UnitsPerSide, *StaticEnum<EStressFormation>()->GetNameStringByValue(static_cast<int64>(ActiveStressConfig.Formation)),
+        ActiveStressConfig.bWithPresentation ? TEXT("TAK") : TEXT("NIE"), BoardBounds.GetSize().X, BoardBounds.GetSize().Y);
+
+    // Logi pojedynczych ataków i ruchów zdominowałyby pomiar - do końca testu tylko błędy
+    SavedLogVerbosity = LogTemp.GetVerbosity();
+    LogTemp.SetVerbosity(ELogVerbosity::Error);
+    bStressTestActive = true;
+
+    DestroySpawnedUnitActors();
+    ClearAllUnits();
+
+    // Siatka przestrzenna obejmująca całą powiększoną planszę
+    SavedSpatialGridWorldMin = SpatialGridWorldMin;
+    SavedSpatialGridWorldMax = SpatialGridWorldMax;
+    SpatialGridWorldMin = BoardBounds.Min;
+    SpatialGridWorldMax = BoardBounds.Max;
+    if (bUseSpatialPartitioning)
+    {
+        SpatialGrid = nullptr;
+        InitializeSpatialGrid();
+    }
+
+    // Plansza AGridManagera (warstwa nawigacji, a za nią obszar bitwy i pola przepływu) też obejmuje obie armie
+    if (!GridManagerRef)
+    {
+        InitializeGridManager();
+    }
+    if (GridManagerRef)
+    {
+        SavedGridWidth = GridManagerRef->GridWidth;
+        SavedGridHeight = GridManagerRef->GridHeight;
+        SavedGridOrigin = GridManagerRef->GetGridOrigin();
+        SavedNavigationLayer = GridManagerRef->GetNavigationLayer();
+
+        // Komórka X zajmuje [X - 0.5, X + 0.5] * CellSize - komórka (0, 0) pół komórki od rogu planszy
+        const float CellSize = GridManagerRef->CellSize;
+        GridManagerRef->ResizeGrid(
+            FMath::CeilToInt(BoardBounds.GetSize().X / CellSize),
+            FMath::CeilToInt(BoardBounds.GetSize().Y / CellSize),
+            FVector(BoardBounds.Min.X + CellSize * 0.5f, BoardBounds.Min.Y + CellSize * 0.5f, SavedGridOrigin.Z));
+        bStressGridResized = true;
+    }
+
+    const int32 TotalUnits = Positions[0].Num() + Positions[1].Num();
+    SpawnedUnits.Reserve(TotalUnits);
+    CombatUnitsArray.Reset(TotalUnits);
+
+    const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+    const double SpawnStartSeconds = FPlatformTime::Seconds();
+
+    for (int32 PlayerID = 0; PlayerID < 2; PlayerID++)
+    {
+        for (int32 i = 0; i < Positions[PlayerID].Num(); i++)
+        {
+            // Armie mieszane - typy jednostek na przemian
+            const EBaseUnitType UnitType = static_cast<EBaseUnitType>(i % FBattleSimSetup::NumUnitTypes);
+            if (ABaseUnit* Unit = SpawnStressUnit(PlayerID, UnitType, Positions[PlayerID][i], BoardBounds, ActiveStressConfig.bWithPresentation))
+            {
+                CombatUnitsArray.Add(Unit);
+            }
+        }
+    }
+
+    // Tablica walki wypełniona od razu - bez wyszukiwania wolnych slotów dla każdej jednostki
+    MaxCombatUnits = CombatUnitsArray.Num();
+    ActiveCombatUnitsCount = CombatUnitsArray.Num();
+
+    const uint64 UsedPhysicalAfter = FPlatformMemory::GetStats().UsedPhysical;
+
+    LastStressReport = FCombatStressReport();
+    LastStressReport.UnitCount = CombatUnitsArray.Num();
+    LastStressReport.SpawnSeconds = static_cast<float>(FPlatformTime::Seconds() - SpawnStartSeconds);
+    if (LastStressReport.UnitCount > 0)
+    {
+        const uint64 UsedPhysicalDelta = UsedPhysicalAfter > UsedPhysicalBefore ? UsedPhysicalAfter - UsedPhysicalBefore : 0;
+        LastStressReport.MeasuredBytesPerUnit = static_cast<float>(static_cast<double>(UsedPhysicalDelta) / LastStressReport.UnitCount);
+        LastStressReport.ActorObjectBytes = CombatUnitsArray[0]->GetClass()->GetStructureSize();
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("=== TEST OBCIĄŻENIOWY: Nie utworzono żadnej jednostki ==="));
+        FinishCombatStressTest();
+        return false;
+    }
+
+    StressTickRecorder.Reset(FMath::CeilToInt(ActiveStressConfig.DurationSeconds * 120.0f));
+    StartCombatPhase();
+
+    StressStartGameSeconds = GetWorld()->GetTimeSeconds();
+    StressLastTickSeconds = FPlatformTime::Seconds();
+    return true;
+}
+
+/// <summary>
+/// Kończy test obciążeniowy: zapisuje raport, usuwa armie i przywraca planszę oraz logi.
+/// </summary>
+void AUnitManager::FinishCombatStressTest()
+{
+    if (!HasAuthority() || !bStressTestActive)
+    {
+        return;
+    }
+
+    StressTickRecorder.Summarize(LastStressReport);
+    LastStressReport.SurvivingUnits = GetAliveUnitCount(0) + GetAliveUnitCount(1);
+
+    if (bCombatPhaseActive)
+    {
+        StopCombatPhase();
+    }
+
+    DestroySpawnedUnitActors();
+    ClearAllUnits();
+
+    // Przywrócenie planszy gry
+    SpatialGridWorldMin = SavedSpatialGridWorldMin;
+    SpatialGridWorldMax = SavedSpatialGridWorldMax;
+    if (bUseSpatialPartitioning)
+    {
+        SpatialGrid = nullptr;
+        InitializeSpatialGrid();
+    }
+
+    if (bStressGridResized && GridManagerRef)
+    {
+        GridManagerRef->ResizeGrid(SavedGridWidth, SavedGridHeight, SavedGridOrigin);
+        GridManagerRef->RestoreNavigationLayer(SavedNavigationLayer);
+    }
+    bStressGridResized = false;
+    SavedNavigationLayer.Reset();
+
+    // Obszar bitwy, pola przepływu, serwis ścieżek i tablica rezerwacji z powrotem na planszy gry
+    UpdateBattleRegion(true);
+    InitializeCombatDataLocality();
+
+    bStressTestActive = false;
+    LogTemp.SetVerbosity(SavedLogVerbosity);
+
+    UE_LOG(LogTemp, Warning, TEXT("=== TEST OBCIĄŻENIOWY: Koniec - %s ==="), *LastStressReport.ToString());
+}
+
+/// <summary>
+/// Tworzy jednostkę testu obciążeniowego na pozycji świata poza strefami spawnu graczy.
+/// Bez prezentacji jednostka jest ukryta, bez kolizji, a siatka i pasek zdrowia nie tykają.
+/// </summary>
+/// <param name="PlayerID">ID gracza</param>
+/// <param name="UnitType">Typ jednostki</param>
+/// <param name="WorldPosition">Pozycja na planszy (XY)</param>
+/// <param name="BoardBounds">Granice powiększonej planszy</param>
+/// <param name="bWithPresentation">Czy jednostka ma być widoczna</param>
+/// <returns>Utworzona jednostka lub nullptr</returns>
+ABaseUnit* AUnitManager::SpawnStressUnit(int32 PlayerID, EBaseUnitType UnitType, const FVector2D& WorldPosition, const FBox2D& BoardBounds, bool bWithPresentation)
+{
+    // Bez przypisanej klasy (np. w teście automatycznym) używana jest klasa bazowa
+    TSubclassOf<ABaseUnit> UnitClass = GetUnitClassByType(UnitType);
+    if (!UnitClass)
+    {
+        UnitClass = ABaseUnit::StaticClass();
+    }
+
+    // Szyki są gęste - bez korekty pozycji przy kolizji
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    // Gracz 0 stoi po stronie ujemnego Y i patrzy w stronę gracza 1
+    const FVector WorldLocation(WorldPosition.X, WorldPosition.Y, 20.0f);
+    const FRotator SpawnRotation(0.0f, PlayerID == 0 ? 90.0f : -90.0f, 0.0f);
+
+    ABaseUnit* Unit = GetWorld()->SpawnActor<ABaseUnit>(UnitClass, WorldLocation, SpawnRotation, SpawnParams);
+    if (!Unit)
+    {
+        return nullptr;
+    }
+
+    Unit->TeamID = PlayerID;
+    Unit->UnitType = UnitType;
+    Unit->GridPosition = GridManagerRef ? GridManagerRef->GetCellFromWorld(WorldLocation)
+        : FGridCell(FMath::FloorToInt(WorldPosition.X / 100.0f), FMath::FloorToInt(WorldPosition.Y / 100.0f));
+
+    // Domyślne granice ruchu jednostki obejmują tylko planszę gry
+    Unit->MinWorldBounds = FVector(BoardBounds.Min.X, BoardBounds.Min.Y, Unit->MinWorldBounds.Z);
+    Unit->MaxWorldBounds = FVector(BoardBounds.Max.X, BoardBounds.Max.Y, Unit->MaxWorldBounds.Z);
+
+    if (!bWithPresentation)
+    {
+        Unit->SetActorHiddenInGame(true);
+        Unit->SetActorEnableCollision(false);
+        Unit->bHealthBarSuppressed = true;
+        Unit->HideHealthBar();
+        if (Unit->UnitMesh)
+        {
+            Unit->UnitMesh->SetComponentTickEnabled(false);
+        }
+    }
+
+    FSpawnedUnitData UnitData;
+    UnitData.Unit = Unit;
+    UnitData.PlayerID = PlayerID;
+    UnitData.GridPosition = Unit->GridPosition;
+    UnitData.UnitType = UnitType;
+    SpawnedUnits.Add(UnitData);
+    AdjustAliveUnitCount(PlayerID, 1);
+
+    return Unit;
+}
+
+/// <summary>
+/// Niszczy aktorów wszystkich zarejestrowanych jednostek (serwer). Tablice czyści ClearAllUnits.
+/// </summary>
+void AUnitManager::DestroySpawnedUnitActors()
+{
+    for (const FSpawnedUnitData& UnitData : SpawnedUnits)
+    {
+        if (UnitData.Unit && IsValid(UnitData.Unit))
+        {
+            UnitData.Unit->Destroy();
+        }
+    }
+}
+
 /// <summary>
 /// Funkcja diagnostyczna dla problemów z siecią.
 /// </summary>
@@ -7,10 +7,14 @@
 #include "Components/SceneComponent.h"
 #include "Components/WidgetComponent.h"
 #include "Net/UnrealNetwork.h"
+#include "CombatTimingWheel.h"
+#include "GridCell.h"
 #include "BaseUnit.generated.h"
 
 class AUnitManager;
 class USpatialGrid;
+class UUnitArchetype;
+struct FGridPathResult;
 
 UENUM(BlueprintType)
 enum class EBaseUnitType : uint8
@@ -35,6 +39,22 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUnitDied, ABaseUnit*, DeadUnit);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitDamaged, ABaseUnit*, DamagedUnit, int32, DamageAmount);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBaseUnitMoved, ABaseUnit*, MovedUnit);
 
+/// <summary>
+/// Geometria do celu liczona raz na tick symulacji (klucz: GFrameCounter, cel i pozycje obu jednostek -
+/// ruch w tej samej klatce uniewaznia wpis). Wszystkie galezie decyzji walki czytaja te wartosci zamiast
+/// ponownie liczyc odleglosc. Tylko watek gry - fazy rownolegle czytaja migawki, nie jednostki.
+/// </summary>
+struct FTargetRangeCache
+{
+    const ABaseUnit* Target = nullptr;
+    uint64 Frame = MAX_uint64;
+    FVector OwnerLocation = FVector::ZeroVector;
+    FVector TargetLocation = FVector::ZeroVector;
+    float DistanceSq = MAX_flt;
+    FVector Direction = FVector::ZeroVector;   // Znormalizowany kierunek w plaszczyznie XY
+    bool bInRange = false;
+};
+
 UCLASS(BlueprintType, Blueprintable)
 class MAGISTERKABKONKEL_API ABaseUnit : public AActor
 {
@@ -47,6 +67,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     virtual void Tick(float DeltaTime) override;
@@ -60,27 +81,9 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
     UWidgetComponent* HealthBarWidget;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Unit Stats", meta = (ClampMin = "1", DisplayName = "Max Health"))
-    int32 MaxHealth = 100;
-
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Replicated, Category = "Unit Stats", meta = (DisplayName = "Current Health"))
     int32 CurrentHealth = 100;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Stats", meta = (ClampMin = "1", DisplayName = "Attack Power"))
-    int32 Attack = 10;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Stats", meta = (ClampMin = "0", DisplayName = "Defense"))
-    int32 Defense = 5;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Stats", meta = (ClampMin = "1", DisplayName = "Movement Speed"))
-    float Speed = 1;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Stats", meta = (ClampMin = "1", DisplayName = "Attack Range"))
-    float AttackRange = 1.5f;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Stats", meta = (ClampMin = "0", DisplayName = "Unit Cost"))
-    int32 Cost = 10;
-
     UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Replicated, Category = "Position")
     FVector WorldPosition = FVector::ZeroVector;
 
@@ -94,7 +97,7 @@ public:
     FVector MaxWorldBounds = FVector(1000, 1000, 100);
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Grid")
-    FVector2D GridPosition = FVector2D(0, 0);
+    FGridCell GridPosition;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
     float GridSize = 100.0f;
@@ -105,6 +108,74 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Unit Settings", meta = (DisplayName = "Unit Type"))
     EBaseUnitType UnitType = EBaseUnitType::Tank;
 
+    // Niezmienne statystyki i strojenie paska zdrowia typu - jednostka trzyma tylko swój zmienny stan
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Unit Settings", meta = (DisplayName = "Archetype"))
+    UUnitArchetype* Archetype = nullptr;
+
+    // Archetyp jednostki, a bez przypisanego zasobu wspólny archetyp domyślny (nigdy nullptr)
+    const UUnitArchetype* GetArchetype() const;
+
+#if WITH_EDITORONLY_DATA
+    // Statystyki zapisane w Blueprintach jednostek sprzed archetypów - czyta je tylko komenda
+    // CreateUnitArchetypes, przenosząc je do zasobów DA_*. Wartości domyślne jak w dawnym konstruktorze.
+    UPROPERTY()
+    int32 MaxHealth_DEPRECATED = 100;
+
+    UPROPERTY()
+    int32 Attack_DEPRECATED = 10;
+
+    UPROPERTY()
+    int32 Defense_DEPRECATED = 5;
+
+    UPROPERTY()
+    float Speed_DEPRECATED = 5.0f;
+
+    UPROPERTY()
+    float AttackRange_DEPRECATED = 1.5f;
+
+    UPROPERTY()
+    float AttackCooldown_DEPRECATED = 1.5f;
+
+    UPROPERTY()
+    float SearchRange_DEPRECATED = 2000.0f;
+
+    UPROPERTY()
+    float MovementInterval_DEPRECATED = 2.0f;
+
+    UPROPERTY()
+    float TargetSearchInterval_DEPRECATED = 0.125f;
+
+    UPROPERTY()
+    float RotationSpeed_DEPRECATED = 5.0f;
+
+    UPROPERTY()
+    float HealthBarHeight_DEPRECATED = 80.0f;
+
+    UPROPERTY()
+    bool bShowHealthBar_DEPRECATED = true;
+
+    UPROPERTY()
+    bool bHealthBarAlwaysVisible_DEPRECATED = false;
+
+    UPROPERTY()
+    bool bHealthBarFaceCamera_DEPRECATED = true;
+
+    UPROPERTY()
+    bool bScaleWithDistance_DEPRECATED = true;
+
+    UPROPERTY()
+    float MinHealthBarScale_DEPRECATED = 0.5f;
+
+    UPROPERTY()
+    float MaxHealthBarScale_DEPRECATED = 2.0f;
+
+    UPROPERTY()
+    float MaxHealthBarVisibilityDistance_DEPRECATED = 2000.0f;
+
+    UPROPERTY()
+    FVector HealthBarOffset_DEPRECATED = FVector(0, 0, 80);
+#endif
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Replicated, Category = "Animation", meta = (DisplayName = "Current Animation State"))
     EAnimationState AnimationState = EAnimationState::Idle;
 
@@ -120,32 +191,11 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Replicated, Category = "Status")
     bool bCanAttack = true;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar", meta = (ClampMin = "10", ClampMax = "200", DisplayName = "Health Bar Height"))
-    float HealthBarHeight = 80.0f;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar", meta = (DisplayName = "Show Health Bar"))
-    bool bShowHealthBar = true;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar", meta = (DisplayName = "Health Bar Always Visible"))
-    bool bHealthBarAlwaysVisible = false;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar 3D", meta = (DisplayName = "Always Face Camera"))
-    bool bHealthBarFaceCamera = true;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar 3D", meta = (DisplayName = "Scale With Distance"))
-    bool bScaleWithDistance = true;
+    // Pasek zdrowia wyłączony dla tej instancji (np. jednostki testu obciążeniowego bez prezentacji)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Health Bar")
+    bool bHealthBarSuppressed = false;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar 3D", meta = (ClampMin = "0.1", ClampMax = "3.0", DisplayName = "Min Scale"))
-    float MinHealthBarScale = 0.5f;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar 3D", meta = (ClampMin = "0.1", ClampMax = "5.0", DisplayName = "Max Scale"))
-    float MaxHealthBarScale = 2.0f;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar 3D", meta = (ClampMin = "500", ClampMax = "5000", DisplayName = "Max Visibility Distance"))
-    float MaxHealthBarVisibilityDistance = 2000.0f;
-
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar 3D", meta = (DisplayName = "Health Bar Offset"))
-    FVector HealthBarOffset = FVector(0, 0, 80);
+    bool ShouldShowHealthBar() const;
 
     UPROPERTY(BlueprintAssignable, Category = "Events")
     FOnUnitDied OnUnitDied;
@@ -159,14 +209,19 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat")
     virtual void ReceiveDamage(int32 DamageAmount);
 
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Combat")
+    int32 CalculateDamageTaken(int32 RawDamage) const;
+
+    virtual void ApplyResolvedDamage(int32 ActualDamage, int32 HitCount);
+
     UFUNCTION(BlueprintCallable, Category = "Combat")
     virtual bool AttackTarget(ABaseUnit* Target);
 
     UFUNCTION(BlueprintCallable, Category = "Movement")
-    virtual bool MoveToGridPosition(FVector2D NewGridPosition);
+    virtual bool MoveToGridPosition(FGridCell NewGridPosition);
 
     UFUNCTION(BlueprintCallable, Category = "Movement")
-    virtual bool CanMoveToGridPosition(FVector2D NewGridPosition) const;
+    virtual bool CanMoveToGridPosition(FGridCell NewGridPosition) const;
 
     UFUNCTION(BlueprintCallable, Category = "Movement")
     virtual bool MoveToWorldPosition(FVector NewWorldPosition);
@@ -249,24 +304,15 @@ public:
     UFUNCTION(BlueprintImplementableEvent, Category = "Health Bar")
     void OnHealthBarUpdated(float HealthPercentage);
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (ClampMin = "0.1", ClampMax = "10.0", DisplayName = "Attack Cooldown"))
-    float AttackCooldown = 1.0f;
-
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (ClampMin = "0.1", ClampMax = "10.0", DisplayName = "Movement Speed"))
     float MovementSpeed = 200.0f;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Replicated, Category = "Combat", meta = (DisplayName = "Auto Combat Enabled"))
     bool bAutoCombatEnabled = false;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (DisplayName = "Search Range"))
-    float SearchRange = 1000.0f;
-
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (DisplayName = "Search Range Using Grid"))
     float SearchRangeGrid = 4.0f;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (DisplayName = "Rotation Speed"))
-    float RotationSpeed = 5.0f;
-
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (DisplayName = "Smooth Rotation"))
     bool bSmoothRotation = true;
 
@@ -277,7 +323,7 @@ public:
     virtual ABaseUnit* FindNearestEnemyUsingSpatialGrid(AUnitManager* UnitManager) const;
 
     UFUNCTION(BlueprintCallable, Category = "Combat Enhanced")
-    virtual void MoveTowardsTargetOptimized(ABaseUnit* Target);
+    virtual void MoveTowardsTargetOptimized(ABaseUnit* Target, float DeltaTime);
 
     UFUNCTION(BlueprintCallable, Category = "Combat Enhanced")
     virtual bool IsPathClearToTarget(ABaseUnit* Target, const TArray<ABaseUnit*>& NearbyUnits) const;
@@ -300,18 +346,47 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat State")
     float LastAttackTime;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (ClampMin = "0.1", ClampMax = "2.0", DisplayName = "Movement Interval"))
-    float MovementInterval = 0.5f;
-
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat State")
     float LastMovementTime;
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (ClampMin = "0.5", ClampMax = "3.0", DisplayName = "Target Search Interval"))
-    float TargetSearchInterval = 1.0f;
-
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat State")
     float LastTargetSearchTime;
 
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat State")
+    bool bAttackReady = true;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat State")
+    bool bMovementReady = true;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat State")
+    bool bTargetSearchReady = true;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat State")
+    float LastCombatUpdateTime;
+
+    float RunCombatUpdate(float WorldTime);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Combat State")
+    float GetCombatDecisionAge(float WorldTime) const;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Combat State")
+    float GetMovementDecisionAge(float WorldTime) const;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat State")
+    bool bCombatSleeping = false;
+
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    bool TryEnterCombatSleep();
+
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    void WakeFromCombatSleep();
+
+    // Slot w tabeli timerow AUnitManager (INDEX_NONE gdy niezarejestrowana)
+    int32 TimerSlotIndex = INDEX_NONE;
+
+    void ScheduleCombatTimer(ECombatTimerAction Action, float Delay);
+    void HandleCombatTimer(ECombatTimerAction Action);
+
     UFUNCTION(BlueprintCallable, Category = "Combat")
     virtual void StartAutoCombat();
 
@@ -325,7 +400,7 @@ public:
     virtual ABaseUnit* FindNearestEnemy(const TArray<ABaseUnit*>& AllUnits) const;
 
     UFUNCTION(BlueprintCallable, Category = "Combat")
-    virtual void MoveTowardsTarget(ABaseUnit* Target);
+    virtual void MoveTowardsTarget(ABaseUnit* Target, float DeltaTime);
 
     UFUNCTION(BlueprintCallable, Category = "Combat")
     virtual bool CanAttackTarget(ABaseUnit* Target) const;
@@ -348,6 +423,9 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Combat")
     virtual float GetDistanceToCurrentTarget() const;
 
+    const FTargetRangeCache& GetTargetRange(const ABaseUnit* Target) const;
+    void InvalidateTargetRange() { TargetRangeCache.Frame = MAX_uint64; }
+
     UFUNCTION(NetMulticast, Reliable)
     void MulticastReceiveDamage(int32 DamageAmount, int32 NewHealth);
 
@@ -388,6 +466,34 @@ public:
     void OnRep_WorldPosition();
     void HideUnit();
 
+    // Pula aktorów AUnitManager - jednostka ukryta i nieaktywna czeka na ponowny zakup
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, ReplicatedUsing = OnRep_bInUnitPool, Category = "Status")
+    bool bInUnitPool = false;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Status")
+    bool IsInUnitPool() const { return bInUnitPool; }
+
+    void DeactivateForPool();
+    void ActivateFromPool(const FVector& Location, const FRotator& Rotation);
+
+    // Trasa z serwisu ścieżek AUnitManager (wynik zapytania z RequestUnitPath)
+    void ReceiveGridPath(const FGridPathResult& Result);
+
+    // Tablica rezerwacji komórek AUnitManager - rozstrzygnięcie zgłoszenia z ClaimMoveCell, true po wykonanym kroku
+    bool ResolveReservedMove(bool bGranted);
+
+    // Unikanie kolizji AUnitManager - prędkość pożądana w tym ticku i wynik ORCA na kolejny
+    FVector2D GetPreferredVelocity() const;
+    FVector2D GetAvoidanceVelocity() const { return AvoidanceVelocity; }
+    void SetAvoidanceVelocity(const FVector2D& Velocity);
+
+    // Ruch wsadowy AUnitManager - zapis transformacji kroku (serwer) i pozycji z partii (klienci)
+    void ApplyBatchedMove(const FVector& NewLocation);
+    void ApplyReplicatedPosition(const FVector& NewLocation);
+
+    UFUNCTION()
+    void OnRep_bInUnitPool();
+
 protected:
     virtual void UpdateWorldPosition();
     virtual bool CanPerformAction() const;
@@ -407,4 +513,44 @@ protected:
 private:
     UPROPERTY()
     class APlayerController* PlayerController;
+
+    AUnitManager* GetCachedUnitManager();
+    FVector GetMovementDirection(const FTargetRangeCache& Range);
+    bool GetGridPathDirection(const FTargetRangeCache& Range, FVector& OutDirection);
+    void ResetGridPath();
+    bool RequestReservedMove(const FVector& NextPosition, const FTargetRangeCache& Range);
+    FVector ApplyAvoidance(const FVector& DesiredDirection);
+    FVector GetNextStepPosition(const FVector& From, const FVector& Direction, float DeltaTime, bool bStartingMove = false);
+    void SetLocationDeferred(const FVector& NewLocation);
+    void ResetAvoidance();
+
+    UPROPERTY(Transient)
+    AUnitManager* CachedUnitManager;
+
+    mutable FTargetRangeCache TargetRangeCache;
+
+    // Trasa po komórkach siatki omijająca zajęte komórki - ważna dopóki cel nie zmieni komórki
+    TArray<FGridCell> GridPath;
+    int32 GridPathIndex = 0;
+    int32 PendingGridPathRequest = INDEX_NONE;
+    FGridCell GridPathGoal = FGridCell(INDEX_NONE, INDEX_NONE);
+
+    // Krok zgłoszony do tablicy rezerwacji, wykonywany po wygranej w ResolveReservedMove
+    bool bHasReservedMove = false;
+    FVector ReservedMovePosition = FVector::ZeroVector;
+
+    // Zgłoszenie z poprzedniego ticku przegrało - kolejna decyzja szuka objazdu
+    bool bLostCellReservation = false;
+
+    // Prędkości w jednostkach świata na krok ruchu; pożądana ważna tylko w klatce PreferredVelocityFrame
+    FVector2D PreferredVelocity = FVector2D::ZeroVector;
+    uint64 PreferredVelocityFrame = MAX_uint64;
+    FVector2D AvoidanceVelocity = FVector2D::ZeroVector;
+    bool bHasAvoidanceVelocity = false;
+
+    // Długość bieżącego kroku względem Speed (ruch całkowany z czasem klatki)
+    float MoveStepScale = 1.0f;
+
+    // Czas ostatniego policzonego kroku (-1 = brak) - ścieżki timerów całkują ruch od tej chwili
+    float LastMovementDecisionTime = -1.0f;
 };
\ No newline at end of file
@@ -0,0 +1,56 @@
+// BatchedUnitMover.h - Delta-time movement integration with deferred, batched transform updates
+#pragma once
+
+#include "CoreMinimal.h"
+
+class ABaseUnit;
+
+/// <summary>
+/// Ruch jednostek w walce niezalezny od liczby klatek. Jednostki licza krok z predkosci i czasu
+/// od poprzedniej decyzji, a zamiast od razu zmieniac transformacje zglaszaja nowa pozycje do kolejki.
+/// Manager zapisuje wszystkie transformacje w jednym przebiegu po tickach jednostek, a pozycje
+/// do klientow wysyla w partiach z wlasna, nizsza czestotliwoscia.
+/// </summary>
+class MAGISTERKABKONKEL_API FBatchedUnitMover
+{
+public:
+    /// Najdluzszy czas calkowany w jednym kroku - przycina skoki po przycieciu klatki
+    static constexpr float MaxStepDeltaTime = 0.25f;
+
+    /// Pozycja po DeltaTime sekundach ruchu w kierunku Direction (plaszczyzna XY, wysokosc bez zmian).
+    /// Direction o dlugosci ponizej 1 (zwolnienie z unikania kolizji) proporcjonalnie skraca krok.
+    /// StepLength to dlugosc kroku na StepTime sekund, czyli Speed jednostki i czas kroku, dla ktorego go dobrano.
+    static FVector IntegrateStep(const FVector& From, const FVector& Direction, float StepLength, float StepTime, float DeltaTime);
+
+    /// Skala dlugosci kroku wzgledem StepLength dla danego DeltaTime
+    static float GetStepScale(float StepTime, float DeltaTime);
+
+    void QueueMove(ABaseUnit* Unit, const FVector& NewLocation);
+
+    /// Zapisuje transformacje wszystkich zgloszonych ruchow. Zwraca liczbe wykonanych ruchow.
+    int32 Flush();
+
+    /// Odlicza czas do kolejnej publikacji pozycji. true - nalezy wyslac partie pozycji.
+    bool ConsumePublishTime(float DeltaTime, float PublishInterval);
+
+    /// Jednostki przesuniete od ostatniej publikacji (lista jest czyszczona)
+    void TakeMovedUnits(TArray<ABaseUnit*>& OutUnits);
+
+    void Reset();
+    int32 GetQueuedMoveCount() const { return QueuedMoves.Num(); }
+
+private:
+    struct FQueuedMove
+    {
+        TWeakObjectPtr<ABaseUnit> Unit;
+        FVector Location;
+    };
+
+    TArray<FQueuedMove> QueuedMoves;
+    TMap<const ABaseUnit*, int32> QueuedMoveIndex;
+
+    TArray<TWeakObjectPtr<ABaseUnit>> MovedUnits;
+    TSet<const ABaseUnit*> MovedUnitSet;
+
+    float PublishAccumulator = 0.0f;
+};
@@ -0,0 +1,96 @@
+// BattleFlowField.h - Per-team flow field over the battle grid (direction toward the nearest enemy concentration)
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// Pole przeplywu jednej druzyny na siatce AGridManager. Celami sa komorki zajete przez wrogow -
+/// im wiecej wrogow w komorce, tym nizszy jej koszt startowy, wiec pole prowadzi do najblizszego
+/// skupiska. Pole jest przeliczane tylko po zmianie zajetosci celow lub blokad, a jednostka
+/// pobiera gotowy kierunek ze swojej komorki zamiast sprawdzac kierunki wokol siebie.
+/// Zmiana samych celow jest naprawiana lokalnie (uniewaznienie komorek zaleznych od celu, ktory
+/// zdrozal, i Dijkstra tylko z granicy zmienionego obszaru) - pelne przeliczenie tylko po zmianie
+/// blokad lub kosztow terenu.
+/// Komorki maja srodek w Origin + (X, Y) * CellSize, tak jak w AGridManager.
+/// </summary>
+class MAGISTERKABKONKEL_API FBattleFlowField
+{
+public:
+    static constexpr int32 OrthogonalCost = 10;
+    static constexpr int32 DiagonalCost = 14;
+    static constexpr int32 MaxGoalConcentration = 4;   // Liczba wrogow w komorce, powyzej ktorej koszt juz nie spada
+    static constexpr int32 Unreachable = MAX_int32;
+
+    void Initialize(int32 InWidth, int32 InHeight, float InCellSize, const FVector& InOrigin);
+    void Reset();
+    bool IsInitialized() const { return Width > 0 && Height > 0; }
+
+    /// Zbieranie zajetosci celow: BeginGoals, AddGoal dla kazdego wroga, CommitGoals.
+    /// CommitGoals przelicza pole tylko gdy zajetosc rozni sie od poprzedniej i zwraca true po przeliczeniu
+    /// (naprawie komorek zmienionych celow lub pelnym przeliczeniu).
+    void BeginGoals();
+    void AddGoal(const FVector& WorldLocation);
+    bool CommitGoals();
+
+    /// Komorki nieprzechodnie (np. przeszkody) - zmiana oznacza pole do przeliczenia w Update
+    void SetCellBlocked(int32 X, int32 Y, bool bBlocked);
+
+    /// Mnoznik kosztu kroku z komorki (1 - teren zwykly) - zmiana oznacza pole do przeliczenia w Update
+    void SetCellMoveCost(int32 X, int32 Y, uint8 Cost);
+    bool Update();
+
+    /// Znormalizowany kierunek (plaszczyzna XY) z komorki pod WorldLocation; false poza siatka,
+    /// w komorce celu bez lepszego sasiada i w komorkach bez drogi do celu
+    bool SampleDirection(const FVector& WorldLocation, FVector& OutDirection) const;
+
+    int32 WorldToCellIndex(const FVector& WorldLocation) const;
+    int32 GetCellCost(int32 X, int32 Y) const;
+    int32 GetRecomputeCount() const { return RecomputeCount; }
+    int32 GetFullRecomputeCount() const { return FullRecomputeCount; }
+    int32 GetLastUpdatedCellCount() const { return LastUpdatedCellCount; }
+    int32 GetWidth() const { return Width; }
+    int32 GetHeight() const { return Height; }
+
+private:
+    struct FOpenCell
+    {
+        int32 Cost;
+        int32 Index;
+
+        bool operator<(const FOpenCell& Other) const { return Cost < Other.Cost; }
+    };
+
+    void Recompute();
+    void RepairGoals(const TArray<uint8>& PreviousGoalCounts);
+    void PropagateCosts(bool bTrackChanges);
+    void UpdateFlowDirection(int32 CellIndex);
+    void MarkCellChanged(int32 CellIndex);
+    bool CanStep(int32 X, int32 Y, int32 Direction) const;
+    int32 GetStepCost(int32 Direction, int32 CellIndex) const;
+    static int32 GetSeedCost(uint8 GoalCount);
+
+    int32 Width = 0;
+    int32 Height = 0;
+    float CellSize = 100.0f;
+    FVector Origin = FVector::ZeroVector;
+
+    TArray<uint8> GoalCounts;
+    TArray<uint8> PendingGoalCounts;
+    TArray<bool> BlockedCells;
+    TArray<uint8> MoveCosts;
+
+    TArray<int32> IntegrationCost;
+    TArray<int8> FlowDirections;       // Indeks kierunku 0-7 lub INDEX_NONE
+    TArray<FOpenCell> OpenCells;
+
+    // Bufory naprawy - czyszczone po kazdej naprawie tylko w odwiedzonych komorkach
+    TBitArray<> InvalidatedCells;
+    TBitArray<> ChangedCells;
+    TArray<int32> InvalidatedList;
+    TArray<int32> ChangedList;
+
+    bool bDirty = false;
+    int32 RecomputeCount = 0;
+    int32 FullRecomputeCount = 0;
+    int32 LastUpdatedCellCount = 0;
+};
@@ -0,0 +1,57 @@
+// BattleReplay.h - Deterministic battle replay (seed + initial placement) with a per-tick hash verifier
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleSimulator.h"
+
+/// <summary>
+/// Wynik weryfikacji powtorki.
+/// </summary>
+struct FBattleReplayVerifyResult
+{
+    bool bMatches = false;
+    int32 TicksCompared = 0;
+    int32 FirstMismatchTick = INDEX_NONE;
+    uint32 ExpectedHash = 0;
+    uint32 ActualHash = 0;
+    FString Error;
+};
+
+/// <summary>
+/// Powtorka bitwy: tylko stan poczatkowy (statystyki, rozstawienie), ziarno i wersja symulacji.
+/// Cala bitwa wynika z tych danych, wiec odtworzenie to ponowna symulacja. Skroty stanu po kazdym
+/// ticku z nagrania pozwalaja wykryc niedeterminizm lub zmiane zasad symulacji.
+/// </summary>
+struct MAGISTERKABKONKEL_API FBattleReplay
+{
+    static constexpr uint32 FileMagic = 0x50455242;   // "BREP"
+
+    // Zwiekszyc przy kazdej zmianie zasad FBattleSimState, ktora zmienia przebieg bitwy
+    static constexpr int32 CurrentSimVersion = 3;
+
+    int32 SimVersion = CurrentSimVersion;
+    uint32 Seed = 0;
+    float PositionJitterCells = 0.0f;
+    bool bRandomizeAttackPhase = false;
+    FBattleSimSetup Setup;
+
+    TArray<uint32> TickHashes;
+    FBattleSimResult RecordedResult;
+
+    /// Symuluje bitwe i zapisuje skrot stanu po kazdym ticku
+    static FBattleReplay Record(const FBattleSimSetup& InSetup, uint32 InSeed,
+        float InPositionJitterCells = 0.0f, bool bInRandomizeAttackPhase = false);
+
+    /// Przygotowuje stan do odtwarzania (FBattleSimState::Advance z dowolnie skalowanym czasem)
+    void StartPlayback(FBattleSimState& OutState) const;
+
+    /// Ponownie symuluje bitwe i porownuje skroty tick po ticku
+    FBattleReplayVerifyResult Verify() const;
+
+    bool SaveToBytes(TArray<uint8>& OutBytes) const;
+    bool LoadFromBytes(const TArray<uint8>& Bytes);
+    bool SaveToFile(const FString& FilePath) const;
+    bool LoadFromFile(const FString& FilePath);
+
+    friend FArchive& operator<<(FArchive& Ar, FBattleReplay& Replay);
+};
@@ -0,0 +1,254 @@
+// BattleSimulator.h - Headless battle simulation for balance runs (no actors, rendering or networking)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BaseUnit.h"
+
+struct FSpawnedUnitData;
+class UUnitArchetype;
+
+/// <summary>
+/// Arytmetyka symulacji. Float to dotychczasowa sciezka (porownanie z walka na aktorach),
+/// FixedPoint daje bitowo identyczny przebieg niezaleznie od kompilatora, zestawu instrukcji
+/// i poziomu optymalizacji - wymagany dla lockstepu i weryfikacji powtorek miedzy buildami.
+/// </summary>
+enum class EBattleSimMath : uint8
+{
+    Float,
+    FixedPoint
+};
+
+/// <summary>
+/// Statystyki jednego typu jednostki uzywane przez symulacje. Odpowiadaja polom ABaseUnit.
+/// </summary>
+struct MAGISTERKABKONKEL_API FSimUnitStats
+{
+    int32 MaxHealth = 100;
+    int32 Attack = 10;
+    int32 Defense = 5;
+    float Speed = 5.0f;              // Dlugosc kroku ruchu w jednostkach swiata
+    float AttackRange = 1.5f;
+    float AttackCooldown = 1.5f;
+    float MovementInterval = 2.0f;
+    float SearchRange = 2000.0f;
+    int32 Cost = 10;
+
+    static FSimUnitStats FromArchetype(const UUnitArchetype* Archetype);
+};
+
+/// <summary>
+/// Poczatkowe ustawienie jednostki - ten sam uklad co FSpawnedUnitData.
+/// </summary>
+struct FSimUnitPlacement
+{
+    int32 PlayerID = 0;
+    FGridCell GridPosition;
+    EBaseUnitType UnitType = EBaseUnitType::Tank;
+};
+
+/// <summary>
+/// Kompletny stan poczatkowy bitwy: statystyki typow, rozstawienie i parametry symulacji.
+/// </summary>
+struct MAGISTERKABKONKEL_API FBattleSimSetup
+{
+    static constexpr int32 NumUnitTypes = 4;
+
+    FSimUnitStats TypeStats[NumUnitTypes];
+    TArray<FSimUnitPlacement> Placements;
+
+    float CellSize = 100.0f;
+    float TickSeconds = 0.1f;
+    float MaxBattleSeconds = 120.0f;
+    EBattleSimMath MathMode = EBattleSimMath::Float;
+
+    void AddPlacements(const TArray<FSpawnedUnitData>& SpawnedUnits);
+    const FSimUnitStats& GetStats(EBaseUnitType UnitType) const;
+};
+
+/// <summary>
+/// Wynik pojedynczej bitwy.
+/// </summary>
+struct FBattleSimResult
+{
+    int32 WinnerPlayerID = INDEX_NONE;   // INDEX_NONE = remis
+    float DurationSeconds = 0.0f;
+    int32 Survivors[2] = { 0, 0 };
+    int32 SurvivingCost[2] = { 0, 0 };
+};
+
+/// <summary>
+/// Parametry serii bitew. Kazda bitwa ma wlasne ziarno (BaseSeed + indeks), ktore losuje
+/// przesuniecie pozycji i faze cooldownu ataku, dzieki czemu seria daje rozklad wynikow.
+/// </summary>
+struct FBattleSimBatchRequest
+{
+    FBattleSimSetup Setup;
+    int32 NumBattles = 1000;
+    uint32 BaseSeed = 1;
+    float PositionJitterCells = 0.25f;
+    bool bRandomizeAttackPhase = true;
+    bool bParallel = true;
+    bool bKeepBattleResults = false;
+};
+
+/// <summary>
+/// Zagregowane wyniki serii bitew.
+/// </summary>
+struct FBattleSimBatchResult
+{
+    int32 NumBattles = 0;
+    int32 Wins[2] = { 0, 0 };
+    int32 Draws = 0;
+    float WinRate[2] = { 0.0f, 0.0f };
+
+    float MeanDurationSeconds = 0.0f;
+    float MedianDurationSeconds = 0.0f;
+    float P90DurationSeconds = 0.0f;
+    float MaxDurationSeconds = 0.0f;
+
+    // Liczba bitew zakonczonych w danym przedziale czasu (DurationBucketSeconds na przedzial)
+    float DurationBucketSeconds = 5.0f;
+    TArray<int32> DurationHistogram;
+
+    float MeanSurvivors[2] = { 0.0f, 0.0f };
+    float MeanSurvivingCost[2] = { 0.0f, 0.0f };
+
+    double WallSeconds = 0.0;
+    TArray<FBattleSimResult> Battles;
+};
+
+/// <summary>
+/// Arytmetyka stalopozycyjna trybu EBattleSimMath::FixedPoint. Pozycje to jednostki swiata z 8 bitami
+/// czesci ulamkowej, odleglosci porownywane jako kwadraty w int64, a kierunek ruchu wybierany
+/// z 64 kierunkow tablicy zamiast normalizacji wektora.
+/// </summary>
+struct MAGISTERKABKONKEL_API FSimFixedMath
+{
+    static constexpr int32 FractionBits = 8;
+    static constexpr int32 One = 1 << FractionBits;
+    static constexpr int32 NumDirections = 64;
+    static constexpr int32 DirectionBits = 14;   // Skladowe kierunku w tablicy: 1.0 = 1 << 14
+
+    static int32 FromFloat(float Value);
+    static float ToFloat(int32 Value) { return static_cast<float>(Value) / One; }
+
+    /// Indeks kierunku z tablicy najblizszy wektorowi (DeltaX, DeltaY); 0 = +X, 16 = +Y
+    static int32 DirectionIndex(int64 DeltaX, int64 DeltaY);
+
+    /// Skladowe kierunku o danym indeksie (skala 1 << DirectionBits)
+    static void GetDirection(int32 Index, int32& OutX, int32& OutY);
+
+    /// Dlugosc Length rzutowana na skladowa kierunku, z zaokragleniem
+    static int32 ScaleByDirection(int32 DirectionComponent, int32 Length);
+};
+
+/// <summary>
+/// Stan jednej jednostki w symulacji - tylko pola potrzebne w petli walki. W trybie FixedPoint
+/// stan prowadza pola FixedX/FixedY i Next*Tick, a X i Y sa jedynie ich kopia do wyswietlania.
+/// </summary>
+struct FSimUnitState
+{
+    float X = 0.0f;
+    float Y = 0.0f;
+    float NextAttackTime = 0.0f;
+    float NextMoveTime = 0.0f;
+    int32 FixedX = 0;
+    int32 FixedY = 0;
+    int32 NextAttackTick = 0;
+    int32 NextMoveTick = 0;
+    int32 Health = 0;
+    int32 PendingDamage = 0;
+    int32 Target = INDEX_NONE;
+    int32 Team = 0;
+    int32 TypeIndex = 0;
+    const FSimUnitStats* Stats = nullptr;
+};
+
+using FSimUnitStateArray = TArray<FSimUnitState, TInlineAllocator<64>>;
+
+/// <summary>
+/// Krokowy stan jednej bitwy. Pozwala odtwarzac bitwe tick po ticku (np. powtorke z dowolna
+/// predkoscia) i liczyc skrot stanu po kazdym ticku. Setup musi zyc dluzej niz ten obiekt.
+/// </summary>
+class MAGISTERKABKONKEL_API FBattleSimState
+{
+public:
+    void Initialize(const FBattleSimSetup& InSetup, uint32 Seed = 0,
+        float PositionJitterCells = 0.0f, bool bRandomizeAttackPhase = false);
+
+    /// Jeden tick symulacji o dlugosci Setup.TickSeconds
+    void Step();
+
+    /// Wykonuje tyle pelnych tickow, ile miesci sie w DeltaSeconds (z akumulacja reszty)
+    int32 Advance(float DeltaSeconds);
+
+    bool IsFinished() const;
+    uint32 ComputeStateHash() const;
+    FBattleSimResult GetResult() const;
+
+    /// Zapis/odczyt pelnego stanu dynamicznego (bez Setup) - resynchronizacja klienta lockstep.
+    /// Odczyt wymaga stanu zainicjalizowanego tym samym Setup.
+    void SerializeSnapshot(FArchive& Ar);
+
+    bool IsFixedPoint() const { return bFixedPoint; }
+    const FSimUnitStateArray& GetUnits() const { return Units; }
+    float GetTime() const { return Time; }
+    int32 GetTickCount() const { return TickCount; }
+    int32 GetAliveCount(int32 Team) const { return (Team == 0 || Team == 1) ? Alive[Team] : 0; }
+
+private:
+    const FBattleSimSetup* Setup = nullptr;
+    FSimUnitStateArray Units;
+    int32 Alive[2] = { 0, 0 };
+    float Time = 0.0f;
+    float TickSeconds = 0.1f;
+    float TimeAccumulator = 0.0f;
+    int32 TickCount = 0;
+
+    // Tryb stalopozycyjny - progi i czasy typow przeliczone raz przy inicjalizacji
+    struct FFixedTypeStats
+    {
+        int32 AttackRange = 0;
+        int32 SearchRange = 0;
+        int32 StepLength = 0;
+        int32 AttackCooldownTicks = 0;
+        int32 MovementIntervalTicks = 0;
+    };
+
+    bool bFixedPoint = false;
+    int32 FixedCellSize = 0;
+    int32 MaxBattleTicks = 0;
+    FFixedTypeStats FixedTypeStats[FBattleSimSetup::NumUnitTypes];
+
+    // Obrazenia typu atakujacego zadawane typowi celu, max(Attack - Defense, 1) - liczone raz przy inicjalizacji
+    int32 DamageTable[FBattleSimSetup::NumUnitTypes][FBattleSimSetup::NumUnitTypes];
+
+    // Indeksy jednostek pogrupowane wedlug typu - stale typu sa czytane raz na grupe
+    TArray<int32> TypeGroups[FBattleSimSetup::NumUnitTypes];
+
+    int32 FindNearestEnemyIndex(int32 SeekerIndex) const;
+    int32 FindNearestEnemyIndexFixed(int32 SeekerIndex, int64 SearchRangeSq) const;
+    int32 SecondsToTicks(float Seconds) const;
+
+    // Jadro kroku generowane osobno dla kazdego typu - indeks typu jest stala czasu kompilacji,
+    // a Step wywoluje instancje raz na grupe
+    template <EBaseUnitType UnitType>
+    void StepTypeGroup();
+
+    template <EBaseUnitType UnitType>
+    void StepTypeGroupFixed();
+};
+
+/// <summary>
+/// Bezstanowy symulator bitew. Zasady odpowiadaja walce na serwerze: najblizszy wrog w SearchRange,
+/// atak max(Attack - Defense, 1) co AttackCooldown, krok o Speed co MovementInterval, obrazenia
+/// rozstrzygane zbiorczo na koniec ticka. Kolizje miedzy jednostkami sa pomijane.
+/// </summary>
+class MAGISTERKABKONKEL_API FBattleSimulator
+{
+public:
+    static FBattleSimResult RunBattle(const FBattleSimSetup& Setup, uint32 Seed = 0,
+        float PositionJitterCells = 0.0f, bool bRandomizeAttackPhase = false);
+
+    static FBattleSimBatchResult RunBatch(const FBattleSimBatchRequest& Request);
+};
@@ -0,0 +1,93 @@
+// BattleSquads.h - Squad clustering of same-team units with stable squad identities
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// Wpis jednostki dla planowania oddzialow - pozycja w plaszczyznie XY, druzyna i staly klucz
+/// (np. UniqueID aktora), po ktorym oddzial jest rozpoznawany miedzy przebudowami.
+/// </summary>
+struct FSquadMemberInput
+{
+    FVector2D Position = FVector2D::ZeroVector;
+    int32 TeamID = -1;
+    uint32 Key = 0;
+};
+
+/// <summary>
+/// Oddzial - spojne skupisko jednostek jednej druzyny. Lider (czlonek najblizszy srodka)
+/// podejmuje decyzje o celu i trasie za caly oddzial, pozostali utrzymuja przesuniecie
+/// wzgledem lidera z chwili przebudowy.
+/// </summary>
+struct FBattleSquad
+{
+    int32 SquadID = INDEX_NONE;
+    int32 TeamID = -1;
+
+    // Indeks wejscia lidera
+    int32 Leader = INDEX_NONE;
+
+    FVector2D Centroid = FVector2D::ZeroVector;
+
+    // Indeksy wejsc czlonkow i ich przesuniecia wzgledem lidera (ten sam porzadek)
+    TArray<int32> Members;
+    TArray<FVector2D> FormationOffsets;
+
+    int32 Num() const { return Members.Num(); }
+};
+
+/// <summary>
+/// Statystyki ostatniej przebudowy - podzialy i polaczenia oddzialow z poprzedniej przebudowy
+/// </summary>
+struct FSquadRebuildStats
+{
+    int32 SquadCount = 0;
+    int32 SplitCount = 0;
+    int32 MergeCount = 0;
+};
+
+/// <summary>
+/// Podzial jednostek na oddzialy. Jednostki tej samej druzyny blizej niz LinkDistance naleza do
+/// jednego skupiska (przeszukiwanie wszerz po kubelkach siatki o boku LinkDistance), a skupiska
+/// wieksze niz MaxSquadSize sa dzielone na kolejne oddzialy. Oddzial zachowuje ID, jesli wiekszosc
+/// jego czlonkow nalezala do tego samego oddzialu w poprzedniej przebudowie - dzieki temu rozpad
+/// i laczenie sie skupisk nie gubi decyzji podjetych przez oddzial.
+/// </summary>
+class MAGISTERKABKONKEL_API FBattleSquadPlanner
+{
+public:
+    void Rebuild(const TArray<FSquadMemberInput>& Inputs, float LinkDistance, int32 MaxSquadSize);
+    void Reset();
+
+    const TArray<FBattleSquad>& GetSquads() const { return Squads; }
+    const FSquadRebuildStats& GetLastRebuildStats() const { return LastStats; }
+
+    /// Indeks oddzialu w GetSquads() dla wejscia z ostatniej przebudowy (INDEX_NONE - brak)
+    int32 GetSquadIndexOf(int32 InputIndex) const
+    {
+        return MemberSquadIndex.IsValidIndex(InputIndex) ? MemberSquadIndex[InputIndex] : INDEX_NONE;
+    }
+
+private:
+    void CollectCluster(const TArray<FSquadMemberInput>& Inputs, int32 Seed, float LinkDistance, int32 MaxSquadSize, TArray<int32>& OutMembers);
+    void AssignSquadIDs(const TArray<FSquadMemberInput>& Inputs);
+
+    TArray<FBattleSquad> Squads;
+    TArray<int32> MemberSquadIndex;
+
+    // Kubelki siatki o boku LinkDistance - pierwszy wpis kubelka i lista jednokierunkowa wpisow
+    TMap<FIntPoint, int32> BucketHeads;
+    TArray<int32> NextInBucket;
+    TArray<FIntPoint> InputBuckets;
+
+    // Stan przeszukiwania: wpis przypisany do oddzialu / oczekujacy w kolejce
+    TArray<bool> Assigned;
+    TArray<bool> Queued;
+    TArray<int32> SearchQueue;
+
+    // Oddzial kazdego klucza z poprzedniej przebudowy
+    TMap<uint32, int32> PreviousSquadByKey;
+    int32 NextSquadID = 0;
+
+    FSquadRebuildStats LastStats;
+};
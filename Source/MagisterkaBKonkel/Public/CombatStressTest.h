@@ -0,0 +1,120 @@
+// CombatStressTest.h - Large-army stress mode: formations, tick-time recorder and report
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatStressTest.generated.h"
+
+UENUM(BlueprintType)
+enum class EStressFormation : uint8
+{
+    Block       UMETA(DisplayName = "Block"),
+    Line        UMETA(DisplayName = "Line"),
+    Wedge       UMETA(DisplayName = "Wedge"),
+    Scattered   UMETA(DisplayName = "Scattered")
+};
+
+/// <summary>
+/// Parametry testu obciazeniowego walki.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FCombatStressConfig
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress Test", meta = (ClampMin = "1", ClampMax = "50000"))
+    int32 UnitsPerSide = 1000;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress Test")
+    EStressFormation Formation = EStressFormation::Block;
+
+    // Odstep miedzy jednostkami w szyku (jednostki swiata)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress Test", meta = (ClampMin = "10"))
+    float Spacing = 100.0f;
+
+    // Odleglosc miedzy czolami armii
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress Test", meta = (ClampMin = "0"))
+    float FrontGap = 1000.0f;
+
+    // Czas trwania pomiaru; walka zakonczona wczesniej konczy test
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress Test", meta = (ClampMin = "0.1"))
+    float DurationSeconds = 30.0f;
+
+    // Bez prezentacji jednostki sa ukryte, a siatka i pasek zdrowia nie tykaja
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress Test")
+    bool bWithPresentation = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Stress Test")
+    int32 Seed = 1;
+};
+
+/// <summary>
+/// Wynik testu obciazeniowego: percentyle czasu klatki i pamiec na jednostke.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FCombatStressReport
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    int32 UnitCount = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    int32 SurvivingUnits = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    int32 TickSamples = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    float MeanTickMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    float P50TickMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    float P90TickMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    float P99TickMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    float MaxTickMs = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    float SpawnSeconds = 0.0f;
+
+    // Przyrost zuzycia pamieci procesu po utworzeniu armii, podzielony przez liczbe jednostek
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    float MeasuredBytesPerUnit = 0.0f;
+
+    // Rozmiar obiektu klasy jednostki (bez komponentow i alokacji)
+    UPROPERTY(BlueprintReadOnly, Category = "Stress Test")
+    int32 ActorObjectBytes = 0;
+
+    FString ToString() const;
+};
+
+/// <summary>
+/// Zbiera czasy kolejnych klatek i liczy percentyle.
+/// </summary>
+struct MAGISTERKABKONKEL_API FCombatStressTickRecorder
+{
+    void Reset(int32 ExpectedSamples = 0);
+    void AddSample(float TickMs);
+    void Summarize(FCombatStressReport& OutReport) const;
+    int32 Num() const { return SamplesMs.Num(); }
+
+private:
+    TArray<float> SamplesMs;
+};
+
+/// <summary>
+/// Rozstawienie armii do testu obciazeniowego. Gracz 0 stoi po stronie ujemnego Y, gracz 1 po
+/// stronie dodatniego Y, obie armie wysrodkowane na X = 0.
+/// </summary>
+struct MAGISTERKABKONKEL_API FCombatStressFormation
+{
+    static void Generate(const FCombatStressConfig& Config, int32 PlayerID, TArray<FVector2D>& OutPositions);
+
+    /// Granice planszy obejmujace obie armie z marginesem
+    static FBox2D ComputeBoardBounds(const TArray<FVector2D>& Player0Positions, const TArray<FVector2D>& Player1Positions, float Margin);
+};
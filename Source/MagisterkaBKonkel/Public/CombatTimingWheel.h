@@ -0,0 +1,61 @@
+// CombatTimingWheel.h - Hierarchical timing wheel for short-lived combat timers
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// Akcje wykonywane po uplywie czasu dla pojedynczej jednostki.
+/// </summary>
+enum class ECombatTimerAction : uint8
+{
+    AttackReset,        // Koniec animacji ataku (0.5 s)
+    HideHealthBar,      // Ukrycie paska zdrowia po trafieniu (3 s)
+    DeathFinished,      // Przejscie Dying -> Dead i zniszczenie aktora (2 s)
+    AttackReady,        // Koniec cooldownu ataku
+    MovementReady,      // Koniec interwalu ruchu
+    TargetSearchReady   // Koniec interwalu wyszukiwania celu
+};
+
+/// <summary>
+/// Kompaktowy wpis timera: indeks slotu jednostki, generacja slotu, akcja i termin w tickach.
+/// </summary>
+struct FCombatTimerEntry
+{
+    int32 UnitSlot = INDEX_NONE;
+    uint16 SlotGeneration = 0;
+    ECombatTimerAction Action = ECombatTimerAction::AttackReset;
+    uint32 DeadlineTick = 0;
+};
+
+/// <summary>
+/// Hierarchiczne kolo czasowe (3 poziomy po 64 sloty). Wstawianie jest O(1), a w kazdym ticku
+/// oprozniany jest tylko jeden kubelek poziomu 0. Wpisy z wyzszych poziomow sa kaskadowo
+/// przenoszone nizej, gdy ich kubelek staje sie aktualny.
+/// </summary>
+class MAGISTERKABKONKEL_API FCombatTimingWheel
+{
+public:
+    static constexpr int32 SlotBits = 6;
+    static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+    static constexpr int32 NumLevels = 3;
+    static constexpr uint32 MaxDelayTicks = (1u << (SlotBits * NumLevels)) - 1;
+
+    FCombatTimingWheel();
+
+    void Reset(uint32 StartTick);
+    void Schedule(const FCombatTimerEntry& Entry);
+    void Advance(uint32 NowTick, TArray<FCombatTimerEntry>& OutDueEntries);
+
+    uint32 GetCurrentTick() const { return CurrentTick; }
+    int32 Num() const { return NumScheduled; }
+
+private:
+    void Insert(const FCombatTimerEntry& Entry);
+    void Cascade(int32 Level, int32 SlotIndex);
+
+    TArray<FCombatTimerEntry> Buckets[NumLevels][SlotsPerLevel];
+    TArray<FCombatTimerEntry> DueNow;
+
+    uint32 CurrentTick;
+    int32 NumScheduled;
+};
@@ -0,0 +1,23 @@
+// CreateUnitArchetypesCommandlet.h - Komenda przenoszaca statystyki z Blueprintow jednostek do zasobow DA_*
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CreateUnitArchetypesCommandlet.generated.h"
+
+/// <summary>
+/// Jednorazowe utworzenie archetypow typow jednostek z wartosci zapisanych w ich Blueprintach:
+/// UnrealEditor-Cmd MagisterkaBKonkel.uproject -run=CreateUnitArchetypes
+/// Dla kazdego BP_* bez archetypu tworzy Units/Archetypes/DA_*, przypisuje go w Blueprincie
+/// i zapisuje oba pakiety. Blueprinty z przypisanym archetypem sa pomijane.
+/// </summary>
+UCLASS()
+class MAGISTERKABKONKEL_API UCreateUnitArchetypesCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UCreateUnitArchetypesCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
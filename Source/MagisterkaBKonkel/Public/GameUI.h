@@ -13,6 +13,8 @@
 #include "Engine/Texture2D.h"
 #include "GameUI.generated.h"
 
+class UUnitArchetype;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitPurchased, int32, UnitType, int32, PlayerID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnPhaseCompleted);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUnitPurchaseRequested, int32, UnitType);
@@ -41,6 +43,9 @@ struct FUnitShopData
         UnitCost = 10;
         UnitType = 0;
     }
+
+    // Dane sklepu z archetypu typu (bez archetypu: domyslna nazwa i koszt)
+    static FUnitShopData FromArchetype(int32 InUnitType, const UUnitArchetype* Archetype);
 };
 
 UCLASS()
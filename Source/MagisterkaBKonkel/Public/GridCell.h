@@ -0,0 +1,80 @@
+// GridCell.h - Calkowitoliczbowa komorka planszy z 32-bitowym kluczem i zwarta serializacja sieciowa
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridCell.generated.h"
+
+/// <summary>
+/// Calkowitoliczbowe wspolrzedne komorki planszy. Klucz 32-bitowy (X w mlodszych, Y w starszych
+/// 16 bitach) sluzy jako hash w TMap/TSet, a w sieci kazda wspolrzedna jest wysylana jako liczba
+/// o zmiennej dlugosci - komorka planszy do 64x64 zajmuje 2 bajty zamiast 16 bajtow FVector2D.
+/// Wspolrzedne musza miescic sie w int16 (plansze do 32767 komorek na bok).
+/// </summary>
+USTRUCT(BlueprintType)
+struct MAGISTERKABKONKEL_API FGridCell
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
+    int32 X = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid")
+    int32 Y = 0;
+
+    FGridCell() = default;
+    FGridCell(int32 InX, int32 InY) : X(InX), Y(InY) {}
+    explicit FGridCell(const FIntPoint& Point) : X(Point.X), Y(Point.Y) {}
+
+    /// Zaokraglenie pozycji siatki w FVector2D (Blueprinty, AGridManager::GetGridPositionFromWorld)
+    static FGridCell FromGridPosition(const FVector2D& GridPosition)
+    {
+        return FGridCell(FMath::RoundToInt(GridPosition.X), FMath::RoundToInt(GridPosition.Y));
+    }
+
+    FVector2D ToGridPosition() const { return FVector2D(X, Y); }
+    FIntPoint ToIntPoint() const { return FIntPoint(X, Y); }
+
+    uint32 GetKey() const
+    {
+        return static_cast<uint32>(static_cast<uint16>(X)) | (static_cast<uint32>(static_cast<uint16>(Y)) << 16);
+    }
+
+    static FGridCell FromKey(uint32 Key)
+    {
+        return FGridCell(static_cast<int16>(Key & 0xFFFF), static_cast<int16>(Key >> 16));
+    }
+
+    /// Indeks w plaskiej tablicy planszy o szerokosci Width
+    int32 ToIndex(int32 Width) const { return Y * Width + X; }
+    static FGridCell FromIndex(int32 Index, int32 Width) { return FGridCell(Index % Width, Index / Width); }
+
+    bool IsInside(int32 Width, int32 Height) const { return X >= 0 && X < Width && Y >= 0 && Y < Height; }
+
+    bool operator==(const FGridCell& Other) const { return X == Other.X && Y == Other.Y; }
+    bool operator!=(const FGridCell& Other) const { return !(*this == Other); }
+    FGridCell operator+(const FGridCell& Other) const { return FGridCell(X + Other.X, Y + Other.Y); }
+    FGridCell operator-(const FGridCell& Other) const { return FGridCell(X - Other.X, Y - Other.Y); }
+    FGridCell operator*(int32 Scale) const { return FGridCell(X * Scale, Y * Scale); }
+    FGridCell& operator+=(const FGridCell& Other) { X += Other.X; Y += Other.Y; return *this; }
+
+    FGridCell ComponentMin(const FGridCell& Other) const { return FGridCell(FMath::Min(X, Other.X), FMath::Min(Y, Other.Y)); }
+    FGridCell ComponentMax(const FGridCell& Other) const { return FGridCell(FMath::Max(X, Other.X), FMath::Max(Y, Other.Y)); }
+
+    friend uint32 GetTypeHash(const FGridCell& Cell) { return Cell.GetKey(); }
+
+    FString ToString() const { return FString::Printf(TEXT("(%d, %d)"), X, Y); }
+
+    /// Kazda wspolrzedna jako zig-zag + SerializeIntPacked (1 bajt dla -64..63)
+    bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FGridCell> : public TStructOpsTypeTraitsBase2<FGridCell>
+{
+    enum
+    {
+        WithNetSerializer = true,
+        WithNetSharedSerialization = true,
+        WithIdenticalViaEquality = true,
+    };
+};
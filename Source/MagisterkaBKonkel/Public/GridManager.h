@@ -5,6 +5,9 @@
 #include "Components/StaticMeshComponent.h"
 #include "Components/BoxComponent.h" 
 #include "Materials/MaterialInterface.h"
+#include "Engine/StaticMesh.h"
+#include "GridNavigationLayer.h"
+#include "GridCell.h"
 #include "GridManager.generated.h"
 
 UCLASS(BlueprintType, Blueprintable)
@@ -69,12 +72,32 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Zones", meta = (ClampMin = "1"))
     int32 Player2SpawnSize = 3;
 
+    // Listy komorek stref spawnu dla Blueprintow - przynaleznosc do strefy trzymaja flagi warstwy nawigacji,
+    // a listy rosna z szerokoscia planszy, wiec sa domyslnie wylaczone (zamiast nich IsPositionInPlayer1SpawnZone
+    // i GetValidSpawnPositions)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Zones")
+    bool bKeepSpawnZoneLists = false;
+
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn Zones")
     TArray<FVector2D> Player1SpawnZone;
 
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Spawn Zones")
     TArray<FVector2D> Player2SpawnZone;
 
+    // Siatka rysowana fragmentami (FGridNavigationLayer::ChunkSize komorek na bok) tylko wokol kamery
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Chunks")
+    UStaticMesh* ChunkVisualMesh;
+
+    // Bok siatki ChunkVisualMesh w jednostkach swiata (plaszczyzna silnika ma 100)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Chunks", meta = (ClampMin = "1.0"))
+    float ChunkVisualMeshSize = 100.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Chunks", meta = (ClampMin = "0.0"))
+    float ChunkVisibleRadius = 5000.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grid Chunks", meta = (ClampMin = "0.05"))
+    float ChunkUpdateInterval = 0.5f;
+
     UFUNCTION(BlueprintCallable, Category = "Grid")
     FVector GetWorldLocationFromGrid(FVector2D GridPosition) const;
 
@@ -117,6 +140,15 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Grid Visual")
     void AddGridLineComponent(UStaticMeshComponent* Component);
 
+    UFUNCTION(BlueprintCallable, Category = "Grid Chunks")
+    void UpdateChunks();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Grid Chunks")
+    int32 GetChunkVisualCount() const { return ChunkVisuals.Num(); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Grid Chunks")
+    int32 GetNavigationChunkCount() const { return NavigationLayer.GetChunkCount(); }
+
     UFUNCTION(BlueprintCallable, Category = "Map Boundaries")
     void CreateMapBoundaries();
 
@@ -126,7 +158,47 @@ public:
     UFUNCTION(BlueprintCallable, CallInEditor, Category = "Map Boundaries")
     void RegenerateMapBoundaries();
 
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+    void InitializeNavigationLayer();
+
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+    void SetCellBlocked(FVector2D GridPosition, bool bBlocked);
+
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+    void SetCellPlacementAllowed(FVector2D GridPosition, bool bAllowed);
+
+    UFUNCTION(BlueprintCallable, Category = "Navigation")
+    void SetCellMovementCost(FVector2D GridPosition, int32 Cost);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation")
+    bool IsCellWalkable(FVector2D GridPosition) const;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation")
+    bool IsCellPlaceable(FVector2D GridPosition) const;
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Navigation")
+    int32 GetCellClearance(FVector2D GridPosition) const;
+
+    // Odpowiedniki powyzszych funkcji na komorkach FGridCell (FVector2D zostaje dla Blueprintow)
+    FVector GetWorldLocationFromCell(const FGridCell& Cell) const;
+    FGridCell GetCellFromWorld(const FVector& WorldLocation) const;
+    bool IsValidCell(const FGridCell& Cell) const { return Cell.IsInside(GridWidth, GridHeight); }
+    bool IsCellInSpawnZone(const FGridCell& Cell, int32 PlayerID) const;
+    bool IsSpawnCellAvailable(const FGridCell& Cell, int32 PlayerID) const;
+    TArray<FGridCell> GetValidSpawnCells(int32 PlayerID) const;
+
+    void SetCellsBlocked(const TArray<FGridCell>& Cells, bool bBlocked);
+    bool IsWorldLocationWalkable(const FVector& WorldLocation) const;
+    const FGridNavigationLayer& GetNavigationLayer() const { return NavigationLayer; }
+    const FVector& GetGridOrigin() const { return GridOrigin; }
+
+    // Zmiana wymiarow i polozenia planszy w trakcie gry (test obciazeniowy) - warstwa nawigacji, strefy spawnu,
+    // kolizja, granice mapy i wizualizacje sa budowane od nowa
+    void ResizeGrid(int32 NewWidth, int32 NewHeight, const FVector& NewOrigin);
+    void RestoreNavigationLayer(const FGridNavigationLayer& SavedLayer);
+
 protected:
+    // Kolizja podlogi tylko pod fragmentami siatki wokol kamery lokalnego gracza (przesuwana w UpdateChunks)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Grid Collision")
     class UBoxComponent* GridCollisionBox;
 
@@ -136,19 +208,46 @@ protected:
     UPROPERTY()
     TArray<UStaticMeshComponent*> GridLineComponents;
 
+    // Wizualizacje fragmentow siatki w poblizu kamery (klucz - wspolrzedne fragmentu)
+    UPROPERTY(Transient)
+    TMap<FGridCell, UStaticMeshComponent*> ChunkVisuals;
+
     void CreateGridLines();
     void CreateGridCell(int32 X, int32 Y);
     UStaticMeshComponent* CreateLineComponent(FVector Start, FVector End);
 
     void SetupCollisionBox();
+    void UpdateCollisionBox(const FGridCell& MinChunk, const FGridCell& MaxChunk);
+    bool GetCameraChunkRange(FGridCell& OutMinChunk, FGridCell& OutMaxChunk) const;
 
     void CreateBoundaryWall(FVector Location, FVector Extent, FString Name);
 
+    UStaticMeshComponent* CreateChunkVisual(const FGridCell& ChunkCoord);
+    void ClearChunkVisuals();
+
 #if WITH_EDITOR
     virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 
 private:
+    static FGridCell ToCell(FVector2D GridPosition);
+    static ENavCellFlags GetSpawnZoneFlag(int32 PlayerID);
+
     FVector GridOrigin = FVector::ZeroVector;
     bool bGridGenerated = false;
+
+    // Stan z ShowGrid/HideGrid - nowe fragmenty siatki go przejmuja
+    bool bGridVisible = true;
+
+    // Flagi nawigacji (z flagami stref spawnu), koszty ruchu i przeswit komorek planszy
+    FGridNavigationLayer NavigationLayer;
+
+    // Rzedy stref spawnu - X: pierwszy rzad, Y: rzad za ostatnim
+    FIntPoint Player1SpawnRows = FIntPoint::ZeroValue;
+    FIntPoint Player2SpawnRows = FIntPoint::ZeroValue;
+
+    FTimerHandle ChunkUpdateTimerHandle;
+
+    // Zakres fragmentow (wlacznie z Max) pod collision boxem - box jest przestawiany tylko po zmianie zakresu
+    FIntRect CollisionBoxChunks = FIntRect(INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE);
 };
\ No newline at end of file
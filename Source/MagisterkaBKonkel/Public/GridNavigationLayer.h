@@ -0,0 +1,140 @@
+// GridNavigationLayer.h - Chunked per-cell navigability bitmask, movement cost layer and clearance map
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GridCell.h"
+
+/// <summary>
+/// Flagi nawigacji komorki siatki (bitmaska uint8)
+/// </summary>
+enum class ENavCellFlags : uint8
+{
+    None = 0,
+    Blocked = 1 << 0,           // Komorka nieprzechodnia (przeszkoda)
+    NoPlacement = 1 << 1,       // Przechodnia, ale nie mozna w niej stawiac jednostek
+    SpawnZonePlayer1 = 1 << 2,  // Strefa spawnu gracza 1
+    SpawnZonePlayer2 = 1 << 3,  // Strefa spawnu gracza 2
+};
+ENUM_CLASS_FLAGS(ENavCellFlags);
+
+/// <summary>
+/// Dane jednego fragmentu planszy (ChunkSize x ChunkSize komorek) w ciaglych tablicach
+/// indeksowanych LocalY * ChunkSize + LocalX. Komorki poza plansza (ostatni, niepelny fragment)
+/// maja wartosci domyslne i nie sa czytane.
+/// </summary>
+struct FGridNavigationChunk
+{
+    TArray<uint8> CellFlags;
+    TArray<uint8> MoveCosts;
+    TArray<uint8> Clearance;
+};
+
+/// <summary>
+/// Warstwa nawigacji planszy AGridManager. Dla kazdej komorki trzyma flagi nawigacji (w tym strefy
+/// spawnu), koszt ruchu i przeswit - odleglosc (Chebyshev, w komorkach) do najblizszej przeszkody
+/// lub krawedzi planszy. Dane sa podzielone na fragmenty tworzone przy pierwszym zapisie - fragment,
+/// ktorego nie ma, ma wszystkie komorki domyslne (przechodnie, koszt 1, przeswit liczony od krawedzi),
+/// wiec pamiec rosnie z liczba uzywanych fragmentow, a nie z rozmiarem planszy.
+/// Zmiany komorek oznaczaja prostokat do przeliczenia, a UpdateClearance przelicza przeswit tylko
+/// w nim (z marginesem MaxClearance). Kazdy fragment pamieta rewizje swojej ostatniej zmiany
+/// (takze po zwolnieniu), wiec odbiorcy kopiuja tylko fragmenty zmienione od ich kopii.
+/// </summary>
+class MAGISTERKABKONKEL_API FGridNavigationLayer
+{
+public:
+    /// Bok fragmentu w komorkach (potega dwojki - wspolrzedne fragmentu to przesuniecie bitowe)
+    static constexpr int32 ChunkShift = 5;
+    static constexpr int32 ChunkSize = 1 << ChunkShift;
+
+    /// Przeswit jest przycinany do tej wartosci - zmiana komorki wplywa tylko na komorki w tym promieniu
+    static constexpr uint8 MaxClearance = 16;
+    static constexpr uint8 DefaultMoveCost = 1;
+
+    void Initialize(int32 InWidth, int32 InHeight);
+    void Reset();
+
+    /// Przejecie komorek zapamietanej kopii warstwy - rewizje rosna dalej, jak po Initialize
+    void RestoreFrom(const FGridNavigationLayer& Saved);
+    bool IsInitialized() const { return Width > 0 && Height > 0; }
+
+    bool IsValidCell(const FGridCell& Cell) const { return Cell.IsInside(Width, Height); }
+
+    /// Zmiany komorek - przeswit jest aktualny dopiero po UpdateClearance
+    void SetCellFlags(const FGridCell& Cell, ENavCellFlags Flags);
+    void SetCellBlocked(const FGridCell& Cell, bool bBlocked);
+    void SetCellMoveCost(const FGridCell& Cell, uint8 Cost);
+
+    /// Usuwa podane flagi ze wszystkich utworzonych fragmentow (np. przed przebudowa stref spawnu)
+    void ClearFlags(ENavCellFlags Flags);
+
+    /// Przelicza przeswit w prostokacie zmienionych komorek. Zwraca true, jesli cos przeliczono.
+    bool UpdateClearance();
+
+    ENavCellFlags GetCellFlags(const FGridCell& Cell) const;
+    bool IsCellBlocked(const FGridCell& Cell) const;
+    bool IsCellPlaceable(const FGridCell& Cell) const;
+    uint8 GetMoveCost(const FGridCell& Cell) const;
+    uint8 GetClearance(const FGridCell& Cell) const;
+
+    /// Czy w komorce zmiesci sie jednostka o promieniu RadiusCells komorek (0 - jedna komorka)
+    bool HasClearance(const FGridCell& Cell, int32 RadiusCells) const;
+
+    /// Plaskie tablice prostokata planszy (Max poza prostokatem, indeks = (Y - Min.Y) * Szerokosc + X - Min.X)
+    /// dla pol przeplywu i serwisu sciezek - wypelniane wartosciami domyslnymi i nadpisywane tylko
+    /// z utworzonych fragmentow, ktore przecinaja prostokat
+    void GetBlockedCells(const FIntRect& Region, TArray<bool>& OutBlocked) const;
+    void GetMoveCosts(const FIntRect& Region, TArray<uint8>& OutCosts) const;
+
+    /// Fragmenty
+    static FGridCell GetChunkCoord(const FGridCell& Cell);
+    const FGridNavigationChunk* FindChunk(const FGridCell& ChunkCoord) const { return Chunks.Find(ChunkCoord); }
+    bool HasChunk(const FGridCell& ChunkCoord) const { return Chunks.Contains(ChunkCoord); }
+    int32 GetChunkCount() const { return Chunks.Num(); }
+    FGridCell GetChunkGridSize() const;
+
+    /// Zwalnia fragmenty, w ktorych wszystkie komorki maja wartosci domyslne. Zwraca liczbe zwolnionych.
+    int32 ReleaseUnusedChunks();
+
+    /// Fragmenty, w ktorych flagi lub koszty zmienily sie po rewizji SinceRevision (takze juz zwolnione)
+    void GetChangedChunks(uint32 SinceRevision, TArray<FGridCell>& OutChunkCoords) const;
+
+    /// Rosnie przy kazdej zmianie flag lub kosztow - odbiorcy kopiuja dane tylko po zmianie
+    uint32 GetRevision() const { return Revision; }
+
+    /// Rewizja ostatniego Initialize - kopia sprzed niej musi byc zbudowana od nowa
+    uint32 GetLayoutRevision() const { return LayoutRevision; }
+    int32 GetWidth() const { return Width; }
+    int32 GetHeight() const { return Height; }
+
+private:
+    static int32 GetLocalIndex(const FGridCell& Cell)
+    {
+        return FGridCell(Cell.X & (ChunkSize - 1), Cell.Y & (ChunkSize - 1)).ToIndex(ChunkSize);
+    }
+
+    FGridNavigationChunk& FindOrAddChunk(const FGridCell& ChunkCoord);
+    bool IsChunkUnused(const FGridCell& ChunkCoord, const FGridNavigationChunk& Chunk) const;
+
+    /// Przeswit komorki bez przeszkod w poblizu - odleglosc do krawedzi planszy
+    uint8 GetEdgeClearance(int32 X, int32 Y) const;
+
+    void MarkDirty(const FGridCell& Cell);
+    void MarkChunkChanged(const FGridCell& ChunkCoord);
+    void RebuildClearance(const FIntRect& Region);
+    uint8 ReadClearance(int32 X, int32 Y) const;
+    void WriteClearance(int32 X, int32 Y, uint8 Value);
+
+    int32 Width = 0;
+    int32 Height = 0;
+
+    TMap<FGridCell, FGridNavigationChunk> Chunks;
+
+    // Rewizja ostatniej zmiany flag lub kosztow kazdego fragmentu - wpis zostaje po zwolnieniu fragmentu
+    TMap<FGridCell, uint32> ChunkRevisions;
+
+    // Prostokat zmienionych komorek (wlacznie z Max) od ostatniego UpdateClearance
+    FIntRect DirtyRegion;
+    bool bHasDirtyRegion = false;
+    uint32 Revision = 0;
+    uint32 LayoutRevision = 0;
+};
@@ -0,0 +1,143 @@
+// GridPathfinder.h - Asynchronous Jump Point Search on the battle grid with request coalescing and a path cache
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "GridCell.h"
+
+/// <summary>
+/// Wynik zapytania o sciezke. Path zawiera kolejne komorki od startu do celu (wlacznie z oboma).
+/// </summary>
+struct FGridPathResult
+{
+    int32 RequestID = INDEX_NONE;
+    bool bFound = false;
+    bool bFromCache = false;
+    TArray<FGridCell> Path;
+};
+
+/// <summary>
+/// Liczniki serwisu sciezek od ostatniego Initialize.
+/// </summary>
+struct FGridPathStats
+{
+    int32 Requests = 0;
+    int32 CacheHits = 0;
+    int32 Searches = 0;             // Wyszukiwania JPS (jedno na cel w partii)
+    int32 CoalescedRequests = 0;    // Zapytania obsluzone przez wyszukiwanie innego zapytania
+};
+
+/// <summary>
+/// A* z Jump Point Search na siatce 8-sasiedztwa bez scinania rogow (koszty 10/14, jak w FBattleFlowField).
+/// Wyszukiwanie idzie wstecz od celu i konczy sie po osiagnieciu wszystkich startow, wiec wiele
+/// jednostek idacych do tej samej komorki dzieli jedno wyszukiwanie.
+/// </summary>
+class MAGISTERKABKONKEL_API FGridPathfinder
+{
+public:
+    static constexpr int32 OrthogonalCost = 10;
+    static constexpr int32 DiagonalCost = 14;
+
+    /// Komorki celu i startow sa traktowane jako przechodnie (zajmuja je sama jednostka i jej cel).
+    /// OutPaths[i] to sciezka Starts[i] -> Goal lub pusta tablica, gdy droga nie istnieje.
+    static void FindPaths(int32 Width, int32 Height, const TArray<bool>& BlockedCells,
+        const FGridCell& Goal, const TArray<FGridCell>& Starts, TArray<TArray<FGridCell>>& OutPaths);
+
+    static int32 OctileDistance(const FGridCell& A, const FGridCell& B);
+};
+
+/// <summary>
+/// Kolejka zapytan o sciezki liczonych na watkach roboczych. Zapytania zebrane w ticku N sa
+/// grupowane po komorce celu i liczone w tle na migawce zajetosci, a wyniki trafiaja do wywolujacego
+/// w ticku N+1. Sciezki sa zapamietywane po (start, cel, epoka zajetosci) - epoka rosnie przy kazdej
+/// zmianie zajetosci komorek, wiec nieaktualne wpisy nigdy nie sa zwracane.
+/// </summary>
+class MAGISTERKABKONKEL_API FGridPathService
+{
+public:
+    static constexpr int32 MaxCachedPaths = 4096;
+
+    ~FGridPathService();
+
+    void Initialize(int32 InWidth, int32 InHeight);
+    void Reset();
+    bool IsInitialized() const { return Width > 0 && Height > 0; }
+
+    /// Nowa zajetosc komorek (Width * Height). Epoka rosnie tylko gdy zajetosc sie zmienila.
+    void SetBlockedCells(const TArray<bool>& NewBlockedCells);
+    void SetCellBlocked(int32 X, int32 Y, bool bBlocked);
+    bool IsCellBlocked(const FGridCell& Cell) const;
+    uint32 GetOccupancyEpoch() const { return OccupancyEpoch; }
+
+    /// Dodaje zapytanie do kolejki. Zwraca ID wyniku albo INDEX_NONE dla komorek poza siatka.
+    int32 RequestPath(const FGridCell& Start, const FGridCell& Goal);
+
+    /// Odbiera wyniki partii z poprzedniego ticku i uruchamia partie z zapytan zebranych od tamtej pory
+    void Tick(TArray<FGridPathResult>& OutResults);
+
+    int32 GetQueuedRequestCount() const { return QueuedRequests.Num(); }
+    bool IsSearchInFlight() const { return InFlightBatch.IsValid(); }
+    const FGridPathStats& GetStats() const { return Stats; }
+
+private:
+    struct FQueuedRequest
+    {
+        int32 RequestID;
+        FGridCell Start;
+        FGridCell Goal;
+    };
+
+    struct FPathCacheKey
+    {
+        FGridCell Start;
+        FGridCell Goal;
+        uint32 Epoch;
+
+        bool operator==(const FPathCacheKey& Other) const
+        {
+            return Start == Other.Start && Goal == Other.Goal && Epoch == Other.Epoch;
+        }
+
+        friend uint32 GetTypeHash(const FPathCacheKey& Key)
+        {
+            return HashCombine(HashCombine(GetTypeHash(Key.Start), GetTypeHash(Key.Goal)), GetTypeHash(Key.Epoch));
+        }
+    };
+
+    struct FSearchGroup
+    {
+        FGridCell Goal;
+        TArray<FGridCell> Starts;
+        TArray<TArray<FGridCell>> Paths;
+    };
+
+    struct FSearchBatch
+    {
+        uint32 Epoch = 0;
+        TArray<FQueuedRequest> Requests;
+        TArray<FIntPoint> RequestSlots;     // Dla kazdego zapytania: (indeks grupy, indeks startu w grupie)
+        TArray<FSearchGroup> Groups;
+    };
+
+    bool IsValidCell(const FGridCell& Cell) const;
+    void LaunchBatch();
+    void CompleteBatch(TArray<FGridPathResult>& OutResults);
+    void AddToCache(const FPathCacheKey& Key, const TArray<FGridCell>& Path);
+
+    int32 Width = 0;
+    int32 Height = 0;
+
+    // Migawka zajetosci wspoldzielona z wyszukiwaniem w tle - zmiana tworzy nowa tablice
+    TSharedPtr<TArray<bool>, ESPMode::ThreadSafe> BlockedCells;
+    uint32 OccupancyEpoch = 0;
+
+    TArray<FQueuedRequest> QueuedRequests;
+    TArray<FGridPathResult> CachedResults;
+    TMap<FPathCacheKey, TArray<FGridCell>> PathCache;
+
+    TSharedPtr<FSearchBatch, ESPMode::ThreadSafe> InFlightBatch;
+    TFuture<void> InFlightSearch;
+
+    int32 NextRequestID = 0;
+    FGridPathStats Stats;
+};
@@ -0,0 +1,69 @@
+// LocalAvoidance.h - Reciprocal velocity obstacle (ORCA) avoidance between allied units on a frozen snapshot
+#pragma once
+
+#include "CoreMinimal.h"
+
+/// <summary>
+/// Zamrozony stan jednostek dla unikania kolizji, zapisany kolumnami (jedna tablica na pole),
+/// aby petle po sasiadach czytaly ciagla pamiec. Predkosci sa wyrazone w jednostkach swiata na krok ruchu.
+/// Listy mega-komorek maja ten sam uklad co FTargetAcquisitionSnapshot.
+/// </summary>
+struct MAGISTERKABKONKEL_API FAvoidanceSnapshot
+{
+    FVector2D WorldMin = FVector2D::ZeroVector;
+    float MegaCellSize = 0.0f;
+    int32 MegaGridWidth = 0;
+    int32 MegaGridHeight = 0;
+
+    TArray<float> PositionX;
+    TArray<float> PositionY;
+    TArray<float> VelocityX;            // Predkosc z ostatniego rozwiazania
+    TArray<float> VelocityY;
+    TArray<float> PreferredX;           // Predkosc pozadana w tym ticku (zero dla stojacych)
+    TArray<float> PreferredY;
+    TArray<float> MaxSpeed;
+    TArray<int32> TeamID;
+    TArray<int32> MegaCellIndex;
+
+    // Zakresy [CellStart[i], CellStart[i + 1]) w CellEntries dla kazdej mega-komorki
+    TArray<int32> CellStart;
+    TArray<int32> CellEntries;
+
+    int32 Num() const { return PositionX.Num(); }
+    void Reset();
+    int32 AddEntry(const FVector2D& Position, const FVector2D& Velocity, const FVector2D& Preferred, float InMaxSpeed, int32 InTeamID);
+    void BuildCellLists();
+    int32 ComputeMegaCellIndex(float X, float Y) const;
+    bool IsMoving(int32 EntryIndex) const { return PreferredX[EntryIndex] != 0.0f || PreferredY[EntryIndex] != 0.0f; }
+};
+
+/// <summary>
+/// Parametry rozwiazania ORCA wspolne dla wszystkich jednostek.
+/// </summary>
+struct FAvoidanceParams
+{
+    float AgentRadius = 40.0f;
+    float NeighborDistance = 300.0f;
+    int32 MaxNeighbors = 8;             // Obcinane do FLocalAvoidance::MaxNeighbors
+    float TimeHorizon = 4.0f;           // W krokach ruchu
+};
+
+/// <summary>
+/// Optimal Reciprocal Collision Avoidance. Kazdy z co najwyzej MaxNeighbors najblizszych sojusznikow
+/// daje jedna polplaszczyzne dozwolonych predkosci, a predkosc najblizsza pozadanej wybiera
+/// dwuwymiarowy program liniowy (z rozluznieniem, gdy ograniczenia sa sprzeczne). Koszt O(k) na jednostke,
+/// bez alokacji. Wrogowie nie sa przeszkoda - kontakt z wrogiem jest celem ruchu. Sasiad, ktory stoi,
+/// nie ustepuje, wiec idaca jednostka bierze na siebie cale ominiecie zamiast polowy.
+/// </summary>
+class MAGISTERKABKONKEL_API FLocalAvoidance
+{
+public:
+    static constexpr int32 MaxNeighbors = 16;
+
+    /// Predkosc dla jednego wpisu migawki; tylko odczyt - bezpieczne z wielu watkow
+    static FVector2D SolveAgent(const FAvoidanceSnapshot& Snapshot, const FAvoidanceParams& Params, int32 AgentIndex);
+
+    /// Predkosci wszystkich idacych wpisow (stojace dostaja zero)
+    static void ComputeVelocities(const FAvoidanceSnapshot& Snapshot, const FAvoidanceParams& Params,
+        TArray<FVector2D>& OutVelocities, bool bParallel = true);
+};
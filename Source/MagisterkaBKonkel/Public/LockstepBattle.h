@@ -0,0 +1,76 @@
+// LockstepBattle.h - Lockstep battle session: one start packet, periodic hash checks, snapshot resync
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BattleReplay.h"
+
+/// <summary>
+/// Skrot stanu bitwy po danym ticku.
+/// </summary>
+struct FLockstepHash
+{
+    int32 Tick = 0;
+    uint32 Hash = 0;
+};
+
+/// <summary>
+/// Bitwa symulowana lokalnie na serwerze i kazdym kliencie. Serwer wysyla jeden pakiet startowy
+/// (rozstawienie, statystyki, wersja symulacji, ziarno), potem tylko skroty stanu co HashIntervalTicks
+/// i wynik koncowy. Klient porownuje skroty ze swoimi; po rozbieznosci prosi o pelna migawke stanu.
+/// Symulacja zawsze dziala w trybie EBattleSimMath::FixedPoint, wiec skroty nie zaleza od buildu.
+/// </summary>
+class MAGISTERKABKONKEL_API FLockstepBattleSession
+{
+public:
+    static constexpr int32 DefaultHashIntervalTicks = 10;
+
+    // Ile ostatnich wlasnych skrotow klient trzyma do porownania z opoznionymi skrotami serwera
+    static constexpr int32 MaxRetainedHashes = 64;
+
+    /// Serwer: start bitwy i pakiet startowy dla klientow
+    bool StartAuthority(const FBattleSimSetup& InSetup, uint32 Seed, int32 InHashIntervalTicks, TArray<uint8>& OutStartPacket);
+
+    /// Klient: start bitwy z pakietu startowego serwera
+    bool StartFromPacket(const TArray<uint8>& StartPacket, int32 InHashIntervalTicks);
+
+    void Stop();
+
+    /// Przesuwa symulacje o DeltaSeconds. Serwer dostaje w OutHashes skroty do rozeslania.
+    int32 Advance(float DeltaSeconds, TArray<FLockstepHash>& OutHashes);
+
+    /// Klient: dogania podany tick serwera bez czekania na czas (np. przed porownaniem wyniku koncowego)
+    void CatchUpToTick(int32 Tick);
+
+    /// Klient: skrot serwera dla ticku. Porownanie nastepuje od razu albo gdy klient dojdzie do ticku.
+    void ReceiveAuthorityHash(int32 Tick, uint32 Hash);
+
+    bool SaveSnapshot(TArray<uint8>& OutBytes) const;
+    bool ApplySnapshot(const TArray<uint8>& Bytes);
+
+    bool IsActive() const { return bActive; }
+    bool IsAuthority() const { return bAuthority; }
+    bool NeedsResync() const { return bDesyncDetected; }
+    int32 GetDesyncTick() const { return DesyncTick; }
+    int32 GetResyncCount() const { return ResyncCount; }
+    int32 GetHashIntervalTicks() const { return HashIntervalTicks; }
+    const FBattleSimState& GetState() const { return State; }
+
+private:
+    void RecordLocalHash();
+    void CompareHash(int32 Tick, uint32 LocalHash, uint32 AuthorityHash);
+
+    // Pakiet startowy - Setup musi zyc tak dlugo jak State
+    FBattleReplay Battle;
+    FBattleSimState State;
+
+    bool bActive = false;
+    bool bAuthority = false;
+    bool bDesyncDetected = false;
+    int32 DesyncTick = INDEX_NONE;
+    int32 ResyncCount = 0;
+    int32 HashIntervalTicks = DefaultHashIntervalTicks;
+    float TimeAccumulator = 0.0f;
+
+    TMap<int32, uint32> LocalHashes;
+    TMap<int32, uint32> PendingAuthorityHashes;
+};
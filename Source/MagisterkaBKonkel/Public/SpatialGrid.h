@@ -4,9 +4,12 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "BaseUnit.h" 
+#include "GridCell.h"
 #include "SpatialGrid.generated.h"
 
 class ABaseUnit;
+struct FAvoidanceSnapshot;
+struct FSquadMemberInput;
 
 USTRUCT(BlueprintType)
 struct FSpatialCell
@@ -16,6 +19,10 @@ struct FSpatialCell
     UPROPERTY()
     TArray<ABaseUnit*> Units;
 
+    // Uspione jednostki zainteresowane ta mega-komorka - budzone gdy wejdzie do niej wrog
+    UPROPERTY()
+    TArray<ABaseUnit*> SleepingWatchers;
+
     FVector2D MinBounds;
     FVector2D MaxBounds;
 
@@ -74,6 +81,41 @@ struct FSpatialCell
     }
 };
 
+/// <summary>
+/// Zamrozony stan pojedynczej jednostki uzywany przez rownolegle wyszukiwanie celow.
+/// </summary>
+struct FTargetSnapshotEntry
+{
+    FVector Position = FVector::ZeroVector;
+    float SearchRange = 0.0f;
+    int32 TeamID = -1;
+    int32 MegaCellIndex = INDEX_NONE;
+    bool bIsAlive = false;
+    bool bNeedsTarget = false;
+};
+
+/// <summary>
+/// Migawka siatki przestrzennej tylko do odczytu. Kolejnosc jednostek w kazdej mega-komorce
+/// odpowiada kolejnosci w FSpatialCell::Units, dzieki czemu wynik jest identyczny z FindNearestEnemy.
+/// </summary>
+struct MAGISTERKABKONKEL_API FTargetAcquisitionSnapshot
+{
+    FVector2D WorldMin = FVector2D::ZeroVector;
+    float MegaCellSize = 0.0f;
+    int32 MegaGridWidth = 0;
+    int32 MegaGridHeight = 0;
+
+    TArray<FTargetSnapshotEntry> Entries;
+
+    // Zakresy [CellStart[i], CellStart[i + 1]) w CellEntries dla kazdej mega-komorki
+    TArray<int32> CellStart;
+    TArray<int32> CellEntries;
+
+    void BuildCellLists();
+    int32 ComputeMegaCellIndex(const FVector& Position) const;
+    int32 FindNearestEnemy(int32 SeekerIndex) const;
+};
+
 UCLASS(BlueprintType)
 class MAGISTERKABKONKEL_API USpatialGrid : public UObject
 {
@@ -112,6 +154,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Spatial Grid")
     ABaseUnit* FindNearestEnemy(ABaseUnit* Unit, float MaxRange = 2000.0f) const;
 
+    void BuildTargetSnapshot(const TArray<ABaseUnit*>& Seekers, FTargetAcquisitionSnapshot& OutSnapshot,
+        TArray<ABaseUnit*>& OutUnits, TArray<int32>& OutSeekerIndices) const;
+
+    static void DecideNearestEnemies(const FTargetAcquisitionSnapshot& Snapshot, TArray<int32>& OutProposedTargets, bool bParallel = true);
+
+    void BuildAvoidanceSnapshot(FAvoidanceSnapshot& OutSnapshot, TArray<ABaseUnit*>& OutUnits) const;
+
+    void BuildSquadInputs(TArray<FSquadMemberInput>& OutInputs, TArray<ABaseUnit*>& OutUnits) const;
+
+    bool RegisterSleepInterest(ABaseUnit* Unit, float Range);
+    void ClearSleepInterest(ABaseUnit* Unit);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Spatial Grid")
+    int32 GetSleepingUnitCount() const { return SleepInterestRects.Num(); }
+
     UFUNCTION(BlueprintCallable, Category = "Spatial Grid")
     void HandleCombatInMegaCell(int32 MegaCellX, int32 MegaCellY);
 
@@ -119,13 +176,13 @@ public:
     void HandleAllCombat();
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Spatial Grid")
-    FVector2D GetMegaCellCoordinates(FVector WorldPosition) const;
+    FGridCell GetMegaCellCoordinates(FVector WorldPosition) const;
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Spatial Grid")
-    FVector2D GetBaseGridCoordinates(FVector WorldPosition) const;
+    FGridCell GetBaseGridCoordinates(FVector WorldPosition) const;
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Spatial Grid")
-    FVector2D BaseGridToMegaCell(int32 BaseGridX, int32 BaseGridY) const;
+    FGridCell BaseGridToMegaCell(int32 BaseGridX, int32 BaseGridY) const;
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Spatial Grid")
     bool IsValidMegaCellCoordinate(int32 MegaCellX, int32 MegaCellY) const;
@@ -183,14 +240,14 @@ protected:
     TArray<FSpatialCell> MegaCells;
 
     UPROPERTY()
-    TMap<ABaseUnit*, FVector2D> UnitToMegaCellMap;
+    TMap<ABaseUnit*, FGridCell> UnitToMegaCellMap;
 
 private:
     int32 GetMegaCellIndex(int32 MegaCellX, int32 MegaCellY) const;
     FSpatialCell* GetMegaCell(int32 MegaCellX, int32 MegaCellY);
     const FSpatialCell* GetMegaCell(int32 MegaCellX, int32 MegaCellY) const;
 
-    void GetNeighboringMegaCells(int32 MegaCellX, int32 MegaCellY, TArray<FVector2D>& NeighborCoords) const;
+    void GetNeighboringMegaCells(int32 MegaCellX, int32 MegaCellY, TArray<FGridCell>& NeighborCoords) const;
     bool IsWithinMegaGridBounds(int32 MegaCellX, int32 MegaCellY) const;
 
     void HandleCombatInMegaCellInternal(FSpatialCell* MegaCell);
@@ -198,4 +255,10 @@ private:
 
     void InitializeMegaCells();
     void ClearGrid();
+
+    FIntRect GetMegaCellNeighbourhood(const FVector& Position, float Range) const;
+    void WakeSleepingWatchers(FSpatialCell& MegaCell, const ABaseUnit* EnteringUnit);
+
+    // Prostokat mega-komorek (wlacznie) zarejestrowany przez kazda uspiona jednostke
+    TMap<ABaseUnit*, FIntRect> SleepInterestRects;
 };
\ No newline at end of file
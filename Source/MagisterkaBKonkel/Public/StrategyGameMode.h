@@ -5,6 +5,7 @@
 #include "Engine/Engine.h"
 #include "GameUI.h"
 #include "BaseUnit.h"
+#include "UnitManager.h"
 #include "Net/UnrealNetwork.h"
 #include "StrategyGameMode.generated.h"
 
@@ -98,7 +99,6 @@ public:
     void InitializeResultsPhase();
     void InitializeGameOverPhase();
     void OnPhaseTimerExpired();
-    void CheckForBattleEnd();
     void ProcessBattleResults();
     void SetAllPlayersReady();
     void CheckAllPlayersReady();
@@ -116,14 +116,20 @@ public:
 
     void InitializeUnitManager();
     void BindUnitManagerEvents();
-    void OnUnitSpawned(ABaseUnit* SpawnedUnit, int32 PlayerID, FVector2D GridPosition);
+    void OnUnitSpawned(ABaseUnit* SpawnedUnit, int32 PlayerID, FGridCell GridPosition);
     void ClearAllUnitsFromBattlefield();
-    void OnUnitMoved(ABaseUnit* MovedUnit, FVector2D OldPosition, FVector2D NewPosition, int32 PlayerID);
+    void OnUnitMoved(ABaseUnit* MovedUnit, FGridCell OldPosition, FGridCell NewPosition, int32 PlayerID);
+
+    UFUNCTION()
+    void OnCombatEnded(int32 Player0AliveCount, int32 Player1AliveCount);
+
+    UFUNCTION()
+    void OnUnitBatchSpawned(int32 BatchID, const TArray<FSpawnedUnitData>& SpawnedBatch, const TArray<FUnitSpawnRequest>& FailedRequests);
+    void FlushPurchasedUnitSpawns();
     AUnitManager* GetUnitManager() const { return UnitManagerRef; }
 
     EMatchResult DetermineBattleWinner();
     void ShowMatchResult(EMatchResult Result);
-    int32 CountPlayerUnits(int32 PlayerID) const;
 
     void CreateUIForPlayer(APlayerController* PlayerController, int32 PlayerID);
 
@@ -149,8 +155,8 @@ public:
     void MulticastUpdatePlayerLives_Implementation(int32 PlayerID, int32 NewLives);
 
     UFUNCTION(NetMulticast, Reliable)
-    void MulticastUnitSpawned(int32 UnitType, int32 PlayerID, FVector2D GridPosition);
-    void MulticastUnitSpawned_Implementation(int32 UnitType, int32 PlayerID, FVector2D GridPosition);
+    void MulticastUnitSpawned(int32 UnitType, int32 PlayerID, FGridCell GridPosition);
+    void MulticastUnitSpawned_Implementation(int32 UnitType, int32 PlayerID, FGridCell GridPosition);
 
     UFUNCTION(NetMulticast, Reliable)
     void MulticastPhaseChanged(EGamePhase NewPhase, float PhaseTime);
@@ -176,8 +182,8 @@ public:
     void MulticastPrepareUnitClearing_Implementation();
 
     UFUNCTION(NetMulticast, Reliable)
-    void MulticastClearSpecificUnits(const TArray<FVector2D>& UnitPositions);
-    void MulticastClearSpecificUnits_Implementation(const TArray<FVector2D>& UnitPositions);
+    void MulticastClearSpecificUnits(const TArray<FGridCell>& UnitPositions);
+    void MulticastClearSpecificUnits_Implementation(const TArray<FGridCell>& UnitPositions);
 
     UFUNCTION(NetMulticast, Reliable)
     void MulticastAllUnitsCleared();
@@ -239,7 +245,15 @@ private:
 
     FTimerHandle DelayedStartTimer;
     FTimerHandle PhaseTimer;
-    FTimerHandle BattleEndCheckTimer;
+
+    // Zakupy z biecej klatki zbierane w jedn parti spawnu UnitManagera
+    UPROPERTY()
+    TArray<FUnitSpawnRequest> PendingPurchaseSpawns;
+
+    // Partie spawnu zlecone przez zakupy - tylko ich nieudane dania s zwracane graczom
+    TSet<int32> PurchaseSpawnBatchIDs;
+
+    bool bPurchaseFlushScheduled;
 
     UPROPERTY(EditDefaultsOnly, Category = "UI")
     TSubclassOf<UGameUI> GameUIClass;
@@ -38,7 +38,7 @@ public:
     void OnEscapePressed();
 
     UFUNCTION(BlueprintCallable, Category = "Grid")
-    bool GetGridPositionUnderCursor(FVector2D& OutGridPosition) const;
+    bool GetGridPositionUnderCursor(FGridCell& OutGridPosition) const;
 
     UFUNCTION(BlueprintCallable, Category = "Grid")
     bool GetUnitUnderCursor(ABaseUnit*& OutUnit) const;
@@ -70,11 +70,13 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "UI")
     UGameUI* GetGameUI() const { return GameUIRef; }
 
+    AUnitManager* GetUnitManager() const { return UnitManagerRef; }
+
     UFUNCTION(Client, Reliable)
     void ClientInitializePlayer(int32 AssignedPlayerID, int32 StartingGold);
 
     UFUNCTION(Client, Reliable)
-    void ClientShowUnitSelectionByPosition(FVector2D UnitGridPosition, int32 RequestingPlayerID);
+    void ClientShowUnitSelectionByPosition(FGridCell UnitGridPosition, int32 RequestingPlayerID);
 
     UFUNCTION(Client, Reliable)
     void ClientHideUnitSelection();
@@ -83,7 +85,7 @@ public:
     void OnUnitPurchaseRequested(int32 UnitType);
 
     UFUNCTION(Server, Reliable, WithValidation)
-    void ServerHandleGridClick(FVector2D GridPosition, int32 RequestingPlayerID);
+    void ServerHandleGridClick(FGridCell GridPosition, int32 RequestingPlayerID);
 
     UFUNCTION(Server, Reliable, WithValidation)
     void ServerHandleUnitClick(ABaseUnit* ClickedUnit, int32 RequestingPlayerID);
@@ -94,6 +96,12 @@ public:
     UFUNCTION(Server, Reliable, WithValidation)
     void ServerRequestUnitPurchase(int32 UnitType, int32 RequestingPlayerID);
 
+    UFUNCTION(Server, Reliable)
+    void ServerRequestBattleSnapshot();
+
+    UFUNCTION(Client, Reliable)
+    void ClientReceiveBattleSnapshot(const TArray<uint8>& SnapshotBytes);
+
 
 
 protected:
@@ -137,6 +145,6 @@ private:
     bool bDrawDebugLines;
 
     float LastClickTime;
-    FVector2D LastClickPosition;
+    FGridCell LastClickPosition;
     bool bInitialized;
 };
\ No newline at end of file
@@ -0,0 +1,96 @@
+// UnitArchetype.h - Shared, immutable per-type unit configuration (stats, timings, health bar tuning)
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "BaseUnit.h"
+#include "UnitArchetype.generated.h"
+
+class UTexture2D;
+
+/// <summary>
+/// Konfiguracja typu jednostki wspolna dla wszystkich jej instancji. Jednostka przechowuje tylko
+/// wskaznik do archetypu i swoj zmienny stan; koszt w sklepie i w AStrategyGameMode::GetUnitCost
+/// oraz statystyki symulacji sa czytane z tego samego zasobu. Zasoby typow (Units/Archetypes/DA_*)
+/// sa przypisane w Blueprintach jednostek; jednostka bez zasobu uzywa domyslnego obiektu tej klasy.
+/// </summary>
+UCLASS(BlueprintType)
+class MAGISTERKABKONKEL_API UUnitArchetype : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Identity")
+    EBaseUnitType UnitType = EBaseUnitType::Tank;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Identity")
+    FString DisplayName = TEXT("Unit");
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Identity")
+    UTexture2D* Icon = nullptr;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Identity", meta = (ClampMin = "0"))
+    int32 Cost = 50;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "1"))
+    int32 MaxHealth = 100;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "1"))
+    int32 Attack = 10;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "0"))
+    int32 Defense = 5;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "1"))
+    float Speed = 5.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats", meta = (ClampMin = "1"))
+    float AttackRange = 1.5f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+    float AttackCooldown = 1.5f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+    float SearchRange = 2000.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (ClampMin = "0.1", ClampMax = "2.0"))
+    float MovementInterval = 2.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat", meta = (ClampMin = "0.05", ClampMax = "3.0"))
+    float TargetSearchInterval = 0.125f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Combat")
+    float RotationSpeed = 5.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar", meta = (ClampMin = "10", ClampMax = "200"))
+    float HealthBarHeight = 80.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar")
+    bool bShowHealthBar = true;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar")
+    bool bHealthBarAlwaysVisible = false;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar")
+    bool bHealthBarFaceCamera = true;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar")
+    bool bScaleWithDistance = true;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar", meta = (ClampMin = "0.1", ClampMax = "3.0"))
+    float MinHealthBarScale = 0.5f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar", meta = (ClampMin = "0.1", ClampMax = "5.0"))
+    float MaxHealthBarScale = 2.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar", meta = (ClampMin = "500", ClampMax = "5000"))
+    float MaxHealthBarVisibilityDistance = 2000.0f;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Health Bar")
+    FVector HealthBarOffset = FVector(0, 0, 80);
+
+    /// Domyslny koszt typu, gdy archetyp nie jest przypisany (dawna tabela GetUnitCost)
+    static int32 GetFallbackCost(int32 UnitType);
+
+    virtual FPrimaryAssetId GetPrimaryAssetId() const override;
+};
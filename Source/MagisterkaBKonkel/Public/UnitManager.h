@@ -5,6 +5,15 @@
 #include "GameFramework/Actor.h"
 #include "BaseUnit.h" 
 #include "GridManager.h"
+#include "CombatTimingWheel.h"
+#include "CombatStressTest.h"
+#include "LockstepBattle.h"
+#include "BattleFlowField.h"
+#include "GridPathfinder.h"
+#include "CellReservationTable.h"
+#include "LocalAvoidance.h"
+#include "BatchedUnitMover.h"
+#include "BattleSquads.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInterface.h"
 #include "Engine/StaticMesh.h"
@@ -15,17 +24,58 @@ class ABaseUnit;
 class AGridManager;
 class AStrategyPlayerController;
 class USpatialGrid; 
+struct FBattleSimSetup;
+class UUnitArchetype;
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUnitSpawned, ABaseUnit*, SpawnedUnit, int32, PlayerID, FVector2D, GridPosition);
-DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnUnitMoved, ABaseUnit*, MovedUnit, FVector2D, OldPosition, FVector2D, NewPosition, int32, PlayerID);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUnitSpawned, ABaseUnit*, SpawnedUnit, int32, PlayerID, FGridCell, GridPosition);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnUnitMoved, ABaseUnit*, MovedUnit, FGridCell, OldPosition, FGridCell, NewPosition, int32, PlayerID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnUnitSelected, ABaseUnit*, SelectedUnit, int32, PlayerID);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUnitDeselected, ABaseUnit*, DeselectedUnit);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCombatStarted, int32, PlayerCount, float, CombatUpdateInterval);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCombatStopped);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCombatEnded, int32, Player0AliveCount, int32, Player1AliveCount);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUnitAttacked, ABaseUnit*, Attacker, ABaseUnit*, Target, int32, Damage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnUnitKilled, ABaseUnit*, DeadUnit);
 
+/// <summary>
+/// Pojedyncze trafienie oczekujące na rozstrzygnięcie na końcu ticka. Słabe wskaźniki - jednostka
+/// może zostać zniszczona lub zwrócona do puli przed fazą rozstrzygnięcia.
+/// </summary>
+struct FPendingDamage
+{
+    TWeakObjectPtr<ABaseUnit> Attacker;
+    TWeakObjectPtr<ABaseUnit> Target;
+    int32 RawDamage = 0;
+};
+
+/// <summary>
+/// Wspólna decyzja oddziału - cel wybrany przez lidera, kandydaci z rejonu celu dla pozostałych
+/// członków i kierunek ostatniego kroku lidera, za którym idzie reszta szyku.
+/// </summary>
+struct FBattleSquadPlan
+{
+    int32 SquadID = INDEX_NONE;
+    TWeakObjectPtr<ABaseUnit> Leader;
+    TArray<TWeakObjectPtr<ABaseUnit>> Members;
+    TArray<FVector2D> FormationOffsets;
+
+    TWeakObjectPtr<ABaseUnit> Target;
+    TArray<TWeakObjectPtr<ABaseUnit>> TargetCandidates;
+
+    FVector LeaderDirection = FVector::ZeroVector;
+    uint64 LeaderDirectionFrame = 0;
+};
+
+/// <summary>
+/// Miejsce jednostki w planach oddziałów (indeks planu i indeks członka w planie).
+/// </summary>
+struct FSquadMemberSlot
+{
+    int32 PlanIndex = INDEX_NONE;
+    int32 MemberIndex = INDEX_NONE;
+};
+
 USTRUCT(BlueprintType)
 struct FSpawnedUnitData
 {
@@ -38,7 +88,7 @@ struct FSpawnedUnitData
     int32 PlayerID;
 
     UPROPERTY(BlueprintReadWrite)
-    FVector2D GridPosition;
+    FGridCell GridPosition;
 
     UPROPERTY(BlueprintReadWrite)
     EBaseUnitType UnitType; 
@@ -47,11 +97,106 @@ struct FSpawnedUnitData
     {
         Unit = nullptr;
         PlayerID = -1;
-        GridPosition = FVector2D::ZeroVector;
+        GridPosition = FGridCell(0, 0);
         UnitType = EBaseUnitType::Tank; 
     }
 };
 
+/// <summary>
+/// Pozycja jednostki w partii wysyłanej klientom przez MulticastUnitPositions.
+/// </summary>
+USTRUCT()
+struct FUnitPositionUpdate
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    ABaseUnit* Unit = nullptr;
+
+    UPROPERTY()
+    FVector_NetQuantize Position;
+};
+
+/// <summary>
+/// Pojedyncze żądanie w partii spawnu jednostek.
+/// </summary>
+USTRUCT(BlueprintType)
+struct FUnitSpawnRequest
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 PlayerID;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EBaseUnitType UnitType;
+
+    FUnitSpawnRequest()
+    {
+        PlayerID = 0;
+        UnitType = EBaseUnitType::Tank;
+    }
+
+    FUnitSpawnRequest(int32 InPlayerID, EBaseUnitType InUnitType)
+    {
+        PlayerID = InPlayerID;
+        UnitType = InUnitType;
+    }
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnUnitBatchSpawned, int32, BatchID, const TArray<FSpawnedUnitData>&, SpawnedBatch, const TArray<FUnitSpawnRequest>&, FailedRequests);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnUnitBatchSpawnedNative, int32 /*BatchID*/, const TArray<FSpawnedUnitData>& /*SpawnedBatch*/, const TArray<FUnitSpawnRequest>& /*FailedRequests*/);
+
+/// <summary>
+/// Partia spawnu przetwarzana przez kolejne klatki w ramach budżetu czasu.
+/// </summary>
+struct FPendingSpawnBatch
+{
+    int32 BatchID = INDEX_NONE;
+    TArray<FUnitSpawnRequest> Requests;
+    int32 NextRequest = 0;
+    TArray<FSpawnedUnitData> Spawned;
+    TArray<FUnitSpawnRequest> Failed;
+};
+
+/// <summary>
+/// Nieaktywne jednostki jednego typu czekające w puli na ponowne użycie.
+/// </summary>
+USTRUCT()
+struct FUnitPoolBucket
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TArray<ABaseUnit*> Units;
+};
+
+USTRUCT(BlueprintType)
+struct FTimeSlicedCombatStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 ProcessedUnits;
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 DeferredUnits;
+
+    UPROPERTY(BlueprintReadOnly)
+    float WorstStalenessSeconds;
+
+    UPROPERTY(BlueprintReadOnly)
+    float SliceTimeMs;
+
+    FTimeSlicedCombatStats()
+    {
+        ProcessedUnits = 0;
+        DeferredUnits = 0;
+        WorstStalenessSeconds = 0.0f;
+        SliceTimeMs = 0.0f;
+    }
+};
+
 UCLASS(BlueprintType, Blueprintable)
 class MAGISTERKABKONKEL_API AUnitManager : public AActor
 {
@@ -64,6 +209,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
     virtual void Tick(float DeltaTime) override;
@@ -95,6 +241,9 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void ProcessUnitCombatWithSpatialGrid(ABaseUnit* Unit);
 
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    void AcquireTargetsInParallel(const TArray<ABaseUnit*>& AliveUnits);
+
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void UpdateAllUnitsCombat();
 
@@ -137,9 +286,6 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Data Locality Combat")
     int32 GetActiveCombatUnitsCount() const { return ActiveCombatUnitsCount; }
 
-    UFUNCTION(BlueprintCallable, Category = "Combat")
-    void MonitorCombatEvents();
-
     UFUNCTION(BlueprintCallable, Category = "Combat")
     void HandleUnitDeath(ABaseUnit* DeadUnit);
 
@@ -152,17 +298,122 @@ public:
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Unit Queries")
     int32 GetAliveUnitCount(int32 PlayerID) const;
 
+    bool ScheduleUnitTimer(ABaseUnit* Unit, ECombatTimerAction Action, float Delay);
+    void ReleaseUnitTimerSlot(ABaseUnit* Unit);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Combat Timers")
+    int32 GetScheduledCombatTimerCount() const { return CombatTimingWheel.Num(); }
+
+    void QueueDamage(ABaseUnit* Attacker, ABaseUnit* Target, int32 RawDamage);
+
+    UFUNCTION(BlueprintCallable, Category = "Combat")
+    void ResolvePendingDamage();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Combat")
+    bool IsBatchedDamageEnabled() const { return bUseBatchedDamage && HasAuthority(); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Combat")
+    int32 GetPendingDamageCount() const { return PendingDamage.Num(); }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Time Slicing")
+    bool IsTimeSlicedCombatEnabled() const { return bUseTimeSlicedCombat; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Time Slicing")
+    FTimeSlicedCombatStats GetTimeSlicedCombatStats() const { return TimeSlicedCombatStats; }
+
+    UFUNCTION(BlueprintCallable, Category = "Time Slicing")
+    void SetTimeSlicedCombat(bool bEnabled, float InCombatFrameBudgetMs, float InMinUnitRefreshRate);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Time Slicing")
+    int32 GetTimeSliceCursor() const { return TimeSliceCursor; }
+
+    void ProcessTimeSlicedCombat();
+
+    void BuildBattleSimSetup(FBattleSimSetup& OutSetup) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Replay")
+    bool SaveBattleReplay(const FString& ReplayName, int32 Seed);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Unit Classes")
+    UUnitArchetype* GetUnitArchetype(EBaseUnitType UnitType) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Unit Classes")
+    void SetUnitClassForType(EBaseUnitType UnitType, TSubclassOf<ABaseUnit> UnitClass);
+
+    UFUNCTION(BlueprintCallable, Category = "Batch Spawning")
+    void SetSpawnFrameBudget(float InSpawnFrameBudgetMs, int32 InMaxSpawnsPerFrame);
+
+    UFUNCTION(BlueprintCallable, Category = "Stress Test")
+    bool StartCombatStressTest(const FCombatStressConfig& Config);
+
+    UFUNCTION(BlueprintCallable, Category = "Stress Test")
+    void FinishCombatStressTest();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stress Test")
+    bool IsCombatStressTestActive() const { return bStressTestActive; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Stress Test")
+    FCombatStressReport GetLastStressReport() const { return LastStressReport; }
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Lockstep")
+    bool IsLockstepBattleActive() const { return LockstepSession.IsActive(); }
+
+    void SendLockstepSnapshot(AStrategyPlayerController* Requester);
+    void ApplyLockstepSnapshot(const TArray<uint8>& SnapshotBytes);
+
     UFUNCTION(BlueprintCallable, Category = "Unit Management")
     ABaseUnit* SpawnUnitForPlayer(int32 PlayerID, EBaseUnitType UnitType); 
 
+    UFUNCTION(BlueprintCallable, Category = "Unit Management")
+    int32 QueueUnitSpawnBatch(const TArray<FUnitSpawnRequest>& Requests);
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Unit Management")
+    int32 GetPendingSpawnCount() const;
+
+    UFUNCTION(BlueprintCallable, Category = "Unit Pool")
+    ABaseUnit* AcquireUnit(EBaseUnitType UnitType, const FVector& Location, const FRotator& Rotation);
+
+    UFUNCTION(BlueprintCallable, Category = "Unit Pool")
+    void ReleaseUnit(ABaseUnit* Unit);
+
+    UFUNCTION(BlueprintCallable, Category = "Unit Pool")
+    void PrewarmUnitPool();
+
+    UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Unit Pool")
+    int32 GetPooledUnitCount(EBaseUnitType UnitType) const;
+
+    bool SampleFlowDirection(int32 TeamID, const FVector& WorldLocation, float TargetDistanceSq, FVector& OutDirection) const;
+    const FBattleFlowField* GetTeamFlowField(int32 TeamID) const;
+
+    int32 RequestUnitPath(ABaseUnit* Unit, const FGridCell& StartCell, const FGridCell& GoalCell);
+    bool GetPathCell(const FVector& WorldLocation, FGridCell& OutCell) const;
+    FVector GetPathCellWorldLocation(const FGridCell& Cell) const;
+    bool IsPathCellBlocked(const FGridCell& Cell) const;
+    bool IsWorldPositionNavigable(const FVector& WorldLocation) const;
+    const FGridPathService& GetPathService() const { return PathService; }
+    const FIntRect& GetBattleRegion() const { return BattleRegion; }
+
+    bool IsCellReservationEnabled() const;
+    bool IsLocalAvoidanceEnabled() const;
+    bool IsBatchedMovementEnabled() const;
+    float GetMovementStepTime() const { return MovementStepTime; }
+    void QueueUnitMove(ABaseUnit* Unit, const FVector& NewLocation);
+    float GetAvoidanceBlendWeight() const { return AvoidanceBlendWeight; }
+    bool ClaimMoveCell(ABaseUnit* Unit, const FGridCell& Cell, uint32 Priority, bool bCanEnterOccupied = false);
+
+    bool IsSquadPlanningEnabled() const;
+    bool GetSquadMoveDirection(const ABaseUnit* Unit, const FTargetRangeCache& Range, FVector& OutDirection) const;
+    void ReportSquadLeaderDirection(const ABaseUnit* Unit, const FVector& Direction);
+    int32 GetSquadCount() const { return SquadPlans.Num(); }
+
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Spatial Partitioning")
     USpatialGrid* GetSpatialGrid() const { return SpatialGrid; }
 
     UFUNCTION(BlueprintCallable, Category = "Unit Management")
-    bool MoveUnitToPosition(ABaseUnit* Unit, FVector2D NewGridPosition, int32 PlayerID);
+    bool MoveUnitToPosition(ABaseUnit* Unit, FGridCell NewGridPosition, int32 PlayerID);
 
     UFUNCTION(BlueprintCallable, Category = "Unit Management")
-    bool CanMoveUnitToPosition(ABaseUnit* Unit, FVector2D NewGridPosition, int32 PlayerID) const;
+    bool CanMoveUnitToPosition(ABaseUnit* Unit, FGridCell NewGridPosition, int32 PlayerID) const;
 
     UFUNCTION(BlueprintCallable, Category = "Unit Management")
     void ForceDeselectAllUnits();
@@ -177,7 +428,7 @@ public:
     void FinalizeUnitClearing();
 
     UFUNCTION(BlueprintCallable, Category = "Unit Management")
-    void DestroyUnitsAtPositions(const TArray<FVector2D>& Positions);
+    void DestroyUnitsAtPositions(const TArray<FGridCell>& Positions);
 
     UFUNCTION(BlueprintCallable, Category = "Unit Selection")
     void SelectUnit(ABaseUnit* Unit, int32 PlayerID);
@@ -192,19 +443,19 @@ public:
     int32 GetSelectedUnitPlayerID() const { return SelectedUnitPlayerID; }
 
     UFUNCTION(BlueprintCallable, Category = "Grid Interaction")
-    void HandleGridClick(FVector2D GridPosition, int32 PlayerID);
+    void HandleGridClick(FGridCell GridPosition, int32 PlayerID);
 
     UFUNCTION(BlueprintCallable, Category = "Grid Interaction")
     void HandleUnitClick(ABaseUnit* ClickedUnit, int32 PlayerID);
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Unit Queries")
-    FVector2D FindFirstFreeSpawnPosition(int32 PlayerID) const;
+    FGridCell FindFirstFreeSpawnPosition(int32 PlayerID) const;
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Unit Queries")
-    bool IsPositionOccupied(FVector2D GridPosition) const;
+    bool IsPositionOccupied(FGridCell GridPosition) const;
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Unit Queries")
-    ABaseUnit* GetUnitAtPosition(FVector2D GridPosition) const;
+    ABaseUnit* GetUnitAtPosition(FGridCell GridPosition) const;
 
     UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Unit Queries")
     TArray<ABaseUnit*> GetPlayerUnits(int32 PlayerID) const;
@@ -228,13 +479,16 @@ public:
     void ShowSelectionHighlight(ABaseUnit* Unit);
 
     UFUNCTION(BlueprintCallable, Category = "Visual Feedback")
-    void HighlightGridPosition(FVector2D GridPosition, UMaterialInterface* Material);
+    void HighlightGridPosition(FGridCell GridPosition, UMaterialInterface* Material);
 
     UFUNCTION(NetMulticast, Reliable)
-    void MulticastUnitSpawned(ABaseUnit* SpawnedUnit, int32 PlayerID, FVector2D GridPosition, EBaseUnitType UnitType);
+    void MulticastUnitSpawned(ABaseUnit* SpawnedUnit, int32 PlayerID, FGridCell GridPosition, EBaseUnitType UnitType);
 
     UFUNCTION(NetMulticast, Reliable)
-    void MulticastUnitMoved(ABaseUnit* MovedUnit, FVector2D OldPosition, FVector2D NewPosition, int32 PlayerID);
+    void MulticastUnitBatchSpawned(const TArray<FSpawnedUnitData>& SpawnedBatch);
+
+    UFUNCTION(NetMulticast, Reliable)
+    void MulticastUnitMoved(ABaseUnit* MovedUnit, FGridCell OldPosition, FGridCell NewPosition, int32 PlayerID);
 
     UFUNCTION(NetMulticast, Reliable)
     void MulticastUnitSelected(ABaseUnit* Unit, int32 PlayerID);
@@ -246,7 +500,7 @@ public:
     void MulticastUnitRemoved(ABaseUnit* Unit);
 
     UFUNCTION(NetMulticast, Reliable)
-    void MulticastUnitMovedByPosition(FVector2D OldPosition, FVector2D NewPosition, int32 PlayerID);
+    void MulticastUnitMovedByPosition(FGridCell OldPosition, FGridCell NewPosition, int32 PlayerID);
 
     UFUNCTION(NetMulticast, Reliable)
     void MulticastAllUnitsCleared();
@@ -269,9 +523,27 @@ public:
     UFUNCTION(NetMulticast, Reliable)
     void MulticastCombatUpdate(const TArray<ABaseUnit*>& CombatUnits);
 
+    UFUNCTION(NetMulticast, Reliable)
+    void MulticastLockstepBattleStart(const TArray<uint8>& StartPacket, int32 HashIntervalTicks);
+
+    UFUNCTION(NetMulticast, Unreliable)
+    void MulticastLockstepHash(int32 Tick, uint32 Hash);
+
+    UFUNCTION(NetMulticast, Unreliable)
+    void MulticastUnitPositions(const TArray<FUnitPositionUpdate>& Updates);
+
+    UFUNCTION(NetMulticast, Reliable)
+    void MulticastLockstepBattleFinished(int32 FinalTick, uint32 FinalHash, int32 Player0Survivors, int32 Player1Survivors);
+
     UPROPERTY(BlueprintAssignable, Category = "Unit Events")
     FOnUnitSpawned OnUnitSpawned;
 
+    UPROPERTY(BlueprintAssignable, Category = "Unit Events")
+    FOnUnitBatchSpawned OnUnitBatchSpawned;
+
+    // Odpowiednik OnUnitBatchSpawned dla kodu C++ - lambdy i odbiorcy spoza UObject
+    FOnUnitBatchSpawnedNative OnUnitBatchSpawnedNative;
+
     UPROPERTY(BlueprintAssignable, Category = "Unit Events")
     FOnUnitMoved OnUnitMoved;
 
@@ -287,6 +559,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Combat Events")
     FOnCombatStopped OnCombatStopped;
 
+    UPROPERTY(BlueprintAssignable, Category = "Combat Events")
+    FOnCombatEnded OnCombatEnded;
+
     UPROPERTY(BlueprintAssignable, Category = "Combat Events")
     FOnUnitAttacked OnUnitAttacked;
 
@@ -330,6 +605,9 @@ protected:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spatial Partitioning", meta = (EditCondition = "bUseSpatialPartitioning"))
     FVector2D SpatialGridWorldMax;
 
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spatial Partitioning", meta = (EditCondition = "bUseSpatialPartitioning"))
+    bool bUseParallelTargetAcquisition;
+
     UPROPERTY(BlueprintReadOnly, Category = "Data Locality Combat")
     TArray<ABaseUnit*> CombatUnitsArray;
 
@@ -339,6 +617,120 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "Data Locality Combat")
     int32 ActiveCombatUnitsCount;
 
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Combat Timers", meta = (ClampMin = "0.01", ClampMax = "0.5"))
+    float TimingWheelResolution;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+    bool bUseBatchedDamage;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Slicing")
+    bool bUseTimeSlicedCombat;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Slicing", meta = (EditCondition = "bUseTimeSlicedCombat", ClampMin = "0.1", ClampMax = "16.0"))
+    float CombatFrameBudgetMs;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Time Slicing", meta = (EditCondition = "bUseTimeSlicedCombat", ClampMin = "1.0", ClampMax = "60.0"))
+    float MinUnitRefreshRate;
+
+    // Bitwa symulowana lokalnie u klientów - zamiast RPC na każdy krok tylko pakiet startowy i skróty stanu
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep")
+    bool bUseLockstepBattle;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Lockstep", meta = (EditCondition = "bUseLockstepBattle", ClampMin = "1", ClampMax = "100"))
+    int32 LockstepHashIntervalTicks;
+
+    // Budżet klatki na tworzenie jednostek z partii spawnu (serwer) i ich lokalnych kopii (klienci), 0 = bez limitu czasu
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batch Spawning", meta = (ClampMin = "0.0", ClampMax = "16.0"))
+    float SpawnFrameBudgetMs;
+
+    // Maksymalna liczba jednostek tworzonych w jednej klatce niezależnie od budżetu czasu, 0 = bez limitu
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Batch Spawning", meta = (ClampMin = "0"))
+    int32 MaxSpawnsPerFrame;
+
+    // Ruch w walce według pól przepływu drużyn zamiast sprawdzania kierunków wokół każdej jednostki
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow Fields")
+    bool bUseFlowFields;
+
+    // Odległość od celu, poniżej której jednostka idzie prosto na swój cel zamiast za polem
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flow Fields", meta = (EditCondition = "bUseFlowFields", ClampMin = "0.0"))
+    float FlowFieldDirectApproachDistance;
+
+    // Trasy JPS liczone w tle, gdy prosta droga do celu jest zajęta przez inne jednostki
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pathfinding")
+    bool bUseGridPathfinding;
+
+    // Krok do innej komórki wymaga rezerwacji - konflikty rozstrzyga priorytet, a nie kolejność ticków
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pathfinding")
+    bool bUseCellReservations;
+
+    // Margines obszaru bitwy wokół jednostek (we fragmentach planszy). Pola przepływu, serwis ścieżek
+    // i rezerwacje komórek obejmują tylko ten obszar zamiast całej planszy
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pathfinding", meta = (ClampMin = "1"))
+    int32 BattleRegionMarginChunks;
+
+    // Unikanie kolizji ORCA między sojusznikami w ścisku walki (prędkości w jednostkach świata na krok)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Local Avoidance")
+    bool bUseLocalAvoidance;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Local Avoidance", meta = (EditCondition = "bUseLocalAvoidance", ClampMin = "1.0"))
+    float AvoidanceRadius;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Local Avoidance", meta = (EditCondition = "bUseLocalAvoidance", ClampMin = "0.0"))
+    float AvoidanceNeighborDistance;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Local Avoidance", meta = (EditCondition = "bUseLocalAvoidance", ClampMin = "1", ClampMax = "16"))
+    int32 AvoidanceMaxNeighbors;
+
+    // Horyzont przewidywania kolizji w krokach ruchu
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Local Avoidance", meta = (EditCondition = "bUseLocalAvoidance", ClampMin = "1.0"))
+    float AvoidanceTimeHorizon;
+
+    // Udział prędkości ORCA w kierunku kroku (0 - tylko kierunek pożądany, 1 - tylko ORCA)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Local Avoidance", meta = (EditCondition = "bUseLocalAvoidance", ClampMin = "0.0", ClampMax = "1.0"))
+    float AvoidanceBlendWeight;
+
+    // Ruch całkowany z czasem klatki, transformacje zapisywane jednym przebiegiem po tickach jednostek
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement")
+    bool bUseBatchedMovement;
+
+    // Czas, w którym jednostka pokonuje Speed - prędkość w walce to Speed / MovementStepTime na sekundę
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (EditCondition = "bUseBatchedMovement", ClampMin = "0.001"))
+    float MovementStepTime;
+
+    // Liczba partii pozycji wysyłanych klientom na sekundę - jedyny kanał pozycji w ruchu wsadowym
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Movement", meta = (EditCondition = "bUseBatchedMovement", ClampMin = "1.0"))
+    float PositionPublishRate;
+
+    // Oddziały - skupiska sojuszników dzielące jedną decyzję o celu i jedno zapytanie o trasę lub pole przepływu
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Squads")
+    bool bUseSquads;
+
+    // Największa odległość między sąsiadami w jednym oddziale
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Squads", meta = (EditCondition = "bUseSquads", ClampMin = "1.0"))
+    float SquadLinkDistance;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Squads", meta = (EditCondition = "bUseSquads", ClampMin = "2", ClampMax = "64"))
+    int32 MaxSquadSize;
+
+    // Co ile sekund oddziały są dzielone i łączone według aktualnych skupisk w siatce przestrzennej
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Squads", meta = (EditCondition = "bUseSquads", ClampMin = "0.0"))
+    float SquadRebuildInterval;
+
+    // Promień rejonu wokół celu oddziału, z którego członkowie bez celu dobierają przeciwników
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Squads", meta = (EditCondition = "bUseSquads", ClampMin = "0.0"))
+    float SquadTargetRegionRadius;
+
+    // Jednostki martwe i czyszczone po rundzie wracają do puli zamiast niszczenia aktorów
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Pool")
+    bool bUseUnitPool;
+
+    // Liczba aktorów tworzonych z góry dla każdego typu przy starcie gry
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Pool", meta = (EditCondition = "bUseUnitPool"))
+    TMap<EBaseUnitType, int32> UnitPoolPrewarmCounts;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Unit Pool", meta = (EditCondition = "bUseUnitPool", ClampMin = "0", ClampMax = "1000"))
+    int32 MaxPooledUnitsPerType;
+
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Unit Classes")
     TSubclassOf<ABaseUnit> TankUnitClass;
 
@@ -375,29 +767,162 @@ private:
     void RetryInitializeGridManager();
     void DelayedGridManagerInit();
 
-    bool IsValidPlayerSpawnPosition(FVector2D GridPosition, int32 PlayerID) const;
+    bool IsValidPlayerSpawnPosition(FGridCell GridPosition, int32 PlayerID) const;
     TSubclassOf<ABaseUnit> GetUnitClassByType(EBaseUnitType UnitType) const;
-    FVector GetWorldLocationFromGrid(FVector2D GridPosition) const;
+
+    FVector GetWorldLocationFromGrid(FGridCell GridPosition) const;
 
     FSpawnedUnitData* FindUnitData(ABaseUnit* Unit);
     bool DoesUnitBelongToPlayer(ABaseUnit* Unit, int32 PlayerID) const;
     void RemoveUnitFromArray(ABaseUnit* Unit);
     void RemoveUnitFromClientArray(ABaseUnit* Unit);
-    void UpdateUnitDataPosition(ABaseUnit* Unit, FVector2D NewPosition);
+    void UpdateUnitDataPosition(ABaseUnit* Unit, FGridCell NewPosition);
 
-    void CreateHighlightComponent(FVector2D GridPosition, UMaterialInterface* Material);
+    void CreateHighlightComponent(FGridCell GridPosition, UMaterialInterface* Material);
     void ClearHighlightComponents();
 
     void BindUnitCombatEvents(ABaseUnit* Unit);
     void UnbindUnitCombatEvents(ABaseUnit* Unit);
     void OnUnitDeathEvent(ABaseUnit* DeadUnit);
     void OnUnitDamagedEvent(ABaseUnit* DamagedUnit, int32 Damage);
+    void ApplyAcquiredTarget(ABaseUnit* Unit, ABaseUnit* NearestEnemy);
+    void AdjustAliveUnitCount(int32 PlayerID, int32 Delta);
     void DiagnoseNetworkIssues();
 
+    void StartLockstepBattle();
+    void UpdateLockstepBattle(float DeltaTime);
+
+    TArray<ABaseUnit*>& GetUnitPoolBucket(EBaseUnitType UnitType);
+
+    void UpdateBattleRegion(bool bForce);
+    bool ToBattleRegionCell(const FGridCell& Cell, FGridCell& OutLocalCell) const;
+    void InitializeFlowFields();
+    void UpdateFlowFields();
+    void ApplyNavigationLayerToBattleRegion(bool bForce);
+    void InitializePathService();
+    void UpdatePathService();
+    void BeginCellReservationTick();
+    void ResolveCellReservations(bool bGrantMoves);
+    void UpdateLocalAvoidance();
+    void FlushUnitMoves(float DeltaTime);
+    void UpdateSquads(float DeltaTime);
+    void RebuildSquads();
+    void UpdateSquadTargets();
+    void RefreshSquadTargetCandidates(FBattleSquadPlan& Plan, int32 TeamID);
+
+    ABaseUnit* SpawnUnitInternal(int32 PlayerID, EBaseUnitType UnitType, bool bNotifyClients);
+    ABaseUnit* SpawnClientUnitCopy(int32 PlayerID, FGridCell GridPosition, EBaseUnitType UnitType);
+    void ProcessSpawnQueue(bool bWithinFrameBudget = true);
+    void ProcessClientSpawnQueue();
+    bool IsSpawnFrameBudgetExhausted(int32 SpawnedThisFrame, double StartTime) const;
+    void FinishSpawnBatch();
+
+    ABaseUnit* SpawnStressUnit(int32 PlayerID, EBaseUnitType UnitType, const FVector2D& WorldPosition, const FBox2D& BoardBounds, bool bWithPresentation);
+    void DestroySpawnedUnitActors();
+
+    int32 RegisterUnitTimerSlot(ABaseUnit* Unit);
+    void ProcessCombatTimers();
+    uint32 GetCurrentTimerTick() const;
+
+    FCombatTimingWheel CombatTimingWheel;
+
+    UPROPERTY()
+    TArray<ABaseUnit*> TimerUnitSlots;
+
+    TArray<uint16> TimerSlotGenerations;
+    TArray<int32> FreeTimerSlots;
+    TArray<FCombatTimerEntry> DueTimerEntries;
+
+    TArray<FPendingDamage> PendingDamage;
+
+    // Liczniki żywych jednostek per gracz (indeks = PlayerID), aktualizowane przy spawnie, śmierci i usunięciu
+    TArray<int32> AliveUnitCounts;
+    bool bCombatEndCheckPending;
+
+    // Kursor round-robin po CombatUnitsArray dla trybu podziału czasu
+    int32 TimeSliceCursor;
+    FTimeSlicedCombatStats TimeSlicedCombatStats;
+    TArray<FPendingDamage> ResolvingDamage;
+
+    FLockstepBattleSession LockstepSession;
+    bool bLockstepSnapshotRequested;
+
+    // Kolejka partii spawnu (serwer) i lokalnych kopii z MulticastUnitBatchSpawned (klienci)
+    TArray<FPendingSpawnBatch> PendingSpawnBatches;
+    TArray<FSpawnedUnitData> PendingClientSpawns;
+    int32 NextSpawnBatchID;
+
+    // Obszar bitwy w komórkach planszy (Max poza obszarem, wyrównany do fragmentów warstwy nawigacji) -
+    // pola przepływu, serwis ścieżek i tablica rezerwacji mają jego wymiary i komórki względem BattleRegion.Min
+    FIntRect BattleRegion;
+
+    // Pola przepływu drużyn (indeks = TeamID) - cele to komórki zajęte przez wrogów
+    FBattleFlowField TeamFlowFields[2];
+
+    // Rewizja warstwy nawigacji GridManagera skopiowana ostatnio do obszaru bitwy
+    uint32 AppliedNavigationRevision;
+
+    // Blokady z warstwy nawigacji w obszarze bitwy - po zmianie rewizji przepisywane tylko ze zmienionych fragmentów
+    TArray<bool> NavigationBlockedCells;
+    TArray<FGridCell> ChangedNavigationChunks;
+
+    // Serwis ścieżek - zajętość komórek obszaru bitwy przez żywe jednostki i zleceniodawcy zapytań w toku
+    FGridPathService PathService;
+    TMap<int32, TWeakObjectPtr<ABaseUnit>> PathRequesters;
+    TArray<FGridPathResult> PathResults;
+    TArray<bool> PathOccupancy;
+
+    // Rezerwacje komórek obszaru bitwy na bieżący tick, migawka zgłoszeń i zgłaszający (indeks = ID zgłoszenia w tablicy)
+    FCellReservationTable CellReservations;
+    TArray<TWeakObjectPtr<ABaseUnit>> ReservationClaimants;
+    TArray<FCellMoveClaim> ReservationClaims;
+
+    // Komórki żywych jednostek na początku ticku we współrzędnych obszaru bitwy (po jednym wpisie na jednostkę)
+    TArray<FGridCell> ReservationOccupiedCells;
+
+    // Bufory unikania kolizji wielokrotnego użytku (indeks = wpis migawki)
+    FAvoidanceSnapshot AvoidanceSnapshot;
+    TArray<ABaseUnit*> AvoidanceUnits;
+    TArray<FVector2D> AvoidanceVelocities;
+
+    // Kroki jednostek z bieżącej klatki i bufory partii pozycji dla klientów
+    FBatchedUnitMover UnitMover;
+    TArray<ABaseUnit*> PublishedUnits;
+    TArray<FUnitPositionUpdate> PositionUpdates;
+
+    // Oddziały z ostatniej przebudowy - wejścia planisty, jednostka każdego wejścia i plany oddziałów
+    FBattleSquadPlanner SquadPlanner;
+    TArray<FSquadMemberInput> SquadInputs;
+    TArray<ABaseUnit*> SquadUnits;
+    TArray<FBattleSquadPlan> SquadPlans;
+    TMap<const ABaseUnit*, FSquadMemberSlot> SquadMemberSlots;
+    float SquadRebuildCountdown;
+
+    // Pula aktorów per typ (indeks = EBaseUnitType)
+    UPROPERTY(Transient)
+    TArray<FUnitPoolBucket> UnitPool;
+
+    // Test obciążeniowy - powiększona plansza i wyciszone logi do czasu FinishCombatStressTest
+    bool bStressTestActive;
+    FCombatStressConfig ActiveStressConfig;
+    FCombatStressTickRecorder StressTickRecorder;
+    FCombatStressReport LastStressReport;
+    float StressStartGameSeconds;
+    double StressLastTickSeconds;
+    FVector2D SavedSpatialGridWorldMin;
+    FVector2D SavedSpatialGridWorldMax;
+    ELogVerbosity::Type SavedLogVerbosity;
+
+    // Plansza AGridManagera sprzed testu obciążeniowego - wymiary, położenie i przeszkody warstwy nawigacji
+    bool bStressGridResized;
+    int32 SavedGridWidth;
+    int32 SavedGridHeight;
+    FVector SavedGridOrigin;
+    FGridNavigationLayer SavedNavigationLayer;
+
     bool bInitialized;
 
     FTimerHandle InitializeGridManagerHandle;
     FTimerHandle RetryInitializeGridManagerHandle;
     FTimerHandle CombatUpdateTimer;
-    FTimerHandle CombatMonitorTimer;
 };
\ No newline at end of file
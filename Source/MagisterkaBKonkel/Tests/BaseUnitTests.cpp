@@ -0,0 +1,45 @@
+// BaseUnitTests.cpp - Testy automatyczne dla ABaseUnit
+#include "Misc/AutomationTest.h"
+#include "BaseUnit.h"
+#include "TestWorld.h"
+#include "Tests/AutomationCommon.h"
+
+// Test 1: Bufor odległości do celu jest przeliczany, gdy cel przesunie się w tej samej klatce
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBaseUnitTargetRangeCacheTest,
+    "Game.BaseUnit.TargetRangeCache",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBaseUnitTargetRangeCacheTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    ABaseUnit* Unit = World->SpawnActor<ABaseUnit>();
+    ABaseUnit* Target = World->SpawnActor<ABaseUnit>();
+    if (!Unit || !Target)
+    {
+        AddError(TEXT("Nie udało się utworzyć aktorów testu"));
+        return false;
+    }
+
+    Unit->SetActorLocation(FVector(0.0f, 0.0f, 0.0f));
+    Target->SetActorLocation(FVector(1000.0f, 0.0f, 0.0f));
+
+    // Act - dwa odczyty w tej samej klatce, między nimi ruch celu
+    const float DistanceBefore = FMath::Sqrt(Unit->GetTargetRange(Target).DistanceSq);
+    const float CachedDistance = FMath::Sqrt(Unit->GetTargetRange(Target).DistanceSq);
+
+    Target->SetActorLocation(FVector(0.0f, 300.0f, 0.0f));
+    const FTargetRangeCache& Moved = Unit->GetTargetRange(Target);
+    const float DistanceAfter = FMath::Sqrt(Moved.DistanceSq);
+    const FVector DirectionAfter = Moved.Direction;
+
+    // Assert
+    TestEqual(TEXT("Odległość przed ruchem"), DistanceBefore, 1000.0f, 0.01f);
+    TestEqual(TEXT("Drugi odczyt bez ruchu zwraca tę samą wartość"), CachedDistance, DistanceBefore);
+    TestEqual(TEXT("Odległość po ruchu celu w tej samej klatce"), DistanceAfter, 300.0f, 0.01f);
+    TestTrue(TEXT("Kierunek po ruchu celu wskazuje na nową pozycję"), DirectionAfter.Equals(FVector(0.0f, 1.0f, 0.0f), 0.001f));
+
+    return true;
+}
@@ -0,0 +1,101 @@
+// BatchedUnitMoverTests.cpp - Testy automatyczne dla ruchu całkowanego z czasem klatki
+#include "Misc/AutomationTest.h"
+#include "BatchedUnitMover.h"
+#include "Tests/AutomationCommon.h"
+
+// Test 1: Droga po jednej sekundzie nie zależy od liczby klatek, a długa klatka jest przycinana
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBatchedUnitMoverIntegrationTest,
+    "Game.BatchedUnitMover.Integration",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBatchedUnitMoverIntegrationTest::RunTest(const FString& Parameters)
+{
+    // Arrange - krok 5 jednostek na 1/60 s, czyli 300 jednostek na sekundę
+    const float StepLength = 5.0f;
+    const float StepTime = 1.0f / 60.0f;
+    const FVector Direction = FVector(3.0f, 4.0f, 0.0f).GetSafeNormal();
+    const FVector Start(100.0f, 200.0f, 50.0f);
+
+    auto SimulateOneSecond = [&](int32 FrameRate)
+    {
+        FVector Position = Start;
+        for (int32 Frame = 0; Frame < FrameRate; Frame++)
+        {
+            Position = FBatchedUnitMover::IntegrateStep(Position, Direction, StepLength, StepTime, 1.0f / FrameRate);
+        }
+        return Position;
+    };
+
+    // Act
+    const FVector At30 = SimulateOneSecond(30);
+    const FVector At60 = SimulateOneSecond(60);
+    const FVector At144 = SimulateOneSecond(144);
+    const FVector AfterHitch = FBatchedUnitMover::IntegrateStep(Start, Direction, StepLength, StepTime, 2.0f);
+    const FVector VerticalDirection = FBatchedUnitMover::IntegrateStep(Start, FVector(0.0f, 0.0f, 1.0f), StepLength, StepTime, StepTime);
+    const FVector SlowedStep = FBatchedUnitMover::IntegrateStep(Start, Direction * 0.4f, StepLength, StepTime, StepTime);
+    const FVector StoppedStep = FBatchedUnitMover::IntegrateStep(Start, FVector::ZeroVector, StepLength, StepTime, StepTime);
+
+    // Assert
+    TestTrue(TEXT("300 jednostek na sekundę przy 60 FPS"), FMath::IsNearlyEqual(FVector::Dist(Start, At60), 300.0f, 0.01f));
+    TestTrue(TEXT("Ta sama droga przy 30 FPS"), At30.Equals(At60, 0.01f));
+    TestTrue(TEXT("Ta sama droga przy 144 FPS"), At144.Equals(At60, 0.01f));
+    TestEqual(TEXT("Wysokość bez zmian"), At60.Z, Start.Z);
+    TestTrue(TEXT("Długa klatka przycięta do MaxStepDeltaTime"),
+        FMath::IsNearlyEqual(FVector::Dist(Start, AfterHitch), StepLength * FBatchedUnitMover::MaxStepDeltaTime / StepTime, 0.01f));
+    TestEqual(TEXT("Ruch tylko w płaszczyźnie XY"), VerticalDirection, Start);
+    TestTrue(TEXT("Zwolnienie z unikania do 40% skraca krok do 40%"), FMath::IsNearlyEqual(FVector::Dist(Start, SlowedStep), 0.4f * StepLength, 0.001f));
+    TestEqual(TEXT("Zerowa prędkość - jednostka stoi"), StoppedStep, Start);
+    TestEqual(TEXT("Skala kroku referencyjnego"), FBatchedUnitMover::GetStepScale(StepTime, StepTime), 1.0f);
+
+    return true;
+}
+
+// Test 2: Liczba publikacji pozycji zależy od czasu gry, a nie od liczby klatek serwera
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBatchedUnitMoverPublishTest,
+    "Game.BatchedUnitMover.Publish",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBatchedUnitMoverPublishTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    const float PublishInterval = 0.1f;
+
+    auto CountPublishes = [PublishInterval](int32 FrameRate, float Seconds)
+    {
+        FBatchedUnitMover Mover;
+        int32 Publishes = 0;
+        const int32 Frames = FMath::RoundToInt(FrameRate * Seconds);
+        for (int32 Frame = 0; Frame < Frames; Frame++)
+        {
+            if (Mover.ConsumePublishTime(1.0f / FrameRate, PublishInterval))
+            {
+                Publishes++;
+            }
+        }
+        return Publishes;
+    };
+
+    // Act
+    const int32 PublishesAt60 = CountPublishes(60, 2.0f);
+    const int32 PublishesAt144 = CountPublishes(144, 2.0f);
+    const int32 PublishesAt20 = CountPublishes(20, 2.0f);
+
+    FBatchedUnitMover HitchMover;
+    const bool bPublishedAfterHitch = HitchMover.ConsumePublishTime(1.0f, PublishInterval);
+    const bool bPublishedRightAfterHitch = HitchMover.ConsumePublishTime(0.01f, PublishInterval);
+
+    // Assert - 10 partii na sekundę niezależnie od klatek serwera
+    TestTrue(TEXT("Około 20 partii przy 60 FPS"), FMath::Abs(PublishesAt60 - 20) <= 1);
+    TestTrue(TEXT("Około 20 partii przy 144 FPS"), FMath::Abs(PublishesAt144 - 20) <= 1);
+    TestTrue(TEXT("Około 20 partii przy 20 FPS"), FMath::Abs(PublishesAt20 - 20) <= 1);
+    TestTrue(TEXT("Publikacja po długiej klatce"), bPublishedAfterHitch);
+    TestFalse(TEXT("Bez serii zaległych publikacji po długiej klatce"), bPublishedRightAfterHitch);
+
+    // Pusta kolejka
+    FBatchedUnitMover EmptyMover;
+    EmptyMover.QueueMove(nullptr, FVector::ZeroVector);
+    TestEqual(TEXT("Brak jednostki - brak zgłoszenia"), EmptyMover.GetQueuedMoveCount(), 0);
+    TestEqual(TEXT("Pusty zapis"), EmptyMover.Flush(), 0);
+
+    return true;
+}
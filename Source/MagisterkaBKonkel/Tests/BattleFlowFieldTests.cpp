@@ -0,0 +1,219 @@
+// BattleFlowFieldTests.cpp - Testy automatyczne dla pól przepływu drużyn
+#include "Misc/AutomationTest.h"
+#include "BattleFlowField.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja zwracająca środek komórki siatki 10x10 o boku 100 zaczynającej się w (0, 0)
+static FVector FlowFieldCellCenter(int32 X, int32 Y)
+{
+    return FVector(X * 100.0f, Y * 100.0f, 0.0f);
+}
+
+// Test 1: Pole prowadzi do celu, a do gęstszego skupiska wrogów przy równej odległości
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleFlowFieldDirectionTest,
+    "Game.BattleFlowField.Direction",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleFlowFieldDirectionTest::RunTest(const FString& Parameters)
+{
+    // Arrange - jeden wróg w (9, 5) i trzech w (0, 5)
+    FBattleFlowField FlowField;
+    FlowField.Initialize(10, 10, 100.0f, FVector::ZeroVector);
+
+    FlowField.BeginGoals();
+    FlowField.AddGoal(FlowFieldCellCenter(9, 5));
+    for (int32 i = 0; i < 3; i++)
+    {
+        FlowField.AddGoal(FlowFieldCellCenter(0, 5));
+    }
+
+    // Act
+    const bool bRecomputed = FlowField.CommitGoals();
+
+    FVector NearSingleDirection;
+    FVector MiddleDirection;
+    FVector OutsideDirection;
+    const bool bNearSingle = FlowField.SampleDirection(FlowFieldCellCenter(8, 5), NearSingleDirection);
+    const bool bMiddle = FlowField.SampleDirection(FlowFieldCellCenter(5, 5) + FVector(10.0f, -20.0f, 0.0f), MiddleDirection);
+    const bool bOutside = FlowField.SampleDirection(FlowFieldCellCenter(12, 5), OutsideDirection);
+
+    // Assert
+    TestTrue(TEXT("Pierwsze zatwierdzenie celów przelicza pole"), bRecomputed);
+    TestTrue(TEXT("Komórka obok wroga ma kierunek"), bNearSingle);
+    TestTrue(TEXT("Obok pojedynczego wroga kierunek +X"), NearSingleDirection.Equals(FVector(1.0f, 0.0f, 0.0f), 0.01f));
+
+    // Ze środka oba cele są w podobnej odległości - wygrywa skupisko trzech wrogów
+    TestTrue(TEXT("Komórka środkowa ma kierunek"), bMiddle);
+    TestTrue(TEXT("Ze środka kierunek do skupiska (-X)"), MiddleDirection.X < -0.5f);
+    TestFalse(TEXT("Poza siatką brak kierunku"), bOutside);
+    TestEqual(TEXT("Koszt komórki celu z trzema wrogami"), FlowField.GetCellCost(0, 5), FBattleFlowField::OrthogonalCost);
+
+    return true;
+}
+
+// Test 2: Pole jest przeliczane tylko po zmianie zajętości komórek celów
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleFlowFieldIncrementalTest,
+    "Game.BattleFlowField.Incremental",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleFlowFieldIncrementalTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FBattleFlowField FlowField;
+    FlowField.Initialize(10, 10, 100.0f, FVector::ZeroVector);
+
+    FlowField.BeginGoals();
+    FlowField.AddGoal(FlowFieldCellCenter(4, 4));
+    FlowField.CommitGoals();
+
+    // Act - ruch wroga w obrębie tej samej komórki nie zmienia zajętości
+    FlowField.BeginGoals();
+    FlowField.AddGoal(FlowFieldCellCenter(4, 4) + FVector(30.0f, 20.0f, 0.0f));
+    const bool bRecomputedSameCell = FlowField.CommitGoals();
+
+    // Act - przejście do sąsiedniej komórki
+    FlowField.BeginGoals();
+    FlowField.AddGoal(FlowFieldCellCenter(5, 4));
+    const bool bRecomputedNewCell = FlowField.CommitGoals();
+
+    // Assert
+    TestFalse(TEXT("Ta sama komórka nie przelicza pola"), bRecomputedSameCell);
+    TestTrue(TEXT("Nowa komórka przelicza pole"), bRecomputedNewCell);
+    TestEqual(TEXT("Liczba przeliczeń"), FlowField.GetRecomputeCount(), 2);
+    TestEqual(TEXT("Koszt nowej komórki celu"), FlowField.GetCellCost(5, 4),
+        FBattleFlowField::OrthogonalCost * (FBattleFlowField::MaxGoalConcentration - 1));
+
+    return true;
+}
+
+// Test 3: Zablokowane komórki są omijane, także bez ścinania rogów po przekątnej
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleFlowFieldBlockedTest,
+    "Game.BattleFlowField.Blocked",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleFlowFieldBlockedTest::RunTest(const FString& Parameters)
+{
+    // Arrange - ściana w kolumnie X = 5 od Y = 0 do Y = 8, przejście tylko w Y = 9
+    FBattleFlowField FlowField;
+    FlowField.Initialize(10, 10, 100.0f, FVector::ZeroVector);
+    for (int32 Y = 0; Y < 9; Y++)
+    {
+        FlowField.SetCellBlocked(5, Y, true);
+    }
+
+    FlowField.BeginGoals();
+    FlowField.AddGoal(FlowFieldCellCenter(9, 0));
+
+    // Act
+    FlowField.CommitGoals();
+
+    FVector BehindWallDirection;
+    FVector CornerDirection;
+    const bool bBehindWall = FlowField.SampleDirection(FlowFieldCellCenter(4, 0), BehindWallDirection);
+    const bool bCorner = FlowField.SampleDirection(FlowFieldCellCenter(4, 8), CornerDirection);
+
+    FlowField.SetCellBlocked(5, 0, true);
+    const bool bRecomputedSameBlock = FlowField.Update();
+
+    // Assert
+    TestTrue(TEXT("Komórka za ścianą ma kierunek"), bBehindWall);
+    TestTrue(TEXT("Za ścianą kierunek w stronę przejścia (+Y)"), BehindWallDirection.Equals(FVector(0.0f, 1.0f, 0.0f), 0.01f));
+
+    // Z (4, 8) przekątna do (5, 9) ścinałaby róg ściany w (5, 8)
+    TestTrue(TEXT("Komórka przy rogu ma kierunek"), bCorner);
+    TestTrue(TEXT("Przy rogu ruch ortogonalny do przejścia"), CornerDirection.Equals(FVector(0.0f, 1.0f, 0.0f), 0.01f));
+
+    // Droga (9, 0) -> (6, 9) -> (4, 9) -> (4, 0): 3 kroki po przekątnej i 17 ortogonalnych
+    TestEqual(TEXT("Koszt drogi naokoło ściany"), FlowField.GetCellCost(4, 0),
+        FBattleFlowField::OrthogonalCost * (FBattleFlowField::MaxGoalConcentration - 1) + 3 * FBattleFlowField::DiagonalCost + 17 * FBattleFlowField::OrthogonalCost);
+    TestFalse(TEXT("Ponowne ustawienie tej samej blokady nie przelicza pola"), bRecomputedSameBlock);
+
+    return true;
+}
+
+// Pomocnicza funkcja porównująca koszty i kierunki dwóch pól o tych samych wymiarach
+static bool FlowFieldsMatch(const FBattleFlowField& A, const FBattleFlowField& B)
+{
+    for (int32 Y = 0; Y < A.GetHeight(); Y++)
+    {
+        for (int32 X = 0; X < A.GetWidth(); X++)
+        {
+            FVector DirectionA = FVector::ZeroVector;
+            FVector DirectionB = FVector::ZeroVector;
+            const bool bHasA = A.SampleDirection(FlowFieldCellCenter(X, Y), DirectionA);
+            const bool bHasB = B.SampleDirection(FlowFieldCellCenter(X, Y), DirectionB);
+            if (A.GetCellCost(X, Y) != B.GetCellCost(X, Y) || bHasA != bHasB || !DirectionA.Equals(DirectionB))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Test 4: Zmiana celów naprawia tylko zależne komórki i daje to samo pole co pełne przeliczenie
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleFlowFieldRepairTest,
+    "Game.BattleFlowField.Repair",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleFlowFieldRepairTest::RunTest(const FString& Parameters)
+{
+    // Arrange - plansza 32x32 z przeszkodą i terenem spowalniającym, wrogowie w (2, 2) i (29, 29)
+    constexpr int32 Size = 32;
+    auto SetupTerrain = [](FBattleFlowField& FlowField, int32 FieldSize)
+    {
+        FlowField.Initialize(FieldSize, FieldSize, 100.0f, FVector::ZeroVector);
+        for (int32 Y = 8; Y < 24; Y++)
+        {
+            FlowField.SetCellBlocked(16, Y, true);
+            FlowField.SetCellMoveCost(10, Y, 3);
+        }
+    };
+
+    FBattleFlowField FlowField;
+    SetupTerrain(FlowField, Size);
+    FlowField.BeginGoals();
+    FlowField.AddGoal(FlowFieldCellCenter(2, 2));
+    FlowField.AddGoal(FlowFieldCellCenter(29, 29));
+    FlowField.CommitGoals();
+
+    // Act - wróg przechodzi do sąsiedniej komórki
+    FlowField.BeginGoals();
+    FlowField.AddGoal(FlowFieldCellCenter(2, 2));
+    FlowField.AddGoal(FlowFieldCellCenter(29, 28));
+    const bool bRepairedMove = FlowField.CommitGoals();
+    const int32 UpdatedAfterMove = FlowField.GetLastUpdatedCellCount();
+
+    FBattleFlowField ExpectedAfterMove;
+    SetupTerrain(ExpectedAfterMove, Size);
+    ExpectedAfterMove.BeginGoals();
+    ExpectedAfterMove.AddGoal(FlowFieldCellCenter(2, 2));
+    ExpectedAfterMove.AddGoal(FlowFieldCellCenter(29, 28));
+    ExpectedAfterMove.CommitGoals();
+    const bool bMatchesAfterMove = FlowFieldsMatch(FlowField, ExpectedAfterMove);
+
+    // Act - jeden wróg ginie, w komórce drugiego staje kolejny
+    FlowField.BeginGoals();
+    FlowField.AddGoal(FlowFieldCellCenter(29, 28));
+    FlowField.AddGoal(FlowFieldCellCenter(29, 28));
+    FlowField.CommitGoals();
+
+    FBattleFlowField ExpectedAfterRemoval;
+    SetupTerrain(ExpectedAfterRemoval, Size);
+    ExpectedAfterRemoval.BeginGoals();
+    ExpectedAfterRemoval.AddGoal(FlowFieldCellCenter(29, 28));
+    ExpectedAfterRemoval.AddGoal(FlowFieldCellCenter(29, 28));
+    ExpectedAfterRemoval.CommitGoals();
+    const bool bMatchesAfterRemoval = FlowFieldsMatch(FlowField, ExpectedAfterRemoval);
+
+    // Assert
+    TestTrue(TEXT("Zmiana komórki celu aktualizuje pole"), bRepairedMove);
+    TestTrue(TEXT("Naprawa po ruchu wroga daje to samo pole co pełne przeliczenie"), bMatchesAfterMove);
+    TestTrue(TEXT("Naprawa po śmierci wroga daje to samo pole co pełne przeliczenie"), bMatchesAfterRemoval);
+    TestEqual(TEXT("Liczba aktualizacji pola"), FlowField.GetRecomputeCount(), 3);
+    TestEqual(TEXT("Tylko pierwsze zatwierdzenie przelicza całe pole"), FlowField.GetFullRecomputeCount(), 1);
+    TestTrue(TEXT("Ruch jednego wroga nie aktualizuje wszystkich komórek"), UpdatedAfterMove > 0 && UpdatedAfterMove < Size * Size);
+
+    return true;
+}
@@ -0,0 +1,152 @@
+// BattleReplayTests.cpp - Testy automatyczne dla powtórek bitew i weryfikatora determinizmu
+#include "Misc/AutomationTest.h"
+#include "BattleReplay.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja tworząca małą bitwę 6 na 6
+static FBattleSimSetup CreateReplaySetup()
+{
+    FBattleSimSetup Setup;
+    for (FSimUnitStats& Stats : Setup.TypeStats)
+    {
+        Stats.Speed = 50.0f;
+        Stats.AttackRange = 150.0f;
+        Stats.AttackCooldown = 1.0f;
+        Stats.MovementInterval = 0.2f;
+        Stats.SearchRange = 5000.0f;
+    }
+    Setup.TypeStats[static_cast<int32>(EBaseUnitType::Sword)].Attack = 25;
+
+    for (int32 i = 0; i < 6; i++)
+    {
+        FSimUnitPlacement& Player0Unit = Setup.Placements.AddDefaulted_GetRef();
+        Player0Unit.PlayerID = 0;
+        Player0Unit.GridPosition = FGridCell(i * 2, 1);
+        Player0Unit.UnitType = (i % 2) ? EBaseUnitType::Sword : EBaseUnitType::Tank;
+
+        FSimUnitPlacement& Player1Unit = Setup.Placements.AddDefaulted_GetRef();
+        Player1Unit.PlayerID = 1;
+        Player1Unit.GridPosition = FGridCell(i * 2 + 1, 12);
+        Player1Unit.UnitType = (i % 2) ? EBaseUnitType::Armor : EBaseUnitType::Ninja;
+    }
+
+    return Setup;
+}
+
+// Test 1: Zapis i odczyt powtórki, weryfikacja skrótów po każdym ticku
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleReplayRoundTripTest,
+    "Game.BattleReplay.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleReplayRoundTripTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    const FBattleReplay Recorded = FBattleReplay::Record(CreateReplaySetup(), 1234, 0.25f, true);
+
+    // Act
+    TArray<uint8> Bytes;
+    const bool bSaved = Recorded.SaveToBytes(Bytes);
+
+    FBattleReplay Loaded;
+    const bool bLoaded = Loaded.LoadFromBytes(Bytes);
+    const FBattleReplayVerifyResult Verification = Loaded.Verify();
+
+    // Assert
+    TestTrue(TEXT("Powtórka powinna się zapisać"), bSaved);
+    TestTrue(TEXT("Powtórka powinna się wczytać"), bLoaded);
+    TestTrue(TEXT("Nagranie powinno mieć skróty ticków"), Recorded.TickHashes.Num() > 0);
+    TestEqual(TEXT("Liczba jednostek po odczycie"), Loaded.Setup.Placements.Num(), 12);
+    TestTrue(FString::Printf(TEXT("Weryfikacja powinna przejść: %s"), *Verification.Error), Verification.bMatches);
+    TestEqual(TEXT("Porównano wszystkie ticki"), Verification.TicksCompared, Recorded.TickHashes.Num());
+    TestTrue(TEXT("Powtórka powinna mieć kilka KB"), Bytes.Num() < 16 * 1024);
+
+    AddInfo(FString::Printf(TEXT("Powtórka: %d bajtów, %d ticków"), Bytes.Num(), Recorded.TickHashes.Num()));
+
+    return true;
+}
+
+// Test 2: Weryfikator wykrywa rozbieżność stanu i zmianę wersji symulacji
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleReplayMismatchTest,
+    "Game.BattleReplay.Mismatch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleReplayMismatchTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    const FBattleReplay Recorded = FBattleReplay::Record(CreateReplaySetup(), 99, 0.25f, true);
+
+    FBattleReplay ChangedStats = Recorded;
+    ChangedStats.Setup.TypeStats[static_cast<int32>(EBaseUnitType::Tank)].Speed += 1.0f;
+
+    FBattleReplay ChangedVersion = Recorded;
+    ChangedVersion.SimVersion = FBattleReplay::CurrentSimVersion + 1;
+
+    // Act
+    const FBattleReplayVerifyResult StatsResult = ChangedStats.Verify();
+    const FBattleReplayVerifyResult VersionResult = ChangedVersion.Verify();
+
+    // Assert
+    TestFalse(TEXT("Zmienione statystyki powinny dać rozbieżność"), StatsResult.bMatches);
+    TestTrue(TEXT("Rozbieżność powinna wskazać tick"), StatsResult.FirstMismatchTick != INDEX_NONE);
+    TestFalse(TEXT("Inna wersja symulacji powinna zostać odrzucona"), VersionResult.bMatches);
+
+    return true;
+}
+
+// Test 3: Odtwarzanie z przyspieszeniem daje ten sam wynik co nagranie
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleReplayPlaybackSpeedTest,
+    "Game.BattleReplay.PlaybackSpeed",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleReplayPlaybackSpeedTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    const FBattleReplay Recorded = FBattleReplay::Record(CreateReplaySetup(), 7, 0.25f, true);
+    FBattleSimState State;
+    Recorded.StartPlayback(State);
+
+    // Act - klatki 60 FPS odtwarzane 4x szybciej
+    const float PlaybackRate = 4.0f;
+    int32 Frames = 0;
+    while (!State.IsFinished() && Frames < 100000)
+    {
+        State.Advance((1.0f / 60.0f) * PlaybackRate);
+        Frames++;
+    }
+    const FBattleSimResult Result = State.GetResult();
+
+    // Assert
+    TestEqual(TEXT("Liczba ticków zgodna z nagraniem"), State.GetTickCount(), Recorded.TickHashes.Num());
+    TestEqual(TEXT("Zwycięzca zgodny z nagraniem"), Result.WinnerPlayerID, Recorded.RecordedResult.WinnerPlayerID);
+    TestEqual(TEXT("Ocalali gracza 0 zgodni"), Result.Survivors[0], Recorded.RecordedResult.Survivors[0]);
+    TestEqual(TEXT("Ocalali gracza 1 zgodni"), Result.Survivors[1], Recorded.RecordedResult.Survivors[1]);
+
+    return true;
+}
+
+// Test 4: Powtórka w trybie stałopozycyjnym zachowuje tryb arytmetyki i przechodzi weryfikację
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleReplayFixedPointTest,
+    "Game.BattleReplay.FixedPoint",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleReplayFixedPointTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FBattleSimSetup Setup = CreateReplaySetup();
+    Setup.MathMode = EBattleSimMath::FixedPoint;
+    const FBattleReplay Recorded = FBattleReplay::Record(Setup, 321, 0.25f, true);
+
+    // Act
+    TArray<uint8> Bytes;
+    Recorded.SaveToBytes(Bytes);
+    FBattleReplay Loaded;
+    const bool bLoaded = Loaded.LoadFromBytes(Bytes);
+    const FBattleReplayVerifyResult Verification = Loaded.Verify();
+
+    // Assert
+    TestTrue(TEXT("Powtórka powinna się wczytać"), bLoaded);
+    TestTrue(TEXT("Tryb arytmetyki zachowany"), Loaded.Setup.MathMode == EBattleSimMath::FixedPoint);
+    TestTrue(FString::Printf(TEXT("Weryfikacja powinna przejść: %s"), *Verification.Error), Verification.bMatches);
+
+    return true;
+}
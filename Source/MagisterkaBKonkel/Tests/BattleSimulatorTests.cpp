@@ -0,0 +1,222 @@
+// BattleSimulatorTests.cpp - Testy automatyczne dla bezstanowego symulatora bitew
+#include "Misc/AutomationTest.h"
+#include "BattleSimulator.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja tworząca bitwę dwóch szeregów po UnitsPerSide jednostek
+static FBattleSimSetup CreateLineBattleSetup(int32 UnitsPerSide, int32 Player1Attack)
+{
+    FBattleSimSetup Setup;
+    for (FSimUnitStats& Stats : Setup.TypeStats)
+    {
+        Stats.MaxHealth = 100;
+        Stats.Attack = 20;
+        Stats.Defense = 5;
+        Stats.Speed = 50.0f;
+        Stats.AttackRange = 150.0f;
+        Stats.AttackCooldown = 1.0f;
+        Stats.MovementInterval = 0.2f;
+        Stats.SearchRange = 5000.0f;
+    }
+
+    // Gracz 1 używa typu Ninja, żeby móc zmieniać jego statystyki niezależnie
+    Setup.TypeStats[static_cast<int32>(EBaseUnitType::Ninja)].Attack = Player1Attack;
+
+    for (int32 i = 0; i < UnitsPerSide; i++)
+    {
+        FSimUnitPlacement& Player0Unit = Setup.Placements.AddDefaulted_GetRef();
+        Player0Unit.PlayerID = 0;
+        Player0Unit.GridPosition = FGridCell(i, 0);
+        Player0Unit.UnitType = EBaseUnitType::Tank;
+
+        FSimUnitPlacement& Player1Unit = Setup.Placements.AddDefaulted_GetRef();
+        Player1Unit.PlayerID = 1;
+        Player1Unit.GridPosition = FGridCell(i, 9);
+        Player1Unit.UnitType = EBaseUnitType::Ninja;
+    }
+
+    return Setup;
+}
+
+// Test 1: Ta sama bitwa z tym samym ziarnem daje ten sam wynik
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleSimulatorDeterminismTest,
+    "Game.BattleSimulator.Determinism",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleSimulatorDeterminismTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    const FBattleSimSetup Setup = CreateLineBattleSetup(8, 20);
+
+    // Act
+    const FBattleSimResult First = FBattleSimulator::RunBattle(Setup, 42, 0.25f, true);
+    const FBattleSimResult Second = FBattleSimulator::RunBattle(Setup, 42, 0.25f, true);
+
+    // Assert
+    TestEqual(TEXT("Zwycięzca powinien być identyczny"), First.WinnerPlayerID, Second.WinnerPlayerID);
+    TestEqual(TEXT("Czas bitwy powinien być identyczny"), First.DurationSeconds, Second.DurationSeconds);
+    TestEqual(TEXT("Ocalali gracza 0 powinni być identyczni"), First.Survivors[0], Second.Survivors[0]);
+    TestEqual(TEXT("Ocalali gracza 1 powinni być identyczni"), First.Survivors[1], Second.Survivors[1]);
+
+    return true;
+}
+
+// Test 2: Silniejsza armia wygrywa, seria równoległa i sekwencyjna dają te same statystyki
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleSimulatorBatchTest,
+    "Game.BattleSimulator.Batch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleSimulatorBatchTest::RunTest(const FString& Parameters)
+{
+    // Arrange - gracz 1 zadaje dwa razy więcej obrażeń
+    FBattleSimBatchRequest Request;
+    Request.Setup = CreateLineBattleSetup(5, 40);
+    Request.NumBattles = 10000;
+    Request.BaseSeed = 7;
+
+    // Act
+    const FBattleSimBatchResult Parallel = FBattleSimulator::RunBatch(Request);
+
+    Request.bParallel = false;
+    const FBattleSimBatchResult Serial = FBattleSimulator::RunBatch(Request);
+
+    // Assert
+    TestEqual(TEXT("Liczba bitew"), Parallel.NumBattles, 10000);
+    TestTrue(TEXT("Silniejszy gracz 1 powinien wygrywać większość bitew"), Parallel.WinRate[1] > 0.9f);
+    TestEqual(TEXT("Wygrane gracza 1 niezależne od wątków"), Parallel.Wins[1], Serial.Wins[1]);
+    TestEqual(TEXT("Średni czas bitwy niezależny od wątków"), Parallel.MeanDurationSeconds, Serial.MeanDurationSeconds);
+    TestTrue(TEXT("Bitwy powinny kończyć się przed limitem czasu"), Parallel.MaxDurationSeconds < Request.Setup.MaxBattleSeconds);
+
+    int32 HistogramTotal = 0;
+    for (int32 Count : Parallel.DurationHistogram)
+    {
+        HistogramTotal += Count;
+    }
+    TestEqual(TEXT("Histogram obejmuje wszystkie bitwy"), HistogramTotal, Parallel.NumBattles);
+
+    AddInfo(FString::Printf(TEXT("10000 bitew 5v5: równolegle %.1f ms, jeden wątek %.1f ms (%.0f bitew/s na rdzeń)"),
+        Parallel.WallSeconds * 1000.0, Serial.WallSeconds * 1000.0, Serial.NumBattles / FMath::Max(Serial.WallSeconds, 1e-6)));
+
+    return true;
+}
+
+// Test 3: Tryb stałopozycyjny - dwa przebiegi mają identyczne skróty po każdym ticku, a wynik zgadza się ze ścieżką float
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleSimulatorFixedPointTest,
+    "Game.BattleSimulator.FixedPoint",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleSimulatorFixedPointTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FBattleSimSetup FixedSetup = CreateLineBattleSetup(8, 40);
+    FixedSetup.MathMode = EBattleSimMath::FixedPoint;
+    const FBattleSimSetup FloatSetup = CreateLineBattleSetup(8, 40);
+
+    FBattleSimState First;
+    FBattleSimState Second;
+    First.Initialize(FixedSetup, 5, 0.25f, true);
+    Second.Initialize(FixedSetup, 5, 0.25f, true);
+
+    // Act
+    int32 FirstMismatchTick = INDEX_NONE;
+    while (!First.IsFinished())
+    {
+        First.Step();
+        Second.Step();
+        if (FirstMismatchTick == INDEX_NONE && First.ComputeStateHash() != Second.ComputeStateHash())
+        {
+            FirstMismatchTick = First.GetTickCount();
+        }
+    }
+
+    const FBattleSimResult FixedResult = First.GetResult();
+    const FBattleSimResult FloatResult = FBattleSimulator::RunBattle(FloatSetup, 5, 0.25f, true);
+
+    // Assert
+    TestTrue(TEXT("Stan powinien być w trybie stałopozycyjnym"), First.IsFixedPoint());
+    TestEqual(TEXT("Skróty obu przebiegów powinny być identyczne"), FirstMismatchTick, static_cast<int32>(INDEX_NONE));
+    TestTrue(TEXT("Bitwa powinna się rozstrzygnąć przed limitem czasu"), FixedResult.DurationSeconds < FixedSetup.MaxBattleSeconds);
+    TestEqual(TEXT("Zwycięzca zgodny ze ścieżką float"), FixedResult.WinnerPlayerID, FloatResult.WinnerPlayerID);
+
+    return true;
+}
+
+// Test 4: Tablica kierunków - osie, przekątne i długość kroku
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleSimulatorFixedDirectionTest,
+    "Game.BattleSimulator.FixedDirections",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleSimulatorFixedDirectionTest::RunTest(const FString& Parameters)
+{
+    // Act & Assert - kierunek 0 to +X, indeksy rosną przeciwnie do ruchu wskazówek zegara
+    TestEqual(TEXT("+X"), FSimFixedMath::DirectionIndex(1000, 0), 0);
+    TestEqual(TEXT("+Y"), FSimFixedMath::DirectionIndex(0, 1000), 16);
+    TestEqual(TEXT("-X"), FSimFixedMath::DirectionIndex(-1000, 0), 32);
+    TestEqual(TEXT("-Y"), FSimFixedMath::DirectionIndex(0, -1000), 48);
+    TestEqual(TEXT("+X+Y"), FSimFixedMath::DirectionIndex(500, 500), 8);
+    TestEqual(TEXT("-X-Y"), FSimFixedMath::DirectionIndex(-500, -500), 40);
+    TestEqual(TEXT("Prawie +X"), FSimFixedMath::DirectionIndex(10000, 20), 0);
+
+    int32 DirectionX = 0;
+    int32 DirectionY = 0;
+    FSimFixedMath::GetDirection(16, DirectionX, DirectionY);
+    TestEqual(TEXT("Kierunek +Y: X"), DirectionX, 0);
+    TestEqual(TEXT("Kierunek +Y: Y"), DirectionY, 1 << FSimFixedMath::DirectionBits);
+
+    // Krok po przekątnej ma długość kroku (z dokładnością do zaokrąglenia)
+    const int32 StepLength = FSimFixedMath::FromFloat(50.0f);
+    FSimFixedMath::GetDirection(8, DirectionX, DirectionY);
+    const int64 StepX = FSimFixedMath::ScaleByDirection(DirectionX, StepLength);
+    const int64 StepY = FSimFixedMath::ScaleByDirection(DirectionY, StepLength);
+    const int64 LengthSq = StepX * StepX + StepY * StepY;
+    TestTrue(TEXT("Długość kroku po przekątnej"), FMath::Abs(LengthSq - static_cast<int64>(StepLength) * StepLength) <= 2 * StepLength);
+
+    return true;
+}
+
+// Test 5: Tryb stałopozycyjny - skróty stanu dla stałego ziarna zgodne z zapisanymi wartościami wzorcowymi
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleSimulatorFixedPointGoldenHashTest,
+    "Game.BattleSimulator.FixedPointGoldenHash",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleSimulatorFixedPointGoldenHashTest::RunTest(const FString& Parameters)
+{
+    // Wartości wzorcowe dla CreateLineBattleSetup(8, 40), ziarno 5, przesunięcie 0.25 komórki, losowa faza ataku.
+    // Zmiana reguł symulacji trybu stałopozycyjnego wymaga świadomej aktualizacji tych stałych.
+    constexpr uint32 GoldenInitialHash = 0x22A03900;
+    constexpr uint32 GoldenTick20Hash = 0x78CBA9F3;
+    constexpr uint32 GoldenFinalHash = 0x647EB91B;
+    constexpr int32 GoldenFinalTick = 45;
+
+    // Arrange
+    FBattleSimSetup Setup = CreateLineBattleSetup(8, 40);
+    Setup.MathMode = EBattleSimMath::FixedPoint;
+
+    FBattleSimState State;
+    State.Initialize(Setup, 5, 0.25f, true);
+    const uint32 InitialHash = State.ComputeStateHash();
+
+    // Act
+    for (int32 Tick = 0; Tick < 20; Tick++)
+    {
+        State.Step();
+    }
+    const uint32 Tick20Hash = State.ComputeStateHash();
+
+    while (!State.IsFinished())
+    {
+        State.Step();
+    }
+    const FBattleSimResult Result = State.GetResult();
+
+    // Assert
+    TestTrue(*FString::Printf(TEXT("Skrót stanu początkowego 0x%08X powinien wynosić 0x%08X"), InitialHash, GoldenInitialHash), InitialHash == GoldenInitialHash);
+    TestTrue(*FString::Printf(TEXT("Skrót stanu po 20 tickach 0x%08X powinien wynosić 0x%08X"), Tick20Hash, GoldenTick20Hash), Tick20Hash == GoldenTick20Hash);
+    TestEqual(TEXT("Liczba ticków do końca bitwy"), State.GetTickCount(), GoldenFinalTick);
+    const uint32 FinalHash = State.ComputeStateHash();
+    TestTrue(*FString::Printf(TEXT("Skrót stanu końcowego 0x%08X powinien wynosić 0x%08X"), FinalHash, GoldenFinalHash), FinalHash == GoldenFinalHash);
+    TestEqual(TEXT("Zwycięzcą powinien być gracz 1"), Result.WinnerPlayerID, 1);
+    TestEqual(TEXT("Ocalali gracza 1"), Result.Survivors[1], 8);
+
+    return true;
+}
@@ -0,0 +1,132 @@
+// BattleSquadsTests.cpp - Testy automatyczne dla podziału jednostek na oddziały
+#include "Misc/AutomationTest.h"
+#include "BattleSquads.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja dodająca wejście jednostki
+static void AddSquadInput(TArray<FSquadMemberInput>& Inputs, float X, float Y, int32 TeamID, uint32 Key)
+{
+    FSquadMemberInput& Input = Inputs.AddDefaulted_GetRef();
+    Input.Position = FVector2D(X, Y);
+    Input.TeamID = TeamID;
+    Input.Key = Key;
+}
+
+// Pomocnicza funkcja zwracająca ID oddziału wejścia
+static int32 GetSquadIDOf(const FBattleSquadPlanner& Planner, int32 InputIndex)
+{
+    const int32 SquadIndex = Planner.GetSquadIndexOf(InputIndex);
+    return SquadIndex != INDEX_NONE ? Planner.GetSquads()[SquadIndex].SquadID : INDEX_NONE;
+}
+
+// Test 1: Skupiska dzielą się według drużyny i odległości, a za duże skupiska na oddziały o ograniczonym rozmiarze
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleSquadsClustersTest,
+    "Game.BattleSquads.Clusters",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleSquadsClustersTest::RunTest(const FString& Parameters)
+{
+    // Arrange - trzy sojusznicy w linii, wróg tuż obok nich i odległy sojusznik
+    TArray<FSquadMemberInput> Inputs;
+    AddSquadInput(Inputs, 0.0f, 0.0f, 0, 1);
+    AddSquadInput(Inputs, 200.0f, 0.0f, 0, 2);
+    AddSquadInput(Inputs, 400.0f, 0.0f, 0, 3);
+    AddSquadInput(Inputs, 200.0f, 100.0f, 1, 4);
+    AddSquadInput(Inputs, 2000.0f, 0.0f, 0, 5);
+
+    // Dziesięciu sojuszników co 100 jednostek przy limicie 4 na oddział
+    TArray<FSquadMemberInput> Column;
+    for (int32 i = 0; i < 10; i++)
+    {
+        AddSquadInput(Column, i * 100.0f, 0.0f, 0, 100 + i);
+    }
+
+    // Act
+    FBattleSquadPlanner Planner;
+    Planner.Rebuild(Inputs, 300.0f, 12);
+
+    FBattleSquadPlanner ColumnPlanner;
+    ColumnPlanner.Rebuild(Column, 300.0f, 4);
+
+    // Assert
+    TestEqual(TEXT("Trzy oddziały"), Planner.GetSquads().Num(), 3);
+    TestEqual(TEXT("Sojusznicy w linii w jednym oddziale"), Planner.GetSquadIndexOf(0), Planner.GetSquadIndexOf(2));
+    TestNotEqual(TEXT("Wróg w osobnym oddziale"), Planner.GetSquadIndexOf(3), Planner.GetSquadIndexOf(1));
+    TestNotEqual(TEXT("Odległy sojusznik w osobnym oddziale"), Planner.GetSquadIndexOf(4), Planner.GetSquadIndexOf(0));
+
+    const FBattleSquad& Line = Planner.GetSquads()[Planner.GetSquadIndexOf(0)];
+    TestEqual(TEXT("Lider najbliżej środka"), Line.Leader, 1);
+    TestEqual(TEXT("Przesunięcie w szyku względem lidera"), Line.FormationOffsets[Line.Members.Find(2)], FVector2D(200.0f, 0.0f));
+
+    TestEqual(TEXT("Kolumna podzielona na trzy oddziały"), ColumnPlanner.GetSquads().Num(), 3);
+
+    int32 CoveredInputs = 0;
+    for (const FBattleSquad& Squad : ColumnPlanner.GetSquads())
+    {
+        TestTrue(TEXT("Oddział nie przekracza limitu"), Squad.Num() <= 4);
+        CoveredInputs += Squad.Num();
+    }
+    TestEqual(TEXT("Każda jednostka w dokładnie jednym oddziale"), CoveredInputs, Column.Num());
+
+    return true;
+}
+
+// Test 2: Oddziały zachowują ID między przebudowami, a łączenie i rozpad skupisk są wykrywane
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBattleSquadsSplitMergeTest,
+    "Game.BattleSquads.SplitMerge",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBattleSquadsSplitMergeTest::RunTest(const FString& Parameters)
+{
+    // Arrange - dwie grupy po trzy jednostki, których pozycje zmieniają się między przebudowami
+    auto BuildInputs = [](float SecondGroupX)
+    {
+        TArray<FSquadMemberInput> Inputs;
+        for (int32 i = 0; i < 3; i++)
+        {
+            AddSquadInput(Inputs, i * 100.0f, 0.0f, 0, 1 + i);
+        }
+        for (int32 i = 0; i < 3; i++)
+        {
+            AddSquadInput(Inputs, SecondGroupX + i * 100.0f, 0.0f, 0, 4 + i);
+        }
+        return Inputs;
+    };
+
+    FBattleSquadPlanner Planner;
+
+    // Act & Assert - dwie oddzielne grupy
+    Planner.Rebuild(BuildInputs(2000.0f), 300.0f, 12);
+    const int32 FirstID = GetSquadIDOf(Planner, 0);
+    const int32 SecondID = GetSquadIDOf(Planner, 3);
+    TestEqual(TEXT("Dwa oddziały"), Planner.GetSquads().Num(), 2);
+    TestNotEqual(TEXT("Różne ID"), FirstID, SecondID);
+
+    // Bez zmian pozycji - te same ID, brak podziałów i połączeń
+    Planner.Rebuild(BuildInputs(2000.0f), 300.0f, 12);
+    TestEqual(TEXT("Pierwszy oddział zachowuje ID"), GetSquadIDOf(Planner, 0), FirstID);
+    TestEqual(TEXT("Drugi oddział zachowuje ID"), GetSquadIDOf(Planner, 3), SecondID);
+    TestEqual(TEXT("Brak podziałów"), Planner.GetLastRebuildStats().SplitCount, 0);
+    TestEqual(TEXT("Brak połączeń"), Planner.GetLastRebuildStats().MergeCount, 0);
+
+    // Druga grupa dochodzi do pierwszej - jeden oddział z ID jednej z grup
+    Planner.Rebuild(BuildInputs(300.0f), 300.0f, 12);
+    const int32 MergedID = GetSquadIDOf(Planner, 0);
+    TestEqual(TEXT("Jeden oddział po połączeniu"), Planner.GetSquads().Num(), 1);
+    TestEqual(TEXT("Połączenie wykryte"), Planner.GetLastRebuildStats().MergeCount, 1);
+    TestTrue(TEXT("Połączony oddział przejmuje istniejące ID"), MergedID == FirstID || MergedID == SecondID);
+
+    // Grupy znów się rozchodzą - jedna zachowuje ID połączonego oddziału, druga dostaje nowe
+    Planner.Rebuild(BuildInputs(2000.0f), 300.0f, 12);
+    TestEqual(TEXT("Dwa oddziały po rozpadzie"), Planner.GetSquads().Num(), 2);
+    TestEqual(TEXT("Podział wykryty"), Planner.GetLastRebuildStats().SplitCount, 1);
+    TestEqual(TEXT("Pierwsza grupa zachowuje ID połączonego oddziału"), GetSquadIDOf(Planner, 0), MergedID);
+    TestTrue(TEXT("Druga grupa dostaje nowe ID"),
+        GetSquadIDOf(Planner, 3) != MergedID && GetSquadIDOf(Planner, 3) != FirstID && GetSquadIDOf(Planner, 3) != SecondID);
+
+    // Pusta przebudowa
+    Planner.Rebuild(TArray<FSquadMemberInput>(), 300.0f, 12);
+    TestEqual(TEXT("Brak jednostek - brak oddziałów"), Planner.GetSquads().Num(), 0);
+
+    return true;
+}
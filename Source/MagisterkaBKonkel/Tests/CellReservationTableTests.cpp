@@ -0,0 +1,177 @@
+// CellReservationTableTests.cpp - Testy automatyczne dla tablicy rezerwacji komórek
+#include "Misc/AutomationTest.h"
+#include "CellReservationTable.h"
+#include "Async/ParallelFor.h"
+#include "Tests/AutomationCommon.h"
+
+// Test 1: Rozstrzyganie konfliktów - priorytet, ID, komórki zajęte i nowy tick
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCellReservationTableClaimTest,
+    "Game.CellReservationTable.Claim",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCellReservationTableClaimTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FCellReservationTable Table;
+    Table.Initialize(10, 10);
+    const FGridCell Cell(3, 4);
+    const FGridCell OccupiedCell(5, 5);
+    Table.MarkOccupied(OccupiedCell);
+
+    // Act & Assert - słabsze zgłoszenie przejęte przez silniejsze
+    TestTrue(TEXT("Pierwsze zgłoszenie prowadzi"), Table.TryClaim(Cell, 7, 100));
+    TestTrue(TEXT("Wyższy priorytet przejmuje komórkę"), Table.TryClaim(Cell, 9, 200));
+    TestFalse(TEXT("Niższy priorytet odrzucony"), Table.TryClaim(Cell, 2, 150));
+    TestTrue(TEXT("Przy równym priorytecie wygrywa niższe ID"), Table.TryClaim(Cell, 4, 200));
+    TestFalse(TEXT("Przy równym priorytecie wyższe ID odrzucone"), Table.TryClaim(Cell, 5, 200));
+    TestTrue(TEXT("Komórka należy do zwycięzcy"), Table.IsClaimedBy(Cell, 4));
+    TestFalse(TEXT("Komórka nie należy do przegranego"), Table.IsClaimedBy(Cell, 9));
+
+    // Komórka zajęta przez stojącą jednostkę
+    TestTrue(TEXT("Komórka oznaczona jako zajęta"), Table.IsOccupied(OccupiedCell));
+    TestFalse(TEXT("Zgłoszenie do zajętej komórki odrzucone"), Table.TryClaim(OccupiedCell, 1, FCellReservationTable::MaxMovePriority));
+    TestTrue(TEXT("Wejście do komórki celu dozwolone"), Table.TryClaim(OccupiedCell, 3, 10, true));
+    TestFalse(TEXT("Drugi atakujący z niższym priorytetem odrzucony"), Table.TryClaim(OccupiedCell, 6, 5, true));
+    TestTrue(TEXT("Komórka celu pozostaje zajęta"), Table.IsOccupied(OccupiedCell));
+
+    TestFalse(TEXT("Komórka poza siatką odrzucona"), Table.TryClaim(FGridCell(10, 0), 1, 1));
+    TestFalse(TEXT("ID spoza zakresu odrzucone"), Table.TryClaim(Cell, FCellReservationTable::MaxClaimantID + 1, 1));
+
+    // Nowy tick unieważnia wszystkie wpisy
+    Table.BeginTick();
+    TestFalse(TEXT("Rezerwacja wygasa z tickiem"), Table.IsClaimedBy(Cell, 4));
+    TestFalse(TEXT("Zajętość wygasa z tickiem"), Table.IsOccupied(OccupiedCell));
+    TestTrue(TEXT("Słabe zgłoszenie w nowym ticku prowadzi"), Table.TryClaim(Cell, 8, 0));
+
+    return true;
+}
+
+// Test 2: Zgłoszenia z wielu wątków - dokładnie jeden zwycięzca na komórkę i jest nim najsilniejsze zgłoszenie
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCellReservationTableParallelTest,
+    "Game.CellReservationTable.Parallel",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCellReservationTableParallelTest::RunTest(const FString& Parameters)
+{
+    // Arrange - 4000 zgłaszających walczy o 16 komórek
+    const int32 ClaimantCount = 4000;
+    const int32 CellCount = 16;
+    FCellReservationTable Table;
+    Table.Initialize(4, 4);
+
+    auto GetClaimCell = [](int32 ClaimantID) { return FGridCell(ClaimantID % 4, (ClaimantID / 4) % 4); };
+    auto GetClaimPriority = [](int32 ClaimantID) { return static_cast<uint32>((ClaimantID * 7919) % 1000); };
+
+    // Act
+    ParallelFor(ClaimantCount, [&](int32 ClaimantID)
+    {
+        Table.TryClaim(GetClaimCell(ClaimantID), ClaimantID, GetClaimPriority(ClaimantID));
+    });
+
+    // Assert - oczekiwany zwycięzca liczony sekwencyjnie
+    TArray<int32> ExpectedWinners;
+    ExpectedWinners.Init(INDEX_NONE, CellCount);
+    for (int32 ClaimantID = 0; ClaimantID < ClaimantCount; ClaimantID++)
+    {
+        const FGridCell Cell = GetClaimCell(ClaimantID);
+        int32& Winner = ExpectedWinners[Cell.ToIndex(4)];
+        if (Winner == INDEX_NONE || GetClaimPriority(ClaimantID) > GetClaimPriority(Winner))
+        {
+            Winner = ClaimantID;
+        }
+    }
+
+    TArray<int32> WinnersPerCell;
+    WinnersPerCell.Init(0, CellCount);
+    for (int32 ClaimantID = 0; ClaimantID < ClaimantCount; ClaimantID++)
+    {
+        const FGridCell Cell = GetClaimCell(ClaimantID);
+        if (Table.IsClaimedBy(Cell, ClaimantID))
+        {
+            WinnersPerCell[Cell.ToIndex(4)]++;
+            TestEqual(TEXT("Zwycięża najsilniejsze zgłoszenie"), ClaimantID, ExpectedWinners[Cell.ToIndex(4)]);
+        }
+    }
+
+    for (int32 CellIndex = 0; CellIndex < CellCount; CellIndex++)
+    {
+        TestEqual(TEXT("Dokładnie jeden zwycięzca na komórkę"), WinnersPerCell[CellIndex], 1);
+    }
+
+    return true;
+}
+
+// Test 3: Rozstrzygnięcie w kolejności zależności - kolumna rusza od czoła, zamiana miejsc i stojąca jednostka blokują
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCellReservationTableDependencyOrderTest,
+    "Game.CellReservationTable.DependencyOrder",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCellReservationTableDependencyOrderTest::RunTest(const FString& Parameters)
+{
+    // Arrange - kolumna (0,0) -> (1,0) -> (2,0) -> wolna (3,0), zgłoszona od końca
+    FCellReservationTable Table;
+    Table.Initialize(10, 10);
+
+    auto MakeClaim = [](const FGridCell& FromCell, const FGridCell& Cell, uint32 Priority, bool bCanEnterOccupied = false)
+    {
+        FCellMoveClaim Claim;
+        Claim.FromCell = FromCell;
+        Claim.Cell = Cell;
+        Claim.Priority = Priority;
+        Claim.bCanEnterOccupied = bCanEnterOccupied;
+        return Claim;
+    };
+
+    TArray<FCellMoveClaim> Claims;
+    Claims.Add(MakeClaim(FGridCell(0, 0), FGridCell(1, 0), 10));     // 0 - ostatni w kolumnie
+    Claims.Add(MakeClaim(FGridCell(1, 0), FGridCell(2, 0), 20));     // 1 - środek kolumny
+    Claims.Add(MakeClaim(FGridCell(2, 0), FGridCell(3, 0), 30));     // 2 - czoło kolumny
+    Claims.Add(MakeClaim(FGridCell(5, 5), FGridCell(6, 5), 10));     // 3 - zamiana miejsc z 4
+    Claims.Add(MakeClaim(FGridCell(6, 5), FGridCell(5, 5), 10));     // 4 - zamiana miejsc z 3
+    Claims.Add(MakeClaim(FGridCell(0, 8), FGridCell(1, 8), 10));     // 5 - do komórki stojącej jednostki
+    Claims.Add(MakeClaim(FGridCell(3, 8), FGridCell(1, 8), 5, true)); // 6 - słabsze wejście do komórki celu
+    Claims.Add(MakeClaim(FGridCell(8, 0), FGridCell(8, 1), 10, true)); // 7 - wejście do komórki celu
+    Claims.Add(MakeClaim(FGridCell(9, 9), FGridCell(3, 0), 5));      // 8 - przegrywa komórkę z czołem kolumny
+
+    const TArray<FGridCell> OccupiedCells = {
+        FGridCell(0, 0), FGridCell(1, 0), FGridCell(2, 0), FGridCell(5, 5), FGridCell(6, 5),
+        FGridCell(0, 8), FGridCell(1, 8), FGridCell(3, 8), FGridCell(8, 0), FGridCell(8, 1), FGridCell(9, 9) };
+
+    // Act
+    Table.ClaimAll(Claims);
+
+    TArray<int32> MoveOrder;
+    TBitArray<> Resolved;
+    Table.ResolveClaims(Claims, OccupiedCells, [&MoveOrder](int32 ClaimIndex)
+        {
+            MoveOrder.Add(ClaimIndex);
+            return true;
+        },
+        Resolved);
+
+    // Act - czoło kolumny jednak stoi, więc dalsze szeregi czekają
+    Table.BeginTick();
+    TArray<FCellMoveClaim> StuckClaims = { Claims[0], Claims[1], Claims[2] };
+    Table.ClaimAll(StuckClaims, false);
+
+    TArray<int32> StuckOrder;
+    TBitArray<> StuckResolved;
+    Table.ResolveClaims(StuckClaims, OccupiedCells, [&StuckOrder](int32 ClaimIndex)
+        {
+            StuckOrder.Add(ClaimIndex);
+            return ClaimIndex != 2;
+        },
+        StuckResolved);
+
+    // Assert - kolumna rusza od czoła w jednym ticku
+    TestTrue(TEXT("Kolejność ruchów: czoło, wejście do celu, środek, koniec kolumny"), MoveOrder == TArray<int32>({ 2, 7, 1, 0 }));
+    TestFalse(TEXT("Zamiana miejsc nie jest wykonywana (3)"), Resolved[3]);
+    TestFalse(TEXT("Zamiana miejsc nie jest wykonywana (4)"), Resolved[4]);
+    TestFalse(TEXT("Wejście do komórki stojącej jednostki odrzucone"), Resolved[5]);
+    TestFalse(TEXT("Słabsze zgłoszenie do komórki celu przegrywa z silniejszym"), Resolved[6]);
+    TestFalse(TEXT("Słabsze zgłoszenie do wolnej komórki przegrywa"), Resolved[8]);
+    TestTrue(TEXT("Gdy czoło stoi, wykonywana jest tylko jego próba ruchu"), StuckOrder == TArray<int32>({ 2 }));
+    TestFalse(TEXT("Środek kolumny czeka na czoło"), StuckResolved[1]);
+
+    return true;
+}
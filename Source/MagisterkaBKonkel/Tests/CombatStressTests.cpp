@@ -0,0 +1,202 @@
+// CombatStressTests.cpp - Testy automatyczne trybu obciążeniowego walki
+#include "Misc/AutomationTest.h"
+#include "CombatStressTest.h"
+#include "UnitManager.h"
+#include "TestWorld.h"
+#include "Tests/AutomationCommon.h"
+
+// Test 1: Każdy szyk daje zadaną liczbę jednostek, a armie stoją po przeciwnych stronach frontu
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatStressFormationTest,
+    "Game.CombatStress.Formations",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatStressFormationTest::RunTest(const FString& Parameters)
+{
+    const EStressFormation Formations[] = { EStressFormation::Block, EStressFormation::Line, EStressFormation::Wedge, EStressFormation::Scattered };
+
+    for (EStressFormation Formation : Formations)
+    {
+        // Arrange
+        FCombatStressConfig Config;
+        Config.UnitsPerSide = 1234;
+        Config.Formation = Formation;
+        Config.FrontGap = 500.0f;
+
+        // Act
+        TArray<FVector2D> Player0Positions;
+        TArray<FVector2D> Player1Positions;
+        FCombatStressFormation::Generate(Config, 0, Player0Positions);
+        FCombatStressFormation::Generate(Config, 1, Player1Positions);
+
+        // Assert
+        const FString FormationName = StaticEnum<EStressFormation>()->GetNameStringByValue(static_cast<int64>(Formation));
+        TestEqual(FString::Printf(TEXT("%s: liczba jednostek gracza 0"), *FormationName), Player0Positions.Num(), 1234);
+        TestEqual(FString::Printf(TEXT("%s: liczba jednostek gracza 1"), *FormationName), Player1Positions.Num(), 1234);
+
+        float Player0MaxY = -BIG_NUMBER;
+        for (const FVector2D& Position : Player0Positions)
+        {
+            Player0MaxY = FMath::Max(Player0MaxY, Position.Y);
+        }
+        float Player1MinY = BIG_NUMBER;
+        for (const FVector2D& Position : Player1Positions)
+        {
+            Player1MinY = FMath::Min(Player1MinY, Position.Y);
+        }
+        TestTrue(FString::Printf(TEXT("%s: armie rozdzielone frontem"), *FormationName), Player0MaxY <= -250.0f && Player1MinY >= 250.0f);
+
+        const FBox2D Bounds = FCombatStressFormation::ComputeBoardBounds(Player0Positions, Player1Positions, 100.0f);
+        TestTrue(FString::Printf(TEXT("%s: plansza obejmuje obie armie"), *FormationName),
+            Bounds.IsInside(Player0Positions[0]) && Bounds.IsInside(Player1Positions.Last()));
+    }
+
+    return true;
+}
+
+// Test 2: Percentyle czasu klatki
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatStressPercentileTest,
+    "Game.CombatStress.Percentiles",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatStressPercentileTest::RunTest(const FString& Parameters)
+{
+    // Arrange - próbki 1..100 ms w odwrotnej kolejności
+    FCombatStressTickRecorder Recorder;
+    Recorder.Reset(100);
+    for (int32 i = 100; i >= 1; i--)
+    {
+        Recorder.AddSample(static_cast<float>(i));
+    }
+
+    // Act
+    FCombatStressReport Report;
+    Recorder.Summarize(Report);
+
+    // Assert
+    TestEqual(TEXT("Liczba próbek"), Report.TickSamples, 100);
+    TestEqual(TEXT("Średnia"), Report.MeanTickMs, 50.5f);
+    TestEqual(TEXT("Mediana"), Report.P50TickMs, 50.0f);
+    TestEqual(TEXT("Percentyl 90"), Report.P90TickMs, 90.0f);
+    TestEqual(TEXT("Percentyl 99"), Report.P99TickMs, 99.0f);
+    TestEqual(TEXT("Maksimum"), Report.MaxTickMs, 100.0f);
+
+    return true;
+}
+
+// Test 3: Pełny potok walki na aktorach - 1000 jednostek na stronę bez prezentacji
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatStressActorPipelineTest,
+    "Game.CombatStress.ActorPipeline",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::StressFilter)
+
+bool FCombatStressActorPipelineTest::RunTest(const FString& Parameters)
+{
+    // Arrange - osobny świat gry z samym managerem jednostek
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    if (!UnitManager)
+    {
+        AddError(TEXT("Nie udało się utworzyć UnitManagera"));
+        return false;
+    }
+
+    FCombatStressConfig Config;
+    Config.UnitsPerSide = 1000;
+    Config.Formation = EStressFormation::Block;
+    Config.DurationSeconds = 3.0f;
+
+    // Act
+    const bool bStarted = UnitManager->StartCombatStressTest(Config);
+
+    const float TickSeconds = 1.0f / 30.0f;
+    const int32 MaxTicks = FMath::CeilToInt(Config.DurationSeconds / TickSeconds) + 30;
+    for (int32 i = 0; i < MaxTicks && UnitManager->IsCombatStressTestActive(); i++)
+    {
+        World->Tick(LEVELTICK_All, TickSeconds);
+    }
+
+    const bool bFinished = !UnitManager->IsCombatStressTestActive();
+    const FCombatStressReport Report = UnitManager->GetLastStressReport();
+
+    // Assert
+    TestTrue(TEXT("Test obciążeniowy powinien wystartować"), bStarted);
+    TestTrue(TEXT("Test obciążeniowy powinien zakończyć się w zadanym czasie"), bFinished);
+    TestEqual(TEXT("Liczba jednostek"), Report.UnitCount, 2000);
+    TestTrue(TEXT("Raport powinien zawierać próbki czasu klatki"), Report.TickSamples > 0);
+    TestTrue(TEXT("Percentyle uporządkowane"), Report.P50TickMs <= Report.P99TickMs && Report.P99TickMs <= Report.MaxTickMs);
+    TestTrue(TEXT("Rozmiar obiektu jednostki znany"), Report.ActorObjectBytes > 0);
+
+    AddInfo(Report.ToString());
+
+    return true;
+}
+
+// Test 4: Plansza AGridManagera jest powiększana na czas testu obciążeniowego i przywracana po nim razem z przeszkodami
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatStressGridResizeTest,
+    "Game.CombatStress.GridResize",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatStressGridResizeTest::RunTest(const FString& Parameters)
+{
+    // Arrange - plansza gry z jedną przeszkodą
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AGridManager* GridManager = World->SpawnActor<AGridManager>();
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    if (!GridManager || !UnitManager)
+    {
+        AddError(TEXT("Nie udało się utworzyć aktorów testu"));
+        return false;
+    }
+
+    const int32 GameWidth = GridManager->GridWidth;
+    const int32 GameHeight = GridManager->GridHeight;
+    const FVector GameOrigin = GridManager->GetGridOrigin();
+    GridManager->SetCellBlocked(FVector2D(5.0f, 5.0f), true);
+
+    FCombatStressConfig Config;
+    Config.UnitsPerSide = 200;
+    Config.Formation = EStressFormation::Block;
+    Config.DurationSeconds = 1.0f;
+
+    TArray<FVector2D> Player0Positions;
+    TArray<FVector2D> Player1Positions;
+    FCombatStressFormation::Generate(Config, 0, Player0Positions);
+    FCombatStressFormation::Generate(Config, 1, Player1Positions);
+
+    // Act
+    const bool bStarted = UnitManager->StartCombatStressTest(Config);
+
+    const int32 StressWidth = GridManager->GridWidth;
+    const int32 StressHeight = GridManager->GridHeight;
+    const int32 StressNavigationWidth = GridManager->GetNavigationLayer().GetWidth();
+    int32 UnitsOffGrid = 0;
+    for (const TArray<FVector2D>* Positions : { &Player0Positions, &Player1Positions })
+    {
+        for (const FVector2D& Position : *Positions)
+        {
+            if (!GridManager->IsValidCell(GridManager->GetCellFromWorld(FVector(Position.X, Position.Y, 0.0f))))
+            {
+                UnitsOffGrid++;
+            }
+        }
+    }
+
+    UnitManager->FinishCombatStressTest();
+
+    // Assert
+    TestTrue(TEXT("Test obciążeniowy powinien wystartować"), bStarted);
+    TestTrue(TEXT("Plansza testu powinna być większa od planszy gry"), StressWidth * StressHeight > GameWidth * GameHeight);
+    TestEqual(TEXT("Warstwa nawigacji powinna mieć wymiary planszy testu"), StressNavigationWidth, StressWidth);
+    TestEqual(TEXT("Wszystkie pozycje armii powinny leżeć na planszy testu"), UnitsOffGrid, 0);
+
+    TestEqual(TEXT("Przywrócona szerokość planszy"), GridManager->GridWidth, GameWidth);
+    TestEqual(TEXT("Przywrócona wysokość planszy"), GridManager->GridHeight, GameHeight);
+    TestTrue(TEXT("Przywrócony początek planszy"), GridManager->GetGridOrigin().Equals(GameOrigin, 0.1f));
+    TestEqual(TEXT("Warstwa nawigacji z wymiarami planszy gry"), GridManager->GetNavigationLayer().GetWidth(), GameWidth);
+    TestFalse(TEXT("Przeszkoda planszy gry powinna zostać przywrócona"), GridManager->IsCellWalkable(FVector2D(5.0f, 5.0f)));
+
+    return true;
+}
@@ -0,0 +1,87 @@
+// CombatTimingWheelTests.cpp - Testy automatyczne dla koła czasowego timerów walki
+#include "Misc/AutomationTest.h"
+#include "CombatTimingWheel.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja tworząca wpis timera
+static FCombatTimerEntry MakeTimerEntry(int32 UnitSlot, ECombatTimerAction Action, uint32 DeadlineTick)
+{
+    FCombatTimerEntry Entry;
+    Entry.UnitSlot = UnitSlot;
+    Entry.Action = Action;
+    Entry.DeadlineTick = DeadlineTick;
+    return Entry;
+}
+
+// Test 1: Wpisy są zwracane dokładnie w ticku terminu
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTimingWheelDeadlineTest,
+    "Game.CombatTimingWheel.Deadline",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatTimingWheelDeadlineTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FCombatTimingWheel Wheel;
+    Wheel.Reset(100);
+    Wheel.Schedule(MakeTimerEntry(0, ECombatTimerAction::AttackReset, 110));
+    Wheel.Schedule(MakeTimerEntry(1, ECombatTimerAction::HideHealthBar, 160));
+    TArray<FCombatTimerEntry> Due;
+
+    // Act & Assert - przed terminem nic nie jest wymagalne
+    Wheel.Advance(109, Due);
+    TestEqual(TEXT("Przed tickiem 110 brak wymagalnych wpisów"), Due.Num(), 0);
+    TestEqual(TEXT("W kole powinny być 2 wpisy"), Wheel.Num(), 2);
+
+    Wheel.Advance(110, Due);
+    TestEqual(TEXT("W ticku 110 wymagalny jest jeden wpis"), Due.Num(), 1);
+    TestEqual(TEXT("Wymagalny wpis dotyczy slotu 0"), Due[0].UnitSlot, 0);
+
+    // Przeskok o wiele ticków naraz
+    Due.Reset();
+    Wheel.Advance(500, Due);
+    TestEqual(TEXT("Drugi wpis zwrócony po przeskoku"), Due.Num(), 1);
+    TestEqual(TEXT("Koło powinno być puste"), Wheel.Num(), 0);
+
+    return true;
+}
+
+// Test 2: Kaskadowanie z wyższych poziomów zachowuje kolejność terminów
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatTimingWheelCascadeTest,
+    "Game.CombatTimingWheel.Cascade",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FCombatTimingWheelCascadeTest::RunTest(const FString& Parameters)
+{
+    // Arrange - terminy na wszystkich trzech poziomach (64, 64^2, 64^3 ticków)
+    FCombatTimingWheel Wheel;
+    Wheel.Reset(7);
+    const uint32 Deadlines[] = { 20000, 63, 4100, 70, 200000, 8 };
+    for (int32 i = 0; i < UE_ARRAY_COUNT(Deadlines); i++)
+    {
+        Wheel.Schedule(MakeTimerEntry(i, ECombatTimerAction::AttackReady, Deadlines[i]));
+    }
+
+    // Act - przesuwanie tick po ticku i zapamiętanie ticka wykonania
+    TMap<int32, uint32> FiredAt;
+    TArray<FCombatTimerEntry> Due;
+    for (uint32 Tick = 8; Tick <= 200000; Tick++)
+    {
+        Due.Reset();
+        Wheel.Advance(Tick, Due);
+        for (const FCombatTimerEntry& Entry : Due)
+        {
+            FiredAt.Add(Entry.UnitSlot, Tick);
+        }
+    }
+
+    // Assert
+    TestEqual(TEXT("Wszystkie wpisy powinny zostać wykonane"), FiredAt.Num(), (int32)UE_ARRAY_COUNT(Deadlines));
+    for (int32 i = 0; i < UE_ARRAY_COUNT(Deadlines); i++)
+    {
+        const uint32* Tick = FiredAt.Find(i);
+        TestTrue(FString::Printf(TEXT("Wpis %d wykonany w ticku terminu %u"), i, Deadlines[i]),
+            Tick && *Tick == Deadlines[i]);
+    }
+
+    return true;
+}
@@ -1,6 +1,7 @@
 // GameUITests.cpp - Testy automatyczne dla interfejsu użytkownika
 #include "Misc/AutomationTest.h"
 #include "GameUI.h"
+#include "UnitArchetype.h"
 #include "Tests/AutomationCommon.h"
 
 // Test 1: Zarządzanie stanem sklepu
@@ -259,4 +260,33 @@ bool FGameUIPurchaseRequestTest::RunTest(const FString& Parameters)
     TestNotNull(TEXT("UI powinno pozostać prawidłowe po requestach zakupu"), UI);
 
     return true;
-}
\ No newline at end of file
+}
+
+// Test 6: Dane sklepu z archetypu jednostki
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameUIShopDataFromArchetypeTest, 
+    "Game.UI.ShopDataFromArchetype", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGameUIShopDataFromArchetypeTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    UUnitArchetype* Archetype = NewObject<UUnitArchetype>();
+    Archetype->UnitType = EBaseUnitType::Sword;
+    Archetype->DisplayName = TEXT("Rycerz");
+    Archetype->Cost = 90;
+
+    // Act
+    FUnitShopData FromArchetype = FUnitShopData::FromArchetype(2, Archetype);
+    FUnitShopData WithoutArchetype = FUnitShopData::FromArchetype(1, nullptr);
+
+    // Assert - dane z archetypu
+    TestEqual(TEXT("Nazwa powinna pochodzić z archetypu"), FromArchetype.UnitName, FString(TEXT("Rycerz")));
+    TestEqual(TEXT("Koszt powinien pochodzić z archetypu"), FromArchetype.UnitCost, 90);
+    TestEqual(TEXT("Typ jednostki powinien być zachowany"), FromArchetype.UnitType, 2);
+
+    // Assert - bez archetypu domyślna tabela kosztów
+    TestEqual(TEXT("Domyślna nazwa typu 1"), WithoutArchetype.UnitName, FString(TEXT("Ninja")));
+    TestEqual(TEXT("Domyślny koszt typu 1"), WithoutArchetype.UnitCost, UUnitArchetype::GetFallbackCost(1));
+
+    return true;
+}
@@ -0,0 +1,96 @@
+// GridCellTests.cpp - Testy automatyczne dla całkowitoliczbowych współrzędnych komórek planszy
+#include "Misc/AutomationTest.h"
+#include "GridCell.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/BitReader.h"
+#include "Tests/AutomationCommon.h"
+
+// Test 1: Klucz 32-bitowy, hashowanie w TSet/TMap i indeks płaskiej tablicy
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridCellKeyTest,
+    "Game.GridCell.Key",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGridCellKeyTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    const TArray<FGridCell> Cells = { FGridCell(0, 0), FGridCell(5, 3), FGridCell(3, 5), FGridCell(-1, 0), FGridCell(0, -1), FGridCell(-300, 1200) };
+
+    // Act & Assert - klucz odtwarza komórkę, także dla ujemnych współrzędnych
+    TSet<uint32> Keys;
+    for (const FGridCell& Cell : Cells)
+    {
+        TestTrue(*FString::Printf(TEXT("Klucz komórki %s powinien odtwarzać komórkę"), *Cell.ToString()), FGridCell::FromKey(Cell.GetKey()) == Cell);
+        Keys.Add(Cell.GetKey());
+    }
+    TestEqual(TEXT("Różne komórki powinny mieć różne klucze"), Keys.Num(), Cells.Num());
+
+    // Act - komórki jako klucze TMap
+    TMap<FGridCell, int32> CellValues;
+    for (int32 i = 0; i < Cells.Num(); i++)
+    {
+        CellValues.Add(Cells[i], i);
+    }
+    CellValues.Add(FGridCell(5, 3), 100);
+
+    // Assert
+    TestEqual(TEXT("Ponowne dodanie tej samej komórki nie powinno tworzyć nowego wpisu"), CellValues.Num(), Cells.Num());
+    TestEqual(TEXT("Wartość komórki (5, 3) powinna zostać nadpisana"), CellValues.FindRef(FGridCell(5, 3)), 100);
+    TestEqual(TEXT("Komórka (3, 5) nie powinna kolidować z (5, 3)"), CellValues.FindRef(FGridCell(3, 5)), 2);
+
+    // Assert - indeks płaskiej tablicy i granice planszy
+    const int32 Width = 10;
+    const FGridCell Cell(7, 4);
+    TestEqual(TEXT("Indeks komórki (7, 4) na planszy 10 szerokości"), Cell.ToIndex(Width), 47);
+    TestTrue(TEXT("Komórka z indeksu powinna odpowiadać oryginałowi"), FGridCell::FromIndex(Cell.ToIndex(Width), Width) == Cell);
+    TestTrue(TEXT("Komórka (7, 4) powinna być na planszy 10x5"), Cell.IsInside(Width, 5));
+    TestFalse(TEXT("Komórka (7, 4) nie powinna być na planszy 10x4"), Cell.IsInside(Width, 4));
+    TestFalse(TEXT("Komórka o ujemnej współrzędnej nie powinna być na planszy"), FGridCell(-1, 0).IsInside(Width, 5));
+
+    // Assert - zaokrąglenie pozycji FVector2D z Blueprintów
+    TestTrue(TEXT("Pozycja (2.6, 3.4) powinna dać komórkę (3, 3)"), FGridCell::FromGridPosition(FVector2D(2.6f, 3.4f)) == FGridCell(3, 3));
+    TestTrue(TEXT("Komórka powinna wracać do tej samej pozycji FVector2D"), FGridCell(4, 9).ToGridPosition() == FVector2D(4.0f, 9.0f));
+
+    return true;
+}
+
+// Test 2: Serializacja sieciowa - zgodność po odczycie i rozmiar mniejszy niż FVector2D
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridCellNetSerializeTest,
+    "Game.GridCell.NetSerialize",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGridCellNetSerializeTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    const TArray<FGridCell> Cells = { FGridCell(0, 0), FGridCell(7, 15), FGridCell(-3, 2), FGridCell(63, 63), FGridCell(1000, -2000) };
+
+    for (const FGridCell& Cell : Cells)
+    {
+        // Act
+        FBitWriter Writer(0, true);
+        FGridCell Source = Cell;
+        bool bWriteSuccess = false;
+        Source.NetSerialize(Writer, nullptr, bWriteSuccess);
+
+        FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+        FGridCell Loaded(-99, -99);
+        bool bReadSuccess = false;
+        Loaded.NetSerialize(Reader, nullptr, bReadSuccess);
+
+        // Assert
+        TestTrue(*FString::Printf(TEXT("Zapis komórki %s powinien się udać"), *Cell.ToString()), bWriteSuccess);
+        TestTrue(*FString::Printf(TEXT("Odczyt komórki %s powinien się udać"), *Cell.ToString()), bReadSuccess);
+        TestTrue(*FString::Printf(TEXT("Odczytana komórka powinna być równa %s"), *Cell.ToString()), Loaded == Cell);
+    }
+
+    // Act - komórka planszy gry (do 64x64) zajmuje po jednym bajcie na współrzędną
+    FBitWriter SmallWriter(0, true);
+    FGridCell SmallCell(12, 40);
+    bool bSuccess = false;
+    SmallCell.NetSerialize(SmallWriter, nullptr, bSuccess);
+
+    // Assert
+    TestTrue(TEXT("Komórka (12, 40) powinna zająć najwyżej 2 bajty"), SmallWriter.GetNumBytes() <= 2);
+    TestTrue(TEXT("Komórka powinna zająć mniej niż FVector2D (16 bajtów)"), SmallWriter.GetNumBytes() < static_cast<int64>(sizeof(FVector2D)));
+
+    return true;
+}
@@ -0,0 +1,279 @@
+// GridNavigationLayerTests.cpp - Testy automatyczne dla warstwy nawigacji planszy
+#include "Misc/AutomationTest.h"
+#include "GridNavigationLayer.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja licząca prześwit komórki wprost - odległość Chebysheva do przeszkody lub krawędzi planszy
+static uint8 ComputeClearanceBruteForce(const FGridNavigationLayer& Layer, const FGridCell& Cell)
+{
+    if (Layer.IsCellBlocked(Cell))
+    {
+        return 0;
+    }
+
+    const int32 Width = Layer.GetWidth();
+    const int32 Height = Layer.GetHeight();
+    int32 Distance = FMath::Min(FMath::Min(Cell.X + 1, Cell.Y + 1), FMath::Min(Width - Cell.X, Height - Cell.Y));
+
+    for (int32 Y = 0; Y < Height; Y++)
+    {
+        for (int32 X = 0; X < Width; X++)
+        {
+            if (Layer.IsCellBlocked(FGridCell(X, Y)))
+            {
+                Distance = FMath::Min(Distance, FMath::Max(FMath::Abs(X - Cell.X), FMath::Abs(Y - Cell.Y)));
+            }
+        }
+    }
+
+    return static_cast<uint8>(FMath::Min<int32>(Distance, FGridNavigationLayer::MaxClearance));
+}
+
+// Pomocnicza funkcja licząca komórki z prześwitem różnym od liczonego wprost
+static int32 CountClearanceMismatches(const FGridNavigationLayer& Layer)
+{
+    int32 Mismatches = 0;
+    for (int32 Y = 0; Y < Layer.GetHeight(); Y++)
+    {
+        for (int32 X = 0; X < Layer.GetWidth(); X++)
+        {
+            if (Layer.GetClearance(FGridCell(X, Y)) != ComputeClearanceBruteForce(Layer, FGridCell(X, Y)))
+            {
+                Mismatches++;
+            }
+        }
+    }
+    return Mismatches;
+}
+
+// Test 1: Prześwit po inicjalizacji i po każdej przyrostowej zmianie zgadza się z liczonym wprost
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridNavigationLayerClearanceTest,
+    "Game.GridNavigationLayer.Clearance",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGridNavigationLayerClearanceTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FGridNavigationLayer Layer;
+    Layer.Initialize(40, 40);
+
+    // Assert - pusta plansza: prześwit rośnie od krawędzi
+    TestEqual(TEXT("Komórka narożna"), Layer.GetClearance(FGridCell(0, 0)), static_cast<uint8>(1));
+    TestEqual(TEXT("Komórka w głębi planszy"), Layer.GetClearance(FGridCell(5, 7)), static_cast<uint8>(6));
+    TestEqual(TEXT("Prześwit przycięty do MaxClearance"), Layer.GetClearance(FGridCell(20, 20)), FGridNavigationLayer::MaxClearance);
+    TestEqual(TEXT("Poza planszą brak prześwitu"), Layer.GetClearance(FGridCell(-1, 3)), static_cast<uint8>(0));
+    TestEqual(TEXT("Pusta plansza zgodna z liczeniem wprost"), CountClearanceMismatches(Layer), 0);
+
+    // Act - przeszkoda na środku, a potem losowe zmiany pojedynczych komórek
+    Layer.SetCellBlocked(FGridCell(20, 20), true);
+    const bool bUpdated = Layer.UpdateClearance();
+    const bool bUpdatedAgain = Layer.UpdateClearance();
+
+    // Assert
+    TestTrue(TEXT("Zmiana blokady wymaga przeliczenia"), bUpdated);
+    TestFalse(TEXT("Bez zmian brak przeliczenia"), bUpdatedAgain);
+    TestEqual(TEXT("Zablokowana komórka"), Layer.GetClearance(FGridCell(20, 20)), static_cast<uint8>(0));
+    TestEqual(TEXT("Sąsiad przeszkody"), Layer.GetClearance(FGridCell(21, 21)), static_cast<uint8>(1));
+    TestTrue(TEXT("Jednostka o promieniu 2 komórek mieści się 3 komórki od przeszkody"), Layer.HasClearance(FGridCell(23, 20), 2));
+    TestFalse(TEXT("Jednostka o promieniu 2 komórek nie mieści się obok przeszkody"), Layer.HasClearance(FGridCell(22, 20), 2));
+
+    FRandomStream Random(4848);
+    int32 IncrementalMismatches = 0;
+    for (int32 Step = 0; Step < 40; Step++)
+    {
+        const FGridCell Cell(Random.RandRange(0, 39), Random.RandRange(0, 39));
+        Layer.SetCellBlocked(Cell, !Layer.IsCellBlocked(Cell));
+
+        // Co drugi krok dwie zmiany w jednej partii
+        if (Step % 2 == 0)
+        {
+            const FGridCell SecondCell(Random.RandRange(0, 39), Random.RandRange(0, 39));
+            Layer.SetCellBlocked(SecondCell, !Layer.IsCellBlocked(SecondCell));
+        }
+
+        Layer.UpdateClearance();
+        IncrementalMismatches += CountClearanceMismatches(Layer);
+    }
+
+    TestEqual(TEXT("Przyrostowe przeliczenia zgodne z liczeniem wprost"), IncrementalMismatches, 0);
+
+    return true;
+}
+
+// Test 2: Flagi, koszty ruchu i rewizja warstwy
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridNavigationLayerFlagsTest,
+    "Game.GridNavigationLayer.Flags",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGridNavigationLayerFlagsTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FGridNavigationLayer Layer;
+    Layer.Initialize(10, 10);
+    const uint32 InitialRevision = Layer.GetRevision();
+
+    // Act
+    Layer.SetCellFlags(FGridCell(2, 2), ENavCellFlags::NoPlacement);
+    Layer.SetCellBlocked(FGridCell(3, 3), true);
+    Layer.SetCellMoveCost(FGridCell(4, 4), 5);
+    Layer.SetCellMoveCost(FGridCell(5, 5), 0);
+    const uint32 RevisionAfterChanges = Layer.GetRevision();
+
+    Layer.SetCellBlocked(FGridCell(3, 3), true);
+    Layer.SetCellMoveCost(FGridCell(4, 4), 5);
+    const bool bClearanceUpdated = Layer.UpdateClearance();
+
+    // Assert
+    TestTrue(TEXT("Komórka bez rozstawiania jest przechodnia"), !Layer.IsCellBlocked(FGridCell(2, 2)));
+    TestFalse(TEXT("W komórce bez rozstawiania nie można stawiać jednostek"), Layer.IsCellPlaceable(FGridCell(2, 2)));
+    TestFalse(TEXT("W przeszkodzie nie można stawiać jednostek"), Layer.IsCellPlaceable(FGridCell(3, 3)));
+    TestTrue(TEXT("Zwykła komórka"), Layer.IsCellPlaceable(FGridCell(6, 6)));
+    TestTrue(TEXT("Poza planszą komórka jest zablokowana"), Layer.IsCellBlocked(FGridCell(10, 0)));
+
+    TestEqual(TEXT("Koszt domyślny"), Layer.GetMoveCost(FGridCell(0, 0)), FGridNavigationLayer::DefaultMoveCost);
+    TestEqual(TEXT("Koszt terenu"), Layer.GetMoveCost(FGridCell(4, 4)), static_cast<uint8>(5));
+    TestEqual(TEXT("Koszt co najmniej 1"), Layer.GetMoveCost(FGridCell(5, 5)), static_cast<uint8>(1));
+
+    TArray<uint8> MoveCosts;
+    TArray<bool> BlockedCells;
+    Layer.GetMoveCosts(FIntRect(0, 0, 10, 10), MoveCosts);
+    Layer.GetBlockedCells(FIntRect(0, 0, 10, 10), BlockedCells);
+    TestEqual(TEXT("Płaska tablica kosztów"), MoveCosts[4 * 10 + 4], static_cast<uint8>(5));
+    TestTrue(TEXT("Płaska tablica blokad"), BlockedCells.Num() == 100 && BlockedCells[3 * 10 + 3] && !BlockedCells[2 * 10 + 2]);
+
+    // Assert - prostokąt częściowo poza planszą ma indeksy względem swojego początku
+    TArray<uint8> RegionCosts;
+    TArray<bool> RegionBlocked;
+    Layer.GetMoveCosts(FIntRect(3, 3, 12, 6), RegionCosts);
+    Layer.GetBlockedCells(FIntRect(3, 3, 12, 6), RegionBlocked);
+    TestEqual(TEXT("Rozmiar tablicy prostokąta"), RegionCosts.Num(), 9 * 3);
+    TestEqual(TEXT("Koszt terenu w prostokącie"), RegionCosts[1 * 9 + 1], static_cast<uint8>(5));
+    TestEqual(TEXT("Koszt poza planszą domyślny"), RegionCosts[2 * 9 + 8], FGridNavigationLayer::DefaultMoveCost);
+    TestTrue(TEXT("Blokada w rogu prostokąta"), RegionBlocked[0] && !RegionBlocked[1]);
+
+    TestTrue(TEXT("Zmiany podnoszą rewizję"), RevisionAfterChanges > InitialRevision);
+    TestEqual(TEXT("Powtórzone wartości nie zmieniają rewizji"), Layer.GetRevision(), RevisionAfterChanges);
+    TestTrue(TEXT("Blokada oznacza prześwit do przeliczenia"), bClearanceUpdated);
+
+    return true;
+}
+
+// Test 3: Fragmenty planszy powstają dopiero przy zapisie i są zwalniane po powrocie do wartości domyślnych
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridNavigationLayerChunksTest,
+    "Game.GridNavigationLayer.Chunks",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGridNavigationLayerChunksTest::RunTest(const FString& Parameters)
+{
+    // Arrange - duża plansza bez żadnych danych
+    FGridNavigationLayer Layer;
+    Layer.Initialize(1000, 1000);
+    const int32 ChunkSize = FGridNavigationLayer::ChunkSize;
+
+    // Assert - odczyty bez fragmentów zwracają wartości domyślne
+    TestEqual(TEXT("Pusta plansza bez fragmentów"), Layer.GetChunkCount(), 0);
+    TestTrue(TEXT("Siatka fragmentów"), Layer.GetChunkGridSize() == FGridCell(32, 32));
+    TestEqual(TEXT("Prześwit przy krawędzi bez fragmentu"), Layer.GetClearance(FGridCell(999, 500)), static_cast<uint8>(1));
+    TestEqual(TEXT("Prześwit w głębi bez fragmentu"), Layer.GetClearance(FGridCell(500, 500)), FGridNavigationLayer::MaxClearance);
+    TestTrue(TEXT("Komórka bez fragmentu jest przechodnia"), Layer.IsCellPlaceable(FGridCell(500, 500)));
+
+    // Act - przeszkoda w środku fragmentu i koszt terenu w innym fragmencie
+    const FGridCell Obstacle(10 * ChunkSize + ChunkSize / 2, 10 * ChunkSize + ChunkSize / 2);
+    Layer.SetCellBlocked(Obstacle, true);
+    Layer.UpdateClearance();
+    const int32 ChunksWithObstacle = Layer.GetChunkCount();
+
+    Layer.SetCellMoveCost(FGridCell(0, 0), 3);
+    Layer.SetCellFlags(FGridCell(999, 999), ENavCellFlags::SpawnZonePlayer2);
+
+    // Assert
+    TestEqual(TEXT("Przeszkoda z otoczeniem mieści się w jednym fragmencie"), ChunksWithObstacle, 1);
+    TestTrue(TEXT("Fragment przeszkody istnieje"), Layer.HasChunk(FGridNavigationLayer::GetChunkCoord(Obstacle)));
+    TestEqual(TEXT("Prześwit obok przeszkody"), Layer.GetClearance(Obstacle + FGridCell(3, 0)), static_cast<uint8>(3));
+    TestEqual(TEXT("Koszt i flaga tworzą własne fragmenty"), Layer.GetChunkCount(), 3);
+    TestTrue(TEXT("Flaga strefy spawnu"), EnumHasAnyFlags(Layer.GetCellFlags(FGridCell(999, 999)), ENavCellFlags::SpawnZonePlayer2));
+
+    // Act - przeszkoda na granicy fragmentów zmienia prześwit w sąsiednich fragmentach
+    const FGridCell BorderObstacle(20 * ChunkSize, 20 * ChunkSize);
+    Layer.SetCellBlocked(BorderObstacle, true);
+    Layer.UpdateClearance();
+
+    // Assert
+    TestEqual(TEXT("Prześwit po drugiej stronie granicy"), Layer.GetClearance(BorderObstacle - FGridCell(2, 2)), static_cast<uint8>(2));
+    TestEqual(TEXT("Fragmenty wokół narożnika"), Layer.GetChunkCount(), 3 + 4);
+
+    // Act - powrót do wartości domyślnych i zwolnienie fragmentów
+    Layer.SetCellBlocked(Obstacle, false);
+    Layer.SetCellBlocked(BorderObstacle, false);
+    Layer.SetCellMoveCost(FGridCell(0, 0), FGridNavigationLayer::DefaultMoveCost);
+    Layer.ClearFlags(ENavCellFlags::SpawnZonePlayer1 | ENavCellFlags::SpawnZonePlayer2);
+    Layer.UpdateClearance();
+    const int32 ReleasedChunks = Layer.ReleaseUnusedChunks();
+
+    // Assert
+    TestEqual(TEXT("Zwolnione wszystkie fragmenty"), ReleasedChunks, 7);
+    TestEqual(TEXT("Brak fragmentów po zwolnieniu"), Layer.GetChunkCount(), 0);
+    TestEqual(TEXT("Prześwit po zwolnieniu"), Layer.GetClearance(Obstacle), FGridNavigationLayer::MaxClearance);
+
+    return true;
+}
+
+// Test 4: Fragmenty zmienione od rewizji odbiorcy i współrzędne fragmentów dla ujemnych komórek
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridNavigationLayerChangedChunksTest,
+    "Game.GridNavigationLayer.ChangedChunks",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGridNavigationLayerChangedChunksTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FGridNavigationLayer Layer;
+    Layer.Initialize(1000, 1000);
+    const int32 ChunkSize = FGridNavigationLayer::ChunkSize;
+
+    // Assert - zaokrąglenie w dół po obu stronach zera
+    TestTrue(TEXT("Komórka (0, 0) we fragmencie (0, 0)"), FGridNavigationLayer::GetChunkCoord(FGridCell(0, 0)) == FGridCell(0, 0));
+    TestTrue(TEXT("Ostatnia komórka fragmentu"), FGridNavigationLayer::GetChunkCoord(FGridCell(ChunkSize - 1, ChunkSize)) == FGridCell(0, 1));
+    TestTrue(TEXT("Komórka -1 we fragmencie -1"), FGridNavigationLayer::GetChunkCoord(FGridCell(-1, -ChunkSize)) == FGridCell(-1, -1));
+    TestTrue(TEXT("Komórka -(ChunkSize + 1) we fragmencie -2"), FGridNavigationLayer::GetChunkCoord(FGridCell(-ChunkSize - 1, 5)) == FGridCell(-2, 0));
+
+    // Act - odbiorca kopiuje warstwę, potem zmieniają się dwa fragmenty
+    const uint32 CopiedRevision = Layer.GetRevision();
+    Layer.SetCellBlocked(FGridCell(5 * ChunkSize + 1, 2 * ChunkSize + 1), true);
+    Layer.SetCellMoveCost(FGridCell(30 * ChunkSize, 30 * ChunkSize), 4);
+    const uint32 RevisionAfterBlock = Layer.GetRevision();
+    Layer.UpdateClearance();
+
+    TArray<FGridCell> ChangedChunks;
+    Layer.GetChangedChunks(CopiedRevision, ChangedChunks);
+
+    // Assert - prześwit tworzy fragmenty sąsiednie, ale flagi i koszty zmieniły się tylko w dwóch
+    TestEqual(TEXT("Dwa zmienione fragmenty"), ChangedChunks.Num(), 2);
+    TestTrue(TEXT("Fragment przeszkody zmieniony"), ChangedChunks.Contains(FGridCell(5, 2)));
+    TestTrue(TEXT("Fragment kosztu zmieniony"), ChangedChunks.Contains(FGridCell(30, 30)));
+    TestTrue(TEXT("Prześwit utworzył fragmenty sąsiednie"), Layer.GetChunkCount() > 2);
+
+    Layer.GetChangedChunks(RevisionAfterBlock, ChangedChunks);
+    TestEqual(TEXT("Od rewizji po obu zmianach nic się nie zmieniło"), ChangedChunks.Num(), 0);
+
+    // Act - zdjęcie blokady i zwolnienie fragmentu nie gubi zmiany dla odbiorcy
+    Layer.SetCellBlocked(FGridCell(5 * ChunkSize + 1, 2 * ChunkSize + 1), false);
+    Layer.SetCellMoveCost(FGridCell(30 * ChunkSize, 30 * ChunkSize), FGridNavigationLayer::DefaultMoveCost);
+    Layer.UpdateClearance();
+    Layer.ReleaseUnusedChunks();
+    Layer.GetChangedChunks(RevisionAfterBlock, ChangedChunks);
+
+    // Assert
+    TestEqual(TEXT("Brak fragmentów po zwolnieniu"), Layer.GetChunkCount(), 0);
+    TestEqual(TEXT("Zwolnione fragmenty nadal zgłaszane jako zmienione"), ChangedChunks.Num(), 2);
+
+    // Act - nowa inicjalizacja wymaga pełnej kopii
+    const uint32 LayoutBefore = Layer.GetLayoutRevision();
+    Layer.Initialize(1000, 1000);
+    Layer.GetChangedChunks(0, ChangedChunks);
+
+    // Assert
+    TestTrue(TEXT("Initialize podnosi rewizję układu"), Layer.GetLayoutRevision() > LayoutBefore);
+    TestEqual(TEXT("Initialize czyści zmienione fragmenty"), ChangedChunks.Num(), 0);
+
+    return true;
+}
@@ -0,0 +1,172 @@
+// GridPathfinderTests.cpp - Testy automatyczne dla wyszukiwania ścieżek JPS i serwisu ścieżek
+#include "Misc/AutomationTest.h"
+#include "GridPathfinder.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja licząca koszt ścieżki komórka po komórce i sprawdzająca ciągłość kroków
+static int32 GetGridPathCost(const TArray<FGridCell>& Path, bool& bOutContinuous)
+{
+    int32 Cost = 0;
+    bOutContinuous = true;
+    for (int32 i = 1; i < Path.Num(); i++)
+    {
+        const FGridCell Step = Path[i] - Path[i - 1];
+        if (FMath::Abs(Step.X) > 1 || FMath::Abs(Step.Y) > 1 || Step == FGridCell())
+        {
+            bOutContinuous = false;
+        }
+        Cost += (Step.X != 0 && Step.Y != 0) ? FGridPathfinder::DiagonalCost : FGridPathfinder::OrthogonalCost;
+    }
+    return Cost;
+}
+
+// Test 1: Jedno wyszukiwanie daje optymalne ścieżki dla wielu startów i omija ścianę bez ścinania rogów
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridPathfinderFindPathsTest,
+    "Game.GridPathfinder.FindPaths",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGridPathfinderFindPathsTest::RunTest(const FString& Parameters)
+{
+    // Arrange - siatka 10x10, ściana w kolumnie X = 5 od Y = 0 do Y = 8
+    const int32 Width = 10;
+    const int32 Height = 10;
+    TArray<bool> BlockedCells;
+    BlockedCells.Init(false, Width * Height);
+    for (int32 Y = 0; Y < 9; Y++)
+    {
+        BlockedCells[Y * Width + 5] = true;
+    }
+
+    // Cel zajęty przez jednostkę (komórka celu jest zawsze przechodnia)
+    const FGridCell Goal(9, 0);
+    BlockedCells[Goal.ToIndex(Width)] = true;
+
+    TArray<FGridCell> Starts;
+    Starts.Add(FGridCell(4, 0));    // Za ścianą
+    Starts.Add(FGridCell(9, 5));    // Po tej samej stronie co cel
+    Starts.Add(FGridCell(9, 0));    // Start w komórce celu
+
+    // Act
+    TArray<TArray<FGridCell>> Paths;
+    FGridPathfinder::FindPaths(Width, Height, BlockedCells, Goal, Starts, Paths);
+
+    // Assert
+    TestEqual(TEXT("Ścieżka dla każdego startu"), Paths.Num(), 3);
+    if (Paths.Num() != 3)
+    {
+        return false;
+    }
+
+    bool bContinuous = false;
+    const int32 BehindWallCost = GetGridPathCost(Paths[0], bContinuous);
+    TestTrue(TEXT("Ścieżka zza ściany jest ciągła"), bContinuous);
+    TestEqual(TEXT("Ścieżka zza ściany zaczyna się w starcie"), Paths[0][0], Starts[0]);
+    TestEqual(TEXT("Ścieżka zza ściany kończy się w celu"), Paths[0].Last(), Goal);
+
+    // Droga (4, 0) -> (4, 9) -> (6, 9) -> (9, 0): przekątna obok rogu (5, 8) jest zabroniona
+    TestEqual(TEXT("Koszt optymalny zza ściany"), BehindWallCost, 17 * FGridPathfinder::OrthogonalCost + 3 * FGridPathfinder::DiagonalCost);
+    TestTrue(TEXT("Ścieżka przechodzi przez przejście (5, 9)"), Paths[0].Contains(FGridCell(5, 9)));
+
+    for (const FGridCell& Cell : Paths[0])
+    {
+        if (Cell != Goal && BlockedCells[Cell.ToIndex(Width)])
+        {
+            AddError(FString::Printf(TEXT("Ścieżka wchodzi w zajętą komórkę (%d, %d)"), Cell.X, Cell.Y));
+        }
+    }
+
+    TestEqual(TEXT("Koszt prostej drogi"), GetGridPathCost(Paths[1], bContinuous), 5 * FGridPathfinder::OrthogonalCost);
+    TestEqual(TEXT("Start w celu daje jedną komórkę"), Paths[2].Num(), 1);
+
+    // Cel otoczony ścianą - brak drogi
+    TArray<bool> Enclosed;
+    Enclosed.Init(false, Width * Height);
+    for (int32 Y = 0; Y < Height; Y++)
+    {
+        Enclosed[Y * Width + 5] = true;
+    }
+
+    TArray<TArray<FGridCell>> NoPaths;
+    FGridPathfinder::FindPaths(Width, Height, Enclosed, Goal, { FGridCell(0, 0) }, NoPaths);
+    TestEqual(TEXT("Brak drogi daje pustą ścieżkę"), NoPaths.Num() == 1 ? NoPaths[0].Num() : -1, 0);
+
+    return true;
+}
+
+// Test 2: Serwis - wynik w kolejnym ticku, łączenie zapytań do jednego celu, cache i epoka zajętości
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGridPathServiceTest,
+    "Game.GridPathfinder.Service",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FGridPathServiceTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FGridPathService PathService;
+    PathService.Initialize(20, 20);
+    const FGridCell Goal(15, 10);
+
+    // Act - trzy jednostki do tego samego celu i jedna do innego
+    const int32 FirstID = PathService.RequestPath(FGridCell(0, 0), Goal);
+    const int32 SecondID = PathService.RequestPath(FGridCell(0, 19), Goal);
+    const int32 ThirdID = PathService.RequestPath(FGridCell(0, 0), Goal);
+    const int32 OtherID = PathService.RequestPath(FGridCell(3, 3), FGridCell(3, 8));
+    const int32 InvalidID = PathService.RequestPath(FGridCell(-1, 0), Goal);
+
+    TArray<FGridPathResult> LaunchTickResults;
+    PathService.Tick(LaunchTickResults);
+    const bool bInFlightAfterLaunch = PathService.IsSearchInFlight();
+
+    TArray<FGridPathResult> NextTickResults;
+    PathService.Tick(NextTickResults);
+
+    // Powtórzone zapytanie przy tej samej zajętości - z cache
+    const int32 CachedID = PathService.RequestPath(FGridCell(0, 19), Goal);
+    TArray<FGridPathResult> CacheTickResults;
+    PathService.Tick(CacheTickResults);
+
+    // Zmiana zajętości podnosi epokę - to samo zapytanie wymaga nowego wyszukiwania
+    const uint32 EpochBefore = PathService.GetOccupancyEpoch();
+    PathService.SetCellBlocked(7, 7, true);
+    PathService.SetCellBlocked(7, 7, true);
+    const uint32 EpochAfter = PathService.GetOccupancyEpoch();
+    PathService.RequestPath(FGridCell(0, 19), Goal);
+    const int32 QueuedAfterEpoch = PathService.GetQueuedRequestCount();
+
+    // Assert
+    TestEqual(TEXT("Komórka poza siatką odrzucona"), InvalidID, static_cast<int32>(INDEX_NONE));
+    TestEqual(TEXT("Wyniki nie przychodzą w ticku zlecenia"), LaunchTickResults.Num(), 0);
+    TestTrue(TEXT("Partia liczy się w tle"), bInFlightAfterLaunch);
+    TestEqual(TEXT("Wszystkie wyniki w kolejnym ticku"), NextTickResults.Num(), 4);
+
+    for (const FGridPathResult& Result : NextTickResults)
+    {
+        TestTrue(TEXT("Ścieżka znaleziona"), Result.bFound);
+        TestFalse(TEXT("Pierwsze wyniki nie pochodzą z cache"), Result.bFromCache);
+        if (Result.RequestID == FirstID || Result.RequestID == SecondID || Result.RequestID == ThirdID)
+        {
+            TestEqual(TEXT("Ścieżka kończy się w celu"), Result.Path.Last(), Goal);
+        }
+        else
+        {
+            TestEqual(TEXT("Wynik drugiego celu"), Result.RequestID, OtherID);
+        }
+    }
+
+    const FGridPathStats& Stats = PathService.GetStats();
+    TestEqual(TEXT("Jedno wyszukiwanie na cel"), Stats.Searches, 2);
+    TestEqual(TEXT("Zapytania dołączone do cudzego wyszukiwania"), Stats.CoalescedRequests, 2);
+
+    TestEqual(TEXT("Trafienie w cache w najbliższym ticku"), CacheTickResults.Num(), 1);
+    if (CacheTickResults.Num() == 1)
+    {
+        TestEqual(TEXT("ID wyniku z cache"), CacheTickResults[0].RequestID, CachedID);
+        TestTrue(TEXT("Wynik z cache"), CacheTickResults[0].bFromCache);
+    }
+    TestEqual(TEXT("Licznik trafień w cache"), PathService.GetStats().CacheHits, 1);
+
+    TestEqual(TEXT("Epoka rośnie raz dla jednej zmiany zajętości"), EpochAfter, EpochBefore + 1);
+    TestTrue(TEXT("Zajęta komórka"), PathService.IsCellBlocked(FGridCell(7, 7)));
+    TestEqual(TEXT("Po zmianie epoki zapytanie trafia do kolejki"), QueuedAfterEpoch, 1);
+
+    return true;
+}
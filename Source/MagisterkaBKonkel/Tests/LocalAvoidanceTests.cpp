@@ -0,0 +1,136 @@
+// LocalAvoidanceTests.cpp - Testy automatyczne dla unikania kolizji ORCA
+#include "Misc/AutomationTest.h"
+#include "LocalAvoidance.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja tworząca pustą migawkę z siatką 4x4 mega-komórek po 500 jednostek
+static FAvoidanceSnapshot CreateAvoidanceSnapshot()
+{
+    FAvoidanceSnapshot Snapshot;
+    Snapshot.WorldMin = FVector2D(-1000.0f, -1000.0f);
+    Snapshot.MegaCellSize = 500.0f;
+    Snapshot.MegaGridWidth = 4;
+    Snapshot.MegaGridHeight = 4;
+    return Snapshot;
+}
+
+// Pomocnicza funkcja licząca najmniejszą odległość dwóch jednostek idących ze stałymi prędkościami przez Horizon kroków
+static float GetClosestApproach(const FVector2D& PositionA, const FVector2D& VelocityA,
+    const FVector2D& PositionB, const FVector2D& VelocityB, float Horizon)
+{
+    const FVector2D RelativePosition = PositionB - PositionA;
+    const FVector2D RelativeVelocity = VelocityB - VelocityA;
+    const float RelativeSpeedSq = RelativeVelocity.SizeSquared();
+    const float Time = RelativeSpeedSq > KINDA_SMALL_NUMBER
+        ? FMath::Clamp(-(RelativePosition | RelativeVelocity) / RelativeSpeedSq, 0.0f, Horizon)
+        : 0.0f;
+    return (RelativePosition + RelativeVelocity * Time).Size();
+}
+
+// Test 1: Dwie jednostki idące na siebie i jednostka idąca na stojącego sojusznika mijają się bez kolizji
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLocalAvoidanceHeadOnTest,
+    "Game.LocalAvoidance.HeadOn",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FLocalAvoidanceHeadOnTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FAvoidanceParams Params;
+    Params.AgentRadius = 40.0f;
+    Params.TimeHorizon = 10.0f;
+    const float MaxSpeed = 10.0f;
+
+    FAvoidanceSnapshot HeadOn = CreateAvoidanceSnapshot();
+    HeadOn.AddEntry(FVector2D(0.0f, 0.0f), FVector2D(10.0f, 0.0f), FVector2D(10.0f, 0.0f), MaxSpeed, 0);
+    HeadOn.AddEntry(FVector2D(200.0f, 10.0f), FVector2D(-10.0f, 0.0f), FVector2D(-10.0f, 0.0f), MaxSpeed, 0);
+    HeadOn.BuildCellLists();
+
+    FAvoidanceSnapshot Stationary = CreateAvoidanceSnapshot();
+    Stationary.AddEntry(FVector2D(0.0f, 0.0f), FVector2D(10.0f, 0.0f), FVector2D(10.0f, 0.0f), MaxSpeed, 0);
+    Stationary.AddEntry(FVector2D(150.0f, 5.0f), FVector2D::ZeroVector, FVector2D::ZeroVector, MaxSpeed, 0);
+    Stationary.BuildCellLists();
+
+    // Act
+    TArray<FVector2D> HeadOnVelocities;
+    FLocalAvoidance::ComputeVelocities(HeadOn, Params, HeadOnVelocities);
+
+    TArray<FVector2D> StationaryVelocities;
+    FLocalAvoidance::ComputeVelocities(Stationary, Params, StationaryVelocities);
+
+    // Assert - każda strona ustępuje w swoją stronę, a razem mijają się w odległości dwóch promieni
+    TestTrue(TEXT("Pierwsza jednostka schodzi w dół"), HeadOnVelocities[0].Y < -1.0f);
+    TestTrue(TEXT("Druga jednostka schodzi w górę"), HeadOnVelocities[1].Y > 1.0f);
+    TestTrue(TEXT("Obie nadal idą do przodu"), HeadOnVelocities[0].X > 0.0f && HeadOnVelocities[1].X < 0.0f);
+    TestTrue(TEXT("Prędkość nie przekracza maksymalnej"), HeadOnVelocities[0].Size() <= MaxSpeed + KINDA_SMALL_NUMBER);
+    TestTrue(TEXT("Brak kolizji w horyzoncie"),
+        GetClosestApproach(FVector2D(0.0f, 0.0f), HeadOnVelocities[0], FVector2D(200.0f, 10.0f), HeadOnVelocities[1], Params.TimeHorizon)
+        >= 2.0f * Params.AgentRadius - 1.0f);
+
+    // Stojący sojusznik nie ustępuje - idąca jednostka omija go sama
+    TestEqual(TEXT("Stojąca jednostka dostaje zero"), StationaryVelocities[1], FVector2D::ZeroVector);
+    TestTrue(TEXT("Brak kolizji ze stojącym sojusznikiem"),
+        GetClosestApproach(FVector2D(0.0f, 0.0f), StationaryVelocities[0], FVector2D(150.0f, 5.0f), FVector2D::ZeroVector, Params.TimeHorizon)
+        >= 2.0f * Params.AgentRadius - 1.0f);
+
+    return true;
+}
+
+// Test 2: Wrogowie i dalecy sojusznicy nie zmieniają prędkości, a wynik równoległy jest identyczny z sekwencyjnym
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLocalAvoidanceNeighboursTest,
+    "Game.LocalAvoidance.Neighbours",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FLocalAvoidanceNeighboursTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FAvoidanceParams Params;
+    Params.TimeHorizon = 10.0f;
+    const FVector2D Preferred(10.0f, 0.0f);
+
+    FAvoidanceSnapshot Enemies = CreateAvoidanceSnapshot();
+    Enemies.AddEntry(FVector2D(0.0f, 0.0f), Preferred, Preferred, 10.0f, 0);
+    Enemies.AddEntry(FVector2D(200.0f, 10.0f), -Preferred, -Preferred, 10.0f, 1);
+    Enemies.AddEntry(FVector2D(0.0f, 900.0f), -Preferred, -Preferred, 10.0f, 0);
+    Enemies.BuildCellLists();
+
+    // Tłum 400 jednostek dwóch drużyn w kwadracie 1200x1200
+    FAvoidanceSnapshot Crowd = CreateAvoidanceSnapshot();
+    FRandomStream Random(4242);
+    for (int32 i = 0; i < 400; i++)
+    {
+        const FVector2D Position(Random.FRandRange(-600.0f, 600.0f), Random.FRandRange(-600.0f, 600.0f));
+        const FVector2D Direction = FVector2D(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f)).GetSafeNormal();
+        const FVector2D Velocity = (i % 5 == 0) ? FVector2D::ZeroVector : Direction * 10.0f;
+        Crowd.AddEntry(Position, Velocity, Velocity, 10.0f, i % 2);
+    }
+    Crowd.BuildCellLists();
+
+    // Act
+    TArray<FVector2D> EnemyVelocities;
+    FLocalAvoidance::ComputeVelocities(Enemies, Params, EnemyVelocities);
+
+    TArray<FVector2D> ParallelVelocities;
+    TArray<FVector2D> SequentialVelocities;
+    FLocalAvoidance::ComputeVelocities(Crowd, Params, ParallelVelocities, true);
+    FLocalAvoidance::ComputeVelocities(Crowd, Params, SequentialVelocities, false);
+
+    // Assert
+    TestEqual(TEXT("Wróg nie jest przeszkodą"), EnemyVelocities[0], Preferred);
+    TestEqual(TEXT("Sojusznik poza zasięgiem sąsiedztwa pomijany"), EnemyVelocities[2], -Preferred);
+
+    int32 Mismatches = 0;
+    for (int32 i = 0; i < Crowd.Num(); i++)
+    {
+        if (ParallelVelocities[i] != SequentialVelocities[i])
+        {
+            Mismatches++;
+        }
+        if (ParallelVelocities[i].Size() > 10.0f + KINDA_SMALL_NUMBER)
+        {
+            AddError(FString::Printf(TEXT("Jednostka %d przekracza prędkość maksymalną"), i));
+        }
+    }
+    TestEqual(TEXT("Wynik równoległy identyczny z sekwencyjnym"), Mismatches, 0);
+
+    return true;
+}
@@ -0,0 +1,162 @@
+// LockstepBattleTests.cpp - Testy automatyczne bitwy lockstep (pakiet startowy, skróty, resynchronizacja)
+#include "Misc/AutomationTest.h"
+#include "LockstepBattle.h"
+#include "Tests/AutomationCommon.h"
+
+// Pomocnicza funkcja tworząca bitwę 6 na 6
+static FBattleSimSetup CreateLockstepSetup(float TankSpeed)
+{
+    FBattleSimSetup Setup;
+    for (FSimUnitStats& Stats : Setup.TypeStats)
+    {
+        Stats.Speed = 50.0f;
+        Stats.AttackRange = 150.0f;
+        Stats.AttackCooldown = 1.0f;
+        Stats.MovementInterval = 0.2f;
+        Stats.SearchRange = 5000.0f;
+    }
+    Setup.TypeStats[static_cast<int32>(EBaseUnitType::Tank)].Speed = TankSpeed;
+
+    for (int32 i = 0; i < 6; i++)
+    {
+        FSimUnitPlacement& Player0Unit = Setup.Placements.AddDefaulted_GetRef();
+        Player0Unit.PlayerID = 0;
+        Player0Unit.GridPosition = FGridCell(i * 2, 1);
+        Player0Unit.UnitType = EBaseUnitType::Tank;
+
+        FSimUnitPlacement& Player1Unit = Setup.Placements.AddDefaulted_GetRef();
+        Player1Unit.PlayerID = 1;
+        Player1Unit.GridPosition = FGridCell(i * 2 + 1, 12);
+        Player1Unit.UnitType = EBaseUnitType::Ninja;
+    }
+
+    return Setup;
+}
+
+// Test 1: Klient z pakietu startowego liczy tę samą bitwę co serwer - żadnej rozbieżności
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLockstepInSyncTest,
+    "Game.Lockstep.InSync",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FLockstepInSyncTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FLockstepBattleSession Server;
+    FLockstepBattleSession Client;
+    TArray<uint8> StartPacket;
+    const bool bServerStarted = Server.StartAuthority(CreateLockstepSetup(50.0f), 77, 10, StartPacket);
+    const bool bClientStarted = Client.StartFromPacket(StartPacket, 10);
+
+    // Act - klient o pół klatki za serwerem, skróty dostarczane po każdej klatce
+    int32 HashesSent = 0;
+    TArray<FLockstepHash> Hashes;
+    for (int32 Frame = 0; Frame < 100000 && !Server.GetState().IsFinished(); Frame++)
+    {
+        Hashes.Reset();
+        Server.Advance(1.0f / 60.0f, Hashes);
+        Client.Advance(Frame == 0 ? 1.0f / 120.0f : 1.0f / 60.0f, Hashes);
+        for (const FLockstepHash& TickHash : Hashes)
+        {
+            Client.ReceiveAuthorityHash(TickHash.Tick, TickHash.Hash);
+        }
+        HashesSent += Hashes.Num();
+    }
+    Client.CatchUpToTick(Server.GetState().GetTickCount());
+
+    // Assert
+    TestTrue(TEXT("Serwer powinien wystartować"), bServerStarted);
+    TestTrue(TEXT("Klient powinien przyjąć pakiet startowy"), bClientStarted);
+    TestTrue(TEXT("Pakiet startowy powinien być mały"), StartPacket.Num() < 1024);
+    TestTrue(TEXT("Serwer powinien wysyłać skróty"), HashesSent > 0);
+    TestFalse(TEXT("Klient nie powinien wykryć rozbieżności"), Client.NeedsResync());
+    TestEqual(TEXT("Tick końcowy zgodny"), Client.GetState().GetTickCount(), Server.GetState().GetTickCount());
+    TestEqual(TEXT("Skrót końcowy zgodny"), Client.GetState().ComputeStateHash(), Server.GetState().ComputeStateHash());
+
+    AddInfo(FString::Printf(TEXT("Pakiet startowy: %d B, skrótów: %d, ticków: %d"), StartPacket.Num(), HashesSent, Server.GetState().GetTickCount()));
+
+    return true;
+}
+
+// Test 2: Rozjechany klient wykrywa rozbieżność i wraca do stanu serwera z migawki
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLockstepResyncTest,
+    "Game.Lockstep.Resync",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FLockstepResyncTest::RunTest(const FString& Parameters)
+{
+    // Arrange - klient dostaje pakiet z inną prędkością czołgów (to samo ziarno i rozstawienie)
+    FLockstepBattleSession Server;
+    FLockstepBattleSession Client;
+    FLockstepBattleSession Unused;
+    TArray<uint8> ServerPacket;
+    TArray<uint8> DivergedPacket;
+    Server.StartAuthority(CreateLockstepSetup(50.0f), 5, 5, ServerPacket);
+    Unused.StartAuthority(CreateLockstepSetup(60.0f), 5, 5, DivergedPacket);
+    Client.StartFromPacket(DivergedPacket, 5);
+
+    // Act
+    TArray<FLockstepHash> Hashes;
+    for (int32 Frame = 0; Frame < 600 && !Client.NeedsResync(); Frame++)
+    {
+        Hashes.Reset();
+        Server.Advance(0.05f, Hashes);
+        Client.Advance(0.05f, Hashes);
+        for (const FLockstepHash& TickHash : Hashes)
+        {
+            Client.ReceiveAuthorityHash(TickHash.Tick, TickHash.Hash);
+        }
+    }
+    const bool bDesyncDetected = Client.NeedsResync();
+
+    TArray<uint8> Snapshot;
+    const bool bSnapshotSaved = Server.SaveSnapshot(Snapshot);
+    const bool bSnapshotApplied = Client.ApplySnapshot(Snapshot);
+
+    // Assert
+    TestTrue(TEXT("Klient powinien wykryć rozbieżność"), bDesyncDetected);
+    TestTrue(TEXT("Serwer powinien zapisać migawkę"), bSnapshotSaved);
+    TestTrue(TEXT("Klient powinien przyjąć migawkę"), bSnapshotApplied);
+    TestFalse(TEXT("Rozbieżność skasowana po resynchronizacji"), Client.NeedsResync());
+    TestEqual(TEXT("Liczba resynchronizacji"), Client.GetResyncCount(), 1);
+    TestEqual(TEXT("Tick po resynchronizacji"), Client.GetState().GetTickCount(), Server.GetState().GetTickCount());
+    TestEqual(TEXT("Skrót po resynchronizacji"), Client.GetState().ComputeStateHash(), Server.GetState().ComputeStateHash());
+
+    return true;
+}
+
+// Test 3: Pakiet z innej wersji symulacji i migawka z innej bitwy są odrzucane
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FLockstepRejectTest,
+    "Game.Lockstep.Reject",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FLockstepRejectTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FBattleReplay OldVersion;
+    OldVersion.Setup = CreateLockstepSetup(50.0f);
+    OldVersion.SimVersion = FBattleReplay::CurrentSimVersion - 1;
+    TArray<uint8> OldPacket;
+    OldVersion.SaveToBytes(OldPacket);
+
+    FLockstepBattleSession Server;
+    FLockstepBattleSession OtherServer;
+    FLockstepBattleSession Client;
+    TArray<uint8> Packet;
+    TArray<uint8> OtherPacket;
+    Server.StartAuthority(CreateLockstepSetup(50.0f), 1, 10, Packet);
+    OtherServer.StartAuthority(CreateLockstepSetup(50.0f), 2, 10, OtherPacket);
+
+    // Act
+    const bool bOldAccepted = Client.StartFromPacket(OldPacket, 10);
+    Client.StartFromPacket(Packet, 10);
+    TArray<uint8> OtherSnapshot;
+    OtherServer.SaveSnapshot(OtherSnapshot);
+    const bool bOtherSnapshotAccepted = Client.ApplySnapshot(OtherSnapshot);
+
+    // Assert
+    TestFalse(TEXT("Pakiet z innej wersji symulacji powinien zostać odrzucony"), bOldAccepted);
+    TestTrue(TEXT("Poprawny pakiet powinien uruchomić bitwę"), Client.IsActive());
+    TestFalse(TEXT("Migawka z innej bitwy powinna zostać odrzucona"), bOtherSnapshotAccepted);
+
+    return true;
+}
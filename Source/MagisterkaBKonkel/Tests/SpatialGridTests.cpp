@@ -2,6 +2,10 @@
 #include "Misc/AutomationTest.h"
 #include "SpatialGrid.h"
 #include "BaseUnit.h"
+#include "UnitArchetype.h"
+#include "UnitManager.h"
+#include "GridManager.h"
+#include "TestWorld.h"
 #include "Tests/AutomationCommon.h"
 
 // Test 1: Inicjalizacja siatki i podstawowe obliczenia
@@ -57,21 +61,21 @@ bool FSpatialGridCoordinateConversionTest::RunTest(const FString& Parameters)
 
     // Test 1: Konwersja pozycji świata na współrzędne komórki bazowej
     FVector TestPosition1(250.0f, 450.0f, 0.0f); // Powinno być w komórce (1, 2)
-    FVector2D BaseCoords = Grid->GetBaseGridCoordinates(TestPosition1);
+    FGridCell BaseCoords = Grid->GetBaseGridCoordinates(TestPosition1);
     
     TestEqual(TEXT("BaseGrid X dla pozycji (250, 450)"), (int32)BaseCoords.X, 1);
     TestEqual(TEXT("BaseGrid Y dla pozycji (250, 450)"), (int32)BaseCoords.Y, 2);
 
     // Test 2: Konwersja pozycji świata na współrzędne mega-komórki
     FVector TestPosition2(1500.0f, 1200.0f, 0.0f); // Powinno być w mega-komórce (2, 2)
-    FVector2D MegaCoords = Grid->GetMegaCellCoordinates(TestPosition2);
+    FGridCell MegaCoords = Grid->GetMegaCellCoordinates(TestPosition2);
     
     TestEqual(TEXT("MegaCell X dla pozycji (1500, 1200)"), (int32)MegaCoords.X, 2);
     TestEqual(TEXT("MegaCell Y dla pozycji (1500, 1200)"), (int32)MegaCoords.Y, 2);
 
     // Test 3: Konwersja komórki bazowej na mega-komórkę
     // Komórka bazowa (7, 8) powinna być w mega-komórce (2, 2)
-    FVector2D ConvertedMega = Grid->BaseGridToMegaCell(7, 8);
+    FGridCell ConvertedMega = Grid->BaseGridToMegaCell(7, 8);
     
     TestEqual(TEXT("Konwersja bazowej (7,8) na mega X"), (int32)ConvertedMega.X, 2);
     TestEqual(TEXT("Konwersja bazowej (7,8) na mega Y"), (int32)ConvertedMega.Y, 2);
@@ -89,12 +93,12 @@ bool FSpatialGridCoordinateConversionTest::RunTest(const FString& Parameters)
 
     // Test 5: Pozycje brzegowe
     FVector EdgePosition(0.0f, 0.0f, 0.0f); // Lewy dolny róg
-    FVector2D EdgeCoords = Grid->GetMegaCellCoordinates(EdgePosition);
+    FGridCell EdgeCoords = Grid->GetMegaCellCoordinates(EdgePosition);
     TestEqual(TEXT("Lewy dolny róg - Mega X"), (int32)EdgeCoords.X, 0);
     TestEqual(TEXT("Lewy dolny róg - Mega Y"), (int32)EdgeCoords.Y, 0);
 
     FVector MaxEdgePosition(2999.0f, 2999.0f, 0.0f); // Prawy górny róg
-    FVector2D MaxEdgeCoords = Grid->GetMegaCellCoordinates(MaxEdgePosition);
+    FGridCell MaxEdgeCoords = Grid->GetMegaCellCoordinates(MaxEdgePosition);
     TestEqual(TEXT("Prawy górny róg - Mega X"), (int32)MaxEdgeCoords.X, 4);
     TestEqual(TEXT("Prawy górny róg - Mega Y"), (int32)MaxEdgeCoords.Y, 4);
 
@@ -160,4 +164,273 @@ bool FSpatialGridMegaCellCenterTest::RunTest(const FString& Parameters)
     TestEqual(TEXT("Centrum mega-komórki (1,1) Y"), (float)Center11.Y, 900.0f);
 
     return true;
-}
\ No newline at end of file
+}
+
+// Pomocnicza funkcja: losowo rozmieszczone jednostki dwóch drużyn w świecie testu, dodane do siatki
+static void SpawnRandomGridUnits(UWorld* World, USpatialGrid* Grid, int32 UnitCount, float WorldSize, int32 Seed, TArray<ABaseUnit*>& OutUnits)
+{
+    FRandomStream Random(Seed);
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    for (int32 i = 0; i < UnitCount; i++)
+    {
+        const FVector Location(Random.FRandRange(0.0f, WorldSize), Random.FRandRange(0.0f, WorldSize), 0.0f);
+        ABaseUnit* Unit = World->SpawnActor<ABaseUnit>(ABaseUnit::StaticClass(), Location, FRotator::ZeroRotator, SpawnParams);
+        if (!Unit)
+        {
+            continue;
+        }
+
+        Unit->SetActorLocation(Location);
+        Unit->TeamID = i % 2;
+        Unit->bIsAlive = Random.FRand() > 0.05f;
+        Unit->bAutoCombatEnabled = true;
+        Grid->AddUnit(Unit);
+        OutUnits.Add(Unit);
+    }
+}
+
+// Test 5: Wyszukiwanie najbliższego wroga na migawce
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpatialGridSnapshotNearestEnemyTest, 
+    "Game.SpatialGrid.SnapshotNearestEnemy", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpatialGridSnapshotNearestEnemyTest::RunTest(const FString& Parameters)
+{
+    // Arrange - jednostka 0 (drużyna 0), sojusznik bliżej niż wrogowie, jeden wróg martwy
+    FTargetAcquisitionSnapshot Snapshot;
+    Snapshot.WorldMin = FVector2D(0.0f, 0.0f);
+    Snapshot.MegaCellSize = 600.0f;
+    Snapshot.MegaGridWidth = 5;
+    Snapshot.MegaGridHeight = 5;
+
+    const FVector Positions[] = { FVector(100, 100, 0), FVector(150, 100, 0), FVector(200, 100, 0), FVector(900, 900, 0), FVector(2900, 2900, 0) };
+    const int32 Teams[] = { 0, 0, 1, 1, 1 };
+    const bool Alive[] = { true, true, false, true, true };
+
+    for (int32 i = 0; i < 5; i++)
+    {
+        FTargetSnapshotEntry& Entry = Snapshot.Entries.AddDefaulted_GetRef();
+        Entry.Position = Positions[i];
+        Entry.SearchRange = 2000.0f;
+        Entry.TeamID = Teams[i];
+        Entry.MegaCellIndex = Snapshot.ComputeMegaCellIndex(Entry.Position);
+        Entry.bIsAlive = Alive[i];
+        Entry.bNeedsTarget = true;
+    }
+    Snapshot.BuildCellLists();
+
+    // Act
+    TArray<int32> ProposedTargets;
+    USpatialGrid::DecideNearestEnemies(Snapshot, ProposedTargets, true);
+
+    // Assert
+    TestEqual(TEXT("Najbliższym żywym wrogiem jednostki 0 powinna być jednostka 3"), ProposedTargets[0], 3);
+    TestEqual(TEXT("Martwa jednostka nie powinna szukać celu"), ProposedTargets[2], (int32)INDEX_NONE);
+    TestEqual(TEXT("Jednostka 4 nie ma wrogów w zasięgu 2000"), ProposedTargets[4], (int32)INDEX_NONE);
+    TestEqual(TEXT("Najbliższym wrogiem jednostki 3 powinna być jednostka 1"), ProposedTargets[3], 1);
+
+    return true;
+}
+
+// Pomocnicza funkcja: porównanie wyszukiwania celów z migawki z zapytaniem FindNearestEnemy dla jednej liczby jednostek
+static void RunTargetAcquisitionBenchmark(FAutomationTestBase& Test, int32 UnitCount)
+{
+    // Arrange - osobny świat z jednostkami w siatce o stałej gęstości (~1 jednostka na 100x100)
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    const float WorldSize = FMath::Sqrt(static_cast<float>(UnitCount)) * 100.0f;
+    USpatialGrid* Grid = NewObject<USpatialGrid>();
+    Grid->InitializeGrid(FVector2D(0.0f, 0.0f), FVector2D(WorldSize, WorldSize), 200.0f);
+
+    TArray<ABaseUnit*> Units;
+    SpawnRandomGridUnits(World, Grid, UnitCount, WorldSize, 1234, Units);
+
+    // Logi pojedynczych zapytań zdominowałyby pomiar
+    const ELogVerbosity::Type SavedVerbosity = LogTemp.GetVerbosity();
+    LogTemp.SetVerbosity(ELogVerbosity::Error);
+
+    // Act - dotychczasowa ścieżka: zapytanie siatki dla każdej jednostki
+    TArray<ABaseUnit*> LegacyTargets;
+    LegacyTargets.Init(nullptr, Units.Num());
+
+    const double LegacyStart = FPlatformTime::Seconds();
+    for (int32 i = 0; i < Units.Num(); i++)
+    {
+        if (Units[i]->bIsAlive)
+        {
+            LegacyTargets[i] = Grid->FindNearestEnemy(Units[i], Units[i]->GetArchetype()->SearchRange);
+        }
+    }
+    const double LegacyMs = (FPlatformTime::Seconds() - LegacyStart) * 1000.0;
+
+    // Act - nowa ścieżka: budowa migawki i równoległa faza decyzji
+    FTargetAcquisitionSnapshot Snapshot;
+    TArray<ABaseUnit*> SnapshotUnits;
+    TArray<int32> SeekerIndices;
+    TArray<int32> ParallelTargets;
+
+    const double ParallelStart = FPlatformTime::Seconds();
+    Grid->BuildTargetSnapshot(Units, Snapshot, SnapshotUnits, SeekerIndices);
+    USpatialGrid::DecideNearestEnemies(Snapshot, ParallelTargets, true);
+    const double ParallelMs = (FPlatformTime::Seconds() - ParallelStart) * 1000.0;
+
+    TArray<int32> SerialTargets;
+    USpatialGrid::DecideNearestEnemies(Snapshot, SerialTargets, false);
+
+    LogTemp.SetVerbosity(SavedVerbosity);
+
+    int32 Mismatches = 0;
+    for (int32 i = 0; i < Units.Num(); i++)
+    {
+        const int32 SeekerIndex = SeekerIndices[i];
+        const int32 TargetIndex = SeekerIndex != INDEX_NONE ? ParallelTargets[SeekerIndex] : INDEX_NONE;
+        ABaseUnit* SnapshotTarget = TargetIndex != INDEX_NONE ? SnapshotUnits[TargetIndex] : nullptr;
+        if (SnapshotTarget != LegacyTargets[i])
+        {
+            Mismatches++;
+        }
+    }
+
+    // Assert
+    Test.TestEqual(FString::Printf(TEXT("Cele z migawki zgodne z FindNearestEnemy dla %d jednostek"), UnitCount), Mismatches, 0);
+    Test.TestTrue(FString::Printf(TEXT("Wyniki równoległe identyczne z szeregowymi dla %d jednostek"), UnitCount),
+        SerialTargets == ParallelTargets);
+
+    Test.AddInfo(FString::Printf(TEXT("Jednostki: %d, FindNearestEnemy: %.2f ms, migawka + równolegle: %.2f ms, przyspieszenie: %.2fx"),
+        UnitCount, LegacyMs, ParallelMs, ParallelMs > 0.0 ? LegacyMs / ParallelMs : 0.0));
+}
+
+// Test 6: Benchmark równoległego wyszukiwania celów - wynik musi być identyczny z zapytaniem FindNearestEnemy,
+// a czas nowej ścieżki obejmuje budowę migawki
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpatialGridParallelTargetAcquisitionBenchmark, 
+    "Game.SpatialGrid.ParallelTargetAcquisitionBenchmark", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpatialGridParallelTargetAcquisitionBenchmark::RunTest(const FString& Parameters)
+{
+    const int32 UnitCounts[] = { 500, 2000 };
+
+    for (int32 UnitCount : UnitCounts)
+    {
+        RunTargetAcquisitionBenchmark(*this, UnitCount);
+    }
+
+    return true;
+}
+
+// Test 7: Ten sam benchmark dla 10 000 jednostek - osobno w filtrze obciążeniowym, bo samo tworzenie aktorów trwa długo
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpatialGridParallelTargetAcquisitionStressBenchmark, 
+    "Game.SpatialGrid.ParallelTargetAcquisitionStressBenchmark", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::StressFilter)
+
+bool FSpatialGridParallelTargetAcquisitionStressBenchmark::RunTest(const FString& Parameters)
+{
+    RunTargetAcquisitionBenchmark(*this, 10000);
+    return true;
+}
+
+// Test 8: Jednostka bez wrogów w zasięgu zasypia i jest pomijana przez tick walki,
+// a budzi ją wróg wchodzący do obserwowanej mega-komórki albo otrzymane obrażenia
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSpatialGridCombatSleepTest, 
+    "Game.SpatialGrid.CombatSleep", 
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FSpatialGridCombatSleepTest::RunTest(const FString& Parameters)
+{
+    // Arrange - manager z siatką przestrzenną, jednostka w siatce i wróg poza jej granicami
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AGridManager* GridManager = World->SpawnActor<AGridManager>();
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    if (!GridManager || !UnitManager)
+    {
+        AddError(TEXT("Nie udało się utworzyć aktorów testu"));
+        return false;
+    }
+
+    // Manager odnajduje GridManagera z opóźnieniem 0.1 s
+    for (int32 i = 0; i < 4; i++)
+    {
+        World->Tick(LEVELTICK_All, 0.2f);
+    }
+
+    USpatialGrid* Grid = UnitManager->GetSpatialGrid();
+    if (!Grid)
+    {
+        AddError(TEXT("Manager nie utworzył siatki przestrzennej"));
+        return false;
+    }
+
+    UnitManager->SetTimeSlicedCombat(true, 0.0f, 4.0f);
+    UnitManager->InitializeCombatDataLocality();
+
+    const FVector FarPosition(10000.0f, 10000.0f, 0.0f);
+    const FVector NearPosition(300.0f, 0.0f, 0.0f);
+    ABaseUnit* Sleeper = World->SpawnActor<ABaseUnit>(ABaseUnit::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator);
+    ABaseUnit* Enemy = World->SpawnActor<ABaseUnit>(ABaseUnit::StaticClass(), FarPosition, FRotator::ZeroRotator);
+    if (!Sleeper || !Enemy)
+    {
+        AddError(TEXT("Nie udało się utworzyć jednostek"));
+        return false;
+    }
+
+    Sleeper->TeamID = 0;
+    Enemy->TeamID = 1;
+    Sleeper->StartAutoCombat();
+    Grid->AddUnit(Sleeper);
+    UnitManager->AddUnitToCombatArray(Sleeper);
+
+    // Act - wyszukiwanie celu bez wrogów w zasięgu usypia jednostkę
+    UnitManager->ProcessUnitCombatWithSpatialGrid(Sleeper);
+    const bool bSleptWithoutEnemies = Sleeper->bCombatSleeping;
+    const int32 SleepingAfterSearch = Grid->GetSleepingUnitCount();
+    const bool bTickEnabledWhileSleeping = Sleeper->IsActorTickEnabled();
+
+    // Act - tick walki pomija uśpioną jednostkę, nawet z decyzją starszą niż 1 / MinUnitRefreshRate
+    const float StaleDecisionTime = World->GetTimeSeconds() - 1.0f;
+    Sleeper->LastCombatUpdateTime = StaleDecisionTime;
+    UnitManager->ProcessTimeSlicedCombat();
+    const FTimeSlicedCombatStats SleepingStats = UnitManager->GetTimeSlicedCombatStats();
+    const bool bDecisionSkipped = Sleeper->LastCombatUpdateTime == StaleDecisionTime;
+
+    // Act - wróg wchodzi do obserwowanej mega-komórki
+    Enemy->SetActorLocation(NearPosition);
+    Grid->UpdateUnitPosition(Enemy, FarPosition, NearPosition);
+    const bool bWokenByEnemy = !Sleeper->bCombatSleeping;
+    const int32 SleepingAfterEnemy = Grid->GetSleepingUnitCount();
+    const bool bTickEnabledAfterEnemy = Sleeper->IsActorTickEnabled();
+
+    // Act - wróg wychodzi, jednostka ponownie zasypia i zostaje trafiona
+    Enemy->SetActorLocation(FarPosition);
+    Grid->UpdateUnitPosition(Enemy, NearPosition, FarPosition);
+    Sleeper->ClearTarget();
+    UnitManager->ProcessUnitCombatWithSpatialGrid(Sleeper);
+    const bool bSleptAgain = Sleeper->bCombatSleeping;
+
+    Sleeper->ReceiveDamage(1);
+    const bool bWokenByDamage = !Sleeper->bCombatSleeping;
+    const int32 SleepingAfterDamage = Grid->GetSleepingUnitCount();
+
+    // Assert
+    TestTrue(TEXT("Jednostka bez wrogów w zasięgu powinna zasnąć"), bSleptWithoutEnemies);
+    TestEqual(TEXT("Siatka powinna obserwować jedną uśpioną jednostkę"), SleepingAfterSearch, 1);
+    TestFalse(TEXT("Uśpiona jednostka bez stałego paska zdrowia nie powinna tickować"), bTickEnabledWhileSleeping);
+
+    TestEqual(TEXT("Tick walki nie powinien przetworzyć uśpionej jednostki"), SleepingStats.ProcessedUnits, 0);
+    TestEqual(TEXT("Uśpiona jednostka nie powinna być liczona jako odłożona"), SleepingStats.DeferredUnits, 0);
+    TestTrue(TEXT("Decyzja uśpionej jednostki nie powinna zostać odświeżona"), bDecisionSkipped);
+
+    TestTrue(TEXT("Wróg w obserwowanej mega-komórce powinien obudzić jednostkę"), bWokenByEnemy);
+    TestEqual(TEXT("Obudzona jednostka nie powinna być obserwowana przez siatkę"), SleepingAfterEnemy, 0);
+    TestTrue(TEXT("Obudzona jednostka powinna znów tickować"), bTickEnabledAfterEnemy);
+
+    TestTrue(TEXT("Jednostka powinna zasnąć ponownie po wyjściu wroga"), bSleptAgain);
+    TestTrue(TEXT("Obrażenia powinny obudzić jednostkę"), bWokenByDamage);
+    TestEqual(TEXT("Po obrażeniach siatka nie powinna obserwować jednostki"), SleepingAfterDamage, 0);
+
+    return true;
+}
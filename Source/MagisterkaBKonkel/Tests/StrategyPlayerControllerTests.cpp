@@ -24,7 +24,7 @@ bool FPlayerControllerGridClickValidationTest::RunTest(const FString& Parameters
     
     // Test 1: Prawidłowe parametry powinny przejść walidację (gdy GridManager istnieje)
     // Bez GridManagera, walidacja zawsze zwróci false
-    FVector2D ValidPosition(5.0f, 5.0f);
+    FGridCell ValidPosition(5, 5);
     int32 ValidPlayerID = 0;
     
     // Bez GridManager walidacja powinna zwrócić false
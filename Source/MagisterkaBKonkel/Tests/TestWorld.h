@@ -0,0 +1,33 @@
+// TestWorld.h - Osobny świat gry na czas jednego testu automatycznego
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+/// <summary>
+/// Świat gry z własnym kontekstem, uruchomiony (BeginPlay) w konstruktorze i niszczony w destruktorze,
+/// więc każde wyjście z testu - także wczesny return po błędzie - sprząta świat.
+/// </summary>
+struct FTestWorld
+{
+    UWorld* World = nullptr;
+
+    FTestWorld()
+    {
+        World = UWorld::CreateWorld(EWorldType::Game, false);
+        FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+        WorldContext.SetCurrentWorld(World);
+        World->InitializeActorsForPlay(FURL());
+        World->BeginPlay();
+    }
+
+    ~FTestWorld()
+    {
+        GEngine->DestroyWorldContext(World);
+        World->DestroyWorld(false);
+    }
+
+    FTestWorld(const FTestWorld&) = delete;
+    FTestWorld& operator=(const FTestWorld&) = delete;
+};
@@ -0,0 +1,192 @@
+// TimeSlicedCombatTests.cpp - Testy automatyczne podziału decyzji bojowych na klatki w AUnitManager
+#include "Misc/AutomationTest.h"
+#include "UnitManager.h"
+#include "BaseUnit.h"
+#include "GridManager.h"
+#include "TestWorld.h"
+#include "Tests/AutomationCommon.h"
+
+// Test 1: Przy zerowym budżecie jednostki są odkładane, kursor wznawia od miejsca przerwania,
+// a jednostka z decyzją starszą niż 1 / MinUnitRefreshRate jest przetwarzana mimo wyczerpanego budżetu
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimeSlicedCombatBudgetTest,
+    "Game.TimeSlicedCombat.Budget",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FTimeSlicedCombatBudgetTest::RunTest(const FString& Parameters)
+{
+    // Arrange - manager z planszą (pojemność tablicy walki) i 6 jednostek w pierwszych slotach
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AGridManager* GridManager = World->SpawnActor<AGridManager>();
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    if (!GridManager || !UnitManager)
+    {
+        AddError(TEXT("Nie udało się utworzyć aktorów testu"));
+        return false;
+    }
+
+    // Manager odnajduje GridManagera z opóźnieniem 0.1 s
+    for (int32 i = 0; i < 4; i++)
+    {
+        World->Tick(LEVELTICK_All, 0.2f);
+    }
+
+    constexpr int32 UnitCount = 6;
+    constexpr float MinUnitRefreshRate = 4.0f;
+    constexpr float MaxDecisionAge = 1.0f / MinUnitRefreshRate;
+    UnitManager->SetTimeSlicedCombat(true, 0.0f, MinUnitRefreshRate);
+    UnitManager->InitializeCombatDataLocality();
+
+    TArray<ABaseUnit*> Units;
+    for (int32 i = 0; i < UnitCount; i++)
+    {
+        ABaseUnit* Unit = World->SpawnActor<ABaseUnit>();
+        if (!Unit)
+        {
+            AddError(TEXT("Nie udało się utworzyć jednostki"));
+            return false;
+        }
+        UnitManager->AddUnitToCombatArray(Unit);
+        Units.Add(Unit);
+    }
+
+    if (UnitManager->GetActiveCombatUnitsCount() != UnitCount)
+    {
+        AddError(TEXT("Jednostki nie trafiły do tablicy walki"));
+        return false;
+    }
+
+    // Kolejność round-robin: najstarsze decyzje w slotach 0-1, świeże w slotach 2-5
+    const float FirstTime = World->GetTimeSeconds();
+    for (int32 i = 0; i < UnitCount; i++)
+    {
+        Units[i]->LastCombatUpdateTime = FirstTime - (i < 2 ? 1.0f : 0.1f);
+    }
+
+    // Act - pierwsza klatka
+    UnitManager->ProcessTimeSlicedCombat();
+    const FTimeSlicedCombatStats FirstStats = UnitManager->GetTimeSlicedCombatStats();
+    const int32 FirstCursor = UnitManager->GetTimeSliceCursor();
+    TArray<bool> FirstProcessed;
+    for (ABaseUnit* Unit : Units)
+    {
+        FirstProcessed.Add(Unit->LastCombatUpdateTime == FirstTime);
+    }
+
+    // Act - druga klatka: odłożone jednostki przekroczyły MaxDecisionAge, przetworzone jeszcze nie
+    World->Tick(LEVELTICK_All, 0.2f);
+    const float SecondTime = World->GetTimeSeconds();
+    UnitManager->ProcessTimeSlicedCombat();
+    const FTimeSlicedCombatStats SecondStats = UnitManager->GetTimeSlicedCombatStats();
+    const int32 SecondCursor = UnitManager->GetTimeSliceCursor();
+    TArray<bool> SecondProcessed;
+    for (ABaseUnit* Unit : Units)
+    {
+        SecondProcessed.Add(Unit->LastCombatUpdateTime == SecondTime);
+    }
+
+    // Assert
+    TestTrue(TEXT("Druga klatka po 0.2 s"), SecondTime - FirstTime > 0.15f && SecondTime - FirstTime < MaxDecisionAge);
+
+    TestEqual(TEXT("Pierwsza klatka: przetworzone tylko jednostki ze zbyt starą decyzją"), FirstStats.ProcessedUnits, 2);
+    TestEqual(TEXT("Pierwsza klatka: świeże jednostki odłożone"), FirstStats.DeferredUnits, 4);
+    TestTrue(TEXT("Pierwsza klatka: sloty 0-1 przetworzone mimo wyczerpanego budżetu"), FirstProcessed[0] && FirstProcessed[1]);
+    TestFalse(TEXT("Pierwsza klatka: slot 2 odłożony"), FirstProcessed[2]);
+    TestEqual(TEXT("Kursor zatrzymany na pierwszej odłożonej jednostce"), FirstCursor, 2);
+
+    TestEqual(TEXT("Druga klatka: przetworzone jednostki odłożone w pierwszej"), SecondStats.ProcessedUnits, 4);
+    TestEqual(TEXT("Druga klatka: jednostki przetworzone w pierwszej odłożone"), SecondStats.DeferredUnits, 2);
+    TestTrue(TEXT("Druga klatka zaczyna od slotu 2"), SecondProcessed[2] && SecondProcessed[3] && SecondProcessed[4] && SecondProcessed[5]);
+    TestFalse(TEXT("Druga klatka nie powtarza slotów 0-1"), SecondProcessed[0] || SecondProcessed[1]);
+    TestEqual(TEXT("Kursor po okrążeniu wraca na slot 0"), SecondCursor, 0);
+
+    return true;
+}
+
+// Test 2: Pętla przerywa na pierwszej jednostce bez zaległości - kolejność round-robin musi trzymać
+// najstarszą decyzję pod kursorem, inaczej zaległa jednostka za kursorem czekałaby kolejną klatkę
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimeSlicedCombatOldestAtCursorTest,
+    "Game.TimeSlicedCombat.OldestAtCursor",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FTimeSlicedCombatOldestAtCursorTest::RunTest(const FString& Parameters)
+{
+    // Arrange - jednostki z decyzjami w kolejności slotów (slot 0 najstarszy), jak po pierwszym okrążeniu
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AGridManager* GridManager = World->SpawnActor<AGridManager>();
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    if (!GridManager || !UnitManager)
+    {
+        AddError(TEXT("Nie udało się utworzyć aktorów testu"));
+        return false;
+    }
+
+    for (int32 i = 0; i < 4; i++)
+    {
+        World->Tick(LEVELTICK_All, 0.2f);
+    }
+
+    constexpr int32 UnitCount = 8;
+    constexpr float MinUnitRefreshRate = 4.0f;
+    constexpr float MaxDecisionAge = 1.0f / MinUnitRefreshRate;
+    constexpr float FrameSeconds = 0.05f;
+    UnitManager->SetTimeSlicedCombat(true, 0.0f, MinUnitRefreshRate);
+    UnitManager->InitializeCombatDataLocality();
+
+    TArray<ABaseUnit*> Units;
+    for (int32 i = 0; i < UnitCount; i++)
+    {
+        ABaseUnit* Unit = World->SpawnActor<ABaseUnit>();
+        if (!Unit)
+        {
+            AddError(TEXT("Nie udało się utworzyć jednostki"));
+            return false;
+        }
+        UnitManager->AddUnitToCombatArray(Unit);
+        Units.Add(Unit);
+    }
+
+    const float StartTime = World->GetTimeSeconds();
+    for (int32 i = 0; i < UnitCount; i++)
+    {
+        Units[i]->LastCombatUpdateTime = StartTime - MaxDecisionAge * (UnitCount - i) / UnitCount;
+    }
+
+    // Act - kolejne klatki z zerowym budżetem: po każdej sprawdzenie jednostki pod kursorem i zaległości
+    int32 CursorNotOldestFrames = 0;
+    int32 OverdueLeftFrames = 0;
+    for (int32 Frame = 0; Frame < 40; Frame++)
+    {
+        World->Tick(LEVELTICK_All, FrameSeconds);
+        UnitManager->ProcessTimeSlicedCombat();
+
+        const float WorldTime = World->GetTimeSeconds();
+        float OldestAge = 0.0f;
+        for (ABaseUnit* Unit : Units)
+        {
+            OldestAge = FMath::Max(OldestAge, Unit->GetCombatDecisionAge(WorldTime));
+        }
+
+        // Sloty za jednostkami są puste - kursor na pustym slocie wskazuje na slot 0 po okrążeniu
+        const int32 Cursor = UnitManager->GetTimeSliceCursor();
+        ABaseUnit* CursorUnit = Units[Cursor < UnitCount ? Cursor : 0];
+        if (CursorUnit->GetCombatDecisionAge(WorldTime) < OldestAge)
+        {
+            CursorNotOldestFrames++;
+        }
+
+        if (OldestAge >= MaxDecisionAge)
+        {
+            OverdueLeftFrames++;
+        }
+    }
+
+    // Assert
+    TestEqual(TEXT("Po każdej klatce pod kursorem jest najstarsza decyzja"), CursorNotOldestFrames, 0);
+    TestEqual(TEXT("Po żadnej klatce nie zostaje jednostka z zaległą decyzją"), OverdueLeftFrames, 0);
+
+    return true;
+}
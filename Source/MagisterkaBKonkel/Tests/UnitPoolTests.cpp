@@ -0,0 +1,248 @@
+// UnitPoolTests.cpp - Testy automatyczne dla puli aktorów i partii spawnu jednostek w AUnitManager
+#include "Misc/AutomationTest.h"
+#include "UnitManager.h"
+#include "BaseUnit.h"
+#include "UnitArchetype.h"
+#include "GridManager.h"
+#include "TestWorld.h"
+#include "Tests/AutomationCommon.h"
+
+// Test 1: Zwolniona jednostka trafia do puli ukryta, a ponownie pobrana ma stan świeżej jednostki
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnitPoolReuseTest,
+    "Game.UnitPool.Reuse",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnitPoolReuseTest::RunTest(const FString& Parameters)
+{
+    // Arrange - osobny świat gry z managerem i jedną martwą jednostką
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    ABaseUnit* Unit = World->SpawnActor<ABaseUnit>();
+    if (!UnitManager || !Unit)
+    {
+        AddError(TEXT("Nie udało się utworzyć aktorów testu"));
+        return false;
+    }
+
+    Unit->UnitType = EBaseUnitType::Ninja;
+    Unit->CurrentHealth = 0;
+    Unit->bIsAlive = false;
+    Unit->bCanMove = false;
+    Unit->bIsAttacking = true;
+
+    // Act
+    UnitManager->ReleaseUnit(Unit);
+
+    const bool bPooled = Unit->IsInUnitPool();
+    const bool bHiddenInPool = Unit->IsHidden();
+    const bool bCollisionInPool = Unit->GetActorEnableCollision();
+    const int32 PooledCount = UnitManager->GetPooledUnitCount(EBaseUnitType::Ninja);
+
+    const FVector ReuseLocation(300.0f, 200.0f, 20.0f);
+    ABaseUnit* Reused = UnitManager->AcquireUnit(EBaseUnitType::Ninja, ReuseLocation, FRotator(0.0f, 180.0f, 0.0f));
+
+    // Assert
+    TestTrue(TEXT("Jednostka powinna trafić do puli"), bPooled);
+    TestTrue(TEXT("Jednostka w puli powinna być ukryta"), bHiddenInPool);
+    TestFalse(TEXT("Jednostka w puli nie powinna mieć kolizji"), bCollisionInPool);
+    TestEqual(TEXT("Pula typu Ninja powinna mieć jedną jednostkę"), PooledCount, 1);
+
+    TestTrue(TEXT("Pobrana powinna być ta sama jednostka"), Reused == Unit);
+    TestEqual(TEXT("Pula powinna być pusta po pobraniu"), UnitManager->GetPooledUnitCount(EBaseUnitType::Ninja), 0);
+    if (Reused)
+    {
+        TestFalse(TEXT("Pobrana jednostka nie jest w puli"), Reused->IsInUnitPool());
+        TestFalse(TEXT("Pobrana jednostka jest widoczna"), Reused->IsHidden());
+        TestTrue(TEXT("Pobrana jednostka żyje"), Reused->bIsAlive);
+        TestTrue(TEXT("Pobrana jednostka może się ruszać"), Reused->bCanMove);
+        TestFalse(TEXT("Pobrana jednostka nie atakuje"), Reused->bIsAttacking);
+        TestEqual(TEXT("Pełne zdrowie"), Reused->CurrentHealth, Reused->GetArchetype()->MaxHealth);
+        TestTrue(TEXT("Nowa pozycja"), Reused->GetActorLocation().Equals(ReuseLocation, 0.1f));
+        TestEqual(TEXT("Stan animacji"), Reused->AnimationState, EAnimationState::Idle);
+    }
+
+    return true;
+}
+
+// Test 2: Partia spawnu jest przetwarzana w kolejnych klatkach i zamykana bez utraty żądań
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnitPoolSpawnBatchTest,
+    "Game.UnitPool.SpawnBatch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnitPoolSpawnBatchTest::RunTest(const FString& Parameters)
+{
+    // Arrange - świat bez GridManagera, więc każde żądanie kończy się niepowodzeniem
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    if (!UnitManager)
+    {
+        AddError(TEXT("Nie udało się utworzyć UnitManagera"));
+        return false;
+    }
+
+    TArray<FUnitSpawnRequest> Requests;
+    for (int32 i = 0; i < 6; i++)
+    {
+        Requests.Add(FUnitSpawnRequest(i % 2, EBaseUnitType::Sword));
+    }
+
+    // Act
+    const int32 EmptyBatchID = UnitManager->QueueUnitSpawnBatch(TArray<FUnitSpawnRequest>());
+    const int32 FirstBatchID = UnitManager->QueueUnitSpawnBatch(Requests);
+    const int32 SecondBatchID = UnitManager->QueueUnitSpawnBatch(Requests);
+    const int32 PendingAfterQueue = UnitManager->GetPendingSpawnCount();
+
+    for (int32 i = 0; i < 30 && UnitManager->GetPendingSpawnCount() > 0; i++)
+    {
+        World->Tick(LEVELTICK_All, 1.0f / 30.0f);
+    }
+
+    const int32 PendingAfterTicks = UnitManager->GetPendingSpawnCount();
+    const int32 UnitCount = UnitManager->GetUnitCount(0) + UnitManager->GetUnitCount(1);
+
+    // Assert
+    TestEqual(TEXT("Pusta partia nie powinna być kolejkowana"), EmptyBatchID, static_cast<int32>(INDEX_NONE));
+    TestEqual(TEXT("ID pierwszej partii"), FirstBatchID, 0);
+    TestEqual(TEXT("ID drugiej partii"), SecondBatchID, 1);
+    TestEqual(TEXT("Oczekujące żądania po zleceniu"), PendingAfterQueue, 12);
+    TestEqual(TEXT("Kolejka powinna zostać opróżniona"), PendingAfterTicks, 0);
+    TestEqual(TEXT("Bez siatki nie powinna powstać żadna jednostka"), UnitCount, 0);
+
+    return true;
+}
+
+// Test 3: Trafienia zakolejkowane przed zniszczeniem celu lub zwrotem atakującego do puli są pomijane
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnitPoolStaleDamageTest,
+    "Game.UnitPool.StaleDamage",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnitPoolStaleDamageTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    ABaseUnit* Attacker = World->SpawnActor<ABaseUnit>();
+    ABaseUnit* PooledAttacker = World->SpawnActor<ABaseUnit>();
+    ABaseUnit* DestroyedTarget = World->SpawnActor<ABaseUnit>();
+    ABaseUnit* Target = World->SpawnActor<ABaseUnit>();
+    if (!UnitManager || !Attacker || !PooledAttacker || !DestroyedTarget || !Target)
+    {
+        AddError(TEXT("Nie udało się utworzyć aktorów testu"));
+        return false;
+    }
+
+    const int32 HealthBefore = Target->CurrentHealth;
+    const int32 ExpectedDamage = Target->CalculateDamageTaken(30);
+
+    UnitManager->QueueDamage(Attacker, DestroyedTarget, 30);
+    UnitManager->QueueDamage(PooledAttacker, Target, 30);
+    UnitManager->QueueDamage(Attacker, Target, 30);
+
+    // Act - zmiany stanu jednostek między kolejkowaniem a rozstrzygnięciem
+    DestroyedTarget->Destroy();
+    UnitManager->ReleaseUnit(PooledAttacker);
+    const bool bAttackerPooled = PooledAttacker->IsInUnitPool();
+
+    UnitManager->ResolvePendingDamage();
+
+    const int32 HealthAfter = Target->CurrentHealth;
+    const int32 PendingAfter = UnitManager->GetPendingDamageCount();
+
+    // Assert
+    TestTrue(TEXT("Atakujący powinien trafić do puli"), bAttackerPooled);
+    TestEqual(TEXT("Cel powinien otrzymać tylko trafienie od aktywnego atakującego"), HealthBefore - HealthAfter, ExpectedDamage);
+    TestEqual(TEXT("Bufor obrażeń powinien być pusty"), PendingAfter, 0);
+
+    return true;
+}
+
+// Test 4: Z siatką partie są rozkładane na klatki w limicie jednostek na klatkę, a każda zgłasza zdarzenie dokładnie raz
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FUnitPoolSpawnBatchWithGridTest,
+    "Game.UnitPool.SpawnBatchWithGrid",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FUnitPoolSpawnBatchWithGridTest::RunTest(const FString& Parameters)
+{
+    // Arrange
+    FTestWorld TestWorld;
+    UWorld* World = TestWorld.World;
+
+    AGridManager* GridManager = World->SpawnActor<AGridManager>();
+    AUnitManager* UnitManager = World->SpawnActor<AUnitManager>();
+    if (!GridManager || !UnitManager)
+    {
+        AddError(TEXT("Nie udało się utworzyć aktorów testu"));
+        return false;
+    }
+
+    constexpr int32 SpawnsPerFrame = 4;
+    UnitManager->SetUnitClassForType(EBaseUnitType::Sword, ABaseUnit::StaticClass());
+    UnitManager->SetSpawnFrameBudget(0.0f, SpawnsPerFrame);
+
+    // Zdarzenia partii zapisywane przez lambdę - ID partii, liczba jednostek i liczba zdarzeń w bieżącej klatce
+    TArray<int32> BatchIDs;
+    TArray<int32> SpawnedCounts;
+    int32 EventsThisFrame = 0;
+    UnitManager->OnUnitBatchSpawnedNative.AddLambda(
+        [&BatchIDs, &SpawnedCounts, &EventsThisFrame](int32 BatchID, const TArray<FSpawnedUnitData>& SpawnedBatch, const TArray<FUnitSpawnRequest>& FailedRequests)
+        {
+            BatchIDs.Add(BatchID);
+            SpawnedCounts.Add(SpawnedBatch.Num());
+            EventsThisFrame++;
+        });
+
+    TArray<FUnitSpawnRequest> Requests;
+    for (int32 i = 0; i < 6; i++)
+    {
+        Requests.Add(FUnitSpawnRequest(i % 2, EBaseUnitType::Sword));
+    }
+
+    const int32 FirstBatchID = UnitManager->QueueUnitSpawnBatch(Requests);
+    const int32 SecondBatchID = UnitManager->QueueUnitSpawnBatch(Requests);
+
+    // Act - klatka po klatce, zapis przyrostu jednostek i zdarzeń
+    TArray<int32> SpawnedPerFrame;
+    TArray<int32> EventsPerFrame;
+    int32 PreviousCount = 0;
+    for (int32 i = 0; i < 10 && UnitManager->GetPendingSpawnCount() > 0; i++)
+    {
+        EventsThisFrame = 0;
+        World->Tick(LEVELTICK_All, 1.0f / 30.0f);
+
+        const int32 UnitCount = UnitManager->GetUnitCount(0) + UnitManager->GetUnitCount(1);
+        SpawnedPerFrame.Add(UnitCount - PreviousCount);
+        EventsPerFrame.Add(EventsThisFrame);
+        PreviousCount = UnitCount;
+    }
+
+    // Dodatkowa klatka po opróżnieniu kolejki nie może ponownie zgłosić zdarzenia
+    World->Tick(LEVELTICK_All, 1.0f / 30.0f);
+
+    const int32 PendingAfterTicks = UnitManager->GetPendingSpawnCount();
+
+    // Assert
+    TestEqual(TEXT("Kolejka powinna zostać opróżniona"), PendingAfterTicks, 0);
+    TestEqual(TEXT("12 żądań przy limicie 4 na klatkę powinno zająć 3 klatki"), SpawnedPerFrame.Num(), 3);
+    for (int32 Frame = 0; Frame < SpawnedPerFrame.Num(); Frame++)
+    {
+        TestEqual(*FString::Printf(TEXT("Liczba jednostek utworzonych w klatce %d"), Frame), SpawnedPerFrame[Frame], SpawnsPerFrame);
+    }
+
+    TestTrue(TEXT("Zdarzenia w klatkach 0-2 powinny wynosić 0, 1, 1"), EventsPerFrame == TArray<int32>({ 0, 1, 1 }));
+    TestEqual(TEXT("Każda partia powinna zgłosić zdarzenie dokładnie raz"), BatchIDs.Num(), 2);
+    if (BatchIDs.Num() == 2)
+    {
+        TestEqual(TEXT("Pierwsze zdarzenie dotyczy pierwszej partii"), BatchIDs[0], FirstBatchID);
+        TestEqual(TEXT("Drugie zdarzenie dotyczy drugiej partii"), BatchIDs[1], SecondBatchID);
+        TestEqual(TEXT("Pierwsza partia powinna utworzyć 6 jednostek"), SpawnedCounts[0], 6);
+        TestEqual(TEXT("Druga partia powinna utworzyć 6 jednostek"), SpawnedCounts[1], 6);
+    }
+
+    return true;
+}